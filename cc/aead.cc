@@ -0,0 +1,174 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/aead.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "openssl/crypto.h"
+#include "tink/internal/fragments.h"
+#include "tink/subtle/subtle_util.h"
+#include "tink/util/request_arena.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+util::StatusOr<int64_t> Aead::MaxEncryptionSize(int64_t plaintext_size) const {
+  return util::Status(absl::StatusCode::kUnimplemented,
+                      "The ciphertext size is not known in advance");
+}
+
+util::StatusOr<int64_t> Aead::EncryptFragments(
+    absl::Span<const absl::string_view> plaintext,
+    absl::string_view associated_data,
+    absl::Span<const absl::Span<char>> ciphertext) const {
+  if (internal::FragmentsOverlap(plaintext, ciphertext)) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "Plaintext and ciphertext fragments must not overlap");
+  }
+  util::StatusOr<std::string> result =
+      Encrypt(absl::StrJoin(plaintext, ""), associated_data);
+  if (!result.ok()) return result.status();
+  if (internal::FragmentsSize(ciphertext) < result->size()) {
+    return util::Status(
+        absl::StatusCode::kInvalidArgument,
+        absl::StrCat("Ciphertext fragments too small; expected at least ",
+                     result->size(), " bytes"));
+  }
+  internal::CopyToFragments(*result, ciphertext);
+  return result->size();
+}
+
+util::StatusOr<int64_t> Aead::DecryptFragments(
+    absl::Span<const absl::string_view> ciphertext,
+    absl::string_view associated_data,
+    absl::Span<const absl::Span<char>> plaintext) const {
+  if (internal::FragmentsOverlap(ciphertext, plaintext)) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "Ciphertext and plaintext fragments must not overlap");
+  }
+  util::StatusOr<std::string> result =
+      Decrypt(absl::StrJoin(ciphertext, ""), associated_data);
+  if (!result.ok()) return result.status();
+  if (internal::FragmentsSize(plaintext) < result->size()) {
+    return util::Status(
+        absl::StatusCode::kInvalidArgument,
+        absl::StrCat("Plaintext fragments too small; expected at least ",
+                     result->size(), " bytes"));
+  }
+  internal::CopyToFragments(*result, plaintext);
+  return result->size();
+}
+
+util::StatusOr<std::vector<std::string>> Aead::EncryptBatch(
+    absl::Span<const absl::string_view> plaintexts,
+    absl::Span<const absl::string_view> associated_data) const {
+  if (plaintexts.size() != associated_data.size()) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "Number of plaintexts and associated data differ");
+  }
+  std::vector<std::string> ciphertexts(plaintexts.size());
+  for (size_t i = 0; i < plaintexts.size(); ++i) {
+    util::StatusOr<std::string> ciphertext =
+        Encrypt(plaintexts[i], associated_data[i]);
+    if (!ciphertext.ok()) return ciphertext.status();
+    ciphertexts[i] = *std::move(ciphertext);
+  }
+  return ciphertexts;
+}
+
+util::StatusOr<std::vector<util::StatusOr<std::string>>> Aead::DecryptBatch(
+    absl::Span<const absl::string_view> ciphertexts,
+    absl::Span<const absl::string_view> associated_data) const {
+  if (ciphertexts.size() != associated_data.size()) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "Number of ciphertexts and associated data differ");
+  }
+  std::vector<util::StatusOr<std::string>> plaintexts;
+  plaintexts.reserve(ciphertexts.size());
+  for (size_t i = 0; i < ciphertexts.size(); ++i) {
+    plaintexts.push_back(Decrypt(ciphertexts[i], associated_data[i]));
+  }
+  return plaintexts;
+}
+
+util::StatusOr<absl::string_view> Aead::EncryptWithArena(
+    absl::string_view plaintext, absl::string_view associated_data,
+    util::RequestArena* arena) const {
+  util::StatusOr<int64_t> max_size = MaxEncryptionSize(plaintext.size());
+  if (!max_size.ok()) {
+    util::StatusOr<std::string> ciphertext =
+        Encrypt(plaintext, associated_data);
+    if (!ciphertext.ok()) return ciphertext.status();
+    return arena->Copy(*ciphertext);
+  }
+  absl::Span<char> buffer = arena->Allocate(*max_size);
+  util::StatusOr<int64_t> written_bytes =
+      EncryptFragments({plaintext}, associated_data, {buffer});
+  if (!written_bytes.ok()) return written_bytes.status();
+  return absl::string_view(buffer.data(), *written_bytes);
+}
+
+util::StatusOr<absl::string_view> Aead::DecryptWithArena(
+    absl::string_view ciphertext, absl::string_view associated_data,
+    util::RequestArena* arena) const {
+  absl::Span<char> buffer = arena->Allocate(ciphertext.size());
+  util::StatusOr<int64_t> written_bytes =
+      DecryptFragments({ciphertext}, associated_data, {buffer});
+  if (!written_bytes.ok()) {
+    // The arena only zeroes the buffer on Reset(), and the failed decryption
+    // may have left unauthenticated plaintext in it.
+    OPENSSL_cleanse(buffer.data(), buffer.size());
+    return written_bytes.status();
+  }
+  return absl::string_view(buffer.data(), *written_bytes);
+}
+
+util::StatusOr<std::string> Aead::EncryptWithPrefix(
+    absl::string_view prefix, absl::string_view plaintext,
+    absl::string_view associated_data) const {
+  util::StatusOr<int64_t> max_size = MaxEncryptionSize(plaintext.size());
+  if (!max_size.ok()) {
+    util::StatusOr<std::string> ciphertext =
+        Encrypt(plaintext, associated_data);
+    if (!ciphertext.ok() || prefix.empty()) return ciphertext;
+    return absl::StrCat(prefix, *ciphertext);
+  }
+  std::string result;
+  subtle::ResizeStringUninitialized(&result, prefix.size() + *max_size);
+  std::memcpy(&result[0], prefix.data(), prefix.size());
+  util::StatusOr<int64_t> written_bytes = EncryptFragments(
+      {plaintext}, associated_data,
+      {absl::MakeSpan(&result[0] + prefix.size(), *max_size)});
+  if (!written_bytes.ok()) return written_bytes.status();
+  result.resize(prefix.size() + *written_bytes);
+  return result;
+}
+
+}  // namespace tink
+}  // namespace crypto
@@ -17,9 +17,13 @@
 #ifndef TINK_AEAD_H_
 #define TINK_AEAD_H_
 
+#include <cstdint>
 #include <string>
+#include <vector>
 
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/util/request_arena.h"
 #include "tink/util/statusor.h"
 
 namespace crypto {
@@ -51,6 +55,82 @@ class Aead {
       absl::string_view ciphertext,
       absl::string_view associated_data) const = 0;
 
+  // The methods below let callers avoid copies and amortize per-message
+  // costs. The ciphertexts are always the ones Encrypt() would return, and
+  // the plaintexts the ones Decrypt() would return. The default
+  // implementations of the virtual methods work for every Aead by calling
+  // Encrypt() and Decrypt(); implementations override them where they can do
+  // better. The non-virtual methods are built on the virtual ones.
+
+  // Returns an upper bound on the size of the ciphertext of a
+  // 'plaintext_size' bytes long plaintext. Returns an UNIMPLEMENTED error
+  // if the implementation does not know it, which is the default.
+  virtual crypto::tink::util::StatusOr<int64_t> MaxEncryptionSize(
+      int64_t plaintext_size) const;
+
+  // Encrypts the concatenation of the 'plaintext' fragments with
+  // 'associated_data' as associated data, writes the ciphertext across the
+  // 'ciphertext' fragments, in order, and returns its size. This is meant
+  // for messages that are held as lists of buffers, e.g., iovecs or
+  // absl::Cord chunks. The 'ciphertext' fragments must not overlap the
+  // 'plaintext' fragments, and must together be large enough for the
+  // ciphertext; MaxEncryptionSize() bytes always are.
+  virtual crypto::tink::util::StatusOr<int64_t> EncryptFragments(
+      absl::Span<const absl::string_view> plaintext,
+      absl::string_view associated_data,
+      absl::Span<const absl::Span<char>> ciphertext) const;
+
+  // Decrypts the concatenation of the 'ciphertext' fragments with
+  // 'associated_data' as associated data, writes the plaintext across the
+  // 'plaintext' fragments, in order, and returns its size. The 'plaintext'
+  // fragments must not overlap the 'ciphertext' fragments, and must together
+  // be large enough for the plaintext; fragments as large as the ciphertext
+  // always are. If decryption fails, the 'plaintext' fragments hold no
+  // plaintext, but may have been overwritten.
+  virtual crypto::tink::util::StatusOr<int64_t> DecryptFragments(
+      absl::Span<const absl::string_view> ciphertext,
+      absl::string_view associated_data,
+      absl::Span<const absl::Span<char>> plaintext) const;
+
+  // Encrypts 'plaintexts[i]' with 'associated_data[i]' for every i, and
+  // returns the ciphertexts in the same order. Fails if any message cannot
+  // be encrypted.
+  virtual crypto::tink::util::StatusOr<std::vector<std::string>> EncryptBatch(
+      absl::Span<const absl::string_view> plaintexts,
+      absl::Span<const absl::string_view> associated_data) const;
+
+  // Decrypts 'ciphertexts[i]' with 'associated_data[i]' for every i, and
+  // returns one result per ciphertext, in the same order. A ciphertext that
+  // fails to decrypt does not affect the others; only a malformed batch
+  // fails the whole call.
+  virtual crypto::tink::util::StatusOr<
+      std::vector<crypto::tink::util::StatusOr<std::string>>>
+  DecryptBatch(absl::Span<const absl::string_view> ciphertexts,
+               absl::Span<const absl::string_view> associated_data) const;
+
+  // Like Encrypt(), but places the ciphertext in 'arena' instead of a new
+  // std::string. The returned view is valid until 'arena' is reset. If
+  // MaxEncryptionSize() is known, encrypts with EncryptFragments() straight
+  // into the arena.
+  crypto::tink::util::StatusOr<absl::string_view> EncryptWithArena(
+      absl::string_view plaintext, absl::string_view associated_data,
+      crypto::tink::util::RequestArena* arena) const;
+
+  // Like Decrypt(), but places the plaintext in 'arena' instead of a new
+  // std::string. The returned view is valid until 'arena' is reset.
+  // Decrypts with DecryptFragments() straight into the arena.
+  crypto::tink::util::StatusOr<absl::string_view> DecryptWithArena(
+      absl::string_view ciphertext, absl::string_view associated_data,
+      crypto::tink::util::RequestArena* arena) const;
+
+  // Returns 'prefix' followed by the result of Encrypt(), e.g. to prepend a
+  // key ID. If MaxEncryptionSize() is known, encrypts with
+  // EncryptFragments() right after the prefix, which saves copying large
+  // ciphertexts.
+  crypto::tink::util::StatusOr<std::string> EncryptWithPrefix(
+      absl::string_view prefix, absl::string_view plaintext,
+      absl::string_view associated_data) const;
+
   virtual ~Aead() = default;
 };
 
@@ -22,10 +22,12 @@
 #include "tink/aead/aes_ctr_hmac_aead_key_manager.h"
 #include "tink/aead/aes_eax_key_manager.h"
 #include "tink/aead/aes_eax_proto_serialization.h"
+#include "tink/aead/aes_gcm_hkdf_segmented_key_manager.h"
 #include "tink/aead/aes_gcm_key_manager.h"
 #include "tink/aead/aes_gcm_proto_serialization.h"
 #include "tink/aead/aes_gcm_siv_key_manager.h"
 #include "tink/aead/aes_gcm_siv_proto_serialization.h"
+#include "tink/aead/aes_gcm_with_key_check_value_key_manager.h"
 #include "tink/aead/kms_aead_key_manager.h"
 #include "tink/aead/kms_envelope_aead_key_manager.h"
 #include "tink/aead/xchacha20_poly1305_key_manager.h"
@@ -92,6 +94,18 @@ util::Status AeadConfig::Register() {
     return status;
   }
 
+  status = Registry::RegisterKeyTypeManager(
+      absl::make_unique<AesGcmHkdfSegmentedKeyManager>(), true);
+  if (!status.ok()) {
+    return status;
+  }
+
+  status = Registry::RegisterKeyTypeManager(
+      absl::make_unique<AesGcmWithKeyCheckValueKeyManager>(), true);
+  if (!status.ok()) {
+    return status;
+  }
+
   status = Registry::RegisterKeyTypeManager(
       absl::make_unique<KmsAeadKeyManager>(), true);
   if (!status.ok()) {
@@ -110,6 +110,54 @@ TEST_F(AeadConfigTest, WrappersRegistered) {
   ASSERT_THAT(*aead, Not(IsNull()));
 }
 
+TEST_F(AeadConfigTest, AesGcmHkdfSegmentedRegistered) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+
+  ASSERT_THAT(AeadConfig::Register(), IsOk());
+
+  StatusOr<std::unique_ptr<KeysetHandle>> keyset_handle =
+      KeysetHandle::GenerateNew(AeadKeyTemplates::Aes128GcmHkdfSegmented1MB(),
+                                KeyGenConfigGlobalRegistry());
+  ASSERT_THAT(keyset_handle.status(), IsOk());
+  StatusOr<std::unique_ptr<Aead>> aead =
+      (*keyset_handle)
+          ->GetPrimitive<crypto::tink::Aead>(ConfigGlobalRegistry());
+  ASSERT_THAT(aead.status(), IsOk());
+
+  std::string plaintext(3 * 1024 * 1024, 'p');
+  StatusOr<std::string> ciphertext = (*aead)->Encrypt(plaintext, "aad");
+  ASSERT_THAT(ciphertext.status(), IsOk());
+  StatusOr<std::string> decrypted = (*aead)->Decrypt(*ciphertext, "aad");
+  ASSERT_THAT(decrypted.status(), IsOk());
+  EXPECT_EQ(*decrypted, plaintext);
+}
+
+TEST_F(AeadConfigTest, AesGcmWithKeyCheckValueRegistered) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+
+  ASSERT_THAT(AeadConfig::Register(), IsOk());
+
+  StatusOr<std::unique_ptr<KeysetHandle>> keyset_handle =
+      KeysetHandle::GenerateNew(
+          AeadKeyTemplates::Aes256GcmNoPrefixWithKeyCheckValue(),
+          KeyGenConfigGlobalRegistry());
+  ASSERT_THAT(keyset_handle.status(), IsOk());
+  StatusOr<std::unique_ptr<Aead>> aead =
+      (*keyset_handle)
+          ->GetPrimitive<crypto::tink::Aead>(ConfigGlobalRegistry());
+  ASSERT_THAT(aead.status(), IsOk());
+
+  StatusOr<std::string> ciphertext = (*aead)->Encrypt("plaintext", "aad");
+  ASSERT_THAT(ciphertext.status(), IsOk());
+  StatusOr<std::string> decrypted = (*aead)->Decrypt(*ciphertext, "aad");
+  ASSERT_THAT(decrypted.status(), IsOk());
+  EXPECT_EQ(*decrypted, "plaintext");
+}
+
 // FIPS-only mode tests
 TEST_F(AeadConfigTest, RegisterNonFipsTemplates) {
   if (!IsFipsModeEnabled() || !internal::IsFipsEnabledInSsl()) {
@@ -122,6 +170,9 @@ TEST_F(AeadConfigTest, RegisterNonFipsTemplates) {
       AeadKeyTemplates::Aes128Eax(),         AeadKeyTemplates::Aes256Eax(),
       AeadKeyTemplates::Aes128GcmSiv(),      AeadKeyTemplates::Aes256GcmSiv(),
       AeadKeyTemplates::XChaCha20Poly1305(),
+      AeadKeyTemplates::Aes128GcmHkdfSegmented1MB(),
+      AeadKeyTemplates::Aes256GcmHkdfSegmented1MB(),
+      AeadKeyTemplates::Aes256GcmNoPrefixWithKeyCheckValue(),
   };
 
   for (auto key_template : non_fips_key_templates) {
@@ -23,7 +23,9 @@
 #include "proto/aes_ctr_hmac_aead.pb.h"
 #include "proto/aes_eax.pb.h"
 #include "proto/aes_gcm.pb.h"
+#include "proto/aes_gcm_hkdf_segmented.pb.h"
 #include "proto/aes_gcm_siv.pb.h"
+#include "proto/aes_gcm_with_key_check_value.pb.h"
 #include "proto/common.pb.h"
 #include "proto/hmac.pb.h"
 #include "proto/kms_envelope.pb.h"
@@ -31,8 +33,10 @@
 
 using google::crypto::tink::AesCtrHmacAeadKeyFormat;
 using google::crypto::tink::AesEaxKeyFormat;
+using google::crypto::tink::AesGcmHkdfSegmentedKeyFormat;
 using google::crypto::tink::AesGcmKeyFormat;
 using google::crypto::tink::AesGcmSivKeyFormat;
+using google::crypto::tink::AesGcmWithKeyCheckValueKeyFormat;
 using google::crypto::tink::HashType;
 using google::crypto::tink::KeyTemplate;
 using google::crypto::tink::KmsEnvelopeAeadKeyFormat;
@@ -67,6 +71,20 @@ KeyTemplate* NewAesGcmKeyTemplate(int key_size_in_bytes,
   return key_template;
 }
 
+KeyTemplate* NewAesGcmWithKeyCheckValueKeyTemplate(
+    int key_size_in_bytes, int key_check_value_size_in_bytes,
+    OutputPrefixType output_prefix_type) {
+  KeyTemplate* key_template = new KeyTemplate;
+  key_template->set_type_url(
+      "type.googleapis.com/google.crypto.tink.AesGcmWithKeyCheckValueKey");
+  key_template->set_output_prefix_type(output_prefix_type);
+  AesGcmWithKeyCheckValueKeyFormat key_format;
+  key_format.set_key_size(key_size_in_bytes);
+  key_format.set_key_check_value_size(key_check_value_size_in_bytes);
+  key_format.SerializeToString(key_template->mutable_value());
+  return key_template;
+}
+
 KeyTemplate* NewAesGcmSivKeyTemplate(int key_size_in_bytes) {
   KeyTemplate* key_template = new KeyTemplate;
   key_template->set_type_url(
@@ -107,6 +125,23 @@ KeyTemplate* NewXChaCha20Poly1305KeyTemplate() {
   return key_template;
 }
 
+KeyTemplate* NewAesGcmHkdfSegmentedKeyTemplate(
+    int ikm_size_in_bytes, int derived_key_size_in_bytes,
+    int ciphertext_segment_size) {
+  KeyTemplate* key_template = new KeyTemplate;
+  key_template->set_type_url(
+      "type.googleapis.com/google.crypto.tink.AesGcmHkdfSegmentedKey");
+  key_template->set_output_prefix_type(OutputPrefixType::TINK);
+  AesGcmHkdfSegmentedKeyFormat key_format;
+  key_format.set_key_size(ikm_size_in_bytes);
+  auto params = key_format.mutable_params();
+  params->set_derived_key_size(derived_key_size_in_bytes);
+  params->set_hkdf_hash_type(HashType::SHA256);
+  params->set_ciphertext_segment_size(ciphertext_segment_size);
+  key_format.SerializeToString(key_template->mutable_value());
+  return key_template;
+}
+
 }  // anonymous namespace
 
 // static
@@ -153,6 +188,15 @@ const KeyTemplate& AeadKeyTemplates::Aes256GcmNoPrefix() {
   return *key_template;
 }
 
+// static
+const KeyTemplate& AeadKeyTemplates::Aes256GcmNoPrefixWithKeyCheckValue() {
+  static const KeyTemplate* key_template =
+      NewAesGcmWithKeyCheckValueKeyTemplate(
+          /* key_size_in_bytes= */ 32,
+          /* key_check_value_size_in_bytes= */ 8, OutputPrefixType::RAW);
+  return *key_template;
+}
+
 // static
 const KeyTemplate& AeadKeyTemplates::Aes128GcmSiv() {
   static const KeyTemplate* key_template =
@@ -193,6 +237,24 @@ const KeyTemplate& AeadKeyTemplates::XChaCha20Poly1305() {
   return *key_template;
 }
 
+// static
+const KeyTemplate& AeadKeyTemplates::Aes128GcmHkdfSegmented1MB() {
+  static const KeyTemplate* key_template = NewAesGcmHkdfSegmentedKeyTemplate(
+      /* ikm_size_in_bytes= */ 16,
+      /* derived_key_size_in_bytes= */ 16,
+      /* ciphertext_segment_size= */ 1024 * 1024);
+  return *key_template;
+}
+
+// static
+const KeyTemplate& AeadKeyTemplates::Aes256GcmHkdfSegmented1MB() {
+  static const KeyTemplate* key_template = NewAesGcmHkdfSegmentedKeyTemplate(
+      /* ikm_size_in_bytes= */ 32,
+      /* derived_key_size_in_bytes= */ 32,
+      /* ciphertext_segment_size= */ 1024 * 1024);
+  return *key_template;
+}
+
 // static
 KeyTemplate AeadKeyTemplates::KmsEnvelopeAead(absl::string_view kek_uri,
                                               const KeyTemplate& dek_template) {
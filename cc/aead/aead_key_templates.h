@@ -84,6 +84,18 @@ class AeadKeyTemplates {
   //   - OutputPrefixType: RAW
   static const google::crypto::tink::KeyTemplate& Aes256GcmNoPrefix();
 
+  // Returns a KeyTemplate that generates new instances of
+  // AesGcmWithKeyCheckValueKey with the following parameters:
+  //   - key size: 32 bytes
+  //   - IV size: 12 bytes
+  //   - tag size: 16 bytes
+  //   - key check value size: 8 bytes
+  //   - OutputPrefixType: RAW
+  // The key check value lets keysets with many RAW keys reject ciphertexts of
+  // other keys without attempting a full decryption with each of them.
+  static const google::crypto::tink::KeyTemplate&
+  Aes256GcmNoPrefixWithKeyCheckValue();
+
   // Returns a KeyTemplate that generates new instances of AesGcmSivKey
   // with the following parameters:
   //   - key size: 16 bytes
@@ -127,6 +139,26 @@ class AeadKeyTemplates {
   //   - OutputPrefixType: TINK
   static const google::crypto::tink::KeyTemplate& XChaCha20Poly1305();
 
+  // Returns a KeyTemplate that generates new instances of
+  // AesGcmHkdfSegmentedKey, for encrypting very large in-memory payloads with
+  // segments processed in parallel, with the following parameters:
+  //   - main key (ikm) size: 16 bytes
+  //   - HKDF algorithm: HMAC-SHA256
+  //   - AES-GCM derived key size: 16 bytes
+  //   - ciphertext segment size: 1 MiB
+  //   - OutputPrefixType: TINK
+  static const google::crypto::tink::KeyTemplate& Aes128GcmHkdfSegmented1MB();
+
+  // Returns a KeyTemplate that generates new instances of
+  // AesGcmHkdfSegmentedKey, for encrypting very large in-memory payloads with
+  // segments processed in parallel, with the following parameters:
+  //   - main key (ikm) size: 32 bytes
+  //   - HKDF algorithm: HMAC-SHA256
+  //   - AES-GCM derived key size: 32 bytes
+  //   - ciphertext segment size: 1 MiB
+  //   - OutputPrefixType: TINK
+  static const google::crypto::tink::KeyTemplate& Aes256GcmHkdfSegmented1MB();
+
   // Returns a KeyTemplate that generates new instances of KmsEnvelopeAeadKey
   // with the following parameters:
   //   - KEK is pointing to kek_uri
@@ -28,8 +28,10 @@
 #include "tink/aead/aead_config.h"
 #include "tink/aead/aes_ctr_hmac_aead_key_manager.h"
 #include "tink/aead/aes_eax_key_manager.h"
+#include "tink/aead/aes_gcm_hkdf_segmented_key_manager.h"
 #include "tink/aead/aes_gcm_key_manager.h"
 #include "tink/aead/aes_gcm_siv_key_manager.h"
+#include "tink/aead/aes_gcm_with_key_check_value_key_manager.h"
 #include "tink/aead/kms_envelope_aead_key_manager.h"
 #include "tink/aead/xchacha20_poly1305_key_manager.h"
 #include "tink/config/global_registry.h"
@@ -44,7 +46,9 @@
 #include "proto/aes_ctr_hmac_aead.pb.h"
 #include "proto/aes_eax.pb.h"
 #include "proto/aes_gcm.pb.h"
+#include "proto/aes_gcm_hkdf_segmented.pb.h"
 #include "proto/aes_gcm_siv.pb.h"
+#include "proto/aes_gcm_with_key_check_value.pb.h"
 #include "proto/common.pb.h"
 #include "proto/hmac.pb.h"
 #include "proto/kms_envelope.pb.h"
@@ -53,8 +57,10 @@
 
 using google::crypto::tink::AesCtrHmacAeadKeyFormat;
 using google::crypto::tink::AesEaxKeyFormat;
+using google::crypto::tink::AesGcmHkdfSegmentedKeyFormat;
 using google::crypto::tink::AesGcmKeyFormat;
 using google::crypto::tink::AesGcmSivKeyFormat;
+using google::crypto::tink::AesGcmWithKeyCheckValueKeyFormat;
 using google::crypto::tink::HashType;
 using google::crypto::tink::KeyTemplate;
 using google::crypto::tink::KmsEnvelopeAeadKeyFormat;
@@ -180,6 +186,29 @@ TEST(Aes256GcmNoPrefix, CheckValues) {
   EXPECT_THAT(key_format.key_size(), Eq(32));
 }
 
+TEST(Aes256GcmNoPrefixWithKeyCheckValue, Basics) {
+  EXPECT_THAT(
+      AeadKeyTemplates::Aes256GcmNoPrefixWithKeyCheckValue().type_url(),
+      Eq(AesGcmWithKeyCheckValueKeyManager().get_key_type()));
+  EXPECT_THAT(AeadKeyTemplates::Aes256GcmNoPrefixWithKeyCheckValue()
+                  .output_prefix_type(),
+              Eq(OutputPrefixType::RAW));
+  EXPECT_THAT(AeadKeyTemplates::Aes256GcmNoPrefixWithKeyCheckValue(),
+              Ref(AeadKeyTemplates::Aes256GcmNoPrefixWithKeyCheckValue()));
+}
+
+TEST(Aes256GcmNoPrefixWithKeyCheckValue, CheckValues) {
+  const KeyTemplate& key_template =
+      AeadKeyTemplates::Aes256GcmNoPrefixWithKeyCheckValue();
+  AesGcmWithKeyCheckValueKeyFormat key_format;
+  EXPECT_TRUE(key_format.ParseFromString(key_template.value()));
+  EXPECT_THAT(
+      AesGcmWithKeyCheckValueKeyManager().ValidateKeyFormat(key_format),
+      IsOk());
+  EXPECT_THAT(key_format.key_size(), Eq(32));
+  EXPECT_THAT(key_format.key_check_value_size(), Eq(8));
+}
+
 TEST(Aes256Gcm, Basics) {
   EXPECT_THAT(AeadKeyTemplates::Aes256Gcm().type_url(),
               Eq("type.googleapis.com/google.crypto.tink.AesGcmKey"));
@@ -290,6 +319,65 @@ TEST(AeadKeyTemplatesTest, testAesGcmSivKeyTemplates) {
   }
 }
 
+TEST(AeadKeyTemplatesTest, testAesGcmHkdfSegmentedKeyTemplates) {
+  std::string type_url =
+      "type.googleapis.com/google.crypto.tink.AesGcmHkdfSegmentedKey";
+
+  {  // Test Aes128GcmHkdfSegmented1MB().
+    // Check that returned template is correct.
+    const KeyTemplate& key_template =
+        AeadKeyTemplates::Aes128GcmHkdfSegmented1MB();
+    EXPECT_EQ(type_url, key_template.type_url());
+    EXPECT_EQ(OutputPrefixType::TINK, key_template.output_prefix_type());
+    AesGcmHkdfSegmentedKeyFormat key_format;
+    EXPECT_TRUE(key_format.ParseFromString(key_template.value()));
+    EXPECT_EQ(16, key_format.key_size());
+    EXPECT_EQ(16, key_format.params().derived_key_size());
+    EXPECT_EQ(HashType::SHA256, key_format.params().hkdf_hash_type());
+    EXPECT_EQ(1024 * 1024, key_format.params().ciphertext_segment_size());
+
+    // Check that reference to the same object is returned.
+    const KeyTemplate& key_template_2 =
+        AeadKeyTemplates::Aes128GcmHkdfSegmented1MB();
+    EXPECT_EQ(&key_template, &key_template_2);
+
+    // Check that the template works with the key manager.
+    AesGcmHkdfSegmentedKeyManager key_type_manager;
+    auto key_manager = internal::MakeKeyManager<Aead>(&key_type_manager);
+    EXPECT_EQ(key_manager->get_key_type(), key_template.type_url());
+    auto new_key_result =
+        key_manager->get_key_factory().NewKey(key_template.value());
+    EXPECT_TRUE(new_key_result.ok()) << new_key_result.status();
+  }
+
+  {  // Test Aes256GcmHkdfSegmented1MB().
+    // Check that returned template is correct.
+    const KeyTemplate& key_template =
+        AeadKeyTemplates::Aes256GcmHkdfSegmented1MB();
+    EXPECT_EQ(type_url, key_template.type_url());
+    EXPECT_EQ(OutputPrefixType::TINK, key_template.output_prefix_type());
+    AesGcmHkdfSegmentedKeyFormat key_format;
+    EXPECT_TRUE(key_format.ParseFromString(key_template.value()));
+    EXPECT_EQ(32, key_format.key_size());
+    EXPECT_EQ(32, key_format.params().derived_key_size());
+    EXPECT_EQ(HashType::SHA256, key_format.params().hkdf_hash_type());
+    EXPECT_EQ(1024 * 1024, key_format.params().ciphertext_segment_size());
+
+    // Check that reference to the same object is returned.
+    const KeyTemplate& key_template_2 =
+        AeadKeyTemplates::Aes256GcmHkdfSegmented1MB();
+    EXPECT_EQ(&key_template, &key_template_2);
+
+    // Check that the template works with the key manager.
+    AesGcmHkdfSegmentedKeyManager key_type_manager;
+    auto key_manager = internal::MakeKeyManager<Aead>(&key_type_manager);
+    EXPECT_EQ(key_manager->get_key_type(), key_template.type_url());
+    auto new_key_result =
+        key_manager->get_key_factory().NewKey(key_template.value());
+    EXPECT_TRUE(new_key_result.ok()) << new_key_result.status();
+  }
+}
+
 TEST(AeadKeyTemplatesTest, testAesCtrHmacAeadKeyTemplates) {
   std::string type_url =
       "type.googleapis.com/google.crypto.tink.AesCtrHmacAeadKey";
@@ -16,16 +16,22 @@
 
 #include "tink/aead/aead_wrapper.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
-#include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "tink/aead.h"
 #include "tink/crypto_format.h"
+#include "tink/internal/adaptive_key_order.h"
+#include "tink/internal/fragments.h"
 #include "tink/internal/monitoring_util.h"
 #include "tink/internal/registry_impl.h"
 #include "tink/internal/util.h"
@@ -62,6 +68,7 @@ class AeadSetWrapper : public Aead {
       std::unique_ptr<MonitoringClient> monitoring_encryption_client = nullptr,
       std::unique_ptr<MonitoringClient> monitoring_decryption_client = nullptr)
       : aead_set_(std::move(aead_set)),
+        key_order_(*aead_set_),
         monitoring_encryption_client_(std::move(monitoring_encryption_client)),
         monitoring_decryption_client_(std::move(monitoring_decryption_client)) {
   }
@@ -74,8 +81,30 @@ class AeadSetWrapper : public Aead {
       absl::string_view ciphertext,
       absl::string_view associated_data) const override;
 
+  util::StatusOr<int64_t> MaxEncryptionSize(
+      int64_t plaintext_size) const override;
+
+  util::StatusOr<std::vector<std::string>> EncryptBatch(
+      absl::Span<const absl::string_view> plaintexts,
+      absl::Span<const absl::string_view> associated_data) const override;
+
+  util::StatusOr<std::vector<util::StatusOr<std::string>>> DecryptBatch(
+      absl::Span<const absl::string_view> ciphertexts,
+      absl::Span<const absl::string_view> associated_data) const override;
+
+  util::StatusOr<int64_t> EncryptFragments(
+      absl::Span<const absl::string_view> plaintext,
+      absl::string_view associated_data,
+      absl::Span<const absl::Span<char>> ciphertext) const override;
+
+  util::StatusOr<int64_t> DecryptFragments(
+      absl::Span<const absl::string_view> ciphertext,
+      absl::string_view associated_data,
+      absl::Span<const absl::Span<char>> plaintext) const override;
+
  private:
   std::unique_ptr<PrimitiveSet<Aead>> aead_set_;
+  internal::PrimitiveSetKeyOrder<Aead> key_order_;
   std::unique_ptr<MonitoringClient> monitoring_encryption_client_;
   std::unique_ptr<MonitoringClient> monitoring_decryption_client_;
 };
@@ -84,8 +113,9 @@ util::StatusOr<std::string> AeadSetWrapper::Encrypt(
     absl::string_view plaintext, absl::string_view associated_data) const {
   associated_data = internal::EnsureStringNonNull(associated_data);
   const Aead& primitive = aead_set_->get_primary()->get_primitive();
+  const std::string& key_id = aead_set_->get_primary()->get_identifier();
   util::StatusOr<std::string> ciphertext =
-      primitive.Encrypt(plaintext, associated_data);
+      primitive.EncryptWithPrefix(key_id, plaintext, associated_data);
   if (!ciphertext.ok()) {
     if (monitoring_encryption_client_ != nullptr) {
       monitoring_encryption_client_->LogFailure();
@@ -96,8 +126,7 @@ util::StatusOr<std::string> AeadSetWrapper::Encrypt(
     monitoring_encryption_client_->Log(aead_set_->get_primary()->get_key_id(),
                                        plaintext.size());
   }
-  const std::string& key_id = aead_set_->get_primary()->get_identifier();
-  return absl::StrCat(key_id, *ciphertext);
+  return ciphertext;
 }
 
 util::StatusOr<std::string> AeadSetWrapper::Decrypt(
@@ -114,18 +143,21 @@ util::StatusOr<std::string> AeadSetWrapper::Decrypt(
     if (primitives.ok()) {
       absl::string_view raw_ciphertext =
           ciphertext.substr(CryptoFormat::kNonRawPrefixSize);
-      for (const std::unique_ptr<PrimitiveSet<Aead>::Entry<Aead>>& aead_entry :
-           **primitives) {
-        Aead& aead = aead_entry->get_primitive();
-        util::StatusOr<std::string> plaintext =
-            aead.Decrypt(raw_ciphertext, associated_data);
-        if (plaintext.ok()) {
-          if (monitoring_decryption_client_ != nullptr) {
-            monitoring_decryption_client_->Log(aead_entry->get_key_id(),
-                                               raw_ciphertext.size());
-          }
-          return plaintext;
+      const PrimitiveSet<Aead>::Primitives& candidates = **primitives;
+      util::StatusOr<std::string> plaintext;
+      size_t match = 0;
+      if (internal::TryCandidates(
+              key_order_.Get(key_id), candidates.size(), [&](size_t i) {
+                match = i;
+                plaintext = candidates[i]->get_primitive().Decrypt(
+                    raw_ciphertext, associated_data);
+                return plaintext.ok();
+              })) {
+        if (monitoring_decryption_client_ != nullptr) {
+          monitoring_decryption_client_->Log(candidates[match]->get_key_id(),
+                                             raw_ciphertext.size());
         }
+        return plaintext;
       }
     }
   }
@@ -134,18 +166,264 @@ util::StatusOr<std::string> AeadSetWrapper::Decrypt(
   util::StatusOr<const PrimitiveSet<Aead>::Primitives*> raw_primitives =
       aead_set_->get_raw_primitives();
   if (raw_primitives.ok()) {
-    for (const std::unique_ptr<PrimitiveSet<Aead>::Entry<Aead>>& aead_entry :
-         **raw_primitives) {
-      Aead& aead = aead_entry->get_primitive();
-      util::StatusOr<std::string> plaintext =
-          aead.Decrypt(ciphertext, associated_data);
-      if (plaintext.ok()) {
+    const PrimitiveSet<Aead>::Primitives& candidates = **raw_primitives;
+    util::StatusOr<std::string> plaintext;
+    size_t match = 0;
+    if (internal::TryCandidates(
+            key_order_.Get(CryptoFormat::kRawPrefix), candidates.size(),
+            [&](size_t i) {
+              match = i;
+              plaintext = candidates[i]->get_primitive().Decrypt(
+                  ciphertext, associated_data);
+              return plaintext.ok();
+            })) {
+      if (monitoring_decryption_client_ != nullptr) {
+        monitoring_decryption_client_->Log(candidates[match]->get_key_id(),
+                                           ciphertext.size());
+      }
+      return plaintext;
+    }
+  }
+  if (monitoring_decryption_client_ != nullptr) {
+    monitoring_decryption_client_->LogFailure();
+  }
+  return util::Status(absl::StatusCode::kInvalidArgument, "decryption failed");
+}
+
+util::StatusOr<int64_t> AeadSetWrapper::MaxEncryptionSize(
+    int64_t plaintext_size) const {
+  util::StatusOr<int64_t> max_size =
+      aead_set_->get_primary()->get_primitive().MaxEncryptionSize(
+          plaintext_size);
+  if (!max_size.ok()) return max_size.status();
+  return aead_set_->get_primary()->get_identifier().size() + *max_size;
+}
+
+util::StatusOr<std::vector<std::string>> AeadSetWrapper::EncryptBatch(
+    absl::Span<const absl::string_view> plaintexts,
+    absl::Span<const absl::string_view> associated_data) const {
+  if (plaintexts.size() != associated_data.size()) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "Number of plaintexts and associated data differ");
+  }
+  std::vector<absl::string_view> ad(associated_data.begin(),
+                                    associated_data.end());
+  for (absl::string_view& data : ad) {
+    data = internal::EnsureStringNonNull(data);
+  }
+  const Aead& primitive = aead_set_->get_primary()->get_primitive();
+  util::StatusOr<std::vector<std::string>> ciphertexts =
+      primitive.EncryptBatch(plaintexts, ad);
+  if (!ciphertexts.ok()) {
+    if (monitoring_encryption_client_ != nullptr) {
+      monitoring_encryption_client_->LogFailure();
+    }
+    return ciphertexts.status();
+  }
+  if (monitoring_encryption_client_ != nullptr) {
+    for (absl::string_view plaintext : plaintexts) {
+      monitoring_encryption_client_->Log(
+          aead_set_->get_primary()->get_key_id(), plaintext.size());
+    }
+  }
+  const std::string& key_id = aead_set_->get_primary()->get_identifier();
+  if (!key_id.empty()) {
+    for (std::string& ciphertext : *ciphertexts) {
+      ciphertext.insert(0, key_id);
+    }
+  }
+  return ciphertexts;
+}
+
+util::StatusOr<std::vector<util::StatusOr<std::string>>>
+AeadSetWrapper::DecryptBatch(
+    absl::Span<const absl::string_view> ciphertexts,
+    absl::Span<const absl::string_view> associated_data) const {
+  if (ciphertexts.size() != associated_data.size()) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "Number of ciphertexts and associated data differ");
+  }
+  std::vector<util::StatusOr<std::string>> plaintexts(
+      ciphertexts.size(),
+      util::Status(absl::StatusCode::kInvalidArgument, "decryption failed"));
+  std::vector<bool> decrypted(ciphertexts.size());
+
+  // Decrypts the still undecrypted ciphertexts among `indices` with
+  // `aead_entry`, stripping `prefix_size` bytes from each ciphertext.
+  auto decrypt_with = [&](const PrimitiveSet<Aead>::Entry<Aead>& aead_entry,
+                          const std::vector<size_t>& indices,
+                          size_t prefix_size) -> util::StatusOr<size_t> {
+    std::vector<size_t> pending;
+    std::vector<absl::string_view> pending_ciphertexts;
+    std::vector<absl::string_view> pending_associated_data;
+    for (size_t i : indices) {
+      if (decrypted[i]) continue;
+      pending.push_back(i);
+      pending_ciphertexts.push_back(ciphertexts[i].substr(prefix_size));
+      pending_associated_data.push_back(
+          internal::EnsureStringNonNull(associated_data[i]));
+    }
+    if (pending.empty()) return 0;
+
+    util::StatusOr<std::vector<util::StatusOr<std::string>>> results =
+        aead_entry.get_primitive().DecryptBatch(pending_ciphertexts,
+                                                pending_associated_data);
+    if (!results.ok()) return results.status();
+    size_t num_decrypted = 0;
+    for (size_t j = 0; j < pending.size(); ++j) {
+      if (!(*results)[j].ok()) continue;
+      plaintexts[pending[j]] = std::move((*results)[j]);
+      decrypted[pending[j]] = true;
+      ++num_decrypted;
+      if (monitoring_decryption_client_ != nullptr) {
+        monitoring_decryption_client_->Log(aead_entry.get_key_id(),
+                                           pending_ciphertexts[j].size());
+      }
+    }
+    return num_decrypted;
+  };
+
+  // Tries the entries of `candidates`, which share the output prefix
+  // `identifier`, on the ciphertexts among `indices`, in the same order as
+  // Decrypt() would.
+  auto decrypt_with_all = [&](const PrimitiveSet<Aead>::Primitives& candidates,
+                              absl::string_view identifier,
+                              const std::vector<size_t>& indices,
+                              size_t prefix_size) -> util::Status {
+    size_t num_pending = 0;
+    for (size_t i : indices) {
+      if (!decrypted[i]) ++num_pending;
+    }
+    return internal::TryCandidatesOnBatch(
+        key_order_.Get(identifier), candidates.size(), num_pending,
+        [&](size_t i) {
+          return decrypt_with(*candidates[i], indices, prefix_size);
+        });
+  };
+
+  // Group the ciphertexts by their key ID prefix, so that each matching key
+  // decrypts all of its ciphertexts in a single batch.
+  absl::flat_hash_map<absl::string_view, std::vector<size_t>> by_key_id;
+  std::vector<size_t> all_indices(ciphertexts.size());
+  for (size_t i = 0; i < ciphertexts.size(); ++i) {
+    all_indices[i] = i;
+    if (ciphertexts[i].size() > CryptoFormat::kNonRawPrefixSize) {
+      by_key_id[ciphertexts[i].substr(0, CryptoFormat::kNonRawPrefixSize)]
+          .push_back(i);
+    }
+  }
+  for (const auto& key_id_and_indices : by_key_id) {
+    util::StatusOr<const PrimitiveSet<Aead>::Primitives*> primitives =
+        aead_set_->get_primitives(key_id_and_indices.first);
+    if (!primitives.ok()) continue;
+    util::Status status = decrypt_with_all(
+        **primitives, key_id_and_indices.first, key_id_and_indices.second,
+        CryptoFormat::kNonRawPrefixSize);
+    if (!status.ok()) return status;
+  }
+
+  // Ciphertexts that no matching key decrypted are tried with all RAW keys.
+  util::StatusOr<const PrimitiveSet<Aead>::Primitives*> raw_primitives =
+      aead_set_->get_raw_primitives();
+  if (raw_primitives.ok()) {
+    util::Status status =
+        decrypt_with_all(**raw_primitives, CryptoFormat::kRawPrefix,
+                         all_indices, /*prefix_size=*/0);
+    if (!status.ok()) return status;
+  }
+  if (monitoring_decryption_client_ != nullptr) {
+    for (size_t i = 0; i < ciphertexts.size(); ++i) {
+      if (!decrypted[i]) monitoring_decryption_client_->LogFailure();
+    }
+  }
+  return plaintexts;
+}
+
+util::StatusOr<int64_t> AeadSetWrapper::EncryptFragments(
+    absl::Span<const absl::string_view> plaintext,
+    absl::string_view associated_data,
+    absl::Span<const absl::Span<char>> ciphertext) const {
+  associated_data = internal::EnsureStringNonNull(associated_data);
+  const Aead& primitive = aead_set_->get_primary()->get_primitive();
+  const std::string& key_id = aead_set_->get_primary()->get_identifier();
+  // The prefix is written last, so that it cannot clobber plaintext that
+  // overlaps the ciphertext fragments.
+  const int64_t buffer_size = internal::FragmentsSize(ciphertext);
+  util::StatusOr<int64_t> written_bytes = primitive.EncryptFragments(
+      plaintext, associated_data,
+      internal::SubFragments(ciphertext, key_id.size(),
+                             buffer_size - key_id.size()));
+  if (!written_bytes.ok()) {
+    if (monitoring_encryption_client_ != nullptr) {
+      monitoring_encryption_client_->LogFailure();
+    }
+    return written_bytes.status();
+  }
+  internal::CopyToFragments(key_id, ciphertext);
+  if (monitoring_encryption_client_ != nullptr) {
+    monitoring_encryption_client_->Log(aead_set_->get_primary()->get_key_id(),
+                                       internal::FragmentsSize(plaintext));
+  }
+  return key_id.size() + *written_bytes;
+}
+
+util::StatusOr<int64_t> AeadSetWrapper::DecryptFragments(
+    absl::Span<const absl::string_view> ciphertext,
+    absl::string_view associated_data,
+    absl::Span<const absl::Span<char>> plaintext) const {
+  associated_data = internal::EnsureStringNonNull(associated_data);
+  const int64_t ciphertext_size = internal::FragmentsSize(ciphertext);
+
+  if (ciphertext_size > CryptoFormat::kNonRawPrefixSize) {
+    std::string key_id(CryptoFormat::kNonRawPrefixSize, '\0');
+    internal::CopyFromFragments(ciphertext, absl::MakeSpan(key_id));
+    util::StatusOr<const PrimitiveSet<Aead>::Primitives*> primitives =
+        aead_set_->get_primitives(key_id);
+    if (primitives.ok()) {
+      std::vector<absl::string_view> raw_ciphertext = internal::SubFragments(
+          ciphertext, CryptoFormat::kNonRawPrefixSize,
+          ciphertext_size - CryptoFormat::kNonRawPrefixSize);
+      const PrimitiveSet<Aead>::Primitives& candidates = **primitives;
+      util::StatusOr<int64_t> written_bytes;
+      size_t match = 0;
+      if (internal::TryCandidates(
+              key_order_.Get(key_id), candidates.size(), [&](size_t i) {
+                match = i;
+                written_bytes =
+                    candidates[i]->get_primitive().DecryptFragments(
+                        raw_ciphertext, associated_data, plaintext);
+                return written_bytes.ok();
+              })) {
         if (monitoring_decryption_client_ != nullptr) {
-          monitoring_decryption_client_->Log(aead_entry->get_key_id(),
-                                             ciphertext.size());
+          monitoring_decryption_client_->Log(
+              candidates[match]->get_key_id(),
+              ciphertext_size - CryptoFormat::kNonRawPrefixSize);
         }
-        return plaintext;
+        return written_bytes;
+      }
+    }
+  }
+
+  // No matching key succeeded with decryption, try all RAW keys.
+  util::StatusOr<const PrimitiveSet<Aead>::Primitives*> raw_primitives =
+      aead_set_->get_raw_primitives();
+  if (raw_primitives.ok()) {
+    const PrimitiveSet<Aead>::Primitives& candidates = **raw_primitives;
+    util::StatusOr<int64_t> written_bytes;
+    size_t match = 0;
+    if (internal::TryCandidates(
+            key_order_.Get(CryptoFormat::kRawPrefix), candidates.size(),
+            [&](size_t i) {
+              match = i;
+              written_bytes = candidates[i]->get_primitive().DecryptFragments(
+                  ciphertext, associated_data, plaintext);
+              return written_bytes.ok();
+            })) {
+      if (monitoring_decryption_client_ != nullptr) {
+        monitoring_decryption_client_->Log(candidates[match]->get_key_id(),
+                                           ciphertext_size);
       }
+      return written_bytes;
     }
   }
   if (monitoring_decryption_client_ != nullptr) {
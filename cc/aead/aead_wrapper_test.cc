@@ -21,6 +21,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -30,14 +31,17 @@
 #include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "tink/aead.h"
 #include "tink/aead/mock_aead.h"
+#include "tink/config/adaptive_key_ordering.h"
 #include "tink/crypto_format.h"
 #include "tink/internal/registry_impl.h"
 #include "tink/monitoring/monitoring.h"
 #include "tink/monitoring/monitoring_client_mocks.h"
 #include "tink/primitive_set.h"
 #include "tink/registry.h"
+#include "tink/util/request_arena.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
 #include "tink/util/test_matchers.h"
@@ -50,6 +54,7 @@ namespace {
 
 using ::crypto::tink::test::DummyAead;
 using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::IsOkAndHolds;
 using ::crypto::tink::test::StatusIs;
 using ::google::crypto::tink::KeysetInfo;
 using ::google::crypto::tink::KeyStatusType;
@@ -197,6 +202,258 @@ TEST(AeadSetWrapperTest, DecryptNonPrimary) {
   EXPECT_THAT(decrypted_plaintext, IsOk());
 }
 
+TEST(AeadSetWrapperTest, EncryptDecryptWithArena) {
+  KeysetInfo keyset_info = CreateTestKeysetInfo();
+  auto aead_set = absl::make_unique<PrimitiveSet<Aead>>();
+  util::StatusOr<PrimitiveSet<Aead>::Entry<Aead>*> aead_entry =
+      aead_set->AddPrimitive(absl::make_unique<DummyAead>("aead0"),
+                             keyset_info.key_info(0));
+  ASSERT_THAT(aead_entry, IsOk());
+  aead_entry = aead_set->AddPrimitive(absl::make_unique<DummyAead>("aead1"),
+                                      keyset_info.key_info(1));
+  ASSERT_THAT(aead_entry, IsOk());
+  ASSERT_THAT(aead_set->set_primary(*aead_entry), IsOk());
+  util::StatusOr<std::unique_ptr<Aead>> aead =
+      AeadWrapper().Wrap(std::move(aead_set));
+  ASSERT_THAT(aead, IsOk());
+
+  std::string plaintext = "some_plaintext";
+  std::string aad = "some_aad";
+  util::RequestArena arena;
+  util::StatusOr<absl::string_view> ciphertext =
+      (*aead)->EncryptWithArena(plaintext, aad, &arena);
+  ASSERT_THAT(ciphertext, IsOk());
+  // The arena output is interchangeable with the regular one.
+  util::StatusOr<std::string> expected_ciphertext =
+      (*aead)->Encrypt(plaintext, aad);
+  ASSERT_THAT(expected_ciphertext, IsOk());
+  EXPECT_EQ(*ciphertext, *expected_ciphertext);
+
+  util::StatusOr<absl::string_view> decrypted =
+      (*aead)->DecryptWithArena(*ciphertext, aad, &arena);
+  ASSERT_THAT(decrypted, IsOk());
+  EXPECT_EQ(*decrypted, plaintext);
+
+  EXPECT_THAT((*aead)->DecryptWithArena("some bad ciphertext", aad, &arena)
+                  .status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(AeadSetWrapperTest, EncryptBatchDecryptBatch) {
+  KeysetInfo keyset_info = CreateTestKeysetInfo();
+  KeysetInfo::KeyInfo raw_key_info;
+  PopulateKeyInfo(&raw_key_info, /*key_id=*/1111, OutputPrefixType::RAW,
+                  KeyStatusType::ENABLED);
+  auto aead_set = absl::make_unique<PrimitiveSet<Aead>>();
+  util::StatusOr<PrimitiveSet<Aead>::Entry<Aead>*> old_entry =
+      aead_set->AddPrimitive(absl::make_unique<DummyAead>("aead0"),
+                             keyset_info.key_info(0));
+  ASSERT_THAT(old_entry, IsOk());
+  ASSERT_THAT(aead_set->AddPrimitive(absl::make_unique<DummyAead>("raw"),
+                                     raw_key_info),
+              IsOk());
+  util::StatusOr<PrimitiveSet<Aead>::Entry<Aead>*> primary_entry =
+      aead_set->AddPrimitive(absl::make_unique<DummyAead>("aead2"),
+                             keyset_info.key_info(2));
+  ASSERT_THAT(primary_entry, IsOk());
+  ASSERT_THAT(aead_set->set_primary(*primary_entry), IsOk());
+  util::StatusOr<std::unique_ptr<Aead>> aead =
+      AeadWrapper().Wrap(std::move(aead_set));
+  ASSERT_THAT(aead, IsOk());
+
+  std::vector<absl::string_view> plaintexts = {"plaintext 0", "plaintext 1",
+                                               ""};
+  std::vector<absl::string_view> aads = {"aad 0", "aad 1", "aad 2"};
+  util::StatusOr<std::vector<std::string>> ciphertexts =
+      (*aead)->EncryptBatch(plaintexts, aads);
+  ASSERT_THAT(ciphertexts, IsOk());
+  ASSERT_EQ(ciphertexts->size(), plaintexts.size());
+  for (size_t i = 0; i < plaintexts.size(); ++i) {
+    // Same output as Encrypt().
+    util::StatusOr<std::string> expected =
+        (*aead)->Encrypt(plaintexts[i], aads[i]);
+    ASSERT_THAT(expected, IsOk());
+    EXPECT_EQ((*ciphertexts)[i], *expected);
+  }
+
+  // Mix in ciphertexts of a non-primary key, of the RAW key and an invalid
+  // one.
+  util::StatusOr<std::string> old_ciphertext =
+      DummyAead("aead0").Encrypt("old plaintext", "old aad");
+  ASSERT_THAT(old_ciphertext, IsOk());
+  std::string old_complete_ciphertext =
+      absl::StrCat((*old_entry)->get_identifier(), *old_ciphertext);
+  util::StatusOr<std::string> raw_ciphertext =
+      DummyAead("raw").Encrypt("raw plaintext", "raw aad");
+  ASSERT_THAT(raw_ciphertext, IsOk());
+  std::vector<absl::string_view> mixed = {
+      (*ciphertexts)[0], old_complete_ciphertext, "some bad ciphertext",
+      *raw_ciphertext, (*ciphertexts)[2]};
+  std::vector<absl::string_view> mixed_aads = {aads[0], "old aad", "aad",
+                                               "raw aad", aads[2]};
+  util::StatusOr<std::vector<util::StatusOr<std::string>>> decrypted =
+      (*aead)->DecryptBatch(mixed, mixed_aads);
+  ASSERT_THAT(decrypted, IsOk());
+  ASSERT_EQ(decrypted->size(), mixed.size());
+  EXPECT_THAT((*decrypted)[0], IsOkAndHolds(plaintexts[0]));
+  EXPECT_THAT((*decrypted)[1], IsOkAndHolds("old plaintext"));
+  EXPECT_THAT((*decrypted)[2].status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT((*decrypted)[3], IsOkAndHolds("raw plaintext"));
+  EXPECT_THAT((*decrypted)[4], IsOkAndHolds(plaintexts[2]));
+
+  EXPECT_THAT((*aead)->EncryptBatch(plaintexts, {}).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT((*aead)->DecryptBatch(mixed, {}).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+// Splits `buffer` into fragments of `fragment_size` bytes.
+std::vector<absl::Span<char>> SplitIntoFragments(absl::Span<char> buffer,
+                                                 size_t fragment_size) {
+  std::vector<absl::Span<char>> fragments;
+  while (!buffer.empty()) {
+    fragments.push_back(buffer.subspan(0, fragment_size));
+    buffer.remove_prefix(fragments.back().size());
+  }
+  return fragments;
+}
+
+TEST(AeadSetWrapperTest, EncryptFragmentsDecryptFragments) {
+  KeysetInfo keyset_info = CreateTestKeysetInfo();
+  KeysetInfo::KeyInfo raw_key_info;
+  PopulateKeyInfo(&raw_key_info, /*key_id=*/1111, OutputPrefixType::RAW,
+                  KeyStatusType::ENABLED);
+  auto aead_set = absl::make_unique<PrimitiveSet<Aead>>();
+  util::StatusOr<PrimitiveSet<Aead>::Entry<Aead>*> old_entry =
+      aead_set->AddPrimitive(absl::make_unique<DummyAead>("aead0"),
+                             keyset_info.key_info(0));
+  ASSERT_THAT(old_entry, IsOk());
+  ASSERT_THAT(aead_set->AddPrimitive(absl::make_unique<DummyAead>("raw"),
+                                     raw_key_info),
+              IsOk());
+  util::StatusOr<PrimitiveSet<Aead>::Entry<Aead>*> primary_entry =
+      aead_set->AddPrimitive(absl::make_unique<DummyAead>("aead2"),
+                             keyset_info.key_info(2));
+  ASSERT_THAT(primary_entry, IsOk());
+  ASSERT_THAT(aead_set->set_primary(*primary_entry), IsOk());
+  util::StatusOr<std::unique_ptr<Aead>> aead =
+      AeadWrapper().Wrap(std::move(aead_set));
+  ASSERT_THAT(aead, IsOk());
+
+  std::vector<absl::string_view> plaintext = {"some ", "", "fragmented ",
+                                              "plaintext"};
+  util::StatusOr<std::string> expected =
+      (*aead)->Encrypt("some fragmented plaintext", "aad");
+  ASSERT_THAT(expected, IsOk());
+
+  // Same output as Encrypt(), including the key prefix.
+  std::string ciphertext(expected->size(), '\0');
+  EXPECT_THAT((*aead)->EncryptFragments(
+                  plaintext, "aad",
+                  SplitIntoFragments(absl::MakeSpan(ciphertext), 3)),
+              IsOkAndHolds(expected->size()));
+  EXPECT_EQ(ciphertext, *expected);
+
+  std::string decrypted(ciphertext.size(), '\0');
+  std::vector<absl::string_view> ciphertext_fragments = {
+      absl::string_view(ciphertext).substr(0, 2),
+      absl::string_view(ciphertext).substr(2)};
+  util::StatusOr<int64_t> written_bytes = (*aead)->DecryptFragments(
+      ciphertext_fragments, "aad",
+      SplitIntoFragments(absl::MakeSpan(decrypted), 4));
+  ASSERT_THAT(written_bytes, IsOk());
+  EXPECT_EQ(decrypted.substr(0, *written_bytes), "some fragmented plaintext");
+
+  // Ciphertexts of a non-primary key and of the RAW key.
+  util::StatusOr<std::string> old_ciphertext =
+      DummyAead("aead0").Encrypt("old plaintext", "aad");
+  ASSERT_THAT(old_ciphertext, IsOk());
+  std::string old_complete_ciphertext =
+      absl::StrCat((*old_entry)->get_identifier(), *old_ciphertext);
+  written_bytes = (*aead)->DecryptFragments(
+      {old_complete_ciphertext}, "aad",
+      SplitIntoFragments(absl::MakeSpan(decrypted), 1));
+  ASSERT_THAT(written_bytes, IsOk());
+  EXPECT_EQ(decrypted.substr(0, *written_bytes), "old plaintext");
+  util::StatusOr<std::string> raw_ciphertext =
+      DummyAead("raw").Encrypt("raw plaintext", "aad");
+  ASSERT_THAT(raw_ciphertext, IsOk());
+  written_bytes = (*aead)->DecryptFragments(
+      {*raw_ciphertext}, "aad", {absl::MakeSpan(decrypted)});
+  ASSERT_THAT(written_bytes, IsOk());
+  EXPECT_EQ(decrypted.substr(0, *written_bytes), "raw plaintext");
+
+  EXPECT_THAT((*aead)
+                  ->DecryptFragments({"some bad ciphertext"}, "aad",
+                                     {absl::MakeSpan(decrypted)})
+                  .status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  std::string too_small(expected->size() - 1, '\0');
+  EXPECT_THAT((*aead)
+                  ->EncryptFragments(plaintext, "aad",
+                                     {absl::MakeSpan(too_small)})
+                  .status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(AeadSetWrapperTest, AdaptiveKeyOrderingTriesSuccessfulRawKeyFirst) {
+  EnableAdaptiveKeyOrdering();
+  auto aead_set = absl::make_unique<PrimitiveSet<Aead>>();
+  std::vector<std::string> names = {"raw0", "raw1", "raw2"};
+  for (uint32_t i = 0; i < names.size(); ++i) {
+    KeysetInfo::KeyInfo key_info;
+    PopulateKeyInfo(&key_info, /*key_id=*/100 + i, OutputPrefixType::RAW,
+                    KeyStatusType::ENABLED);
+    util::StatusOr<PrimitiveSet<Aead>::Entry<Aead>*> entry =
+        aead_set->AddPrimitive(absl::make_unique<DummyAead>(names[i]),
+                               key_info);
+    ASSERT_THAT(entry, IsOk());
+    if (i == 0) {
+      ASSERT_THAT(aead_set->set_primary(*entry), IsOk());
+    }
+  }
+  util::StatusOr<std::unique_ptr<Aead>> aead =
+      AeadWrapper().Wrap(std::move(aead_set));
+  DisableAdaptiveKeyOrdering();
+  ASSERT_THAT(aead, IsOk());
+
+  util::StatusOr<std::string> ciphertext =
+      DummyAead("raw2").Encrypt("plaintext", "aad");
+  ASSERT_THAT(ciphertext, IsOk());
+  AdaptiveKeyOrderingStats before = GetAdaptiveKeyOrderingStats();
+  constexpr int kNumDecryptions = 10;
+  for (int i = 0; i < kNumDecryptions; ++i) {
+    EXPECT_THAT((*aead)->Decrypt(*ciphertext, "aad"),
+                IsOkAndHolds("plaintext"));
+  }
+  AdaptiveKeyOrderingStats after = GetAdaptiveKeyOrderingStats();
+  // Only the first decryption tries all three keys.
+  EXPECT_EQ(after.trial_operations - before.trial_operations,
+            3 + (kNumDecryptions - 1));
+  EXPECT_EQ(
+      after.fixed_order_trial_operations - before.fixed_order_trial_operations,
+      3 * kNumDecryptions);
+  EXPECT_EQ(after.saved_trial_operations - before.saved_trial_operations,
+            2 * (kNumDecryptions - 1));
+
+  // Batch decryption follows the same order.
+  std::vector<absl::string_view> ciphertexts = {*ciphertext, *ciphertext,
+                                                "some bad ciphertext"};
+  std::vector<absl::string_view> aads = {"aad", "aad", "aad"};
+  util::StatusOr<std::vector<util::StatusOr<std::string>>> plaintexts =
+      (*aead)->DecryptBatch(ciphertexts, aads);
+  ASSERT_THAT(plaintexts, IsOk());
+  EXPECT_THAT((*plaintexts)[0], IsOkAndHolds("plaintext"));
+  EXPECT_THAT((*plaintexts)[1], IsOkAndHolds("plaintext"));
+  EXPECT_THAT((*plaintexts)[2].status(), Not(IsOk()));
+  AdaptiveKeyOrderingStats after_batch = GetAdaptiveKeyOrderingStats();
+  EXPECT_EQ(after_batch.trial_operations - after.trial_operations, 1 + 1 + 3);
+  EXPECT_EQ(after_batch.fixed_order_trial_operations -
+                after.fixed_order_trial_operations,
+            3 + 3 + 3);
+}
+
 // Tests with monitoring enabled.
 class AeadSetWrapperTestWithMonitoring : public Test {
  protected:
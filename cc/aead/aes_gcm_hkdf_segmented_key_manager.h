@@ -0,0 +1,107 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef TINK_AEAD_AES_GCM_HKDF_SEGMENTED_KEY_MANAGER_H_
+#define TINK_AEAD_AES_GCM_HKDF_SEGMENTED_KEY_MANAGER_H_
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "tink/aead.h"
+#include "tink/core/key_type_manager.h"
+#include "tink/input_stream.h"
+#include "tink/subtle/aes_gcm_hkdf_segmented_aead.h"
+#include "tink/util/constants.h"
+#include "tink/util/enums.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "proto/aes_gcm_hkdf_segmented.pb.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+// Key manager for AesGcmHkdfSegmentedKey, a one-shot AEAD for very large
+// in-memory payloads. Segments of a message are encrypted and decrypted in
+// parallel if enabled with EnableParallelism() (see config/parallelism.h);
+// the ciphertexts can also be decrypted by the AesGcmHkdfStreaming
+// StreamingAead with the same parameters.
+class AesGcmHkdfSegmentedKeyManager
+    : public KeyTypeManager<google::crypto::tink::AesGcmHkdfSegmentedKey,
+                            google::crypto::tink::AesGcmHkdfSegmentedKeyFormat,
+                            List<Aead>> {
+ public:
+  class AeadFactory : public PrimitiveFactory<Aead> {
+    crypto::tink::util::StatusOr<std::unique_ptr<Aead>> Create(
+        const google::crypto::tink::AesGcmHkdfSegmentedKey& key)
+        const override {
+      subtle::AesGcmHkdfSegmentedAead::Params params;
+      params.ikm = util::SecretDataFromStringView(key.key_value());
+      params.hkdf_hash = crypto::tink::util::Enums::ProtoToSubtle(
+          key.params().hkdf_hash_type());
+      params.derived_key_size = key.params().derived_key_size();
+      params.ciphertext_segment_size = key.params().ciphertext_segment_size();
+      return subtle::AesGcmHkdfSegmentedAead::New(std::move(params));
+    }
+  };
+
+  AesGcmHkdfSegmentedKeyManager()
+      : KeyTypeManager(absl::make_unique<AeadFactory>()) {}
+
+  uint32_t get_version() const override { return 0; }
+
+  google::crypto::tink::KeyData::KeyMaterialType key_material_type()
+      const override {
+    return google::crypto::tink::KeyData::SYMMETRIC;
+  }
+
+  const std::string& get_key_type() const override { return key_type_; }
+
+  crypto::tink::util::Status ValidateKey(
+      const google::crypto::tink::AesGcmHkdfSegmentedKey& key) const override;
+
+  crypto::tink::util::Status ValidateKeyFormat(
+      const google::crypto::tink::AesGcmHkdfSegmentedKeyFormat& key_format)
+      const override;
+
+  crypto::tink::util::StatusOr<google::crypto::tink::AesGcmHkdfSegmentedKey>
+  CreateKey(const google::crypto::tink::AesGcmHkdfSegmentedKeyFormat&
+                key_format) const override;
+
+  crypto::tink::util::StatusOr<google::crypto::tink::AesGcmHkdfSegmentedKey>
+  DeriveKey(
+      const google::crypto::tink::AesGcmHkdfSegmentedKeyFormat& key_format,
+      InputStream* input_stream) const override;
+
+  ~AesGcmHkdfSegmentedKeyManager() override = default;
+
+ private:
+  const std::string key_type_ = absl::StrCat(
+      kTypeGoogleapisCom,
+      google::crypto::tink::AesGcmHkdfSegmentedKey().GetTypeName());
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_AEAD_AES_GCM_HKDF_SEGMENTED_KEY_MANAGER_H_
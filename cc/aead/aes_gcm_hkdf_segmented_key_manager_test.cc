@@ -0,0 +1,209 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/aead/aes_gcm_hkdf_segmented_key_manager.h"
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "tink/aead.h"
+#include "tink/config/tink_fips.h"
+#include "tink/subtle/aes_gcm_hkdf_streaming.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/streaming_aead_test_util.h"
+#include "tink/util/istream_input_stream.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "proto/aes_gcm_hkdf_segmented.pb.h"
+#include "proto/common.pb.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::IsOkAndHolds;
+using ::crypto::tink::test::StatusIs;
+using ::crypto::tink::util::IstreamInputStream;
+using ::crypto::tink::util::StatusOr;
+using ::google::crypto::tink::AesGcmHkdfSegmentedKey;
+using ::google::crypto::tink::AesGcmHkdfSegmentedKeyFormat;
+using ::google::crypto::tink::HashType;
+using ::google::crypto::tink::KeyData;
+using ::testing::Eq;
+using ::testing::HasSubstr;
+using ::testing::Not;
+
+AesGcmHkdfSegmentedKeyFormat ValidKeyFormat() {
+  AesGcmHkdfSegmentedKeyFormat key_format;
+  key_format.set_key_size(32);
+  key_format.mutable_params()->set_derived_key_size(32);
+  key_format.mutable_params()->set_hkdf_hash_type(HashType::SHA256);
+  key_format.mutable_params()->set_ciphertext_segment_size(1024);
+  return key_format;
+}
+
+TEST(AesGcmHkdfSegmentedKeyManagerTest, Basics) {
+  EXPECT_THAT(AesGcmHkdfSegmentedKeyManager().get_version(), Eq(0));
+  EXPECT_THAT(AesGcmHkdfSegmentedKeyManager().key_material_type(),
+              Eq(KeyData::SYMMETRIC));
+  EXPECT_THAT(
+      AesGcmHkdfSegmentedKeyManager().get_key_type(),
+      Eq("type.googleapis.com/google.crypto.tink.AesGcmHkdfSegmentedKey"));
+}
+
+TEST(AesGcmHkdfSegmentedKeyManagerTest, ValidateKeyFormat) {
+  EXPECT_THAT(AesGcmHkdfSegmentedKeyManager().ValidateKeyFormat(
+                  ValidKeyFormat()),
+              IsOk());
+  EXPECT_THAT(AesGcmHkdfSegmentedKeyManager().ValidateKeyFormat(
+                  AesGcmHkdfSegmentedKeyFormat()),
+              Not(IsOk()));
+
+  AesGcmHkdfSegmentedKeyFormat key_format = ValidKeyFormat();
+  key_format.set_key_size(16);
+  EXPECT_THAT(AesGcmHkdfSegmentedKeyManager().ValidateKeyFormat(key_format),
+              Not(IsOk()));
+
+  key_format = ValidKeyFormat();
+  key_format.mutable_params()->set_derived_key_size(24);
+  EXPECT_THAT(AesGcmHkdfSegmentedKeyManager().ValidateKeyFormat(key_format),
+              Not(IsOk()));
+
+  key_format = ValidKeyFormat();
+  key_format.mutable_params()->set_hkdf_hash_type(HashType::SHA384);
+  EXPECT_THAT(AesGcmHkdfSegmentedKeyManager().ValidateKeyFormat(key_format),
+              Not(IsOk()));
+
+  key_format = ValidKeyFormat();
+  key_format.mutable_params()->set_ciphertext_segment_size(1 + 32 + 7 + 16);
+  EXPECT_THAT(AesGcmHkdfSegmentedKeyManager().ValidateKeyFormat(key_format),
+              Not(IsOk()));
+}
+
+TEST(AesGcmHkdfSegmentedKeyManagerTest, CreateKey) {
+  AesGcmHkdfSegmentedKeyFormat key_format = ValidKeyFormat();
+  StatusOr<AesGcmHkdfSegmentedKey> key =
+      AesGcmHkdfSegmentedKeyManager().CreateKey(key_format);
+  ASSERT_THAT(key, IsOk());
+  EXPECT_THAT(key->version(), Eq(0));
+  EXPECT_THAT(key->key_value().size(), Eq(key_format.key_size()));
+  EXPECT_THAT(key->params().SerializeAsString(),
+              Eq(key_format.params().SerializeAsString()));
+  EXPECT_THAT(AesGcmHkdfSegmentedKeyManager().ValidateKey(*key), IsOk());
+}
+
+TEST(AesGcmHkdfSegmentedKeyManagerTest, ValidateKey) {
+  StatusOr<AesGcmHkdfSegmentedKey> key =
+      AesGcmHkdfSegmentedKeyManager().CreateKey(ValidKeyFormat());
+  ASSERT_THAT(key, IsOk());
+
+  AesGcmHkdfSegmentedKey bad_key = *key;
+  bad_key.set_version(1);
+  EXPECT_THAT(AesGcmHkdfSegmentedKeyManager().ValidateKey(bad_key),
+              Not(IsOk()));
+
+  bad_key = *key;
+  bad_key.set_key_value(std::string(16, 'a'));
+  EXPECT_THAT(AesGcmHkdfSegmentedKeyManager().ValidateKey(bad_key),
+              Not(IsOk()));
+}
+
+TEST(AesGcmHkdfSegmentedKeyManagerTest, DeriveKey) {
+  AesGcmHkdfSegmentedKeyFormat key_format = ValidKeyFormat();
+  IstreamInputStream input_stream{
+      absl::make_unique<std::stringstream>("01234567890123456789012345678901")};
+
+  StatusOr<AesGcmHkdfSegmentedKey> key =
+      AesGcmHkdfSegmentedKeyManager().DeriveKey(key_format, &input_stream);
+  ASSERT_THAT(key, IsOk());
+  EXPECT_THAT(key->key_value(), Eq("01234567890123456789012345678901"));
+  EXPECT_THAT(key->params().SerializeAsString(),
+              Eq(key_format.params().SerializeAsString()));
+}
+
+TEST(AesGcmHkdfSegmentedKeyManagerTest, DeriveKeyNotEnoughRandomness) {
+  IstreamInputStream input_stream{
+      absl::make_unique<std::stringstream>("0123456789012345678901234567890")};
+  EXPECT_THAT(AesGcmHkdfSegmentedKeyManager()
+                  .DeriveKey(ValidKeyFormat(), &input_stream)
+                  .status(),
+              Not(IsOk()));
+}
+
+TEST(AesGcmHkdfSegmentedKeyManagerTest, DeriveKeyWrongVersion) {
+  AesGcmHkdfSegmentedKeyFormat key_format = ValidKeyFormat();
+  key_format.set_version(1);
+  IstreamInputStream input_stream{
+      absl::make_unique<std::stringstream>("01234567890123456789012345678901")};
+  EXPECT_THAT(
+      AesGcmHkdfSegmentedKeyManager()
+          .DeriveKey(key_format, &input_stream)
+          .status(),
+      StatusIs(absl::StatusCode::kInvalidArgument, HasSubstr("version")));
+}
+
+TEST(AesGcmHkdfSegmentedKeyManagerTest, GetPrimitive) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  StatusOr<AesGcmHkdfSegmentedKey> key =
+      AesGcmHkdfSegmentedKeyManager().CreateKey(ValidKeyFormat());
+  ASSERT_THAT(key, IsOk());
+  StatusOr<std::unique_ptr<Aead>> aead =
+      AesGcmHkdfSegmentedKeyManager().GetPrimitive<Aead>(*key);
+  ASSERT_THAT(aead, IsOk());
+
+  std::string plaintext = subtle::Random::GetRandomBytes(5000);
+  StatusOr<std::string> ciphertext =
+      (*aead)->Encrypt(plaintext, "associated data");
+  ASSERT_THAT(ciphertext, IsOk());
+  EXPECT_THAT((*aead)->Decrypt(*ciphertext, "associated data"),
+              IsOkAndHolds(Eq(plaintext)));
+
+  // The ciphertext is an AesGcmHkdfStreaming ciphertext of the same key.
+  subtle::AesGcmHkdfStreaming::Params params;
+  params.ikm = util::SecretDataFromStringView(key->key_value());
+  params.hkdf_hash = subtle::SHA256;
+  params.derived_key_size = 32;
+  params.ciphertext_segment_size = 1024;
+  params.ciphertext_offset = 0;
+  StatusOr<std::unique_ptr<subtle::AesGcmHkdfStreaming>> streaming_aead =
+      subtle::AesGcmHkdfStreaming::New(std::move(params));
+  ASSERT_THAT(streaming_aead, IsOk());
+  StatusOr<std::string> stream_ciphertext =
+      EncryptToString(streaming_aead->get(), plaintext, "associated data",
+                      /*ciphertext_offset=*/0);
+  ASSERT_THAT(stream_ciphertext, IsOk());
+  EXPECT_THAT((*aead)->Decrypt(*stream_ciphertext, "associated data"),
+              IsOkAndHolds(Eq(plaintext)));
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
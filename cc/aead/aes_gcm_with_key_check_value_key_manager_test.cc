@@ -0,0 +1,199 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/aead/aes_gcm_with_key_check_value_key_manager.h"
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "tink/aead.h"
+#include "tink/aead/cord_aead.h"
+#include "tink/internal/key_check_value.h"
+#include "tink/subtle/aes_gcm_boringssl.h"
+#include "tink/util/istream_input_stream.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "proto/aes_gcm_with_key_check_value.pb.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::IsOkAndHolds;
+using ::crypto::tink::test::StatusIs;
+using ::crypto::tink::util::IstreamInputStream;
+using ::crypto::tink::util::StatusOr;
+using ::google::crypto::tink::AesGcmWithKeyCheckValueKey;
+using ::google::crypto::tink::AesGcmWithKeyCheckValueKeyFormat;
+using ::testing::Eq;
+using ::testing::HasSubstr;
+using ::testing::StartsWith;
+
+TEST(AesGcmWithKeyCheckValueKeyManagerTest, Basics) {
+  EXPECT_THAT(AesGcmWithKeyCheckValueKeyManager().get_version(), Eq(0));
+  EXPECT_THAT(
+      AesGcmWithKeyCheckValueKeyManager().get_key_type(),
+      Eq("type.googleapis.com/google.crypto.tink.AesGcmWithKeyCheckValueKey"));
+  EXPECT_THAT(AesGcmWithKeyCheckValueKeyManager().key_material_type(),
+              Eq(google::crypto::tink::KeyData::SYMMETRIC));
+}
+
+TEST(AesGcmWithKeyCheckValueKeyManagerTest, ValidateKeyFormat) {
+  AesGcmWithKeyCheckValueKeyFormat format;
+  format.set_key_size(32);
+  for (int key_check_value_size : {4, 8, 16}) {
+    format.set_key_check_value_size(key_check_value_size);
+    EXPECT_THAT(AesGcmWithKeyCheckValueKeyManager().ValidateKeyFormat(format),
+                IsOk());
+  }
+  for (int key_check_value_size : {0, 1, 3, 17}) {
+    format.set_key_check_value_size(key_check_value_size);
+    EXPECT_THAT(AesGcmWithKeyCheckValueKeyManager().ValidateKeyFormat(format),
+                StatusIs(absl::StatusCode::kInvalidArgument));
+  }
+  format.set_key_check_value_size(8);
+  format.set_key_size(24);
+  EXPECT_THAT(AesGcmWithKeyCheckValueKeyManager().ValidateKeyFormat(format),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(AesGcmWithKeyCheckValueKeyManagerTest, ValidateKey) {
+  AesGcmWithKeyCheckValueKey key;
+  key.set_version(0);
+  key.set_key_value(std::string(32, 'a'));
+  key.set_key_check_value_size(8);
+  EXPECT_THAT(AesGcmWithKeyCheckValueKeyManager().ValidateKey(key), IsOk());
+  key.set_key_check_value_size(2);
+  EXPECT_THAT(AesGcmWithKeyCheckValueKeyManager().ValidateKey(key),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  key.set_key_check_value_size(8);
+  key.set_version(1);
+  EXPECT_THAT(AesGcmWithKeyCheckValueKeyManager().ValidateKey(key),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(AesGcmWithKeyCheckValueKeyManagerTest, CreateAead) {
+  AesGcmWithKeyCheckValueKeyFormat format;
+  format.set_key_size(32);
+  format.set_key_check_value_size(8);
+  StatusOr<AesGcmWithKeyCheckValueKey> key =
+      AesGcmWithKeyCheckValueKeyManager().CreateKey(format);
+  ASSERT_THAT(key, IsOk());
+  EXPECT_THAT(key->key_check_value_size(), Eq(8));
+  ASSERT_THAT(AesGcmWithKeyCheckValueKeyManager().ValidateKey(*key), IsOk());
+
+  StatusOr<std::unique_ptr<Aead>> aead =
+      AesGcmWithKeyCheckValueKeyManager().GetPrimitive<Aead>(*key);
+  ASSERT_THAT(aead, IsOk());
+  StatusOr<std::string> ciphertext = (*aead)->Encrypt("message", "aad");
+  ASSERT_THAT(ciphertext, IsOk());
+
+  // The ciphertext is the key check value followed by an AES-GCM ciphertext.
+  util::SecretData key_value = util::SecretDataFromStringView(key->key_value());
+  StatusOr<std::string> key_check_value =
+      internal::ComputeKeyCheckValue(key_value, 8);
+  ASSERT_THAT(key_check_value, IsOk());
+  EXPECT_THAT(*ciphertext, StartsWith(*key_check_value));
+  StatusOr<std::unique_ptr<Aead>> boring_ssl_aead =
+      subtle::AesGcmBoringSsl::New(key_value);
+  ASSERT_THAT(boring_ssl_aead, IsOk());
+  EXPECT_THAT((*boring_ssl_aead)->Decrypt(ciphertext->substr(8), "aad"),
+              IsOkAndHolds("message"));
+  EXPECT_THAT((*aead)->Decrypt(*ciphertext, "aad"), IsOkAndHolds("message"));
+
+  // A different key is rejected by its key check value.
+  StatusOr<AesGcmWithKeyCheckValueKey> other_key =
+      AesGcmWithKeyCheckValueKeyManager().CreateKey(format);
+  ASSERT_THAT(other_key, IsOk());
+  StatusOr<std::unique_ptr<Aead>> other_aead =
+      AesGcmWithKeyCheckValueKeyManager().GetPrimitive<Aead>(*other_key);
+  ASSERT_THAT(other_aead, IsOk());
+  EXPECT_THAT((*other_aead)->Decrypt(*ciphertext, "aad").status(),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       HasSubstr("Key check value mismatch")));
+}
+
+TEST(AesGcmWithKeyCheckValueKeyManagerTest, CreateCordAead) {
+  AesGcmWithKeyCheckValueKeyFormat format;
+  format.set_key_size(32);
+  format.set_key_check_value_size(4);
+  StatusOr<AesGcmWithKeyCheckValueKey> key =
+      AesGcmWithKeyCheckValueKeyManager().CreateKey(format);
+  ASSERT_THAT(key, IsOk());
+
+  StatusOr<std::unique_ptr<CordAead>> cord_aead =
+      AesGcmWithKeyCheckValueKeyManager().GetPrimitive<CordAead>(*key);
+  ASSERT_THAT(cord_aead, IsOk());
+  StatusOr<std::unique_ptr<Aead>> aead =
+      AesGcmWithKeyCheckValueKeyManager().GetPrimitive<Aead>(*key);
+  ASSERT_THAT(aead, IsOk());
+
+  // Both primitives produce the same ciphertext format.
+  StatusOr<std::string> ciphertext = (*aead)->Encrypt("message", "aad");
+  ASSERT_THAT(ciphertext, IsOk());
+  EXPECT_THAT(
+      (*cord_aead)->Decrypt(absl::Cord(*ciphertext), absl::Cord("aad")),
+      IsOkAndHolds(absl::Cord("message")));
+  StatusOr<absl::Cord> cord_ciphertext =
+      (*cord_aead)->Encrypt(absl::Cord("message"), absl::Cord("aad"));
+  ASSERT_THAT(cord_ciphertext, IsOk());
+  EXPECT_THAT((*aead)->Decrypt(std::string(*cord_ciphertext), "aad"),
+              IsOkAndHolds("message"));
+}
+
+TEST(AesGcmWithKeyCheckValueKeyManagerTest, DeriveKey) {
+  AesGcmWithKeyCheckValueKeyFormat format;
+  format.set_key_size(16);
+  format.set_version(0);
+  format.set_key_check_value_size(8);
+
+  IstreamInputStream input_stream{
+      absl::make_unique<std::stringstream>("0123456789abcdefghijklmnop")};
+
+  StatusOr<AesGcmWithKeyCheckValueKey> key =
+      AesGcmWithKeyCheckValueKeyManager().DeriveKey(format, &input_stream);
+  ASSERT_THAT(key, IsOk());
+  EXPECT_THAT(key->key_value(), Eq("0123456789abcdef"));
+  EXPECT_THAT(key->key_check_value_size(), Eq(8));
+}
+
+TEST(AesGcmWithKeyCheckValueKeyManagerTest, DeriveKeyNotEnoughRandomness) {
+  AesGcmWithKeyCheckValueKeyFormat format;
+  format.set_key_size(32);
+  format.set_version(0);
+  format.set_key_check_value_size(8);
+
+  IstreamInputStream input_stream{
+      absl::make_unique<std::stringstream>("0123456789")};
+
+  EXPECT_THAT(AesGcmWithKeyCheckValueKeyManager()
+                  .DeriveKey(format, &input_stream)
+                  .status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
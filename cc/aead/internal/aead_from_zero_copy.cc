@@ -15,9 +15,15 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include "tink/aead/internal/aead_from_zero_copy.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "absl/memory/memory.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "tink/aead/internal/zero_copy_aead.h"
 #include "tink/subtle/subtle_util.h"
 #include "tink/util/statusor.h"
@@ -54,6 +60,75 @@ util::StatusOr<std::string> AeadFromZeroCopy::Decrypt(
   return result;
 }
 
+util::StatusOr<int64_t> AeadFromZeroCopy::MaxEncryptionSize(
+    int64_t plaintext_size) const {
+  return aead_->MaxEncryptionSize(plaintext_size);
+}
+
+util::StatusOr<std::vector<std::string>> AeadFromZeroCopy::EncryptBatch(
+    absl::Span<const absl::string_view> plaintexts,
+    absl::Span<const absl::string_view> associated_data) const {
+  std::vector<std::string> results(plaintexts.size());
+  std::vector<absl::Span<char>> buffers(plaintexts.size());
+  for (size_t i = 0; i < plaintexts.size(); ++i) {
+    subtle::ResizeStringUninitialized(
+        &results[i], aead_->MaxEncryptionSize(plaintexts[i].size()));
+    buffers[i] = absl::MakeSpan(&results[i][0], results[i].size());
+  }
+  util::StatusOr<std::vector<int64_t>> written_bytes =
+      aead_->EncryptBatch(plaintexts, associated_data, buffers);
+  if (!written_bytes.ok()) {
+    return written_bytes.status();
+  }
+  for (size_t i = 0; i < results.size(); ++i) {
+    results[i].resize((*written_bytes)[i]);
+  }
+  return results;
+}
+
+util::StatusOr<std::vector<util::StatusOr<std::string>>>
+AeadFromZeroCopy::DecryptBatch(
+    absl::Span<const absl::string_view> ciphertexts,
+    absl::Span<const absl::string_view> associated_data) const {
+  std::vector<std::string> plaintexts(ciphertexts.size());
+  std::vector<absl::Span<char>> buffers(ciphertexts.size());
+  for (size_t i = 0; i < ciphertexts.size(); ++i) {
+    subtle::ResizeStringUninitialized(
+        &plaintexts[i], aead_->MaxDecryptionSize(ciphertexts[i].size()));
+    buffers[i] = absl::MakeSpan(&plaintexts[i][0], plaintexts[i].size());
+  }
+  util::StatusOr<std::vector<util::StatusOr<int64_t>>> written_bytes =
+      aead_->DecryptBatch(ciphertexts, associated_data, buffers);
+  if (!written_bytes.ok()) {
+    return written_bytes.status();
+  }
+  std::vector<util::StatusOr<std::string>> results;
+  results.reserve(plaintexts.size());
+  for (size_t i = 0; i < plaintexts.size(); ++i) {
+    if (!(*written_bytes)[i].ok()) {
+      results.push_back((*written_bytes)[i].status());
+      continue;
+    }
+    plaintexts[i].resize(*(*written_bytes)[i]);
+    results.push_back(std::move(plaintexts[i]));
+  }
+  return results;
+}
+
+util::StatusOr<int64_t> AeadFromZeroCopy::EncryptFragments(
+    absl::Span<const absl::string_view> plaintext,
+    absl::string_view associated_data,
+    absl::Span<const absl::Span<char>> ciphertext) const {
+  return aead_->EncryptFragments(plaintext, associated_data, ciphertext);
+}
+
+util::StatusOr<int64_t> AeadFromZeroCopy::DecryptFragments(
+    absl::Span<const absl::string_view> ciphertext,
+    absl::string_view associated_data,
+    absl::Span<const absl::Span<char>> plaintext) const {
+  return aead_->DecryptFragments(ciphertext, associated_data, plaintext);
+}
+
 }  // namespace internal
 }  // namespace tink
 }  // namespace crypto
@@ -16,12 +16,16 @@
 #ifndef TINK_AEAD_INTERNAL_AEAD_FROM_ZERO_COPY_H_
 #define TINK_AEAD_INTERNAL_AEAD_FROM_ZERO_COPY_H_
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "tink/aead.h"
 #include "tink/aead/internal/zero_copy_aead.h"
 #include "tink/subtle/subtle_util.h"
@@ -50,6 +54,34 @@ class AeadFromZeroCopy : public Aead {
       absl::string_view ciphertext,
       absl::string_view associated_data) const override;
 
+  // Returns ZeroCopyAead::MaxEncryptionSize().
+  crypto::tink::util::StatusOr<int64_t> MaxEncryptionSize(
+      int64_t plaintext_size) const override;
+
+  // Encrypts all messages with a single ZeroCopyAead::EncryptBatch() call.
+  crypto::tink::util::StatusOr<std::vector<std::string>> EncryptBatch(
+      absl::Span<const absl::string_view> plaintexts,
+      absl::Span<const absl::string_view> associated_data) const override;
+
+  // Decrypts all messages with a single ZeroCopyAead::DecryptBatch() call.
+  crypto::tink::util::StatusOr<
+      std::vector<crypto::tink::util::StatusOr<std::string>>>
+  DecryptBatch(absl::Span<const absl::string_view> ciphertexts,
+               absl::Span<const absl::string_view> associated_data)
+      const override;
+
+  // Encrypts with ZeroCopyAead::EncryptFragments().
+  crypto::tink::util::StatusOr<int64_t> EncryptFragments(
+      absl::Span<const absl::string_view> plaintext,
+      absl::string_view associated_data,
+      absl::Span<const absl::Span<char>> ciphertext) const override;
+
+  // Decrypts with ZeroCopyAead::DecryptFragments().
+  crypto::tink::util::StatusOr<int64_t> DecryptFragments(
+      absl::Span<const absl::string_view> ciphertext,
+      absl::string_view associated_data,
+      absl::Span<const absl::Span<char>> plaintext) const override;
+
  private:
   const std::unique_ptr<ZeroCopyAead> aead_;
 };
@@ -24,9 +24,11 @@
 #include "gtest/gtest.h"
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/span.h"
 #include "tink/aead/internal/mock_zero_copy_aead.h"
+#include "tink/util/request_arena.h"
 #include "tink/util/statusor.h"
 #include "tink/util/test_matchers.h"
 
@@ -76,6 +78,24 @@ TEST(AeadFromZeroCopyTest, EncryptFailsIfZeroCopyEncryptFails) {
               StatusIs(absl::StatusCode::kInternal));
 }
 
+TEST(AeadFromZeroCopyTest, EncryptWithPrefixSucceeds) {
+  auto mock_zero_copy_aead = std::make_unique<MockZeroCopyAead>();
+  EXPECT_CALL(*mock_zero_copy_aead, MaxEncryptionSize(kPlaintext.size()))
+      .WillOnce(Return(kCiphertext.size()));
+  EXPECT_CALL(*mock_zero_copy_aead, Encrypt(kPlaintext, kAssociatedData, _))
+      .WillOnce(Invoke([&](Unused, Unused, absl::Span<char> buffer) {
+        EXPECT_EQ(buffer.size(), kCiphertext.size());
+        memcpy(buffer.data(), kCiphertext.data(), kCiphertext.size());
+        return kCiphertext.size();
+      }));
+
+  AeadFromZeroCopy aead(std::move(mock_zero_copy_aead));
+  StatusOr<std::string> ciphertext =
+      aead.EncryptWithPrefix("prefix", kPlaintext, kAssociatedData);
+  ASSERT_THAT(ciphertext, IsOk());
+  EXPECT_EQ(*ciphertext, absl::StrCat("prefix", kCiphertext));
+}
+
 TEST(AeadFromZeroCopyTest, DecryptSucceeds) {
   auto mock_zero_copy_aead = std::make_unique<MockZeroCopyAead>();
   EXPECT_CALL(*mock_zero_copy_aead, MaxDecryptionSize(kCiphertext.size()))
@@ -104,6 +124,29 @@ TEST(AeadFromZeroCopyTest, EncryptFailsIfZeroCopyDecryptFails) {
               StatusIs(absl::StatusCode::kInternal));
 }
 
+TEST(AeadFromZeroCopyTest, DecryptWithArenaErasesOutputOnFailure) {
+  auto mock_zero_copy_aead = std::make_unique<MockZeroCopyAead>();
+  EXPECT_CALL(*mock_zero_copy_aead, MaxDecryptionSize(kCiphertext.size()))
+      .WillOnce(Return(kPlaintext.size()));
+  absl::Span<char> output;
+  EXPECT_CALL(*mock_zero_copy_aead, Decrypt(kCiphertext, kAssociatedData, _))
+      .WillOnce(Invoke([&](Unused, Unused, absl::Span<char> buffer) {
+        memcpy(buffer.data(), kPlaintext.data(), kPlaintext.size());
+        output = buffer;
+        return Status(absl::StatusCode::kInternal, "Some error happened!");
+      }));
+
+  AeadFromZeroCopy aead(std::move(mock_zero_copy_aead));
+  util::RequestArena arena;
+  EXPECT_THAT(
+      aead.DecryptWithArena(kCiphertext, kAssociatedData, &arena).status(),
+      StatusIs(absl::StatusCode::kInternal));
+  // The arena keeps the memory until it is reset.
+  ASSERT_EQ(output.size(), kPlaintext.size());
+  EXPECT_EQ(absl::string_view(output.data(), output.size()),
+            std::string(kPlaintext.size(), '\0'));
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace tink
@@ -38,13 +38,34 @@ bool IsSupportedKmsEnvelopeAeadDekKeyType(absl::string_view key_type) {
   return kSupportedDekKeyTypes->contains(key_type);
 }
 
+namespace {
+
+// With OpenSSL 3, fetches `cipher` from the provider once so that later
+// EVP_CipherInit_ex calls skip the implicit fetch. Otherwise returns `cipher`.
+const EVP_CIPHER *Prefetch(const EVP_CIPHER *cipher) {
+#if !defined(OPENSSL_IS_BORINGSSL) && OPENSSL_VERSION_NUMBER >= 0x30000000L
+  EVP_CIPHER *fetched = EVP_CIPHER_fetch(
+      /*ctx=*/nullptr, EVP_CIPHER_get0_name(cipher), /*properties=*/nullptr);
+  if (fetched != nullptr) {
+    return fetched;
+  }
+#endif
+  return cipher;
+}
+
+}  // namespace
+
 util::StatusOr<const EVP_CIPHER *> GetAesGcmCipherForKeySize(
     uint32_t key_size_in_bytes) {
   switch (key_size_in_bytes) {
-    case 16:
-      return EVP_aes_128_gcm();
-    case 32:
-      return EVP_aes_256_gcm();
+    case 16: {
+      static const EVP_CIPHER *const kCipher = Prefetch(EVP_aes_128_gcm());
+      return kCipher;
+    }
+    case 32: {
+      static const EVP_CIPHER *const kCipher = Prefetch(EVP_aes_256_gcm());
+      return kCipher;
+    }
     default:
       return ToStatusF(absl::StatusCode::kInvalidArgument,
                        "Invalid key size %d", key_size_in_bytes);
@@ -0,0 +1,260 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/aead/internal/af_alg_aes_gcm.h"
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <linux/if_alg.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+#if defined(__linux__) && !defined(SOL_ALG)
+#define SOL_ALG 279
+#endif
+
+namespace crypto {
+namespace tink {
+namespace internal {
+
+#if defined(__linux__)
+
+namespace {
+
+util::Status ErrnoStatus(absl::StatusCode code, absl::string_view operation) {
+  return util::Status(code, absl::StrCat(operation, " failed: ",
+                                         std::strerror(errno)));
+}
+
+// Sets the socket buffer `option` of `fd` to at least `size` bytes. The kernel
+// caps the size at a system-wide limit, so the result is read back.
+bool SetBufferSize(int fd, int option, int size) {
+  if (setsockopt(fd, SOL_SOCKET, option, &size, sizeof(size)) != 0) {
+    return false;
+  }
+  int actual = 0;
+  socklen_t length = sizeof(actual);
+  return getsockopt(fd, SOL_SOCKET, option, &actual, &length) == 0 &&
+         actual >= size;
+}
+
+}  // namespace
+
+util::StatusOr<std::unique_ptr<AfAlgAesGcm>> AfAlgAesGcm::New(
+    const util::SecretData& key, int max_plaintext_size) {
+  if (key.size() != 16 && key.size() != 32) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "key must have 16 or 32 bytes");
+  }
+  if (max_plaintext_size < 0) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "max_plaintext_size must be non-negative");
+  }
+  int tfm_fd = socket(AF_ALG, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+  if (tfm_fd < 0) {
+    return ErrnoStatus(absl::StatusCode::kUnavailable, "AF_ALG socket");
+  }
+  int op_fd = -1;
+  int pipe_fds[2] = {-1, -1};
+  auto close_all = [&]() {
+    for (int fd : {tfm_fd, op_fd, pipe_fds[0], pipe_fds[1]}) {
+      if (fd >= 0) close(fd);
+    }
+  };
+
+  sockaddr_alg address = {};
+  address.salg_family = AF_ALG;
+  std::strcpy(reinterpret_cast<char*>(address.salg_type), "aead");
+  std::strcpy(reinterpret_cast<char*>(address.salg_name), "gcm(aes)");
+  if (bind(tfm_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) !=
+      0) {
+    util::Status status =
+        ErrnoStatus(absl::StatusCode::kUnavailable, "AF_ALG bind");
+    close_all();
+    return status;
+  }
+  if (setsockopt(tfm_fd, SOL_ALG, ALG_SET_KEY, key.data(), key.size()) != 0 ||
+      setsockopt(tfm_fd, SOL_ALG, ALG_SET_AEAD_AUTHSIZE, nullptr,
+                 kTagSizeInBytes) != 0) {
+    util::Status status =
+        ErrnoStatus(absl::StatusCode::kUnavailable, "AF_ALG setsockopt");
+    close_all();
+    return status;
+  }
+  op_fd = accept4(tfm_fd, nullptr, nullptr, SOCK_CLOEXEC);
+  if (op_fd < 0) {
+    util::Status status =
+        ErrnoStatus(absl::StatusCode::kUnavailable, "AF_ALG accept");
+    close_all();
+    return status;
+  }
+  // The kernel only starts an AEAD operation once all of its input has been
+  // queued, and queues input only while it fits into the send buffer; the
+  // output must fit into the receive buffer. Both need a spare page.
+  const int page_size = sysconf(_SC_PAGESIZE);
+  if (!SetBufferSize(op_fd, SO_SNDBUF, max_plaintext_size + 2 * page_size) ||
+      !SetBufferSize(op_fd, SO_RCVBUF,
+                     max_plaintext_size + kTagSizeInBytes + 2 * page_size)) {
+    close_all();
+    return util::Status(absl::StatusCode::kUnavailable,
+                        "AF_ALG socket buffers are too small for a segment");
+  }
+  if (pipe2(pipe_fds, O_CLOEXEC) != 0) {
+    util::Status status = ErrnoStatus(absl::StatusCode::kUnavailable, "pipe");
+    close_all();
+    return status;
+  }
+  return absl::WrapUnique(new AfAlgAesGcm(tfm_fd, op_fd, pipe_fds[0],
+                                          pipe_fds[1], max_plaintext_size));
+}
+
+AfAlgAesGcm::~AfAlgAesGcm() {
+  close(pipe_write_fd_);
+  close(pipe_read_fd_);
+  close(op_fd_);
+  close(tfm_fd_);
+}
+
+util::Status AfAlgAesGcm::EncryptFromFd(int plaintext_fd, int plaintext_size,
+                                        absl::string_view iv,
+                                        std::vector<uint8_t>* ciphertext) {
+  if (iv.size() != kIvSizeInBytes) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "iv has wrong size");
+  }
+  if (plaintext_size < 0 || plaintext_size > max_plaintext_size_) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "plaintext_size out of range");
+  }
+  if (ciphertext == nullptr) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "ciphertext must be non-null");
+  }
+
+  // Start an encryption with `iv` and no associated data. MSG_MORE keeps the
+  // operation open for the plaintext that is spliced in next.
+  alignas(cmsghdr) char control[CMSG_SPACE(sizeof(uint32_t)) +
+                                CMSG_SPACE(sizeof(af_alg_iv) + kIvSizeInBytes) +
+                                CMSG_SPACE(sizeof(uint32_t))] = {};
+  msghdr message = {};
+  message.msg_control = control;
+  message.msg_controllen = sizeof(control);
+  const uint32_t op = ALG_OP_ENCRYPT;
+  const uint32_t associated_data_size = 0;
+  cmsghdr* header = CMSG_FIRSTHDR(&message);
+  header->cmsg_level = SOL_ALG;
+  header->cmsg_type = ALG_SET_OP;
+  header->cmsg_len = CMSG_LEN(sizeof(op));
+  std::memcpy(CMSG_DATA(header), &op, sizeof(op));
+  header = CMSG_NXTHDR(&message, header);
+  header->cmsg_level = SOL_ALG;
+  header->cmsg_type = ALG_SET_IV;
+  header->cmsg_len = CMSG_LEN(sizeof(af_alg_iv) + kIvSizeInBytes);
+  const uint32_t iv_size = kIvSizeInBytes;
+  std::memcpy(CMSG_DATA(header) + offsetof(af_alg_iv, ivlen), &iv_size,
+              sizeof(iv_size));
+  std::memcpy(CMSG_DATA(header) + offsetof(af_alg_iv, iv), iv.data(),
+              iv.size());
+  header = CMSG_NXTHDR(&message, header);
+  header->cmsg_level = SOL_ALG;
+  header->cmsg_type = ALG_SET_AEAD_ASSOCLEN;
+  header->cmsg_len = CMSG_LEN(sizeof(associated_data_size));
+  std::memcpy(CMSG_DATA(header), &associated_data_size,
+              sizeof(associated_data_size));
+  if (sendmsg(op_fd_, &message, MSG_MORE) < 0) {
+    return ErrnoStatus(absl::StatusCode::kInternal, "AF_ALG sendmsg");
+  }
+
+  // Move the plaintext file -> pipe -> socket, a pipe buffer at a time.
+  int remaining = plaintext_size;
+  while (remaining > 0) {
+    ssize_t in = splice(plaintext_fd, nullptr, pipe_write_fd_, nullptr,
+                        remaining, SPLICE_F_MOVE);
+    if (in < 0 && errno == EINTR) continue;
+    if (in < 0) return ErrnoStatus(absl::StatusCode::kInternal, "splice");
+    if (in == 0) {
+      return util::Status(absl::StatusCode::kOutOfRange,
+                          "Unexpected end of plaintext file");
+    }
+    remaining -= in;
+    while (in > 0) {
+      ssize_t out = splice(pipe_read_fd_, nullptr, op_fd_, nullptr, in,
+                           SPLICE_F_MOVE | SPLICE_F_MORE);
+      if (out < 0 && errno == EINTR) continue;
+      if (out <= 0) return ErrnoStatus(absl::StatusCode::kInternal, "splice");
+      in -= out;
+    }
+  }
+  // An empty message without MSG_MORE completes the input.
+  msghdr end = {};
+  if (sendmsg(op_fd_, &end, 0) < 0) {
+    return ErrnoStatus(absl::StatusCode::kInternal, "AF_ALG sendmsg");
+  }
+
+  ciphertext->resize(plaintext_size + kTagSizeInBytes);
+  ssize_t read_size;
+  do {
+    read_size = read(op_fd_, ciphertext->data(), ciphertext->size());
+  } while (read_size < 0 && errno == EINTR);
+  if (read_size < 0) {
+    return ErrnoStatus(absl::StatusCode::kInternal, "AF_ALG read");
+  }
+  if (read_size != ciphertext->size()) {
+    return util::Status(absl::StatusCode::kInternal,
+                        "AF_ALG returned a truncated ciphertext");
+  }
+  return util::OkStatus();
+}
+
+#else  // defined(__linux__)
+
+util::StatusOr<std::unique_ptr<AfAlgAesGcm>> AfAlgAesGcm::New(
+    const util::SecretData& key, int max_plaintext_size) {
+  return util::Status(absl::StatusCode::kUnavailable,
+                      "AF_ALG is only available on Linux");
+}
+
+AfAlgAesGcm::~AfAlgAesGcm() = default;
+
+util::Status AfAlgAesGcm::EncryptFromFd(int plaintext_fd, int plaintext_size,
+                                        absl::string_view iv,
+                                        std::vector<uint8_t>* ciphertext) {
+  return util::Status(absl::StatusCode::kUnavailable,
+                      "AF_ALG is only available on Linux");
+}
+
+#endif  // defined(__linux__)
+
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,96 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef TINK_AEAD_INTERNAL_AF_ALG_AES_GCM_H_
+#define TINK_AEAD_INTERNAL_AF_ALG_AES_GCM_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+
+// AES-GCM encryption through the Linux kernel crypto API (AF_ALG), for
+// plaintext that is read from a file descriptor.
+//
+// The plaintext is moved from the file into the kernel's crypto socket with
+// splice(), through a pipe, so it never passes through user space. The kernel
+// has no splice support for reading from crypto sockets, so the ciphertext is
+// read back into a user-space buffer.
+//
+// This class is not thread-safe: each instance owns one operation socket.
+class AfAlgAesGcm {
+ public:
+  static constexpr int kIvSizeInBytes = 12;
+  static constexpr int kTagSizeInBytes = 16;
+
+  // Returns an encrypter with the 16 or 32 byte `key` that encrypts up to
+  // `max_plaintext_size` bytes per call. Returns an UNAVAILABLE error if the
+  // kernel cannot do this, e.g., if AF_ALG or "gcm(aes)" is not available
+  // (other platforms, sandboxes, missing modules), or if the socket buffer
+  // cannot hold `max_plaintext_size` bytes. Callers are expected to fall back
+  // to user-space encryption in that case.
+  static crypto::tink::util::StatusOr<std::unique_ptr<AfAlgAesGcm>> New(
+      const crypto::tink::util::SecretData& key, int max_plaintext_size);
+
+  // Not copyable or movable.
+  AfAlgAesGcm(const AfAlgAesGcm&) = delete;
+  AfAlgAesGcm& operator=(const AfAlgAesGcm&) = delete;
+
+  ~AfAlgAesGcm();
+
+  // Encrypts the next `plaintext_size` bytes of `plaintext_fd` with `iv` and
+  // empty associated data, and stores ciphertext || tag in `*ciphertext`.
+  // Reading starts at the current file offset of `plaintext_fd` and advances
+  // it. `plaintext_fd` must support splice(), e.g., a regular file. After an
+  // error the operation socket may hold a partial request, so the instance
+  // must not be used again.
+  crypto::tink::util::Status EncryptFromFd(int plaintext_fd,
+                                           int plaintext_size,
+                                           absl::string_view iv,
+                                           std::vector<uint8_t>* ciphertext);
+
+ private:
+  AfAlgAesGcm(int tfm_fd, int op_fd, int pipe_read_fd, int pipe_write_fd,
+              int max_plaintext_size)
+      : tfm_fd_(tfm_fd),
+        op_fd_(op_fd),
+        pipe_read_fd_(pipe_read_fd),
+        pipe_write_fd_(pipe_write_fd),
+        max_plaintext_size_(max_plaintext_size) {}
+
+  // The socket that holds the key, and the socket for encryption operations
+  // that is accepted from it.
+  const int tfm_fd_;
+  const int op_fd_;
+  const int pipe_read_fd_;
+  const int pipe_write_fd_;
+  const int max_plaintext_size_;
+};
+
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_AEAD_INTERNAL_AF_ALG_AES_GCM_H_
@@ -0,0 +1,132 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/aead/internal/af_alg_aes_gcm.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "tink/aead/internal/ssl_aead.h"
+#include "tink/internal/test_file_util.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/subtle_util.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "tink/util/test_util.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::testing::ElementsAreArray;
+
+constexpr int kMaxPlaintextSize = 1 << 16;
+
+// Writes `contents` to a new test file and returns a descriptor to read it.
+int OpenTestFile(absl::string_view contents) {
+  std::string filename = absl::StrCat(GetTestFileNamePrefix(), "_plaintext");
+  EXPECT_THAT(CreateTestFile(filename, contents), IsOk());
+  std::string path = absl::StrCat(test::TmpDir(), "/", filename);
+  int fd = open(path.c_str(), O_RDONLY);
+  EXPECT_GE(fd, 0);
+  return fd;
+}
+
+TEST(AfAlgAesGcmTest, RejectsInvalidKeySize) {
+  EXPECT_THAT(AfAlgAesGcm::New(util::SecretDataFromStringView(
+                                   subtle::Random::GetRandomBytes(24)),
+                               kMaxPlaintextSize)
+                  .status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(AfAlgAesGcmTest, MatchesUserSpaceAesGcm) {
+  for (int key_size : {16, 32}) {
+    util::SecretData key = util::SecretDataFromStringView(
+        subtle::Random::GetRandomBytes(key_size));
+    util::StatusOr<std::unique_ptr<AfAlgAesGcm>> kernel =
+        AfAlgAesGcm::New(key, kMaxPlaintextSize);
+    if (absl::IsUnavailable(kernel.status())) {
+      GTEST_SKIP() << "AF_ALG is not available: " << kernel.status();
+    }
+    ASSERT_THAT(kernel, IsOk());
+    util::StatusOr<std::unique_ptr<SslOneShotAead>> user_space =
+        CreateAesGcmOneShotCrypter(key);
+    ASSERT_THAT(user_space, IsOk());
+
+    for (int size : {0, 1, 4095, 4096, 40000,
+                     kMaxPlaintextSize}) {
+      SCOPED_TRACE(absl::StrCat("key_size: ", key_size, " size: ", size));
+      std::string plaintext = subtle::Random::GetRandomBytes(size);
+      std::string iv =
+          subtle::Random::GetRandomBytes(AfAlgAesGcm::kIvSizeInBytes);
+      int fd = OpenTestFile(plaintext);
+      std::vector<uint8_t> ciphertext;
+      ASSERT_THAT((*kernel)->EncryptFromFd(fd, size, iv, &ciphertext),
+                  IsOk());
+      close(fd);
+
+      std::string expected;
+      subtle::ResizeStringUninitialized(
+          &expected, (*user_space)->CiphertextSize(plaintext.size()));
+      ASSERT_THAT((*user_space)
+                      ->Encrypt(plaintext, /*associated_data=*/"", iv,
+                                absl::MakeSpan(expected)),
+                  IsOk());
+      EXPECT_THAT(ciphertext, ElementsAreArray(expected.begin(),
+                                               expected.end()));
+    }
+  }
+}
+
+TEST(AfAlgAesGcmTest, FailsOnShortFile) {
+  util::StatusOr<std::unique_ptr<AfAlgAesGcm>> kernel = AfAlgAesGcm::New(
+      util::SecretDataFromStringView(subtle::Random::GetRandomBytes(16)),
+      kMaxPlaintextSize);
+  if (absl::IsUnavailable(kernel.status())) {
+    GTEST_SKIP() << "AF_ALG is not available: " << kernel.status();
+  }
+  ASSERT_THAT(kernel, IsOk());
+  int fd = OpenTestFile("short");
+  std::vector<uint8_t> ciphertext;
+  EXPECT_THAT(
+      (*kernel)->EncryptFromFd(
+          fd, 100,
+          subtle::Random::GetRandomBytes(AfAlgAesGcm::kIvSizeInBytes),
+          &ciphertext),
+      StatusIs(absl::StatusCode::kOutOfRange));
+  close(fd);
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,74 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/aead/internal/key_check_aead.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "openssl/crypto.h"
+#include "tink/aead.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+
+util::StatusOr<std::unique_ptr<Aead>> KeyCheckAead::New(
+    std::unique_ptr<Aead> aead, std::string key_check_value) {
+  if (aead == nullptr) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "aead must be non-null");
+  }
+  if (key_check_value.empty()) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "key_check_value must be non-empty");
+  }
+  return {absl::WrapUnique(
+      new KeyCheckAead(std::move(aead), std::move(key_check_value)))};
+}
+
+util::StatusOr<std::string> KeyCheckAead::Encrypt(
+    absl::string_view plaintext, absl::string_view associated_data) const {
+  util::StatusOr<std::string> ciphertext =
+      aead_->Encrypt(plaintext, associated_data);
+  if (!ciphertext.ok()) {
+    return ciphertext.status();
+  }
+  return absl::StrCat(key_check_value_, *ciphertext);
+}
+
+util::StatusOr<std::string> KeyCheckAead::Decrypt(
+    absl::string_view ciphertext, absl::string_view associated_data) const {
+  if (ciphertext.size() < key_check_value_.size() ||
+      CRYPTO_memcmp(ciphertext.data(), key_check_value_.data(),
+                    key_check_value_.size()) != 0) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "Key check value mismatch");
+  }
+  return aead_->Decrypt(ciphertext.substr(key_check_value_.size()),
+                        associated_data);
+}
+
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
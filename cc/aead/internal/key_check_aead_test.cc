@@ -0,0 +1,117 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/aead/internal/key_check_aead.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "tink/aead.h"
+#include "tink/aead/mock_aead.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "tink/util/test_util.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+namespace {
+
+using ::crypto::tink::test::DummyAead;
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::IsOkAndHolds;
+using ::crypto::tink::test::StatusIs;
+using ::testing::_;
+using ::testing::HasSubstr;
+using ::testing::Return;
+
+constexpr absl::string_view kPlaintext = "Some data to encrypt.";
+constexpr absl::string_view kAssociatedData = "Some associated data.";
+constexpr absl::string_view kKeyCheckValue = "\x01\x02\x03\x04";
+
+TEST(KeyCheckAeadTest, EncryptPrependsKeyCheckValue) {
+  util::StatusOr<std::unique_ptr<Aead>> aead = KeyCheckAead::New(
+      absl::make_unique<DummyAead>("aead"), std::string(kKeyCheckValue));
+  ASSERT_THAT(aead, IsOk());
+
+  util::StatusOr<std::string> expected =
+      DummyAead("aead").Encrypt(kPlaintext, kAssociatedData);
+  ASSERT_THAT(expected, IsOk());
+  EXPECT_THAT((*aead)->Encrypt(kPlaintext, kAssociatedData),
+              IsOkAndHolds(absl::StrCat(kKeyCheckValue, *expected)));
+}
+
+TEST(KeyCheckAeadTest, EncryptDecrypt) {
+  util::StatusOr<std::unique_ptr<Aead>> aead = KeyCheckAead::New(
+      absl::make_unique<DummyAead>("aead"), std::string(kKeyCheckValue));
+  ASSERT_THAT(aead, IsOk());
+
+  util::StatusOr<std::string> ciphertext =
+      (*aead)->Encrypt(kPlaintext, kAssociatedData);
+  ASSERT_THAT(ciphertext, IsOk());
+  EXPECT_THAT((*aead)->Decrypt(*ciphertext, kAssociatedData),
+              IsOkAndHolds(kPlaintext));
+}
+
+TEST(KeyCheckAeadTest, MismatchingKeyCheckValueSkipsDecryption) {
+  auto mock_aead = absl::make_unique<MockAead>();
+  EXPECT_CALL(*mock_aead, Decrypt(_, _)).Times(0);
+  util::StatusOr<std::unique_ptr<Aead>> aead =
+      KeyCheckAead::New(std::move(mock_aead), std::string(kKeyCheckValue));
+  ASSERT_THAT(aead, IsOk());
+
+  EXPECT_THAT((*aead)
+                  ->Decrypt("\x01\x02\x03\x05 some ciphertext", kAssociatedData)
+                  .status(),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       HasSubstr("Key check value mismatch")));
+  EXPECT_THAT((*aead)->Decrypt("\x01\x02\x03", kAssociatedData).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(KeyCheckAeadTest, MatchingKeyCheckValueDecryptsRemainder) {
+  auto mock_aead = absl::make_unique<MockAead>();
+  EXPECT_CALL(*mock_aead,
+              Decrypt(absl::string_view("ciphertext"), kAssociatedData))
+      .WillOnce(Return(std::string(kPlaintext)));
+  util::StatusOr<std::unique_ptr<Aead>> aead =
+      KeyCheckAead::New(std::move(mock_aead), std::string(kKeyCheckValue));
+  ASSERT_THAT(aead, IsOk());
+
+  EXPECT_THAT((*aead)->Decrypt(absl::StrCat(kKeyCheckValue, "ciphertext"),
+                               kAssociatedData),
+              IsOkAndHolds(kPlaintext));
+}
+
+TEST(KeyCheckAeadTest, NewFailsWithInvalidArguments) {
+  EXPECT_THAT(KeyCheckAead::New(nullptr, std::string(kKeyCheckValue)).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(
+      KeyCheckAead::New(absl::make_unique<DummyAead>("aead"), "").status(),
+      StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,79 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/aead/internal/key_check_cord_aead.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "openssl/crypto.h"
+#include "tink/aead/cord_aead.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+
+util::StatusOr<std::unique_ptr<CordAead>> KeyCheckCordAead::New(
+    std::unique_ptr<CordAead> aead, std::string key_check_value) {
+  if (aead == nullptr) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "aead must be non-null");
+  }
+  if (key_check_value.empty()) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "key_check_value must be non-empty");
+  }
+  return {absl::WrapUnique(
+      new KeyCheckCordAead(std::move(aead), std::move(key_check_value)))};
+}
+
+util::StatusOr<absl::Cord> KeyCheckCordAead::Encrypt(
+    absl::Cord plaintext, absl::Cord associated_data) const {
+  util::StatusOr<absl::Cord> ciphertext =
+      aead_->Encrypt(std::move(plaintext), std::move(associated_data));
+  if (!ciphertext.ok()) {
+    return ciphertext.status();
+  }
+  absl::Cord result(key_check_value_);
+  result.Append(*std::move(ciphertext));
+  return result;
+}
+
+util::StatusOr<absl::Cord> KeyCheckCordAead::Decrypt(
+    absl::Cord ciphertext, absl::Cord associated_data) const {
+  if (ciphertext.size() < key_check_value_.size()) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "Key check value mismatch");
+  }
+  std::string key_check_value(ciphertext.Subcord(0, key_check_value_.size()));
+  if (CRYPTO_memcmp(key_check_value.data(), key_check_value_.data(),
+                    key_check_value_.size()) != 0) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "Key check value mismatch");
+  }
+  ciphertext.RemovePrefix(key_check_value_.size());
+  return aead_->Decrypt(std::move(ciphertext), std::move(associated_data));
+}
+
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,59 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_AEAD_INTERNAL_KEY_CHECK_CORD_AEAD_H_
+#define TINK_AEAD_INTERNAL_KEY_CHECK_CORD_AEAD_H_
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/strings/cord.h"
+#include "tink/aead/cord_aead.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+
+// CordAead counterpart of KeyCheckAead: prepends the key check value of its
+// key to every ciphertext and rejects ciphertexts with a different key check
+// value before decrypting them with the wrapped CordAead.
+class KeyCheckCordAead : public CordAead {
+ public:
+  // Wraps `aead`, whose key has the non-empty `key_check_value`.
+  static util::StatusOr<std::unique_ptr<CordAead>> New(
+      std::unique_ptr<CordAead> aead, std::string key_check_value);
+
+  util::StatusOr<absl::Cord> Encrypt(
+      absl::Cord plaintext, absl::Cord associated_data) const override;
+
+  util::StatusOr<absl::Cord> Decrypt(
+      absl::Cord ciphertext, absl::Cord associated_data) const override;
+
+ private:
+  KeyCheckCordAead(std::unique_ptr<CordAead> aead, std::string key_check_value)
+      : aead_(std::move(aead)), key_check_value_(std::move(key_check_value)) {}
+
+  const std::unique_ptr<CordAead> aead_;
+  const std::string key_check_value_;
+};
+
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_AEAD_INTERNAL_KEY_CHECK_CORD_AEAD_H_
@@ -0,0 +1,96 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/aead/internal/key_check_cord_aead.h"
+
+#include <memory>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/string_view.h"
+#include "tink/aead/cord_aead.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "tink/util/test_util.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+namespace {
+
+using ::crypto::tink::test::DummyCordAead;
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::IsOkAndHolds;
+using ::crypto::tink::test::StatusIs;
+using ::testing::HasSubstr;
+
+constexpr absl::string_view kPlaintext = "Some data to encrypt.";
+constexpr absl::string_view kAssociatedData = "Some associated data.";
+constexpr absl::string_view kKeyCheckValue = "\x01\x02\x03\x04";
+
+TEST(KeyCheckCordAeadTest, EncryptDecrypt) {
+  util::StatusOr<std::unique_ptr<CordAead>> aead = KeyCheckCordAead::New(
+      absl::make_unique<DummyCordAead>("aead"), std::string(kKeyCheckValue));
+  ASSERT_THAT(aead, IsOk());
+
+  util::StatusOr<absl::Cord> ciphertext = (*aead)->Encrypt(
+      absl::Cord(kPlaintext), absl::Cord(kAssociatedData));
+  ASSERT_THAT(ciphertext, IsOk());
+  EXPECT_TRUE(ciphertext->StartsWith(kKeyCheckValue));
+  EXPECT_THAT((*aead)->Decrypt(*ciphertext, absl::Cord(kAssociatedData)),
+              IsOkAndHolds(absl::Cord(kPlaintext)));
+}
+
+TEST(KeyCheckCordAeadTest, DecryptRejectsMismatchingKeyCheckValue) {
+  util::StatusOr<std::unique_ptr<CordAead>> aead = KeyCheckCordAead::New(
+      absl::make_unique<DummyCordAead>("aead"), std::string(kKeyCheckValue));
+  ASSERT_THAT(aead, IsOk());
+  util::StatusOr<std::unique_ptr<CordAead>> other_aead = KeyCheckCordAead::New(
+      absl::make_unique<DummyCordAead>("aead"), "\x01\x02\x03\x05");
+  ASSERT_THAT(other_aead, IsOk());
+
+  util::StatusOr<absl::Cord> ciphertext = (*other_aead)->Encrypt(
+      absl::Cord(kPlaintext), absl::Cord(kAssociatedData));
+  ASSERT_THAT(ciphertext, IsOk());
+  EXPECT_THAT(
+      (*aead)->Decrypt(*ciphertext, absl::Cord(kAssociatedData)).status(),
+      StatusIs(absl::StatusCode::kInvalidArgument,
+               HasSubstr("Key check value mismatch")));
+  EXPECT_THAT(
+      (*aead)
+          ->Decrypt(absl::Cord("\x01\x02"), absl::Cord(kAssociatedData))
+          .status(),
+      StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(KeyCheckCordAeadTest, NewFailsWithInvalidArguments) {
+  EXPECT_THAT(
+      KeyCheckCordAead::New(nullptr, std::string(kKeyCheckValue)).status(),
+      StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(
+      KeyCheckCordAead::New(absl::make_unique<DummyCordAead>("aead"), "")
+          .status(),
+      StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
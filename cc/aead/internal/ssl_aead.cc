@@ -17,15 +17,18 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <limits>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/cleanup/cleanup.h"
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/span.h"
 #include "openssl/crypto.h"
@@ -33,6 +36,7 @@
 #include "tink/aead/internal/aead_util.h"
 #include "tink/internal/call_with_core_dump_protection.h"
 #include "tink/internal/err_util.h"
+#include "tink/internal/fragments.h"
 #include "tink/internal/ssl_unique_ptr.h"
 #include "tink/internal/util.h"
 #include "tink/util/secret_data.h"
@@ -81,6 +85,147 @@ util::StatusOr<int64_t> UpdateCipher(EVP_CIPHER_CTX *context,
   return total_written_bytes;
 }
 
+// Like UpdateCipher(), but for the concatenation of the `data` fragments,
+// written across the `out` fragments. The `out` fragments must hold at least
+// as many bytes as `data`, and the cipher must output exactly as many bytes as
+// it is given, as AES-GCM does.
+//
+// Each EVP_CipherUpdate() call has a fixed cost that dominates for short
+// inputs, so runs of short pieces are gathered into a scratch buffer and
+// processed with a single call.
+util::Status UpdateCipherFragments(EVP_CIPHER_CTX *context,
+                                   absl::Span<const absl::string_view> data,
+                                   absl::Span<const absl::Span<char>> out) {
+  constexpr size_t kMinDirectUpdateSize = 256;
+  constexpr size_t kScratchSize = 4096;
+  char scratch_in[kScratchSize];
+  char scratch_out[kScratchSize];
+  size_t scratch_size = 0;
+  size_t scratch_used = 0;
+  // The scratch output is consecutive in the output, so it is enough to know
+  // where it starts: in `scratch_destination`, followed by the `out`
+  // fragments from `scratch_next_index` on.
+  absl::Span<char> scratch_destination;
+  size_t scratch_next_index = 0;
+  // Only the plaintext side of the scratch buffers needs to be erased.
+  char *scratch_plaintext =
+      EVP_CIPHER_CTX_encrypting(context) == 1 ? scratch_in : scratch_out;
+  auto cleanup = absl::MakeCleanup([&]() {
+    OPENSSL_cleanse(scratch_plaintext, scratch_used);
+  });
+
+  // Processes `input` into `output`, which have the same size.
+  auto update = [context](absl::string_view input,
+                          absl::Span<char> output) -> util::Status {
+    util::StatusOr<int64_t> written_bytes =
+        UpdateCipher(context, input, output);
+    if (!written_bytes.ok()) {
+      return written_bytes.status();
+    }
+    if (*written_bytes != input.size()) {
+      return util::Status(absl::StatusCode::kInternal,
+                          "Cipher output size differs from input size");
+    }
+    return util::OkStatus();
+  };
+  auto flush_scratch = [&]() -> util::Status {
+    if (scratch_size == 0) {
+      return util::OkStatus();
+    }
+    util::Status status =
+        update(absl::string_view(scratch_in, scratch_size),
+               absl::MakeSpan(scratch_out, scratch_size));
+    if (!status.ok()) {
+      return status;
+    }
+    absl::string_view output(scratch_out, scratch_size);
+    const size_t size = std::min(output.size(), scratch_destination.size());
+    std::memcpy(scratch_destination.data(), output.data(), size);
+    output.remove_prefix(size);
+    CopyToFragments(output, out.subspan(scratch_next_index));
+    scratch_size = 0;
+    return util::OkStatus();
+  };
+
+  size_t out_index = 0;
+  absl::Span<char> out_fragment;
+  for (absl::string_view fragment : data) {
+    while (!fragment.empty()) {
+      while (out_fragment.empty()) {
+        if (out_index == out.size()) {
+          return util::Status(absl::StatusCode::kInternal,
+                              "Output fragments too small");
+        }
+        out_fragment = out[out_index++];
+      }
+      const size_t size = std::min(fragment.size(), out_fragment.size());
+      util::Status status;
+      if (size >= kMinDirectUpdateSize) {
+        status = flush_scratch();
+        if (status.ok()) {
+          status = update(fragment.substr(0, size),
+                          out_fragment.subspan(0, size));
+        }
+      } else if (scratch_size + size > kScratchSize) {
+        status = flush_scratch();
+      }
+      if (!status.ok()) {
+        return status;
+      }
+      if (size < kMinDirectUpdateSize) {
+        if (scratch_size == 0) {
+          scratch_destination = out_fragment;
+          scratch_next_index = out_index;
+        }
+        std::memcpy(scratch_in + scratch_size, fragment.data(), size);
+        scratch_size += size;
+        scratch_used = std::max(scratch_used, scratch_size);
+      }
+      fragment.remove_prefix(size);
+      out_fragment.remove_prefix(size);
+    }
+  }
+  return flush_scratch();
+}
+
+// Returns the concatenation of `fragments`, which is joined into `*buffer`
+// only if there is more than one fragment.
+absl::string_view Contiguous(absl::Span<const absl::string_view> fragments,
+                             std::string *buffer) {
+  if (fragments.empty()) {
+    return absl::string_view();
+  }
+  if (fragments.size() == 1) {
+    return fragments[0];
+  }
+  *buffer = absl::StrJoin(fragments, "");
+  return *buffer;
+}
+
+util::Status CheckAssociatedDataSize(absl::string_view associated_data) {
+  if (associated_data.size() > std::numeric_limits<int>::max()) {
+    return util::Status(
+        absl::StatusCode::kInvalidArgument,
+        absl::StrCat("Associated data too large; expected at most ",
+                     std::numeric_limits<int>::max(), " got ",
+                     associated_data.size()));
+  }
+  return util::OkStatus();
+}
+
+util::Status CheckBatchSizes(size_t num_messages, size_t num_associated_data,
+                             size_t num_ivs, size_t num_outputs) {
+  if (num_associated_data != num_messages || num_ivs != num_messages ||
+      num_outputs != num_messages) {
+    return util::Status(
+        absl::StatusCode::kInvalidArgument,
+        absl::StrCat("Batch sizes differ: ", num_messages, " messages, ",
+                     num_associated_data, " associated data, ", num_ivs,
+                     " IVs and ", num_outputs, " output buffers"));
+  }
+  return util::OkStatus();
+}
+
 class OpenSslOneShotAeadImpl : public SslOneShotAead {
  public:
   explicit OpenSslOneShotAeadImpl(const util::SecretData &key,
@@ -94,25 +239,10 @@ class OpenSslOneShotAeadImpl : public SslOneShotAead {
     absl::string_view plaintext_data = internal::EnsureStringNonNull(plaintext);
     absl::string_view ad = internal::EnsureStringNonNull(associated_data);
 
-    const int64_t min_out_buff_size = CiphertextSize(plaintext.size());
-    if (out.size() < min_out_buff_size) {
-      return util::Status(
-          absl::StatusCode::kInvalidArgument,
-          absl::StrCat("Encryption buffer too small; expected at least ",
-                       min_out_buff_size, " bytes, got ", out.size()));
-    }
-
-    if (BuffersOverlap(plaintext, absl::string_view(out.data(), out.size()))) {
-      return util::Status(absl::StatusCode::kInvalidArgument,
-                          "Plaintext and output buffer must not overlap");
-    }
-
-    if (associated_data.size() > std::numeric_limits<int>::max()) {
-      return util::Status(
-          absl::StatusCode::kInvalidArgument,
-          absl::StrCat("Associated data too large; expected at most ",
-                       std::numeric_limits<int>::max(), " got ",
-                       associated_data.size()));
+    util::Status status =
+        CheckEncryptionArguments(plaintext, associated_data, out);
+    if (!status.ok()) {
+      return status;
     }
 
     return internal::CallWithCoreDumpProtection(
@@ -125,36 +255,240 @@ class OpenSslOneShotAeadImpl : public SslOneShotAead {
                                   absl::Span<char> out) const override {
     absl::string_view ad = internal::EnsureStringNonNull(associated_data);
 
-    if (ciphertext.size() < tag_size_) {
+    util::Status status =
+        CheckDecryptionArguments(ciphertext, associated_data, out);
+    if (!status.ok()) {
+      return status;
+    }
+
+    return internal::CallWithCoreDumpProtection(
+        [&]() { return DecryptSensitive(ciphertext, ad, iv, out); });
+  }
+
+  // Keys a single context for the whole batch; each message then only resets
+  // the IV, skipping the key schedule and GHASH key setup.
+  util::StatusOr<std::vector<int64_t>> EncryptBatch(
+      absl::Span<const absl::string_view> plaintexts,
+      absl::Span<const absl::string_view> associated_data,
+      absl::Span<const absl::string_view> ivs,
+      absl::Span<const absl::Span<char>> out) const override {
+    util::Status status = CheckBatchSizes(plaintexts.size(),
+                                          associated_data.size(), ivs.size(),
+                                          out.size());
+    if (!status.ok()) {
+      return status;
+    }
+    for (size_t i = 0; i < plaintexts.size(); ++i) {
+      status = CheckEncryptionArguments(plaintexts[i], associated_data[i],
+                                        out[i]);
+      if (!status.ok()) {
+        return status;
+      }
+    }
+    if (plaintexts.empty()) {
+      return std::vector<int64_t>();
+    }
+
+    return internal::CallWithCoreDumpProtection(
+        [&]() -> util::StatusOr<std::vector<int64_t>> {
+          util::StatusOr<internal::SslUniquePtr<EVP_CIPHER_CTX>> context =
+              GetKeyedContext(/*encryption=*/true);
+          if (!context.ok()) {
+            return context.status();
+          }
+          std::vector<int64_t> written_bytes(plaintexts.size());
+          for (size_t i = 0; i < plaintexts.size(); ++i) {
+            util::Status status =
+                SetIv(context->get(), ivs[i], /*encryption=*/true);
+            if (!status.ok()) {
+              return status;
+            }
+            util::StatusOr<int64_t> written = EncryptWithContext(
+                context->get(), internal::EnsureStringNonNull(plaintexts[i]),
+                internal::EnsureStringNonNull(associated_data[i]), out[i]);
+            if (!written.ok()) {
+              return written.status();
+            }
+            written_bytes[i] = *written;
+          }
+          return written_bytes;
+        });
+  }
+
+  util::StatusOr<std::vector<util::StatusOr<int64_t>>> DecryptBatch(
+      absl::Span<const absl::string_view> ciphertexts,
+      absl::Span<const absl::string_view> associated_data,
+      absl::Span<const absl::string_view> ivs,
+      absl::Span<const absl::Span<char>> out) const override {
+    util::Status status = CheckBatchSizes(ciphertexts.size(),
+                                          associated_data.size(), ivs.size(),
+                                          out.size());
+    if (!status.ok()) {
+      return status;
+    }
+    if (ciphertexts.empty()) {
+      return std::vector<util::StatusOr<int64_t>>();
+    }
+
+    return internal::CallWithCoreDumpProtection(
+        [&]() -> util::StatusOr<std::vector<util::StatusOr<int64_t>>> {
+          util::StatusOr<internal::SslUniquePtr<EVP_CIPHER_CTX>> context =
+              GetKeyedContext(/*encryption=*/false);
+          if (!context.ok()) {
+            return context.status();
+          }
+          std::vector<util::StatusOr<int64_t>> results;
+          results.reserve(ciphertexts.size());
+          for (size_t i = 0; i < ciphertexts.size(); ++i) {
+            util::Status status = CheckDecryptionArguments(
+                ciphertexts[i], associated_data[i], out[i]);
+            if (status.ok()) {
+              status = SetIv(context->get(), ivs[i], /*encryption=*/false);
+            }
+            if (!status.ok()) {
+              results.push_back(status);
+              continue;
+            }
+            results.push_back(DecryptWithContext(
+                context->get(), ciphertexts[i],
+                internal::EnsureStringNonNull(associated_data[i]), out[i]));
+          }
+          return results;
+        });
+  }
+
+  // Feeds the fragments through a single cipher context, so that neither the
+  // plaintext nor the ciphertext is joined.
+  util::StatusOr<int64_t> EncryptFragments(
+      absl::Span<const absl::string_view> plaintext,
+      absl::string_view associated_data, absl::string_view iv,
+      absl::Span<const absl::Span<char>> out) const override {
+    const int64_t plaintext_size = FragmentsSize(plaintext);
+    const int64_t min_out_buff_size = CiphertextSize(plaintext_size);
+    if (FragmentsSize(out) < min_out_buff_size) {
       return util::Status(
           absl::StatusCode::kInvalidArgument,
-          absl::StrCat("Ciphertext buffer too small; expected at least ",
-                       tag_size_, " got ", ciphertext.size()));
+          absl::StrCat("Encryption buffer too small; expected at least ",
+                       min_out_buff_size, " bytes, got ", FragmentsSize(out)));
     }
+    if (FragmentsOverlap(plaintext, out)) {
+      return util::Status(absl::StatusCode::kInvalidArgument,
+                          "Plaintext and output buffer must not overlap");
+    }
+    util::Status status = CheckAssociatedDataSize(associated_data);
+    if (!status.ok()) {
+      return status;
+    }
+    absl::string_view ad = internal::EnsureStringNonNull(associated_data);
 
-    const int64_t min_out_buff_size = PlaintextSize(ciphertext.size());
-    if (out.size() < min_out_buff_size) {
+    return internal::CallWithCoreDumpProtection(
+        [&]() -> util::StatusOr<int64_t> {
+          util::StatusOr<internal::SslUniquePtr<EVP_CIPHER_CTX>> context =
+              GetContext(iv, /*encryption=*/true);
+          if (!context.ok()) {
+            return context.status();
+          }
+          int len = 0;
+          if (EVP_EncryptUpdate(context->get(), /*out=*/nullptr, &len,
+                                reinterpret_cast<const uint8_t *>(ad.data()),
+                                ad.size()) <= 0) {
+            return util::Status(absl::StatusCode::kInternal,
+                                "Failed to set associated data");
+          }
+          util::Status status = UpdateCipherFragments(
+              context->get(), plaintext, SubFragments(out, 0, plaintext_size));
+          if (!status.ok()) {
+            return status;
+          }
+          if (EVP_EncryptFinal_ex(context->get(), /*out=*/nullptr, &len) <= 0) {
+            return util::Status(absl::StatusCode::kInternal,
+                                "Finalization failed");
+          }
+          std::string tag(tag_size_, '\0');
+          if (EVP_CIPHER_CTX_ctrl(context->get(), EVP_CTRL_AEAD_GET_TAG,
+                                  tag_size_,
+                                  reinterpret_cast<uint8_t *>(&tag[0])) <= 0) {
+            return util::Status(absl::StatusCode::kInternal,
+                                "Failed to get the tag");
+          }
+          CopyToFragments(tag, SubFragments(out, plaintext_size, tag_size_));
+          return min_out_buff_size;
+        });
+  }
+
+  util::StatusOr<int64_t> DecryptFragments(
+      absl::Span<const absl::string_view> ciphertext,
+      absl::string_view associated_data, absl::string_view iv,
+      absl::Span<const absl::Span<char>> out) const override {
+    const int64_t ciphertext_size = FragmentsSize(ciphertext);
+    if (ciphertext_size < tag_size_) {
+      return util::Status(
+          absl::StatusCode::kInvalidArgument,
+          absl::StrCat("Ciphertext buffer too small; expected at least ",
+                       tag_size_, " got ", ciphertext_size));
+    }
+    const int64_t plaintext_size = PlaintextSize(ciphertext_size);
+    if (FragmentsSize(out) < plaintext_size) {
       return util::Status(
           absl::StatusCode::kInvalidArgument,
           absl::StrCat("Output buffer too small; expected at least ",
-                       min_out_buff_size, " got ", out.size()));
+                       plaintext_size, " got ", FragmentsSize(out)));
     }
-
-    if (BuffersOverlap(ciphertext, absl::string_view(out.data(), out.size()))) {
+    if (FragmentsOverlap(ciphertext, out)) {
       return util::Status(absl::StatusCode::kInvalidArgument,
                           "Ciphertext and output buffer must not overlap");
     }
-
-    if (associated_data.size() > std::numeric_limits<int>::max()) {
-      return util::Status(
-          absl::StatusCode::kInvalidArgument,
-          absl::StrCat("Associated data too large; expected at most ",
-                       std::numeric_limits<int>::max(), " got ",
-                       associated_data.size()));
+    util::Status status = CheckAssociatedDataSize(associated_data);
+    if (!status.ok()) {
+      return status;
     }
+    absl::string_view ad = internal::EnsureStringNonNull(associated_data);
 
     return internal::CallWithCoreDumpProtection(
-        [&]() { return DecryptSensitive(ciphertext, ad, iv, out); });
+        [&]() -> util::StatusOr<int64_t> {
+          util::StatusOr<internal::SslUniquePtr<EVP_CIPHER_CTX>> context =
+              GetContext(iv, /*encryption=*/false);
+          if (!context.ok()) {
+            return context.status();
+          }
+          int len = 0;
+          if (EVP_DecryptUpdate(context->get(), /*out=*/nullptr, &len,
+                                reinterpret_cast<const uint8_t *>(ad.data()),
+                                ad.size()) <= 0) {
+            return util::Status(absl::StatusCode::kInternal,
+                                "Failed to set associated_data");
+          }
+          std::string tag(tag_size_, '\0');
+          CopyFromFragments(
+              SubFragments(ciphertext, plaintext_size, tag_size_),
+              absl::MakeSpan(tag));
+          if (EVP_CIPHER_CTX_ctrl(context->get(), EVP_CTRL_AEAD_SET_TAG,
+                                  tag_size_,
+                                  reinterpret_cast<uint8_t *>(&tag[0])) <= 0) {
+            return util::Status(absl::StatusCode::kInternal,
+                                "Could not set authentication tag");
+          }
+
+          // Zero the plaintext fragments in case decryption fails before
+          // returning an error.
+          auto output_eraser = absl::MakeCleanup([out] {
+            for (absl::Span<char> fragment : out) {
+              OPENSSL_cleanse(fragment.data(), fragment.size());
+            }
+          });
+          util::Status status = UpdateCipherFragments(
+              context->get(), SubFragments(ciphertext, 0, plaintext_size),
+              SubFragments(out, 0, plaintext_size));
+          if (!status.ok()) {
+            return status;
+          }
+          if (!EVP_DecryptFinal_ex(context->get(), /*out=*/nullptr, &len)) {
+            return util::Status(absl::StatusCode::kInternal,
+                                "Authentication failed");
+          }
+          std::move(output_eraser).Cancel();
+          return plaintext_size;
+        });
   }
 
   int64_t CiphertextSize(int64_t plaintext_length) const override {
@@ -169,6 +503,51 @@ class OpenSslOneShotAeadImpl : public SslOneShotAead {
   }
 
  private:
+  util::Status CheckEncryptionArguments(absl::string_view plaintext,
+                                        absl::string_view associated_data,
+                                        absl::Span<char> out) const {
+    const int64_t min_out_buff_size = CiphertextSize(plaintext.size());
+    if (out.size() < min_out_buff_size) {
+      return util::Status(
+          absl::StatusCode::kInvalidArgument,
+          absl::StrCat("Encryption buffer too small; expected at least ",
+                       min_out_buff_size, " bytes, got ", out.size()));
+    }
+
+    if (BuffersOverlap(plaintext, absl::string_view(out.data(), out.size()))) {
+      return util::Status(absl::StatusCode::kInvalidArgument,
+                          "Plaintext and output buffer must not overlap");
+    }
+
+    return CheckAssociatedDataSize(associated_data);
+  }
+
+  util::Status CheckDecryptionArguments(absl::string_view ciphertext,
+                                        absl::string_view associated_data,
+                                        absl::Span<char> out) const {
+    if (ciphertext.size() < tag_size_) {
+      return util::Status(
+          absl::StatusCode::kInvalidArgument,
+          absl::StrCat("Ciphertext buffer too small; expected at least ",
+                       tag_size_, " got ", ciphertext.size()));
+    }
+
+    const int64_t min_out_buff_size = PlaintextSize(ciphertext.size());
+    if (out.size() < min_out_buff_size) {
+      return util::Status(
+          absl::StatusCode::kInvalidArgument,
+          absl::StrCat("Output buffer too small; expected at least ",
+                       min_out_buff_size, " got ", out.size()));
+    }
+
+    if (BuffersOverlap(ciphertext, absl::string_view(out.data(), out.size()))) {
+      return util::Status(absl::StatusCode::kInvalidArgument,
+                          "Ciphertext and output buffer must not overlap");
+    }
+
+    return CheckAssociatedDataSize(associated_data);
+  }
+
   util::StatusOr<uint64_t> EncryptSensitive(absl::string_view plaintext_data,
                                             absl::string_view ad,
                                             absl::string_view iv,
@@ -178,10 +557,22 @@ class OpenSslOneShotAeadImpl : public SslOneShotAead {
     if (!context.ok()) {
       return context.status();
     }
+    util::StatusOr<int64_t> written_bytes =
+        EncryptWithContext(context->get(), plaintext_data, ad, out);
+    if (!written_bytes.ok()) {
+      return written_bytes.status();
+    }
+    return *written_bytes;
+  }
 
+  // Encrypts with `context`, which must be initialized with key and IV.
+  util::StatusOr<int64_t> EncryptWithContext(EVP_CIPHER_CTX *context,
+                                             absl::string_view plaintext_data,
+                                             absl::string_view ad,
+                                             absl::Span<char> out) const {
     // Set the associated data.
     int len = 0;
-    if (EVP_EncryptUpdate(context->get(), /*out=*/nullptr, &len,
+    if (EVP_EncryptUpdate(context, /*out=*/nullptr, &len,
                           reinterpret_cast<const uint8_t *>(ad.data()),
                           ad.size()) <= 0) {
       return util::Status(absl::StatusCode::kInternal,
@@ -189,18 +580,18 @@ class OpenSslOneShotAeadImpl : public SslOneShotAead {
     }
 
     util::StatusOr<int64_t> raw_ciphertext_bytes =
-        UpdateCipher(context->get(), plaintext_data, out);
+        UpdateCipher(context, plaintext_data, out);
     if (!raw_ciphertext_bytes.ok()) {
       return raw_ciphertext_bytes.status();
     }
 
-    if (EVP_EncryptFinal_ex(context->get(), /*out=*/nullptr, &len) <= 0) {
+    if (EVP_EncryptFinal_ex(context, /*out=*/nullptr, &len) <= 0) {
       return util::Status(absl::StatusCode::kInternal, "Finalization failed");
     }
 
     // Write the tag after the ciphertext.
     absl::Span<char> tag = out.subspan(*raw_ciphertext_bytes, tag_size_);
-    if (EVP_CIPHER_CTX_ctrl(context->get(), EVP_CTRL_AEAD_GET_TAG, tag_size_,
+    if (EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_AEAD_GET_TAG, tag_size_,
                             reinterpret_cast<uint8_t *>(tag.data())) <= 0) {
       return util::Status(absl::StatusCode::kInternal, "Failed to get the tag");
     }
@@ -216,10 +607,22 @@ class OpenSslOneShotAeadImpl : public SslOneShotAead {
     if (!context.ok()) {
       return context.status();
     }
+    util::StatusOr<int64_t> written_bytes =
+        DecryptWithContext(context->get(), ciphertext, ad, out);
+    if (!written_bytes.ok()) {
+      return written_bytes.status();
+    }
+    return *written_bytes;
+  }
 
+  // Decrypts with `context`, which must be initialized with key and IV.
+  util::StatusOr<int64_t> DecryptWithContext(EVP_CIPHER_CTX *context,
+                                             absl::string_view ciphertext,
+                                             absl::string_view ad,
+                                             absl::Span<char> out) const {
     int len = 0;
     // Add the associated data.
-    if (EVP_DecryptUpdate(context->get(), /*out=*/nullptr, &len,
+    if (EVP_DecryptUpdate(context, /*out=*/nullptr, &len,
                           reinterpret_cast<const uint8_t *>(ad.data()),
                           ad.size()) <= 0) {
       return util::Status(absl::StatusCode::kInternal,
@@ -236,7 +639,7 @@ class OpenSslOneShotAeadImpl : public SslOneShotAead {
     auto tag = std::string(ciphertext.substr(raw_ciphertext_size, tag_size_));
 
     // Set the tag.
-    if (EVP_CIPHER_CTX_ctrl(context->get(), EVP_CTRL_AEAD_SET_TAG, tag_size_,
+    if (EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_AEAD_SET_TAG, tag_size_,
                             reinterpret_cast<uint8_t *>(&tag[0])) <= 0) {
       return util::Status(absl::StatusCode::kInternal,
                           "Could not set authentication tag");
@@ -258,12 +661,12 @@ class OpenSslOneShotAeadImpl : public SslOneShotAead {
         absl::MakeCleanup([out] { OPENSSL_cleanse(out.data(), out.size()); });
 
     util::StatusOr<int64_t> written_bytes =
-        UpdateCipher(context->get(), raw_ciphertext, out_buffer);
+        UpdateCipher(context, raw_ciphertext, out_buffer);
     if (!written_bytes.ok()) {
       return written_bytes.status();
     }
 
-    if (!EVP_DecryptFinal_ex(context->get(), /*out=*/nullptr, &len)) {
+    if (!EVP_DecryptFinal_ex(context, /*out=*/nullptr, &len)) {
       return util::Status(absl::StatusCode::kInternal, "Authentication failed");
     }
 
@@ -310,6 +713,45 @@ class OpenSslOneShotAeadImpl : public SslOneShotAead {
     return std::move(context);
   }
 
+  // Returns a new EVP_CIPHER_CTX initialized with the key but no IV, to be
+  // reused for several messages through SetIv().
+  util::StatusOr<internal::SslUniquePtr<EVP_CIPHER_CTX>> GetKeyedContext(
+      bool encryption) const {
+    internal::SslUniquePtr<EVP_CIPHER_CTX> context(EVP_CIPHER_CTX_new());
+    if (context == nullptr) {
+      return util::Status(absl::StatusCode::kInternal,
+                          "EVP_CIPHER_CTX_new failed");
+    }
+    const int encryption_flag = encryption ? 1 : 0;
+    if (EVP_CipherInit_ex(context.get(), cipher_, /*impl=*/nullptr,
+                          reinterpret_cast<const uint8_t *>(key_.data()),
+                          /*iv=*/nullptr, encryption_flag) <= 0) {
+      return util::Status(
+          absl::StatusCode::kInternal,
+          absl::StrCat("Failed to set key of size ", key_.size()));
+    }
+    return std::move(context);
+  }
+
+  // Starts a new message on a context returned by GetKeyedContext().
+  util::Status SetIv(EVP_CIPHER_CTX *context, absl::string_view iv,
+                     bool encryption) const {
+    if (EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_AEAD_SET_IVLEN, iv.size(),
+                            /*ptr=*/nullptr) <= 0) {
+      return util::Status(
+          absl::StatusCode::kInternal,
+          absl::StrCat("Failed setting size of the IV to ", iv.size()));
+    }
+    if (EVP_CipherInit_ex(context, /*cipher=*/nullptr, /*impl=*/nullptr,
+                          /*key=*/nullptr,
+                          reinterpret_cast<const uint8_t *>(iv.data()),
+                          encryption ? 1 : 0) <= 0) {
+      return util::Status(absl::StatusCode::kInternal,
+                          absl::StrCat("Failed to set IV of size ", iv.size()));
+    }
+    return util::OkStatus();
+  }
+
   const util::SecretData key_;
   const EVP_CIPHER *cipher_;
   const size_t tag_size_;
@@ -458,6 +900,119 @@ class BoringSslOneShotAeadImpl : public SslOneShotAead {
 
 }  // namespace
 
+util::StatusOr<std::vector<int64_t>> SslOneShotAead::EncryptBatch(
+    absl::Span<const absl::string_view> plaintexts,
+    absl::Span<const absl::string_view> associated_data,
+    absl::Span<const absl::string_view> ivs,
+    absl::Span<const absl::Span<char>> out) const {
+  util::Status status = CheckBatchSizes(
+      plaintexts.size(), associated_data.size(), ivs.size(), out.size());
+  if (!status.ok()) {
+    return status;
+  }
+  std::vector<int64_t> written_bytes(plaintexts.size());
+  for (size_t i = 0; i < plaintexts.size(); ++i) {
+    util::StatusOr<int64_t> written =
+        Encrypt(plaintexts[i], associated_data[i], ivs[i], out[i]);
+    if (!written.ok()) {
+      return written.status();
+    }
+    written_bytes[i] = *written;
+  }
+  return written_bytes;
+}
+
+util::StatusOr<std::vector<util::StatusOr<int64_t>>>
+SslOneShotAead::DecryptBatch(
+    absl::Span<const absl::string_view> ciphertexts,
+    absl::Span<const absl::string_view> associated_data,
+    absl::Span<const absl::string_view> ivs,
+    absl::Span<const absl::Span<char>> out) const {
+  util::Status status = CheckBatchSizes(
+      ciphertexts.size(), associated_data.size(), ivs.size(), out.size());
+  if (!status.ok()) {
+    return status;
+  }
+  std::vector<util::StatusOr<int64_t>> results;
+  results.reserve(ciphertexts.size());
+  for (size_t i = 0; i < ciphertexts.size(); ++i) {
+    results.push_back(
+        Decrypt(ciphertexts[i], associated_data[i], ivs[i], out[i]));
+  }
+  return results;
+}
+
+util::StatusOr<int64_t> SslOneShotAead::EncryptFragments(
+    absl::Span<const absl::string_view> plaintext,
+    absl::string_view associated_data, absl::string_view iv,
+    absl::Span<const absl::Span<char>> out) const {
+  if (FragmentsOverlap(plaintext, out)) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "Plaintext and output buffer must not overlap");
+  }
+  std::string joined_plaintext;
+  auto plaintext_eraser = absl::MakeCleanup([&joined_plaintext] {
+    OPENSSL_cleanse(&joined_plaintext[0], joined_plaintext.size());
+  });
+  absl::string_view contiguous_plaintext =
+      Contiguous(plaintext, &joined_plaintext);
+  const int64_t ciphertext_size = CiphertextSize(contiguous_plaintext.size());
+  if (!out.empty() && out[0].size() >= ciphertext_size) {
+    return Encrypt(contiguous_plaintext, associated_data, iv, out[0]);
+  }
+  if (FragmentsSize(out) < ciphertext_size) {
+    return util::Status(
+        absl::StatusCode::kInvalidArgument,
+        absl::StrCat("Encryption buffer too small; expected at least ",
+                     ciphertext_size, " bytes, got ", FragmentsSize(out)));
+  }
+  std::string ciphertext(ciphertext_size, '\0');
+  util::StatusOr<int64_t> written_bytes = Encrypt(
+      contiguous_plaintext, associated_data, iv, absl::MakeSpan(ciphertext));
+  if (!written_bytes.ok()) {
+    return written_bytes.status();
+  }
+  CopyToFragments(absl::string_view(ciphertext).substr(0, *written_bytes),
+                  out);
+  return *written_bytes;
+}
+
+util::StatusOr<int64_t> SslOneShotAead::DecryptFragments(
+    absl::Span<const absl::string_view> ciphertext,
+    absl::string_view associated_data, absl::string_view iv,
+    absl::Span<const absl::Span<char>> out) const {
+  if (FragmentsOverlap(ciphertext, out)) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "Ciphertext and output buffer must not overlap");
+  }
+  std::string joined_ciphertext;
+  absl::string_view contiguous_ciphertext =
+      Contiguous(ciphertext, &joined_ciphertext);
+  const int64_t plaintext_size = PlaintextSize(contiguous_ciphertext.size());
+  if (!out.empty() && out[0].size() >= plaintext_size) {
+    return Decrypt(contiguous_ciphertext, associated_data, iv, out[0]);
+  }
+  if (FragmentsSize(out) < plaintext_size) {
+    return util::Status(
+        absl::StatusCode::kInvalidArgument,
+        absl::StrCat("Output buffer too small; expected at least ",
+                     plaintext_size, " got ", FragmentsSize(out)));
+  }
+  std::string plaintext(plaintext_size, '\0');
+  auto plaintext_eraser = absl::MakeCleanup(
+      [&plaintext] { OPENSSL_cleanse(&plaintext[0], plaintext.size()); });
+  util::StatusOr<int64_t> written_bytes = Decrypt(
+      contiguous_ciphertext, associated_data, iv, absl::MakeSpan(plaintext));
+  if (!written_bytes.ok()) {
+    for (absl::Span<char> fragment : out) {
+      OPENSSL_cleanse(fragment.data(), fragment.size());
+    }
+    return written_bytes.status();
+  }
+  CopyToFragments(absl::string_view(plaintext).substr(0, *written_bytes), out);
+  return *written_bytes;
+}
+
 util::StatusOr<std::unique_ptr<SslOneShotAead>> CreateAesGcmOneShotCrypter(
     const util::SecretData &key) {
 #ifdef OPENSSL_IS_BORINGSSL
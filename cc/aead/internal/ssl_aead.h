@@ -18,6 +18,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "absl/strings/string_view.h"
 #include "absl/types/span.h"
@@ -63,6 +64,47 @@ class SslOneShotAead {
                                           absl::string_view associated_data,
                                           absl::string_view iv,
                                           absl::Span<char> out) const = 0;
+
+  // Encrypts many independent messages under this key, with output identical
+  // to calling Encrypt(plaintexts[i], associated_data[i], ivs[i], out[i]) for
+  // every i, and returns the number of bytes written to each `out[i]`. Fails
+  // if any message cannot be encrypted. Implementations override this to
+  // amortize per-message setup over the batch, which dominates the cost of
+  // small messages.
+  virtual util::StatusOr<std::vector<int64_t>> EncryptBatch(
+      absl::Span<const absl::string_view> plaintexts,
+      absl::Span<const absl::string_view> associated_data,
+      absl::Span<const absl::string_view> ivs,
+      absl::Span<const absl::Span<char>> out) const;
+
+  // Decrypts many independent messages under this key, as if by calling
+  // Decrypt(ciphertexts[i], associated_data[i], ivs[i], out[i]) for every i,
+  // and returns the result for each message. Only a malformed batch (e.g.,
+  // spans of different sizes) fails the whole call.
+  virtual util::StatusOr<std::vector<util::StatusOr<int64_t>>> DecryptBatch(
+      absl::Span<const absl::string_view> ciphertexts,
+      absl::Span<const absl::string_view> associated_data,
+      absl::Span<const absl::string_view> ivs,
+      absl::Span<const absl::Span<char>> out) const;
+
+  // Like Encrypt(), but the plaintext is the concatenation of the `plaintext`
+  // fragments, and the output is written across the `out` fragments, in
+  // order. The default implementation joins fragmented plaintexts and writes
+  // the output directly only if the first `out` fragment can hold all of it;
+  // implementations whose cipher can be fed incrementally override it to
+  // process the fragments without joining them.
+  virtual util::StatusOr<int64_t> EncryptFragments(
+      absl::Span<const absl::string_view> plaintext,
+      absl::string_view associated_data, absl::string_view iv,
+      absl::Span<const absl::Span<char>> out) const;
+
+  // Like Decrypt(), but the ciphertext is the concatenation of the
+  // `ciphertext` fragments, and the plaintext is written across the `out`
+  // fragments, in order. On failure, the `out` fragments hold no plaintext.
+  virtual util::StatusOr<int64_t> DecryptFragments(
+      absl::Span<const absl::string_view> ciphertext,
+      absl::string_view associated_data, absl::string_view iv,
+      absl::Span<const absl::Span<char>> out) const;
 };
 
 // Create one-shot crypters for the supported algorithms.
@@ -47,6 +47,7 @@ namespace internal {
 namespace {
 
 using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::IsOkAndHolds;
 using ::crypto::tink::test::StatusIs;
 using ::testing::AllOf;
 using ::testing::Eq;
@@ -415,6 +416,282 @@ TEST_P(SslOneShotAeadTest, BufferOverlapDecryptFails) {
       StatusIs(absl::StatusCode::kInvalidArgument));
 }
 
+// Independent messages, each with its own associated data and IV.
+struct Batch {
+  std::vector<std::string> messages;
+  std::vector<std::string> associated_data;
+  std::vector<std::string> ivs;
+};
+
+// Returns `num_messages` messages of increasing size.
+Batch MakeBatch(int num_messages, absl::string_view iv_hex) {
+  Batch batch;
+  for (int i = 0; i < num_messages; ++i) {
+    batch.messages.push_back(std::string(i * 5, 'a' + i % 26));
+    batch.associated_data.push_back(absl::StrCat("associated data ", i));
+    std::string iv = absl::HexStringToBytes(iv_hex);
+    iv[iv.size() - 1] = static_cast<char>(i);
+    batch.ivs.push_back(iv);
+  }
+  return batch;
+}
+
+TEST_P(SslOneShotAeadTest, EncryptBatchMatchesEncrypt) {
+  SslOneShotAeadTestParams test_param = GetParam();
+  util::StatusOr<std::unique_ptr<SslOneShotAead>> aead = CipherFromName(
+      test_param.cipher, util::SecretDataFromStringView(
+                             absl::HexStringToBytes(test_param.key_hex)));
+  ASSERT_THAT(aead, IsOk());
+
+  Batch batch = MakeBatch(/*num_messages=*/40, test_param.iv_hex);
+  std::vector<std::string> ciphertexts(batch.messages.size());
+  std::vector<absl::Span<char>> out;
+  for (size_t i = 0; i < batch.messages.size(); ++i) {
+    subtle::ResizeStringUninitialized(
+        &ciphertexts[i], (*aead)->CiphertextSize(batch.messages[i].size()));
+    out.push_back(absl::MakeSpan(ciphertexts[i]));
+  }
+  std::vector<absl::string_view> messages(batch.messages.begin(),
+                                          batch.messages.end());
+  std::vector<absl::string_view> associated_data(
+      batch.associated_data.begin(), batch.associated_data.end());
+  std::vector<absl::string_view> ivs(batch.ivs.begin(), batch.ivs.end());
+  util::StatusOr<std::vector<int64_t>> written_bytes =
+      (*aead)->EncryptBatch(messages, associated_data, ivs, out);
+  ASSERT_THAT(written_bytes, IsOk());
+  ASSERT_EQ(written_bytes->size(), messages.size());
+
+  for (size_t i = 0; i < messages.size(); ++i) {
+    EXPECT_EQ((*written_bytes)[i], ciphertexts[i].size());
+    std::string expected;
+    subtle::ResizeStringUninitialized(
+        &expected, (*aead)->CiphertextSize(messages[i].size()));
+    ASSERT_THAT((*aead)->Encrypt(messages[i], associated_data[i], ivs[i],
+                                 absl::MakeSpan(expected)),
+                IsOk());
+    EXPECT_EQ(ciphertexts[i], expected) << i;
+  }
+}
+
+TEST_P(SslOneShotAeadTest, DecryptBatchReportsEachMessage) {
+  SslOneShotAeadTestParams test_param = GetParam();
+  util::StatusOr<std::unique_ptr<SslOneShotAead>> aead = CipherFromName(
+      test_param.cipher, util::SecretDataFromStringView(
+                             absl::HexStringToBytes(test_param.key_hex)));
+  ASSERT_THAT(aead, IsOk());
+
+  Batch batch = MakeBatch(/*num_messages=*/20, test_param.iv_hex);
+  std::vector<std::string> ciphertexts(batch.messages.size());
+  for (size_t i = 0; i < batch.messages.size(); ++i) {
+    subtle::ResizeStringUninitialized(
+        &ciphertexts[i], (*aead)->CiphertextSize(batch.messages[i].size()));
+    ASSERT_THAT((*aead)->Encrypt(batch.messages[i], batch.associated_data[i],
+                                 batch.ivs[i], absl::MakeSpan(ciphertexts[i])),
+                IsOk());
+  }
+  // Corrupt every third ciphertext.
+  for (size_t i = 0; i < ciphertexts.size(); i += 3) {
+    ciphertexts[i].back() ^= 1;
+  }
+
+  std::vector<std::string> plaintexts(batch.messages.size());
+  std::vector<absl::Span<char>> out;
+  for (size_t i = 0; i < batch.messages.size(); ++i) {
+    plaintexts[i] = std::string(batch.messages[i].size(), 'x');
+    out.push_back(absl::MakeSpan(plaintexts[i]));
+  }
+  std::vector<absl::string_view> ciphertext_views(ciphertexts.begin(),
+                                                  ciphertexts.end());
+  std::vector<absl::string_view> associated_data(
+      batch.associated_data.begin(), batch.associated_data.end());
+  std::vector<absl::string_view> ivs(batch.ivs.begin(), batch.ivs.end());
+  util::StatusOr<std::vector<util::StatusOr<int64_t>>> results =
+      (*aead)->DecryptBatch(ciphertext_views, associated_data, ivs, out);
+  ASSERT_THAT(results, IsOk());
+  ASSERT_EQ(results->size(), ciphertexts.size());
+  for (size_t i = 0; i < ciphertexts.size(); ++i) {
+    if (i % 3 == 0) {
+      EXPECT_THAT((*results)[i], Not(IsOk())) << i;
+      EXPECT_EQ(plaintexts[i], std::string(plaintexts[i].size(), '\0')) << i;
+    } else {
+      ASSERT_THAT((*results)[i], IsOk()) << i;
+      EXPECT_EQ(*(*results)[i], batch.messages[i].size());
+      EXPECT_EQ(plaintexts[i], batch.messages[i]) << i;
+    }
+  }
+}
+
+TEST_P(SslOneShotAeadTest, BatchSizeMismatchFails) {
+  SslOneShotAeadTestParams test_param = GetParam();
+  util::StatusOr<std::unique_ptr<SslOneShotAead>> aead = CipherFromName(
+      test_param.cipher, util::SecretDataFromStringView(
+                             absl::HexStringToBytes(test_param.key_hex)));
+  ASSERT_THAT(aead, IsOk());
+
+  std::string iv = absl::HexStringToBytes(test_param.iv_hex);
+  std::string buffer(kMessage.size() + test_param.tag_size, '\0');
+  std::vector<absl::string_view> two_messages = {kMessage, kMessage};
+  std::vector<absl::string_view> one_associated_data = {kAssociatedData};
+  std::vector<absl::string_view> two_ivs = {iv, iv};
+  std::vector<absl::Span<char>> two_buffers = {absl::MakeSpan(buffer),
+                                               absl::MakeSpan(buffer)};
+  EXPECT_THAT((*aead)
+                  ->EncryptBatch(two_messages, one_associated_data, two_ivs,
+                                 two_buffers)
+                  .status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT((*aead)
+                  ->DecryptBatch(two_messages, one_associated_data, two_ivs,
+                                 two_buffers)
+                  .status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+// Splits `data` into fragments of `fragment_size` bytes; the last one may be
+// shorter.
+std::vector<absl::string_view> SplitIntoFragments(absl::string_view data,
+                                                  size_t fragment_size) {
+  std::vector<absl::string_view> fragments;
+  for (size_t i = 0; i < data.size(); i += fragment_size) {
+    fragments.push_back(data.substr(i, fragment_size));
+  }
+  return fragments;
+}
+
+std::vector<absl::Span<char>> SplitIntoFragments(absl::Span<char> buffer,
+                                                 size_t fragment_size) {
+  std::vector<absl::Span<char>> fragments;
+  for (size_t i = 0; i < buffer.size(); i += fragment_size) {
+    fragments.push_back(buffer.subspan(i, fragment_size));
+  }
+  return fragments;
+}
+
+TEST_P(SslOneShotAeadTest, FragmentsMatchContiguous) {
+  SslOneShotAeadTestParams test_param = GetParam();
+  util::StatusOr<std::unique_ptr<SslOneShotAead>> aead = CipherFromName(
+      test_param.cipher, util::SecretDataFromStringView(
+                             absl::HexStringToBytes(test_param.key_hex)));
+  ASSERT_THAT(aead, IsOk());
+
+  std::string iv = absl::HexStringToBytes(test_param.iv_hex);
+  std::string message;
+  // Long enough to mix pieces that are processed directly with runs of short
+  // pieces that span more than one scratch buffer.
+  for (int i = 0; i < 10000; ++i) message.push_back(static_cast<char>(i * 7));
+  std::string expected((*aead)->CiphertextSize(message.size()), '\0');
+  ASSERT_THAT((*aead)->Encrypt(message, kAssociatedData, iv,
+                               absl::MakeSpan(expected)),
+              IsOk());
+
+  for (size_t input_fragment_size : {1, 7, 300, 10000}) {
+    for (size_t output_fragment_size : {1, 5, 300, 20000}) {
+      SCOPED_TRACE(absl::StrCat(input_fragment_size, " ", output_fragment_size));
+      std::string ciphertext(expected.size(), 'x');
+      util::StatusOr<int64_t> written_bytes = (*aead)->EncryptFragments(
+          SplitIntoFragments(message, input_fragment_size), kAssociatedData,
+          iv, SplitIntoFragments(absl::MakeSpan(ciphertext),
+                                 output_fragment_size));
+      ASSERT_THAT(written_bytes, IsOk());
+      EXPECT_EQ(*written_bytes, expected.size());
+      EXPECT_EQ(ciphertext, expected);
+
+      std::string plaintext(message.size(), 'x');
+      written_bytes = (*aead)->DecryptFragments(
+          SplitIntoFragments(expected, input_fragment_size), kAssociatedData,
+          iv,
+          SplitIntoFragments(absl::MakeSpan(plaintext), output_fragment_size));
+      ASSERT_THAT(written_bytes, IsOk());
+      EXPECT_EQ(*written_bytes, message.size());
+      EXPECT_EQ(plaintext, message);
+    }
+  }
+}
+
+TEST_P(SslOneShotAeadTest, EmptyMessageFragments) {
+  SslOneShotAeadTestParams test_param = GetParam();
+  util::StatusOr<std::unique_ptr<SslOneShotAead>> aead = CipherFromName(
+      test_param.cipher, util::SecretDataFromStringView(
+                             absl::HexStringToBytes(test_param.key_hex)));
+  ASSERT_THAT(aead, IsOk());
+
+  std::string iv = absl::HexStringToBytes(test_param.iv_hex);
+  std::string ciphertext(test_param.tag_size, '\0');
+  util::StatusOr<int64_t> written_bytes = (*aead)->EncryptFragments(
+      {}, kAssociatedData, iv, {absl::MakeSpan(ciphertext)});
+  ASSERT_THAT(written_bytes, IsOk());
+  EXPECT_EQ(*written_bytes, test_param.tag_size);
+  EXPECT_THAT((*aead)->DecryptFragments(
+                  SplitIntoFragments(ciphertext, 3), kAssociatedData, iv, {}),
+              IsOkAndHolds(0));
+}
+
+TEST_P(SslOneShotAeadTest, DecryptFragmentsClearsOutputIfDecryptionFails) {
+  SslOneShotAeadTestParams test_param = GetParam();
+  util::StatusOr<std::unique_ptr<SslOneShotAead>> aead = CipherFromName(
+      test_param.cipher, util::SecretDataFromStringView(
+                             absl::HexStringToBytes(test_param.key_hex)));
+  ASSERT_THAT(aead, IsOk());
+
+  std::string iv = absl::HexStringToBytes(test_param.iv_hex);
+  std::string ciphertext((*aead)->CiphertextSize(kMessage.size()), '\0');
+  ASSERT_THAT((*aead)->Encrypt(kMessage, kAssociatedData, iv,
+                               absl::MakeSpan(ciphertext)),
+              IsOk());
+  ciphertext.back() ^= 1;
+
+  std::string plaintext(kMessage.size(), 'x');
+  EXPECT_THAT((*aead)
+                  ->DecryptFragments(SplitIntoFragments(ciphertext, 4),
+                                     kAssociatedData, iv,
+                                     SplitIntoFragments(
+                                         absl::MakeSpan(plaintext), 3))
+                  .status(),
+              Not(IsOk()));
+  EXPECT_EQ(plaintext, std::string(kMessage.size(), '\0'));
+}
+
+TEST_P(SslOneShotAeadTest, FragmentsTooSmallOrOverlappingFail) {
+  SslOneShotAeadTestParams test_param = GetParam();
+  util::StatusOr<std::unique_ptr<SslOneShotAead>> aead = CipherFromName(
+      test_param.cipher, util::SecretDataFromStringView(
+                             absl::HexStringToBytes(test_param.key_hex)));
+  ASSERT_THAT(aead, IsOk());
+
+  std::string iv = absl::HexStringToBytes(test_param.iv_hex);
+  std::string ciphertext((*aead)->CiphertextSize(kMessage.size()), '\0');
+  EXPECT_THAT(
+      (*aead)
+          ->EncryptFragments(
+              SplitIntoFragments(kMessage, 4), kAssociatedData, iv,
+              SplitIntoFragments(
+                  absl::MakeSpan(ciphertext).subspan(1), 4))
+          .status(),
+      StatusIs(absl::StatusCode::kInvalidArgument));
+  ASSERT_THAT((*aead)->EncryptFragments(
+                  SplitIntoFragments(kMessage, 4), kAssociatedData, iv,
+                  SplitIntoFragments(absl::MakeSpan(ciphertext), 4)),
+              IsOk());
+
+  std::string plaintext(kMessage.size() - 1, '\0');
+  EXPECT_THAT((*aead)
+                  ->DecryptFragments(
+                      SplitIntoFragments(ciphertext, 4), kAssociatedData, iv,
+                      SplitIntoFragments(absl::MakeSpan(plaintext), 4))
+                  .status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+
+  std::string buffer(kMessage);
+  buffer.resize(ciphertext.size());
+  EXPECT_THAT((*aead)
+                  ->EncryptFragments(
+                      {absl::string_view(buffer).substr(0, kMessage.size())},
+                      kAssociatedData, iv,
+                      SplitIntoFragments(absl::MakeSpan(buffer), 8))
+                  .status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
 std::vector<SslOneShotAeadTestParams> GetSslOneShotAeadTestParams() {
   std::vector<SslOneShotAeadTestParams> params = {
       {/*test_name=*/"AesGcm256", /*cipher=*/CipherType::kAesGcm,
@@ -17,9 +17,17 @@
 #ifndef TINK_AEAD_INTERNAL_ZERO_COPY_AEAD_H_
 #define TINK_AEAD_INTERNAL_ZERO_COPY_AEAD_H_
 
+#include <cstddef>
 #include <cstdint>
+#include <string>
+#include <vector>
 
+#include "absl/status/status.h"
+#include "absl/strings/str_join.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/internal/fragments.h"
+#include "tink/util/status.h"
 #include "tink/util/statusor.h"
 
 namespace crypto {
@@ -72,6 +80,96 @@ class ZeroCopyAead {
   virtual crypto::tink::util::StatusOr<int64_t> Decrypt(
       absl::string_view ciphertext, absl::string_view associated_data,
       absl::Span<char> buffer) const = 0;
+
+  // Encrypts `plaintexts[i]` with `associated_data[i]` into `buffers[i]` for
+  // every i, and returns the size of each ciphertext. The output is the same
+  // as calling Encrypt() on every message. Fails if any message cannot be
+  // encrypted. Implementations override this to amortize per-message setup
+  // over many small messages.
+  virtual crypto::tink::util::StatusOr<std::vector<int64_t>> EncryptBatch(
+      absl::Span<const absl::string_view> plaintexts,
+      absl::Span<const absl::string_view> associated_data,
+      absl::Span<const absl::Span<char>> buffers) const {
+    if (associated_data.size() != plaintexts.size() ||
+        buffers.size() != plaintexts.size()) {
+      return crypto::tink::util::Status(absl::StatusCode::kInvalidArgument,
+                                        "Batch sizes differ");
+    }
+    std::vector<int64_t> sizes(plaintexts.size());
+    for (size_t i = 0; i < plaintexts.size(); ++i) {
+      crypto::tink::util::StatusOr<int64_t> size =
+          Encrypt(plaintexts[i], associated_data[i], buffers[i]);
+      if (!size.ok()) return size.status();
+      sizes[i] = *size;
+    }
+    return sizes;
+  }
+
+  // Decrypts `ciphertexts[i]` with `associated_data[i]` into `buffers[i]` for
+  // every i, and returns the result of each decryption, as Decrypt() would.
+  // Only a malformed batch fails the whole call.
+  virtual crypto::tink::util::StatusOr<
+      std::vector<crypto::tink::util::StatusOr<int64_t>>>
+  DecryptBatch(absl::Span<const absl::string_view> ciphertexts,
+               absl::Span<const absl::string_view> associated_data,
+               absl::Span<const absl::Span<char>> buffers) const {
+    if (associated_data.size() != ciphertexts.size() ||
+        buffers.size() != ciphertexts.size()) {
+      return crypto::tink::util::Status(absl::StatusCode::kInvalidArgument,
+                                        "Batch sizes differ");
+    }
+    std::vector<crypto::tink::util::StatusOr<int64_t>> results;
+    results.reserve(ciphertexts.size());
+    for (size_t i = 0; i < ciphertexts.size(); ++i) {
+      results.push_back(Decrypt(ciphertexts[i], associated_data[i], buffers[i]));
+    }
+    return results;
+  }
+
+  // Encrypts the concatenation of the `plaintext` fragments with
+  // `associated_data` as associated data, and writes the ciphertext across
+  // the `buffers` fragments, in order. Returns the size of the ciphertext.
+  // `buffers` must together hold at least MaxEncryptionSize bytes. The
+  // default implementation joins the fragments and calls Encrypt();
+  // implementations override it to encrypt the fragments in place.
+  virtual crypto::tink::util::StatusOr<int64_t> EncryptFragments(
+      absl::Span<const absl::string_view> plaintext,
+      absl::string_view associated_data,
+      absl::Span<const absl::Span<char>> buffers) const {
+    std::string joined_plaintext = absl::StrJoin(plaintext, "");
+    std::string ciphertext(MaxEncryptionSize(joined_plaintext.size()), '\0');
+    crypto::tink::util::StatusOr<int64_t> size = Encrypt(
+        joined_plaintext, associated_data, absl::MakeSpan(ciphertext));
+    if (!size.ok()) return size.status();
+    if (FragmentsSize(buffers) < *size) {
+      return crypto::tink::util::Status(absl::StatusCode::kInvalidArgument,
+                                        "Encryption buffers too small");
+    }
+    CopyToFragments(absl::string_view(ciphertext).substr(0, *size), buffers);
+    return *size;
+  }
+
+  // Decrypts the concatenation of the `ciphertext` fragments with
+  // `associated_data` as associated data, and writes the plaintext across the
+  // `buffers` fragments, in order. Returns the size of the plaintext.
+  // `buffers` must together hold at least MaxDecryptionSize bytes. If the
+  // authentication tag does not validate, `buffers` hold no plaintext.
+  virtual crypto::tink::util::StatusOr<int64_t> DecryptFragments(
+      absl::Span<const absl::string_view> ciphertext,
+      absl::string_view associated_data,
+      absl::Span<const absl::Span<char>> buffers) const {
+    std::string joined_ciphertext = absl::StrJoin(ciphertext, "");
+    std::string plaintext(MaxDecryptionSize(joined_ciphertext.size()), '\0');
+    crypto::tink::util::StatusOr<int64_t> size = Decrypt(
+        joined_ciphertext, associated_data, absl::MakeSpan(plaintext));
+    if (!size.ok()) return size.status();
+    if (FragmentsSize(buffers) < *size) {
+      return crypto::tink::util::Status(absl::StatusCode::kInvalidArgument,
+                                        "Decryption buffers too small");
+    }
+    CopyToFragments(absl::string_view(plaintext).substr(0, *size), buffers);
+    return *size;
+  }
 };
 
 }  // namespace internal
@@ -17,16 +17,21 @@
 #include "tink/aead/internal/zero_copy_aes_gcm_boringssl.h"
 
 #include <cstdint>
+#include <cstring>
 #include <memory>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "tink/aead/internal/aead_util.h"
 #include "tink/aead/internal/ssl_aead.h"
 #include "tink/aead/internal/zero_copy_aead.h"
+#include "tink/internal/fragments.h"
 #include "tink/internal/util.h"
 #include "tink/subtle/random.h"
 #include "tink/subtle/subtle_util.h"
@@ -40,6 +45,22 @@ namespace internal {
 constexpr int kIvSizeInBytes = 12;
 constexpr int kTagSizeInBytes = 16;
 
+namespace {
+
+util::Status CheckBatchSizes(size_t num_messages, size_t num_associated_data,
+                             size_t num_buffers) {
+  if (num_associated_data != num_messages || num_buffers != num_messages) {
+    return util::Status(
+        absl::StatusCode::kInvalidArgument,
+        absl::StrCat("Batch sizes differ: ", num_messages, " messages, ",
+                     num_associated_data, " associated data and ",
+                     num_buffers, " buffers"));
+  }
+  return util::OkStatus();
+}
+
+}  // namespace
+
 util::StatusOr<std::unique_ptr<ZeroCopyAead>> ZeroCopyAesGcmBoringSsl::New(
     const util::SecretData &key) {
   util::StatusOr<std::unique_ptr<internal::SslOneShotAead>> aead =
@@ -129,6 +150,188 @@ util::StatusOr<int64_t> ZeroCopyAesGcmBoringSsl::Decrypt(
   return aead_->Decrypt(ciphertext_and_tag, associated_data, iv, buffer);
 }
 
+util::StatusOr<std::vector<int64_t>> ZeroCopyAesGcmBoringSsl::EncryptBatch(
+    absl::Span<const absl::string_view> plaintexts,
+    absl::Span<const absl::string_view> associated_data,
+    absl::Span<const absl::Span<char>> buffers) const {
+  util::Status status = CheckBatchSizes(plaintexts.size(),
+                                        associated_data.size(), buffers.size());
+  if (!status.ok()) {
+    return status;
+  }
+  for (size_t i = 0; i < plaintexts.size(); ++i) {
+    const int64_t max_encryption_size = MaxEncryptionSize(plaintexts[i].size());
+    if (buffers[i].size() < max_encryption_size) {
+      return util::Status(
+          absl::StatusCode::kInvalidArgument,
+          absl::StrCat("Encryption buffer too small; expected at least ",
+                       max_encryption_size, " bytes, got ", buffers[i].size()));
+    }
+    if (BuffersOverlap(plaintexts[i], absl::string_view(buffers[i].data(),
+                                                        buffers[i].size()))) {
+      return util::Status(
+          absl::StatusCode::kFailedPrecondition,
+          "Plaintext and ciphertext buffers overlap; this is disallowed");
+    }
+  }
+
+  // One call to the RNG for all IVs.
+  std::string ivs;
+  subtle::ResizeStringUninitialized(&ivs, kIvSizeInBytes * plaintexts.size());
+  status = subtle::Random::GetRandomBytes(absl::MakeSpan(ivs));
+  if (!status.ok()) {
+    return status;
+  }
+  std::vector<absl::string_view> iv_views(plaintexts.size());
+  std::vector<absl::Span<char>> raw_buffers(plaintexts.size());
+  for (size_t i = 0; i < plaintexts.size(); ++i) {
+    std::memcpy(buffers[i].data(), &ivs[i * kIvSizeInBytes], kIvSizeInBytes);
+    iv_views[i] = absl::string_view(buffers[i].data(), kIvSizeInBytes);
+    raw_buffers[i] = buffers[i].subspan(kIvSizeInBytes);
+  }
+
+  util::StatusOr<std::vector<int64_t>> written_bytes =
+      aead_->EncryptBatch(plaintexts, associated_data, iv_views, raw_buffers);
+  if (!written_bytes.ok()) {
+    return written_bytes.status();
+  }
+  for (int64_t& size : *written_bytes) {
+    size += kIvSizeInBytes;
+  }
+  return written_bytes;
+}
+
+util::StatusOr<std::vector<util::StatusOr<int64_t>>>
+ZeroCopyAesGcmBoringSsl::DecryptBatch(
+    absl::Span<const absl::string_view> ciphertexts,
+    absl::Span<const absl::string_view> associated_data,
+    absl::Span<const absl::Span<char>> buffers) const {
+  util::Status status = CheckBatchSizes(
+      ciphertexts.size(), associated_data.size(), buffers.size());
+  if (!status.ok()) {
+    return status;
+  }
+  std::vector<util::StatusOr<int64_t>> results(ciphertexts.size());
+
+  // Messages that pass the size checks are decrypted in one batch.
+  std::vector<size_t> indices;
+  std::vector<absl::string_view> raw_ciphertexts;
+  std::vector<absl::string_view> batch_associated_data;
+  std::vector<absl::string_view> ivs;
+  std::vector<absl::Span<char>> batch_buffers;
+  for (size_t i = 0; i < ciphertexts.size(); ++i) {
+    absl::string_view ciphertext = ciphertexts[i];
+    const size_t min_ciphertext_size = kIvSizeInBytes + kTagSizeInBytes;
+    if (ciphertext.size() < min_ciphertext_size) {
+      results[i] = util::Status(
+          absl::StatusCode::kInvalidArgument,
+          absl::StrCat("Ciphertext too short; expected at least ",
+                       min_ciphertext_size, " bytes, got ", ciphertext.size()));
+      continue;
+    }
+    const int64_t max_decryption_size = MaxDecryptionSize(ciphertext.size());
+    if (buffers[i].size() < max_decryption_size) {
+      results[i] = util::Status(
+          absl::StatusCode::kInvalidArgument,
+          absl::StrCat("Decryption buffer too small; expected at least ",
+                       max_decryption_size, " bytes, got ", buffers[i].size()));
+      continue;
+    }
+    if (BuffersOverlap(ciphertext, absl::string_view(buffers[i].data(),
+                                                     buffers[i].size()))) {
+      results[i] = util::Status(
+          absl::StatusCode::kFailedPrecondition,
+          "Plaintext and ciphertext buffers overlap; this is disallowed");
+      continue;
+    }
+    indices.push_back(i);
+    ivs.push_back(ciphertext.substr(0, kIvSizeInBytes));
+    raw_ciphertexts.push_back(ciphertext.substr(kIvSizeInBytes));
+    batch_associated_data.push_back(associated_data[i]);
+    batch_buffers.push_back(buffers[i]);
+  }
+
+  util::StatusOr<std::vector<util::StatusOr<int64_t>>> batch_results =
+      aead_->DecryptBatch(raw_ciphertexts, batch_associated_data, ivs,
+                          batch_buffers);
+  if (!batch_results.ok()) {
+    return batch_results.status();
+  }
+  for (size_t j = 0; j < indices.size(); ++j) {
+    results[indices[j]] = std::move((*batch_results)[j]);
+  }
+  return results;
+}
+
+util::StatusOr<int64_t> ZeroCopyAesGcmBoringSsl::EncryptFragments(
+    absl::Span<const absl::string_view> plaintext,
+    absl::string_view associated_data,
+    absl::Span<const absl::Span<char>> buffers) const {
+  const int64_t max_encryption_size =
+      MaxEncryptionSize(FragmentsSize(plaintext));
+  const int64_t buffers_size = FragmentsSize(buffers);
+  if (buffers_size < max_encryption_size) {
+    return util::Status(
+        absl::StatusCode::kInvalidArgument,
+        absl::StrCat("Encryption buffer too small; expected at least ",
+                     max_encryption_size, " bytes, got ", buffers_size));
+  }
+  if (FragmentsOverlap(plaintext, buffers)) {
+    return util::Status(
+        absl::StatusCode::kFailedPrecondition,
+        "Plaintext and ciphertext buffers overlap; this is disallowed");
+  }
+
+  std::string iv;
+  subtle::ResizeStringUninitialized(&iv, kIvSizeInBytes);
+  util::Status res = subtle::Random::GetRandomBytes(absl::MakeSpan(iv));
+  if (!res.ok()) {
+    return res;
+  }
+  CopyToFragments(iv, buffers);
+  util::StatusOr<int64_t> written_bytes = aead_->EncryptFragments(
+      plaintext, associated_data, iv,
+      SubFragments(buffers, kIvSizeInBytes, buffers_size - kIvSizeInBytes));
+  if (!written_bytes.ok()) {
+    return written_bytes.status();
+  }
+  return kIvSizeInBytes + *written_bytes;
+}
+
+util::StatusOr<int64_t> ZeroCopyAesGcmBoringSsl::DecryptFragments(
+    absl::Span<const absl::string_view> ciphertext,
+    absl::string_view associated_data,
+    absl::Span<const absl::Span<char>> buffers) const {
+  const int64_t ciphertext_size = FragmentsSize(ciphertext);
+  const int64_t min_ciphertext_size = kIvSizeInBytes + kTagSizeInBytes;
+  if (ciphertext_size < min_ciphertext_size) {
+    return util::Status(
+        absl::StatusCode::kInvalidArgument,
+        absl::StrCat("Ciphertext too short; expected at least ",
+                     min_ciphertext_size, " bytes, got ", ciphertext_size));
+  }
+  const int64_t max_decryption_size = MaxDecryptionSize(ciphertext_size);
+  if (FragmentsSize(buffers) < max_decryption_size) {
+    return util::Status(
+        absl::StatusCode::kInvalidArgument,
+        absl::StrCat("Decryption buffer too small; expected at least ",
+                     max_decryption_size, " bytes, got ",
+                     FragmentsSize(buffers)));
+  }
+  if (FragmentsOverlap(ciphertext, buffers)) {
+    return util::Status(
+        absl::StatusCode::kFailedPrecondition,
+        "Plaintext and ciphertext buffers overlap; this is disallowed");
+  }
+
+  std::string iv(kIvSizeInBytes, '\0');
+  CopyFromFragments(ciphertext, absl::MakeSpan(iv));
+  return aead_->DecryptFragments(
+      SubFragments(ciphertext, kIvSizeInBytes,
+                   ciphertext_size - kIvSizeInBytes),
+      associated_data, iv, buffers);
+}
+
 }  // namespace internal
 }  // namespace tink
 }  // namespace crypto
@@ -20,8 +20,11 @@
 #include <cstdint>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "absl/base/macros.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "tink/aead/internal/ssl_aead.h"
 #include "tink/aead/internal/zero_copy_aead.h"
 #include "tink/util/secret_data.h"
@@ -48,6 +51,31 @@ class ZeroCopyAesGcmBoringSsl : public ZeroCopyAead {
       absl::string_view ciphertext, absl::string_view associated_data,
       absl::Span<char> buffer) const override;
 
+  // Draws the IVs of the whole batch at once and encrypts all messages with a
+  // single keyed cipher context where the backend allows it.
+  crypto::tink::util::StatusOr<std::vector<int64_t>> EncryptBatch(
+      absl::Span<const absl::string_view> plaintexts,
+      absl::Span<const absl::string_view> associated_data,
+      absl::Span<const absl::Span<char>> buffers) const override;
+
+  crypto::tink::util::StatusOr<
+      std::vector<crypto::tink::util::StatusOr<int64_t>>>
+  DecryptBatch(absl::Span<const absl::string_view> ciphertexts,
+               absl::Span<const absl::string_view> associated_data,
+               absl::Span<const absl::Span<char>> buffers) const override;
+
+  // Writes the IV to the first fragments and encrypts the plaintext
+  // fragments in place with SslOneShotAead::EncryptFragments().
+  crypto::tink::util::StatusOr<int64_t> EncryptFragments(
+      absl::Span<const absl::string_view> plaintext,
+      absl::string_view associated_data,
+      absl::Span<const absl::Span<char>> buffers) const override;
+
+  crypto::tink::util::StatusOr<int64_t> DecryptFragments(
+      absl::Span<const absl::string_view> ciphertext,
+      absl::string_view associated_data,
+      absl::Span<const absl::Span<char>> buffers) const override;
+
  private:
   explicit ZeroCopyAesGcmBoringSsl(std::unique_ptr<SslOneShotAead> aead)
       : aead_(std::move(aead)) {}
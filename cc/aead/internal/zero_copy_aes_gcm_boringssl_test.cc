@@ -26,6 +26,7 @@
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/status/status.h"
 #include "absl/strings/escaping.h"
 #include "absl/strings/str_cat.h"
@@ -42,6 +43,7 @@ namespace internal {
 namespace {
 
 using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::IsOkAndHolds;
 using ::crypto::tink::test::StatusIs;
 using ::testing::AllOf;
 using ::testing::Eq;
@@ -170,6 +172,89 @@ TEST_F(ZeroCopyAesGcmBoringSslTest, DecryptOverlappingPlaintextCiphertext) {
       StatusIs(absl::StatusCode::kFailedPrecondition));
 }
 
+TEST_F(ZeroCopyAesGcmBoringSslTest, EncryptBatchThenDecrypt) {
+  std::vector<std::string> messages;
+  std::vector<std::string> associated_data;
+  for (int i = 0; i < 33; ++i) {
+    messages.push_back(std::string(i * 3, 'a' + i % 26));
+    associated_data.push_back(absl::StrCat(kAssociatedData, i));
+  }
+  std::vector<std::string> ciphertexts(messages.size());
+  std::vector<absl::Span<char>> buffers;
+  for (size_t i = 0; i < messages.size(); ++i) {
+    subtle::ResizeStringUninitialized(
+        &ciphertexts[i], cipher_->MaxEncryptionSize(messages[i].size()));
+    buffers.push_back(absl::MakeSpan(ciphertexts[i]));
+  }
+  std::vector<absl::string_view> message_views(messages.begin(),
+                                               messages.end());
+  std::vector<absl::string_view> associated_data_views(associated_data.begin(),
+                                                       associated_data.end());
+  util::StatusOr<std::vector<int64_t>> ciphertext_sizes =
+      cipher_->EncryptBatch(message_views, associated_data_views, buffers);
+  ASSERT_THAT(ciphertext_sizes, IsOk());
+  ASSERT_EQ(ciphertext_sizes->size(), messages.size());
+
+  absl::flat_hash_set<std::string> ivs;
+  for (size_t i = 0; i < messages.size(); ++i) {
+    EXPECT_EQ((*ciphertext_sizes)[i],
+              kIvSizeInBytes + messages[i].size() + kTagSizeInBytes);
+    ivs.insert(ciphertexts[i].substr(0, kIvSizeInBytes));
+    std::string plaintext;
+    subtle::ResizeStringUninitialized(
+        &plaintext, cipher_->MaxDecryptionSize(ciphertexts[i].size()));
+    util::StatusOr<int64_t> plaintext_size = cipher_->Decrypt(
+        ciphertexts[i], associated_data[i], absl::MakeSpan(plaintext));
+    ASSERT_THAT(plaintext_size, IsOk());
+    EXPECT_EQ(plaintext, messages[i]);
+  }
+  // Each message gets a fresh IV.
+  EXPECT_EQ(ivs.size(), messages.size());
+}
+
+TEST_F(ZeroCopyAesGcmBoringSslTest, DecryptBatch) {
+  std::string valid = absl::HexStringToBytes(kEncodedCiphertext);
+  std::string modified = valid;
+  modified.back() ^= 1;
+  std::string too_short = valid.substr(0, kIvSizeInBytes + kTagSizeInBytes - 1);
+  std::vector<absl::string_view> ciphertexts = {valid, modified, too_short,
+                                                valid};
+  std::vector<absl::string_view> associated_data(ciphertexts.size(),
+                                                 kAssociatedData);
+  std::vector<std::string> plaintexts(ciphertexts.size(),
+                                      std::string(kMaxDecryptionSize, 'x'));
+  std::vector<absl::Span<char>> buffers;
+  for (std::string& plaintext : plaintexts) {
+    buffers.push_back(absl::MakeSpan(plaintext));
+  }
+
+  util::StatusOr<std::vector<util::StatusOr<int64_t>>> results =
+      cipher_->DecryptBatch(ciphertexts, associated_data, buffers);
+  ASSERT_THAT(results, IsOk());
+  ASSERT_EQ(results->size(), ciphertexts.size());
+  EXPECT_THAT((*results)[0], IsOkAndHolds(kMessage.size()));
+  EXPECT_EQ(plaintexts[0], kMessage);
+  EXPECT_THAT((*results)[1], Not(IsOk()));
+  EXPECT_EQ(plaintexts[1], std::string(kMaxDecryptionSize, '\0'));
+  EXPECT_THAT((*results)[2].status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT((*results)[3], IsOkAndHolds(kMessage.size()));
+  EXPECT_EQ(plaintexts[3], kMessage);
+}
+
+TEST_F(ZeroCopyAesGcmBoringSslTest, BatchSizeMismatchFails) {
+  std::string buffer(kMaxEncryptionSize, '\0');
+  std::vector<absl::string_view> messages = {kMessage, kMessage};
+  std::vector<absl::string_view> associated_data = {kAssociatedData};
+  std::vector<absl::Span<char>> buffers = {absl::MakeSpan(buffer)};
+  EXPECT_THAT(
+      cipher_->EncryptBatch(messages, associated_data, buffers).status(),
+      StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(
+      cipher_->DecryptBatch(messages, associated_data, buffers).status(),
+      StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
 class ZeroCopyAesGcmBoringSslWycheproofTest
     : public TestWithParam<WycheproofTestVector> {
   void SetUp() override {
@@ -17,14 +17,19 @@
 #ifndef TINK_CLEARTEXT_KEYSET_HANDLE_H_
 #define TINK_CLEARTEXT_KEYSET_HANDLE_H_
 
+#include <cstdint>
 #include <istream>
 #include <memory>
 #include <sstream>
 #include <string>
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "tink/key_gen_configuration.h"
 #include "tink/keyset_handle.h"
 #include "tink/keyset_reader.h"
+#include "tink/keyset_writer.h"
+#include "tink/util/status.h"
 #include "tink/util/statusor.h"
 #include "proto/tink.pb.h"
 
@@ -43,11 +48,30 @@ class CleartextKeysetHandle {
       const absl::flat_hash_map<std::string, std::string>&
           monitoring_annotations = {});
 
+  // Creates a KeysetHandle from a keyset in the flat keyset format, see
+  // FlatKeysetWriter. As with Read(), every key is parsed and validated before
+  // the handle is returned, which dominates the cost of loading; only parsing
+  // the keyset structure is cheaper than with Read(). `flat_keyset` is copied
+  // and does not need to outlive the returned handle.
+  static crypto::tink::util::StatusOr<std::unique_ptr<KeysetHandle>> ReadFlat(
+      absl::string_view flat_keyset,
+      const absl::flat_hash_map<std::string, std::string>&
+          monitoring_annotations = {});
+
   // Writes the keyset in the given `keyset_handle` to the `writer` which must
   // be non-null.
   static crypto::tink::util::Status Write(KeysetWriter* writer,
                                           const KeysetHandle& keyset_handle);
 
+  // Generates `count` keysets that each contain one new key generated
+  // according to `key_template` using `config`, and writes them to `writer`
+  // in order, as KeysetHandle::GenerateNewAndWrite() does, but without
+  // encrypting them.
+  static crypto::tink::util::Status GenerateNewAndWrite(
+      const google::crypto::tink::KeyTemplate& key_template,
+      const crypto::tink::KeyGenConfiguration& config, int64_t count,
+      KeysetWriter* writer);
+
   // Creates a KeysetHandle object for the given 'keyset'.
   static std::unique_ptr<KeysetHandle> GetKeysetHandle(
       const google::crypto::tink::Keyset& keyset);
@@ -0,0 +1,44 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/config/adaptive_key_ordering.h"
+
+#include "tink/internal/adaptive_key_order.h"
+
+namespace crypto {
+namespace tink {
+
+void EnableAdaptiveKeyOrdering() {
+  internal::SetAdaptiveKeyOrderingEnabled(true);
+}
+
+void DisableAdaptiveKeyOrdering() {
+  internal::SetAdaptiveKeyOrderingEnabled(false);
+}
+
+bool IsAdaptiveKeyOrderingEnabled() {
+  return internal::IsAdaptiveKeyOrderingEnabled();
+}
+
+AdaptiveKeyOrderingStats GetAdaptiveKeyOrderingStats() {
+  internal::KeyOrderingStats stats = internal::GetKeyOrderingStats();
+  return {stats.trial_operations, stats.fixed_order_trial_operations,
+          stats.fixed_order_trial_operations - stats.trial_operations};
+}
+
+}  // namespace tink
+}  // namespace crypto
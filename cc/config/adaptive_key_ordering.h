@@ -0,0 +1,54 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef TINK_CONFIG_ADAPTIVE_KEY_ORDERING_H_
+#define TINK_CONFIG_ADAPTIVE_KEY_ORDERING_H_
+
+#include <cstdint>
+
+namespace crypto {
+namespace tink {
+
+// When decrypting or verifying, the keyset wrappers of Aead, Mac,
+// PublicKeyVerify, JwtMac and JwtPublicKeyVerify may have to try several
+// candidate keys, e.g. all RAW keys. By default candidates are tried in
+// keyset order. With adaptive key ordering, each wrapper counts how often
+// each candidate succeeds and tries the most successful candidates first,
+// which saves trial operations while most inputs use one non-primary key,
+// e.g. during key rotation.
+//
+// Only affects wrappers created after the call.
+void EnableAdaptiveKeyOrdering();
+void DisableAdaptiveKeyOrdering();
+bool IsAdaptiveKeyOrderingEnabled();
+
+// Totals over all adaptively ordered wrappers in this process.
+struct AdaptiveKeyOrderingStats {
+  // Trial decryptions or verifications performed.
+  int64_t trial_operations;
+  // Trial operations the keyset order would have needed for the same calls.
+  int64_t fixed_order_trial_operations;
+  // fixed_order_trial_operations - trial_operations.
+  int64_t saved_trial_operations;
+};
+
+AdaptiveKeyOrderingStats GetAdaptiveKeyOrderingStats();
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_CONFIG_ADAPTIVE_KEY_ORDERING_H_
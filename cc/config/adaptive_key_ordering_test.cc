@@ -0,0 +1,53 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/config/adaptive_key_ordering.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "tink/internal/adaptive_key_order.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+TEST(AdaptiveKeyOrderingTest, DisabledByDefault) {
+  EXPECT_FALSE(IsAdaptiveKeyOrderingEnabled());
+}
+
+TEST(AdaptiveKeyOrderingTest, EnableAndDisable) {
+  EnableAdaptiveKeyOrdering();
+  EXPECT_TRUE(IsAdaptiveKeyOrderingEnabled());
+  EXPECT_TRUE(internal::IsAdaptiveKeyOrderingEnabled());
+  DisableAdaptiveKeyOrdering();
+  EXPECT_FALSE(IsAdaptiveKeyOrderingEnabled());
+  EXPECT_FALSE(internal::IsAdaptiveKeyOrderingEnabled());
+}
+
+TEST(AdaptiveKeyOrderingTest, Stats) {
+  internal::ResetKeyOrderingStats();
+  internal::AddKeyOrderingTrials(/*trials=*/3, /*fixed_order_trials=*/10);
+  internal::AddKeyOrderingTrials(/*trials=*/2, /*fixed_order_trials=*/2);
+  AdaptiveKeyOrderingStats stats = GetAdaptiveKeyOrderingStats();
+  EXPECT_EQ(stats.trial_operations, 5);
+  EXPECT_EQ(stats.fixed_order_trial_operations, 12);
+  EXPECT_EQ(stats.saved_trial_operations, 7);
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
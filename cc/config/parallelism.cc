@@ -0,0 +1,32 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/config/parallelism.h"
+
+#include "tink/internal/run_in_parallel.h"
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+
+util::Status EnableParallelism(int num_threads) {
+  return internal::StartSharedThreadPool(num_threads);
+}
+
+int GetParallelism() { return internal::SharedThreadPoolSize(); }
+
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,47 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_CONFIG_PARALLELISM_H_
+#define TINK_CONFIG_PARALLELISM_H_
+
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+
+// Some operations consist of many independent parts: the segments checked by
+// StreamingAead::VerifyCiphertext() and processed by AES-GCM-HKDF segmented
+// AEAD keys, the leaves of HMAC tree MACs, the signatures of RSA SignBatch()
+// and of multi-key signing, and the keys of KeysetHandle::GenerateKeysets()
+// and GenerateNewAndWrite(). By default Tink runs all of them on the calling
+// thread and never starts threads of its own.
+//
+// After EnableParallelism(num_threads), these parts also run on a process-wide
+// pool of `num_threads` worker threads that all callers share, so concurrent
+// calls never use more than `num_threads` threads besides their own. The
+// threads are started by the first successful call and run until the process
+// exits; call this early, e.g. in main(). Returns an error if `num_threads` is
+// not positive, or if parallelism was already enabled with a different number
+// of threads.
+crypto::tink::util::Status EnableParallelism(int num_threads);
+
+// Returns the number of worker threads enabled by EnableParallelism(), or 0.
+int GetParallelism();
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_CONFIG_PARALLELISM_H_
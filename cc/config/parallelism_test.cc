@@ -0,0 +1,47 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/config/parallelism.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/status/status.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+
+TEST(ParallelismTest, EnableParallelism) {
+  EXPECT_EQ(GetParallelism(), 0);
+  EXPECT_THAT(EnableParallelism(0),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_EQ(GetParallelism(), 0);
+
+  ASSERT_THAT(EnableParallelism(2), IsOk());
+  EXPECT_EQ(GetParallelism(), 2);
+  EXPECT_THAT(EnableParallelism(2), IsOk());
+  EXPECT_THAT(EnableParallelism(3),
+              StatusIs(absl::StatusCode::kFailedPrecondition));
+  EXPECT_EQ(GetParallelism(), 2);
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
@@ -16,6 +16,7 @@
 
 #include "tink/cleartext_keyset_handle.h"
 
+#include <cstdint>
 #include <istream>
 #include <memory>
 #include <string>
@@ -24,8 +25,13 @@
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/internal/flat_keyset.h"
+#include "tink/key_gen_configuration.h"
 #include "tink/keyset_handle.h"
 #include "tink/keyset_reader.h"
+#include "tink/keyset_writer.h"
 #include "tink/util/errors.h"
 #include "tink/util/secret_proto.h"
 #include "tink/util/status.h"
@@ -33,6 +39,7 @@
 #include "proto/tink.pb.h"
 
 using google::crypto::tink::Keyset;
+using google::crypto::tink::KeyTemplate;
 
 namespace crypto {
 namespace tink {
@@ -63,6 +70,40 @@ util::StatusOr<std::unique_ptr<KeysetHandle>> CleartextKeysetHandle::Read(
   return std::move(handle);
 }
 
+// static
+util::StatusOr<std::unique_ptr<KeysetHandle>> CleartextKeysetHandle::ReadFlat(
+    absl::string_view flat_keyset,
+    const absl::flat_hash_map<std::string, std::string>&
+        monitoring_annotations) {
+  util::StatusOr<internal::FlatKeysetView> view =
+      internal::FlatKeysetView::Parse(flat_keyset);
+  if (!view.ok()) {
+    return ToStatusF(absl::StatusCode::kInvalidArgument,
+                     "Error reading keyset data: %s", view.status().message());
+  }
+  util::SecretProto<Keyset> keyset = view->ToKeyset();
+  // Create the entries now, as Read() does: KeysetHandle cannot report an
+  // error for a key that fails to parse when it is first accessed.
+  util::StatusOr<std::vector<std::shared_ptr<const KeysetHandle::Entry>>>
+      entries = KeysetHandle::GetEntriesFromKeyset(*keyset);
+  if (!entries.ok()) {
+    return entries.status();
+  }
+  if (entries->size() != keyset->key_size()) {
+    return util::Status(absl::StatusCode::kInternal,
+                        "Error converting keyset proto into key entries.");
+  }
+  std::unique_ptr<KeysetHandle> handle(
+      new KeysetHandle(std::move(keyset), *entries, monitoring_annotations));
+  for (int i = 0; i < handle->size(); ++i) {
+    util::Status status = handle->ValidateAt(i);
+    if (!status.ok()) {
+      return status;
+    }
+  }
+  return std::move(handle);
+}
+
 // static
 crypto::tink::util::Status CleartextKeysetHandle::Write(
     KeysetWriter* writer, const KeysetHandle& keyset_handle) {
@@ -73,6 +114,27 @@ crypto::tink::util::Status CleartextKeysetHandle::Write(
   return writer->Write(keyset_handle.get_keyset());
 }
 
+// static
+crypto::tink::util::Status CleartextKeysetHandle::GenerateNewAndWrite(
+    const KeyTemplate& key_template, const KeyGenConfiguration& config,
+    int64_t count, KeysetWriter* writer) {
+  if (!writer) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "Error KeysetWriter cannot be null");
+  }
+  return KeysetHandle::GenerateKeysets(
+      key_template, config, count,
+      [writer](absl::Span<util::SecretProto<Keyset>> keysets) {
+        for (const util::SecretProto<Keyset>& keyset : keysets) {
+          util::Status status = writer->Write(*keyset);
+          if (!status.ok()) {
+            return status;
+          }
+        }
+        return util::OkStatus();
+      });
+}
+
 // static
 std::unique_ptr<KeysetHandle> CleartextKeysetHandle::GetKeysetHandle(
     const Keyset& keyset) {
@@ -20,11 +20,24 @@
 #include <memory>
 #include <ostream>
 #include <sstream>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "tink/aead/aead_key_templates.h"
+#include "tink/aead/aes_gcm_proto_serialization.h"
+#include "tink/aead/aes_gcm_key_manager.h"
 #include "tink/binary_keyset_reader.h"
+#include "tink/internal/flat_keyset.h"
+#include "tink/internal/key_gen_configuration_impl.h"
+#include "tink/key_gen_configuration.h"
 #include "tink/keyset_handle.h"
+#include "tink/keyset_writer.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
 #include "tink/util/test_keyset_handle.h"
 #include "tink/util/test_util.h"
 #include "proto/tink.pb.h"
@@ -32,9 +45,11 @@
 using crypto::tink::test::AddRawKey;
 using crypto::tink::test::AddTinkKey;
 
+using google::crypto::tink::EncryptedKeyset;
 using google::crypto::tink::KeyData;
 using google::crypto::tink::Keyset;
 using google::crypto::tink::KeyStatusType;
+using google::crypto::tink::KeyTemplate;
 
 
 namespace crypto {
@@ -72,6 +87,64 @@ TEST_F(CleartextKeysetHandleTest, testRead) {
   }
 }
 
+TEST_F(CleartextKeysetHandleTest, ReadFlat) {
+  Keyset keyset;
+  Keyset::Key key;
+  AddTinkKey("some_key_type", 42, key, KeyStatusType::ENABLED,
+             KeyData::SYMMETRIC, &keyset);
+  AddRawKey("some_other_key_type", 711, key, KeyStatusType::ENABLED,
+            KeyData::SYMMETRIC, &keyset);
+  keyset.set_primary_key_id(42);
+  util::StatusOr<std::string> flat_keyset =
+      internal::SerializeFlatKeyset(keyset);
+  ASSERT_TRUE(flat_keyset.ok()) << flat_keyset.status();
+
+  {  // Valid flat keyset.
+    auto result = CleartextKeysetHandle::ReadFlat(*flat_keyset);
+    ASSERT_TRUE(result.ok()) << result.status();
+    auto handle = std::move(result.value());
+    EXPECT_EQ(keyset.SerializeAsString(),
+              TestKeysetHandle::GetKeyset(*handle).SerializeAsString());
+    ASSERT_EQ(handle->size(), 2);
+    EXPECT_EQ((*handle)[0].GetId(), 42);
+    EXPECT_TRUE((*handle)[0].IsPrimary());
+    EXPECT_EQ((*handle)[1].GetId(), 711);
+  }
+
+  {  // Input in the binary format.
+    auto result = CleartextKeysetHandle::ReadFlat(keyset.SerializeAsString());
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(absl::StatusCode::kInvalidArgument, result.status().code());
+  }
+
+  {  // Key with an unknown status.
+    keyset.mutable_key(1)->set_status(KeyStatusType::UNKNOWN_STATUS);
+    flat_keyset = internal::SerializeFlatKeyset(keyset);
+    ASSERT_TRUE(flat_keyset.ok()) << flat_keyset.status();
+    EXPECT_FALSE(CleartextKeysetHandle::ReadFlat(*flat_keyset).ok());
+  }
+}
+
+TEST_F(CleartextKeysetHandleTest, ReadFlatWithCorruptedKeyValue) {
+  ASSERT_TRUE(RegisterAesGcmProtoSerialization().ok());
+  Keyset keyset;
+  Keyset::Key* key = keyset.add_key();
+  key->set_key_id(42);
+  key->set_status(KeyStatusType::ENABLED);
+  key->set_output_prefix_type(google::crypto::tink::OutputPrefixType::TINK);
+  key->mutable_key_data()->set_type_url(
+      "type.googleapis.com/google.crypto.tink.AesGcmKey");
+  key->mutable_key_data()->set_value("not a serialized AesGcmKey");
+  key->mutable_key_data()->set_key_material_type(KeyData::SYMMETRIC);
+  keyset.set_primary_key_id(42);
+  util::StatusOr<std::string> flat_keyset =
+      internal::SerializeFlatKeyset(keyset);
+  ASSERT_TRUE(flat_keyset.ok()) << flat_keyset.status();
+
+  auto result = CleartextKeysetHandle::ReadFlat(*flat_keyset);
+  EXPECT_FALSE(result.ok());
+}
+
 TEST_F(CleartextKeysetHandleTest, testWrite) {
   Keyset keyset;
   Keyset::Key key;
@@ -97,6 +170,52 @@ TEST_F(CleartextKeysetHandleTest, testWrite) {
             util::OkStatus());
 }
 
+// KeysetWriter that keeps the cleartext keysets written to it, in order.
+class RecordingKeysetWriter : public KeysetWriter {
+ public:
+  util::Status Write(const Keyset& keyset) override {
+    keysets_.push_back(keyset);
+    return util::OkStatus();
+  }
+
+  util::Status Write(const EncryptedKeyset& encrypted_keyset) override {
+    return util::Status(absl::StatusCode::kUnimplemented,
+                        "Unexpected encrypted keyset");
+  }
+
+  const std::vector<Keyset>& keysets() const { return keysets_; }
+
+ private:
+  std::vector<Keyset> keysets_;
+};
+
+TEST_F(CleartextKeysetHandleTest, GenerateNewAndWrite) {
+  KeyGenConfiguration config;
+  ASSERT_TRUE(internal::KeyGenConfigurationImpl::AddKeyTypeManager(
+                  absl::make_unique<AesGcmKeyManager>(), config)
+                  .ok());
+  const KeyTemplate& key_template = AeadKeyTemplates::Aes128Gcm();
+
+  RecordingKeysetWriter writer;
+  ASSERT_EQ(CleartextKeysetHandle::GenerateNewAndWrite(key_template, config,
+                                                       10, &writer),
+            util::OkStatus());
+  ASSERT_EQ(writer.keysets().size(), 10);
+  for (const Keyset& keyset : writer.keysets()) {
+    ASSERT_EQ(keyset.key_size(), 1);
+    EXPECT_NE(keyset.key(0).key_id(), 0);
+    EXPECT_EQ(keyset.primary_key_id(), keyset.key(0).key_id());
+    EXPECT_EQ(keyset.key(0).status(), KeyStatusType::ENABLED);
+    EXPECT_EQ(keyset.key(0).key_data().type_url(), key_template.type_url());
+    EXPECT_NE(CleartextKeysetHandle::GetKeysetHandle(keyset), nullptr);
+  }
+
+  // Null writer.
+  EXPECT_NE(CleartextKeysetHandle::GenerateNewAndWrite(key_template, config,
+                                                       10, nullptr),
+            util::OkStatus());
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
@@ -0,0 +1,86 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/flat_keyset_reader.h"
+
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "tink/internal/flat_keyset.h"
+#include "tink/util/errors.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+using google::crypto::tink::EncryptedKeyset;
+using google::crypto::tink::Keyset;
+
+//  static
+util::StatusOr<std::unique_ptr<FlatKeysetReader>> FlatKeysetReader::New(
+    absl::string_view flat_keyset) {
+  util::StatusOr<internal::FlatKeysetView> view =
+      internal::FlatKeysetView::Parse(flat_keyset);
+  if (!view.ok()) {
+    return view.status();
+  }
+  return absl::WrapUnique(new FlatKeysetReader(*view, /*contents=*/nullptr));
+}
+
+//  static
+util::StatusOr<std::unique_ptr<FlatKeysetReader>> FlatKeysetReader::NewFromFile(
+    const std::string& path) {
+  std::ifstream input(path, std::ios::binary);
+  if (!input.is_open()) {
+    return ToStatusF(absl::StatusCode::kNotFound, "Cannot open '%s'", path);
+  }
+  // The view points into the string, so it must not move after parsing.
+  auto contents = absl::make_unique<std::string>(
+      std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+  if (input.bad()) {
+    return ToStatusF(absl::StatusCode::kInternal, "Cannot read '%s'", path);
+  }
+  util::StatusOr<internal::FlatKeysetView> view =
+      internal::FlatKeysetView::Parse(*contents);
+  if (!view.ok()) {
+    return view.status();
+  }
+  return absl::WrapUnique(new FlatKeysetReader(*view, std::move(contents)));
+}
+
+util::StatusOr<std::unique_ptr<Keyset>> FlatKeysetReader::Read() {
+  auto keyset = absl::make_unique<Keyset>();
+  *keyset = *view_.ToKeyset();
+  return std::move(keyset);
+}
+
+util::StatusOr<std::unique_ptr<EncryptedKeyset>>
+FlatKeysetReader::ReadEncrypted() {
+  return util::Status(absl::StatusCode::kUnimplemented,
+                      "The flat keyset format does not support encrypted "
+                      "keysets.");
+}
+
+}  // namespace tink
+}  // namespace crypto
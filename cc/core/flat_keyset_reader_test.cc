@@ -0,0 +1,134 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/flat_keyset_reader.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "tink/internal/flat_keyset.h"
+#include "tink/internal/test_file_util.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "tink/util/test_util.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::test::AddLegacyKey;
+using ::crypto::tink::test::AddRawKey;
+using ::crypto::tink::test::AddTinkKey;
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::google::crypto::tink::KeyData;
+using ::google::crypto::tink::Keyset;
+using ::google::crypto::tink::KeyStatusType;
+
+class FlatKeysetReaderTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    Keyset::Key key;
+    AddTinkKey("some key type", 42, key, KeyStatusType::ENABLED,
+               KeyData::SYMMETRIC, &keyset_);
+    AddRawKey("some other key type", 711, key, KeyStatusType::ENABLED,
+              KeyData::SYMMETRIC, &keyset_);
+    AddLegacyKey("some key type", 3, key, KeyStatusType::DISABLED,
+                 KeyData::ASYMMETRIC_PRIVATE, &keyset_);
+    keyset_.set_primary_key_id(42);
+    util::StatusOr<std::string> flat_keyset =
+        internal::SerializeFlatKeyset(keyset_);
+    ASSERT_THAT(flat_keyset, IsOk());
+    flat_keyset_ = *flat_keyset;
+  }
+
+  Keyset keyset_;
+  std::string flat_keyset_;
+};
+
+TEST_F(FlatKeysetReaderTest, Read) {
+  util::StatusOr<std::unique_ptr<FlatKeysetReader>> reader =
+      FlatKeysetReader::New(flat_keyset_);
+  ASSERT_THAT(reader, IsOk());
+  EXPECT_EQ((*reader)->flat_keyset().data(), flat_keyset_.data());
+  util::StatusOr<std::unique_ptr<Keyset>> keyset = (*reader)->Read();
+  ASSERT_THAT(keyset, IsOk());
+  EXPECT_EQ((*keyset)->SerializeAsString(), keyset_.SerializeAsString());
+}
+
+TEST_F(FlatKeysetReaderTest, NewFailsOnInvalidInput) {
+  EXPECT_THAT(FlatKeysetReader::New("some weird string").status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(FlatKeysetReader::New(keyset_.SerializeAsString()).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST_F(FlatKeysetReaderTest, ReadEncryptedIsUnimplemented) {
+  util::StatusOr<std::unique_ptr<FlatKeysetReader>> reader =
+      FlatKeysetReader::New(flat_keyset_);
+  ASSERT_THAT(reader, IsOk());
+  EXPECT_THAT((*reader)->ReadEncrypted().status(),
+              StatusIs(absl::StatusCode::kUnimplemented));
+}
+
+TEST_F(FlatKeysetReaderTest, NewFromFile) {
+  std::string filename =
+      absl::StrCat(internal::GetTestFileNamePrefix(), "_keyset.flat");
+  ASSERT_THAT(internal::CreateTestFile(filename, flat_keyset_), IsOk());
+  util::StatusOr<std::unique_ptr<FlatKeysetReader>> reader =
+      FlatKeysetReader::NewFromFile(absl::StrCat(test::TmpDir(), "/", filename));
+  ASSERT_THAT(reader, IsOk());
+  EXPECT_EQ((*reader)->flat_keyset(), flat_keyset_);
+  util::StatusOr<std::unique_ptr<Keyset>> keyset = (*reader)->Read();
+  ASSERT_THAT(keyset, IsOk());
+  EXPECT_EQ((*keyset)->SerializeAsString(), keyset_.SerializeAsString());
+}
+
+TEST_F(FlatKeysetReaderTest, NewFromFileFailsOnInvalidFile) {
+  std::string filename =
+      absl::StrCat(internal::GetTestFileNamePrefix(), "_keyset.bin");
+  ASSERT_THAT(
+      internal::CreateTestFile(filename, keyset_.SerializeAsString()), IsOk());
+  EXPECT_THAT(
+      FlatKeysetReader::NewFromFile(absl::StrCat(test::TmpDir(), "/", filename))
+          .status(),
+      StatusIs(absl::StatusCode::kInvalidArgument));
+
+  std::string empty_filename =
+      absl::StrCat(internal::GetTestFileNamePrefix(), "_empty.flat");
+  ASSERT_THAT(internal::CreateTestFile(empty_filename, ""), IsOk());
+  EXPECT_THAT(FlatKeysetReader::NewFromFile(
+                  absl::StrCat(test::TmpDir(), "/", empty_filename))
+                  .status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST_F(FlatKeysetReaderTest, NewFromFileFailsOnMissingFile) {
+  EXPECT_THAT(FlatKeysetReader::NewFromFile(
+                  absl::StrCat(test::TmpDir(), "/does_not_exist.flat"))
+                  .status(),
+              StatusIs(absl::StatusCode::kNotFound));
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,68 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/flat_keyset_writer.h"
+
+#include <memory>
+#include <ostream>
+#include <string>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "tink/internal/flat_keyset.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "proto/tink.pb.h"
+
+using google::crypto::tink::EncryptedKeyset;
+using google::crypto::tink::Keyset;
+
+namespace crypto {
+namespace tink {
+
+//  static
+util::StatusOr<std::unique_ptr<FlatKeysetWriter>> FlatKeysetWriter::New(
+    std::unique_ptr<std::ostream> destination_stream) {
+  if (destination_stream == nullptr) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "destination_stream must be non-null.");
+  }
+  return absl::WrapUnique(new FlatKeysetWriter(std::move(destination_stream)));
+}
+
+util::Status FlatKeysetWriter::Write(const Keyset& keyset) {
+  util::StatusOr<std::string> flat_keyset =
+      internal::SerializeFlatKeyset(keyset);
+  if (!flat_keyset.ok()) {
+    return flat_keyset.status();
+  }
+  destination_stream_->write(flat_keyset->data(), flat_keyset->size());
+  if (destination_stream_->fail()) {
+    return util::Status(absl::StatusCode::kUnknown,
+                        "Error writing to the destination stream.");
+  }
+  return util::OkStatus();
+}
+
+util::Status FlatKeysetWriter::Write(const EncryptedKeyset& encrypted_keyset) {
+  return util::Status(absl::StatusCode::kUnimplemented,
+                      "The flat keyset format does not support encrypted "
+                      "keysets.");
+}
+
+}  // namespace tink
+}  // namespace crypto
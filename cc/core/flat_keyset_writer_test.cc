@@ -0,0 +1,124 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/flat_keyset_writer.h"
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/status/status.h"
+#include "tink/binary_keyset_reader.h"
+#include "tink/binary_keyset_writer.h"
+#include "tink/flat_keyset_reader.h"
+#include "tink/keyset_reader.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "tink/util/test_util.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::test::AddRawKey;
+using ::crypto::tink::test::AddTinkKey;
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::google::crypto::tink::EncryptedKeyset;
+using ::google::crypto::tink::KeyData;
+using ::google::crypto::tink::Keyset;
+using ::google::crypto::tink::KeyStatusType;
+
+Keyset TestKeyset() {
+  Keyset keyset;
+  Keyset::Key key;
+  AddTinkKey("some key type", 42, key, KeyStatusType::ENABLED,
+             KeyData::SYMMETRIC, &keyset);
+  AddRawKey("some other key type", 711, key, KeyStatusType::ENABLED,
+            KeyData::SYMMETRIC, &keyset);
+  keyset.set_primary_key_id(42);
+  return keyset;
+}
+
+TEST(FlatKeysetWriterTest, NullStream) {
+  EXPECT_THAT(FlatKeysetWriter::New(nullptr).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(FlatKeysetWriterTest, WriteAndRead) {
+  Keyset keyset = TestKeyset();
+  std::stringbuf buffer;
+  util::StatusOr<std::unique_ptr<FlatKeysetWriter>> writer =
+      FlatKeysetWriter::New(std::make_unique<std::ostream>(&buffer));
+  ASSERT_THAT(writer, IsOk());
+  ASSERT_THAT((*writer)->Write(keyset), IsOk());
+
+  std::string flat_keyset = buffer.str();
+  util::StatusOr<std::unique_ptr<FlatKeysetReader>> reader =
+      FlatKeysetReader::New(flat_keyset);
+  ASSERT_THAT(reader, IsOk());
+  util::StatusOr<std::unique_ptr<Keyset>> read_keyset = (*reader)->Read();
+  ASSERT_THAT(read_keyset, IsOk());
+  EXPECT_EQ((*read_keyset)->SerializeAsString(), keyset.SerializeAsString());
+}
+
+// Converting from the binary format to the flat format and back preserves the
+// keyset.
+TEST(FlatKeysetWriterTest, ConvertFromAndToBinaryFormat) {
+  Keyset keyset = TestKeyset();
+  util::StatusOr<std::unique_ptr<KeysetReader>> binary_reader =
+      BinaryKeysetReader::New(keyset.SerializeAsString());
+  ASSERT_THAT(binary_reader, IsOk());
+  util::StatusOr<std::unique_ptr<Keyset>> parsed = (*binary_reader)->Read();
+  ASSERT_THAT(parsed, IsOk());
+
+  std::stringbuf flat_buffer;
+  util::StatusOr<std::unique_ptr<FlatKeysetWriter>> flat_writer =
+      FlatKeysetWriter::New(std::make_unique<std::ostream>(&flat_buffer));
+  ASSERT_THAT(flat_writer, IsOk());
+  ASSERT_THAT((*flat_writer)->Write(**parsed), IsOk());
+
+  std::string flat_keyset = flat_buffer.str();
+  util::StatusOr<std::unique_ptr<FlatKeysetReader>> flat_reader =
+      FlatKeysetReader::New(flat_keyset);
+  ASSERT_THAT(flat_reader, IsOk());
+  util::StatusOr<std::unique_ptr<Keyset>> from_flat = (*flat_reader)->Read();
+  ASSERT_THAT(from_flat, IsOk());
+
+  std::stringbuf binary_buffer;
+  util::StatusOr<std::unique_ptr<BinaryKeysetWriter>> binary_writer =
+      BinaryKeysetWriter::New(std::make_unique<std::ostream>(&binary_buffer));
+  ASSERT_THAT(binary_writer, IsOk());
+  ASSERT_THAT((*binary_writer)->Write(**from_flat), IsOk());
+  EXPECT_EQ(binary_buffer.str(), keyset.SerializeAsString());
+}
+
+TEST(FlatKeysetWriterTest, WriteEncryptedIsUnimplemented) {
+  std::stringbuf buffer;
+  util::StatusOr<std::unique_ptr<FlatKeysetWriter>> writer =
+      FlatKeysetWriter::New(std::make_unique<std::ostream>(&buffer));
+  ASSERT_THAT(writer, IsOk());
+  EXPECT_THAT((*writer)->Write(EncryptedKeyset()),
+              StatusIs(absl::StatusCode::kUnimplemented));
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
@@ -16,18 +16,23 @@
 
 #include "tink/keyset_handle.h"
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/functional/function_ref.h"
 #include "absl/log/check.h"
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
+#include "absl/types/span.h"
 #include "tink/aead.h"
 #include "tink/config/global_registry.h"
 #include "tink/insecure_secret_key_access.h"
@@ -37,6 +42,8 @@
 #include "tink/internal/key_type_info_store.h"
 #include "tink/internal/mutable_serialization_registry.h"
 #include "tink/internal/proto_key_serialization.h"
+#include "tink/internal/registry_impl.h"
+#include "tink/internal/run_in_parallel.h"
 #include "tink/internal/util.h"
 #include "tink/key.h"
 #include "tink/key_gen_configuration.h"
@@ -46,8 +53,10 @@
 #include "tink/keyset_writer.h"
 #include "tink/registry.h"
 #include "tink/restricted_data.h"
+#include "tink/subtle/random.h"
 #include "tink/util/errors.h"
 #include "tink/util/keyset_util.h"
+#include "tink/util/secret_data.h"
 #include "tink/util/secret_proto.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
@@ -77,6 +86,44 @@ util::StatusOr<std::unique_ptr<EncryptedKeyset>> Encrypt(
   return std::move(enc_keyset);
 }
 
+// Number of keysets that KeysetHandle::GenerateKeysets() generates per chunk,
+// and per parallel task within a chunk.
+constexpr int64_t kKeysetChunkSize = 4096;
+constexpr int kKeysetsPerTask = 64;
+
+// Returns `count` random non-zero key IDs, drawn with one call to the random
+// number generator.
+std::vector<uint32_t> NewKeyIds(int count) {
+  std::string bytes = subtle::Random::GetRandomBytes(count * sizeof(uint32_t));
+  std::vector<uint32_t> key_ids(count);
+  std::memcpy(key_ids.data(), bytes.data(), bytes.size());
+  for (uint32_t& key_id : key_ids) {
+    while (key_id == 0) key_id = subtle::Random::GetRandomUInt32();
+  }
+  return key_ids;
+}
+
+// Generates a key with `factory` from `key_template` and adds it to `keyset`
+// with ID `key_id`.
+util::Status AddNewKey(const KeyFactory& factory,
+                       const KeyTemplate& key_template, bool as_primary,
+                       uint32_t key_id, Keyset* keyset) {
+  util::StatusOr<std::unique_ptr<KeyData>> key_data =
+      factory.NewKeyData(key_template.value());
+  if (!key_data.ok()) {
+    return key_data.status();
+  }
+  Keyset::Key* key = keyset->add_key();
+  *(key->mutable_key_data()) = *std::move(key_data).value();
+  key->set_status(KeyStatusType::ENABLED);
+  key->set_output_prefix_type(key_template.output_prefix_type());
+  key->set_key_id(key_id);
+  if (as_primary) {
+    keyset->set_primary_key_id(key_id);
+  }
+  return util::OkStatus();
+}
+
 util::StatusOr<util::SecretProto<Keyset>> Decrypt(
     const EncryptedKeyset& enc_keyset, const Aead& master_key_aead,
     absl::string_view associated_data) {
@@ -362,6 +409,65 @@ util::StatusOr<std::unique_ptr<KeysetHandle>> KeysetHandle::GenerateNew(
   return GenerateNew(key_template, config, /*monitoring_annotations=*/{});
 }
 
+util::Status KeysetHandle::GenerateNewAndWrite(
+    const KeyTemplate& key_template, const KeyGenConfiguration& config,
+    int64_t count, const Aead& master_key_aead,
+    absl::string_view associated_data, KeysetWriter* writer) {
+  if (writer == nullptr) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "Writer must be non-null");
+  }
+  std::vector<std::string> serialized_keysets;
+  std::vector<util::StatusOr<std::vector<std::string>>> ciphertexts;
+  return GenerateKeysets(
+      key_template, config, count,
+      [&](absl::Span<util::SecretProto<Keyset>> keysets) -> util::Status {
+        serialized_keysets.resize(keysets.size());
+        const size_t num_tasks =
+            (keysets.size() + kKeysetsPerTask - 1) / kKeysetsPerTask;
+        ciphertexts.clear();
+        for (size_t i = 0; i < num_tasks; ++i) {
+          ciphertexts.push_back(util::Status(absl::StatusCode::kInternal,
+                                             "Encryption did not run."));
+        }
+        // Each task encrypts its keysets with one EncryptBatch() call.
+        internal::RunInParallel(num_tasks, [&](size_t task) {
+          const size_t begin = task * kKeysetsPerTask;
+          const size_t end =
+              std::min(keysets.size(), begin + kKeysetsPerTask);
+          std::vector<absl::string_view> plaintexts;
+          for (size_t i = begin; i < end; ++i) {
+            serialized_keysets[i] = keysets[i]->SerializeAsString();
+            plaintexts.push_back(serialized_keysets[i]);
+          }
+          std::vector<absl::string_view> associated_datas(plaintexts.size(),
+                                                          associated_data);
+          ciphertexts[task] =
+              master_key_aead.EncryptBatch(plaintexts, associated_datas);
+          for (size_t i = begin; i < end; ++i) {
+            util::SafeZeroString(&serialized_keysets[i]);
+          }
+        });
+        EncryptedKeyset encrypted_keyset;
+        for (util::StatusOr<std::vector<std::string>>& task_ciphertexts :
+             ciphertexts) {
+          if (!task_ciphertexts.ok()) {
+            return ToStatusF(absl::StatusCode::kInvalidArgument,
+                             "Encryption of the keyset failed: %s",
+                             task_ciphertexts.status().message());
+          }
+          for (std::string& ciphertext : *task_ciphertexts) {
+            encrypted_keyset.set_encrypted_keyset(std::move(ciphertext));
+            util::Status status = writer->Write(encrypted_keyset);
+            if (!status.ok()) {
+              return status;
+            }
+          }
+        }
+        return util::OkStatus();
+      });
+}
+
 util::StatusOr<std::unique_ptr<Keyset::Key>> ExtractPublicKey(
     const Keyset::Key& key, const KeyGenConfiguration& config) {
   if (key.key_data().key_material_type() != KeyData::ASYMMETRIC_PRIVATE) {
@@ -429,45 +535,96 @@ KeysetHandle::GetPublicKeysetHandle(const KeyGenConfiguration& config) const {
 crypto::tink::util::StatusOr<uint32_t> KeysetHandle::AddToKeyset(
     const google::crypto::tink::KeyTemplate& key_template, bool as_primary,
     const KeyGenConfiguration& config, Keyset* keyset) {
+  return AddToKeyset(key_template, as_primary, GenerateUnusedKeyId(*keyset),
+                     config, keyset);
+}
+
+crypto::tink::util::StatusOr<uint32_t> KeysetHandle::AddToKeyset(
+    const google::crypto::tink::KeyTemplate& key_template, bool as_primary,
+    uint32_t key_id, const KeyGenConfiguration& config, Keyset* keyset) {
+  util::StatusOr<const KeyFactory*> factory =
+      GetNewKeyFactory(key_template, config);
+  if (!factory.ok()) {
+    return factory.status();
+  }
+  util::Status status =
+      AddNewKey(**factory, key_template, as_primary, key_id, keyset);
+  if (!status.ok()) {
+    return status;
+  }
+  return key_id;
+}
+
+crypto::tink::util::StatusOr<const KeyFactory*> KeysetHandle::GetNewKeyFactory(
+    const google::crypto::tink::KeyTemplate& key_template,
+    const KeyGenConfiguration& config) {
   if (key_template.output_prefix_type() ==
       google::crypto::tink::OutputPrefixType::UNKNOWN_PREFIX) {
     return util::Status(absl::StatusCode::kInvalidArgument,
                         "key template has unknown prefix");
   }
-
-  // Generate new key data.
-  util::StatusOr<std::unique_ptr<KeyData>> key_data;
   if (internal::KeyGenConfigurationImpl::IsInGlobalRegistryMode(config)) {
-    key_data = Registry::NewKeyData(key_template);
-  } else {
-    util::StatusOr<const internal::KeyTypeInfoStore*> key_type_info_store =
-        internal::KeyGenConfigurationImpl::GetKeyTypeInfoStore(config);
-    if (!key_type_info_store.ok()) {
-      return key_type_info_store.status();
-    }
-    util::StatusOr<const internal::KeyTypeInfoStore::Info*> key_type_info =
-        (*key_type_info_store)->Get(key_template.type_url());
-    if (!key_type_info.ok()) {
-      return key_type_info.status();
-    }
-    key_data = (*key_type_info)->key_factory().NewKeyData(key_template.value());
+    return internal::RegistryImpl::GlobalInstance().GetNewKeyFactory(
+        key_template.type_url());
   }
-  if (!key_data.ok()) {
-    return key_data.status();
+  util::StatusOr<const internal::KeyTypeInfoStore*> key_type_info_store =
+      internal::KeyGenConfigurationImpl::GetKeyTypeInfoStore(config);
+  if (!key_type_info_store.ok()) {
+    return key_type_info_store.status();
   }
+  util::StatusOr<const internal::KeyTypeInfoStore::Info*> key_type_info =
+      (*key_type_info_store)->Get(key_template.type_url());
+  if (!key_type_info.ok()) {
+    return key_type_info.status();
+  }
+  return &(*key_type_info)->key_factory();
+}
 
-  // Add and fill in new key in `keyset`.
-  Keyset::Key* key = keyset->add_key();
-  *(key->mutable_key_data()) = *std::move(key_data).value();
-  key->set_status(KeyStatusType::ENABLED);
-  key->set_output_prefix_type(key_template.output_prefix_type());
-
-  uint32_t key_id = GenerateUnusedKeyId(*keyset);
-  key->set_key_id(key_id);
-  if (as_primary) {
-    keyset->set_primary_key_id(key_id);
+crypto::tink::util::Status KeysetHandle::GenerateKeysets(
+    const google::crypto::tink::KeyTemplate& key_template,
+    const KeyGenConfiguration& config, int64_t count,
+    absl::FunctionRef<util::Status(absl::Span<util::SecretProto<Keyset>>)>
+        consume) {
+  if (count < 0) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "count must be non-negative");
+  }
+  util::StatusOr<const KeyFactory*> factory =
+      GetNewKeyFactory(key_template, config);
+  if (!factory.ok()) {
+    return factory.status();
+  }
+  std::vector<util::SecretProto<Keyset>> keysets;
+  std::vector<util::Status> statuses;
+  for (int64_t start = 0; start < count; start += kKeysetChunkSize) {
+    const int chunk_size =
+        static_cast<int>(std::min(kKeysetChunkSize, count - start));
+    const std::vector<uint32_t> key_ids = NewKeyIds(chunk_size);
+    keysets.clear();
+    keysets.resize(chunk_size);
+    const size_t num_tasks =
+        (chunk_size + kKeysetsPerTask - 1) / kKeysetsPerTask;
+    statuses.assign(num_tasks, util::OkStatus());
+    internal::RunInParallel(num_tasks, [&](size_t task) {
+      const int begin = task * kKeysetsPerTask;
+      const int end = std::min(chunk_size, begin + kKeysetsPerTask);
+      for (int i = begin; i < end && statuses[task].ok(); ++i) {
+        statuses[task] = AddNewKey(**factory, key_template,
+                                   /*as_primary=*/true, key_ids[i],
+                                   keysets[i].get());
+      }
+    });
+    for (const util::Status& status : statuses) {
+      if (!status.ok()) {
+        return status;
+      }
+    }
+    util::Status status = consume(absl::MakeSpan(keysets));
+    if (!status.ok()) {
+      return status;
+    }
   }
-  return key_id;
+  return util::OkStatus();
 }
 
 crypto::tink::util::StatusOr<uint32_t> KeysetHandle::AddKey(
@@ -18,11 +18,11 @@
 
 #include <iostream>
 #include <memory>
-#include <set>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_set.h"
 #include "absl/log/check.h"
 #include "absl/status/status.h"
 #include "absl/strings/string_view.h"
@@ -87,7 +87,8 @@ KeysetHandleBuilder::Entry KeysetHandleBuilder::Entry::CreateFromParams(
 }
 
 util::StatusOr<int> KeysetHandleBuilder::NextIdFromKeyIdStrategy(
-    internal::KeyIdStrategy strategy, const std::set<int>& ids_so_far) {
+    internal::KeyIdStrategy strategy,
+    const absl::flat_hash_set<int>& ids_so_far) {
   if (strategy.strategy == internal::KeyIdStrategyEnum::kFixedId) {
     if (!strategy.id_requirement.has_value()) {
       return util::Status(absl::StatusCode::kInvalidArgument,
@@ -97,7 +98,7 @@ util::StatusOr<int> KeysetHandleBuilder::NextIdFromKeyIdStrategy(
   }
   if (strategy.strategy == internal::KeyIdStrategyEnum::kRandomId) {
     int id = 0;
-    while (id == 0 || ids_so_far.find(id) != ids_so_far.end()) {
+    while (id == 0 || ids_so_far.contains(id)) {
       id = subtle::Random::GetRandomUInt32();
     }
     return id;
@@ -157,23 +158,24 @@ util::StatusOr<KeysetHandle> KeysetHandleBuilder::Build() {
   util::Status assigned_ids_status = CheckIdAssignments();
   if (!assigned_ids_status.ok()) return assigned_ids_status;
 
-  std::set<int> ids_so_far;
+  absl::flat_hash_set<int> ids_so_far;
+  ids_so_far.reserve(entries_.size());
+  keyset->mutable_key()->Reserve(entries_.size());
   for (KeysetHandleBuilder::Entry& entry : entries_) {
     util::StatusOr<int> id =
         NextIdFromKeyIdStrategy(entry.GetKeyIdStrategy(), ids_so_far);
     if (!id.ok()) return id.status();
 
-    if (ids_so_far.find(*id) != ids_so_far.end()) {
+    if (!ids_so_far.insert(*id).second) {
       return util::Status(
           absl::StatusCode::kAlreadyExists,
           absl::StrFormat("Next id %d is already used in the keyset.", *id));
     }
-    ids_so_far.insert(*id);
 
     util::StatusOr<Keyset::Key> key = entry.CreateKeysetKey(*id);
     if (!key.ok()) return key.status();
 
-    *keyset->add_key() = *key;
+    *keyset->add_key() = *std::move(key);
     if (entry.IsPrimary()) {
       if (primary_id.has_value()) {
         return util::Status(
@@ -21,6 +21,7 @@
 #include <sstream>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -45,6 +46,7 @@
 #include "tink/json_keyset_writer.h"
 #include "tink/key_gen_configuration.h"
 #include "tink/key_status.h"
+#include "tink/keyset_writer.h"
 #include "tink/primitive_set.h"
 #include "tink/primitive_wrapper.h"
 #include "tink/signature/ecdsa_sign_key_manager.h"
@@ -68,6 +70,7 @@ using ::crypto::tink::test::AddRawKey;
 using ::crypto::tink::test::AddTinkKey;
 using ::crypto::tink::test::DummyAead;
 using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::IsOkAndHolds;
 using ::crypto::tink::test::StatusIs;
 using ::google::crypto::tink::AesGcmKey;
 using ::google::crypto::tink::AesGcmKeyFormat;
@@ -685,6 +688,133 @@ TEST_F(KeysetHandleTest, UnknownPrefixIsInvalid) {
   EXPECT_FALSE(handle_result.ok());
 }
 
+// KeysetWriter that keeps everything written to it, in order.
+class RecordingKeysetWriter : public KeysetWriter {
+ public:
+  util::Status Write(const Keyset& keyset) override {
+    keysets_.push_back(keyset);
+    return util::OkStatus();
+  }
+
+  util::Status Write(const EncryptedKeyset& encrypted_keyset) override {
+    encrypted_keysets_.push_back(encrypted_keyset);
+    return util::OkStatus();
+  }
+
+  const std::vector<Keyset>& keysets() const { return keysets_; }
+  const std::vector<EncryptedKeyset>& encrypted_keysets() const {
+    return encrypted_keysets_;
+  }
+
+ private:
+  std::vector<Keyset> keysets_;
+  std::vector<EncryptedKeyset> encrypted_keysets_;
+};
+
+TEST_F(KeysetHandleTest, GenerateNewAndWrite) {
+  // More than one chunk of keysets, so that the chunks are written in order.
+  const int kCount = 5000;
+  DummyAead master_key_aead("dummy aead 42");
+  RecordingKeysetWriter writer;
+  ASSERT_THAT(KeysetHandle::GenerateNewAndWrite(
+                  AeadKeyTemplates::Aes128Gcm(), KeyGenConfigGlobalRegistry(),
+                  kCount, master_key_aead, "aad", &writer),
+              IsOk());
+  ASSERT_THAT(writer.keysets(), SizeIs(0));
+  ASSERT_THAT(writer.encrypted_keysets(), SizeIs(kCount));
+
+  for (const EncryptedKeyset& encrypted_keyset : writer.encrypted_keysets()) {
+    util::StatusOr<std::string> serialized_keyset =
+        master_key_aead.Decrypt(encrypted_keyset.encrypted_keyset(), "aad");
+    ASSERT_THAT(serialized_keyset, IsOk());
+    Keyset keyset;
+    ASSERT_TRUE(keyset.ParseFromString(*serialized_keyset));
+    ASSERT_THAT(keyset.key(), SizeIs(1));
+    const Keyset::Key& key = keyset.key(0);
+    EXPECT_NE(key.key_id(), 0);
+    EXPECT_EQ(keyset.primary_key_id(), key.key_id());
+    EXPECT_EQ(key.status(), KeyStatusType::ENABLED);
+    EXPECT_EQ(key.output_prefix_type(),
+              AeadKeyTemplates::Aes128Gcm().output_prefix_type());
+    EXPECT_EQ(key.key_data().type_url(),
+              AeadKeyTemplates::Aes128Gcm().type_url());
+  }
+
+  // The written keysets can be read back and used.
+  util::StatusOr<std::unique_ptr<KeysetReader>> reader =
+      BinaryKeysetReader::New(
+          writer.encrypted_keysets().back().SerializeAsString());
+  ASSERT_THAT(reader, IsOk());
+  util::StatusOr<std::unique_ptr<KeysetHandle>> handle =
+      KeysetHandle::ReadWithAssociatedData(std::move(*reader), master_key_aead,
+                                           "aad");
+  ASSERT_THAT(handle, IsOk());
+  util::StatusOr<std::unique_ptr<Aead>> aead =
+      (*handle)->GetPrimitive<Aead>(ConfigGlobalRegistry());
+  ASSERT_THAT(aead, IsOk());
+  util::StatusOr<std::string> ciphertext = (*aead)->Encrypt("plaintext", "");
+  ASSERT_THAT(ciphertext, IsOk());
+  EXPECT_THAT((*aead)->Decrypt(*ciphertext, ""), IsOkAndHolds("plaintext"));
+}
+
+TEST_F(KeysetHandleTest, GenerateNewAndWriteNothing) {
+  DummyAead master_key_aead("dummy aead 42");
+  RecordingKeysetWriter writer;
+  EXPECT_THAT(KeysetHandle::GenerateNewAndWrite(
+                  AeadKeyTemplates::Aes128Gcm(), KeyGenConfigGlobalRegistry(),
+                  /*count=*/0, master_key_aead, "aad", &writer),
+              IsOk());
+  EXPECT_THAT(writer.encrypted_keysets(), SizeIs(0));
+}
+
+TEST_F(KeysetHandleTest, GenerateNewAndWriteWithBespokeConfig) {
+  DummyAead master_key_aead("dummy aead 42");
+  KeyGenConfiguration config;
+  RecordingKeysetWriter writer;
+  EXPECT_THAT(KeysetHandle::GenerateNewAndWrite(AeadKeyTemplates::Aes128Gcm(),
+                                                config, 3, master_key_aead,
+                                                "aad", &writer),
+              StatusIs(absl::StatusCode::kNotFound));
+
+  ASSERT_THAT(internal::KeyGenConfigurationImpl::AddKeyTypeManager(
+                  absl::make_unique<AesGcmKeyManager>(), config),
+              IsOk());
+  EXPECT_THAT(KeysetHandle::GenerateNewAndWrite(AeadKeyTemplates::Aes128Gcm(),
+                                                config, 3, master_key_aead,
+                                                "aad", &writer),
+              IsOk());
+  EXPECT_THAT(writer.encrypted_keysets(), SizeIs(3));
+}
+
+TEST_F(KeysetHandleTest, GenerateNewAndWriteErrors) {
+  DummyAead master_key_aead("dummy aead 42");
+  RecordingKeysetWriter writer;
+  EXPECT_THAT(KeysetHandle::GenerateNewAndWrite(
+                  AeadKeyTemplates::Aes128Gcm(), KeyGenConfigGlobalRegistry(),
+                  3, master_key_aead, "aad", /*writer=*/nullptr),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(KeysetHandle::GenerateNewAndWrite(
+                  AeadKeyTemplates::Aes128Gcm(), KeyGenConfigGlobalRegistry(),
+                  -1, master_key_aead, "aad", &writer),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+
+  KeyTemplate unknown_type;
+  unknown_type.set_type_url("type.googleapis.com/some.unknown.KeyType");
+  unknown_type.set_output_prefix_type(OutputPrefixType::TINK);
+  EXPECT_THAT(KeysetHandle::GenerateNewAndWrite(
+                  unknown_type, KeyGenConfigGlobalRegistry(), 3,
+                  master_key_aead, "aad", &writer),
+              StatusIs(absl::StatusCode::kNotFound));
+
+  KeyTemplate unknown_prefix(AeadKeyTemplates::Aes128Gcm());
+  unknown_prefix.set_output_prefix_type(OutputPrefixType::UNKNOWN_PREFIX);
+  EXPECT_THAT(KeysetHandle::GenerateNewAndWrite(
+                  unknown_prefix, KeyGenConfigGlobalRegistry(), 3,
+                  master_key_aead, "aad", &writer),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(writer.encrypted_keysets(), SizeIs(0));
+}
+
 void CompareKeyMetadata(const Keyset::Key& expected,
                         const Keyset::Key& actual) {
   EXPECT_EQ(expected.status(), actual.status());
@@ -16,12 +16,19 @@
 
 #include "tink/keyset_manager.h"
 
+#include <cstdint>
 #include <memory>
 #include <utility>
+#include <vector>
 
+#include "absl/container/flat_hash_set.h"
+#include "absl/functional/function_ref.h"
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
+#include "absl/types/span.h"
 #include "tink/internal/key_gen_configuration_impl.h"
+#include "tink/internal/key_info.h"
+#include "tink/internal/keyset_index.h"
 #include "tink/key_gen_configuration.h"
 #include "tink/keyset_handle.h"
 #include "tink/util/enums.h"
@@ -37,6 +44,7 @@ using ::crypto::tink::util::Enums;
 using ::crypto::tink::util::Status;
 using ::crypto::tink::util::StatusOr;
 using google::crypto::tink::Keyset;
+using google::crypto::tink::KeysetInfo;
 using google::crypto::tink::KeyStatusType;
 using google::crypto::tink::KeyTemplate;
 
@@ -55,6 +63,7 @@ StatusOr<std::unique_ptr<KeysetManager>> KeysetManager::New(
   auto manager = absl::make_unique<KeysetManager>();
   absl::MutexLock lock(&manager->keyset_mutex_);
   *manager->keyset_ = keyset_handle.get_keyset();
+  manager->key_index_.Rebuild(*manager->keyset_);
   return std::move(manager);
 }
 
@@ -77,113 +86,217 @@ StatusOr<uint32_t> KeysetManager::Add(
     return status;
   }
   absl::MutexLock lock(&keyset_mutex_);
-  return KeysetHandle::AddToKeyset(key_template, as_primary, config,
-                                   keyset_.get());
+  StatusOr<uint32_t> key_id = KeysetHandle::AddToKeyset(
+      key_template, as_primary, key_index_.GenerateUnusedKeyId(), config,
+      keyset_.get());
+  if (!key_id.ok()) {
+    return key_id.status();
+  }
+  key_index_.Add(*key_id, keyset_->key_size() - 1);
+  return key_id;
 }
 
 StatusOr<uint32_t> KeysetManager::Rotate(const KeyTemplate& key_template) {
   return Add(key_template, true);
 }
 
-Status KeysetManager::Enable(uint32_t key_id) {
-  absl::MutexLock lock(&keyset_mutex_);
-  for (auto& key : *(keyset_->mutable_key())) {
-    if (key.key_id() == key_id) {
-      if (key.status() != KeyStatusType::DISABLED &&
-          key.status() != KeyStatusType::ENABLED) {
-        return ToStatusF(absl::StatusCode::kInvalidArgument,
-                         "Cannot enable key with key_id %u and status %s.",
-                         key_id, Enums::KeyStatusName(key.status()));
-      }
-      key.set_status(KeyStatusType::ENABLED);
-      return util::OkStatus();
-    }
-  }
+Keyset::Key* KeysetManager::FindKey(uint32_t key_id) {
+  int position = key_index_.Find(key_id);
+  if (position < 0) return nullptr;
+  return keyset_->mutable_key(position);
+}
+
+namespace {
+
+Status KeyNotFound(uint32_t key_id) {
   return ToStatusF(absl::StatusCode::kNotFound,
                    "No key with key_id %u found in the keyset.", key_id);
 }
 
-Status KeysetManager::Disable(uint32_t key_id) {
-  absl::MutexLock lock(&keyset_mutex_);
-  if (keyset_->primary_key_id() == key_id) {
+Status CheckCanEnable(const Keyset::Key* key, uint32_t key_id) {
+  if (key == nullptr) return KeyNotFound(key_id);
+  if (key->status() != KeyStatusType::DISABLED &&
+      key->status() != KeyStatusType::ENABLED) {
+    return ToStatusF(absl::StatusCode::kInvalidArgument,
+                     "Cannot enable key with key_id %u and status %s.", key_id,
+                     Enums::KeyStatusName(key->status()));
+  }
+  return util::OkStatus();
+}
+
+Status CheckCanDisable(const Keyset& keyset, const Keyset::Key* key,
+                       uint32_t key_id) {
+  if (keyset.primary_key_id() == key_id) {
     return ToStatusF(absl::StatusCode::kInvalidArgument,
                      "Cannot disable primary key (key_id %u).", key_id);
   }
-  for (auto& key : *(keyset_->mutable_key())) {
-    if (key.key_id() == key_id) {
-      if (key.status() != KeyStatusType::DISABLED &&
-          key.status() != KeyStatusType::ENABLED) {
-        return ToStatusF(absl::StatusCode::kInvalidArgument,
-                         "Cannot disable key with key_id %u and status %s.",
-                         key_id, Enums::KeyStatusName(key.status()));
-      }
-      key.set_status(KeyStatusType::DISABLED);
-      return util::OkStatus();
-    }
+  if (key == nullptr) return KeyNotFound(key_id);
+  if (key->status() != KeyStatusType::DISABLED &&
+      key->status() != KeyStatusType::ENABLED) {
+    return ToStatusF(absl::StatusCode::kInvalidArgument,
+                     "Cannot disable key with key_id %u and status %s.",
+                     key_id, Enums::KeyStatusName(key->status()));
   }
-  return ToStatusF(absl::StatusCode::kNotFound,
-                   "No key with key_id %u found in the keyset.", key_id);
+  return util::OkStatus();
 }
 
-Status KeysetManager::Delete(uint32_t key_id) {
-  absl::MutexLock lock(&keyset_mutex_);
-  if (keyset_->primary_key_id() == key_id) {
+Status CheckCanDestroy(const Keyset& keyset, const Keyset::Key* key,
+                       uint32_t key_id) {
+  if (keyset.primary_key_id() == key_id) {
     return ToStatusF(absl::StatusCode::kInvalidArgument,
-                     "Cannot delete primary key (key_id %u).", key_id);
+                     "Cannot destroy primary key (key_id %u).", key_id);
   }
-  auto key_field = keyset_->mutable_key();
-  for (auto key_iter = key_field->begin(); key_iter != key_field->end();
-       key_iter++) {
-    auto key = *key_iter;
-    if (key.key_id() == key_id) {
-      keyset_->mutable_key()->erase(key_iter);
-      return util::OkStatus();
-    }
+  if (key == nullptr) return KeyNotFound(key_id);
+  if (key->status() != KeyStatusType::DISABLED &&
+      key->status() != KeyStatusType::DESTROYED &&
+      key->status() != KeyStatusType::ENABLED) {
+    return ToStatusF(absl::StatusCode::kInvalidArgument,
+                     "Cannot destroy key with key_id %u and status %s.",
+                     key_id, Enums::KeyStatusName(key->status()));
   }
-  return ToStatusF(absl::StatusCode::kNotFound,
-                   "No key with key_id %u found in the keyset.", key_id);
+  return util::OkStatus();
+}
+
+Status CheckCanDelete(const Keyset& keyset, const Keyset::Key* key,
+                      uint32_t key_id) {
+  if (keyset.primary_key_id() == key_id) {
+    return ToStatusF(absl::StatusCode::kInvalidArgument,
+                     "Cannot delete primary key (key_id %u).", key_id);
+  }
+  if (key == nullptr) return KeyNotFound(key_id);
+  return util::OkStatus();
+}
+
+void DestroyKey(Keyset::Key* key) {
+  key->clear_key_data();
+  key->set_status(KeyStatusType::DESTROYED);
+}
+
+}  // namespace
+
+Status KeysetManager::Enable(uint32_t key_id) {
+  absl::MutexLock lock(&keyset_mutex_);
+  Keyset::Key* key = FindKey(key_id);
+  Status status = CheckCanEnable(key, key_id);
+  if (!status.ok()) return status;
+  key->set_status(KeyStatusType::ENABLED);
+  return util::OkStatus();
+}
+
+Status KeysetManager::Disable(uint32_t key_id) {
+  absl::MutexLock lock(&keyset_mutex_);
+  Keyset::Key* key = FindKey(key_id);
+  Status status = CheckCanDisable(*keyset_, key, key_id);
+  if (!status.ok()) return status;
+  key->set_status(KeyStatusType::DISABLED);
+  return util::OkStatus();
+}
+
+Status KeysetManager::Delete(uint32_t key_id) {
+  absl::MutexLock lock(&keyset_mutex_);
+  int position = key_index_.Find(key_id);
+  Status status = CheckCanDelete(
+      *keyset_, position < 0 ? nullptr : &keyset_->key(position), key_id);
+  if (!status.ok()) return status;
+  keyset_->mutable_key()->DeleteSubrange(position, 1);
+  key_index_.Rebuild(*keyset_);
+  return util::OkStatus();
 }
 
 Status KeysetManager::Destroy(uint32_t key_id) {
   absl::MutexLock lock(&keyset_mutex_);
-  if (keyset_->primary_key_id() == key_id) {
+  Keyset::Key* key = FindKey(key_id);
+  Status status = CheckCanDestroy(*keyset_, key, key_id);
+  if (!status.ok()) return status;
+  DestroyKey(key);
+  return util::OkStatus();
+}
+
+Status KeysetManager::SetPrimary(uint32_t key_id) {
+  absl::MutexLock lock(&keyset_mutex_);
+  const Keyset::Key* key = FindKey(key_id);
+  if (key == nullptr) return KeyNotFound(key_id);
+  if (key->status() != KeyStatusType::ENABLED) {
     return ToStatusF(absl::StatusCode::kInvalidArgument,
-                     "Cannot destroy primary key (key_id %u).", key_id);
+                     "The candidate for the primary key must be ENABLED"
+                     " (key_id %u).",
+                     key_id);
   }
-  for (auto& key : *(keyset_->mutable_key())) {
-    if (key.key_id() == key_id) {
-      if (key.status() != KeyStatusType::DISABLED &&
-          key.status() != KeyStatusType::DESTROYED &&
-          key.status() != KeyStatusType::ENABLED) {
-        return ToStatusF(absl::StatusCode::kInvalidArgument,
-                         "Cannot destroy key with key_id %u and status %s.",
-                         key_id, Enums::KeyStatusName(key.status()));
-      }
-      key.clear_key_data();
-      key.set_status(KeyStatusType::DESTROYED);
-      return util::OkStatus();
-    }
+  keyset_->set_primary_key_id(key_id);
+  return util::OkStatus();
+}
+
+Status KeysetManager::EnableKeys(absl::Span<const uint32_t> key_ids) {
+  absl::MutexLock lock(&keyset_mutex_);
+  std::vector<Keyset::Key*> keys;
+  keys.reserve(key_ids.size());
+  for (uint32_t key_id : key_ids) {
+    Keyset::Key* key = FindKey(key_id);
+    Status status = CheckCanEnable(key, key_id);
+    if (!status.ok()) return status;
+    keys.push_back(key);
   }
-  return ToStatusF(absl::StatusCode::kNotFound,
-                   "No key with key_id %u found in the keyset.", key_id);
+  for (Keyset::Key* key : keys) {
+    key->set_status(KeyStatusType::ENABLED);
+  }
+  return util::OkStatus();
 }
 
-Status KeysetManager::SetPrimary(uint32_t key_id) {
+Status KeysetManager::DisableKeys(absl::Span<const uint32_t> key_ids) {
+  absl::MutexLock lock(&keyset_mutex_);
+  std::vector<Keyset::Key*> keys;
+  keys.reserve(key_ids.size());
+  for (uint32_t key_id : key_ids) {
+    Keyset::Key* key = FindKey(key_id);
+    Status status = CheckCanDisable(*keyset_, key, key_id);
+    if (!status.ok()) return status;
+    keys.push_back(key);
+  }
+  for (Keyset::Key* key : keys) {
+    key->set_status(KeyStatusType::DISABLED);
+  }
+  return util::OkStatus();
+}
+
+Status KeysetManager::DestroyKeys(absl::Span<const uint32_t> key_ids) {
+  absl::MutexLock lock(&keyset_mutex_);
+  std::vector<Keyset::Key*> keys;
+  keys.reserve(key_ids.size());
+  for (uint32_t key_id : key_ids) {
+    Keyset::Key* key = FindKey(key_id);
+    Status status = CheckCanDestroy(*keyset_, key, key_id);
+    if (!status.ok()) return status;
+    keys.push_back(key);
+  }
+  for (Keyset::Key* key : keys) {
+    DestroyKey(key);
+  }
+  return util::OkStatus();
+}
+
+Status KeysetManager::DeleteKeys(absl::Span<const uint32_t> key_ids) {
   absl::MutexLock lock(&keyset_mutex_);
-  for (auto& key : keyset_->key()) {
-    if (key.key_id() == key_id) {
-      if (key.status() != KeyStatusType::ENABLED) {
-        return ToStatusF(absl::StatusCode::kInvalidArgument,
-                         "The candidate for the primary key must be ENABLED"
-                         " (key_id %u).",
-                         key_id);
-      }
-      keyset_->set_primary_key_id(key_id);
-      return util::OkStatus();
+  absl::flat_hash_set<uint32_t> to_delete;
+  to_delete.reserve(key_ids.size());
+  for (uint32_t key_id : key_ids) {
+    Status status = CheckCanDelete(*keyset_, FindKey(key_id), key_id);
+    if (!status.ok()) return status;
+    to_delete.insert(key_id);
+  }
+  key_index_.EraseKeys(to_delete, keyset_.get());
+  return util::OkStatus();
+}
+
+std::vector<uint32_t> KeysetManager::GetKeyIds(
+    absl::FunctionRef<bool(const KeysetInfo::KeyInfo&)> predicate) const {
+  absl::MutexLock lock(&keyset_mutex_);
+  std::vector<uint32_t> key_ids;
+  for (const Keyset::Key& key : keyset_->key()) {
+    if (predicate(KeyInfoFromKey(key))) {
+      key_ids.push_back(key.key_id());
     }
   }
-  return ToStatusF(absl::StatusCode::kNotFound,
-                   "No key with key_id %u found in the keyset.", key_id);
+  return key_ids;
 }
 
 int KeysetManager::KeyCount() const {
@@ -15,9 +15,15 @@
 ////////////////////////////////////////////////////////////////////////////////
 #include "tink/keyset_manager.h"
 
+#include <cstdint>
+#include <memory>
 #include <utility>
+#include <vector>
 
+#include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
 #include "tink/aead/aead_config.h"
 #include "tink/aead/aes_gcm_key_manager.h"
 #include "tink/keyset_handle.h"
@@ -27,9 +33,13 @@
 
 using google::crypto::tink::AesGcmKeyFormat;
 using google::crypto::tink::KeyData;
+using google::crypto::tink::Keyset;
+using google::crypto::tink::KeysetInfo;
 using google::crypto::tink::KeyStatusType;
 using google::crypto::tink::KeyTemplate;
 using google::crypto::tink::OutputPrefixType;
+using ::testing::ElementsAreArray;
+using ::testing::IsEmpty;
 
 namespace crypto {
 namespace tink {
@@ -229,5 +239,133 @@ TEST_F(KeysetManagerTest, testBasicOperations) {
   EXPECT_EQ(1, keyset_manager->KeyCount());
 }
 
+KeyTemplate AesGcmTemplate() {
+  AesGcmKeyFormat key_format;
+  key_format.set_key_size(16);
+  KeyTemplate key_template;
+  key_template.set_type_url(AesGcmKeyManager().get_key_type());
+  key_template.set_output_prefix_type(OutputPrefixType::TINK);
+  key_template.set_value(key_format.SerializeAsString());
+  return key_template;
+}
+
+// Returns a manager with `num_keys` keys, the last of which is the primary,
+// and stores the key IDs in creation order in `key_ids`.
+std::unique_ptr<KeysetManager> NewManagerWithKeys(
+    int num_keys, std::vector<uint32_t>* key_ids) {
+  auto keyset_manager = absl::make_unique<KeysetManager>();
+  for (int i = 0; i < num_keys; ++i) {
+    auto key_id = keyset_manager->Rotate(AesGcmTemplate());
+    EXPECT_TRUE(key_id.ok()) << key_id.status();
+    key_ids->push_back(key_id.value());
+  }
+  return keyset_manager;
+}
+
+TEST_F(KeysetManagerTest, BatchOperations) {
+  std::vector<uint32_t> key_ids;
+  auto keyset_manager = NewManagerWithKeys(5, &key_ids);
+  std::vector<uint32_t> non_primary(key_ids.begin(), key_ids.end() - 1);
+
+  EXPECT_TRUE(keyset_manager->DisableKeys(non_primary).ok());
+  Keyset keyset =
+      TestKeysetHandle::GetKeyset(*(keyset_manager->GetKeysetHandle()));
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(KeyStatusType::DISABLED, keyset.key(i).status());
+  }
+  EXPECT_EQ(KeyStatusType::ENABLED, keyset.key(4).status());
+
+  EXPECT_TRUE(keyset_manager->EnableKeys({key_ids[0], key_ids[1]}).ok());
+  EXPECT_TRUE(keyset_manager->DestroyKeys({key_ids[2]}).ok());
+  keyset = TestKeysetHandle::GetKeyset(*(keyset_manager->GetKeysetHandle()));
+  EXPECT_EQ(KeyStatusType::ENABLED, keyset.key(0).status());
+  EXPECT_EQ(KeyStatusType::ENABLED, keyset.key(1).status());
+  EXPECT_EQ(KeyStatusType::DESTROYED, keyset.key(2).status());
+  EXPECT_FALSE(keyset.key(2).has_key_data());
+  EXPECT_EQ(KeyStatusType::DISABLED, keyset.key(3).status());
+
+  EXPECT_TRUE(keyset_manager->DeleteKeys({key_ids[1], key_ids[2]}).ok());
+  EXPECT_EQ(3, keyset_manager->KeyCount());
+  EXPECT_THAT(keyset_manager->GetKeyIds(
+                  [](const KeysetInfo::KeyInfo&) { return true; }),
+              ElementsAreArray({key_ids[0], key_ids[3], key_ids[4]}));
+
+  // Single-key operations still find keys after a batch deletion.
+  EXPECT_TRUE(keyset_manager->Disable(key_ids[0]).ok());
+  EXPECT_EQ(absl::StatusCode::kInvalidArgument,
+            keyset_manager->SetPrimary(key_ids[0]).code());
+  EXPECT_TRUE(keyset_manager->Delete(key_ids[3]).ok());
+  EXPECT_TRUE(keyset_manager->Enable(key_ids[0]).ok());
+  EXPECT_TRUE(keyset_manager->SetPrimary(key_ids[0]).ok());
+}
+
+TEST_F(KeysetManagerTest, BatchOperationsAreAllOrNothing) {
+  std::vector<uint32_t> key_ids;
+  auto keyset_manager = NewManagerWithKeys(3, &key_ids);
+  Keyset before =
+      TestKeysetHandle::GetKeyset(*(keyset_manager->GetKeysetHandle()));
+
+  // The last key is the primary.
+  auto status = keyset_manager->DisableKeys(key_ids);
+  EXPECT_EQ(absl::StatusCode::kInvalidArgument, status.code());
+  status = keyset_manager->DestroyKeys(key_ids);
+  EXPECT_EQ(absl::StatusCode::kInvalidArgument, status.code());
+  status = keyset_manager->DeleteKeys(key_ids);
+  EXPECT_EQ(absl::StatusCode::kInvalidArgument, status.code());
+  status = keyset_manager->DeleteKeys({key_ids[0], 0});
+  EXPECT_EQ(absl::StatusCode::kNotFound, status.code());
+
+  ASSERT_TRUE(keyset_manager->DestroyKeys({key_ids[0]}).ok());
+  status = keyset_manager->EnableKeys({key_ids[1], key_ids[0]});
+  EXPECT_EQ(absl::StatusCode::kInvalidArgument, status.code());
+
+  Keyset after =
+      TestKeysetHandle::GetKeyset(*(keyset_manager->GetKeysetHandle()));
+  ASSERT_EQ(before.key_size(), after.key_size());
+  EXPECT_EQ(KeyStatusType::DESTROYED, after.key(0).status());
+  for (int i = 1; i < after.key_size(); ++i) {
+    EXPECT_EQ(before.key(i).SerializeAsString(),
+              after.key(i).SerializeAsString());
+  }
+}
+
+TEST_F(KeysetManagerTest, GetKeyIdsSelectsOlderKeys) {
+  std::vector<uint32_t> key_ids;
+  auto keyset_manager = NewManagerWithKeys(4, &key_ids);
+  ASSERT_TRUE(keyset_manager->Disable(key_ids[1]).ok());
+
+  EXPECT_THAT(keyset_manager->GetKeyIds([](const KeysetInfo::KeyInfo& info) {
+    return info.status() == KeyStatusType::DISABLED;
+  }),
+              ElementsAreArray({key_ids[1]}));
+  EXPECT_THAT(keyset_manager->GetKeyIds(
+                  [](const KeysetInfo::KeyInfo&) { return false; }),
+              IsEmpty());
+
+  // Disable every key older than key_ids[2].
+  bool older = true;
+  std::vector<uint32_t> older_keys =
+      keyset_manager->GetKeyIds([&](const KeysetInfo::KeyInfo& info) {
+        if (info.key_id() == key_ids[2]) older = false;
+        return older;
+      });
+  EXPECT_THAT(older_keys, ElementsAreArray({key_ids[0], key_ids[1]}));
+  EXPECT_TRUE(keyset_manager->DisableKeys(older_keys).ok());
+}
+
+TEST_F(KeysetManagerTest, IndexIsRebuiltFromKeysetHandle) {
+  std::vector<uint32_t> key_ids;
+  auto keyset_manager = NewManagerWithKeys(3, &key_ids);
+  auto copy = KeysetManager::New(*keyset_manager->GetKeysetHandle());
+  ASSERT_TRUE(copy.ok()) << copy.status();
+  EXPECT_TRUE((*copy)->DisableKeys({key_ids[0], key_ids[1]}).ok());
+  EXPECT_TRUE((*copy)->SetPrimary(key_ids[2]).ok());
+  auto added = (*copy)->Add(AesGcmTemplate());
+  ASSERT_TRUE(added.ok()) << added.status();
+  EXPECT_TRUE((*copy)->SetPrimary(*added).ok());
+  EXPECT_TRUE((*copy)->DeleteKeys({key_ids[0], key_ids[1], key_ids[2]}).ok());
+  EXPECT_EQ(1, (*copy)->KeyCount());
+}
+
 }  // namespace tink
 }  // namespace crypto
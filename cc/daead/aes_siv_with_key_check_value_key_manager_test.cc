@@ -0,0 +1,154 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/daead/aes_siv_with_key_check_value_key_manager.h"
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "tink/deterministic_aead.h"
+#include "tink/internal/key_check_value.h"
+#include "tink/subtle/aes_siv_boringssl.h"
+#include "tink/util/istream_input_stream.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "proto/aes_siv_with_key_check_value.pb.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::IsOkAndHolds;
+using ::crypto::tink::test::StatusIs;
+using ::google::crypto::tink::AesSivWithKeyCheckValueKey;
+using ::google::crypto::tink::AesSivWithKeyCheckValueKeyFormat;
+using ::testing::Eq;
+using ::testing::HasSubstr;
+
+TEST(AesSivWithKeyCheckValueKeyManagerTest, Basics) {
+  EXPECT_THAT(AesSivWithKeyCheckValueKeyManager().get_version(), Eq(0));
+  EXPECT_THAT(
+      AesSivWithKeyCheckValueKeyManager().get_key_type(),
+      Eq("type.googleapis.com/google.crypto.tink.AesSivWithKeyCheckValueKey"));
+  EXPECT_THAT(AesSivWithKeyCheckValueKeyManager().key_material_type(),
+              Eq(google::crypto::tink::KeyData::SYMMETRIC));
+}
+
+TEST(AesSivWithKeyCheckValueKeyManagerTest, ValidateKeyFormat) {
+  AesSivWithKeyCheckValueKeyFormat format;
+  format.set_key_size(64);
+  for (int key_check_value_size : {4, 8, 16}) {
+    format.set_key_check_value_size(key_check_value_size);
+    EXPECT_THAT(AesSivWithKeyCheckValueKeyManager().ValidateKeyFormat(format),
+                IsOk());
+  }
+  for (int key_check_value_size : {0, 1, 3, 17}) {
+    format.set_key_check_value_size(key_check_value_size);
+    EXPECT_THAT(AesSivWithKeyCheckValueKeyManager().ValidateKeyFormat(format),
+                StatusIs(absl::StatusCode::kInvalidArgument));
+  }
+  format.set_key_check_value_size(8);
+  format.set_key_size(32);
+  EXPECT_THAT(AesSivWithKeyCheckValueKeyManager().ValidateKeyFormat(format),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(AesSivWithKeyCheckValueKeyManagerTest, ValidateKey) {
+  AesSivWithKeyCheckValueKey key;
+  key.set_version(0);
+  key.set_key_value(std::string(64, 'a'));
+  key.set_key_check_value_size(8);
+  EXPECT_THAT(AesSivWithKeyCheckValueKeyManager().ValidateKey(key), IsOk());
+  key.set_key_check_value_size(0);
+  EXPECT_THAT(AesSivWithKeyCheckValueKeyManager().ValidateKey(key),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  key.set_key_check_value_size(8);
+  key.set_version(1);
+  EXPECT_THAT(AesSivWithKeyCheckValueKeyManager().ValidateKey(key),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(AesSivWithKeyCheckValueKeyManagerTest, DeriveKey) {
+  util::IstreamInputStream input_stream{absl::make_unique<std::stringstream>(
+      "0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef")};
+  AesSivWithKeyCheckValueKeyFormat format;
+  format.set_key_size(64);
+  format.set_key_check_value_size(8);
+  util::StatusOr<AesSivWithKeyCheckValueKey> key =
+      AesSivWithKeyCheckValueKeyManager().DeriveKey(format, &input_stream);
+  ASSERT_THAT(key, IsOk());
+  EXPECT_THAT(
+      key->key_value(),
+      Eq("0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef"));
+  EXPECT_THAT(key->key_check_value_size(), Eq(8));
+}
+
+TEST(AesSivWithKeyCheckValueKeyManagerTest, GetPrimitive) {
+  AesSivWithKeyCheckValueKeyFormat format;
+  format.set_key_size(64);
+  format.set_key_check_value_size(8);
+  util::StatusOr<AesSivWithKeyCheckValueKey> key =
+      AesSivWithKeyCheckValueKeyManager().CreateKey(format);
+  ASSERT_THAT(key, IsOk());
+  EXPECT_THAT(key->key_check_value_size(), Eq(8));
+  util::StatusOr<std::unique_ptr<DeterministicAead>> daead =
+      AesSivWithKeyCheckValueKeyManager().GetPrimitive<DeterministicAead>(
+          *key);
+  ASSERT_THAT(daead, IsOk());
+
+  // The ciphertext is the key check value followed by an AES-SIV ciphertext.
+  util::SecretData key_value = util::SecretDataFromStringView(key->key_value());
+  util::StatusOr<std::string> key_check_value =
+      internal::ComputeKeyCheckValue(key_value, 8);
+  ASSERT_THAT(key_check_value, IsOk());
+  util::StatusOr<std::unique_ptr<DeterministicAead>> direct_daead =
+      subtle::AesSivBoringSsl::New(key_value);
+  ASSERT_THAT(direct_daead, IsOk());
+  util::StatusOr<std::string> direct_ciphertext =
+      (*direct_daead)->EncryptDeterministically("123", "abcd");
+  ASSERT_THAT(direct_ciphertext, IsOk());
+  util::StatusOr<std::string> ciphertext =
+      (*daead)->EncryptDeterministically("123", "abcd");
+  ASSERT_THAT(ciphertext, IsOk());
+  EXPECT_THAT(*ciphertext, Eq(*key_check_value + *direct_ciphertext));
+  EXPECT_THAT((*daead)->DecryptDeterministically(*ciphertext, "abcd"),
+              IsOkAndHolds("123"));
+
+  // A different key is rejected by its key check value.
+  util::StatusOr<AesSivWithKeyCheckValueKey> other_key =
+      AesSivWithKeyCheckValueKeyManager().CreateKey(format);
+  ASSERT_THAT(other_key, IsOk());
+  util::StatusOr<std::unique_ptr<DeterministicAead>> other_daead =
+      AesSivWithKeyCheckValueKeyManager().GetPrimitive<DeterministicAead>(
+          *other_key);
+  ASSERT_THAT(other_daead, IsOk());
+  EXPECT_THAT(
+      (*other_daead)->DecryptDeterministically(*ciphertext, "abcd").status(),
+      StatusIs(absl::StatusCode::kInvalidArgument,
+               HasSubstr("Key check value mismatch")));
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
@@ -20,6 +20,7 @@
 #include "tink/config/tink_fips.h"
 #include "tink/daead/aes_siv_key_manager.h"
 #include "tink/daead/aes_siv_proto_serialization.h"
+#include "tink/daead/aes_siv_with_key_check_value_key_manager.h"
 #include "tink/daead/deterministic_aead_wrapper.h"
 #include "tink/registry.h"
 #include "tink/util/status.h"
@@ -43,6 +44,10 @@ util::Status DeterministicAeadConfig::Register() {
   status = RegisterAesSivProtoSerialization();
   if (!status.ok()) return status;
 
+  status = Registry::RegisterKeyTypeManager(
+      absl::make_unique<AesSivWithKeyCheckValueKeyManager>(), true);
+  if (!status.ok()) return status;
+
   // Register primitive wrapper.
   return Registry::RegisterPrimitiveWrapper(
       absl::make_unique<DeterministicAeadWrapper>());
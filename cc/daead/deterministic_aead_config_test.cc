@@ -27,6 +27,7 @@
 #include "tink/daead/aes_siv_key.h"
 #include "tink/daead/aes_siv_key_manager.h"
 #include "tink/daead/aes_siv_parameters.h"
+#include "tink/daead/aes_siv_with_key_check_value_key_manager.h"
 #include "tink/daead/deterministic_aead_key_templates.h"
 #include "tink/deterministic_aead.h"
 #include "tink/insecure_secret_key_access.h"
@@ -73,6 +74,10 @@ TEST_F(DeterministicAeadConfigTest, Basic) {
                   AesSivKeyManager().get_key_type())
                   .status(),
               IsOk());
+  EXPECT_THAT(Registry::get_key_manager<DeterministicAead>(
+                  AesSivWithKeyCheckValueKeyManager().get_key_type())
+                  .status(),
+              IsOk());
 }
 
 // Tests that the DeterministicAeadWrapper has been properly registered and we
@@ -125,6 +130,8 @@ TEST_F(DeterministicAeadConfigTest, RegisterFipsValidTemplates) {
   // Check that we can not retrieve non-FIPS key handle
   std::list<google::crypto::tink::KeyTemplate> non_fips_key_templates;
   non_fips_key_templates.push_back(DeterministicAeadKeyTemplates::Aes256Siv());
+  non_fips_key_templates.push_back(
+      DeterministicAeadKeyTemplates::Aes256SivNoPrefixWithKeyCheckValue());
 
   for (auto key_template : non_fips_key_templates) {
     auto new_keyset_handle_result =
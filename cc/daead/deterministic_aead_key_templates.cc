@@ -17,10 +17,12 @@
 #include "tink/daead/deterministic_aead_key_templates.h"
 
 #include "proto/aes_siv.pb.h"
+#include "proto/aes_siv_with_key_check_value.pb.h"
 #include "proto/common.pb.h"
 #include "proto/tink.pb.h"
 
 using google::crypto::tink::AesSivKeyFormat;
+using google::crypto::tink::AesSivWithKeyCheckValueKeyFormat;
 using google::crypto::tink::KeyTemplate;
 using google::crypto::tink::OutputPrefixType;
 
@@ -40,6 +42,19 @@ KeyTemplate* NewAesSivKeyTemplate(int key_size_in_bytes) {
   return key_template;
 }
 
+KeyTemplate* NewAesSivWithKeyCheckValueKeyTemplate(
+    int key_size_in_bytes, int key_check_value_size_in_bytes) {
+  KeyTemplate* key_template = new KeyTemplate;
+  key_template->set_type_url(
+      "type.googleapis.com/google.crypto.tink.AesSivWithKeyCheckValueKey");
+  key_template->set_output_prefix_type(OutputPrefixType::RAW);
+  AesSivWithKeyCheckValueKeyFormat key_format;
+  key_format.set_key_size(key_size_in_bytes);
+  key_format.set_key_check_value_size(key_check_value_size_in_bytes);
+  key_format.SerializeToString(key_template->mutable_value());
+  return key_template;
+}
+
 }  // anonymous namespace
 
 // static
@@ -49,5 +64,15 @@ const KeyTemplate& DeterministicAeadKeyTemplates::Aes256Siv() {
   return *key_template;
 }
 
+// static
+const KeyTemplate&
+DeterministicAeadKeyTemplates::Aes256SivNoPrefixWithKeyCheckValue() {
+  static const KeyTemplate* key_template =
+      NewAesSivWithKeyCheckValueKeyTemplate(
+          /* key_size_in_bytes= */ 64,
+          /* key_check_value_size_in_bytes= */ 8);
+  return *key_template;
+}
+
 }  // namespace tink
 }  // namespace crypto
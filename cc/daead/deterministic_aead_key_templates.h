@@ -40,6 +40,16 @@ class DeterministicAeadKeyTemplates {
   //   - key size: 64 bytes
   //   - OutputPrefixType: TINK
   static const google::crypto::tink::KeyTemplate& Aes256Siv();
+
+  // Returns a KeyTemplate that generates new instances of
+  // AesSivWithKeyCheckValueKey with the following parameters:
+  //   - key size: 64 bytes
+  //   - key check value size: 8 bytes
+  //   - OutputPrefixType: RAW
+  // The key check value lets keysets with many RAW keys reject ciphertexts of
+  // other keys without attempting a full decryption with each of them.
+  static const google::crypto::tink::KeyTemplate&
+  Aes256SivNoPrefixWithKeyCheckValue();
 };
 
 }  // namespace tink
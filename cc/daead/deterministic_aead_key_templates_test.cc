@@ -21,11 +21,14 @@
 #include "gtest/gtest.h"
 #include "tink/core/key_manager_impl.h"
 #include "tink/daead/aes_siv_key_manager.h"
+#include "tink/daead/aes_siv_with_key_check_value_key_manager.h"
 #include "proto/aes_siv.pb.h"
+#include "proto/aes_siv_with_key_check_value.pb.h"
 #include "proto/common.pb.h"
 #include "proto/tink.pb.h"
 
 using google::crypto::tink::AesSivKeyFormat;
+using google::crypto::tink::AesSivWithKeyCheckValueKeyFormat;
 using google::crypto::tink::KeyTemplate;
 using google::crypto::tink::OutputPrefixType;
 
@@ -62,6 +65,34 @@ TEST(DeterministicAeadKeyTemplatesTest, testAesSivKeyTemplates) {
   }
 }
 
+TEST(DeterministicAeadKeyTemplatesTest,
+     testAesSivWithKeyCheckValueKeyTemplates) {
+  // Check that returned template is correct.
+  const KeyTemplate& key_template =
+      DeterministicAeadKeyTemplates::Aes256SivNoPrefixWithKeyCheckValue();
+  EXPECT_EQ("type.googleapis.com/google.crypto.tink.AesSivWithKeyCheckValueKey",
+            key_template.type_url());
+  EXPECT_EQ(OutputPrefixType::RAW, key_template.output_prefix_type());
+  AesSivWithKeyCheckValueKeyFormat key_format;
+  EXPECT_TRUE(key_format.ParseFromString(key_template.value()));
+  EXPECT_EQ(64, key_format.key_size());
+  EXPECT_EQ(8, key_format.key_check_value_size());
+
+  // Check that reference to the same object is returned.
+  const KeyTemplate& key_template_2 =
+      DeterministicAeadKeyTemplates::Aes256SivNoPrefixWithKeyCheckValue();
+  EXPECT_EQ(&key_template, &key_template_2);
+
+  // Check that the template works with the key manager.
+  AesSivWithKeyCheckValueKeyManager key_type_manager;
+  auto key_manager =
+      internal::MakeKeyManager<DeterministicAead>(&key_type_manager);
+  EXPECT_EQ(key_manager->get_key_type(), key_template.type_url());
+  auto new_key_result =
+      key_manager->get_key_factory().NewKey(key_template.value());
+  EXPECT_TRUE(new_key_result.ok()) << new_key_result.status();
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
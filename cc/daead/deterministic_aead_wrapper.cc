@@ -16,11 +16,14 @@
 
 #include "tink/daead/deterministic_aead_wrapper.h"
 
+#include <cstring>
 #include <memory>
 #include <string>
 #include <utility>
 
 #include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "tink/crypto_format.h"
 #include "tink/deterministic_aead.h"
 #include "tink/internal/monitoring_util.h"
@@ -28,6 +31,7 @@
 #include "tink/internal/util.h"
 #include "tink/monitoring/monitoring.h"
 #include "tink/primitive_set.h"
+#include "tink/util/request_arena.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
 
@@ -71,6 +75,16 @@ class  DeterministicAeadSetWrapper : public DeterministicAead {
       absl::string_view ciphertext,
       absl::string_view associated_data) const override;
 
+  crypto::tink::util::StatusOr<absl::string_view>
+  EncryptDeterministicallyWithArena(
+      absl::string_view plaintext, absl::string_view associated_data,
+      util::RequestArena* arena) const override;
+
+  crypto::tink::util::StatusOr<absl::string_view>
+  DecryptDeterministicallyWithArena(
+      absl::string_view ciphertext, absl::string_view associated_data,
+      util::RequestArena* arena) const override;
+
   ~DeterministicAeadSetWrapper() override = default;
 
  private:
@@ -157,6 +171,90 @@ DeterministicAeadSetWrapper::DecryptDeterministically(
   return util::Status(absl::StatusCode::kInvalidArgument, "decryption failed");
 }
 
+util::StatusOr<absl::string_view>
+DeterministicAeadSetWrapper::EncryptDeterministicallyWithArena(
+    absl::string_view plaintext, absl::string_view associated_data,
+    util::RequestArena* arena) const {
+  plaintext = internal::EnsureStringNonNull(plaintext);
+  associated_data = internal::EnsureStringNonNull(associated_data);
+
+  util::StatusOr<absl::string_view> ciphertext =
+      daead_set_->get_primary()
+          ->get_primitive()
+          .EncryptDeterministicallyWithArena(plaintext, associated_data, arena);
+  if (!ciphertext.ok()) {
+    if (monitoring_encryption_client_ != nullptr) {
+      monitoring_encryption_client_->LogFailure();
+    }
+    return ciphertext.status();
+  }
+  if (monitoring_encryption_client_ != nullptr) {
+    monitoring_encryption_client_->Log(daead_set_->get_primary()->get_key_id(),
+                                       plaintext.size());
+  }
+  const std::string& key_id = daead_set_->get_primary()->get_identifier();
+  if (key_id.empty()) {
+    return ciphertext;
+  }
+  absl::Span<char> output = arena->Allocate(key_id.size() + ciphertext->size());
+  std::memcpy(output.data(), key_id.data(), key_id.size());
+  std::memcpy(output.data() + key_id.size(), ciphertext->data(),
+              ciphertext->size());
+  return absl::string_view(output.data(), output.size());
+}
+
+util::StatusOr<absl::string_view>
+DeterministicAeadSetWrapper::DecryptDeterministicallyWithArena(
+    absl::string_view ciphertext, absl::string_view associated_data,
+    util::RequestArena* arena) const {
+  associated_data = internal::EnsureStringNonNull(associated_data);
+
+  if (ciphertext.length() > CryptoFormat::kNonRawPrefixSize) {
+    absl::string_view key_id =
+        ciphertext.substr(0, CryptoFormat::kNonRawPrefixSize);
+    auto primitives_result = daead_set_->get_primitives(key_id);
+    if (primitives_result.ok()) {
+      absl::string_view raw_ciphertext =
+          ciphertext.substr(CryptoFormat::kNonRawPrefixSize);
+      for (const auto& daead_entry : *(primitives_result.value())) {
+        DeterministicAead& daead = daead_entry->get_primitive();
+        util::StatusOr<absl::string_view> plaintext =
+            daead.DecryptDeterministicallyWithArena(raw_ciphertext,
+                                                    associated_data, arena);
+        if (plaintext.ok()) {
+          if (monitoring_decryption_client_ != nullptr) {
+            monitoring_decryption_client_->Log(daead_entry->get_key_id(),
+                                               raw_ciphertext.size());
+          }
+          return plaintext;
+        }
+      }
+    }
+  }
+
+  // No matching key succeeded with decryption, try all RAW keys.
+  auto raw_primitives_result = daead_set_->get_raw_primitives();
+  if (raw_primitives_result.ok()) {
+    for (const auto& daead_entry : *(raw_primitives_result.value())) {
+      DeterministicAead& daead = daead_entry->get_primitive();
+      util::StatusOr<absl::string_view> plaintext =
+          daead.DecryptDeterministicallyWithArena(ciphertext, associated_data,
+                                                  arena);
+      if (plaintext.ok()) {
+        if (monitoring_decryption_client_ != nullptr) {
+          monitoring_decryption_client_->Log(daead_entry->get_key_id(),
+                                             ciphertext.size());
+        }
+        return plaintext;
+      }
+    }
+  }
+  if (monitoring_decryption_client_ != nullptr) {
+    monitoring_decryption_client_->LogFailure();
+  }
+  return util::Status(absl::StatusCode::kInvalidArgument, "decryption failed");
+}
+
 }  // anonymous namespace
 
 util::StatusOr<std::unique_ptr<DeterministicAead>>
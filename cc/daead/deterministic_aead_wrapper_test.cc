@@ -29,6 +29,7 @@
 #include "tink/monitoring/monitoring.h"
 #include "tink/monitoring/monitoring_client_mocks.h"
 #include "tink/primitive_set.h"
+#include "tink/util/request_arena.h"
 #include "tink/util/status.h"
 #include "tink/util/test_matchers.h"
 #include "tink/util/test_util.h"
@@ -155,6 +156,39 @@ TEST_F(DeterministicAeadSetWrapperTest, testBasic) {
   }
 }
 
+TEST_F(DeterministicAeadSetWrapperTest, EncryptDecryptWithArena) {
+  KeysetInfo::KeyInfo key_info;
+  key_info.set_output_prefix_type(OutputPrefixType::TINK);
+  key_info.set_key_id(1234543);
+  key_info.set_status(KeyStatusType::ENABLED);
+  auto daead_set = absl::make_unique<PrimitiveSet<DeterministicAead>>();
+  auto entry = daead_set->AddPrimitive(
+      absl::make_unique<DummyDeterministicAead>("daead"), key_info);
+  ASSERT_THAT(entry, IsOk());
+  ASSERT_THAT(daead_set->set_primary(*entry), IsOk());
+  util::StatusOr<std::unique_ptr<DeterministicAead>> daead =
+      DeterministicAeadWrapper().Wrap(std::move(daead_set));
+  ASSERT_THAT(daead, IsOk());
+
+  std::string plaintext = "some_plaintext";
+  std::string associated_data = "some_associated_data";
+  util::RequestArena arena;
+  util::StatusOr<absl::string_view> ciphertext =
+      (*daead)->EncryptDeterministicallyWithArena(plaintext, associated_data,
+                                                  &arena);
+  ASSERT_THAT(ciphertext, IsOk());
+  EXPECT_THAT((*daead)->EncryptDeterministically(plaintext, associated_data),
+              IsOkAndHolds(std::string(*ciphertext)));
+  EXPECT_THAT((*daead)->DecryptDeterministicallyWithArena(
+                  *ciphertext, associated_data, &arena),
+              IsOkAndHolds(plaintext));
+  EXPECT_THAT((*daead)
+                  ->DecryptDeterministicallyWithArena("some bad ciphertext",
+                                                      associated_data, &arena)
+                  .status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
 KeysetInfo::KeyInfo PopulateKeyInfo(uint32_t key_id,
                                     OutputPrefixType out_prefix_type,
                                     KeyStatusType status) {
@@ -0,0 +1,64 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_DAEAD_INTERNAL_KEY_CHECK_DETERMINISTIC_AEAD_H_
+#define TINK_DAEAD_INTERNAL_KEY_CHECK_DETERMINISTIC_AEAD_H_
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+#include "tink/deterministic_aead.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+
+// DeterministicAead that prepends the key check value of its key (see
+// tink/internal/key_check_value.h) to every ciphertext, and rejects
+// ciphertexts with a different key check value before decrypting them with
+// the wrapped DeterministicAead.
+class KeyCheckDeterministicAead : public DeterministicAead {
+ public:
+  // Wraps `daead`, whose key has the non-empty `key_check_value`.
+  static util::StatusOr<std::unique_ptr<DeterministicAead>> New(
+      std::unique_ptr<DeterministicAead> daead, std::string key_check_value);
+
+  util::StatusOr<std::string> EncryptDeterministically(
+      absl::string_view plaintext,
+      absl::string_view associated_data) const override;
+
+  util::StatusOr<std::string> DecryptDeterministically(
+      absl::string_view ciphertext,
+      absl::string_view associated_data) const override;
+
+ private:
+  KeyCheckDeterministicAead(std::unique_ptr<DeterministicAead> daead,
+                            std::string key_check_value)
+      : daead_(std::move(daead)),
+        key_check_value_(std::move(key_check_value)) {}
+
+  const std::unique_ptr<DeterministicAead> daead_;
+  const std::string key_check_value_;
+};
+
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_DAEAD_INTERNAL_KEY_CHECK_DETERMINISTIC_AEAD_H_
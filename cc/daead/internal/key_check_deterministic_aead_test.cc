@@ -0,0 +1,102 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/daead/internal/key_check_deterministic_aead.h"
+
+#include <memory>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "tink/deterministic_aead.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "tink/util/test_util.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+namespace {
+
+using ::crypto::tink::test::DummyDeterministicAead;
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::IsOkAndHolds;
+using ::crypto::tink::test::StatusIs;
+using ::testing::HasSubstr;
+using ::testing::StartsWith;
+
+constexpr absl::string_view kPlaintext = "Some data to encrypt.";
+constexpr absl::string_view kAssociatedData = "Some associated data.";
+constexpr absl::string_view kKeyCheckValue = "\x01\x02\x03\x04";
+
+TEST(KeyCheckDeterministicAeadTest, EncryptDecrypt) {
+  util::StatusOr<std::unique_ptr<DeterministicAead>> daead =
+      KeyCheckDeterministicAead::New(
+          absl::make_unique<DummyDeterministicAead>("daead"),
+          std::string(kKeyCheckValue));
+  ASSERT_THAT(daead, IsOk());
+
+  util::StatusOr<std::string> ciphertext =
+      (*daead)->EncryptDeterministically(kPlaintext, kAssociatedData);
+  ASSERT_THAT(ciphertext, IsOk());
+  EXPECT_THAT(*ciphertext, StartsWith(std::string(kKeyCheckValue)));
+  EXPECT_THAT((*daead)->DecryptDeterministically(*ciphertext, kAssociatedData),
+              IsOkAndHolds(kPlaintext));
+}
+
+TEST(KeyCheckDeterministicAeadTest, DecryptRejectsMismatchingKeyCheckValue) {
+  util::StatusOr<std::unique_ptr<DeterministicAead>> daead =
+      KeyCheckDeterministicAead::New(
+          absl::make_unique<DummyDeterministicAead>("daead"),
+          std::string(kKeyCheckValue));
+  ASSERT_THAT(daead, IsOk());
+
+  util::StatusOr<std::string> ciphertext =
+      DummyDeterministicAead("daead").EncryptDeterministically(
+          kPlaintext, kAssociatedData);
+  ASSERT_THAT(ciphertext, IsOk());
+  EXPECT_THAT(
+      (*daead)
+          ->DecryptDeterministically(absl::StrCat("\x01\x02\x03\x05",
+                                                  *ciphertext),
+                                     kAssociatedData)
+          .status(),
+      StatusIs(absl::StatusCode::kInvalidArgument,
+               HasSubstr("Key check value mismatch")));
+  EXPECT_THAT(
+      (*daead)->DecryptDeterministically("\x01", kAssociatedData).status(),
+      StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(KeyCheckDeterministicAeadTest, NewFailsWithInvalidArguments) {
+  EXPECT_THAT(
+      KeyCheckDeterministicAead::New(nullptr, std::string(kKeyCheckValue))
+          .status(),
+      StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(KeyCheckDeterministicAead::New(
+                  absl::make_unique<DummyDeterministicAead>("daead"), "")
+                  .status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
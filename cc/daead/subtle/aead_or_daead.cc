@@ -21,6 +21,8 @@
 #include <utility>
 
 #include "absl/functional/bind_front.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
 
 namespace crypto {
 namespace tink {
@@ -41,6 +43,27 @@ struct EncryptFunctor {
   }
 };
 
+// Functor implementing Encryption of a given plaintext into a result that
+// starts with a given prefix.
+struct EncryptWithPrefixFunctor {
+  crypto::tink::util::StatusOr<std::string> operator()(
+      absl::string_view prefix, absl::string_view plaintext,
+      absl::string_view associated_data,
+      const std::unique_ptr<const Aead>& aead_primitive) {
+    return aead_primitive->EncryptWithPrefix(prefix, plaintext,
+                                             associated_data);
+  }
+  crypto::tink::util::StatusOr<std::string> operator()(
+      absl::string_view prefix, absl::string_view plaintext,
+      absl::string_view associated_data,
+      const std::unique_ptr<const DeterministicAead>& aead_primitive) {
+    crypto::tink::util::StatusOr<std::string> ciphertext =
+        aead_primitive->EncryptDeterministically(plaintext, associated_data);
+    if (!ciphertext.ok()) return ciphertext.status();
+    return absl::StrCat(prefix, *ciphertext);
+  }
+};
+
 // Functor implementing Decryption of a given ciphertext.
 struct DecryptFunctor {
   crypto::tink::util::StatusOr<std::string> operator()(
@@ -64,6 +87,14 @@ crypto::tink::util::StatusOr<std::string> AeadOrDaead::Encrypt(
       primitive_variant_);
 }
 
+crypto::tink::util::StatusOr<std::string> AeadOrDaead::EncryptWithPrefix(
+    absl::string_view prefix, absl::string_view plaintext,
+    absl::string_view associated_data) const {
+  return absl::visit(absl::bind_front(EncryptWithPrefixFunctor(), prefix,
+                                      plaintext, associated_data),
+                     primitive_variant_);
+}
+
 crypto::tink::util::StatusOr<std::string> AeadOrDaead::Decrypt(
     absl::string_view ciphertext, absl::string_view associated_data) const {
   return absl::visit(
@@ -46,6 +46,12 @@ class AeadOrDaead {
   crypto::tink::util::StatusOr<std::string> Encrypt(
       absl::string_view plaintext, absl::string_view associated_data) const;
 
+  // Returns 'prefix' followed by the result of Encrypt(). Aead primitives
+  // that support it write the ciphertext directly after the prefix.
+  crypto::tink::util::StatusOr<std::string> EncryptWithPrefix(
+      absl::string_view prefix, absl::string_view plaintext,
+      absl::string_view associated_data) const;
+
   // Decrypts 'ciphertext' using the underlying aead or determnistic aead
   // primitive, and returns the resulting plaintext.
   crypto::tink::util::StatusOr<std::string> Decrypt(
@@ -22,6 +22,7 @@
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include "absl/strings/str_cat.h"
 #include "tink/util/test_matchers.h"
 #include "tink/util/test_util.h"
 
@@ -68,6 +69,21 @@ TEST(AeadOrDaead, testWithDeterministicAeadPrimitive) {
               IsOk());
 }
 
+TEST(AeadOrDaead, EncryptWithPrefix) {
+  AeadOrDaead aead(absl::make_unique<test::DummyAead>("TestAead"));
+  AeadOrDaead daead(
+      absl::make_unique<test::DummyDeterministicAead>("TestDaead"));
+  for (const AeadOrDaead* aead_or_daead : {&aead, &daead}) {
+    StatusOr<std::string> ciphertext =
+        aead_or_daead->Encrypt("test_plaintext", "aad");
+    ASSERT_THAT(ciphertext, IsOk());
+    StatusOr<std::string> prefixed =
+        aead_or_daead->EncryptWithPrefix("prefix", "test_plaintext", "aad");
+    ASSERT_THAT(prefixed, IsOk());
+    EXPECT_EQ(*prefixed, absl::StrCat("prefix", *ciphertext));
+  }
+}
+
 }  // namespace
 }  // namespace subtle
 }  // namespace tink
@@ -20,6 +20,7 @@
 #include <string>
 
 #include "absl/strings/string_view.h"
+#include "tink/util/request_arena.h"
 #include "tink/util/statusor.h"
 
 namespace crypto {
@@ -53,6 +54,34 @@ class DeterministicAead {
       absl::string_view ciphertext,
       absl::string_view associated_data) const = 0;
 
+  // Like EncryptDeterministically(), but places the ciphertext in `arena`
+  // instead of a new std::string. The returned view is valid until `arena` is
+  // reset. The default implementation copies the result of
+  // EncryptDeterministically() into `arena`.
+  virtual crypto::tink::util::StatusOr<absl::string_view>
+  EncryptDeterministicallyWithArena(
+      absl::string_view plaintext, absl::string_view associated_data,
+      crypto::tink::util::RequestArena* arena) const {
+    crypto::tink::util::StatusOr<std::string> ciphertext =
+        EncryptDeterministically(plaintext, associated_data);
+    if (!ciphertext.ok()) return ciphertext.status();
+    return arena->Copy(*ciphertext);
+  }
+
+  // Like DecryptDeterministically(), but places the plaintext in `arena`
+  // instead of a new std::string. The returned view is valid until `arena` is
+  // reset. The default implementation copies the result of
+  // DecryptDeterministically() into `arena`.
+  virtual crypto::tink::util::StatusOr<absl::string_view>
+  DecryptDeterministicallyWithArena(
+      absl::string_view ciphertext, absl::string_view associated_data,
+      crypto::tink::util::RequestArena* arena) const {
+    crypto::tink::util::StatusOr<std::string> plaintext =
+        DecryptDeterministically(ciphertext, associated_data);
+    if (!plaintext.ok()) return plaintext.status();
+    return arena->Copy(*plaintext);
+  }
+
   virtual ~DeterministicAead() = default;
 };
 
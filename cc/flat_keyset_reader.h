@@ -0,0 +1,75 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_FLAT_KEYSET_READER_H_
+#define TINK_FLAT_KEYSET_READER_H_
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+#include "tink/internal/flat_keyset.h"
+#include "tink/keyset_reader.h"
+#include "tink/util/statusor.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+// A KeysetReader for cleartext keysets in the flat keyset format written by
+// FlatKeysetWriter. The reader validates the input once, and Read() converts
+// it into a Keyset proto.
+//
+// Use CleartextKeysetHandle::ReadFlat() to create a KeysetHandle directly
+// from a flat keyset.
+class FlatKeysetReader : public KeysetReader {
+ public:
+  // Creates a reader over `flat_keyset`, which is not copied and must outlive
+  // the reader.
+  static crypto::tink::util::StatusOr<std::unique_ptr<FlatKeysetReader>> New(
+      absl::string_view flat_keyset);
+
+  // Creates a reader over the contents of the file at `path`, which the reader
+  // reads and owns.
+  static crypto::tink::util::StatusOr<std::unique_ptr<FlatKeysetReader>>
+  NewFromFile(const std::string& path);
+
+  crypto::tink::util::StatusOr<std::unique_ptr<google::crypto::tink::Keyset>>
+  Read() override;
+
+  // Encrypted keysets are not supported by the flat format.
+  crypto::tink::util::StatusOr<
+    std::unique_ptr<google::crypto::tink::EncryptedKeyset>>
+  ReadEncrypted() override;
+
+  // Returns the underlying flat keyset.
+  absl::string_view flat_keyset() const { return view_.data(); }
+
+ private:
+  FlatKeysetReader(internal::FlatKeysetView view,
+                   std::unique_ptr<const std::string> contents)
+      : contents_(std::move(contents)), view_(view) {}
+
+  // File contents backing `view_`, or nullptr if not owned.
+  const std::unique_ptr<const std::string> contents_;
+  const internal::FlatKeysetView view_;
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_FLAT_KEYSET_READER_H_
@@ -22,7 +22,6 @@
 
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
-#include "absl/strings/str_cat.h"
 #include "tink/aead.h"
 #include "tink/util/enums.h"
 #include "tink/util/status.h"
@@ -77,8 +76,13 @@ util::StatusOr<std::unique_ptr<HybridEncrypt>> EciesAeadHkdfHybridEncrypt::New(
       recipient_key.params().dem_params().aead_dem());
   if (!dem_result.ok()) return dem_result.status();
 
+  KemParams kem_params = {
+      util::Enums::ProtoToSubtle(
+          recipient_key.params().kem_params().hkdf_hash_type()),
+      recipient_key.params().kem_params().hkdf_salt(),
+      util::Enums::ProtoToSubtle(recipient_key.params().ec_point_format())};
   return {absl::WrapUnique(new EciesAeadHkdfHybridEncrypt(
-      recipient_key, std::move(kem_result).value(),
+      std::move(kem_params), std::move(kem_result).value(),
       std::move(dem_result).value()))};
 }
 
@@ -86,13 +90,8 @@ util::StatusOr<std::string> EciesAeadHkdfHybridEncrypt::Encrypt(
     absl::string_view plaintext, absl::string_view context_info) const {
   // Use KEM to get a symmetric key.
   auto kem_key_result = sender_kem_->GenerateKey(
-      util::Enums::ProtoToSubtle(
-          recipient_key_.params().kem_params().hkdf_hash_type()),
-      recipient_key_.params().kem_params().hkdf_salt(),
-      context_info,
-      dem_helper_->dem_key_size_in_bytes(),
-      util::Enums::ProtoToSubtle(
-          recipient_key_.params().ec_point_format()));
+      kem_params_.hkdf_hash, kem_params_.hkdf_salt, context_info,
+      dem_helper_->dem_key_size_in_bytes(), kem_params_.point_format);
   if (!kem_key_result.ok()) return kem_key_result.status();
   auto kem_key = std::move(kem_key_result.value());
 
@@ -102,14 +101,10 @@ util::StatusOr<std::string> EciesAeadHkdfHybridEncrypt::Encrypt(
   if (!aead_or_daead_result.ok()) return aead_or_daead_result.status();
   auto aead_or_daead = std::move(aead_or_daead_result.value());
 
-  // Do the actual encryption using the AEAD-primitive.
-  auto encrypt_result = aead_or_daead->Encrypt(plaintext, "");  // empty aad
-  if (!encrypt_result.ok()) return encrypt_result.status();
-
-  // Prepend AEAD-ciphertext with a KEM component.
-  std::string ciphertext =
-      absl::StrCat(kem_key->get_kem_bytes(), encrypt_result.value());
-  return ciphertext;
+  // Do the actual encryption using the AEAD-primitive, writing the
+  // AEAD-ciphertext right after the KEM component.
+  return aead_or_daead->EncryptWithPrefix(kem_key->get_kem_bytes(), plaintext,
+                                          "");  // empty aad
 }
 
 }  // namespace tink
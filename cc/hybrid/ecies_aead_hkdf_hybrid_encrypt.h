@@ -23,6 +23,7 @@
 
 #include "tink/hybrid/ecies_aead_hkdf_dem_helper.h"
 #include "tink/hybrid_encrypt.h"
+#include "tink/subtle/common_enums.h"
 #include "tink/subtle/ecies_hkdf_sender_kem_boringssl.h"
 #include "tink/util/statusor.h"
 #include "proto/ecies_aead_hkdf.pb.h"
@@ -44,14 +45,23 @@ class EciesAeadHkdfHybridEncrypt : public HybridEncrypt {
       absl::string_view context_info) const override;
 
  private:
+  // Parameters of the recipient key that are used on every Encrypt() call,
+  // converted once from their proto representation.
+  struct KemParams {
+    subtle::HashType hkdf_hash;
+    std::string hkdf_salt;
+    subtle::EcPointFormat point_format;
+  };
+
   EciesAeadHkdfHybridEncrypt(
-      const google::crypto::tink::EciesAeadHkdfPublicKey& recipient_key,
+      KemParams kem_params,
       std::unique_ptr<const subtle::EciesHkdfSenderKemBoringSsl> sender_kem,
       std::unique_ptr<const EciesAeadHkdfDemHelper> dem_helper)
-      : recipient_key_(recipient_key), sender_kem_(std::move(sender_kem)),
+      : kem_params_(std::move(kem_params)),
+        sender_kem_(std::move(sender_kem)),
         dem_helper_(std::move(dem_helper)) {}
 
-  google::crypto::tink::EciesAeadHkdfPublicKey recipient_key_;
+  const KemParams kem_params_;
   std::unique_ptr<const subtle::EciesHkdfSenderKemBoringSsl> sender_kem_;
   std::unique_ptr<const EciesAeadHkdfDemHelper> dem_helper_;
 };
@@ -109,13 +109,13 @@ util::Status ValidateNistEcKeyPair(subtle::EllipticCurveType curve,
                                    absl::string_view public_key_bytes,
                                    const util::SecretData& private_key_bytes) {
   // Construct EC_KEY from public and private key bytes.
-  util::StatusOr<internal::SslUniquePtr<EC_GROUP>> group =
-      internal::EcGroupFromCurveType(curve);
+  util::StatusOr<const EC_GROUP*> group =
+      internal::CachedEcGroupFromCurveType(curve);
   if (!group.ok()) {
     return group.status();
   }
   internal::SslUniquePtr<EC_KEY> key(EC_KEY_new());
-  EC_KEY_set_group(key.get(), group->get());
+  EC_KEY_set_group(key.get(), *group);
 
   util::StatusOr<internal::SslUniquePtr<EC_POINT>> public_key =
       internal::EcPointDecode(curve, subtle::EcPointFormat::UNCOMPRESSED,
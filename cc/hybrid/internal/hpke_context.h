@@ -92,6 +92,14 @@ class HpkeContext {
     return context_->Seal(plaintext, associated_data);
   }
 
+  // Returns the HPKE payload EncapsulatedKey() || Seal(plaintext,
+  // associated_data), built in a single buffer.
+  crypto::tink::util::StatusOr<std::string> SealPayload(
+      absl::string_view plaintext, absl::string_view associated_data) {
+    return context_->SealWithPrefix(encapsulated_key_, plaintext,
+                                    associated_data);
+  }
+
   // Performs an AEAD decryption of `ciphertext` with `associated_data`. Returns
   // an error if decryption fails.  Otherwise, returns the plaintext.
   crypto::tink::util::StatusOr<std::string> Open(
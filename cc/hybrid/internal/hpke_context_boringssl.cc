@@ -16,6 +16,7 @@
 
 #include "tink/hybrid/internal/hpke_context_boringssl.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
@@ -109,14 +110,22 @@ HpkeContextBoringSsl::SetupRecipient(
 
 util::StatusOr<std::string> HpkeContextBoringSsl::Seal(
     absl::string_view plaintext, absl::string_view associated_data) {
+  return SealWithPrefix(/*prefix=*/"", plaintext, associated_data);
+}
+
+util::StatusOr<std::string> HpkeContextBoringSsl::SealWithPrefix(
+    absl::string_view prefix, absl::string_view plaintext,
+    absl::string_view associated_data) {
   std::string ciphertext;
   subtle::ResizeStringUninitialized(
-      &ciphertext,
-      plaintext.size() + EVP_HPKE_CTX_max_overhead(context_.get()));
-  size_t max_out_len = ciphertext.size();
+      &ciphertext, prefix.size() + plaintext.size() +
+                       EVP_HPKE_CTX_max_overhead(context_.get()));
+  std::copy(prefix.begin(), prefix.end(), ciphertext.begin());
+  size_t max_out_len = ciphertext.size() - prefix.size();
   size_t ciphertext_size;
   if (!EVP_HPKE_CTX_seal(
-          context_.get(), reinterpret_cast<uint8_t *>(&ciphertext[0]),
+          context_.get(),
+          reinterpret_cast<uint8_t *>(&ciphertext[0] + prefix.size()),
           &ciphertext_size, max_out_len,
           reinterpret_cast<const uint8_t *>(plaintext.data()), plaintext.size(),
           reinterpret_cast<const uint8_t *>(associated_data.data()),
@@ -124,8 +133,9 @@ util::StatusOr<std::string> HpkeContextBoringSsl::Seal(
     return util::Status(absl::StatusCode::kUnknown,
                         "BoringSSL HPKE encryption failed.");
   }
-  if (ciphertext_size < ciphertext.size()) {
-    subtle::ResizeStringUninitialized(&ciphertext, ciphertext_size);
+  if (ciphertext_size < max_out_len) {
+    subtle::ResizeStringUninitialized(&ciphertext,
+                                      prefix.size() + ciphertext_size);
   }
   return ciphertext;
 }
@@ -66,6 +66,12 @@ class HpkeContextBoringSsl {
   crypto::tink::util::StatusOr<std::string> Seal(
       absl::string_view plaintext, absl::string_view associated_data);
 
+  // Same as Seal(), but returns `prefix` || ciphertext, with the ciphertext
+  // written directly after the prefix.
+  crypto::tink::util::StatusOr<std::string> SealWithPrefix(
+      absl::string_view prefix, absl::string_view plaintext,
+      absl::string_view associated_data);
+
   // Performs an AEAD decryption of `ciphertext` with `associated_data`. Returns
   // an error if decryption fails.  Otherwise, returns the plaintext.
   crypto::tink::util::StatusOr<std::string> Open(
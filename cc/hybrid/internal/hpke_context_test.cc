@@ -87,6 +87,37 @@ TEST_P(HpkeContextTest, SealAndOpen) {
   }
 }
 
+TEST_P(HpkeContextTest, SealPayload) {
+  HpkeParams hpke_params = GetParam();
+  util::StatusOr<HpkeTestParams> params = CreateHpkeTestParams(hpke_params);
+  ASSERT_THAT(params, IsOk());
+
+  util::StatusOr<std::unique_ptr<HpkeContext>> sender_hpke_context =
+      HpkeContext::SetupSender(hpke_params, params->recipient_public_key,
+                               params->application_info);
+  ASSERT_THAT(sender_hpke_context, IsOk());
+
+  util::StatusOr<std::string> payload =
+      (*sender_hpke_context)->SealPayload(params->plaintext, "aad");
+  ASSERT_THAT(payload, IsOk());
+  util::StatusOr<HpkePayloadView> payload_view =
+      SplitPayload(hpke_params.kem, *payload);
+  ASSERT_THAT(payload_view, IsOk());
+  EXPECT_THAT(payload_view->encapsulated_key,
+              Eq((*sender_hpke_context)->EncapsulatedKey()));
+
+  util::StatusOr<std::unique_ptr<HpkeContext>> recipient_hpke_context =
+      HpkeContext::SetupRecipient(
+          hpke_params,
+          util::SecretDataFromStringView(params->recipient_private_key),
+          payload_view->encapsulated_key, params->application_info);
+  ASSERT_THAT(recipient_hpke_context, IsOk());
+  util::StatusOr<std::string> plaintext =
+      (*recipient_hpke_context)->Open(payload_view->ciphertext, "aad");
+  ASSERT_THAT(plaintext, IsOk());
+  EXPECT_THAT(*plaintext, Eq(params->plaintext));
+}
+
 TEST_P(HpkeContextTest, Export) {
   HpkeParams hpke_params = GetParam();
   util::StatusOr<HpkeTestParams> params = CreateHpkeTestParams(hpke_params);
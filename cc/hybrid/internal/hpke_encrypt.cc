@@ -55,26 +55,21 @@ util::StatusOr<std::unique_ptr<HybridEncrypt>> HpkeEncrypt::New(
     return util::Status(absl::StatusCode::kInvalidArgument,
                         "Recipient public key is missing AEAD");
   }
-  return {absl::WrapUnique(new HpkeEncrypt(recipient_public_key))};
+  util::StatusOr<internal::HpkeParams> params =
+      internal::HpkeParamsProtoToStruct(recipient_public_key.params());
+  if (!params.ok()) return params.status();
+  return {absl::WrapUnique(
+      new HpkeEncrypt(*params, recipient_public_key.public_key()))};
 }
 
 util::StatusOr<std::string> HpkeEncrypt::Encrypt(
     absl::string_view plaintext, absl::string_view context_info) const {
-  util::StatusOr<internal::HpkeParams> params =
-      internal::HpkeParamsProtoToStruct(recipient_public_key_.params());
-  if (!params.ok()) return params.status();
-
   util::StatusOr<std::unique_ptr<internal::HpkeContext>> sender_context =
-      internal::HpkeContext::SetupSender(
-          *params, recipient_public_key_.public_key(), context_info);
+      internal::HpkeContext::SetupSender(params_, recipient_public_key_,
+                                         context_info);
   if (!sender_context.ok()) return sender_context.status();
 
-  util::StatusOr<std::string> ciphertext =
-      (*sender_context)->Seal(plaintext, /*associated_data=*/"");
-  if (!ciphertext.ok()) return ciphertext.status();
-
-  return internal::ConcatenatePayload((*sender_context)->EncapsulatedKey(),
-                                      *ciphertext);
+  return (*sender_context)->SealPayload(plaintext, /*associated_data=*/"");
 }
 
 }  // namespace tink
@@ -20,6 +20,8 @@
 #include <memory>
 #include <string>
 
+#include "absl/strings/string_view.h"
+#include "tink/hybrid/internal/hpke_util.h"
 #include "tink/hybrid_encrypt.h"
 #include "tink/util/statusor.h"
 #include "proto/hpke.pb.h"
@@ -43,11 +45,13 @@ class HpkeEncrypt : public HybridEncrypt {
       absl::string_view context_info) const override;
 
  private:
-  explicit HpkeEncrypt(
-      const google::crypto::tink::HpkePublicKey& recipient_public_key)
-      : recipient_public_key_(recipient_public_key) {}
+  HpkeEncrypt(const internal::HpkeParams& params,
+              absl::string_view recipient_public_key)
+      : params_(params), recipient_public_key_(recipient_public_key) {}
 
-  google::crypto::tink::HpkePublicKey recipient_public_key_;
+  // Parameters and public key of the recipient, converted from the proto once.
+  internal::HpkeParams params_;
+  std::string recipient_public_key_;
 };
 
 }  // namespace tink
@@ -0,0 +1,109 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/internal/adaptive_key_order.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "absl/container/inlined_vector.h"
+#include "absl/memory/memory.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+namespace {
+
+std::atomic<bool> adaptive_key_ordering_enabled(false);
+std::atomic<int64_t> trial_operations(0);
+std::atomic<int64_t> fixed_order_trial_operations(0);
+
+}  // namespace
+
+constexpr uint32_t AdaptiveKeyOrder::kDecayThreshold;
+
+void SetAdaptiveKeyOrderingEnabled(bool enabled) {
+  adaptive_key_ordering_enabled = enabled;
+}
+
+bool IsAdaptiveKeyOrderingEnabled() { return adaptive_key_ordering_enabled; }
+
+KeyOrderingStats GetKeyOrderingStats() {
+  return {trial_operations.load(std::memory_order_relaxed),
+          fixed_order_trial_operations.load(std::memory_order_relaxed)};
+}
+
+void ResetKeyOrderingStats() {
+  trial_operations = 0;
+  fixed_order_trial_operations = 0;
+}
+
+void AddKeyOrderingTrials(int64_t trials, int64_t fixed_order_trials) {
+  trial_operations.fetch_add(trials, std::memory_order_relaxed);
+  fixed_order_trial_operations.fetch_add(fixed_order_trials,
+                                         std::memory_order_relaxed);
+}
+
+std::unique_ptr<AdaptiveKeyOrder> AdaptiveKeyOrder::NewIfEnabled(
+    size_t num_candidates) {
+  if (!IsAdaptiveKeyOrderingEnabled() || num_candidates < 2) {
+    return nullptr;
+  }
+  return absl::make_unique<AdaptiveKeyOrder>(num_candidates);
+}
+
+absl::InlinedVector<size_t, 8> AdaptiveKeyOrder::Order() const {
+  absl::InlinedVector<uint32_t, 8> counts(successes_.size());
+  absl::InlinedVector<size_t, 8> indices(successes_.size());
+  for (size_t i = 0; i < successes_.size(); ++i) {
+    counts[i] = successes_[i].load(std::memory_order_relaxed);
+    indices[i] = i;
+  }
+  std::stable_sort(indices.begin(), indices.end(),
+                   [&counts](size_t a, size_t b) {
+                     return counts[a] > counts[b];
+                   });
+  return indices;
+}
+
+void AdaptiveKeyOrder::RecordSuccesses(size_t index, size_t trials,
+                                       size_t count) const {
+  if (count == 0) return;
+  AddKeyOrderingTrials(trials * count, (index + 1) * count);
+  const uint32_t increment =
+      static_cast<uint32_t>(std::min<size_t>(count, kDecayThreshold));
+  if (successes_[index].fetch_add(increment, std::memory_order_relaxed) +
+          increment <
+      kDecayThreshold) {
+    return;
+  }
+  for (std::atomic<uint32_t>& successes : successes_) {
+    successes.store(successes.load(std::memory_order_relaxed) / 2,
+                    std::memory_order_relaxed);
+  }
+}
+
+void AdaptiveKeyOrder::RecordFailures(size_t count) const {
+  AddKeyOrderingTrials(successes_.size() * count, successes_.size() * count);
+}
+
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
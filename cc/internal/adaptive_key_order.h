@@ -0,0 +1,190 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef TINK_INTERNAL_ADAPTIVE_KEY_ORDER_H_
+#define TINK_INTERNAL_ADAPTIVE_KEY_ORDER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/inlined_vector.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/string_view.h"
+#include "tink/primitive_set.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+
+// Process-wide switch for adaptive key ordering. Only wrappers created after
+// enabling it use adaptive ordering; existing wrappers keep their mode.
+void SetAdaptiveKeyOrderingEnabled(bool enabled);
+bool IsAdaptiveKeyOrderingEnabled();
+
+// Number of trial operations (decryptions or verifications) performed by
+// adaptively ordered wrappers, and the number the fixed keyset order would
+// have needed for the same calls.
+struct KeyOrderingStats {
+  int64_t trial_operations;
+  int64_t fixed_order_trial_operations;
+};
+
+KeyOrderingStats GetKeyOrderingStats();
+void ResetKeyOrderingStats();
+
+// Adds `trials` trial operations, for which the keyset order would have
+// needed `fixed_order_trials`.
+void AddKeyOrderingTrials(int64_t trials, int64_t fixed_order_trials);
+
+// Orders a fixed list of candidate keys by how often each of them succeeded
+// recently. Counters are updated with relaxed atomics, so that concurrent
+// callers never block each other; a lost update merely perturbs the order.
+class AdaptiveKeyOrder {
+ public:
+  // Counters are halved once one of them reaches this value, so that a key
+  // that stops being used loses its rank after about this many operations.
+  static constexpr uint32_t kDecayThreshold = 1024;
+
+  // Returns an AdaptiveKeyOrder for `num_candidates` candidates, or nullptr if
+  // adaptive key ordering is disabled or there is nothing to reorder.
+  static std::unique_ptr<AdaptiveKeyOrder> NewIfEnabled(size_t num_candidates);
+
+  explicit AdaptiveKeyOrder(size_t num_candidates)
+      : successes_(num_candidates) {}
+
+  // Not copyable or movable.
+  AdaptiveKeyOrder(const AdaptiveKeyOrder&) = delete;
+  AdaptiveKeyOrder& operator=(const AdaptiveKeyOrder&) = delete;
+
+  // Returns the candidate indices, most frequently successful first. Ties
+  // keep the original candidate order.
+  absl::InlinedVector<size_t, 8> Order() const;
+
+  // Records `count` inputs on which candidate `index` succeeded after
+  // `trials` trials.
+  void RecordSuccesses(size_t index, size_t trials, size_t count) const;
+
+  // Records `count` inputs on which no candidate succeeded.
+  void RecordFailures(size_t count) const;
+
+  size_t size() const { return successes_.size(); }
+
+ private:
+  mutable std::vector<std::atomic<uint32_t>> successes_;
+};
+
+// Calls `try_candidate(i)` for the indices `i` in [0, `num_candidates`) until
+// it returns true, and returns whether it did. If `order` is null, candidates
+// are tried in their original order; otherwise in the order of `order`, which
+// must have been created for `num_candidates` candidates and is updated with
+// the outcome.
+template <class F>
+bool TryCandidates(const AdaptiveKeyOrder* order, size_t num_candidates,
+                   F try_candidate) {
+  if (order == nullptr) {
+    for (size_t i = 0; i < num_candidates; ++i) {
+      if (try_candidate(i)) return true;
+    }
+    return false;
+  }
+  absl::InlinedVector<size_t, 8> indices = order->Order();
+  for (size_t trials = 1; trials <= indices.size(); ++trials) {
+    if (try_candidate(indices[trials - 1])) {
+      order->RecordSuccesses(indices[trials - 1], trials, /*count=*/1);
+      return true;
+    }
+  }
+  order->RecordFailures(/*count=*/1);
+  return false;
+}
+
+// Batch variant of TryCandidates() for `num_inputs` inputs. Calls
+// `try_candidate(i)` for the candidates `i` in order, as long as some inputs
+// remain; `try_candidate(i)` must try candidate `i` on the inputs that no
+// earlier candidate succeeded on, and return the number of inputs it
+// succeeded on.
+template <class F>
+crypto::tink::util::Status TryCandidatesOnBatch(const AdaptiveKeyOrder* order,
+                                                size_t num_candidates,
+                                                size_t num_inputs,
+                                                F try_candidate) {
+  absl::InlinedVector<size_t, 8> indices;
+  if (order != nullptr) {
+    indices = order->Order();
+  } else {
+    for (size_t i = 0; i < num_candidates; ++i) indices.push_back(i);
+  }
+  size_t num_remaining = num_inputs;
+  for (size_t trials = 1; trials <= indices.size() && num_remaining > 0;
+       ++trials) {
+    crypto::tink::util::StatusOr<size_t> num_succeeded =
+        try_candidate(indices[trials - 1]);
+    if (!num_succeeded.ok()) return num_succeeded.status();
+    num_remaining -= *num_succeeded;
+    if (order != nullptr) {
+      order->RecordSuccesses(indices[trials - 1], trials, *num_succeeded);
+    }
+  }
+  if (order != nullptr) order->RecordFailures(num_remaining);
+  return crypto::tink::util::OkStatus();
+}
+
+// Holds an AdaptiveKeyOrder for each group of entries of a PrimitiveSet that
+// share an output prefix and have more than one entry, such as the RAW keys.
+// Holds nothing if adaptive key ordering is disabled.
+template <class P>
+class PrimitiveSetKeyOrder {
+ public:
+  explicit PrimitiveSetKeyOrder(const PrimitiveSet<P>& primitive_set) {
+    if (!IsAdaptiveKeyOrderingEnabled()) return;
+    absl::flat_hash_map<std::string, size_t> group_sizes;
+    for (const auto* entry : primitive_set.get_all()) {
+      ++group_sizes[entry->get_identifier()];
+    }
+    for (const auto& identifier_and_size : group_sizes) {
+      std::unique_ptr<AdaptiveKeyOrder> order =
+          AdaptiveKeyOrder::NewIfEnabled(identifier_and_size.second);
+      if (order != nullptr) {
+        orders_[identifier_and_size.first] = std::move(order);
+      }
+    }
+  }
+
+  // Returns the order of the entries with output prefix `identifier`, or
+  // nullptr if they are tried in their original order.
+  const AdaptiveKeyOrder* Get(absl::string_view identifier) const {
+    if (orders_.empty()) return nullptr;
+    auto it = orders_.find(identifier);
+    return it == orders_.end() ? nullptr : it->second.get();
+  }
+
+ private:
+  absl::flat_hash_map<std::string, std::unique_ptr<AdaptiveKeyOrder>> orders_;
+};
+
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_INTERNAL_ADAPTIVE_KEY_ORDER_H_
@@ -0,0 +1,158 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/internal/adaptive_key_order.h"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/container/inlined_vector.h"
+#include "absl/status/status.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::testing::ElementsAre;
+using ::testing::IsNull;
+using ::testing::NotNull;
+
+class AdaptiveKeyOrderTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    SetAdaptiveKeyOrderingEnabled(true);
+    ResetKeyOrderingStats();
+  }
+  void TearDown() override { SetAdaptiveKeyOrderingEnabled(false); }
+};
+
+TEST_F(AdaptiveKeyOrderTest, NewIfEnabled) {
+  EXPECT_THAT(AdaptiveKeyOrder::NewIfEnabled(3), NotNull());
+  // A single candidate has nothing to reorder.
+  EXPECT_THAT(AdaptiveKeyOrder::NewIfEnabled(1), IsNull());
+  SetAdaptiveKeyOrderingEnabled(false);
+  EXPECT_THAT(AdaptiveKeyOrder::NewIfEnabled(3), IsNull());
+}
+
+TEST_F(AdaptiveKeyOrderTest, InitialOrderIsOriginalOrder) {
+  AdaptiveKeyOrder order(4);
+  EXPECT_THAT(order.Order(), ElementsAre(0, 1, 2, 3));
+}
+
+TEST_F(AdaptiveKeyOrderTest, MostSuccessfulFirst) {
+  AdaptiveKeyOrder order(4);
+  order.RecordSuccesses(/*index=*/2, /*trials=*/3, /*count=*/5);
+  order.RecordSuccesses(/*index=*/3, /*trials=*/4, /*count=*/2);
+  EXPECT_THAT(order.Order(), ElementsAre(2, 3, 0, 1));
+}
+
+TEST_F(AdaptiveKeyOrderTest, StaleKeyLosesRank) {
+  AdaptiveKeyOrder order(2);
+  order.RecordSuccesses(/*index=*/0, /*trials=*/1, /*count=*/500);
+  EXPECT_THAT(order.Order(), ElementsAre(0, 1));
+  // Counters decay, so that a newly used key overtakes the old one well
+  // before matching its total count.
+  for (int i = 0; i < 3; ++i) {
+    order.RecordSuccesses(/*index=*/1, /*trials=*/2,
+                          /*count=*/AdaptiveKeyOrder::kDecayThreshold);
+  }
+  EXPECT_THAT(order.Order(), ElementsAre(1, 0));
+}
+
+TEST_F(AdaptiveKeyOrderTest, TryCandidatesWithoutOrder) {
+  std::vector<size_t> tried;
+  EXPECT_TRUE(TryCandidates(/*order=*/nullptr, 3, [&](size_t i) {
+    tried.push_back(i);
+    return i == 2;
+  }));
+  EXPECT_THAT(tried, ElementsAre(0, 1, 2));
+  EXPECT_EQ(GetKeyOrderingStats().trial_operations, 0);
+}
+
+TEST_F(AdaptiveKeyOrderTest, TryCandidatesLearnsAndCountsSavedTrials) {
+  AdaptiveKeyOrder order(3);
+  auto only_last_succeeds = [](size_t i) { return i == 2; };
+  EXPECT_TRUE(TryCandidates(&order, 3, only_last_succeeds));
+  std::vector<size_t> tried;
+  EXPECT_TRUE(TryCandidates(&order, 3, [&](size_t i) {
+    tried.push_back(i);
+    return i == 2;
+  }));
+  EXPECT_THAT(tried, ElementsAre(2));
+  EXPECT_FALSE(TryCandidates(&order, 3, [](size_t) { return false; }));
+
+  KeyOrderingStats stats = GetKeyOrderingStats();
+  EXPECT_EQ(stats.trial_operations, 3 + 1 + 3);
+  EXPECT_EQ(stats.fixed_order_trial_operations, 3 + 3 + 3);
+}
+
+TEST_F(AdaptiveKeyOrderTest, TryCandidatesOnBatch) {
+  AdaptiveKeyOrder order(3);
+  order.RecordSuccesses(/*index=*/1, /*trials=*/2, /*count=*/1);
+  ResetKeyOrderingStats();
+
+  // Candidate 1 succeeds on 4 inputs, candidate 2 on 1, and 2 inputs fail.
+  std::vector<size_t> tried;
+  util::Status status =
+      TryCandidatesOnBatch(&order, 3, /*num_inputs=*/7,
+                           [&](size_t i) -> util::StatusOr<size_t> {
+                             tried.push_back(i);
+                             if (i == 1) return 4;
+                             if (i == 2) return 1;
+                             return 0;
+                           });
+  EXPECT_THAT(status, IsOk());
+  EXPECT_THAT(tried, ElementsAre(1, 0, 2));
+  KeyOrderingStats stats = GetKeyOrderingStats();
+  EXPECT_EQ(stats.trial_operations, 4 * 1 + 1 * 3 + 2 * 3);
+  EXPECT_EQ(stats.fixed_order_trial_operations, 4 * 2 + 1 * 3 + 2 * 3);
+}
+
+TEST_F(AdaptiveKeyOrderTest, TryCandidatesOnBatchStopsWhenDone) {
+  std::vector<size_t> tried;
+  EXPECT_THAT(TryCandidatesOnBatch(/*order=*/nullptr, 3, /*num_inputs=*/2,
+                                   [&](size_t i) -> util::StatusOr<size_t> {
+                                     tried.push_back(i);
+                                     return 2;
+                                   }),
+              IsOk());
+  EXPECT_THAT(tried, ElementsAre(0));
+}
+
+TEST_F(AdaptiveKeyOrderTest, TryCandidatesOnBatchPropagatesErrors) {
+  AdaptiveKeyOrder order(2);
+  EXPECT_THAT(TryCandidatesOnBatch(&order, 2, /*num_inputs=*/1,
+                                   [](size_t) -> util::StatusOr<size_t> {
+                                     return util::Status(
+                                         absl::StatusCode::kInternal, "error");
+                                   }),
+              StatusIs(absl::StatusCode::kInternal));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
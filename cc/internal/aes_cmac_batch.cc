@@ -0,0 +1,228 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/internal/aes_cmac_batch.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "openssl/crypto.h"
+#include "openssl/evp.h"
+#include "tink/internal/aes_util.h"
+#include "tink/internal/ssl_unique_ptr.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+namespace {
+
+constexpr size_t kBlockSize = AesBlockSize();
+
+// Returns a new AES-ECB encryption context without padding for `key`.
+util::StatusOr<SslUniquePtr<EVP_CIPHER_CTX>> NewEcbContext(
+    const util::SecretData& key) {
+  util::StatusOr<const EVP_CIPHER*> cipher =
+      GetAesEcbCipherForKeySize(key.size());
+  if (!cipher.ok()) {
+    return cipher.status();
+  }
+  SslUniquePtr<EVP_CIPHER_CTX> context(EVP_CIPHER_CTX_new());
+  if (context == nullptr) {
+    return util::Status(absl::StatusCode::kInternal,
+                        "EVP_CIPHER_CTX_new failed");
+  }
+  if (EVP_EncryptInit_ex(context.get(), *cipher, /*impl=*/nullptr,
+                         reinterpret_cast<const uint8_t*>(key.data()),
+                         /*iv=*/nullptr) <= 0 ||
+      EVP_CIPHER_CTX_set_padding(context.get(), /*pad=*/0) <= 0) {
+    return util::Status(absl::StatusCode::kInternal,
+                        "Context initialization failed");
+  }
+  return std::move(context);
+}
+
+// Encrypts `num_blocks` consecutive blocks from `in` into `out`.
+util::Status EncryptBlocks(EVP_CIPHER_CTX* context, const uint8_t* in,
+                           int num_blocks, uint8_t* out) {
+  int len = 0;
+  if (EVP_EncryptUpdate(context, out, &len, in, num_blocks * kBlockSize) <=
+          0 ||
+      len != num_blocks * static_cast<int>(kBlockSize)) {
+    return util::Status(absl::StatusCode::kInternal, "Failed to compute CMAC");
+  }
+  return util::OkStatus();
+}
+
+// Multiplication by x in GF(2^128), as used for subkey generation in
+// RFC 4493, Section 2.3.
+util::SecretData Double(const util::SecretData& in) {
+  util::SecretData out(kBlockSize);
+  for (size_t i = 0; i < kBlockSize - 1; ++i) {
+    out[i] = (in[i] << 1) | (in[i + 1] >> 7);
+  }
+  out[kBlockSize - 1] = in[kBlockSize - 1] << 1;
+  // Constant-time conditional reduction.
+  out[kBlockSize - 1] ^= 0x87 & (0 - (in[0] >> 7));
+  return out;
+}
+
+size_t NumBlocks(absl::string_view input) {
+  if (input.empty()) return 1;
+  return (input.size() + kBlockSize - 1) / kBlockSize;
+}
+
+struct Lane {
+  // Index of the message processed by this lane.
+  size_t input;
+  // Index of the next block to process.
+  size_t block;
+  // Total number of blocks of the message.
+  size_t num_blocks;
+};
+
+}  // namespace
+
+util::StatusOr<std::unique_ptr<AesCmacBatch>> AesCmacBatch::New(
+    const util::SecretData& key) {
+  util::StatusOr<SslUniquePtr<EVP_CIPHER_CTX>> context = NewEcbContext(key);
+  if (!context.ok()) {
+    return context.status();
+  }
+  const std::array<uint8_t, kBlockSize> zeros = {};
+  util::SecretData l(kBlockSize);
+  util::Status status =
+      EncryptBlocks(context->get(), zeros.data(), /*num_blocks=*/1, l.data());
+  if (!status.ok()) {
+    return status;
+  }
+  util::SecretData k1 = Double(l);
+  util::SecretData k2 = Double(k1);
+  return absl::WrapUnique(
+      new AesCmacBatch(key, std::move(k1), std::move(k2)));
+}
+
+util::Status AesCmacBatch::Compute(absl::Span<const absl::string_view> inputs,
+                                   absl::Span<uint8_t> out) const {
+  if (out.size() != kTagSize * inputs.size()) {
+    return util::Status(
+        absl::StatusCode::kInvalidArgument,
+        absl::StrCat("Invalid output size; expected ",
+                     kTagSize * inputs.size(), " got ", out.size()));
+  }
+  if (inputs.empty()) {
+    return util::OkStatus();
+  }
+  util::StatusOr<SslUniquePtr<EVP_CIPHER_CTX>> context = NewEcbContext(key_);
+  if (!context.ok()) {
+    return context.status();
+  }
+
+  std::array<Lane, kNumLanes> lanes;
+  // Chaining values of the active lanes, stored contiguously so that one ECB
+  // call advances all of them.
+  std::array<uint8_t, kNumLanes * kBlockSize> state;
+  // Next cipher input of every active lane.
+  std::array<uint8_t, kNumLanes * kBlockSize> blocks;
+
+  size_t next_input = 0;
+  int num_active = 0;
+  auto start_lane = [&](int lane) {
+    lanes[lane] = {next_input, 0, NumBlocks(inputs[next_input])};
+    std::memset(&state[lane * kBlockSize], 0, kBlockSize);
+    ++next_input;
+  };
+  while (num_active < kNumLanes && next_input < inputs.size()) {
+    start_lane(num_active++);
+  }
+
+  while (num_active > 0) {
+    for (int i = 0; i < num_active; ++i) {
+      const Lane& lane = lanes[i];
+      absl::string_view input = inputs[lane.input];
+      uint8_t* block = &blocks[i * kBlockSize];
+      const size_t offset = lane.block * kBlockSize;
+      if (lane.block + 1 < lane.num_blocks) {
+        std::memcpy(block, input.data() + offset, kBlockSize);
+      } else {
+        // Last block: complete blocks are masked with K1, incomplete ones are
+        // padded with 10^i and masked with K2.
+        const size_t remaining = input.size() - offset;
+        const util::SecretData* subkey = &k1_;
+        if (remaining == kBlockSize) {
+          std::memcpy(block, input.data() + offset, kBlockSize);
+        } else {
+          if (remaining > 0) {
+            std::memcpy(block, input.data() + offset, remaining);
+          }
+          block[remaining] = 0x80;
+          std::memset(block + remaining + 1, 0, kBlockSize - remaining - 1);
+          subkey = &k2_;
+        }
+        for (size_t j = 0; j < kBlockSize; ++j) {
+          block[j] ^= (*subkey)[j];
+        }
+      }
+      for (size_t j = 0; j < kBlockSize; ++j) {
+        block[j] ^= state[i * kBlockSize + j];
+      }
+    }
+
+    util::Status status =
+        EncryptBlocks(context->get(), blocks.data(), num_active, state.data());
+    if (!status.ok()) {
+      return status;
+    }
+
+    // Walk the lanes backwards, so that a finished lane can be replaced by the
+    // last active one, which has already been advanced in this step.
+    for (int i = num_active - 1; i >= 0; --i) {
+      Lane& lane = lanes[i];
+      if (++lane.block < lane.num_blocks) continue;
+      std::memcpy(&out[lane.input * kTagSize], &state[i * kBlockSize],
+                  kTagSize);
+      if (next_input < inputs.size()) {
+        start_lane(i);
+      } else {
+        --num_active;
+        if (i != num_active) {
+          lanes[i] = lanes[num_active];
+          std::memcpy(&state[i * kBlockSize], &state[num_active * kBlockSize],
+                      kBlockSize);
+        }
+      }
+    }
+  }
+
+  OPENSSL_cleanse(state.data(), state.size());
+  OPENSSL_cleanse(blocks.data(), blocks.size());
+  return util::OkStatus();
+}
+
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
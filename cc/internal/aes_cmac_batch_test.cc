@@ -0,0 +1,170 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/internal/aes_cmac_batch.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/status/status.h"
+#include "absl/strings/escaping.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "openssl/cmac.h"
+#include "openssl/evp.h"
+#include "tink/internal/aes_util.h"
+#include "tink/internal/ssl_unique_ptr.h"
+#include "tink/subtle/random.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::testing::Eq;
+using ::testing::Not;
+
+// Computes the CMAC of `data` with the one-message-at-a-time CMAC API.
+std::string ReferenceCmac(const util::SecretData& key, absl::string_view data) {
+  SslUniquePtr<CMAC_CTX> context(CMAC_CTX_new());
+  uint8_t tag[AesCmacBatch::kTagSize];
+  size_t len = 0;
+  util::StatusOr<const EVP_CIPHER*> cipher =
+      GetAesCbcCipherForKeySize(key.size());
+  EXPECT_THAT(cipher, IsOk());
+  EXPECT_EQ(CMAC_Init(context.get(), key.data(), key.size(), *cipher,
+                      /*impl=*/nullptr),
+            1);
+  EXPECT_EQ(CMAC_Update(context.get(),
+                        reinterpret_cast<const uint8_t*>(data.data()),
+                        data.size()),
+            1);
+  EXPECT_EQ(CMAC_Final(context.get(), tag, &len), 1);
+  return std::string(reinterpret_cast<const char*>(tag), len);
+}
+
+std::vector<std::string> ComputeBatch(
+    const AesCmacBatch& cmac, const std::vector<std::string>& messages) {
+  std::vector<absl::string_view> inputs(messages.begin(), messages.end());
+  std::vector<uint8_t> out(AesCmacBatch::kTagSize * inputs.size());
+  EXPECT_THAT(cmac.Compute(inputs, absl::MakeSpan(out)), IsOk());
+  std::vector<std::string> tags;
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    tags.push_back(std::string(
+        reinterpret_cast<const char*>(&out[i * AesCmacBatch::kTagSize]),
+        AesCmacBatch::kTagSize));
+  }
+  return tags;
+}
+
+// Test vectors from RFC 4493, Section 4.
+TEST(AesCmacBatchTest, Rfc4493TestVectors) {
+  util::SecretData key = util::SecretDataFromStringView(
+      absl::HexStringToBytes("2b7e151628aed2a6abf7158809cf4f3c"));
+  util::StatusOr<std::unique_ptr<AesCmacBatch>> cmac = AesCmacBatch::New(key);
+  ASSERT_THAT(cmac, IsOk());
+
+  std::string message = absl::HexStringToBytes(
+      "6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51"
+      "30c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710");
+  std::vector<std::string> messages = {message.substr(0, 0),
+                                       message.substr(0, 16),
+                                       message.substr(0, 40), message};
+  EXPECT_THAT(
+      ComputeBatch(**cmac, messages),
+      Eq(std::vector<std::string>{
+          absl::HexStringToBytes("bb1d6929e95937287fa37d129b756746"),
+          absl::HexStringToBytes("070a16b46b4d4144f79bdd9dd04a287c"),
+          absl::HexStringToBytes("dfa66747de9ae63030ca32611497c827"),
+          absl::HexStringToBytes("51f0bebf7e3b9d92fc49741779363cfe")}));
+}
+
+TEST(AesCmacBatchTest, MatchesSingleMessageCmac) {
+  for (size_t key_size : {16, 32}) {
+    util::SecretData key = util::SecretDataFromStringView(
+        subtle::Random::GetRandomBytes(key_size));
+    util::StatusOr<std::unique_ptr<AesCmacBatch>> cmac =
+        AesCmacBatch::New(key);
+    ASSERT_THAT(cmac, IsOk());
+
+    // Mixing lengths exercises lanes finishing at different steps and being
+    // refilled with pending messages.
+    std::vector<std::string> messages;
+    for (size_t i = 0; i < 130; ++i) {
+      messages.push_back(subtle::Random::GetRandomBytes((i * 7) % 131));
+    }
+    std::vector<std::string> tags = ComputeBatch(**cmac, messages);
+    ASSERT_EQ(tags.size(), messages.size());
+    for (size_t i = 0; i < messages.size(); ++i) {
+      EXPECT_EQ(tags[i], ReferenceCmac(key, messages[i]))
+          << "message size " << messages[i].size();
+    }
+  }
+}
+
+TEST(AesCmacBatchTest, BatchSizes) {
+  util::SecretData key =
+      util::SecretDataFromStringView(subtle::Random::GetRandomBytes(32));
+  util::StatusOr<std::unique_ptr<AesCmacBatch>> cmac = AesCmacBatch::New(key);
+  ASSERT_THAT(cmac, IsOk());
+  for (size_t batch_size = 0; batch_size <= 2 * AesCmacBatch::kNumLanes + 1;
+       ++batch_size) {
+    std::vector<std::string> messages;
+    for (size_t i = 0; i < batch_size; ++i) {
+      messages.push_back(subtle::Random::GetRandomBytes(16 + i));
+    }
+    std::vector<std::string> tags = ComputeBatch(**cmac, messages);
+    ASSERT_EQ(tags.size(), batch_size);
+    for (size_t i = 0; i < batch_size; ++i) {
+      EXPECT_EQ(tags[i], ReferenceCmac(key, messages[i]));
+    }
+  }
+}
+
+TEST(AesCmacBatchTest, InvalidKeySize) {
+  for (size_t key_size : {0, 15, 24, 33}) {
+    EXPECT_THAT(AesCmacBatch::New(util::SecretDataFromStringView(
+                                      subtle::Random::GetRandomBytes(key_size)))
+                    .status(),
+                Not(IsOk()));
+  }
+}
+
+TEST(AesCmacBatchTest, InvalidOutputSize) {
+  util::StatusOr<std::unique_ptr<AesCmacBatch>> cmac = AesCmacBatch::New(
+      util::SecretDataFromStringView(subtle::Random::GetRandomBytes(32)));
+  ASSERT_THAT(cmac, IsOk());
+  std::vector<absl::string_view> inputs = {"a", "b"};
+  std::vector<uint8_t> out(AesCmacBatch::kTagSize * inputs.size() - 1);
+  EXPECT_THAT((*cmac)->Compute(inputs, absl::MakeSpan(out)),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
@@ -73,13 +73,36 @@ util::Status AesCtr128Crypt(absl::string_view data, uint8_t iv[AesBlockSize()],
   return util::OkStatus();
 }
 
+namespace {
+
+// Returns the implementation of `cipher` that is used for the remainder of the
+// process. With OpenSSL 3 this is fetched from the provider once, instead of
+// implicitly on every EVP_CipherInit_ex call; with BoringSSL and older OpenSSL
+// versions `cipher` is returned unchanged.
+const EVP_CIPHER* Prefetch(const EVP_CIPHER* cipher) {
+#if !defined(OPENSSL_IS_BORINGSSL) && OPENSSL_VERSION_NUMBER >= 0x30000000L
+  EVP_CIPHER* fetched = EVP_CIPHER_fetch(
+      /*ctx=*/nullptr, EVP_CIPHER_get0_name(cipher), /*properties=*/nullptr);
+  if (fetched != nullptr) {
+    return fetched;
+  }
+#endif
+  return cipher;
+}
+
+}  // namespace
+
 util::StatusOr<const EVP_CIPHER*> GetAesCtrCipherForKeySize(
     uint32_t key_size_in_bytes) {
   switch (key_size_in_bytes) {
-    case 16:
-      return EVP_aes_128_ctr();
-    case 32:
-      return EVP_aes_256_ctr();
+    case 16: {
+      static const EVP_CIPHER* const kCipher = Prefetch(EVP_aes_128_ctr());
+      return kCipher;
+    }
+    case 32: {
+      static const EVP_CIPHER* const kCipher = Prefetch(EVP_aes_256_ctr());
+      return kCipher;
+    }
     default:
       return util::Status(absl::StatusCode::kInvalidArgument,
                           absl::StrCat("Invalid key size ", key_size_in_bytes));
@@ -89,10 +112,30 @@ util::StatusOr<const EVP_CIPHER*> GetAesCtrCipherForKeySize(
 util::StatusOr<const EVP_CIPHER*> GetAesCbcCipherForKeySize(
     uint32_t key_size_in_bytes) {
   switch (key_size_in_bytes) {
-    case 16:
-      return EVP_aes_128_cbc();
-    case 32:
-      return EVP_aes_256_cbc();
+    case 16: {
+      static const EVP_CIPHER* const kCipher = Prefetch(EVP_aes_128_cbc());
+      return kCipher;
+    }
+    case 32: {
+      static const EVP_CIPHER* const kCipher = Prefetch(EVP_aes_256_cbc());
+      return kCipher;
+    }
+  }
+  return util::Status(absl::StatusCode::kInvalidArgument,
+                      absl::StrCat("Invalid key size ", key_size_in_bytes));
+}
+
+util::StatusOr<const EVP_CIPHER*> GetAesEcbCipherForKeySize(
+    uint32_t key_size_in_bytes) {
+  switch (key_size_in_bytes) {
+    case 16: {
+      static const EVP_CIPHER* const kCipher = Prefetch(EVP_aes_128_ecb());
+      return kCipher;
+    }
+    case 32: {
+      static const EVP_CIPHER* const kCipher = Prefetch(EVP_aes_256_ecb());
+      return kCipher;
+    }
   }
   return util::Status(absl::StatusCode::kInvalidArgument,
                       absl::StrCat("Invalid key size ", key_size_in_bytes));
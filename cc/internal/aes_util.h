@@ -53,6 +53,11 @@ util::StatusOr<const EVP_CIPHER*> GetAesCtrCipherForKeySize(
 util::StatusOr<const EVP_CIPHER*> GetAesCbcCipherForKeySize(
     uint32_t key_size_in_bytes);
 
+// Returns a pointer to an AES-ECB EVP_CIPHER for the given key size
+// `key_size_in_bytes`.
+util::StatusOr<const EVP_CIPHER*> GetAesEcbCipherForKeySize(
+    uint32_t key_size_in_bytes);
+
 }  // namespace internal
 }  // namespace tink
 }  // namespace crypto
@@ -156,9 +156,11 @@ TEST(AesUtilTest, GetAesCtrCipherForKeySize) {
   for (int i = 0; i < 64; i++) {
     util::StatusOr<const EVP_CIPHER*> cipher = GetAesCtrCipherForKeySize(i);
     if (i == 16) {
-      EXPECT_THAT(cipher, IsOkAndHolds(EVP_aes_128_ctr()));
+      ASSERT_THAT(cipher, IsOk());
+      EXPECT_EQ(EVP_CIPHER_nid(*cipher), EVP_CIPHER_nid(EVP_aes_128_ctr()));
     } else if (i == 32) {
-      EXPECT_THAT(cipher, IsOkAndHolds(EVP_aes_256_ctr()));
+      ASSERT_THAT(cipher, IsOk());
+      EXPECT_EQ(EVP_CIPHER_nid(*cipher), EVP_CIPHER_nid(EVP_aes_256_ctr()));
     } else {
       EXPECT_THAT(cipher, Not(IsOk()));
     }
@@ -169,9 +171,26 @@ TEST(AesUtilTest, GetAesCbcCipherForKeySize) {
   for (int i = 0; i < 64; i++) {
     util::StatusOr<const EVP_CIPHER*> cipher = GetAesCbcCipherForKeySize(i);
     if (i == 16) {
-      EXPECT_THAT(cipher, IsOkAndHolds(EVP_aes_128_cbc()));
+      ASSERT_THAT(cipher, IsOk());
+      EXPECT_EQ(EVP_CIPHER_nid(*cipher), EVP_CIPHER_nid(EVP_aes_128_cbc()));
     } else if (i == 32) {
-      EXPECT_THAT(cipher, IsOkAndHolds(EVP_aes_256_cbc()));
+      ASSERT_THAT(cipher, IsOk());
+      EXPECT_EQ(EVP_CIPHER_nid(*cipher), EVP_CIPHER_nid(EVP_aes_256_cbc()));
+    } else {
+      EXPECT_THAT(cipher, Not(IsOk()));
+    }
+  }
+}
+
+TEST(AesUtilTest, GetAesEcbCipherForKeySize) {
+  for (int i = 0; i < 64; i++) {
+    util::StatusOr<const EVP_CIPHER*> cipher = GetAesEcbCipherForKeySize(i);
+    if (i == 16) {
+      ASSERT_THAT(cipher, IsOk());
+      EXPECT_EQ(EVP_CIPHER_nid(*cipher), EVP_CIPHER_nid(EVP_aes_128_ecb()));
+    } else if (i == 32) {
+      ASSERT_THAT(cipher, IsOk());
+      EXPECT_EQ(EVP_CIPHER_nid(*cipher), EVP_CIPHER_nid(EVP_aes_256_ecb()));
     } else {
       EXPECT_THAT(cipher, Not(IsOk()));
     }
@@ -59,7 +59,7 @@ using ::crypto::tink::subtle::EllipticCurveType;
 
 // Encodes the given `point` to string, according to a `conversion_form`.
 util::StatusOr<std::string> SslEcPointEncode(
-    EC_GROUP *group, const EC_POINT *point,
+    const EC_GROUP *group, const EC_POINT *point,
     point_conversion_form_t conversion_form) {
   // Get the buffer size first passing a NULL buffer.
   size_t buffer_size =
@@ -116,7 +116,7 @@ util::StatusOr<SslUniquePtr<EC_POINT>> SslGetEcPointFromEncoded(
         absl::StatusCode::kInvalidArgument,
         absl::StrCat("Invalid format ", subtle::EnumToString(format)));
   }
-  util::StatusOr<SslUniquePtr<EC_GROUP>> group = EcGroupFromCurveType(curve);
+  util::StatusOr<const EC_GROUP *> group = CachedEcGroupFromCurveType(curve);
   if (!group.ok()) {
     return group.status();
   }
@@ -146,15 +146,15 @@ util::StatusOr<SslUniquePtr<EC_POINT>> SslGetEcPointFromEncoded(
                         "0x03, but input doesn't");
   }
 
-  SslUniquePtr<EC_POINT> point(EC_POINT_new(group->get()));
-  if (EC_POINT_oct2point(group->get(), point.get(),
+  SslUniquePtr<EC_POINT> point(EC_POINT_new(*group));
+  if (EC_POINT_oct2point(*group, point.get(),
                          reinterpret_cast<const uint8_t *>(encoded.data()),
                          encoded.size(), nullptr) != 1) {
     return util::Status(absl::StatusCode::kInternal,
                         "EC_POINT_toc2point failed");
   }
   // Check that point is on curve.
-  if (EC_POINT_is_on_curve(group->get(), point.get(), nullptr) != 1) {
+  if (EC_POINT_is_on_curve(*group, point.get(), nullptr) != 1) {
     return util::Status(absl::StatusCode::kInternal, "Point is not on curve");
   }
 
@@ -268,11 +268,30 @@ util::StatusOr<std::string> SslEcdsaSignatureToBytes(
   return result;
 }
 
+// Returns a new EC_GROUP for the curve `nid` that is never modified after this
+// call, or nullptr on failure.
+const EC_GROUP *NewImmutableEcGroup(int nid) {
+  EC_GROUP *group = EC_GROUP_new_by_curve_name(nid);
+  if (group == nullptr) {
+    return nullptr;
+  }
+#if !defined(OPENSSL_IS_BORINGSSL) && OPENSSL_VERSION_NUMBER < 0x30000000L
+  // OpenSSL 1.1 only ships static generator tables for some curves; compute
+  // the missing ones once here so every later scalar multiplication by the
+  // generator benefits. BoringSSL and OpenSSL 3 always use built-in tables.
+  if (EC_GROUP_precompute_mult(group, /*ctx=*/nullptr) != 1) {
+    EC_GROUP_free(group);
+    return nullptr;
+  }
+#endif
+  return group;
+}
+
 }  // namespace
 
 util::StatusOr<EcKey> EcKeyFromSslEcKey(EllipticCurveType curve,
                                         const EC_KEY &key) {
-  util::StatusOr<SslUniquePtr<EC_GROUP>> group = EcGroupFromCurveType(curve);
+  util::StatusOr<const EC_GROUP *> group = CachedEcGroupFromCurveType(curve);
   if (!group.ok()) {
     return group.status();
   }
@@ -280,12 +299,12 @@ util::StatusOr<EcKey> EcKeyFromSslEcKey(EllipticCurveType curve,
   const EC_POINT *pub_key = EC_KEY_get0_public_key(&key);
 
   util::StatusOr<EcPointCoordinates> pub_key_bns =
-      SslGetEcPointCoordinates(group->get(), pub_key);
+      SslGetEcPointCoordinates(*group, pub_key);
   if (!pub_key_bns.ok()) {
     return pub_key_bns.status();
   }
 
-  const int kFieldElementSizeInBytes = SslEcFieldSizeInBytes(group->get());
+  const int kFieldElementSizeInBytes = SslEcFieldSizeInBytes(*group);
 
   util::StatusOr<std::string> pub_x_str =
       BignumToString(pub_key_bns->x.get(), kFieldElementSizeInBytes);
@@ -298,7 +317,7 @@ util::StatusOr<EcKey> EcKeyFromSslEcKey(EllipticCurveType curve,
     return pub_y_str.status();
   }
   util::StatusOr<util::SecretData> priv_key_data =
-      BignumToSecretData(priv_key, ScalarSizeInBytes(group->get()));
+      BignumToSecretData(priv_key, ScalarSizeInBytes(*group));
   if (!priv_key_data.ok()) {
     return priv_key_data.status();
   }
@@ -315,12 +334,12 @@ util::StatusOr<int32_t> EcFieldSizeInBytes(EllipticCurveType curve_type) {
   if (curve_type == EllipticCurveType::CURVE25519) {
     return 32;
   }
-  util::StatusOr<SslUniquePtr<EC_GROUP>> ec_group =
-      EcGroupFromCurveType(curve_type);
+  util::StatusOr<const EC_GROUP *> ec_group =
+      CachedEcGroupFromCurveType(curve_type);
   if (!ec_group.ok()) {
     return ec_group.status();
   }
-  return SslEcFieldSizeInBytes(ec_group->get());
+  return SslEcFieldSizeInBytes(*ec_group);
 }
 
 util::StatusOr<int32_t> EcPointEncodingSizeInBytes(EllipticCurveType curve_type,
@@ -360,8 +379,8 @@ util::StatusOr<EcKey> NewEcKey(EllipticCurveType curve_type) {
     }
     return EcKeyFromX25519Key(key->get());
   }
-  util::StatusOr<SslUniquePtr<EC_GROUP>> group =
-      EcGroupFromCurveType(curve_type);
+  util::StatusOr<const EC_GROUP *> group =
+      CachedEcGroupFromCurveType(curve_type);
   if (!group.ok()) {
     return group.status();
   }
@@ -370,7 +389,7 @@ util::StatusOr<EcKey> NewEcKey(EllipticCurveType curve_type) {
   if (key.get() == nullptr) {
     return util::Status(absl::StatusCode::kInternal, "EC_KEY_new failed");
   }
-  EC_KEY_set_group(key.get(), group->get());
+  EC_KEY_set_group(key.get(), *group);
   EC_KEY_generate_key(key.get());
   return EcKeyFromSslEcKey(curve_type, *key);
 }
@@ -399,13 +418,13 @@ util::StatusOr<EcKey> NewEcKey(EllipticCurveType curve_type,
         absl::StatusCode::kInternal,
         "Creating a X25519 key from a secret seed is not supported");
   }
-  util::StatusOr<SslUniquePtr<EC_GROUP>> group =
-      EcGroupFromCurveType(curve_type);
+  util::StatusOr<const EC_GROUP *> group =
+      CachedEcGroupFromCurveType(curve_type);
   if (!group.ok()) {
     return group.status();
   }
   SslUniquePtr<EC_KEY> key(EC_KEY_derive_from_secret(
-      group->get(), secret_seed.data(), secret_seed.size()));
+      *group, secret_seed.data(), secret_seed.size()));
   if (key.get() == nullptr) {
     return util::Status(absl::StatusCode::kInternal,
                         "EC_KEY_derive_from_secret failed");
@@ -554,28 +573,28 @@ util::StatusOr<std::unique_ptr<X25519Key>> X25519KeyFromPrivateKey(
 util::StatusOr<std::string> EcPointEncode(EllipticCurveType curve,
                                           EcPointFormat format,
                                           const EC_POINT *point) {
-  util::StatusOr<SslUniquePtr<EC_GROUP>> group = EcGroupFromCurveType(curve);
+  util::StatusOr<const EC_GROUP *> group = CachedEcGroupFromCurveType(curve);
   if (!group.ok()) {
     return group.status();
   }
-  if (EC_POINT_is_on_curve(group->get(), point, nullptr) != 1) {
+  if (EC_POINT_is_on_curve(*group, point, nullptr) != 1) {
     return util::Status(absl::StatusCode::kInternal, "Point is not on curve");
   }
   switch (format) {
     case EcPointFormat::UNCOMPRESSED: {
-      return SslEcPointEncode(group->get(), point,
+      return SslEcPointEncode(*group, point,
                               POINT_CONVERSION_UNCOMPRESSED);
     }
     case EcPointFormat::COMPRESSED: {
-      return SslEcPointEncode(group->get(), point, POINT_CONVERSION_COMPRESSED);
+      return SslEcPointEncode(*group, point, POINT_CONVERSION_COMPRESSED);
     }
     case EcPointFormat::DO_NOT_USE_CRUNCHY_UNCOMPRESSED: {
       util::StatusOr<EcPointCoordinates> ec_point_xy =
-          SslGetEcPointCoordinates(group->get(), point);
+          SslGetEcPointCoordinates(*group, point);
       if (!ec_point_xy.ok()) {
         return ec_point_xy.status();
       }
-      const int kCurveSizeInBytes = SslEcFieldSizeInBytes(group->get());
+      const int kCurveSizeInBytes = SslEcFieldSizeInBytes(*group);
       std::string encoded_point;
       subtle::ResizeStringUninitialized(&encoded_point, 2 * kCurveSizeInBytes);
       util::Status res = BignumToBinaryPadded(
@@ -610,12 +629,12 @@ util::StatusOr<SslUniquePtr<EC_POINT>> EcPointDecode(
     case EcPointFormat::COMPRESSED:
       return SslGetEcPointFromEncoded(curve, format, encoded);
     case EcPointFormat::DO_NOT_USE_CRUNCHY_UNCOMPRESSED: {
-      util::StatusOr<SslUniquePtr<EC_GROUP>> group =
-          EcGroupFromCurveType(curve);
+      util::StatusOr<const EC_GROUP *> group =
+          CachedEcGroupFromCurveType(curve);
       if (!group.ok()) {
         return group.status();
       }
-      const int kCurveSizeInBytes = SslEcFieldSizeInBytes(group->get());
+      const int kCurveSizeInBytes = SslEcFieldSizeInBytes(*group);
       if (encoded.size() != 2 * kCurveSizeInBytes) {
         return util::Status(
             absl::StatusCode::kInternal,
@@ -624,7 +643,7 @@ util::StatusOr<SslUniquePtr<EC_POINT>> EcPointDecode(
       }
       // SslGetEcPoint already checks if the point is on curve so we can return
       // directly.
-      return SslGetEcPointFromCoordinates(group->get(),
+      return SslGetEcPointFromCoordinates(*group,
                                           encoded.substr(0, kCurveSizeInBytes),
                                           encoded.substr(kCurveSizeInBytes));
     }
@@ -660,6 +679,39 @@ util::StatusOr<SslUniquePtr<EC_GROUP>> EcGroupFromCurveType(
   return {SslUniquePtr<EC_GROUP>(ec_group)};
 }
 
+util::StatusOr<const EC_GROUP *> CachedEcGroupFromCurveType(
+    EllipticCurveType curve_type) {
+  const EC_GROUP *ec_group = nullptr;
+  // Function-local statics are initialized exactly once, even when reached
+  // concurrently, and are intentionally never freed.
+  switch (curve_type) {
+    case EllipticCurveType::NIST_P256: {
+      static const EC_GROUP *const kGroup =
+          NewImmutableEcGroup(NID_X9_62_prime256v1);
+      ec_group = kGroup;
+      break;
+    }
+    case EllipticCurveType::NIST_P384: {
+      static const EC_GROUP *const kGroup = NewImmutableEcGroup(NID_secp384r1);
+      ec_group = kGroup;
+      break;
+    }
+    case EllipticCurveType::NIST_P521: {
+      static const EC_GROUP *const kGroup = NewImmutableEcGroup(NID_secp521r1);
+      ec_group = kGroup;
+      break;
+    }
+    default:
+      return util::Status(absl::StatusCode::kUnimplemented,
+                          "Unsupported elliptic curve");
+  }
+  if (ec_group == nullptr) {
+    return util::Status(absl::StatusCode::kInternal,
+                        "EC_GROUP_new_by_curve_name failed");
+  }
+  return ec_group;
+}
+
 util::StatusOr<EllipticCurveType> CurveTypeFromEcGroup(const EC_GROUP *group) {
   if (group == nullptr) {
     return util::Status(absl::StatusCode::kInvalidArgument,
@@ -681,21 +733,21 @@ util::StatusOr<EllipticCurveType> CurveTypeFromEcGroup(const EC_GROUP *group) {
 util::StatusOr<SslUniquePtr<EC_POINT>> GetEcPoint(EllipticCurveType curve,
                                                   absl::string_view pubx,
                                                   absl::string_view puby) {
-  util::StatusOr<SslUniquePtr<EC_GROUP>> group = EcGroupFromCurveType(curve);
+  util::StatusOr<const EC_GROUP *> group = CachedEcGroupFromCurveType(curve);
   if (!group.ok()) {
     return group.status();
   }
-  return SslGetEcPointFromCoordinates(group->get(), pubx, puby);
+  return SslGetEcPointFromCoordinates(*group, pubx, puby);
 }
 
 util::StatusOr<util::SecretData> ComputeEcdhSharedSecret(
     EllipticCurveType curve, const BIGNUM *priv_key, const EC_POINT *pub_key) {
-  util::StatusOr<internal::SslUniquePtr<EC_GROUP>> priv_group =
-      internal::EcGroupFromCurveType(curve);
+  util::StatusOr<const EC_GROUP *> priv_group =
+      CachedEcGroupFromCurveType(curve);
   if (!priv_group.ok()) {
     return priv_group.status();
   }
-  if (EC_POINT_is_on_curve(priv_group->get(), pub_key, /*ctx=*/nullptr) != 1) {
+  if (EC_POINT_is_on_curve(*priv_group, pub_key, /*ctx=*/nullptr) != 1) {
     return util::Status(absl::StatusCode::kInternal,
                         absl::StrCat("Public key is not on curve ",
                                      subtle::EnumToString(curve)));
@@ -703,13 +755,13 @@ util::StatusOr<util::SecretData> ComputeEcdhSharedSecret(
 
   // Compute the shared point and make sure it is on `curve`.
   internal::SslUniquePtr<EC_POINT> shared_point(
-      EC_POINT_new(priv_group->get()));
-  if (EC_POINT_mul(priv_group->get(), shared_point.get(), /*n=*/nullptr,
+      EC_POINT_new(*priv_group));
+  if (EC_POINT_mul(*priv_group, shared_point.get(), /*n=*/nullptr,
                    pub_key, priv_key, /*ctx=*/nullptr) != 1) {
     return util::Status(absl::StatusCode::kInternal,
                         "Point multiplication failed");
   }
-  if (EC_POINT_is_on_curve(priv_group->get(), shared_point.get(),
+  if (EC_POINT_is_on_curve(*priv_group, shared_point.get(),
                            /*ctx=*/nullptr) != 1) {
     return util::Status(absl::StatusCode::kInternal,
                         absl::StrCat("Shared point is not on curve ",
@@ -717,14 +769,14 @@ util::StatusOr<util::SecretData> ComputeEcdhSharedSecret(
   }
 
   util::StatusOr<EcPointCoordinates> shared_point_coordinates =
-      SslGetEcPointCoordinates(priv_group->get(), shared_point.get());
+      SslGetEcPointCoordinates(*priv_group, shared_point.get());
   if (!shared_point_coordinates.ok()) {
     return shared_point_coordinates.status();
   }
 
   // We need only the x coordinate.
   return internal::BignumToSecretData(shared_point_coordinates->x.get(),
-                                      SslEcFieldSizeInBytes(priv_group->get()));
+                                      SslEcFieldSizeInBytes(*priv_group));
 }
 
 util::StatusOr<std::string> EcSignatureIeeeToDer(const EC_GROUP *group,
@@ -144,6 +144,14 @@ util::StatusOr<int32_t> EcFieldSizeInBytes(
 crypto::tink::util::StatusOr<SslUniquePtr<EC_GROUP>> EcGroupFromCurveType(
     crypto::tink::subtle::EllipticCurveType curve_type);
 
+// Returns a process-wide EC_GROUP for the given `curve_type`. The group is
+// created once per curve, is owned by Tink and lives for the remainder of the
+// process; callers must neither modify nor free it. Unlike
+// EcGroupFromCurveType, this does not allocate and is safe to call on hot
+// paths from multiple threads.
+crypto::tink::util::StatusOr<const EC_GROUP *> CachedEcGroupFromCurveType(
+    crypto::tink::subtle::EllipticCurveType curve_type);
+
 // Returns the curve type associated with the given `group`.
 crypto::tink::util::StatusOr<crypto::tink::subtle::EllipticCurveType>
 CurveTypeFromEcGroup(const EC_GROUP *group);
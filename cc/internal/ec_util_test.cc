@@ -626,6 +626,32 @@ TEST(EcUtilTest, EcGroupFromCurveTypeUnimplemented) {
               StatusIs(absl::StatusCode::kUnimplemented));
 }
 
+TEST(EcUtilTest, CachedEcGroupFromCurveTypeMatchesEcGroupFromCurveType) {
+  for (EllipticCurveType curve :
+       {EllipticCurveType::NIST_P256, EllipticCurveType::NIST_P384,
+        EllipticCurveType::NIST_P521}) {
+    util::StatusOr<const EC_GROUP *> cached_group =
+        CachedEcGroupFromCurveType(curve);
+    ASSERT_THAT(cached_group, IsOk());
+    util::StatusOr<SslUniquePtr<EC_GROUP>> group = EcGroupFromCurveType(curve);
+    ASSERT_THAT(group, IsOk());
+    EXPECT_EQ(EC_GROUP_cmp(*cached_group, group->get(), /*ignored=*/nullptr),
+              0);
+    EXPECT_THAT(CurveTypeFromEcGroup(*cached_group), IsOkAndHolds(curve));
+    // The same instance is returned on every call.
+    EXPECT_THAT(CachedEcGroupFromCurveType(curve), IsOkAndHolds(*cached_group));
+  }
+}
+
+TEST(EcUtilTest, CachedEcGroupFromCurveTypeUnimplemented) {
+  EXPECT_THAT(
+      CachedEcGroupFromCurveType(EllipticCurveType::CURVE25519).status(),
+      StatusIs(absl::StatusCode::kUnimplemented));
+  EXPECT_THAT(
+      CachedEcGroupFromCurveType(EllipticCurveType::UNKNOWN_CURVE).status(),
+      StatusIs(absl::StatusCode::kUnimplemented));
+}
+
 TEST(EcUtilTest, GetEcPointReturnsAValidPoint) {
   SslUniquePtr<EC_GROUP> group(EC_GROUP_new_by_curve_name(NID_secp521r1));
   const unsigned int kCurveSizeInBytes =
@@ -0,0 +1,278 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/internal/flat_keyset.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "tink/util/secret_proto.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+
+using ::google::crypto::tink::KeyData;
+using ::google::crypto::tink::Keyset;
+using ::google::crypto::tink::KeyStatusType;
+using ::google::crypto::tink::OutputPrefixType;
+
+namespace {
+
+constexpr absl::string_view kMagic = "TINKFLAT";
+constexpr uint32_t kVersion = 1;
+
+constexpr size_t kHeaderSize = 32;
+constexpr size_t kKeyRecordSize = 32;
+constexpr size_t kTypeUrlRecordSize = 16;
+
+// Offsets of the sections of a flat keyset with the given number of keys and
+// type URLs.
+struct Layout {
+  Layout(uint64_t num_keys, uint64_t num_type_urls)
+      : key_records(kHeaderSize),
+        type_url_records(key_records + num_keys * kKeyRecordSize),
+        data(type_url_records + num_type_urls * kTypeUrlRecordSize) {}
+
+  static uint64_t Align(uint64_t offset) {
+    constexpr uint64_t kAlignment = FlatKeysetView::kFlatKeysetAlignment;
+    return (offset + kAlignment - 1) / kAlignment * kAlignment;
+  }
+
+  uint64_t key_records;
+  uint64_t type_url_records;
+  uint64_t data;
+};
+
+uint32_t LoadU32(absl::string_view data, uint64_t offset) {
+  const auto* p = reinterpret_cast<const uint8_t*>(data.data() + offset);
+  return static_cast<uint32_t>(p[0]) | static_cast<uint32_t>(p[1]) << 8 |
+         static_cast<uint32_t>(p[2]) << 16 | static_cast<uint32_t>(p[3]) << 24;
+}
+
+uint64_t LoadU64(absl::string_view data, uint64_t offset) {
+  return static_cast<uint64_t>(LoadU32(data, offset)) |
+         static_cast<uint64_t>(LoadU32(data, offset + 4)) << 32;
+}
+
+uint8_t LoadU8(absl::string_view data, uint64_t offset) {
+  return static_cast<uint8_t>(data[offset]);
+}
+
+void StoreU32(uint32_t value, uint64_t offset, std::string& out) {
+  for (int i = 0; i < 4; ++i) {
+    out[offset + i] = static_cast<char>(value >> (8 * i));
+  }
+}
+
+void StoreU64(uint64_t value, uint64_t offset, std::string& out) {
+  StoreU32(static_cast<uint32_t>(value), offset, out);
+  StoreU32(static_cast<uint32_t>(value >> 32), offset + 4, out);
+}
+
+util::Status InvalidFlatKeyset(absl::string_view reason) {
+  return util::Status(absl::StatusCode::kInvalidArgument,
+                      absl::StrCat("Invalid flat keyset: ", reason));
+}
+
+// Returns true if [offset, offset + size) lies within [begin, end).
+bool InRange(uint64_t offset, uint64_t size, uint64_t begin, uint64_t end) {
+  return offset >= begin && offset <= end && size <= end - offset;
+}
+
+bool IsAligned(uint64_t offset) {
+  return offset % FlatKeysetView::kFlatKeysetAlignment == 0;
+}
+
+}  // namespace
+
+util::StatusOr<FlatKeysetView> FlatKeysetView::Parse(absl::string_view data) {
+  if (data.size() < kHeaderSize) {
+    return InvalidFlatKeyset("too short");
+  }
+  if (data.substr(0, kMagic.size()) != kMagic) {
+    return InvalidFlatKeyset("wrong magic");
+  }
+  if (LoadU32(data, 8) != kVersion) {
+    return InvalidFlatKeyset("unsupported version");
+  }
+  const uint32_t num_keys = LoadU32(data, 12);
+  const uint32_t primary_key_id = LoadU32(data, 16);
+  const uint32_t num_type_urls = LoadU32(data, 20);
+  if (LoadU64(data, 24) != data.size()) {
+    return InvalidFlatKeyset("size mismatch");
+  }
+  if (num_type_urls > num_keys) {
+    return InvalidFlatKeyset("too many type URLs");
+  }
+  const Layout layout(num_keys, num_type_urls);
+  if (layout.data > data.size()) {
+    return InvalidFlatKeyset("truncated");
+  }
+
+  for (uint32_t i = 0; i < num_keys; ++i) {
+    const uint64_t record = layout.key_records + i * kKeyRecordSize;
+    if (LoadU32(data, record + 4) >= num_type_urls) {
+      return InvalidFlatKeyset("type URL index out of range");
+    }
+    if (!google::crypto::tink::KeyStatusType_IsValid(
+            LoadU8(data, record + 8)) ||
+        !google::crypto::tink::OutputPrefixType_IsValid(
+            LoadU8(data, record + 9)) ||
+        !KeyData::KeyMaterialType_IsValid(LoadU8(data, record + 10))) {
+      return InvalidFlatKeyset("invalid enum value");
+    }
+    const uint64_t value_offset = LoadU64(data, record + 16);
+    if (!InRange(value_offset, LoadU64(data, record + 24), layout.data,
+                 data.size())) {
+      return InvalidFlatKeyset("key value out of range");
+    }
+    if (!IsAligned(value_offset)) {
+      return InvalidFlatKeyset("unaligned key value");
+    }
+  }
+
+  for (uint32_t t = 0; t < num_type_urls; ++t) {
+    const uint64_t record = layout.type_url_records + t * kTypeUrlRecordSize;
+    const uint64_t type_url_offset = LoadU64(data, record);
+    if (!InRange(type_url_offset, LoadU64(data, record + 8), layout.data,
+                 data.size())) {
+      return InvalidFlatKeyset("type URL out of range");
+    }
+    if (!IsAligned(type_url_offset)) {
+      return InvalidFlatKeyset("unaligned type URL");
+    }
+  }
+
+  return FlatKeysetView(data, num_keys, primary_key_id, num_type_urls);
+}
+
+absl::string_view FlatKeysetView::TypeUrl(uint32_t type_url_index) const {
+  const uint64_t record = Layout(num_keys_, num_type_urls_).type_url_records +
+                          type_url_index * kTypeUrlRecordSize;
+  return data_.substr(LoadU64(data_, record), LoadU64(data_, record + 8));
+}
+
+FlatKeysetView::Key FlatKeysetView::key(int index) const {
+  const uint64_t record = Layout(num_keys_, num_type_urls_).key_records +
+                          static_cast<uint64_t>(index) * kKeyRecordSize;
+  Key key;
+  key.key_id = LoadU32(data_, record);
+  key.type_url = TypeUrl(LoadU32(data_, record + 4));
+  key.status = static_cast<KeyStatusType>(LoadU8(data_, record + 8));
+  key.output_prefix_type =
+      static_cast<OutputPrefixType>(LoadU8(data_, record + 9));
+  key.key_material_type =
+      static_cast<KeyData::KeyMaterialType>(LoadU8(data_, record + 10));
+  key.value = data_.substr(LoadU64(data_, record + 16),
+                           LoadU64(data_, record + 24));
+  return key;
+}
+
+util::SecretProto<Keyset> FlatKeysetView::ToKeyset() const {
+  util::SecretProto<Keyset> keyset;
+  keyset->set_primary_key_id(primary_key_id_);
+  keyset->mutable_key()->Reserve(num_keys_);
+  for (int i = 0; i < size(); ++i) {
+    const Key flat_key = key(i);
+    Keyset::Key* proto_key = keyset->add_key();
+    proto_key->set_key_id(flat_key.key_id);
+    proto_key->set_status(flat_key.status);
+    proto_key->set_output_prefix_type(flat_key.output_prefix_type);
+    KeyData* key_data = proto_key->mutable_key_data();
+    key_data->set_type_url(std::string(flat_key.type_url));
+    key_data->set_value(std::string(flat_key.value));
+    key_data->set_key_material_type(flat_key.key_material_type);
+  }
+  return keyset;
+}
+
+util::StatusOr<std::string> SerializeFlatKeyset(const Keyset& keyset) {
+  // Index of each distinct type URL in the type URL records.
+  std::map<absl::string_view, uint32_t> type_url_indices;
+  for (int i = 0; i < keyset.key_size(); ++i) {
+    const Keyset::Key& key = keyset.key(i);
+    if (!google::crypto::tink::KeyStatusType_IsValid(key.status()) ||
+        !google::crypto::tink::OutputPrefixType_IsValid(
+            key.output_prefix_type()) ||
+        !KeyData::KeyMaterialType_IsValid(
+            key.key_data().key_material_type())) {
+      return util::Status(absl::StatusCode::kInvalidArgument,
+                          "Keyset contains an invalid enum value.");
+    }
+    type_url_indices.emplace(key.key_data().type_url(), 0);
+  }
+
+  const uint64_t num_keys = keyset.key_size();
+  const uint64_t num_type_urls = type_url_indices.size();
+  const Layout layout(num_keys, num_type_urls);
+  uint64_t size = layout.data;
+  for (const auto& type_url_and_index : type_url_indices) {
+    size = Layout::Align(size + type_url_and_index.first.size());
+  }
+  for (const Keyset::Key& key : keyset.key()) {
+    size = Layout::Align(size + key.key_data().value().size());
+  }
+
+  std::string out(size, '\0');
+  out.replace(0, kMagic.size(), kMagic.data(), kMagic.size());
+  StoreU32(kVersion, 8, out);
+  StoreU32(num_keys, 12, out);
+  StoreU32(keyset.primary_key_id(), 16, out);
+  StoreU32(num_type_urls, 20, out);
+  StoreU64(size, 24, out);
+
+  uint64_t data_offset = layout.data;
+  auto append = [&](absl::string_view value) {
+    const uint64_t offset = data_offset;
+    out.replace(offset, value.size(), value.data(), value.size());
+    data_offset = Layout::Align(offset + value.size());
+    return offset;
+  };
+
+  uint32_t t = 0;
+  for (auto& type_url_and_index : type_url_indices) {
+    const uint64_t record = layout.type_url_records + t * kTypeUrlRecordSize;
+    StoreU64(append(type_url_and_index.first), record, out);
+    StoreU64(type_url_and_index.first.size(), record + 8, out);
+    type_url_and_index.second = t++;
+  }
+
+  for (uint32_t i = 0; i < num_keys; ++i) {
+    const Keyset::Key& key = keyset.key(i);
+    const uint64_t record = layout.key_records + i * kKeyRecordSize;
+    StoreU32(key.key_id(), record, out);
+    StoreU32(type_url_indices[key.key_data().type_url()], record + 4, out);
+    out[record + 8] = static_cast<char>(key.status());
+    out[record + 9] = static_cast<char>(key.output_prefix_type());
+    out[record + 10] = static_cast<char>(key.key_data().key_material_type());
+    StoreU64(append(key.key_data().value()), record + 16, out);
+    StoreU64(key.key_data().value().size(), record + 24, out);
+  }
+  return out;
+}
+
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,104 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_INTERNAL_FLAT_KEYSET_H_
+#define TINK_INTERNAL_FLAT_KEYSET_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "tink/util/secret_proto.h"
+#include "tink/util/statusor.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+
+// Read-only view of a keyset in the flat keyset format.
+//
+// The flat format stores a Keyset as fixed-size, offset-addressed records, so
+// that the keyset structure can be read without parsing a Keyset proto. All
+// integers are little-endian and all sections and variable-length fields
+// start at multiples of kFlatKeysetAlignment:
+//
+//   Header (32 bytes):
+//     char[8] magic ("TINKFLAT"), u32 version, u32 num_keys,
+//     u32 primary_key_id, u32 num_type_urls, u64 total_size
+//   Key records (num_keys x 32 bytes, in keyset order):
+//     u32 key_id, u32 type_url_index, u8 status, u8 output_prefix_type,
+//     u8 key_material_type, u8[5] reserved, u64 value_offset, u64 value_size
+//   Type URL records (num_type_urls x 16 bytes):
+//     u64 type_url_offset, u64 type_url_size
+//   Data: type URLs and key values.
+//
+// Parse() validates all offsets and sizes, so the accessors below never read
+// out of bounds. The view does not own `data`, which must outlive it.
+class FlatKeysetView {
+ public:
+  static constexpr size_t kFlatKeysetAlignment = 8;
+
+  struct Key {
+    uint32_t key_id;
+    google::crypto::tink::KeyStatusType status;
+    google::crypto::tink::OutputPrefixType output_prefix_type;
+    google::crypto::tink::KeyData::KeyMaterialType key_material_type;
+    absl::string_view type_url;
+    absl::string_view value;
+  };
+
+  // Validates `data` and returns a view of it.
+  static util::StatusOr<FlatKeysetView> Parse(absl::string_view data);
+
+  // Returns the underlying flat keyset.
+  absl::string_view data() const { return data_; }
+
+  int size() const { return num_keys_; }
+  uint32_t primary_key_id() const { return primary_key_id_; }
+
+  // Returns the key at `index`, which must be in [0, size()).
+  Key key(int index) const;
+
+  // Materializes the keyset as a Keyset proto.
+  util::SecretProto<google::crypto::tink::Keyset> ToKeyset() const;
+
+ private:
+  FlatKeysetView(absl::string_view data, uint32_t num_keys,
+                 uint32_t primary_key_id, uint32_t num_type_urls)
+      : data_(data),
+        num_keys_(num_keys),
+        primary_key_id_(primary_key_id),
+        num_type_urls_(num_type_urls) {}
+
+  absl::string_view TypeUrl(uint32_t type_url_index) const;
+
+  absl::string_view data_;
+  uint32_t num_keys_;
+  uint32_t primary_key_id_;
+  uint32_t num_type_urls_;
+};
+
+// Serializes `keyset` in the flat keyset format.
+util::StatusOr<std::string> SerializeFlatKeyset(
+    const google::crypto::tink::Keyset& keyset);
+
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_INTERNAL_FLAT_KEYSET_H_
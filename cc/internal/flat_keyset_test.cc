@@ -0,0 +1,208 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/internal/flat_keyset.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "tink/util/secret_proto.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::google::crypto::tink::KeyData;
+using ::google::crypto::tink::Keyset;
+using ::google::crypto::tink::KeyStatusType;
+using ::google::crypto::tink::OutputPrefixType;
+using ::testing::Eq;
+using ::testing::IsEmpty;
+using ::testing::Not;
+
+constexpr absl::string_view kMacTypeUrl =
+    "type.googleapis.com/google.crypto.tink.HmacKey";
+constexpr absl::string_view kVerifyTypeUrl =
+    "type.googleapis.com/google.crypto.tink.EcdsaPublicKey";
+
+void AddKey(uint32_t key_id, absl::string_view type_url,
+            absl::string_view value, KeyStatusType status,
+            OutputPrefixType output_prefix_type,
+            KeyData::KeyMaterialType key_material_type, Keyset& keyset) {
+  Keyset::Key* key = keyset.add_key();
+  key->set_key_id(key_id);
+  key->set_status(status);
+  key->set_output_prefix_type(output_prefix_type);
+  key->mutable_key_data()->set_type_url(std::string(type_url));
+  key->mutable_key_data()->set_value(std::string(value));
+  key->mutable_key_data()->set_key_material_type(key_material_type);
+}
+
+Keyset TestKeyset() {
+  Keyset keyset;
+  AddKey(42, kMacTypeUrl, "mac key 42", KeyStatusType::ENABLED,
+         OutputPrefixType::TINK, KeyData::SYMMETRIC, keyset);
+  AddKey(7, kVerifyTypeUrl, "public key 7", KeyStatusType::DISABLED,
+         OutputPrefixType::LEGACY, KeyData::ASYMMETRIC_PUBLIC, keyset);
+  AddKey(1000, kMacTypeUrl, "", KeyStatusType::ENABLED, OutputPrefixType::RAW,
+         KeyData::SYMMETRIC, keyset);
+  AddKey(7, kVerifyTypeUrl, "another public key 7", KeyStatusType::ENABLED,
+         OutputPrefixType::CRUNCHY, KeyData::ASYMMETRIC_PUBLIC, keyset);
+  keyset.set_primary_key_id(42);
+  return keyset;
+}
+
+TEST(FlatKeysetTest, RoundTrip) {
+  Keyset keyset = TestKeyset();
+  util::StatusOr<std::string> flat = SerializeFlatKeyset(keyset);
+  ASSERT_THAT(flat, IsOk());
+  EXPECT_EQ(flat->size() % FlatKeysetView::kFlatKeysetAlignment, 0);
+
+  util::StatusOr<FlatKeysetView> view = FlatKeysetView::Parse(*flat);
+  ASSERT_THAT(view, IsOk());
+  ASSERT_EQ(view->size(), keyset.key_size());
+  EXPECT_EQ(view->primary_key_id(), 42);
+  for (int i = 0; i < keyset.key_size(); ++i) {
+    const Keyset::Key& expected = keyset.key(i);
+    FlatKeysetView::Key key = view->key(i);
+    EXPECT_EQ(key.key_id, expected.key_id());
+    EXPECT_EQ(key.status, expected.status());
+    EXPECT_EQ(key.output_prefix_type, expected.output_prefix_type());
+    EXPECT_EQ(key.key_material_type, expected.key_data().key_material_type());
+    EXPECT_EQ(key.type_url, expected.key_data().type_url());
+    EXPECT_EQ(key.value, expected.key_data().value());
+  }
+  EXPECT_EQ(view->ToKeyset()->SerializeAsString(), keyset.SerializeAsString());
+}
+
+TEST(FlatKeysetTest, EmptyKeyset) {
+  util::StatusOr<std::string> flat = SerializeFlatKeyset(Keyset());
+  ASSERT_THAT(flat, IsOk());
+  util::StatusOr<FlatKeysetView> view = FlatKeysetView::Parse(*flat);
+  ASSERT_THAT(view, IsOk());
+  EXPECT_EQ(view->size(), 0);
+  EXPECT_THAT(view->ToKeyset()->key(), IsEmpty());
+}
+
+TEST(FlatKeysetTest, ParseUnalignedInput) {
+  util::StatusOr<std::string> flat = SerializeFlatKeyset(TestKeyset());
+  ASSERT_THAT(flat, IsOk());
+  std::string shifted = absl::StrCat("x", *flat);
+  util::StatusOr<FlatKeysetView> view =
+      FlatKeysetView::Parse(absl::string_view(shifted).substr(1));
+  ASSERT_THAT(view, IsOk());
+  EXPECT_EQ(view->key(3).value, "another public key 7");
+}
+
+TEST(FlatKeysetTest, ParseFailsOnUnalignedKeyValue) {
+  util::StatusOr<std::string> flat = SerializeFlatKeyset(TestKeyset());
+  ASSERT_THAT(flat, IsOk());
+  // Moves the value of the first key, whose offset is a multiple of the
+  // alignment, by one byte. The value still lies within the input.
+  constexpr size_t kFirstValueOffset = 32 + 16;
+  (*flat)[kFirstValueOffset] += 1;
+  EXPECT_THAT(FlatKeysetView::Parse(*flat).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(FlatKeysetTest, ParseFailsOnUnalignedTypeUrl) {
+  util::StatusOr<std::string> flat = SerializeFlatKeyset(TestKeyset());
+  ASSERT_THAT(flat, IsOk());
+  // The type URL records follow the header and the 4 key records.
+  constexpr size_t kFirstTypeUrlOffset = 32 + 4 * 32;
+  (*flat)[kFirstTypeUrlOffset] += 1;
+  EXPECT_THAT(FlatKeysetView::Parse(*flat).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(FlatKeysetTest, InvalidEnumValueFails) {
+  Keyset keyset = TestKeyset();
+  keyset.mutable_key(0)->set_status(static_cast<KeyStatusType>(300));
+  EXPECT_THAT(SerializeFlatKeyset(keyset).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(FlatKeysetTest, ParseFailsOnTruncatedInput) {
+  util::StatusOr<std::string> flat = SerializeFlatKeyset(TestKeyset());
+  ASSERT_THAT(flat, IsOk());
+  for (size_t size = 0; size < flat->size(); ++size) {
+    EXPECT_THAT(FlatKeysetView::Parse(absl::string_view(*flat).substr(0, size))
+                    .status(),
+                StatusIs(absl::StatusCode::kInvalidArgument));
+  }
+}
+
+TEST(FlatKeysetTest, ParseFailsOnWrongMagic) {
+  util::StatusOr<std::string> flat = SerializeFlatKeyset(TestKeyset());
+  ASSERT_THAT(flat, IsOk());
+  (*flat)[0] ^= 1;
+  EXPECT_THAT(FlatKeysetView::Parse(*flat).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+// Corrupting any byte of the metadata must either be detected or still yield
+// a view whose accessors stay within the input.
+TEST(FlatKeysetTest, CorruptedMetadataIsSafe) {
+  util::StatusOr<std::string> flat = SerializeFlatKeyset(TestKeyset());
+  ASSERT_THAT(flat, IsOk());
+  util::StatusOr<FlatKeysetView> original = FlatKeysetView::Parse(*flat);
+  ASSERT_THAT(original, IsOk());
+  // The data section starts with the type URLs.
+  const size_t metadata_size = std::min(original->key(0).type_url.data(),
+                                        original->key(1).type_url.data()) -
+                               flat->data();
+  for (size_t i = 0; i < metadata_size; ++i) {
+    for (uint8_t flip : {0x01, 0x80, 0xff}) {
+      std::string corrupted = *flat;
+      corrupted[i] ^= flip;
+      util::StatusOr<FlatKeysetView> view = FlatKeysetView::Parse(corrupted);
+      if (!view.ok()) continue;
+      for (int k = 0; k < view->size(); ++k) {
+        FlatKeysetView::Key key = view->key(k);
+        EXPECT_GE(key.value.data(), corrupted.data());
+        EXPECT_LE(key.value.data() + key.value.size(),
+                  corrupted.data() + corrupted.size());
+        EXPECT_GE(key.type_url.data(), corrupted.data());
+        EXPECT_LE(key.type_url.data() + key.type_url.size(),
+                  corrupted.data() + corrupted.size());
+      }
+      EXPECT_THAT(view->ToKeyset()->key_size(), Eq(view->size()));
+    }
+  }
+}
+
+TEST(FlatKeysetTest, ParseFailsOnSizeMismatch) {
+  util::StatusOr<std::string> flat = SerializeFlatKeyset(TestKeyset());
+  ASSERT_THAT(flat, IsOk());
+  EXPECT_THAT(FlatKeysetView::Parse(absl::StrCat(*flat, "padding")),
+              Not(IsOk()));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,143 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/internal/fragments.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/internal/util.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+
+namespace {
+
+template <typename Fragment>
+int64_t TotalSize(absl::Span<const Fragment> fragments) {
+  int64_t size = 0;
+  for (const Fragment& fragment : fragments) {
+    size += fragment.size();
+  }
+  return size;
+}
+
+template <typename Fragment>
+std::vector<Fragment> Slice(absl::Span<const Fragment> fragments,
+                            int64_t offset, int64_t size) {
+  std::vector<Fragment> result;
+  for (const Fragment& fragment : fragments) {
+    if (size <= 0) break;
+    const int64_t fragment_size = fragment.size();
+    if (offset >= fragment_size) {
+      offset -= fragment_size;
+      continue;
+    }
+    const int64_t length = std::min(fragment_size - offset, size);
+    result.push_back(Fragment(fragment.data() + offset, length));
+    size -= length;
+    offset = 0;
+  }
+  return result;
+}
+
+}  // namespace
+
+int64_t FragmentsSize(absl::Span<const absl::string_view> fragments) {
+  return TotalSize(fragments);
+}
+
+int64_t FragmentsSize(absl::Span<const absl::Span<char>> fragments) {
+  return TotalSize(fragments);
+}
+
+std::vector<absl::string_view> SubFragments(
+    absl::Span<const absl::string_view> fragments, int64_t offset,
+    int64_t size) {
+  return Slice(fragments, offset, size);
+}
+
+std::vector<absl::Span<char>> SubFragments(
+    absl::Span<const absl::Span<char>> fragments, int64_t offset,
+    int64_t size) {
+  return Slice(fragments, offset, size);
+}
+
+void CopyFromFragments(absl::Span<const absl::string_view> fragments,
+                       absl::Span<char> out) {
+  for (absl::string_view fragment : fragments) {
+    if (out.empty()) return;
+    const size_t length = std::min(fragment.size(), out.size());
+    if (length > 0) std::memcpy(out.data(), fragment.data(), length);
+    out.remove_prefix(length);
+  }
+}
+
+void CopyToFragments(absl::string_view data,
+                     absl::Span<const absl::Span<char>> fragments) {
+  for (absl::Span<char> fragment : fragments) {
+    if (data.empty()) return;
+    const size_t length = std::min(fragment.size(), data.size());
+    if (length > 0) std::memcpy(fragment.data(), data.data(), length);
+    data.remove_prefix(length);
+  }
+}
+
+bool FragmentsOverlap(absl::Span<const absl::string_view> first,
+                      absl::Span<const absl::Span<char>> second) {
+  // Output fragments usually come from one buffer, so fragments of `first`
+  // outside of the range spanned by `second` are ruled out without comparing
+  // them to each fragment of `second`.
+  const char* second_begin = nullptr;
+  const char* second_end = nullptr;
+  for (absl::Span<char> fragment : second) {
+    if (fragment.empty()) continue;
+    if (second_begin == nullptr ||
+        std::less<const char*>{}(fragment.data(), second_begin)) {
+      second_begin = fragment.data();
+    }
+    const char* fragment_end = fragment.data() + fragment.size();
+    if (second_end == nullptr ||
+        std::less<const char*>{}(second_end, fragment_end)) {
+      second_end = fragment_end;
+    }
+  }
+  if (second_begin == nullptr) return false;
+  const absl::string_view second_range(
+      second_begin, reinterpret_cast<uintptr_t>(second_end) -
+                        reinterpret_cast<uintptr_t>(second_begin));
+  for (absl::string_view other : first) {
+    if (!BuffersOverlap(other, second_range)) continue;
+    for (absl::Span<char> fragment : second) {
+      if (BuffersOverlap(other,
+                         absl::string_view(fragment.data(), fragment.size()))) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
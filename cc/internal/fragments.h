@@ -0,0 +1,69 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef TINK_INTERNAL_FRAGMENTS_H_
+#define TINK_INTERNAL_FRAGMENTS_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+
+// Helpers for messages that are held as a list of fragments, e.g., the
+// buffers of an iovec or the chunks of an absl::Cord, instead of one
+// contiguous buffer. A list of fragments stands for the concatenation of its
+// fragments.
+
+// Returns the total size of `fragments`.
+int64_t FragmentsSize(absl::Span<const absl::string_view> fragments);
+int64_t FragmentsSize(absl::Span<const absl::Span<char>> fragments);
+
+// Returns the fragments that hold the bytes [`offset`, `offset` + `size`) of
+// `fragments`, without empty fragments. If `fragments` are shorter than that,
+// the result ends where `fragments` end.
+std::vector<absl::string_view> SubFragments(
+    absl::Span<const absl::string_view> fragments, int64_t offset,
+    int64_t size);
+std::vector<absl::Span<char>> SubFragments(
+    absl::Span<const absl::Span<char>> fragments, int64_t offset,
+    int64_t size);
+
+// Copies the first `out.size()` bytes of `fragments` to `out`, or all of
+// `fragments` if they are shorter.
+void CopyFromFragments(absl::Span<const absl::string_view> fragments,
+                       absl::Span<char> out);
+
+// Copies `data` to the first `data.size()` bytes of `fragments`, or only as
+// much of it as `fragments` can hold.
+void CopyToFragments(absl::string_view data,
+                     absl::Span<const absl::Span<char>> fragments);
+
+// Returns true if any fragment of `first` overlaps with any fragment of
+// `second`.
+bool FragmentsOverlap(absl::Span<const absl::string_view> first,
+                      absl::Span<const absl::Span<char>> second);
+
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_INTERNAL_FRAGMENTS_H_
@@ -0,0 +1,116 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/internal/fragments.h"
+
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+std::string Join(const std::vector<absl::string_view>& fragments) {
+  std::string result;
+  for (absl::string_view fragment : fragments) {
+    result.append(fragment.data(), fragment.size());
+  }
+  return result;
+}
+
+TEST(FragmentsTest, FragmentsSize) {
+  std::vector<absl::string_view> fragments = {"abc", "", "de", "f"};
+  EXPECT_EQ(FragmentsSize(fragments), 6);
+  EXPECT_EQ(FragmentsSize(std::vector<absl::string_view>()), 0);
+
+  std::string buffer(10, 'x');
+  std::vector<absl::Span<char>> out = {absl::MakeSpan(buffer).subspan(0, 3),
+                                       absl::MakeSpan(buffer).subspan(5, 5)};
+  EXPECT_EQ(FragmentsSize(out), 8);
+}
+
+TEST(FragmentsTest, SubFragments) {
+  std::vector<absl::string_view> fragments = {"abc", "", "de", "fgh"};
+  EXPECT_THAT(SubFragments(fragments, 0, 8),
+              ElementsAre("abc", "de", "fgh"));
+  EXPECT_THAT(SubFragments(fragments, 1, 3), ElementsAre("bc", "d"));
+  EXPECT_THAT(SubFragments(fragments, 3, 2), ElementsAre("de"));
+  EXPECT_THAT(SubFragments(fragments, 4, 100), ElementsAre("e", "fgh"));
+  EXPECT_THAT(SubFragments(fragments, 8, 1), IsEmpty());
+  EXPECT_THAT(SubFragments(fragments, 2, 0), IsEmpty());
+}
+
+TEST(FragmentsTest, SubFragmentsOfOutput) {
+  std::string buffer = "0123456789";
+  std::vector<absl::Span<char>> fragments = {
+      absl::MakeSpan(buffer).subspan(0, 4),
+      absl::MakeSpan(buffer).subspan(6, 4)};
+  std::vector<absl::Span<char>> sub = SubFragments(fragments, 2, 4);
+  ASSERT_EQ(sub.size(), 2);
+  EXPECT_EQ(absl::string_view(sub[0].data(), sub[0].size()), "23");
+  EXPECT_EQ(absl::string_view(sub[1].data(), sub[1].size()), "67");
+}
+
+TEST(FragmentsTest, CopyFromFragments) {
+  std::vector<absl::string_view> fragments = {"abc", "", "de", "fgh"};
+  for (int size = 0; size <= 8; ++size) {
+    std::string out(size, 'x');
+    CopyFromFragments(fragments, absl::MakeSpan(out));
+    EXPECT_EQ(out, Join(fragments).substr(0, size));
+  }
+  std::string out(10, 'x');
+  CopyFromFragments(fragments, absl::MakeSpan(out));
+  EXPECT_EQ(out, "abcdefghxx");
+}
+
+TEST(FragmentsTest, CopyToFragments) {
+  std::string buffer(10, 'x');
+  std::vector<absl::Span<char>> fragments = {
+      absl::MakeSpan(buffer).subspan(0, 3),
+      absl::MakeSpan(buffer).subspan(3, 0),
+      absl::MakeSpan(buffer).subspan(5, 5)};
+  CopyToFragments("abcde", fragments);
+  EXPECT_EQ(buffer, "abcxxdexxx");
+  CopyToFragments("0123456789", fragments);
+  EXPECT_EQ(buffer, "012xx34567");
+}
+
+TEST(FragmentsTest, FragmentsOverlap) {
+  std::string buffer = "0123456789";
+  absl::string_view view = buffer;
+  std::vector<absl::Span<char>> out = {absl::MakeSpan(buffer).subspan(4, 2),
+                                       absl::MakeSpan(buffer).subspan(8, 2)};
+  EXPECT_FALSE(FragmentsOverlap({view.substr(0, 4), view.substr(6, 2)}, out));
+  EXPECT_TRUE(FragmentsOverlap({view.substr(0, 4), view.substr(9, 1)}, out));
+  EXPECT_TRUE(FragmentsOverlap({view.substr(3, 2)}, out));
+  EXPECT_FALSE(FragmentsOverlap({"other"}, out));
+  EXPECT_FALSE(FragmentsOverlap({view}, {}));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
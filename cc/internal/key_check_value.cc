@@ -0,0 +1,69 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/internal/key_check_value.h"
+
+#include <string>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/hkdf.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+namespace {
+
+constexpr absl::string_view kInfo = "Tink key check value";
+
+}  // namespace
+
+util::Status ValidateKeyCheckValueSize(int size_in_bytes) {
+  if (size_in_bytes >= kMinKeyCheckValueSizeInBytes &&
+      size_in_bytes <= kMaxKeyCheckValueSizeInBytes) {
+    return util::OkStatus();
+  }
+  return util::Status(
+      absl::StatusCode::kInvalidArgument,
+      absl::StrCat("Key check value size should be between ",
+                   kMinKeyCheckValueSizeInBytes, " and ",
+                   kMaxKeyCheckValueSizeInBytes, " bytes, got ",
+                   size_in_bytes, " bytes."));
+}
+
+util::StatusOr<std::string> ComputeKeyCheckValue(const util::SecretData& key,
+                                                 int size_in_bytes) {
+  util::Status status = ValidateKeyCheckValueSize(size_in_bytes);
+  if (!status.ok()) {
+    return status;
+  }
+  util::StatusOr<util::SecretData> key_check_value =
+      subtle::Hkdf::ComputeHkdf(subtle::HashType::SHA256, key, /*salt=*/"",
+                                kInfo, size_in_bytes);
+  if (!key_check_value.ok()) {
+    return key_check_value.status();
+  }
+  return std::string(util::SecretDataAsStringView(*key_check_value));
+}
+
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,58 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_INTERNAL_KEY_CHECK_VALUE_H_
+#define TINK_INTERNAL_KEY_CHECK_VALUE_H_
+
+#include <string>
+
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+
+// A key check value (KCV) is a short string derived from a symmetric key that
+// is stored in front of a ciphertext. A decrypter holding a different key can
+// then reject the ciphertext by comparing a few bytes, without processing the
+// payload. This matters when a keyset contains several keys without output
+// prefix, which are otherwise tried one full decryption at a time.
+//
+// The KCV is derived from the key with HKDF-SHA256, using an empty salt and a
+// fixed info string. The key is thus only used as HKDF input key material and
+// never directly as a key of another algorithm, and the KCV reveals nothing
+// about the key besides allowing equality checks. It is not a replacement for
+// authentication: a matching KCV only selects the key to try.
+
+// Smallest and largest supported KCV sizes.
+constexpr int kMinKeyCheckValueSizeInBytes = 4;
+constexpr int kMaxKeyCheckValueSizeInBytes = 16;
+
+// Returns OK if `size_in_bytes` is between kMinKeyCheckValueSizeInBytes and
+// kMaxKeyCheckValueSizeInBytes.
+util::Status ValidateKeyCheckValueSize(int size_in_bytes);
+
+// Computes the `size_in_bytes` long KCV of `key`.
+util::StatusOr<std::string> ComputeKeyCheckValue(const util::SecretData& key,
+                                                 int size_in_bytes);
+
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_INTERNAL_KEY_CHECK_VALUE_H_
@@ -0,0 +1,95 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/internal/key_check_value.h"
+
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/status/status.h"
+#include "absl/strings/escaping.h"
+#include "tink/subtle/random.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::testing::Eq;
+using ::testing::Not;
+using ::testing::SizeIs;
+using ::testing::StartsWith;
+
+TEST(KeyCheckValueTest, ValidateKeyCheckValueSize) {
+  for (int size = kMinKeyCheckValueSizeInBytes;
+       size <= kMaxKeyCheckValueSizeInBytes; ++size) {
+    EXPECT_THAT(ValidateKeyCheckValueSize(size), IsOk());
+  }
+  for (int size : {-1, 0, 1, kMinKeyCheckValueSizeInBytes - 1,
+                   kMaxKeyCheckValueSizeInBytes + 1}) {
+    EXPECT_THAT(ValidateKeyCheckValueSize(size),
+                StatusIs(absl::StatusCode::kInvalidArgument));
+  }
+}
+
+TEST(KeyCheckValueTest, TestVector) {
+  // HKDF-SHA256(ikm = 0x00 * 16, salt = "", info = "Tink key check value").
+  util::SecretData key(16, 0);
+  util::StatusOr<std::string> kcv = ComputeKeyCheckValue(key, 16);
+  ASSERT_THAT(kcv, IsOk());
+  EXPECT_THAT(absl::BytesToHexString(*kcv),
+              Eq("be367ad9b72b4f4880cf60cc63896408"));
+}
+
+TEST(KeyCheckValueTest, TruncatesToRequestedSize) {
+  util::SecretData key =
+      util::SecretDataFromStringView(subtle::Random::GetRandomBytes(32));
+  util::StatusOr<std::string> full =
+      ComputeKeyCheckValue(key, kMaxKeyCheckValueSizeInBytes);
+  ASSERT_THAT(full, IsOk());
+  for (int size = kMinKeyCheckValueSizeInBytes;
+       size <= kMaxKeyCheckValueSizeInBytes; ++size) {
+    util::StatusOr<std::string> kcv = ComputeKeyCheckValue(key, size);
+    ASSERT_THAT(kcv, IsOk());
+    EXPECT_THAT(*kcv, SizeIs(size));
+    EXPECT_THAT(*full, StartsWith(*kcv));
+  }
+  EXPECT_THAT(ComputeKeyCheckValue(key, 0).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(ComputeKeyCheckValue(key, 2).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(KeyCheckValueTest, DifferentKeysHaveDifferentKeyCheckValues) {
+  util::StatusOr<std::string> kcv1 = ComputeKeyCheckValue(
+      util::SecretDataFromStringView(subtle::Random::GetRandomBytes(32)), 16);
+  util::StatusOr<std::string> kcv2 = ComputeKeyCheckValue(
+      util::SecretDataFromStringView(subtle::Random::GetRandomBytes(32)), 16);
+  ASSERT_THAT(kcv1, IsOk());
+  ASSERT_THAT(kcv2, IsOk());
+  EXPECT_THAT(*kcv1, Not(Eq(*kcv2)));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
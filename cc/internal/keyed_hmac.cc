@@ -0,0 +1,116 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/internal/keyed_hmac.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "openssl/evp.h"
+#include "openssl/hmac.h"
+#include "tink/internal/ssl_unique_ptr.h"
+#include "tink/internal/util.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+namespace {
+
+// Continues the HMAC computation in `context` over `inputs` and writes the
+// tag to `out`.
+util::Status UpdateAndFinalize(HMAC_CTX* context,
+                               absl::Span<const absl::string_view> inputs,
+                               absl::Span<uint8_t> out) {
+  for (absl::string_view input : inputs) {
+    // BoringSSL expects a non-null pointer for data, regardless of whether
+    // the size is 0.
+    input = EnsureStringNonNull(input);
+    if (HMAC_Update(context, reinterpret_cast<const uint8_t*>(input.data()),
+                    input.size()) != 1) {
+      return util::Status(absl::StatusCode::kInternal, "HMAC_Update failed");
+    }
+  }
+  unsigned int len = 0;
+  if (HMAC_Final(context, out.data(), &len) != 1 || len != out.size()) {
+    return util::Status(absl::StatusCode::kInternal, "HMAC_Final failed");
+  }
+  return util::OkStatus();
+}
+
+}  // namespace
+
+util::StatusOr<std::unique_ptr<KeyedHmac>> KeyedHmac::New(
+    const EVP_MD* md, absl::string_view key) {
+  if (md == nullptr) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "Hash function must not be null");
+  }
+  SslUniquePtr<HMAC_CTX> context(HMAC_CTX_new());
+  if (context == nullptr) {
+    return util::Status(absl::StatusCode::kInternal, "HMAC_CTX_new failed");
+  }
+  key = EnsureStringNonNull(key);
+  if (HMAC_Init_ex(context.get(), key.data(), key.size(), md,
+                   /*impl=*/nullptr) != 1) {
+    return util::Status(absl::StatusCode::kInternal,
+                        "HMAC initialization failed");
+  }
+  return absl::WrapUnique(
+      new KeyedHmac(std::move(context), static_cast<size_t>(EVP_MD_size(md))));
+}
+
+util::Status KeyedHmac::Compute(absl::Span<const absl::string_view> inputs,
+                                absl::Span<uint8_t> out) const {
+  if (out.size() != tag_size_) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        absl::StrCat("Invalid output size; expected ",
+                                     tag_size_, " got ", out.size()));
+  }
+#ifdef OPENSSL_IS_BORINGSSL
+  HMAC_CTX context;
+  HMAC_CTX_init(&context);
+  util::Status status;
+  if (HMAC_CTX_copy_ex(&context, keyed_context_.get()) != 1) {
+    status = util::Status(absl::StatusCode::kInternal, "HMAC_CTX_copy failed");
+  } else {
+    status = UpdateAndFinalize(&context, inputs, out);
+  }
+  HMAC_CTX_cleanup(&context);
+  return status;
+#else
+  // OpenSSL does not allow HMAC_CTX on the stack.
+  SslUniquePtr<HMAC_CTX> context(HMAC_CTX_new());
+  if (context == nullptr ||
+      HMAC_CTX_copy(context.get(), keyed_context_.get()) != 1) {
+    return util::Status(absl::StatusCode::kInternal, "HMAC_CTX_copy failed");
+  }
+  return UpdateAndFinalize(context.get(), inputs, out);
+#endif
+}
+
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,74 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef TINK_INTERNAL_KEYED_HMAC_H_
+#define TINK_INTERNAL_KEYED_HMAC_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "openssl/evp.h"
+#include "openssl/hmac.h"
+#include "tink/internal/ssl_unique_ptr.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+
+// HMAC with a fixed key, for callers that compute many tags with one key.
+//
+// Keying HMAC hashes the inner and outer padded keys, which for short
+// messages costs as much as hashing the message itself. This class keys an
+// HMAC_CTX once and starts every computation from a copy of it. With
+// BoringSSL the copy lives on the stack, so Compute() performs no heap
+// allocation.
+//
+// This class is thread-safe.
+class KeyedHmac {
+ public:
+  // Creates a new instance computing HMAC with hash function `md` and `key`.
+  static util::StatusOr<std::unique_ptr<KeyedHmac>> New(const EVP_MD* md,
+                                                        absl::string_view key);
+
+  // Size of the (untruncated) HMAC tag.
+  size_t tag_size() const { return tag_size_; }
+
+  // Computes the HMAC tag of the concatenation of `inputs` and writes it to
+  // `out`, which must have size exactly tag_size().
+  util::Status Compute(absl::Span<const absl::string_view> inputs,
+                       absl::Span<uint8_t> out) const;
+
+ private:
+  KeyedHmac(SslUniquePtr<HMAC_CTX> keyed_context, size_t tag_size)
+      : keyed_context_(std::move(keyed_context)), tag_size_(tag_size) {}
+
+  // Context right after HMAC_Init_ex; never updated after construction.
+  const SslUniquePtr<HMAC_CTX> keyed_context_;
+  const size_t tag_size_;
+};
+
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_INTERNAL_KEYED_HMAC_H_
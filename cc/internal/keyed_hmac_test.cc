@@ -0,0 +1,119 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/internal/keyed_hmac.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "openssl/evp.h"
+#include "openssl/hmac.h"
+#include "tink/subtle/random.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+
+std::string ReferenceHmac(const EVP_MD* md, absl::string_view key,
+                          absl::string_view data) {
+  uint8_t tag[EVP_MAX_MD_SIZE];
+  unsigned int len = 0;
+  EXPECT_NE(HMAC(md, key.data(), key.size(),
+                 reinterpret_cast<const uint8_t*>(data.data()), data.size(),
+                 tag, &len),
+            nullptr);
+  return std::string(reinterpret_cast<const char*>(tag), len);
+}
+
+TEST(KeyedHmacTest, MatchesOneShotHmac) {
+  for (const EVP_MD* md : {EVP_sha1(), EVP_sha256(), EVP_sha512()}) {
+    std::string key = subtle::Random::GetRandomBytes(32);
+    util::StatusOr<std::unique_ptr<KeyedHmac>> hmac = KeyedHmac::New(md, key);
+    ASSERT_THAT(hmac, IsOk());
+    ASSERT_EQ((*hmac)->tag_size(), EVP_MD_size(md));
+    // Computing several tags checks that the keyed state is not modified.
+    for (int size : {0, 1, 64, 200}) {
+      std::string message = subtle::Random::GetRandomBytes(size);
+      std::vector<uint8_t> tag((*hmac)->tag_size());
+      absl::string_view input = message;
+      ASSERT_THAT((*hmac)->Compute(absl::MakeConstSpan(&input, 1),
+                                   absl::MakeSpan(tag)),
+                  IsOk());
+      EXPECT_EQ(std::string(tag.begin(), tag.end()),
+                ReferenceHmac(md, key, message));
+    }
+  }
+}
+
+TEST(KeyedHmacTest, ComputesHmacOfConcatenation) {
+  std::string key = subtle::Random::GetRandomBytes(32);
+  util::StatusOr<std::unique_ptr<KeyedHmac>> hmac =
+      KeyedHmac::New(EVP_sha256(), key);
+  ASSERT_THAT(hmac, IsOk());
+  std::vector<absl::string_view> inputs = {"first", "", "second", "third"};
+  std::vector<uint8_t> tag((*hmac)->tag_size());
+  ASSERT_THAT((*hmac)->Compute(inputs, absl::MakeSpan(tag)), IsOk());
+  EXPECT_EQ(std::string(tag.begin(), tag.end()),
+            ReferenceHmac(EVP_sha256(), key, "firstsecondthird"));
+}
+
+TEST(KeyedHmacTest, EmptyKey) {
+  util::StatusOr<std::unique_ptr<KeyedHmac>> hmac =
+      KeyedHmac::New(EVP_sha256(), "");
+  ASSERT_THAT(hmac, IsOk());
+  std::vector<uint8_t> tag((*hmac)->tag_size());
+  absl::string_view input = "input";
+  ASSERT_THAT(
+      (*hmac)->Compute(absl::MakeConstSpan(&input, 1), absl::MakeSpan(tag)),
+      IsOk());
+  EXPECT_EQ(std::string(tag.begin(), tag.end()),
+            ReferenceHmac(EVP_sha256(), "", "input"));
+}
+
+TEST(KeyedHmacTest, InvalidOutputSize) {
+  util::StatusOr<std::unique_ptr<KeyedHmac>> hmac =
+      KeyedHmac::New(EVP_sha256(), subtle::Random::GetRandomBytes(32));
+  ASSERT_THAT(hmac, IsOk());
+  std::vector<uint8_t> tag((*hmac)->tag_size() - 1);
+  absl::string_view input = "input";
+  EXPECT_THAT(
+      (*hmac)->Compute(absl::MakeConstSpan(&input, 1), absl::MakeSpan(tag)),
+      StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(KeyedHmacTest, NullHash) {
+  EXPECT_THAT(KeyedHmac::New(nullptr, "key").status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
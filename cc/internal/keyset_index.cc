@@ -0,0 +1,63 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+#include "tink/internal/keyset_index.h"
+
+#include <cstdint>
+
+#include "absl/container/flat_hash_set.h"
+#include "tink/subtle/random.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+
+using ::google::crypto::tink::Keyset;
+
+void KeysetIndex::Rebuild(const Keyset& keyset) {
+  positions_.clear();
+  positions_.reserve(keyset.key_size());
+  for (int i = 0; i < keyset.key_size(); ++i) {
+    // emplace() keeps the first position of duplicated IDs.
+    positions_.emplace(keyset.key(i).key_id(), i);
+  }
+}
+
+uint32_t KeysetIndex::GenerateUnusedKeyId() const {
+  uint32_t key_id = 0;
+  while (key_id == 0 || Contains(key_id)) {
+    key_id = subtle::Random::GetRandomUInt32();
+  }
+  return key_id;
+}
+
+void KeysetIndex::EraseKeys(const absl::flat_hash_set<uint32_t>& key_ids,
+                            Keyset* keyset) {
+  if (key_ids.empty()) return;
+  auto* keys = keyset->mutable_key();
+  int kept = 0;
+  for (int i = 0; i < keys->size(); ++i) {
+    if (key_ids.contains(keys->Get(i).key_id())) continue;
+    if (kept != i) keys->SwapElements(kept, i);
+    ++kept;
+  }
+  keys->DeleteSubrange(kept, keys->size() - kept);
+  Rebuild(*keyset);
+}
+
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
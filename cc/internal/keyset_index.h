@@ -0,0 +1,84 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+#ifndef TINK_INTERNAL_KEYSET_INDEX_H_
+#define TINK_INTERNAL_KEYSET_INDEX_H_
+
+#include <cstdint>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+
+// Maps key IDs to the position of the corresponding key in a Keyset proto, so
+// that large keysets can be edited without scanning all keys on every lookup.
+//
+// If an ID occurs several times, only its first position is indexed, which
+// matches the result of a linear scan. The index is not updated
+// automatically: callers that modify the keyset must keep it in sync through
+// Add() and EraseKeys(), or call Rebuild().
+class KeysetIndex {
+ public:
+  KeysetIndex() = default;
+  explicit KeysetIndex(const google::crypto::tink::Keyset& keyset) {
+    Rebuild(keyset);
+  }
+
+  // Copyable and movable.
+  KeysetIndex(const KeysetIndex&) = default;
+  KeysetIndex& operator=(const KeysetIndex&) = default;
+  KeysetIndex(KeysetIndex&&) = default;
+  KeysetIndex& operator=(KeysetIndex&&) = default;
+
+  // Re-indexes all keys of `keyset`. Runs in O(keyset.key_size()).
+  void Rebuild(const google::crypto::tink::Keyset& keyset);
+
+  // Returns the position of the key with ID `key_id`, or -1 if there is none.
+  int Find(uint32_t key_id) const {
+    auto it = positions_.find(key_id);
+    return it == positions_.end() ? -1 : it->second;
+  }
+
+  bool Contains(uint32_t key_id) const { return positions_.contains(key_id); }
+
+  // Records that the key with ID `key_id` was appended at `position`.
+  void Add(uint32_t key_id, int position) {
+    positions_.emplace(key_id, position);
+  }
+
+  // Returns a random non-zero key ID which is not in the index.
+  uint32_t GenerateUnusedKeyId() const;
+
+  // Removes all keys whose ID is in `key_ids` from `keyset`, which must be
+  // the indexed keyset, and updates the index. The relative order of the
+  // remaining keys is preserved. Runs in O(keyset->key_size()).
+  void EraseKeys(const absl::flat_hash_set<uint32_t>& key_ids,
+                 google::crypto::tink::Keyset* keyset);
+
+  int size() const { return positions_.size(); }
+
+ private:
+  absl::flat_hash_map<uint32_t, int> positions_;
+};
+
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_INTERNAL_KEYSET_INDEX_H_
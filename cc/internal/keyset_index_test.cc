@@ -0,0 +1,111 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+#include "tink/internal/keyset_index.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/container/flat_hash_set.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+namespace {
+
+using ::google::crypto::tink::Keyset;
+using ::testing::ElementsAre;
+using ::testing::Eq;
+using ::testing::Ne;
+
+Keyset KeysetWithIds(const std::vector<uint32_t>& key_ids) {
+  Keyset keyset;
+  for (uint32_t key_id : key_ids) {
+    keyset.add_key()->set_key_id(key_id);
+  }
+  return keyset;
+}
+
+std::vector<uint32_t> KeyIds(const Keyset& keyset) {
+  std::vector<uint32_t> key_ids;
+  for (const Keyset::Key& key : keyset.key()) {
+    key_ids.push_back(key.key_id());
+  }
+  return key_ids;
+}
+
+TEST(KeysetIndexTest, FindAndContains) {
+  KeysetIndex index(KeysetWithIds({10, 20, 30}));
+  EXPECT_THAT(index.size(), Eq(3));
+  EXPECT_THAT(index.Find(10), Eq(0));
+  EXPECT_THAT(index.Find(20), Eq(1));
+  EXPECT_THAT(index.Find(30), Eq(2));
+  EXPECT_THAT(index.Find(40), Eq(-1));
+  EXPECT_TRUE(index.Contains(20));
+  EXPECT_FALSE(index.Contains(40));
+}
+
+TEST(KeysetIndexTest, DuplicateIdsIndexFirstPosition) {
+  KeysetIndex index(KeysetWithIds({10, 20, 10}));
+  EXPECT_THAT(index.Find(10), Eq(0));
+}
+
+TEST(KeysetIndexTest, Add) {
+  Keyset keyset = KeysetWithIds({10});
+  KeysetIndex index(keyset);
+  keyset.add_key()->set_key_id(20);
+  index.Add(20, keyset.key_size() - 1);
+  EXPECT_THAT(index.Find(20), Eq(1));
+}
+
+TEST(KeysetIndexTest, GenerateUnusedKeyId) {
+  Keyset keyset;
+  KeysetIndex index;
+  for (int i = 0; i < 1000; ++i) {
+    uint32_t key_id = index.GenerateUnusedKeyId();
+    ASSERT_THAT(key_id, Ne(0));
+    ASSERT_FALSE(index.Contains(key_id));
+    keyset.add_key()->set_key_id(key_id);
+    index.Add(key_id, keyset.key_size() - 1);
+  }
+  EXPECT_THAT(index.size(), Eq(1000));
+}
+
+TEST(KeysetIndexTest, EraseKeysPreservesOrder) {
+  Keyset keyset = KeysetWithIds({1, 2, 3, 4, 5, 6});
+  KeysetIndex index(keyset);
+  index.EraseKeys({2, 5, 6, 42}, &keyset);
+  EXPECT_THAT(KeyIds(keyset), ElementsAre(1, 3, 4));
+  EXPECT_THAT(index.size(), Eq(3));
+  EXPECT_THAT(index.Find(1), Eq(0));
+  EXPECT_THAT(index.Find(3), Eq(1));
+  EXPECT_THAT(index.Find(4), Eq(2));
+  EXPECT_FALSE(index.Contains(2));
+}
+
+TEST(KeysetIndexTest, EraseKeysEmpty) {
+  Keyset keyset = KeysetWithIds({1, 2});
+  KeysetIndex index(keyset);
+  index.EraseKeys({}, &keyset);
+  EXPECT_THAT(KeyIds(keyset), ElementsAre(1, 2));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
@@ -34,18 +34,50 @@ namespace crypto {
 namespace tink {
 namespace internal {
 
+namespace {
+
+// Returns the implementation of `md` that is used for the remainder of the
+// process. With OpenSSL 3, EVP_sha256() and friends return legacy descriptors
+// that are re-fetched from the provider on every EVP_DigestInit_ex call;
+// fetching them once up front avoids this per-operation lookup. With BoringSSL
+// and older OpenSSL versions `md` is returned unchanged.
+const EVP_MD *Prefetch(const EVP_MD *md) {
+#if !defined(OPENSSL_IS_BORINGSSL) && OPENSSL_VERSION_NUMBER >= 0x30000000L
+  EVP_MD *fetched = EVP_MD_fetch(/*ctx=*/nullptr, EVP_MD_get0_name(md),
+                                 /*properties=*/nullptr);
+  if (fetched != nullptr) {
+    return fetched;
+  }
+#endif
+  return md;
+}
+
+}  // namespace
+
 util::StatusOr<const EVP_MD *> EvpHashFromHashType(subtle::HashType hash_type) {
+  // Each descriptor is resolved once; function-local statics make this
+  // thread-safe.
   switch (hash_type) {
-    case subtle::HashType::SHA1:
-      return EVP_sha1();
-    case subtle::HashType::SHA224:
-      return EVP_sha224();
-    case subtle::HashType::SHA256:
-      return EVP_sha256();
-    case subtle::HashType::SHA384:
-      return EVP_sha384();
-    case subtle::HashType::SHA512:
-      return EVP_sha512();
+    case subtle::HashType::SHA1: {
+      static const EVP_MD *const kMd = Prefetch(EVP_sha1());
+      return kMd;
+    }
+    case subtle::HashType::SHA224: {
+      static const EVP_MD *const kMd = Prefetch(EVP_sha224());
+      return kMd;
+    }
+    case subtle::HashType::SHA256: {
+      static const EVP_MD *const kMd = Prefetch(EVP_sha256());
+      return kMd;
+    }
+    case subtle::HashType::SHA384: {
+      static const EVP_MD *const kMd = Prefetch(EVP_sha384());
+      return kMd;
+    }
+    case subtle::HashType::SHA512: {
+      static const EVP_MD *const kMd = Prefetch(EVP_sha512());
+      return kMd;
+    }
     default:
       return util::Status(
           absl::StatusCode::kUnimplemented,
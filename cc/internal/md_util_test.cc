@@ -16,6 +16,7 @@
 #include "tink/internal/md_util.h"
 
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "gmock/gmock.h"
@@ -41,19 +42,28 @@ using ::testing::TestWithParam;
 using ::testing::ValuesIn;
 
 TEST(MdUtil, EvpHashFromHashType) {
-  EXPECT_THAT(EvpHashFromHashType(HashType::SHA1), IsOkAndHolds(EVP_sha1()));
-  EXPECT_THAT(EvpHashFromHashType(HashType::SHA224),
-              IsOkAndHolds(EVP_sha224()));
-  EXPECT_THAT(EvpHashFromHashType(HashType::SHA256),
-              IsOkAndHolds(EVP_sha256()));
-  EXPECT_THAT(EvpHashFromHashType(HashType::SHA384),
-              IsOkAndHolds(EVP_sha384()));
-  EXPECT_THAT(EvpHashFromHashType(HashType::SHA512),
-              IsOkAndHolds(EVP_sha512()));
+  std::vector<std::pair<HashType, const EVP_MD *>> hashes = {
+      {HashType::SHA1, EVP_sha1()},     {HashType::SHA224, EVP_sha224()},
+      {HashType::SHA256, EVP_sha256()}, {HashType::SHA384, EVP_sha384()},
+      {HashType::SHA512, EVP_sha512()}};
+  for (const auto &hash : hashes) {
+    util::StatusOr<const EVP_MD *> md = EvpHashFromHashType(hash.first);
+    ASSERT_THAT(md, IsOk());
+    EXPECT_EQ(EVP_MD_type(*md), EVP_MD_type(hash.second));
+  }
   EXPECT_THAT(EvpHashFromHashType(HashType::UNKNOWN_HASH).status(),
               Not(IsOk()));
 }
 
+TEST(MdUtil, EvpHashFromHashTypeReturnsSameDescriptor) {
+  for (HashType hash_type : {HashType::SHA1, HashType::SHA224, HashType::SHA256,
+                             HashType::SHA384, HashType::SHA512}) {
+    util::StatusOr<const EVP_MD *> md = EvpHashFromHashType(hash_type);
+    ASSERT_THAT(md, IsOk());
+    EXPECT_THAT(EvpHashFromHashType(hash_type), IsOkAndHolds(*md));
+  }
+}
+
 TEST(MdUtil, IsHashTypeSafeForSignature) {
   EXPECT_THAT(IsHashTypeSafeForSignature(HashType::SHA256), IsOk());
   EXPECT_THAT(IsHashTypeSafeForSignature(HashType::SHA384), IsOk());
@@ -49,18 +49,28 @@ util::StatusOr<const KeyTypeInfoStore::Info*> RegistryImpl::get_key_type_info(
 
 util::StatusOr<std::unique_ptr<KeyData>> RegistryImpl::NewKeyData(
     const KeyTemplate& key_template) const {
+  util::StatusOr<const KeyFactory*> factory =
+      GetNewKeyFactory(key_template.type_url());
+  if (!factory.ok()) {
+    return factory.status();
+  }
+  return (*factory)->NewKeyData(key_template.value());
+}
+
+util::StatusOr<const KeyFactory*> RegistryImpl::GetNewKeyFactory(
+    absl::string_view type_url) const {
   util::StatusOr<const internal::KeyTypeInfoStore::Info*> info =
-      get_key_type_info(key_template.type_url());
+      get_key_type_info(type_url);
   if (!info.ok()) {
     return info.status();
   }
   if (!(*info)->new_key_allowed()) {
     return crypto::tink::util::Status(
         absl::StatusCode::kInvalidArgument,
-        absl::StrCat("KeyManager for type ", key_template.type_url(),
+        absl::StrCat("KeyManager for type ", type_url,
                      " does not allow for creation of new keys."));
   }
-  return (*info)->key_factory().NewKeyData(key_template.value());
+  return &(*info)->key_factory();
 }
 
 util::StatusOr<std::unique_ptr<KeyData>> RegistryImpl::GetPublicKeyData(
@@ -103,6 +103,13 @@ class RegistryImpl {
   NewKeyData(const google::crypto::tink::KeyTemplate& key_template) const
       ABSL_LOCKS_EXCLUDED(maps_mutex_);
 
+  // Returns the factory that NewKeyData() uses for keys of type `type_url`,
+  // so that many keys can be generated without locking the registry for each
+  // of them. Fails if the key type is unknown or does not allow new keys. The
+  // factory stays valid until Reset() is called.
+  crypto::tink::util::StatusOr<const KeyFactory*> GetNewKeyFactory(
+      absl::string_view type_url) const ABSL_LOCKS_EXCLUDED(maps_mutex_);
+
   crypto::tink::util::StatusOr<std::unique_ptr<google::crypto::tink::KeyData>>
   GetPublicKeyData(absl::string_view type_url,
                    absl::string_view serialized_private_key) const
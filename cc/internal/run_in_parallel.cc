@@ -0,0 +1,163 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/internal/run_in_parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <thread>  // NOLINT(build/c++11)
+
+#include "absl/base/thread_annotations.h"
+#include "absl/functional/function_ref.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+namespace {
+
+// A fixed set of worker threads that help with the tasks of RunInParallel()
+// calls. Callers always work on their own tasks, so a call completes even if
+// all workers are busy with other calls.
+class SharedThreadPool {
+ public:
+  explicit SharedThreadPool(int num_threads) : num_threads_(num_threads) {
+    for (int i = 0; i < num_threads; ++i) {
+      // The pool is never destroyed, so the workers are never joined.
+      std::thread([this]() { WorkLoop(); }).detach();
+    }
+  }
+
+  int num_threads() const { return num_threads_; }
+
+  void Run(size_t num_tasks, absl::FunctionRef<void(size_t)> task) {
+    Job job(num_tasks, task);
+    {
+      absl::MutexLock lock(&mutex_);
+      jobs_.push_back(&job);
+    }
+    Work(job);
+    // All tasks have been handed out. Wait for the workers that are still
+    // running some of them, after making sure that no new worker picks up
+    // the job.
+    absl::MutexLock lock(&mutex_);
+    RemoveJob(&job);
+    mutex_.Await(absl::Condition(
+        +[](Job* job) { return job->active_workers == 0; }, &job));
+  }
+
+ private:
+  struct Job {
+    Job(size_t num_tasks, absl::FunctionRef<void(size_t)> task)
+        : num_tasks(num_tasks), task(task) {}
+
+    const size_t num_tasks;
+    const absl::FunctionRef<void(size_t)> task;
+    std::atomic<size_t> next_task{0};
+    // Number of workers that run tasks of this job. Guarded by mutex_.
+    int active_workers = 0;
+  };
+
+  // Runs tasks of `job` until all of them have been handed out.
+  static void Work(Job& job) {
+    for (size_t i = job.next_task++; i < job.num_tasks; i = job.next_task++) {
+      job.task(i);
+    }
+  }
+
+  void RemoveJob(Job* job) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    auto it = std::find(jobs_.begin(), jobs_.end(), job);
+    if (it != jobs_.end()) jobs_.erase(it);
+  }
+
+  bool HasJobs() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return !jobs_.empty();
+  }
+
+  void WorkLoop() {
+    absl::MutexLock lock(&mutex_);
+    while (true) {
+      mutex_.Await(absl::Condition(this, &SharedThreadPool::HasJobs));
+      Job* job = jobs_.front();
+      ++job->active_workers;
+      mutex_.Unlock();
+      Work(*job);
+      mutex_.Lock();
+      // Nothing is left to hand out; keep other workers from picking up the
+      // job again until its caller removes it.
+      RemoveJob(job);
+      --job->active_workers;
+    }
+  }
+
+  const int num_threads_;
+  absl::Mutex mutex_;
+  // Calls with tasks that have not all been handed out yet.
+  std::deque<Job*> jobs_ ABSL_GUARDED_BY(mutex_);
+};
+
+absl::Mutex& PoolMutex() {
+  static absl::Mutex* mutex = new absl::Mutex();
+  return *mutex;
+}
+
+std::atomic<SharedThreadPool*> shared_pool{nullptr};
+
+}  // namespace
+
+void RunInParallel(size_t num_tasks, absl::FunctionRef<void(size_t)> task) {
+  SharedThreadPool* pool = shared_pool.load(std::memory_order_acquire);
+  if (pool == nullptr || num_tasks <= 1) {
+    for (size_t i = 0; i < num_tasks; ++i) {
+      task(i);
+    }
+    return;
+  }
+  pool->Run(num_tasks, task);
+}
+
+util::Status StartSharedThreadPool(int num_threads) {
+  if (num_threads <= 0) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "The number of threads must be positive");
+  }
+  absl::MutexLock lock(&PoolMutex());
+  SharedThreadPool* pool = shared_pool.load(std::memory_order_acquire);
+  if (pool != nullptr) {
+    if (pool->num_threads() == num_threads) return util::OkStatus();
+    return util::Status(
+        absl::StatusCode::kFailedPrecondition,
+        absl::StrCat("The shared thread pool already has ",
+                     pool->num_threads(), " threads"));
+  }
+  shared_pool.store(new SharedThreadPool(num_threads),
+                    std::memory_order_release);
+  return util::OkStatus();
+}
+
+int SharedThreadPoolSize() {
+  SharedThreadPool* pool = shared_pool.load(std::memory_order_acquire);
+  return pool == nullptr ? 0 : pool->num_threads();
+}
+
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
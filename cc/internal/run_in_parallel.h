@@ -0,0 +1,49 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_INTERNAL_RUN_IN_PARALLEL_H_
+#define TINK_INTERNAL_RUN_IN_PARALLEL_H_
+
+#include <cstddef>
+
+#include "absl/functional/function_ref.h"
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+
+// Runs `task(i)` for every i in [0, num_tasks) and returns once all calls
+// have returned. Tasks are handed out in increasing order of i. The calling
+// thread always runs tasks itself; if the shared thread pool has been started,
+// its idle workers help. Otherwise, all tasks run on the calling thread.
+void RunInParallel(size_t num_tasks, absl::FunctionRef<void(size_t)> task);
+
+// Starts the process-wide pool of `num_threads` worker threads that
+// RunInParallel() shares between all callers. The threads run until the
+// process exits. Fails if `num_threads` is not positive, or if the pool was
+// already started with a different number of threads.
+crypto::tink::util::Status StartSharedThreadPool(int num_threads);
+
+// Returns the number of worker threads of the shared pool, or 0 if it has not
+// been started.
+int SharedThreadPoolSize();
+
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_INTERNAL_RUN_IN_PARALLEL_H_
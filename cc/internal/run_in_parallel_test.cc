@@ -0,0 +1,96 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/internal/run_in_parallel.h"
+
+#include <atomic>
+#include <cstddef>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/status/status.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::testing::Each;
+using ::testing::Eq;
+
+void ExpectRunsEveryTaskOnce() {
+  for (size_t num_tasks : {0, 1, 2, 7, 100, 1000}) {
+    std::vector<std::atomic<int>> runs(num_tasks);
+    RunInParallel(num_tasks, [&](size_t i) { runs[i]++; });
+    std::vector<int> counts(runs.begin(), runs.end());
+    EXPECT_THAT(counts, Each(Eq(1))) << "num_tasks " << num_tasks;
+  }
+}
+
+TEST(RunInParallelTest, RunsEveryTaskOnce) { ExpectRunsEveryTaskOnce(); }
+
+TEST(RunInParallelTest, StartSharedThreadPoolFailsWithoutThreads) {
+  EXPECT_THAT(StartSharedThreadPool(0),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(StartSharedThreadPool(-1),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(RunInParallelTest, RunsEveryTaskOnceOnSharedThreadPool) {
+  ASSERT_THAT(StartSharedThreadPool(4), IsOk());
+  EXPECT_THAT(SharedThreadPoolSize(), Eq(4));
+  // Starting the pool again is only possible with the same size.
+  EXPECT_THAT(StartSharedThreadPool(4), IsOk());
+  EXPECT_THAT(StartSharedThreadPool(8),
+              StatusIs(absl::StatusCode::kFailedPrecondition));
+
+  ExpectRunsEveryTaskOnce();
+}
+
+TEST(RunInParallelTest, ConcurrentAndNestedCallsShareThePool) {
+  ASSERT_THAT(StartSharedThreadPool(4), IsOk());
+  constexpr int kNumCallers = 16;
+  constexpr size_t kNumTasks = 50;
+  std::vector<std::vector<std::atomic<int>>> runs(kNumCallers);
+  std::vector<std::thread> callers;
+  for (int c = 0; c < kNumCallers; ++c) {
+    runs[c] = std::vector<std::atomic<int>>(kNumTasks * kNumTasks);
+    callers.emplace_back([&runs, c]() {
+      RunInParallel(kNumTasks, [&runs, c](size_t i) {
+        RunInParallel(kNumTasks, [&runs, c, i](size_t j) {
+          runs[c][i * kNumTasks + j]++;
+        });
+      });
+    });
+  }
+  for (std::thread& caller : callers) {
+    caller.join();
+  }
+  for (int c = 0; c < kNumCallers; ++c) {
+    std::vector<int> counts(runs[c].begin(), runs[c].end());
+    EXPECT_THAT(counts, Each(Eq(1))) << "caller " << c;
+  }
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
@@ -75,6 +75,10 @@ struct Deleter<BN_CTX> {
   void operator()(BN_CTX* ptr) { BN_CTX_free(ptr); }
 };
 template <>
+struct Deleter<BN_MONT_CTX> {
+  void operator()(BN_MONT_CTX* ptr) { BN_MONT_CTX_free(ptr); }
+};
+template <>
 struct Deleter<RSA> {
   void operator()(RSA* ptr) { RSA_free(ptr); }
 };
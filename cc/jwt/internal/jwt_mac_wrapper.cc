@@ -16,11 +16,14 @@
 
 #include "tink/jwt/internal/jwt_mac_wrapper.h"
 
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/status/status.h"
+#include "tink/internal/adaptive_key_order.h"
 #include "tink/jwt/internal/jwt_format.h"
 #include "tink/jwt/internal/jwt_mac_internal.h"
 #include "tink/jwt/jwt_mac.h"
@@ -40,7 +43,10 @@ class JwtMacSetWrapper : public JwtMac {
  public:
   explicit JwtMacSetWrapper(
       std::unique_ptr<PrimitiveSet<JwtMacInternal>> jwt_mac_set)
-      : jwt_mac_set_(std::move(jwt_mac_set)) {}
+      : jwt_mac_set_(std::move(jwt_mac_set)),
+        entries_(jwt_mac_set_->get_all()),
+        key_order_(
+            internal::AdaptiveKeyOrder::NewIfEnabled(entries_.size())) {}
 
   crypto::tink::util::StatusOr<std::string> ComputeMacAndEncode(
       const crypto::tink::RawJwt& token) const override;
@@ -53,6 +59,10 @@ class JwtMacSetWrapper : public JwtMac {
 
  private:
   std::unique_ptr<PrimitiveSet<JwtMacInternal>> jwt_mac_set_;
+  // All entries of jwt_mac_set_, which are tried in this order when
+  // key_order_ is null.
+  std::vector<PrimitiveSet<JwtMacInternal>::Entry<JwtMacInternal>*> entries_;
+  std::unique_ptr<internal::AdaptiveKeyOrder> key_order_;
 };
 
 util::Status Validate(PrimitiveSet<JwtMacInternal>* jwt_mac_set) {
@@ -86,19 +96,24 @@ util::StatusOr<crypto::tink::VerifiedJwt> JwtMacSetWrapper::VerifyMacAndDecode(
     absl::string_view compact,
     const crypto::tink::JwtValidator& validator) const {
   absl::optional<util::Status> interesting_status;
-  for (const auto* mac_entry : jwt_mac_set_->get_all()) {
-    JwtMacInternal& jwt_mac = mac_entry->get_primitive();
-    absl::optional<std::string> kid =
-        GetKid(mac_entry->get_key_id(), mac_entry->get_output_prefix_type());
-    util::StatusOr<VerifiedJwt> verified_jwt =
-        jwt_mac.VerifyMacAndDecodeWithKid(compact, validator, kid);
-    if (verified_jwt.ok()) {
-      return verified_jwt;
-    } else if (verified_jwt.status().code() !=
-               absl::StatusCode::kUnauthenticated) {
-      // errors that are not the result of a MAC verification
-      interesting_status = verified_jwt.status();
-    }
+  util::StatusOr<VerifiedJwt> verified_jwt;
+  if (internal::TryCandidates(
+          key_order_.get(), entries_.size(), [&](size_t i) {
+            const auto* mac_entry = entries_[i];
+            JwtMacInternal& jwt_mac = mac_entry->get_primitive();
+            absl::optional<std::string> kid = GetKid(
+                mac_entry->get_key_id(), mac_entry->get_output_prefix_type());
+            verified_jwt =
+                jwt_mac.VerifyMacAndDecodeWithKid(compact, validator, kid);
+            if (verified_jwt.ok()) return true;
+            if (verified_jwt.status().code() !=
+                absl::StatusCode::kUnauthenticated) {
+              // errors that are not the result of a MAC verification
+              interesting_status = verified_jwt.status();
+            }
+            return false;
+          })) {
+    return verified_jwt;
   }
   if (interesting_status.has_value()) {
     return *interesting_status;
@@ -16,11 +16,14 @@
 
 #include "tink/jwt/internal/jwt_public_key_verify_wrapper.h"
 
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/status/status.h"
+#include "tink/internal/adaptive_key_order.h"
 #include "tink/jwt/internal/jwt_format.h"
 #include "tink/jwt/internal/jwt_public_key_verify_internal.h"
 #include "tink/jwt/jwt_public_key_verify.h"
@@ -40,7 +43,10 @@ class JwtPublicKeyVerifySetWrapper : public JwtPublicKeyVerify {
  public:
   explicit JwtPublicKeyVerifySetWrapper(
       std::unique_ptr<PrimitiveSet<JwtPublicKeyVerifyInternal>> jwt_verify_set)
-      : jwt_verify_set_(std::move(jwt_verify_set)) {}
+      : jwt_verify_set_(std::move(jwt_verify_set)),
+        entries_(jwt_verify_set_->get_all()),
+        key_order_(
+            internal::AdaptiveKeyOrder::NewIfEnabled(entries_.size())) {}
 
   crypto::tink::util::StatusOr<crypto::tink::VerifiedJwt> VerifyAndDecode(
       absl::string_view compact,
@@ -50,6 +56,12 @@ class JwtPublicKeyVerifySetWrapper : public JwtPublicKeyVerify {
 
  private:
   std::unique_ptr<PrimitiveSet<JwtPublicKeyVerifyInternal>> jwt_verify_set_;
+  // All entries of jwt_verify_set_, which are tried in this order when
+  // key_order_ is null.
+  std::vector<PrimitiveSet<JwtPublicKeyVerifyInternal>::Entry<
+      JwtPublicKeyVerifyInternal>*>
+      entries_;
+  std::unique_ptr<internal::AdaptiveKeyOrder> key_order_;
 };
 
 util::Status Validate(
@@ -73,19 +85,24 @@ JwtPublicKeyVerifySetWrapper::VerifyAndDecode(
     absl::string_view compact,
     const crypto::tink::JwtValidator& validator) const {
   absl::optional<util::Status> interesting_status;
-  for (const auto* entry : jwt_verify_set_->get_all()) {
-    JwtPublicKeyVerifyInternal& jwt_verify = entry->get_primitive();
-    absl::optional<std::string> kid =
-        GetKid(entry->get_key_id(), entry->get_output_prefix_type());
-    util::StatusOr<VerifiedJwt> verified_jwt =
-        jwt_verify.VerifyAndDecodeWithKid(compact, validator, kid);
-    if (verified_jwt.ok()) {
-      return verified_jwt;
-    } else if (verified_jwt.status().code() !=
-               absl::StatusCode::kUnauthenticated) {
-      // errors that are not the result of a signature verification
-      interesting_status = verified_jwt.status();
-    }
+  util::StatusOr<VerifiedJwt> verified_jwt;
+  if (internal::TryCandidates(
+          key_order_.get(), entries_.size(), [&](size_t i) {
+            const auto* entry = entries_[i];
+            JwtPublicKeyVerifyInternal& jwt_verify = entry->get_primitive();
+            absl::optional<std::string> kid =
+                GetKid(entry->get_key_id(), entry->get_output_prefix_type());
+            verified_jwt =
+                jwt_verify.VerifyAndDecodeWithKid(compact, validator, kid);
+            if (verified_jwt.ok()) return true;
+            if (verified_jwt.status().code() !=
+                absl::StatusCode::kUnauthenticated) {
+              // errors that are not the result of a signature verification
+              interesting_status = verified_jwt.status();
+            }
+            return false;
+          })) {
+    return verified_jwt;
   }
   if (interesting_status.has_value()) {
     return *std::move(interesting_status);
@@ -26,9 +26,11 @@
 #include "absl/base/attributes.h"
 #include "absl/base/macros.h"
 #include "absl/container/flat_hash_map.h"
+#include "absl/functional/function_ref.h"
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "tink/aead.h"
 #include "tink/config/global_registry.h"
 #include "tink/configuration.h"
@@ -171,6 +173,24 @@ class KeysetHandle {
                        crypto::tink::KeyGenConfigGlobalRegistry());
   }
 
+  // Generates `count` keysets that each contain one new key generated
+  // according to `key_template` using `config`, encrypts each of them with
+  // `master_key_aead` using `associated_data`, and writes the resulting
+  // EncryptedKeysets to `writer` in order. Each written keyset is the same as
+  // GenerateNew() followed by WriteWithAssociatedData() would produce.
+  //
+  // This is meant for provisioning large numbers of keysets: the key manager
+  // is looked up once, key IDs are drawn in batches, and keys are generated
+  // and encrypted in parallel if enabled with EnableParallelism() (see
+  // config/parallelism.h). Keysets are produced in chunks, so
+  // memory use does not grow with `count`. Stops at the first error; keysets
+  // that were written before it are not rolled back.
+  static crypto::tink::util::Status GenerateNewAndWrite(
+      const google::crypto::tink::KeyTemplate& key_template,
+      const crypto::tink::KeyGenConfiguration& config, int64_t count,
+      const Aead& master_key_aead, absl::string_view associated_data,
+      KeysetWriter* writer);
+
   // Encrypts the underlying keyset with the provided `master_key_aead`
   // and writes the resulting EncryptedKeyset to the given `writer`,
   // which must be non-null.
@@ -273,12 +293,35 @@ class KeysetHandle {
         entries_(entries),
         monitoring_annotations_(monitoring_annotations) {}
 
+  // Returns the factory for new keys of `key_template` in `config`.
+  static crypto::tink::util::StatusOr<const KeyFactory*> GetNewKeyFactory(
+      const google::crypto::tink::KeyTemplate& key_template,
+      const crypto::tink::KeyGenConfiguration& config);
+
+  // Generates `count` keysets that each contain one new primary key, as
+  // GenerateNew() does, and passes them to `consume` in order, one chunk of
+  // keysets per call. Keys are generated in parallel if enabled with
+  // EnableParallelism().
+  static crypto::tink::util::Status GenerateKeysets(
+      const google::crypto::tink::KeyTemplate& key_template,
+      const crypto::tink::KeyGenConfiguration& config, int64_t count,
+      absl::FunctionRef<crypto::tink::util::Status(
+          absl::Span<util::SecretProto<google::crypto::tink::Keyset>>)>
+          consume);
+
   // Generates a key from `key_template` and adds it `keyset`.
   static crypto::tink::util::StatusOr<uint32_t> AddToKeyset(
       const google::crypto::tink::KeyTemplate& key_template, bool as_primary,
       const crypto::tink::KeyGenConfiguration& config,
       google::crypto::tink::Keyset* keyset);
 
+  // Same as above, but the new key gets ID `key_id`, which the caller must
+  // have checked to be unused in `keyset`.
+  static crypto::tink::util::StatusOr<uint32_t> AddToKeyset(
+      const google::crypto::tink::KeyTemplate& key_template, bool as_primary,
+      uint32_t key_id, const crypto::tink::KeyGenConfiguration& config,
+      google::crypto::tink::Keyset* keyset);
+
   // Creates list of KeysetHandle::Entry entries derived from `keyset` in order.
   static crypto::tink::util::StatusOr<std::vector<std::shared_ptr<const Entry>>>
   GetEntriesFromKeyset(const google::crypto::tink::Keyset& keyset);
@@ -18,11 +18,11 @@
 #define TINK_KEYSET_HANDLE_BUILDER_H_
 
 #include <memory>
-#include <set>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_set.h"
 #include "tink/internal/keyset_handle_builder_entry.h"
 #include "tink/key.h"
 #include "tink/key_status.h"
@@ -150,7 +150,8 @@ class KeysetHandleBuilder {
  private:
   // Select the next key id based on the given strategy.
   crypto::tink::util::StatusOr<int> NextIdFromKeyIdStrategy(
-      internal::KeyIdStrategy strategy, const std::set<int>& ids_so_far);
+      internal::KeyIdStrategy strategy,
+      const absl::flat_hash_set<int>& ids_so_far);
 
   // Unset primary flag on all entries.
   void ClearPrimary();
@@ -16,10 +16,15 @@
 #ifndef TINK_KEYSET_MANAGER_H_
 #define TINK_KEYSET_MANAGER_H_
 
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "absl/base/thread_annotations.h"
+#include "absl/functional/function_ref.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
+#include "tink/internal/keyset_index.h"
 #include "tink/util/secret_proto.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
@@ -34,6 +39,11 @@ class KeysetHandle;
 // rotating, disabling, enabling, or destroying keys.
 // An instance of this class takes care of a single Keyset, that can be
 // accessed via GetKeysetHandle()-method.
+//
+// Keys are looked up through an index by key ID, so single-key operations
+// other than Delete() take constant time regardless of the keyset size. For
+// bulk maintenance of large keysets use the *Keys() variants, which apply an
+// operation to many keys while taking the lock once.
 class KeysetManager {
  public:
   // Constructs a KeysetManager with an empty Keyset.
@@ -95,6 +105,28 @@ class KeysetManager {
   crypto::tink::util::Status SetPrimary(uint32_t key_id)
       ABSL_LOCKS_EXCLUDED(keyset_mutex_);
 
+  // Batch variants of Enable(), Disable(), Destroy() and Delete(). Each key in
+  // 'key_ids' is checked as by the corresponding single-key method; if any
+  // check fails, the keyset is left unchanged and the first error is
+  // returned. DeleteKeys() runs in time linear in the size of the keyset,
+  // the others in time linear in the size of 'key_ids'.
+  crypto::tink::util::Status EnableKeys(absl::Span<const uint32_t> key_ids)
+      ABSL_LOCKS_EXCLUDED(keyset_mutex_);
+  crypto::tink::util::Status DisableKeys(absl::Span<const uint32_t> key_ids)
+      ABSL_LOCKS_EXCLUDED(keyset_mutex_);
+  crypto::tink::util::Status DestroyKeys(absl::Span<const uint32_t> key_ids)
+      ABSL_LOCKS_EXCLUDED(keyset_mutex_);
+  crypto::tink::util::Status DeleteKeys(absl::Span<const uint32_t> key_ids)
+      ABSL_LOCKS_EXCLUDED(keyset_mutex_);
+
+  // Returns the IDs of all keys for which 'predicate' returns true, in
+  // keyset order. Add() and Rotate() append keys, so for keys created through
+  // this class keyset order is creation order; e.g., the keys older than a
+  // given key are those preceding it.
+  std::vector<uint32_t> GetKeyIds(
+      absl::FunctionRef<bool(const google::crypto::tink::KeysetInfo::KeyInfo&)>
+          predicate) const ABSL_LOCKS_EXCLUDED(keyset_mutex_);
+
   // Returns the count of all keys in the keyset.
   int KeyCount() const;
 
@@ -107,9 +139,14 @@ class KeysetManager {
       const google::crypto::tink::KeyTemplate& key_template, bool as_primary)
       ABSL_LOCKS_EXCLUDED(keyset_mutex_);
 
+  // Returns the key with ID 'key_id', or nullptr if there is none.
+  google::crypto::tink::Keyset::Key* FindKey(uint32_t key_id)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(keyset_mutex_);
+
   mutable absl::Mutex keyset_mutex_;
   util::SecretProto<google::crypto::tink::Keyset> keyset_
       ABSL_GUARDED_BY(keyset_mutex_);
+  internal::KeysetIndex key_index_ ABSL_GUARDED_BY(keyset_mutex_);
 };
 
 }  // namespace tink
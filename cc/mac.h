@@ -17,10 +17,16 @@
 #ifndef TINK_MAC_H_
 #define TINK_MAC_H_
 
+#include <cstddef>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "absl/status/status.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "tink/util/status.h"
+#include "tink/util/request_arena.h"
 #include "tink/util/statusor.h"
 
 namespace crypto {
@@ -36,12 +42,61 @@ class Mac {
   virtual crypto::tink::util::StatusOr<std::string> ComputeMac(
       absl::string_view data) const = 0;
 
+  // Like ComputeMac(), but places the MAC in `arena` instead of a new
+  // std::string. The returned view is valid until `arena` is reset.
+  // The default implementation copies the result of ComputeMac() into `arena`;
+  // implementations that can write their output directly override it.
+  virtual crypto::tink::util::StatusOr<absl::string_view> ComputeMacWithArena(
+      absl::string_view data, crypto::tink::util::RequestArena* arena) const {
+    crypto::tink::util::StatusOr<std::string> mac = ComputeMac(data);
+    if (!mac.ok()) return mac.status();
+    return arena->Copy(*mac);
+  }
+
   // Verifies if 'mac' is a correct authentication code (MAC) for 'data'.
   // Returns Status::OK if 'mac' is correct, and a non-OK-Status otherwise.
   virtual crypto::tink::util::Status VerifyMac(
       absl::string_view mac_value,
       absl::string_view data) const = 0;
 
+  // Computes the MACs for each element of `data` and returns them in the same
+  // order. The result is identical to calling ComputeMac() on every element.
+  // The default implementation does exactly that; implementations that can
+  // process several independent messages at once (e.g., AES-CMAC) override
+  // it.
+  virtual crypto::tink::util::StatusOr<std::vector<std::string>>
+  ComputeMacBatch(absl::Span<const absl::string_view> data) const {
+    std::vector<std::string> macs;
+    macs.reserve(data.size());
+    for (absl::string_view d : data) {
+      crypto::tink::util::StatusOr<std::string> mac = ComputeMac(d);
+      if (!mac.ok()) return mac.status();
+      macs.push_back(*std::move(mac));
+    }
+    return macs;
+  }
+
+  // Verifies each pair (`macs[i]`, `data[i]`). Element i of the result is true
+  // if and only if VerifyMac(macs[i], data[i]) would succeed. A non-OK status
+  // is only returned if the batch itself is malformed, i.e., if `macs` and
+  // `data` differ in size. The default implementation calls VerifyMac() on
+  // every pair; implementations that can compute several tags at once, or
+  // reuse per-key state across messages, override it.
+  virtual crypto::tink::util::StatusOr<std::vector<bool>> VerifyMacBatch(
+      absl::Span<const absl::string_view> macs,
+      absl::Span<const absl::string_view> data) const {
+    if (macs.size() != data.size()) {
+      return crypto::tink::util::Status(
+          absl::StatusCode::kInvalidArgument,
+          "Number of MACs and number of messages differ");
+    }
+    std::vector<bool> valid(data.size());
+    for (size_t i = 0; i < data.size(); ++i) {
+      valid[i] = VerifyMac(macs[i], data[i]).ok();
+    }
+    return valid;
+  }
+
   virtual ~Mac() = default;
 };
 
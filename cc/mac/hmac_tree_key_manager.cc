@@ -0,0 +1,139 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/mac/hmac_tree_key_manager.h"
+
+#include <cstdint>
+#include <string>
+
+#include "absl/status/status.h"
+#include "tink/input_stream.h"
+#include "tink/subtle/hmac_tree_mac.h"
+#include "tink/subtle/random.h"
+#include "tink/util/enums.h"
+#include "tink/util/errors.h"
+#include "tink/util/input_stream_util.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/validation.h"
+#include "proto/common.pb.h"
+#include "proto/hmac_tree.pb.h"
+
+namespace crypto {
+namespace tink {
+
+using crypto::tink::util::Enums;
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+using google::crypto::tink::HashType;
+using google::crypto::tink::HmacTreeKey;
+using google::crypto::tink::HmacTreeKeyFormat;
+using google::crypto::tink::HmacTreeParams;
+
+namespace {
+
+uint32_t MaxTagSize(HashType hash) {
+  switch (hash) {
+    case HashType::SHA256:
+      return 32;
+    case HashType::SHA384:
+      return 48;
+    case HashType::SHA512:
+      return 64;
+    default:
+      return 0;
+  }
+}
+
+}  // namespace
+
+StatusOr<HmacTreeKey> HmacTreeKeyManager::CreateKey(
+    const HmacTreeKeyFormat& key_format) const {
+  HmacTreeKey key;
+  key.set_version(get_version());
+  *key.mutable_params() = key_format.params();
+  key.set_key_value(subtle::Random::GetRandomBytes(key_format.key_size()));
+  return key;
+}
+
+StatusOr<HmacTreeKey> HmacTreeKeyManager::DeriveKey(
+    const HmacTreeKeyFormat& key_format, InputStream* input_stream) const {
+  Status status = ValidateKeyFormat(key_format);
+  if (!status.ok()) return status;
+
+  StatusOr<std::string> randomness =
+      ReadBytesFromStream(key_format.key_size(), input_stream);
+  if (!randomness.ok()) {
+    if (randomness.status().code() == absl::StatusCode::kOutOfRange) {
+      return Status(absl::StatusCode::kInvalidArgument,
+                    "Could not get enough pseudorandomness from input stream");
+    }
+    return randomness.status();
+  }
+
+  HmacTreeKey key;
+  key.set_version(get_version());
+  *key.mutable_params() = key_format.params();
+  key.set_key_value(*randomness);
+  return key;
+}
+
+Status HmacTreeKeyManager::ValidateParams(const HmacTreeParams& params) const {
+  const uint32_t max_tag_size = MaxTagSize(params.hash());
+  if (max_tag_size == 0) {
+    return ToStatusF(absl::StatusCode::kInvalidArgument,
+                     "Invalid HmacTreeParams: HashType '%s' not supported.",
+                     Enums::HashName(params.hash()));
+  }
+  if (params.tag_size() < subtle::HmacTreeMac::kMinTagSize ||
+      params.tag_size() > max_tag_size) {
+    return ToStatusF(
+        absl::StatusCode::kInvalidArgument,
+        "Invalid HmacTreeParams: tag_size %d is invalid for HashType '%s'.",
+        params.tag_size(), Enums::HashName(params.hash()));
+  }
+  if (params.chunk_size() < subtle::HmacTreeMac::kMinChunkSize) {
+    return ToStatusF(absl::StatusCode::kInvalidArgument,
+                     "Invalid HmacTreeParams: chunk_size %d is too small.",
+                     params.chunk_size());
+  }
+  return util::OkStatus();
+}
+
+Status HmacTreeKeyManager::ValidateKey(const HmacTreeKey& key) const {
+  Status status = ValidateVersion(key.version(), get_version());
+  if (!status.ok()) return status;
+  if (key.key_value().size() < subtle::HmacTreeMac::kMinKeySize) {
+    return Status(absl::StatusCode::kInvalidArgument,
+                  "Invalid HmacTreeKey: key_value is too short.");
+  }
+  return ValidateParams(key.params());
+}
+
+Status HmacTreeKeyManager::ValidateKeyFormat(
+    const HmacTreeKeyFormat& key_format) const {
+  Status status = ValidateVersion(key_format.version(), get_version());
+  if (!status.ok()) return status;
+  if (key_format.key_size() < subtle::HmacTreeMac::kMinKeySize) {
+    return Status(absl::StatusCode::kInvalidArgument,
+                  "Invalid HmacTreeKeyFormat: key_size is too small.");
+  }
+  return ValidateParams(key_format.params());
+}
+
+}  // namespace tink
+}  // namespace crypto
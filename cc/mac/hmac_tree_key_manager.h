@@ -0,0 +1,115 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef TINK_MAC_HMAC_TREE_KEY_MANAGER_H_
+#define TINK_MAC_HMAC_TREE_KEY_MANAGER_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "tink/chunked_mac.h"
+#include "tink/core/key_type_manager.h"
+#include "tink/input_stream.h"
+#include "tink/internal/fips_utils.h"
+#include "tink/mac.h"
+#include "tink/subtle/hmac_tree_mac.h"
+#include "tink/util/constants.h"
+#include "tink/util/enums.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "proto/hmac_tree.pb.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+// Key manager for HmacTreeKey, a MAC over a Merkle tree of HMAC values whose
+// leaves can be computed in parallel; see subtle::HmacTreeMac. Both
+// primitives compute the same tags.
+class HmacTreeKeyManager
+    : public KeyTypeManager<google::crypto::tink::HmacTreeKey,
+                            google::crypto::tink::HmacTreeKeyFormat,
+                            List<Mac, ChunkedMac>> {
+ public:
+  class MacFactory : public PrimitiveFactory<Mac> {
+    crypto::tink::util::StatusOr<std::unique_ptr<Mac>> Create(
+        const google::crypto::tink::HmacTreeKey& key) const override {
+      return subtle::HmacTreeMac::New(
+          util::Enums::ProtoToSubtle(key.params().hash()),
+          key.params().tag_size(), key.params().chunk_size(),
+          util::SecretDataFromStringView(key.key_value()));
+    }
+  };
+
+  class ChunkedMacFactory : public PrimitiveFactory<ChunkedMac> {
+    crypto::tink::util::StatusOr<std::unique_ptr<ChunkedMac>> Create(
+        const google::crypto::tink::HmacTreeKey& key) const override {
+      return subtle::HmacTreeMac::New(
+          util::Enums::ProtoToSubtle(key.params().hash()),
+          key.params().tag_size(), key.params().chunk_size(),
+          util::SecretDataFromStringView(key.key_value()));
+    }
+  };
+
+  HmacTreeKeyManager()
+      : KeyTypeManager(absl::make_unique<MacFactory>(),
+                       absl::make_unique<ChunkedMacFactory>()) {}
+
+  uint32_t get_version() const override { return 0; }
+
+  google::crypto::tink::KeyData::KeyMaterialType key_material_type()
+      const override {
+    return google::crypto::tink::KeyData::SYMMETRIC;
+  }
+
+  const std::string& get_key_type() const override { return key_type_; }
+
+  crypto::tink::util::Status ValidateKey(
+      const google::crypto::tink::HmacTreeKey& key) const override;
+
+  crypto::tink::util::Status ValidateKeyFormat(
+      const google::crypto::tink::HmacTreeKeyFormat& key_format)
+      const override;
+
+  crypto::tink::util::StatusOr<google::crypto::tink::HmacTreeKey> CreateKey(
+      const google::crypto::tink::HmacTreeKeyFormat& key_format)
+      const override;
+
+  crypto::tink::util::StatusOr<google::crypto::tink::HmacTreeKey> DeriveKey(
+      const google::crypto::tink::HmacTreeKeyFormat& key_format,
+      InputStream* input_stream) const override;
+
+  internal::FipsCompatibility FipsStatus() const override {
+    return internal::FipsCompatibility::kNotFips;
+  }
+
+ private:
+  crypto::tink::util::Status ValidateParams(
+      const google::crypto::tink::HmacTreeParams& params) const;
+
+  const std::string key_type_ = absl::StrCat(
+      kTypeGoogleapisCom, google::crypto::tink::HmacTreeKey().GetTypeName());
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_MAC_HMAC_TREE_KEY_MANAGER_H_
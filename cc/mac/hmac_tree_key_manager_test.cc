@@ -0,0 +1,179 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/mac/hmac_tree_key_manager.h"
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "tink/chunked_mac.h"
+#include "tink/internal/fips_utils.h"
+#include "tink/mac.h"
+#include "tink/subtle/hmac_tree_mac.h"
+#include "tink/util/istream_input_stream.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "proto/common.pb.h"
+#include "proto/hmac_tree.pb.h"
+
+namespace crypto {
+namespace tink {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::IsOkAndHolds;
+using ::crypto::tink::test::StatusIs;
+using ::crypto::tink::util::IstreamInputStream;
+using ::crypto::tink::util::StatusOr;
+using ::google::crypto::tink::HashType;
+using ::google::crypto::tink::HmacTreeKey;
+using ::google::crypto::tink::HmacTreeKeyFormat;
+using ::testing::Eq;
+using ::testing::Not;
+using ::testing::SizeIs;
+
+namespace {
+
+HmacTreeKeyFormat ValidKeyFormat() {
+  HmacTreeKeyFormat key_format;
+  key_format.mutable_params()->set_hash(HashType::SHA256);
+  key_format.mutable_params()->set_tag_size(32);
+  key_format.mutable_params()->set_chunk_size(1 << 20);
+  key_format.set_key_size(32);
+  return key_format;
+}
+
+TEST(HmacTreeKeyManagerTest, Basics) {
+  EXPECT_EQ(HmacTreeKeyManager().get_version(), 0);
+  EXPECT_EQ(HmacTreeKeyManager().get_key_type(),
+            "type.googleapis.com/google.crypto.tink.HmacTreeKey");
+  EXPECT_EQ(HmacTreeKeyManager().key_material_type(),
+            google::crypto::tink::KeyData::SYMMETRIC);
+}
+
+TEST(HmacTreeKeyManagerTest, ValidateEmptyKey) {
+  EXPECT_THAT(HmacTreeKeyManager().ValidateKey(HmacTreeKey()), Not(IsOk()));
+}
+
+TEST(HmacTreeKeyManagerTest, ValidateEmptyKeyFormat) {
+  EXPECT_THAT(HmacTreeKeyManager().ValidateKeyFormat(HmacTreeKeyFormat()),
+              Not(IsOk()));
+}
+
+TEST(HmacTreeKeyManagerTest, ValidKeyFormat) {
+  EXPECT_THAT(HmacTreeKeyManager().ValidateKeyFormat(ValidKeyFormat()),
+              IsOk());
+}
+
+TEST(HmacTreeKeyManagerTest, ValidateKeyFormatHashes) {
+  HmacTreeKeyFormat key_format = ValidKeyFormat();
+  key_format.mutable_params()->set_tag_size(16);
+  for (HashType hash : {HashType::SHA256, HashType::SHA384, HashType::SHA512}) {
+    key_format.mutable_params()->set_hash(hash);
+    EXPECT_THAT(HmacTreeKeyManager().ValidateKeyFormat(key_format), IsOk());
+  }
+  for (HashType hash : {HashType::SHA1, HashType::SHA224}) {
+    key_format.mutable_params()->set_hash(hash);
+    EXPECT_THAT(HmacTreeKeyManager().ValidateKeyFormat(key_format),
+                StatusIs(absl::StatusCode::kInvalidArgument));
+  }
+}
+
+TEST(HmacTreeKeyManagerTest, ValidateKeyFormatInvalidParams) {
+  HmacTreeKeyFormat key_format = ValidKeyFormat();
+  key_format.mutable_params()->set_tag_size(15);
+  EXPECT_THAT(HmacTreeKeyManager().ValidateKeyFormat(key_format),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  key_format.mutable_params()->set_tag_size(33);
+  EXPECT_THAT(HmacTreeKeyManager().ValidateKeyFormat(key_format),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+
+  key_format = ValidKeyFormat();
+  key_format.mutable_params()->set_chunk_size(1023);
+  EXPECT_THAT(HmacTreeKeyManager().ValidateKeyFormat(key_format),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+
+  key_format = ValidKeyFormat();
+  key_format.set_key_size(15);
+  EXPECT_THAT(HmacTreeKeyManager().ValidateKeyFormat(key_format),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(HmacTreeKeyManagerTest, CreateKey) {
+  HmacTreeKeyFormat key_format = ValidKeyFormat();
+  StatusOr<HmacTreeKey> key = HmacTreeKeyManager().CreateKey(key_format);
+  ASSERT_THAT(key, IsOk());
+  EXPECT_THAT(key->version(), Eq(0));
+  EXPECT_THAT(key->key_value(), SizeIs(32));
+  EXPECT_THAT(key->params().chunk_size(), Eq(1 << 20));
+  EXPECT_THAT(HmacTreeKeyManager().ValidateKey(*key), IsOk());
+}
+
+TEST(HmacTreeKeyManagerTest, DeriveKey) {
+  HmacTreeKeyFormat key_format = ValidKeyFormat();
+  IstreamInputStream input_stream{absl::make_unique<std::stringstream>(
+      "0123456789abcdef0123456789abcdefXXX")};
+  StatusOr<HmacTreeKey> key =
+      HmacTreeKeyManager().DeriveKey(key_format, &input_stream);
+  ASSERT_THAT(key, IsOk());
+  EXPECT_THAT(key->key_value(), Eq("0123456789abcdef0123456789abcdef"));
+  EXPECT_THAT(key->params().chunk_size(), Eq(1 << 20));
+}
+
+TEST(HmacTreeKeyManagerTest, DeriveKeyNotEnoughRandomness) {
+  HmacTreeKeyFormat key_format = ValidKeyFormat();
+  IstreamInputStream input_stream{
+      absl::make_unique<std::stringstream>("0123456789")};
+  EXPECT_THAT(
+      HmacTreeKeyManager().DeriveKey(key_format, &input_stream).status(),
+      StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(HmacTreeKeyManagerTest, GetPrimitives) {
+  if (internal::IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  StatusOr<HmacTreeKey> key =
+      HmacTreeKeyManager().CreateKey(ValidKeyFormat());
+  ASSERT_THAT(key, IsOk());
+  StatusOr<std::unique_ptr<Mac>> mac =
+      HmacTreeKeyManager().GetPrimitive<Mac>(*key);
+  ASSERT_THAT(mac, IsOk());
+  StatusOr<std::unique_ptr<ChunkedMac>> chunked_mac =
+      HmacTreeKeyManager().GetPrimitive<ChunkedMac>(*key);
+  ASSERT_THAT(chunked_mac, IsOk());
+
+  std::string data(3 << 20, 'a');
+  StatusOr<std::string> tag = (*mac)->ComputeMac(data);
+  ASSERT_THAT(tag, IsOkAndHolds(SizeIs(32)));
+
+  StatusOr<std::unique_ptr<ChunkedMacVerification>> verification =
+      (*chunked_mac)->CreateVerification(*tag);
+  ASSERT_THAT(verification, IsOk());
+  ASSERT_THAT((*verification)->Update(data), IsOk());
+  EXPECT_THAT((*verification)->VerifyMac(), IsOk());
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
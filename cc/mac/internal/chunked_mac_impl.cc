@@ -21,7 +21,6 @@
 #include <utility>
 
 #include "absl/strings/string_view.h"
-#include "openssl/crypto.h"
 #include "tink/chunked_mac.h"
 #include "tink/subtle/mac/stateful_mac.h"
 #include "tink/subtle/stateful_cmac_boringssl.h"
@@ -61,19 +60,7 @@ util::Status ChunkedMacVerificationImpl::VerifyMac() {
   if (!status_.ok()) return status_;
   status_ = util::Status(absl::StatusCode::kFailedPrecondition,
                          "MAC verification already finalized.");
-  util::StatusOr<std::string> computed_mac = stateful_mac_->Finalize();
-  if (!computed_mac.ok()) {
-    return computed_mac.status();
-  }
-  if (computed_mac->size() != tag_.size()) {
-    return util::Status(absl::StatusCode::kInvalidArgument,
-                        "Verification failed.");
-  }
-  if (CRYPTO_memcmp(computed_mac->data(), tag_.data(), computed_mac->size())) {
-    return util::Status(absl::StatusCode::kInvalidArgument,
-                        "Verification failed.");
-  }
-  return util::OkStatus();
+  return stateful_mac_->FinalizeAndVerify(tag_);
 }
 
 util::StatusOr<std::unique_ptr<ChunkedMacComputation>>
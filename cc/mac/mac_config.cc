@@ -23,6 +23,7 @@
 #include "tink/mac/aes_cmac_proto_serialization.h"
 #include "tink/mac/hmac_key_manager.h"
 #include "tink/mac/hmac_proto_serialization.h"
+#include "tink/mac/hmac_tree_key_manager.h"
 #include "tink/mac/internal/chunked_mac_wrapper.h"
 #include "tink/mac/mac_wrapper.h"
 #include "tink/registry.h"
@@ -64,6 +65,10 @@ util::Status MacConfig::Register() {
   status = RegisterAesCmacProtoSerialization();
   if (!status.ok()) return status;
 
+  status = Registry::RegisterKeyTypeManager(
+      absl::make_unique<HmacTreeKeyManager>(), true);
+  if (!status.ok()) return status;
+
   return util::OkStatus();
 }
 
@@ -37,6 +37,7 @@
 #include "tink/mac/hmac_key.h"
 #include "tink/mac/hmac_key_manager.h"
 #include "tink/mac/hmac_parameters.h"
+#include "tink/mac/hmac_tree_key_manager.h"
 #include "tink/mac/mac_key_templates.h"
 #include "tink/partial_key_access.h"
 #include "tink/registry.h"
@@ -88,6 +89,10 @@ TEST_F(MacConfigTest, Basic) {
       Registry::get_key_manager<ChunkedMac>(AesCmacKeyManager().get_key_type())
           .status(),
       StatusIs(absl::StatusCode::kNotFound));
+  EXPECT_THAT(
+      Registry::get_key_manager<Mac>(HmacTreeKeyManager().get_key_type())
+          .status(),
+      StatusIs(absl::StatusCode::kNotFound));
 
   ASSERT_THAT(MacConfig::Register(), IsOk());
 
@@ -105,6 +110,14 @@ TEST_F(MacConfigTest, Basic) {
       Registry::get_key_manager<ChunkedMac>(AesCmacKeyManager().get_key_type())
           .status(),
       IsOk());
+  EXPECT_THAT(
+      Registry::get_key_manager<Mac>(HmacTreeKeyManager().get_key_type())
+          .status(),
+      IsOk());
+  EXPECT_THAT(
+      Registry::get_key_manager<ChunkedMac>(HmacTreeKeyManager().get_key_type())
+          .status(),
+      IsOk());
 }
 
 // Tests that the MacWrapper has been properly registered and we can wrap
@@ -343,7 +356,8 @@ class ChunkedMacConfigTest : public ::testing::TestWithParam<KeyTemplate> {
 
 INSTANTIATE_TEST_SUITE_P(ChunkedMacConfigTestSuite, ChunkedMacConfigTest,
                          Values(MacKeyTemplates::AesCmac(),
-                                MacKeyTemplates::HmacSha256()));
+                                MacKeyTemplates::HmacSha256(),
+                                MacKeyTemplates::HmacSha256Tree()));
 
 // Tests that the ChunkedMacWrapper has been properly registered and we can get
 // primitives.
@@ -388,6 +402,8 @@ TEST_F(MacConfigTest, RegisterNonFipsTemplates) {
 
   std::list<google::crypto::tink::KeyTemplate> non_fips_key_templates;
   non_fips_key_templates.push_back(MacKeyTemplates::AesCmac());
+  non_fips_key_templates.push_back(MacKeyTemplates::HmacSha256Tree());
+  non_fips_key_templates.push_back(MacKeyTemplates::HmacSha512Tree());
 
   for (auto key_template : non_fips_key_templates) {
     EXPECT_THAT(
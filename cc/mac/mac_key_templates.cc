@@ -19,6 +19,7 @@
 #include "proto/aes_cmac.pb.h"
 #include "proto/common.pb.h"
 #include "proto/hmac.pb.h"
+#include "proto/hmac_tree.pb.h"
 #include "proto/tink.pb.h"
 
 namespace crypto {
@@ -28,6 +29,7 @@ namespace {
 using google::crypto::tink::AesCmacKeyFormat;
 using google::crypto::tink::HashType;
 using google::crypto::tink::HmacKeyFormat;
+using google::crypto::tink::HmacTreeKeyFormat;
 using google::crypto::tink::KeyTemplate;
 using google::crypto::tink::OutputPrefixType;
 
@@ -57,6 +59,22 @@ KeyTemplate* NewAesCmacKeyTemplate(int key_size_in_bytes,
   return key_template;
 }
 
+KeyTemplate* NewHmacTreeKeyTemplate(int key_size_in_bytes,
+                                    int tag_size_in_bytes, HashType hash_type,
+                                    int chunk_size_in_bytes) {
+  KeyTemplate* key_template = new KeyTemplate;
+  key_template->set_type_url(
+      "type.googleapis.com/google.crypto.tink.HmacTreeKey");
+  key_template->set_output_prefix_type(OutputPrefixType::TINK);
+  HmacTreeKeyFormat key_format;
+  key_format.set_key_size(key_size_in_bytes);
+  key_format.mutable_params()->set_tag_size(tag_size_in_bytes);
+  key_format.mutable_params()->set_hash(hash_type);
+  key_format.mutable_params()->set_chunk_size(chunk_size_in_bytes);
+  key_format.SerializeToString(key_template->mutable_value());
+  return key_template;
+}
+
 }  // anonymous namespace
 
 // static
@@ -98,5 +116,21 @@ const KeyTemplate& MacKeyTemplates::AesCmac() {
   return *key_template;
 }
 
+// static
+const KeyTemplate& MacKeyTemplates::HmacSha256Tree() {
+  static const KeyTemplate* key_template = NewHmacTreeKeyTemplate(
+      /* key_size_in_bytes= */ 32, /* tag_size_in_bytes= */ 32,
+      HashType::SHA256, /* chunk_size_in_bytes= */ 1 << 20);
+  return *key_template;
+}
+
+// static
+const KeyTemplate& MacKeyTemplates::HmacSha512Tree() {
+  static const KeyTemplate* key_template = NewHmacTreeKeyTemplate(
+      /* key_size_in_bytes= */ 64, /* tag_size_in_bytes= */ 64,
+      HashType::SHA512, /* chunk_size_in_bytes= */ 1 << 20);
+  return *key_template;
+}
+
 }  // namespace tink
 }  // namespace crypto
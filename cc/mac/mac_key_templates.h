@@ -73,6 +73,22 @@ class MacKeyTemplates {
   //   - tag size: 16 bytes
   //   - OutputPrefixType: TINK
   static const google::crypto::tink::KeyTemplate& AesCmac();
+  // Returns a KeyTemplate that generates new instances of HmacTreeKey
+  // with the following parameters:
+  //   - key size: 32 bytes
+  //   - tag size: 32 bytes
+  //   - hash function: SHA256
+  //   - chunk size: 1 MiB
+  //   - OutputPrefixType: TINK
+  static const google::crypto::tink::KeyTemplate& HmacSha256Tree();
+  // Returns a KeyTemplate that generates new instances of HmacTreeKey
+  // with the following parameters:
+  //   - key size: 64 bytes
+  //   - tag size: 64 bytes
+  //   - hash function: SHA512
+  //   - chunk size: 1 MiB
+  //   - OutputPrefixType: TINK
+  static const google::crypto::tink::KeyTemplate& HmacSha512Tree();
 };
 
 }  // namespace tink
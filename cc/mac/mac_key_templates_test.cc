@@ -23,10 +23,12 @@
 #include "tink/core/key_manager_impl.h"
 #include "tink/mac/aes_cmac_key_manager.h"
 #include "tink/mac/hmac_key_manager.h"
+#include "tink/mac/hmac_tree_key_manager.h"
 #include "tink/util/test_matchers.h"
 #include "proto/aes_cmac.pb.h"
 #include "proto/common.pb.h"
 #include "proto/hmac.pb.h"
+#include "proto/hmac_tree.pb.h"
 #include "proto/tink.pb.h"
 
 namespace crypto {
@@ -37,6 +39,7 @@ using ::crypto::tink::test::IsOk;
 using ::google::crypto::tink::AesCmacKeyFormat;
 using ::google::crypto::tink::HashType;
 using ::google::crypto::tink::HmacKeyFormat;
+using ::google::crypto::tink::HmacTreeKeyFormat;
 using ::google::crypto::tink::KeyTemplate;
 using ::google::crypto::tink::OutputPrefixType;
 using ::testing::Eq;
@@ -169,6 +172,40 @@ TEST(AesCmac, CheckValues) {
   EXPECT_THAT(key_format.params().tag_size(), Eq(16));
 }
 
+TEST(HmacTree, Basics) {
+  EXPECT_THAT(MacKeyTemplates::HmacSha256Tree().type_url(),
+              Eq("type.googleapis.com/google.crypto.tink.HmacTreeKey"));
+  EXPECT_THAT(MacKeyTemplates::HmacSha256Tree().type_url(),
+              Eq(HmacTreeKeyManager().get_key_type()));
+  EXPECT_THAT(MacKeyTemplates::HmacSha512Tree().type_url(),
+              Eq(HmacTreeKeyManager().get_key_type()));
+}
+
+TEST(HmacTree, OutputPrefixType) {
+  EXPECT_THAT(MacKeyTemplates::HmacSha256Tree().output_prefix_type(),
+              Eq(OutputPrefixType::TINK));
+  EXPECT_THAT(MacKeyTemplates::HmacSha512Tree().output_prefix_type(),
+              Eq(OutputPrefixType::TINK));
+}
+
+TEST(HmacTree, SameReference) {
+  EXPECT_THAT(MacKeyTemplates::HmacSha256Tree(),
+              Ref(MacKeyTemplates::HmacSha256Tree()));
+  EXPECT_THAT(MacKeyTemplates::HmacSha512Tree(),
+              Ref(MacKeyTemplates::HmacSha512Tree()));
+}
+
+TEST(HmacTree, WorksWithKeyTypeManager) {
+  for (const KeyTemplate* key_template :
+       {&MacKeyTemplates::HmacSha256Tree(),
+        &MacKeyTemplates::HmacSha512Tree()}) {
+    HmacTreeKeyFormat key_format;
+    ASSERT_TRUE(key_format.ParseFromString(key_template->value()));
+    EXPECT_EQ(1 << 20, key_format.params().chunk_size());
+    EXPECT_THAT(HmacTreeKeyManager().ValidateKeyFormat(key_format), IsOk());
+  }
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
@@ -16,19 +16,27 @@
 
 #include "tink/mac/mac_wrapper.h"
 
+#include <cstddef>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "tink/crypto_format.h"
+#include "tink/internal/adaptive_key_order.h"
 #include "tink/internal/monitoring_util.h"
 #include "tink/internal/registry_impl.h"
 #include "tink/internal/util.h"
 #include "tink/mac.h"
 #include "tink/monitoring/monitoring.h"
 #include "tink/primitive_set.h"
+#include "tink/util/request_arena.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
 #include "proto/tink.pb.h"
@@ -51,19 +59,31 @@ class MacSetWrapper : public Mac {
       std::unique_ptr<MonitoringClient> monitoring_compute_client = nullptr,
       std::unique_ptr<MonitoringClient> monitoring_verify_client = nullptr)
       : mac_set_(std::move(mac_set)),
+        key_order_(*mac_set_),
         monitoring_compute_client_(std::move(monitoring_compute_client)),
         monitoring_verify_client_(std::move(monitoring_verify_client)) {}
 
   crypto::tink::util::StatusOr<std::string> ComputeMac(
       absl::string_view data) const override;
 
+  crypto::tink::util::StatusOr<std::vector<std::string>> ComputeMacBatch(
+      absl::Span<const absl::string_view> data) const override;
+
+  crypto::tink::util::StatusOr<absl::string_view> ComputeMacWithArena(
+      absl::string_view data, util::RequestArena* arena) const override;
+
   crypto::tink::util::Status VerifyMac(absl::string_view mac_value,
                                        absl::string_view data) const override;
 
+  crypto::tink::util::StatusOr<std::vector<bool>> VerifyMacBatch(
+      absl::Span<const absl::string_view> macs,
+      absl::Span<const absl::string_view> data) const override;
+
   ~MacSetWrapper() override = default;
 
  private:
   std::unique_ptr<PrimitiveSet<Mac>> mac_set_;
+  internal::PrimitiveSetKeyOrder<Mac> key_order_;
   std::unique_ptr<MonitoringClient> monitoring_compute_client_;
   std::unique_ptr<MonitoringClient> monitoring_verify_client_;
 };
@@ -108,6 +128,74 @@ util::StatusOr<std::string> MacSetWrapper::ComputeMac(
   return key_id + compute_mac_result.value();
 }
 
+util::StatusOr<absl::string_view> MacSetWrapper::ComputeMacWithArena(
+    absl::string_view data, util::RequestArena* arena) const {
+  data = internal::EnsureStringNonNull(data);
+
+  auto primary = mac_set_->get_primary();
+  if (primary->get_output_prefix_type() == OutputPrefixType::LEGACY) {
+    absl::Span<char> local_data = arena->Allocate(data.size() + 1);
+    std::memcpy(local_data.data(), data.data(), data.size());
+    local_data[data.size()] = CryptoFormat::kLegacyStartByte;
+    data = absl::string_view(local_data.data(), local_data.size());
+  }
+  util::StatusOr<absl::string_view> mac_value =
+      primary->get_primitive().ComputeMacWithArena(data, arena);
+  if (!mac_value.ok()) {
+    if (monitoring_compute_client_ != nullptr) {
+      monitoring_compute_client_->LogFailure();
+    }
+    return mac_value.status();
+  }
+  if (monitoring_compute_client_ != nullptr) {
+    monitoring_compute_client_->Log(primary->get_key_id(), data.size());
+  }
+  const std::string& key_id = primary->get_identifier();
+  if (key_id.empty()) {
+    return mac_value;
+  }
+  absl::Span<char> output = arena->Allocate(key_id.size() + mac_value->size());
+  std::memcpy(output.data(), key_id.data(), key_id.size());
+  std::memcpy(output.data() + key_id.size(), mac_value->data(),
+              mac_value->size());
+  return absl::string_view(output.data(), output.size());
+}
+
+util::StatusOr<std::vector<std::string>> MacSetWrapper::ComputeMacBatch(
+    absl::Span<const absl::string_view> data) const {
+  auto primary = mac_set_->get_primary();
+  // LEGACY keys MAC a modified copy of every message; batching brings no
+  // benefit there.
+  if (primary->get_output_prefix_type() == OutputPrefixType::LEGACY) {
+    return Mac::ComputeMacBatch(data);
+  }
+
+  std::vector<absl::string_view> non_null_data(data.begin(), data.end());
+  for (absl::string_view& d : non_null_data) {
+    d = internal::EnsureStringNonNull(d);
+  }
+  util::StatusOr<std::vector<std::string>> compute_mac_result =
+      primary->get_primitive().ComputeMacBatch(non_null_data);
+  if (!compute_mac_result.ok()) {
+    if (monitoring_compute_client_ != nullptr) {
+      monitoring_compute_client_->LogFailure();
+    }
+    return compute_mac_result.status();
+  }
+  if (monitoring_compute_client_ != nullptr) {
+    for (absl::string_view d : non_null_data) {
+      monitoring_compute_client_->Log(primary->get_key_id(), d.size());
+    }
+  }
+  const std::string& key_id = primary->get_identifier();
+  if (!key_id.empty()) {
+    for (std::string& mac : *compute_mac_result) {
+      mac.insert(0, key_id);
+    }
+  }
+  return compute_mac_result;
+}
+
 util::Status MacSetWrapper::VerifyMac(
     absl::string_view mac_value,
     absl::string_view data) const {
@@ -121,23 +209,29 @@ util::Status MacSetWrapper::VerifyMac(
     if (primitives_result.ok()) {
       absl::string_view raw_mac_value =
           mac_value.substr(CryptoFormat::kNonRawPrefixSize);
-      for (auto& mac_entry : *(primitives_result.value())) {
-        std::string legacy_data;
-        absl::string_view view_on_data_or_legacy_data = data;
-        if (mac_entry->get_output_prefix_type() == OutputPrefixType::LEGACY) {
-          legacy_data = absl::StrCat(data, std::string("\x00", 1));
-          view_on_data_or_legacy_data = legacy_data;
-        }
-        Mac& mac = mac_entry->get_primitive();
-        util::Status status =
-            mac.VerifyMac(raw_mac_value, view_on_data_or_legacy_data);
-        if (status.ok()) {
-          if (monitoring_verify_client_ != nullptr) {
-            monitoring_verify_client_->Log(mac_entry->get_key_id(),
-                                           data.size());
-          }
-          return status;
+      const PrimitiveSet<Mac>::Primitives& candidates =
+          *(primitives_result.value());
+      size_t match = 0;
+      if (internal::TryCandidates(
+              key_order_.Get(key_id), candidates.size(), [&](size_t i) {
+                const auto& mac_entry = candidates[i];
+                std::string legacy_data;
+                absl::string_view view_on_data_or_legacy_data = data;
+                if (mac_entry->get_output_prefix_type() ==
+                    OutputPrefixType::LEGACY) {
+                  legacy_data = absl::StrCat(data, std::string("\x00", 1));
+                  view_on_data_or_legacy_data = legacy_data;
+                }
+                match = i;
+                return mac_entry->get_primitive()
+                    .VerifyMac(raw_mac_value, view_on_data_or_legacy_data)
+                    .ok();
+              })) {
+        if (monitoring_verify_client_ != nullptr) {
+          monitoring_verify_client_->Log(candidates[match]->get_key_id(),
+                                         data.size());
         }
+        return util::OkStatus();
       }
     }
   }
@@ -145,15 +239,23 @@ util::Status MacSetWrapper::VerifyMac(
   // No matching key succeeded with verification, try all RAW keys.
   auto raw_primitives_result = mac_set_->get_raw_primitives();
   if (raw_primitives_result.ok()) {
-    for (auto& mac_entry : *(raw_primitives_result.value())) {
-      Mac& mac = mac_entry->get_primitive();
-      util::Status status = mac.VerifyMac(mac_value, data);
-      if (status.ok()) {
-        if (monitoring_verify_client_ != nullptr) {
-          monitoring_verify_client_->Log(mac_entry->get_key_id(), data.size());
-        }
-        return status;
+    const PrimitiveSet<Mac>::Primitives& candidates =
+        *(raw_primitives_result.value());
+    size_t match = 0;
+    if (internal::TryCandidates(
+            key_order_.Get(CryptoFormat::kRawPrefix), candidates.size(),
+            [&](size_t i) {
+              match = i;
+              return candidates[i]
+                  ->get_primitive()
+                  .VerifyMac(mac_value, data)
+                  .ok();
+            })) {
+      if (monitoring_verify_client_ != nullptr) {
+        monitoring_verify_client_->Log(candidates[match]->get_key_id(),
+                                       data.size());
       }
+      return util::OkStatus();
     }
   }
   if (monitoring_verify_client_ != nullptr) {
@@ -164,6 +266,116 @@ util::Status MacSetWrapper::VerifyMac(
                       "verification failed");
 }
 
+util::StatusOr<std::vector<bool>> MacSetWrapper::VerifyMacBatch(
+    absl::Span<const absl::string_view> macs,
+    absl::Span<const absl::string_view> data) const {
+  if (macs.size() != data.size()) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "Number of MACs and number of messages differ");
+  }
+  std::vector<bool> valid(data.size());
+
+  // Verifies the still unverified pairs among `indices` with `mac_entry`,
+  // stripping `prefix_size` bytes from each MAC.
+  auto verify_with = [&](const PrimitiveSet<Mac>::Entry<Mac>& mac_entry,
+                         const std::vector<size_t>& indices,
+                         size_t prefix_size) -> util::StatusOr<size_t> {
+    std::vector<size_t> pending;
+    std::vector<absl::string_view> pending_macs;
+    std::vector<absl::string_view> pending_data;
+    for (size_t i : indices) {
+      if (valid[i]) continue;
+      pending.push_back(i);
+      pending_macs.push_back(
+          internal::EnsureStringNonNull(macs[i].substr(prefix_size)));
+      pending_data.push_back(internal::EnsureStringNonNull(data[i]));
+    }
+    if (pending.empty()) return 0;
+
+    Mac& mac = mac_entry.get_primitive();
+    std::vector<bool> entry_valid(pending.size());
+    if (mac_entry.get_output_prefix_type() == OutputPrefixType::LEGACY) {
+      // LEGACY keys MAC a modified copy of every message.
+      for (size_t j = 0; j < pending.size(); ++j) {
+        std::string legacy_data =
+            absl::StrCat(pending_data[j], std::string("\x00", 1));
+        entry_valid[j] = mac.VerifyMac(pending_macs[j], legacy_data).ok();
+      }
+    } else {
+      util::StatusOr<std::vector<bool>> result =
+          mac.VerifyMacBatch(pending_macs, pending_data);
+      if (!result.ok()) return result.status();
+      entry_valid = *std::move(result);
+    }
+    size_t num_valid = 0;
+    for (size_t j = 0; j < pending.size(); ++j) {
+      if (!entry_valid[j]) continue;
+      valid[pending[j]] = true;
+      ++num_valid;
+      if (monitoring_verify_client_ != nullptr) {
+        monitoring_verify_client_->Log(mac_entry.get_key_id(),
+                                       data[pending[j]].size());
+      }
+    }
+    return num_valid;
+  };
+
+  // Tries the entries of `candidates`, which share the output prefix
+  // `identifier`, on the pairs among `indices`, in the same order as
+  // VerifyMac() would.
+  auto verify_with_all = [&](const PrimitiveSet<Mac>::Primitives& candidates,
+                             absl::string_view identifier,
+                             const std::vector<size_t>& indices,
+                             size_t prefix_size) -> util::Status {
+    size_t num_pending = 0;
+    for (size_t i : indices) {
+      if (!valid[i]) ++num_pending;
+    }
+    return internal::TryCandidatesOnBatch(
+        key_order_.Get(identifier), candidates.size(), num_pending,
+        [&](size_t i) {
+          return verify_with(*candidates[i], indices, prefix_size);
+        });
+  };
+
+  // Group the pairs by the key ID prefix of their MAC, so that each matching
+  // key verifies all of its pairs in a single batch.
+  absl::flat_hash_map<absl::string_view, std::vector<size_t>> by_key_id;
+  std::vector<size_t> all_indices(data.size());
+  for (size_t i = 0; i < data.size(); ++i) {
+    all_indices[i] = i;
+    if (macs[i].size() > CryptoFormat::kNonRawPrefixSize) {
+      by_key_id[macs[i].substr(0, CryptoFormat::kNonRawPrefixSize)].push_back(
+          i);
+    }
+  }
+  for (const auto& key_id_and_indices : by_key_id) {
+    util::StatusOr<const PrimitiveSet<Mac>::Primitives*> primitives =
+        mac_set_->get_primitives(key_id_and_indices.first);
+    if (!primitives.ok()) continue;
+    util::Status status = verify_with_all(
+        **primitives, key_id_and_indices.first, key_id_and_indices.second,
+        CryptoFormat::kNonRawPrefixSize);
+    if (!status.ok()) return status;
+  }
+
+  // Pairs that no matching key verified are tried with all RAW keys.
+  util::StatusOr<const PrimitiveSet<Mac>::Primitives*> raw_primitives =
+      mac_set_->get_raw_primitives();
+  if (raw_primitives.ok()) {
+    util::Status status =
+        verify_with_all(**raw_primitives, CryptoFormat::kRawPrefix,
+                        all_indices, /*prefix_size=*/0);
+    if (!status.ok()) return status;
+  }
+  if (monitoring_verify_client_ != nullptr) {
+    for (size_t i = 0; i < data.size(); ++i) {
+      if (!valid[i]) monitoring_verify_client_->LogFailure();
+    }
+  }
+  return valid;
+}
+
 }  // namespace
 
 util::StatusOr<std::unique_ptr<Mac>> MacWrapper::Wrap(
@@ -19,6 +19,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "absl/strings/str_cat.h"
@@ -29,6 +30,7 @@
 #include "tink/monitoring/monitoring.h"
 #include "tink/monitoring/monitoring_client_mocks.h"
 #include "tink/primitive_set.h"
+#include "tink/util/request_arena.h"
 #include "tink/util/status.h"
 #include "tink/util/test_matchers.h"
 #include "tink/util/test_util.h"
@@ -173,6 +175,63 @@ TEST(MacWrapperTest, testLegacyAuthentication) {
   EXPECT_TRUE(status.ok()) << status;
 }
 
+TEST(MacWrapperTest, ComputeMacBatchMatchesComputeMac) {
+  for (OutputPrefixType prefix_type :
+       {OutputPrefixType::TINK, OutputPrefixType::CRUNCHY,
+        OutputPrefixType::LEGACY, OutputPrefixType::RAW}) {
+    KeysetInfo::KeyInfo key_info;
+    key_info.set_output_prefix_type(prefix_type);
+    key_info.set_key_id(1234543);
+    key_info.set_status(KeyStatusType::ENABLED);
+    std::unique_ptr<PrimitiveSet<Mac>> mac_set(new PrimitiveSet<Mac>());
+    auto entry = mac_set->AddPrimitive(absl::make_unique<DummyMac>("mac"),
+                                       key_info);
+    ASSERT_THAT(entry, IsOk());
+    ASSERT_THAT(mac_set->set_primary(*entry), IsOk());
+    util::StatusOr<std::unique_ptr<Mac>> mac =
+        MacWrapper().Wrap(std::move(mac_set));
+    ASSERT_THAT(mac, IsOk());
+
+    std::vector<absl::string_view> data = {"", "some data", "more data"};
+    util::StatusOr<std::vector<std::string>> tags =
+        (*mac)->ComputeMacBatch(data);
+    ASSERT_THAT(tags, IsOk());
+    ASSERT_EQ(tags->size(), data.size());
+    for (int i = 0; i < data.size(); ++i) {
+      EXPECT_THAT((*mac)->ComputeMac(data[i]), IsOkAndHolds((*tags)[i]));
+      EXPECT_THAT((*mac)->VerifyMac((*tags)[i], data[i]), IsOk());
+    }
+  }
+}
+
+TEST(MacWrapperTest, ComputeMacWithArenaMatchesComputeMac) {
+  util::RequestArena arena;
+  for (OutputPrefixType prefix_type :
+       {OutputPrefixType::TINK, OutputPrefixType::CRUNCHY,
+        OutputPrefixType::LEGACY, OutputPrefixType::RAW}) {
+    KeysetInfo::KeyInfo key_info;
+    key_info.set_output_prefix_type(prefix_type);
+    key_info.set_key_id(1234543);
+    key_info.set_status(KeyStatusType::ENABLED);
+    std::unique_ptr<PrimitiveSet<Mac>> mac_set(new PrimitiveSet<Mac>());
+    auto entry = mac_set->AddPrimitive(absl::make_unique<DummyMac>("mac"),
+                                       key_info);
+    ASSERT_THAT(entry, IsOk());
+    ASSERT_THAT(mac_set->set_primary(*entry), IsOk());
+    util::StatusOr<std::unique_ptr<Mac>> mac =
+        MacWrapper().Wrap(std::move(mac_set));
+    ASSERT_THAT(mac, IsOk());
+
+    std::string data = "some data";
+    util::StatusOr<absl::string_view> tag =
+        (*mac)->ComputeMacWithArena(data, &arena);
+    ASSERT_THAT(tag, IsOk());
+    EXPECT_THAT((*mac)->ComputeMac(data), IsOkAndHolds(std::string(*tag)));
+    EXPECT_THAT((*mac)->VerifyMac(*tag, data), IsOk());
+    arena.Reset();
+  }
+}
+
 // Produces a mac which starts in the same way as a legacy non-raw signature.
 class TryBreakLegacyMac : public Mac {
  public:
@@ -248,6 +307,67 @@ KeysetInfo CreateTestKeysetInfo() {
   return keyset_info;
 }
 
+// Returns a MAC wrapping DummyMacs for the keys in `key_infos`, with the key at
+// `primary` as primary. The DummyMac of key i is named "mac<key_id>".
+util::StatusOr<std::unique_ptr<Mac>> WrapDummyMacs(
+    const std::vector<KeysetInfo::KeyInfo>& key_infos, int primary) {
+  std::unique_ptr<PrimitiveSet<Mac>> mac_set(new PrimitiveSet<Mac>());
+  for (int i = 0; i < key_infos.size(); ++i) {
+    auto entry = mac_set->AddPrimitive(
+        absl::make_unique<DummyMac>(absl::StrCat("mac", key_infos[i].key_id())),
+        key_infos[i]);
+    if (!entry.ok()) return entry.status();
+    if (i == primary) {
+      util::Status status = mac_set->set_primary(*entry);
+      if (!status.ok()) return status;
+    }
+  }
+  return MacWrapper().Wrap(std::move(mac_set));
+}
+
+TEST(MacWrapperTest, VerifyMacBatch) {
+  std::vector<KeysetInfo::KeyInfo> key_infos = {
+      PopulateKeyInfo(1, OutputPrefixType::TINK, KeyStatusType::ENABLED),
+      PopulateKeyInfo(2, OutputPrefixType::LEGACY, KeyStatusType::ENABLED),
+      PopulateKeyInfo(3, OutputPrefixType::RAW, KeyStatusType::ENABLED),
+      PopulateKeyInfo(4, OutputPrefixType::TINK, KeyStatusType::ENABLED)};
+
+  // Tags are produced by wrappers with a single key each.
+  std::vector<std::string> messages;
+  std::vector<std::string> tags;
+  for (const KeysetInfo::KeyInfo& key_info : key_infos) {
+    util::StatusOr<std::unique_ptr<Mac>> single = WrapDummyMacs({key_info}, 0);
+    ASSERT_THAT(single, IsOk());
+    for (absl::string_view data : {"", "some data"}) {
+      util::StatusOr<std::string> tag = (*single)->ComputeMac(data);
+      ASSERT_THAT(tag, IsOk());
+      messages.push_back(std::string(data));
+      tags.push_back(*tag);
+    }
+  }
+  // A tag over different data.
+  messages.push_back("other data");
+  tags.push_back(tags[1]);
+
+  // The verifying keyset does not contain key 4.
+  util::StatusOr<std::unique_ptr<Mac>> mac = WrapDummyMacs(
+      {key_infos[0], key_infos[1], key_infos[2]}, /*primary=*/0);
+  ASSERT_THAT(mac, IsOk());
+  std::vector<absl::string_view> tag_views(tags.begin(), tags.end());
+  std::vector<absl::string_view> data(messages.begin(), messages.end());
+  util::StatusOr<std::vector<bool>> valid =
+      (*mac)->VerifyMacBatch(tag_views, data);
+  ASSERT_THAT(valid, IsOk());
+  EXPECT_EQ(*valid, std::vector<bool>({true, true, true, true, true, true,
+                                       false, false, false}));
+  for (int i = 0; i < data.size(); ++i) {
+    EXPECT_EQ((*mac)->VerifyMac(tag_views[i], data[i]).ok(), (*valid)[i]);
+  }
+
+  EXPECT_THAT((*mac)->VerifyMacBatch(tag_views, {}).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
 // Tests for the monitoring behavior.
 class MacSetWrapperWithMonitoringTest : public Test {
  protected:
@@ -450,6 +570,36 @@ TEST_F(MacSetWrapperWithMonitoringTest,
               StatusIs(absl::StatusCode::kInvalidArgument));
 }
 
+// Tests that VerifyMacBatch logs every pair.
+TEST_F(MacSetWrapperWithMonitoringTest, WrapKeysetWithMonitoringVerifyBatch) {
+  KeysetInfo keyset_info = CreateTestKeysetInfo();
+  const absl::flat_hash_map<std::string, std::string> annotations = {
+      {"key1", "value1"}, {"key2", "value2"}, {"key3", "value3"}};
+  auto mac_primitive_set = absl::make_unique<PrimitiveSet<Mac>>(annotations);
+  util::StatusOr<PrimitiveSet<Mac>::Entry<Mac>*> primary =
+      mac_primitive_set->AddPrimitive(absl::make_unique<DummyMac>("mac0"),
+                                      keyset_info.key_info(0));
+  ASSERT_THAT(primary.status(), IsOk());
+  ASSERT_THAT(mac_primitive_set->set_primary(*primary), IsOk());
+  const uint32_t primary_key_id = keyset_info.key_info(0).key_id();
+
+  util::StatusOr<std::unique_ptr<Mac>> mac =
+      MacWrapper().Wrap(std::move(mac_primitive_set));
+  ASSERT_THAT(mac, IsOkAndHolds(NotNull()));
+
+  constexpr absl::string_view message = "This is some message!";
+  util::StatusOr<std::string> tag = (*mac)->ComputeMac(message);
+  ASSERT_THAT(tag, IsOk());
+
+  std::vector<absl::string_view> tags = {*tag, *tag, "some invalid tag!"};
+  std::vector<absl::string_view> data = {message, message, message};
+  EXPECT_CALL(*verify_monitoring_client_, Log(primary_key_id, message.size()))
+      .Times(2);
+  EXPECT_CALL(*verify_monitoring_client_, LogFailure());
+  EXPECT_THAT((*mac)->VerifyMacBatch(tags, data),
+              IsOkAndHolds(std::vector<bool>({true, true, false})));
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
@@ -0,0 +1,152 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef TINK_PRF_AES_BLOCK_PRF_KEY_MANAGER_H_
+#define TINK_PRF_AES_BLOCK_PRF_KEY_MANAGER_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "tink/core/key_type_manager.h"
+#include "tink/input_stream.h"
+#include "tink/prf/prf_set.h"
+#include "tink/subtle/prf/aes_block_prf.h"
+#include "tink/subtle/random.h"
+#include "tink/util/constants.h"
+#include "tink/util/input_stream_util.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/validation.h"
+#include "proto/aes_block_prf.pb.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+// Key manager for AesBlockPrfKey, a PRF for short inputs of a fixed size; see
+// subtle::AesBlockPrf for the construction and its limits.
+class AesBlockPrfKeyManager
+    : public KeyTypeManager<google::crypto::tink::AesBlockPrfKey,
+                            google::crypto::tink::AesBlockPrfKeyFormat,
+                            List<Prf>> {
+ public:
+  class PrfSetFactory : public PrimitiveFactory<Prf> {
+    crypto::tink::util::StatusOr<std::unique_ptr<Prf>> Create(
+        const google::crypto::tink::AesBlockPrfKey& key) const override {
+      return subtle::AesBlockPrf::New(
+          util::SecretDataFromStringView(key.key_value()),
+          key.params().input_size());
+    }
+  };
+
+  AesBlockPrfKeyManager()
+      : KeyTypeManager(
+            absl::make_unique<AesBlockPrfKeyManager::PrfSetFactory>()) {}
+
+  uint32_t get_version() const override { return 0; }
+
+  google::crypto::tink::KeyData::KeyMaterialType key_material_type()
+      const override {
+    return google::crypto::tink::KeyData::SYMMETRIC;
+  }
+
+  static uint64_t MaxOutputLength() { return subtle::AesBlockPrf::kBlockSize; }
+  const std::string& get_key_type() const override { return key_type_; }
+
+  crypto::tink::util::Status ValidateKey(
+      const google::crypto::tink::AesBlockPrfKey& key) const override {
+    crypto::tink::util::Status status =
+        ValidateVersion(key.version(), get_version());
+    if (!status.ok()) return status;
+    if (key.key_value().size() != kKeySizeInBytes) {
+      return crypto::tink::util::Status(
+          absl::StatusCode::kInvalidArgument,
+          "Invalid AesBlockPrfKey: key_value wrong length.");
+    }
+    return ValidateParams(key.params());
+  }
+
+  crypto::tink::util::Status ValidateKeyFormat(
+      const google::crypto::tink::AesBlockPrfKeyFormat& key_format)
+      const override {
+    crypto::tink::util::Status status =
+        ValidateVersion(key_format.version(), get_version());
+    if (!status.ok()) return status;
+    if (key_format.key_size() != kKeySizeInBytes) {
+      return crypto::tink::util::Status(
+          absl::StatusCode::kInvalidArgument,
+          "Invalid AesBlockPrfKeyFormat: invalid key_size.");
+    }
+    return ValidateParams(key_format.params());
+  }
+
+  crypto::tink::util::StatusOr<google::crypto::tink::AesBlockPrfKey> CreateKey(
+      const google::crypto::tink::AesBlockPrfKeyFormat& key_format)
+      const override {
+    google::crypto::tink::AesBlockPrfKey key;
+    key.set_version(get_version());
+    *key.mutable_params() = key_format.params();
+    key.set_key_value(subtle::Random::GetRandomBytes(key_format.key_size()));
+    return key;
+  }
+
+  crypto::tink::util::StatusOr<google::crypto::tink::AesBlockPrfKey> DeriveKey(
+      const google::crypto::tink::AesBlockPrfKeyFormat& key_format,
+      InputStream* input_stream) const override {
+    crypto::tink::util::Status status = ValidateKeyFormat(key_format);
+    if (!status.ok()) return status;
+    crypto::tink::util::StatusOr<std::string> randomness =
+        ReadBytesFromStream(key_format.key_size(), input_stream);
+    if (!randomness.ok()) return randomness.status();
+    google::crypto::tink::AesBlockPrfKey key;
+    key.set_version(get_version());
+    *key.mutable_params() = key_format.params();
+    key.set_key_value(*randomness);
+    return key;
+  }
+
+ private:
+  crypto::tink::util::Status ValidateParams(
+      const google::crypto::tink::AesBlockPrfParams& params) const {
+    if (params.input_size() < 1 ||
+        params.input_size() > subtle::AesBlockPrf::kMaxInputSize) {
+      return crypto::tink::util::Status(
+          absl::StatusCode::kInvalidArgument,
+          absl::StrCat("Invalid AesBlockPrfParams: input_size must be between "
+                       "1 and ",
+                       subtle::AesBlockPrf::kMaxInputSize, "."));
+    }
+    return util::OkStatus();
+  }
+
+  // As for AesCmacPrfKey, only 256-bit keys are allowed, see
+  // https://www.math.uwaterloo.ca/~ajmeneze/publications/tightness.pdf.
+  const int kKeySizeInBytes = 32;
+
+  const std::string key_type_ = absl::StrCat(
+      kTypeGoogleapisCom, google::crypto::tink::AesBlockPrfKey().GetTypeName());
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_PRF_AES_BLOCK_PRF_KEY_MANAGER_H_
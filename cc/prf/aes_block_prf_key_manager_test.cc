@@ -0,0 +1,180 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/prf/aes_block_prf_key_manager.h"
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "tink/prf/prf_set.h"
+#include "tink/subtle/prf/aes_block_prf.h"
+#include "tink/util/istream_input_stream.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "proto/aes_block_prf.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::IsOkAndHolds;
+using ::google::crypto::tink::AesBlockPrfKey;
+using ::google::crypto::tink::AesBlockPrfKeyFormat;
+using ::testing::Eq;
+using ::testing::Not;
+using ::testing::SizeIs;
+
+std::unique_ptr<InputStream> GetInputStreamForString(const std::string& input) {
+  return absl::make_unique<util::IstreamInputStream>(
+      absl::make_unique<std::stringstream>(input));
+}
+
+AesBlockPrfKeyFormat ValidKeyFormat() {
+  AesBlockPrfKeyFormat format;
+  format.set_key_size(32);
+  format.mutable_params()->set_input_size(16);
+  return format;
+}
+
+TEST(AesBlockPrfKeyManagerTest, Basics) {
+  EXPECT_THAT(AesBlockPrfKeyManager().get_version(), Eq(0));
+  EXPECT_THAT(AesBlockPrfKeyManager().get_key_type(),
+              Eq("type.googleapis.com/google.crypto.tink.AesBlockPrfKey"));
+  EXPECT_THAT(AesBlockPrfKeyManager().key_material_type(),
+              Eq(google::crypto::tink::KeyData::SYMMETRIC));
+}
+
+TEST(AesBlockPrfKeyManagerTest, ValidateEmptyKey) {
+  EXPECT_THAT(AesBlockPrfKeyManager().ValidateKey(AesBlockPrfKey()),
+              Not(IsOk()));
+}
+
+TEST(AesBlockPrfKeyManagerTest, ValidateEmptyKeyFormat) {
+  EXPECT_THAT(
+      AesBlockPrfKeyManager().ValidateKeyFormat(AesBlockPrfKeyFormat()),
+      Not(IsOk()));
+}
+
+TEST(AesBlockPrfKeyManagerTest, ValidateKeyFormatKeySizes) {
+  AesBlockPrfKeyFormat format = ValidKeyFormat();
+  for (int key_size : {0, 16, 24, 31, 33}) {
+    format.set_key_size(key_size);
+    EXPECT_THAT(AesBlockPrfKeyManager().ValidateKeyFormat(format),
+                Not(IsOk()));
+  }
+  format.set_key_size(32);
+  EXPECT_THAT(AesBlockPrfKeyManager().ValidateKeyFormat(format), IsOk());
+}
+
+TEST(AesBlockPrfKeyManagerTest, ValidateKeyFormatInputSizes) {
+  AesBlockPrfKeyFormat format = ValidKeyFormat();
+  for (int input_size : {1, 8, 16, 17, 32}) {
+    format.mutable_params()->set_input_size(input_size);
+    EXPECT_THAT(AesBlockPrfKeyManager().ValidateKeyFormat(format), IsOk());
+  }
+  for (int input_size : {0, 33, 64}) {
+    format.mutable_params()->set_input_size(input_size);
+    EXPECT_THAT(AesBlockPrfKeyManager().ValidateKeyFormat(format),
+                Not(IsOk()));
+  }
+}
+
+TEST(AesBlockPrfKeyManagerTest, CreateKey) {
+  AesBlockPrfKeyFormat format = ValidKeyFormat();
+  util::StatusOr<AesBlockPrfKey> key =
+      AesBlockPrfKeyManager().CreateKey(format);
+  ASSERT_THAT(key, IsOk());
+  EXPECT_THAT(key->version(), Eq(0));
+  EXPECT_THAT(key->key_value(), SizeIs(format.key_size()));
+  EXPECT_THAT(key->params().input_size(), Eq(format.params().input_size()));
+  EXPECT_THAT(AesBlockPrfKeyManager().ValidateKey(*key), IsOk());
+}
+
+TEST(AesBlockPrfKeyManagerTest, ValidateKeyInvalidVersion) {
+  util::StatusOr<AesBlockPrfKey> key =
+      AesBlockPrfKeyManager().CreateKey(ValidKeyFormat());
+  ASSERT_THAT(key, IsOk());
+  key->set_version(1);
+  EXPECT_THAT(AesBlockPrfKeyManager().ValidateKey(*key), Not(IsOk()));
+}
+
+TEST(AesBlockPrfKeyManagerTest, ValidateKeyInvalidInputSize) {
+  util::StatusOr<AesBlockPrfKey> key =
+      AesBlockPrfKeyManager().CreateKey(ValidKeyFormat());
+  ASSERT_THAT(key, IsOk());
+  key->mutable_params()->set_input_size(33);
+  EXPECT_THAT(AesBlockPrfKeyManager().ValidateKey(*key), Not(IsOk()));
+}
+
+TEST(AesBlockPrfKeyManagerTest, GetPrimitive) {
+  util::StatusOr<AesBlockPrfKey> key =
+      AesBlockPrfKeyManager().CreateKey(ValidKeyFormat());
+  ASSERT_THAT(key, IsOk());
+  util::StatusOr<std::unique_ptr<Prf>> manager_prf =
+      AesBlockPrfKeyManager().GetPrimitive<Prf>(*key);
+  ASSERT_THAT(manager_prf, IsOk());
+
+  util::StatusOr<std::unique_ptr<Prf>> direct_prf = subtle::AesBlockPrf::New(
+      util::SecretDataFromStringView(key->key_value()), 16);
+  ASSERT_THAT(direct_prf, IsOk());
+  util::StatusOr<std::string> expected =
+      (*direct_prf)->Compute("0123456789abcdef", 16);
+  ASSERT_THAT(expected, IsOk());
+  EXPECT_THAT((*manager_prf)->Compute("0123456789abcdef", 16),
+              IsOkAndHolds(*expected));
+}
+
+TEST(AesBlockPrfKeyManagerTest, DeriveKeyValid) {
+  std::string bytes = "0123456789abcdef0123456789abcdef";
+  std::unique_ptr<InputStream> input_stream = GetInputStreamForString(bytes);
+  util::StatusOr<AesBlockPrfKey> key = AesBlockPrfKeyManager().DeriveKey(
+      ValidKeyFormat(), input_stream.get());
+  ASSERT_THAT(key, IsOk());
+  EXPECT_THAT(key->version(), Eq(AesBlockPrfKeyManager().get_version()));
+  EXPECT_THAT(key->key_value(), Eq(bytes));
+  EXPECT_THAT(key->params().input_size(), Eq(16));
+}
+
+TEST(AesBlockPrfKeyManagerTest, DeriveKeyNotEnoughRandomness) {
+  std::unique_ptr<InputStream> input_stream =
+      GetInputStreamForString("0123456789abcdef");
+  EXPECT_THAT(AesBlockPrfKeyManager()
+                  .DeriveKey(ValidKeyFormat(), input_stream.get())
+                  .status(),
+              Not(IsOk()));
+}
+
+TEST(AesBlockPrfKeyManagerTest, DeriveKeyInvalidFormat) {
+  AesBlockPrfKeyFormat format = ValidKeyFormat();
+  format.mutable_params()->set_input_size(0);
+  std::unique_ptr<InputStream> input_stream =
+      GetInputStreamForString("0123456789abcdef0123456789abcdef");
+  EXPECT_THAT(
+      AesBlockPrfKeyManager().DeriveKey(format, input_stream.get()).status(),
+      Not(IsOk()));
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
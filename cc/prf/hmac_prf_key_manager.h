@@ -28,9 +28,8 @@
 #include "tink/internal/fips_utils.h"
 #include "tink/key_manager.h"
 #include "tink/subtle/common_enums.h"
-#include "tink/subtle/prf/prf_set_util.h"
+#include "tink/subtle/prf/hmac_prf.h"
 #include "tink/subtle/random.h"
-#include "tink/subtle/stateful_hmac_boringssl.h"
 #include "tink/util/constants.h"
 #include "tink/util/enums.h"
 #include "tink/util/errors.h"
@@ -52,11 +51,9 @@ class HmacPrfKeyManager
   class PrfFactory : public PrimitiveFactory<Prf> {
     crypto::tink::util::StatusOr<std::unique_ptr<Prf>> Create(
         const google::crypto::tink::HmacPrfKey& key) const override {
-      return subtle::CreatePrfFromStatefulMacFactory(
-          absl::make_unique<subtle::StatefulHmacBoringSslFactory>(
-              util::Enums::ProtoToSubtle(key.params().hash()),
-              MaxOutputLength(util::Enums::ProtoToSubtle(key.params().hash())),
-              util::SecretDataFromStringView(key.key_value())));
+      return subtle::HmacPrf::New(
+          util::Enums::ProtoToSubtle(key.params().hash()),
+          util::SecretDataFromStringView(key.key_value()));
     }
   };
 
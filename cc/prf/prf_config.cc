@@ -16,6 +16,7 @@
 #include "tink/prf/prf_config.h"
 
 #include "tink/config/tink_fips.h"
+#include "tink/prf/aes_block_prf_key_manager.h"
 #include "tink/prf/aes_cmac_prf_key_manager.h"
 #include "tink/prf/hkdf_prf_key_manager.h"
 #include "tink/prf/hmac_prf_key_manager.h"
@@ -48,6 +49,12 @@ crypto::tink::util::Status PrfConfig::Register() {
   if (!status.ok()) {
     return status;
   }
+
+  status = Registry::RegisterKeyTypeManager(
+      absl::make_unique<AesBlockPrfKeyManager>(), true);
+  if (!status.ok()) {
+    return status;
+  }
   return util::OkStatus();
 }
 
@@ -16,10 +16,13 @@
 #include "tink/prf/prf_config.h"
 
 #include <list>
+#include <memory>
+#include <string>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "absl/status/status.h"
+#include "tink/config/global_registry.h"
 #include "tink/internal/fips_utils.h"
 #include "tink/keyset_handle.h"
 #include "tink/prf/hmac_prf_key_manager.h"
@@ -27,6 +30,7 @@
 #include "tink/prf/prf_set.h"
 #include "tink/registry.h"
 #include "tink/util/status.h"
+#include "tink/util/statusor.h"
 #include "tink/util/test_matchers.h"
 #include "tink/util/test_util.h"
 
@@ -36,6 +40,7 @@ namespace {
 
 using ::crypto::tink::test::IsOk;
 using ::crypto::tink::test::StatusIs;
+using ::testing::Eq;
 
 class PrfConfigTest : public ::testing::Test {
  protected:
@@ -56,6 +61,27 @@ TEST_F(PrfConfigTest, RegisterWorks) {
               IsOk());
 }
 
+TEST_F(PrfConfigTest, AesBlockPrfWorksWithPrfSet) {
+  if (internal::IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+
+  ASSERT_THAT(PrfConfig::Register(), IsOk());
+  util::StatusOr<std::unique_ptr<KeysetHandle>> handle =
+      KeysetHandle::GenerateNew(PrfKeyTemplates::AesBlock16ByteInput(),
+                                KeyGenConfigGlobalRegistry());
+  ASSERT_THAT(handle, IsOk());
+  util::StatusOr<std::unique_ptr<PrfSet>> prf_set =
+      (*handle)->GetPrimitive<crypto::tink::PrfSet>(ConfigGlobalRegistry());
+  ASSERT_THAT(prf_set, IsOk());
+  util::StatusOr<std::string> output =
+      (*prf_set)->ComputePrimary("0123456789abcdef", 16);
+  ASSERT_THAT(output, IsOk());
+  EXPECT_THAT(output->size(), Eq(16));
+  EXPECT_THAT((*prf_set)->ComputePrimary("too short", 16).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
 // FIPS-only mode tests
 TEST_F(PrfConfigTest, RegisterNonFipsTemplates) {
   if (!internal::IsFipsModeEnabled() || !internal::IsFipsEnabledInSsl()) {
@@ -67,6 +93,7 @@ TEST_F(PrfConfigTest, RegisterNonFipsTemplates) {
   std::list<google::crypto::tink::KeyTemplate> non_fips_key_templates;
   non_fips_key_templates.push_back(PrfKeyTemplates::HkdfSha256());
   non_fips_key_templates.push_back(PrfKeyTemplates::AesCmac());
+  non_fips_key_templates.push_back(PrfKeyTemplates::AesBlock16ByteInput());
 
   for (auto key_template : non_fips_key_templates) {
     auto new_keyset_handle_result =
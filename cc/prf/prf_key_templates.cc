@@ -18,9 +18,11 @@
 #include <memory>
 
 #include "absl/memory/memory.h"
+#include "tink/prf/aes_block_prf_key_manager.h"
 #include "tink/prf/aes_cmac_prf_key_manager.h"
 #include "tink/prf/hkdf_prf_key_manager.h"
 #include "tink/prf/hmac_prf_key_manager.h"
+#include "proto/aes_block_prf.pb.h"
 #include "proto/aes_cmac_prf.pb.h"
 #include "proto/hkdf_prf.pb.h"
 #include "proto/hmac_prf.pb.h"
@@ -30,6 +32,7 @@ namespace tink {
 
 namespace {
 
+using google::crypto::tink::AesBlockPrfKeyFormat;
 using google::crypto::tink::AesCmacPrfKeyFormat;
 using google::crypto::tink::HkdfPrfKeyFormat;
 using google::crypto::tink::HmacPrfKeyFormat;
@@ -76,6 +79,21 @@ std::unique_ptr<google::crypto::tink::KeyTemplate> NewAesCmacTemplate() {
   return key_template;
 }
 
+std::unique_ptr<google::crypto::tink::KeyTemplate> NewAesBlockTemplate(
+    uint32_t input_size) {
+  auto key_template = absl::make_unique<google::crypto::tink::KeyTemplate>();
+  auto aes_block_prf_key_manager = absl::make_unique<AesBlockPrfKeyManager>();
+  key_template->set_type_url(aes_block_prf_key_manager->get_key_type());
+  key_template->set_output_prefix_type(
+      google::crypto::tink::OutputPrefixType::RAW);
+  AesBlockPrfKeyFormat key_format;
+  key_format.set_version(aes_block_prf_key_manager->get_version());
+  key_format.set_key_size(32);
+  key_format.mutable_params()->set_input_size(input_size);
+  key_format.SerializeToString(key_template->mutable_value());
+  return key_template;
+}
+
 }  // namespace
 
 const google::crypto::tink::KeyTemplate& PrfKeyTemplates::HkdfSha256() {
@@ -102,5 +120,25 @@ const google::crypto::tink::KeyTemplate& PrfKeyTemplates::AesCmac() {
   return *key_template;
 }
 
+const google::crypto::tink::KeyTemplate& PrfKeyTemplates::AesBlock8ByteInput() {
+  static const google::crypto::tink::KeyTemplate* key_template =
+      NewAesBlockTemplate(8).release();
+  return *key_template;
+}
+
+const google::crypto::tink::KeyTemplate&
+PrfKeyTemplates::AesBlock16ByteInput() {
+  static const google::crypto::tink::KeyTemplate* key_template =
+      NewAesBlockTemplate(16).release();
+  return *key_template;
+}
+
+const google::crypto::tink::KeyTemplate&
+PrfKeyTemplates::AesBlock32ByteInput() {
+  static const google::crypto::tink::KeyTemplate* key_template =
+      NewAesBlockTemplate(32).release();
+  return *key_template;
+}
+
 }  // namespace tink
 }  // namespace crypto
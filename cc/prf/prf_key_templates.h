@@ -41,6 +41,15 @@ class PrfKeyTemplates {
   static const google::crypto::tink::KeyTemplate& HmacSha256();
   static const google::crypto::tink::KeyTemplate& HmacSha512();
   static const google::crypto::tink::KeyTemplate& AesCmac();
+
+  // AesBlockPrf, for inputs of exactly 8, 16 or 32 bytes (e.g., 64-bit IDs,
+  // UUIDs, or SHA-256 digests of longer identifiers). Other input sizes are
+  // rejected by the PRF.
+  //  * Key size: 256 bit
+  //  * Output: at most 16 bytes
+  static const google::crypto::tink::KeyTemplate& AesBlock8ByteInput();
+  static const google::crypto::tink::KeyTemplate& AesBlock16ByteInput();
+  static const google::crypto::tink::KeyTemplate& AesBlock32ByteInput();
 };
 
 }  // namespace tink
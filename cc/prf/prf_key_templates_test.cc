@@ -19,10 +19,12 @@
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "absl/memory/memory.h"
+#include "tink/prf/aes_block_prf_key_manager.h"
 #include "tink/prf/aes_cmac_prf_key_manager.h"
 #include "tink/prf/hkdf_prf_key_manager.h"
 #include "tink/prf/hmac_prf_key_manager.h"
 #include "tink/util/test_matchers.h"
+#include "proto/aes_block_prf.pb.h"
 #include "proto/aes_cmac_prf.pb.h"
 #include "proto/hmac_prf.pb.h"
 
@@ -110,6 +112,37 @@ TEST(CmacPrfTest, MultipleCallsSameReference) {
   EXPECT_THAT(PrfKeyTemplates::AesCmac(), Ref(PrfKeyTemplates::AesCmac()));
 }
 
+TEST(AesBlockPrfTest, Basics) {
+  auto manager = absl::make_unique<AesBlockPrfKeyManager>();
+  struct {
+    const google::crypto::tink::KeyTemplate& key_template;
+    uint32_t input_size;
+  } test_cases[] = {{PrfKeyTemplates::AesBlock8ByteInput(), 8},
+                    {PrfKeyTemplates::AesBlock16ByteInput(), 16},
+                    {PrfKeyTemplates::AesBlock32ByteInput(), 32}};
+  for (const auto& test_case : test_cases) {
+    EXPECT_THAT(test_case.key_template.type_url(),
+                Eq("type.googleapis.com/google.crypto.tink.AesBlockPrfKey"));
+    EXPECT_THAT(test_case.key_template.type_url(),
+                Eq(manager->get_key_type()));
+    EXPECT_THAT(test_case.key_template.output_prefix_type(),
+                Eq(google::crypto::tink::OutputPrefixType::RAW));
+    google::crypto::tink::AesBlockPrfKeyFormat format;
+    ASSERT_TRUE(format.ParseFromString(test_case.key_template.value()));
+    EXPECT_THAT(format.params().input_size(), Eq(test_case.input_size));
+    EXPECT_THAT(manager->ValidateKeyFormat(format), IsOk());
+  }
+}
+
+TEST(AesBlockPrfTest, MultipleCallsSameReference) {
+  EXPECT_THAT(PrfKeyTemplates::AesBlock8ByteInput(),
+              Ref(PrfKeyTemplates::AesBlock8ByteInput()));
+  EXPECT_THAT(PrfKeyTemplates::AesBlock16ByteInput(),
+              Ref(PrfKeyTemplates::AesBlock16ByteInput()));
+  EXPECT_THAT(PrfKeyTemplates::AesBlock32ByteInput(),
+              Ref(PrfKeyTemplates::AesBlock32ByteInput()));
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
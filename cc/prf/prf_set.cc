@@ -16,16 +16,48 @@
 
 #include "tink/prf/prf_set.h"
 
+#include <cstdint>
+#include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/util/request_arena.h"
+#include "tink/util/statusor.h"
 
 namespace crypto {
 namespace tink {
 
+util::StatusOr<std::vector<std::string>> Prf::ComputeBatch(
+    absl::Span<const absl::string_view> inputs, size_t output_length) const {
+  std::vector<std::string> outputs;
+  outputs.reserve(inputs.size());
+  for (absl::string_view input : inputs) {
+    util::StatusOr<std::string> output = Compute(input, output_length);
+    if (!output.ok()) {
+      return output.status();
+    }
+    outputs.push_back(*std::move(output));
+  }
+  return outputs;
+}
+
+util::StatusOr<absl::string_view> Prf::ComputeWithArena(
+    absl::string_view input, size_t output_length,
+    util::RequestArena* arena) const {
+  util::StatusOr<std::string> output = Compute(input, output_length);
+  if (!output.ok()) {
+    return output.status();
+  }
+  return arena->Copy(*output);
+}
+
 util::StatusOr<std::string> PrfSet::ComputePrimary(absl::string_view input,
                                                    size_t output_length) const {
-  auto prfs = GetPrfs();
+  const std::map<uint32_t, Prf*>& prfs = GetPrfs();
   auto prf_it = prfs.find(GetPrimaryId());
   if (prf_it == prfs.end()) {
     return util::Status(absl::StatusCode::kInternal,
@@ -34,5 +66,17 @@ util::StatusOr<std::string> PrfSet::ComputePrimary(absl::string_view input,
   return prf_it->second->Compute(input, output_length);
 }
 
+util::StatusOr<absl::string_view> PrfSet::ComputePrimaryWithArena(
+    absl::string_view input, size_t output_length,
+    util::RequestArena* arena) const {
+  const std::map<uint32_t, Prf*>& prfs = GetPrfs();
+  auto prf_it = prfs.find(GetPrimaryId());
+  if (prf_it == prfs.end()) {
+    return util::Status(absl::StatusCode::kInternal,
+                        "PrfSet has no PRF for primary ID.");
+  }
+  return prf_it->second->ComputeWithArena(input, output_length, arena);
+}
+
 }  // namespace tink
 }  // namespace crypto
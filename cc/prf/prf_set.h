@@ -19,8 +19,11 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/util/request_arena.h"
 #include "tink/util/statusor.h"
 
 namespace crypto {
@@ -59,6 +62,22 @@ class Prf {
   // algorithm is less than outputLength.
   virtual util::StatusOr<std::string> Compute(absl::string_view input,
                                               size_t output_length) const = 0;
+
+  // Computes the PRF on each element of `inputs` and returns the first
+  // `output_length` bytes of every output, in the same order as `inputs`.
+  // Fails if any single computation fails.
+  // The default implementation calls Compute() once per input;
+  // implementations that can process several independent inputs at once
+  // (e.g., AES-CMAC) override it.
+  virtual util::StatusOr<std::vector<std::string>> ComputeBatch(
+      absl::Span<const absl::string_view> inputs, size_t output_length) const;
+
+  // Like Compute(), but places the output in `arena` instead of a new
+  // std::string. The returned view is valid until `arena` is reset.
+  // The default implementation copies the result of Compute() into `arena`.
+  virtual util::StatusOr<absl::string_view> ComputeWithArena(
+      absl::string_view input, size_t output_length,
+      util::RequestArena* arena) const;
 };
 
 // A Tink Keyset can be converted into a set of PRFs using this primitive. Every
@@ -77,6 +96,11 @@ class PrfSet {
   // See PRF.compute for details of the parameters.
   util::StatusOr<std::string> ComputePrimary(absl::string_view input,
                                              size_t output_length) const;
+  // Like ComputePrimary(), but places the output in `arena`. See
+  // Prf::ComputeWithArena for details.
+  util::StatusOr<absl::string_view> ComputePrimaryWithArena(
+      absl::string_view input, size_t output_length,
+      util::RequestArena* arena) const;
 };
 
 }  // namespace tink
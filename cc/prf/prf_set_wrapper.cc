@@ -25,10 +25,13 @@
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "tink/internal/monitoring_util.h"
 #include "tink/internal/registry_impl.h"
 #include "tink/monitoring/monitoring.h"
 #include "tink/prf/prf_set.h"
+#include "tink/util/request_arena.h"
 #include "tink/util/status.h"
 #include "proto/tink.pb.h"
 
@@ -71,6 +74,44 @@ class MonitoredPrf : public Prf {
     return result.value();
   }
 
+  util::StatusOr<std::vector<std::string>> ComputeBatch(
+      absl::Span<const absl::string_view> inputs,
+      size_t output_length) const override {
+    util::StatusOr<std::vector<std::string>> result =
+        prf_->ComputeBatch(inputs, output_length);
+    if (!result.ok()) {
+      if (monitoring_client_ != nullptr) {
+        monitoring_client_->LogFailure();
+      }
+      return result.status();
+    }
+
+    if (monitoring_client_ != nullptr) {
+      for (absl::string_view input : inputs) {
+        monitoring_client_->Log(key_id_, input.size());
+      }
+    }
+    return result;
+  }
+
+  util::StatusOr<absl::string_view> ComputeWithArena(
+      absl::string_view input, size_t output_length,
+      util::RequestArena* arena) const override {
+    util::StatusOr<absl::string_view> result =
+        prf_->ComputeWithArena(input, output_length, arena);
+    if (!result.ok()) {
+      if (monitoring_client_ != nullptr) {
+        monitoring_client_->LogFailure();
+      }
+      return result.status();
+    }
+
+    if (monitoring_client_ != nullptr) {
+      monitoring_client_->Log(key_id_, input.size());
+    }
+    return result;
+  }
+
  private:
   uint32_t key_id_;
   const Prf* prf_;
@@ -20,6 +20,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -30,6 +31,7 @@
 #include "tink/prf/prf_set.h"
 #include "tink/primitive_set.h"
 #include "tink/registry.h"
+#include "tink/util/request_arena.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
 #include "tink/util/test_matchers.h"
@@ -45,6 +47,7 @@ using ::google::crypto::tink::KeysetInfo;
 using ::google::crypto::tink::KeyStatusType;
 using ::testing::_;
 using ::testing::ByMove;
+using ::testing::ElementsAre;
 using ::testing::Key;
 using ::testing::NiceMock;
 using ::testing::Not;
@@ -144,6 +147,30 @@ TEST_F(PrfSetWrapperTest, WrapTwo) {
               IsOkAndHolds(StrEq("different")));
 }
 
+TEST_F(PrfSetWrapperTest, ComputeBatch) {
+  auto entry = AddPrf("output", MakeKey(1));
+  ASSERT_THAT(entry, IsOk());
+  ASSERT_THAT(PrfSet()->set_primary(entry.value()), IsOk());
+  util::StatusOr<std::unique_ptr<crypto::tink::PrfSet>> wrapped =
+      PrfSetWrapper().Wrap(std::move(PrfSet()));
+  ASSERT_THAT(wrapped, IsOk());
+  std::vector<absl::string_view> inputs = {"input1", "input2"};
+  EXPECT_THAT((*wrapped)->GetPrfs().at(1)->ComputeBatch(inputs, 6),
+              IsOkAndHolds(ElementsAre("output", "output")));
+}
+
+TEST_F(PrfSetWrapperTest, ComputePrimaryWithArena) {
+  auto entry = AddPrf("output", MakeKey(1));
+  ASSERT_THAT(entry, IsOk());
+  ASSERT_THAT(PrfSet()->set_primary(entry.value()), IsOk());
+  util::StatusOr<std::unique_ptr<crypto::tink::PrfSet>> wrapped =
+      PrfSetWrapper().Wrap(std::move(PrfSet()));
+  ASSERT_THAT(wrapped, IsOk());
+  util::RequestArena arena;
+  EXPECT_THAT((*wrapped)->ComputePrimaryWithArena("input", 6, &arena),
+              IsOkAndHolds("output"));
+}
+
 // Tests for the monitoring behavior.
 class PrfSetWrapperWithMonitoringTest : public Test {
  protected:
@@ -242,6 +269,61 @@ TEST_F(PrfSetWrapperWithMonitoringTest, WrapKeysetWithMonitoringVerifySuccess) {
   EXPECT_THAT((*prf_set)->ComputePrimary(input, /*output_length=*/16), IsOk());
 }
 
+TEST_F(PrfSetWrapperWithMonitoringTest, ComputeBatchLogsEveryInput) {
+  auto primitive_set = absl::make_unique<PrimitiveSet<Prf>>();
+  util::StatusOr<PrimitiveSet<Prf>::Entry<Prf>*> entry =
+      primitive_set->AddPrimitive(absl::make_unique<FakePrf>("output"),
+                                  MakeKey(/*id=*/1));
+  ASSERT_THAT(entry, IsOk());
+  ASSERT_THAT(primitive_set->set_primary(entry.value()), IsOk());
+  util::StatusOr<std::unique_ptr<PrfSet>> prf_set =
+      PrfSetWrapper().Wrap(std::move(primitive_set));
+  ASSERT_THAT(prf_set, IsOk());
+
+  std::vector<absl::string_view> inputs = {"a", "bc"};
+  EXPECT_CALL(*monitoring_client_ref_, Log(1, 1));
+  EXPECT_CALL(*monitoring_client_ref_, Log(1, 2));
+  EXPECT_THAT(
+      (*prf_set)->GetPrfs().at(1)->ComputeBatch(inputs, /*output_length=*/16),
+      IsOk());
+}
+
+TEST_F(PrfSetWrapperWithMonitoringTest, ComputeWithArenaLogs) {
+  auto primitive_set = absl::make_unique<PrimitiveSet<Prf>>();
+  util::StatusOr<PrimitiveSet<Prf>::Entry<Prf>*> entry =
+      primitive_set->AddPrimitive(absl::make_unique<FakePrf>("output"),
+                                  MakeKey(/*id=*/1));
+  ASSERT_THAT(entry, IsOk());
+  ASSERT_THAT(primitive_set->set_primary(entry.value()), IsOk());
+  util::StatusOr<std::unique_ptr<PrfSet>> prf_set =
+      PrfSetWrapper().Wrap(std::move(primitive_set));
+  ASSERT_THAT(prf_set, IsOk());
+
+  util::RequestArena arena;
+  EXPECT_CALL(*monitoring_client_ref_, Log(1, 5));
+  EXPECT_THAT((*prf_set)->GetPrfs().at(1)->ComputeWithArena(
+                  "input", /*output_length=*/16, &arena),
+              IsOk());
+}
+
+TEST_F(PrfSetWrapperWithMonitoringTest, ComputeBatchLogsFailure) {
+  auto primitive_set = absl::make_unique<PrimitiveSet<Prf>>();
+  util::StatusOr<PrimitiveSet<Prf>::Entry<Prf>*> entry =
+      primitive_set->AddPrimitive(absl::make_unique<AlwaysFailingPrf>(),
+                                  MakeKey(/*id=*/1));
+  ASSERT_THAT(entry, IsOk());
+  ASSERT_THAT(primitive_set->set_primary(entry.value()), IsOk());
+  util::StatusOr<std::unique_ptr<PrfSet>> prf_set =
+      PrfSetWrapper().Wrap(std::move(primitive_set));
+  ASSERT_THAT(prf_set, IsOk());
+
+  std::vector<absl::string_view> inputs = {"a", "bc"};
+  EXPECT_CALL(*monitoring_client_ref_, LogFailure());
+  EXPECT_THAT(
+      (*prf_set)->GetPrfs().at(1)->ComputeBatch(inputs, /*output_length=*/16),
+      Not(IsOk()));
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
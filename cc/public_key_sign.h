@@ -18,8 +18,11 @@
 #define TINK_PUBLIC_KEY_SIGN_H_
 
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "tink/util/statusor.h"
 
 namespace crypto {
@@ -39,6 +42,24 @@ class PublicKeySign {
   virtual crypto::tink::util::StatusOr<std::string> Sign(
       absl::string_view data) const = 0;
 
+  // Computes the signatures for each element of `data` and returns them in
+  // the same order. Each signature is one Sign() would return for the same
+  // element, and verifies the same way. If signing any element fails, the
+  // whole batch fails. The default implementation calls Sign() on every
+  // element; implementations with an expensive private key operation (e.g.,
+  // RSA) override it to sign several messages concurrently.
+  virtual crypto::tink::util::StatusOr<std::vector<std::string>> SignBatch(
+      absl::Span<const absl::string_view> data) const {
+    std::vector<std::string> signatures;
+    signatures.reserve(data.size());
+    for (absl::string_view d : data) {
+      crypto::tink::util::StatusOr<std::string> signature = Sign(d);
+      if (!signature.ok()) return signature.status();
+      signatures.push_back(*std::move(signature));
+    }
+    return signatures;
+  }
+
   virtual ~PublicKeySign() = default;
 };
 
@@ -23,6 +23,8 @@
 #include "tink/signature/ecdsa_verify_key_manager.h"
 #include "tink/signature/ed25519_sign_key_manager.h"
 #include "tink/signature/ed25519_verify_key_manager.h"
+#include "tink/signature/multi_public_key_sign_wrapper.h"
+#include "tink/signature/multi_public_key_verify_wrapper.h"
 #include "tink/signature/public_key_sign_wrapper.h"
 #include "tink/signature/public_key_verify_wrapper.h"
 #include "tink/signature/rsa_ssa_pkcs1_sign_key_manager.h"
@@ -46,6 +48,16 @@ util::Status AddSignatureV0(Configuration& config) {
   if (!status.ok()) {
     return status;
   }
+  status = ConfigurationImpl::AddPrimitiveWrapper(
+      absl::make_unique<MultiPublicKeySignWrapper>(), config);
+  if (!status.ok()) {
+    return status;
+  }
+  status = ConfigurationImpl::AddPrimitiveWrapper(
+      absl::make_unique<MultiPublicKeyVerifyWrapper>(), config);
+  if (!status.ok()) {
+    return status;
+  }
 
   status = ConfigurationImpl::AddAsymmetricKeyManagers(
       absl::make_unique<EcdsaSignKeyManager>(),
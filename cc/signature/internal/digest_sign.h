@@ -0,0 +1,50 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SIGNATURE_INTERNAL_DIGEST_SIGN_H_
+#define TINK_SIGNATURE_INTERNAL_DIGEST_SIGN_H_
+
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "openssl/evp.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+
+// Implemented by PublicKeySign primitives whose Sign(data) is a private key
+// operation over a single hash of `data`. Callers that sign the same message
+// with several keys can then compute each distinct digest only once.
+class DigestSign {
+ public:
+  virtual ~DigestSign() = default;
+
+  // Returns the hash function that Sign() applies to the message.
+  virtual const EVP_MD* GetDigestMd() const = 0;
+
+  // Computes the signature for a message whose digest under GetDigestMd() is
+  // `digest`. Sign(data) is equivalent to SignDigest(Hash(data)).
+  virtual crypto::tink::util::StatusOr<std::string> SignDigest(
+      absl::string_view digest) const = 0;
+};
+
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SIGNATURE_INTERNAL_DIGEST_SIGN_H_
@@ -0,0 +1,249 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/signature/internal/ecdsa_presignature_pool.h"
+
+#include <pthread.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+
+#include "absl/base/call_once.h"
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
+#include "openssl/bn.h"
+#include "openssl/ec.h"
+#include "tink/internal/bn_util.h"
+#include "tink/internal/ec_util.h"
+#include "tink/internal/fips_utils.h"
+#include "tink/internal/ssl_unique_ptr.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+
+namespace {
+
+// All live pools, for the fork handlers.
+absl::Mutex& PoolsMutex() {
+  static absl::Mutex* mutex = new absl::Mutex();
+  return *mutex;
+}
+
+std::set<EcdsaPresignaturePool*>& Pools() {
+  static auto* pools = new std::set<EcdsaPresignaturePool*>();
+  return *pools;
+}
+
+}  // namespace
+
+util::StatusOr<std::unique_ptr<EcdsaPresignaturePool>>
+EcdsaPresignaturePool::New(subtle::EllipticCurveType curve,
+                           const Params& params) {
+  util::Status status = CheckFipsCompatibility<EcdsaPresignaturePool>();
+  if (!status.ok()) return status;
+  util::StatusOr<const EC_GROUP*> group = CachedEcGroupFromCurveType(curve);
+  if (!group.ok()) return group.status();
+  if (params.capacity == 0 || params.refill_threshold >= params.capacity) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "refill_threshold must be smaller than capacity");
+  }
+
+  static absl::once_flag register_fork_handlers;
+  absl::call_once(register_fork_handlers, []() {
+    pthread_atfork(&EcdsaPresignaturePool::PrepareFork,
+                   &EcdsaPresignaturePool::ParentAfterFork,
+                   &EcdsaPresignaturePool::ChildAfterFork);
+  });
+
+  auto pool = absl::WrapUnique(new EcdsaPresignaturePool(curve, params));
+  {
+    absl::MutexLock lock(&PoolsMutex());
+    Pools().insert(pool.get());
+  }
+  absl::MutexLock lock(&pool->mutex_);
+  pool->StartRefillThread();
+  return std::move(pool);
+}
+
+EcdsaPresignaturePool::EcdsaPresignaturePool(subtle::EllipticCurveType curve,
+                                             const Params& params)
+    : curve_(curve), params_(params), pid_(getpid()) {}
+
+EcdsaPresignaturePool::~EcdsaPresignaturePool() {
+  {
+    absl::MutexLock lock(&PoolsMutex());
+    Pools().erase(this);
+  }
+  std::unique_ptr<std::thread> refill_thread;
+  {
+    absl::MutexLock lock(&mutex_);
+    if (pid_ != getpid()) ResetAfterFork();
+    stopped_ = true;
+    refill_thread = std::move(refill_thread_);
+  }
+  if (refill_thread != nullptr) refill_thread->join();
+}
+
+util::StatusOr<EcdsaPresignature> EcdsaPresignaturePool::Take() {
+  {
+    absl::MutexLock lock(&mutex_);
+    if (pid_ != getpid()) ResetAfterFork();
+    if (refill_thread_ == nullptr) StartRefillThread();
+    if (!presignatures_.empty()) {
+      EcdsaPresignature presignature = std::move(presignatures_.front());
+      presignatures_.pop_front();
+      return std::move(presignature);
+    }
+  }
+  return Compute();
+}
+
+size_t EcdsaPresignaturePool::size() const {
+  absl::MutexLock lock(&mutex_);
+  return presignatures_.size();
+}
+
+util::StatusOr<EcdsaPresignature> EcdsaPresignaturePool::Compute() const {
+  util::StatusOr<const EC_GROUP*> group = CachedEcGroupFromCurveType(curve_);
+  if (!group.ok()) return group.status();
+  util::StatusOr<int32_t> field_size = EcFieldSizeInBytes(curve_);
+  if (!field_size.ok()) return field_size.status();
+  const BIGNUM* order = EC_GROUP_get0_order(*group);
+
+  SslUniquePtr<BN_CTX> ctx(BN_CTX_new());
+  SslUniquePtr<BIGNUM> k(BN_new());
+  SslUniquePtr<BIGNUM> k_inv(BN_new());
+  SslUniquePtr<BIGNUM> r(BN_new());
+  SslUniquePtr<BIGNUM> order_minus_two(BN_dup(order));
+  SslUniquePtr<EC_POINT> point(EC_POINT_new(*group));
+  if (ctx == nullptr || k == nullptr || k_inv == nullptr || r == nullptr ||
+      order_minus_two == nullptr || point == nullptr) {
+    return util::Status(absl::StatusCode::kInternal, "Allocation failed");
+  }
+  BN_set_flags(k.get(), BN_FLG_CONSTTIME);
+  BN_set_flags(k_inv.get(), BN_FLG_CONSTTIME);
+
+  util::StatusOr<EcdsaPresignature> presignature;
+  do {
+    // k is uniform in [1, n - 1]; r = x(k * G) mod n must not be zero.
+    do {
+      if (BN_rand_range(k.get(), order) != 1) {
+        return util::Status(absl::StatusCode::kInternal,
+                            "Could not generate the nonce");
+      }
+    } while (BN_is_zero(k.get()));
+    if (EC_POINT_mul(*group, point.get(), k.get(), nullptr, nullptr,
+                     ctx.get()) != 1 ||
+        EC_POINT_get_affine_coordinates_GFp(*group, point.get(), r.get(),
+                                            nullptr, ctx.get()) != 1 ||
+        BN_nnmod(r.get(), r.get(), order, ctx.get()) != 1) {
+      return util::Status(absl::StatusCode::kInternal,
+                          "Could not compute k * G");
+    }
+  } while (BN_is_zero(r.get()));
+
+  // k^-1 = k^(n - 2) mod n, since n is prime; unlike BN_mod_inverse, this is
+  // constant time.
+  if (BN_sub_word(order_minus_two.get(), 2) != 1 ||
+      BN_mod_exp_mont_consttime(k_inv.get(), k.get(), order_minus_two.get(),
+                                order, ctx.get(), nullptr) != 1) {
+    BN_clear(k.get());
+    return util::Status(absl::StatusCode::kInternal,
+                        "Could not invert the nonce");
+  }
+  BN_clear(k.get());
+
+  util::StatusOr<util::SecretData> k_inv_bytes =
+      BignumToSecretData(k_inv.get(), *field_size);
+  BN_clear(k_inv.get());
+  if (!k_inv_bytes.ok()) return k_inv_bytes.status();
+  util::StatusOr<std::string> r_bytes = BignumToString(r.get(), *field_size);
+  if (!r_bytes.ok()) return r_bytes.status();
+  return EcdsaPresignature{*std::move(k_inv_bytes), *std::move(r_bytes)};
+}
+
+void EcdsaPresignaturePool::StartRefillThread() {
+  if (stopped_ || refill_failed_) return;
+  refill_thread_ = absl::make_unique<std::thread>([this]() { Refill(); });
+}
+
+bool EcdsaPresignaturePool::NeedsRefill() const {
+  return stopped_ || presignatures_.size() <= params_.refill_threshold;
+}
+
+void EcdsaPresignaturePool::Refill() {
+  absl::MutexLock lock(&mutex_);
+  while (true) {
+    mutex_.Await(absl::Condition(this, &EcdsaPresignaturePool::NeedsRefill));
+    while (!stopped_ && presignatures_.size() < params_.capacity) {
+      // Take() does not wait for the computation.
+      mutex_.Unlock();
+      util::StatusOr<EcdsaPresignature> presignature = Compute();
+      mutex_.Lock();
+      if (!presignature.ok()) {
+        // Take() computes presignatures itself from now on and reports the
+        // error, if it persists.
+        refill_failed_ = true;
+        return;
+      }
+      presignatures_.push_back(*std::move(presignature));
+    }
+    if (stopped_) return;
+  }
+}
+
+void EcdsaPresignaturePool::ResetAfterFork() {
+  presignatures_.clear();
+  // The refill thread only exists in the parent process, so it can neither be
+  // joined nor detached here; its handle is leaked instead.
+  refill_thread_.release();  // NOLINT(bugprone-unused-return-value)
+  pid_ = getpid();
+}
+
+// Lock order: PoolsMutex(), then the mutexes of the pools.
+void EcdsaPresignaturePool::PrepareFork() ABSL_NO_THREAD_SAFETY_ANALYSIS {
+  PoolsMutex().Lock();
+  for (EcdsaPresignaturePool* pool : Pools()) pool->mutex_.Lock();
+}
+
+void EcdsaPresignaturePool::ParentAfterFork() ABSL_NO_THREAD_SAFETY_ANALYSIS {
+  for (EcdsaPresignaturePool* pool : Pools()) pool->mutex_.Unlock();
+  PoolsMutex().Unlock();
+}
+
+void EcdsaPresignaturePool::ChildAfterFork() ABSL_NO_THREAD_SAFETY_ANALYSIS {
+  for (EcdsaPresignaturePool* pool : Pools()) {
+    pool->ResetAfterFork();
+    pool->mutex_.Unlock();
+  }
+  PoolsMutex().Unlock();
+}
+
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
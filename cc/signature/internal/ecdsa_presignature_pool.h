@@ -0,0 +1,124 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef TINK_SIGNATURE_INTERNAL_ECDSA_PRESIGNATURE_POOL_H_
+#define TINK_SIGNATURE_INTERNAL_ECDSA_PRESIGNATURE_POOL_H_
+
+#include <sys/types.h>
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "tink/internal/fips_utils.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+
+// The part of an ECDSA signature that does not depend on the key or the
+// message: for a random nonce k, `k_inv` is k^-1 mod n and `r` is the
+// x-coordinate of k*G mod n, both big-endian and padded to the field size.
+struct EcdsaPresignature {
+  util::SecretData k_inv;
+  std::string r;
+};
+
+// A bounded pool of ECDSA presignatures for one curve, refilled by a
+// background thread whenever it runs low. With a presignature at hand, the
+// signer only needs a few modular multiplications instead of a scalar
+// multiplication.
+//
+// Every presignature is handed out at most once: Take() removes it from the
+// pool, and a child process created by fork() starts with an empty pool, so
+// that parent and child never use the same nonce. The pool only depends on
+// the curve and can be shared by the signers of all keys on that curve.
+// This class is thread-safe.
+class EcdsaPresignaturePool {
+ public:
+  struct Params {
+    // Maximal number of presignatures in the pool.
+    size_t capacity;
+    // The pool is refilled up to `capacity` once it holds no more than this
+    // many presignatures. Must be smaller than `capacity`.
+    size_t refill_threshold;
+  };
+
+  static crypto::tink::util::StatusOr<std::unique_ptr<EcdsaPresignaturePool>>
+  New(subtle::EllipticCurveType curve, const Params& params);
+
+  // Stops the refill thread and erases the remaining presignatures.
+  ~EcdsaPresignaturePool();
+
+  // Removes a presignature from the pool and returns it. If the pool is
+  // empty, e.g., under a burst of requests, a fresh presignature is computed
+  // by the calling thread instead of waiting for the refill thread.
+  crypto::tink::util::StatusOr<EcdsaPresignature> Take();
+
+  subtle::EllipticCurveType curve() const { return curve_; }
+
+  // Returns the number of presignatures currently in the pool.
+  size_t size() const;
+
+  static constexpr crypto::tink::internal::FipsCompatibility kFipsStatus =
+      crypto::tink::internal::FipsCompatibility::kNotFips;
+
+ private:
+  EcdsaPresignaturePool(subtle::EllipticCurveType curve, const Params& params);
+
+  // Computes a new presignature for `curve_`.
+  crypto::tink::util::StatusOr<EcdsaPresignature> Compute() const;
+
+  void StartRefillThread() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void Refill();
+  bool NeedsRefill() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // Forgets the presignatures and the refill thread inherited from the parent
+  // process.
+  void ResetAfterFork() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // pthread_atfork() handlers. All pools are locked across fork(), so that
+  // the child process sees consistent pools, which it then empties.
+  static void PrepareFork();
+  static void ParentAfterFork();
+  static void ChildAfterFork();
+
+  const subtle::EllipticCurveType curve_;
+  const Params params_;
+
+  mutable absl::Mutex mutex_;
+  std::deque<EcdsaPresignature> presignatures_ ABSL_GUARDED_BY(mutex_);
+  // Process that filled `presignatures_`. Checked in addition to the fork
+  // handlers, which do not run if a child process is created by other means.
+  pid_t pid_ ABSL_GUARDED_BY(mutex_);
+  std::unique_ptr<std::thread> refill_thread_ ABSL_GUARDED_BY(mutex_);
+  bool refill_failed_ ABSL_GUARDED_BY(mutex_) = false;
+  bool stopped_ ABSL_GUARDED_BY(mutex_) = false;
+};
+
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SIGNATURE_INTERNAL_ECDSA_PRESIGNATURE_POOL_H_
@@ -0,0 +1,229 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/signature/internal/ecdsa_presignature_pool.h"
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>  // NOLINT(build/c++11)
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/status/status.h"
+#include "tink/internal/ec_util.h"
+#include "tink/internal/fips_utils.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::testing::Eq;
+using ::testing::Not;
+using ::testing::SizeIs;
+
+// Waits until `pool` holds `size` presignatures.
+bool WaitForSize(const EcdsaPresignaturePool& pool, size_t size) {
+  for (int i = 0; i < 1000; ++i) {
+    if (pool.size() == size) return true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return false;
+}
+
+TEST(EcdsaPresignaturePoolTest, FillsAndRefills) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  util::StatusOr<std::unique_ptr<EcdsaPresignaturePool>> pool =
+      EcdsaPresignaturePool::New(subtle::EllipticCurveType::NIST_P256,
+                                 {/*capacity=*/8, /*refill_threshold=*/2});
+  ASSERT_THAT(pool, IsOk());
+  ASSERT_TRUE(WaitForSize(**pool, 8));
+
+  // Above the threshold, the pool is not refilled.
+  for (int i = 0; i < 5; ++i) ASSERT_THAT((*pool)->Take(), IsOk());
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_THAT((*pool)->size(), Eq(3));
+
+  ASSERT_THAT((*pool)->Take(), IsOk());
+  EXPECT_TRUE(WaitForSize(**pool, 8));
+}
+
+TEST(EcdsaPresignaturePoolTest, PresignaturesAreNotReused) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  for (subtle::EllipticCurveType curve :
+       {subtle::EllipticCurveType::NIST_P256,
+        subtle::EllipticCurveType::NIST_P384,
+        subtle::EllipticCurveType::NIST_P521}) {
+    util::StatusOr<int32_t> field_size = EcFieldSizeInBytes(curve);
+    ASSERT_THAT(field_size, IsOk());
+    util::StatusOr<std::unique_ptr<EcdsaPresignaturePool>> pool =
+        EcdsaPresignaturePool::New(curve,
+                                   {/*capacity=*/4, /*refill_threshold=*/1});
+    ASSERT_THAT(pool, IsOk());
+    // Takes more presignatures than the pool holds, so that some of them are
+    // computed by the calling thread.
+    std::set<std::string> rs;
+    std::set<std::string> k_invs;
+    for (int i = 0; i < 32; ++i) {
+      util::StatusOr<EcdsaPresignature> presignature = (*pool)->Take();
+      ASSERT_THAT(presignature, IsOk());
+      EXPECT_THAT(presignature->r, SizeIs(*field_size));
+      EXPECT_THAT(presignature->k_inv, SizeIs(*field_size));
+      rs.insert(presignature->r);
+      k_invs.insert(
+          std::string(util::SecretDataAsStringView(presignature->k_inv)));
+    }
+    EXPECT_THAT(rs, SizeIs(32));
+    EXPECT_THAT(k_invs, SizeIs(32));
+  }
+}
+
+TEST(EcdsaPresignaturePoolTest, ConcurrentTake) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  util::StatusOr<std::unique_ptr<EcdsaPresignaturePool>> pool =
+      EcdsaPresignaturePool::New(subtle::EllipticCurveType::NIST_P256,
+                                 {/*capacity=*/16, /*refill_threshold=*/4});
+  ASSERT_THAT(pool, IsOk());
+  constexpr int kNumThreads = 4;
+  constexpr int kTakesPerThread = 25;
+  std::vector<std::vector<std::string>> rs(kNumThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < kTakesPerThread; ++i) {
+        util::StatusOr<EcdsaPresignature> presignature = (*pool)->Take();
+        if (presignature.ok()) rs[t].push_back(presignature->r);
+      }
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+  std::set<std::string> all_rs;
+  for (const std::vector<std::string>& thread_rs : rs) {
+    EXPECT_THAT(thread_rs, SizeIs(kTakesPerThread));
+    all_rs.insert(thread_rs.begin(), thread_rs.end());
+  }
+  EXPECT_THAT(all_rs, SizeIs(kNumThreads * kTakesPerThread));
+}
+
+TEST(EcdsaPresignaturePoolTest, ChildProcessDoesNotReusePresignatures) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  util::StatusOr<std::unique_ptr<EcdsaPresignaturePool>> pool =
+      EcdsaPresignaturePool::New(subtle::EllipticCurveType::NIST_P256,
+                                 {/*capacity=*/4, /*refill_threshold=*/0});
+  ASSERT_THAT(pool, IsOk());
+  ASSERT_TRUE(WaitForSize(**pool, 4));
+
+  int fds[2];
+  ASSERT_EQ(pipe(fds), 0);
+  pid_t pid = fork();
+  ASSERT_GE(pid, 0);
+  if (pid == 0) {
+    // Child: report the size of the inherited pool and one presignature.
+    close(fds[0]);
+    const char size = static_cast<char>((*pool)->size());
+    util::StatusOr<EcdsaPresignature> presignature = (*pool)->Take();
+    if (write(fds[1], &size, 1) != 1 || !presignature.ok() ||
+        write(fds[1], presignature->r.data(), presignature->r.size()) !=
+            static_cast<ssize_t>(presignature->r.size())) {
+      _exit(1);
+    }
+    _exit(0);
+  }
+  close(fds[1]);
+  std::string child_output(33, '\0');
+  size_t read_size = 0;
+  while (read_size < child_output.size()) {
+    ssize_t n = read(fds[0], &child_output[read_size],
+                     child_output.size() - read_size);
+    if (n <= 0) break;
+    read_size += n;
+  }
+  close(fds[0]);
+  int child_status;
+  ASSERT_EQ(waitpid(pid, &child_status, 0), pid);
+  ASSERT_TRUE(WIFEXITED(child_status));
+  ASSERT_EQ(WEXITSTATUS(child_status), 0);
+  ASSERT_EQ(read_size, child_output.size());
+
+  EXPECT_EQ(child_output[0], 0);
+  const std::string child_r = child_output.substr(1);
+  for (int i = 0; i < 4; ++i) {
+    util::StatusOr<EcdsaPresignature> presignature = (*pool)->Take();
+    ASSERT_THAT(presignature, IsOk());
+    EXPECT_NE(presignature->r, child_r);
+  }
+}
+
+TEST(EcdsaPresignaturePoolTest, InvalidParams) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  EXPECT_THAT(EcdsaPresignaturePool::New(subtle::EllipticCurveType::NIST_P256,
+                                         {/*capacity=*/0,
+                                          /*refill_threshold=*/0})
+                  .status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(EcdsaPresignaturePool::New(subtle::EllipticCurveType::NIST_P256,
+                                         {/*capacity=*/4,
+                                          /*refill_threshold=*/4})
+                  .status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(EcdsaPresignaturePool::New(subtle::EllipticCurveType::CURVE25519,
+                                         {/*capacity=*/4,
+                                          /*refill_threshold=*/1})
+                  .status(),
+              Not(IsOk()));
+}
+
+TEST(EcdsaPresignaturePoolTest, FipsMode) {
+  if (!IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Only supported in FIPS-only mode";
+  }
+  EXPECT_THAT(EcdsaPresignaturePool::New(subtle::EllipticCurveType::NIST_P256,
+                                         {/*capacity=*/4,
+                                          /*refill_threshold=*/1})
+                  .status(),
+              StatusIs(absl::StatusCode::kInternal));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
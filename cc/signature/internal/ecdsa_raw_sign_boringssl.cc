@@ -16,6 +16,8 @@
 
 #include "tink/signature/internal/ecdsa_raw_sign_boringssl.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <utility>
@@ -32,10 +34,13 @@
 #include "tink/internal/err_util.h"
 #include "tink/internal/md_util.h"
 #include "tink/internal/ssl_unique_ptr.h"
+#include "tink/internal/ssl_util.h"
 #include "tink/internal/util.h"
+#include "tink/signature/internal/ecdsa_presignature_pool.h"
 #include "tink/subtle/common_enums.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 #include "tink/util/errors.h"
+#include "tink/util/secret_data.h"
 #include "tink/util/statusor.h"
 
 namespace crypto {
@@ -83,6 +88,17 @@ crypto::tink::util::StatusOr<std::string> DerToIeee(absl::string_view der,
   return absl::StrCat(*r, *s);
 }
 
+// Sets `result` to `a`, which must be less than `modulus`, at the full width
+// of `modulus`. Arithmetic on secret scalars then does not depend on their
+// leading zero words. In BoringSSL, BN_mod_add_quick() is constant time and
+// leaves its result at the width of the modulus; OpenSSL trims leading zero
+// words instead, which is why presignatures require BoringSSL.
+bool PadToWidthOf(BIGNUM* result, const BIGNUM* a, const BIGNUM* modulus) {
+  internal::SslUniquePtr<BIGNUM> zero(BN_new());
+  return zero != nullptr &&
+         BN_mod_add_quick(result, a, zero.get(), modulus) == 1;
+}
+
 }  // namespace
 
 // static
@@ -93,13 +109,13 @@ EcdsaRawSignBoringSsl::New(const subtle::SubtleUtilBoringSSL::EcKey& ec_key,
   if (!status.ok()) return status;
 
   // Check curve.
-  util::StatusOr<internal::SslUniquePtr<EC_GROUP>> group =
-      internal::EcGroupFromCurveType(ec_key.curve);
+  util::StatusOr<const EC_GROUP*> group =
+      internal::CachedEcGroupFromCurveType(ec_key.curve);
   if (!group.ok()) {
     return group.status();
   }
   internal::SslUniquePtr<EC_KEY> key(EC_KEY_new());
-  EC_KEY_set_group(key.get(), group->get());
+  EC_KEY_set_group(key.get(), *group);
 
   // Check key.
   util::StatusOr<internal::SslUniquePtr<EC_POINT>> pub_key =
@@ -122,8 +138,54 @@ EcdsaRawSignBoringSsl::New(const subtle::SubtleUtilBoringSSL::EcKey& ec_key,
         absl::StrCat("Invalid private key: ", internal::GetSslErrors()));
   }
 
-  return {
-      absl::WrapUnique(new EcdsaRawSignBoringSsl(std::move(key), encoding))};
+  return {absl::WrapUnique(
+      new EcdsaRawSignBoringSsl(std::move(key), encoding, nullptr))};
+}
+
+// static
+util::StatusOr<std::unique_ptr<EcdsaRawSignBoringSsl>>
+EcdsaRawSignBoringSsl::New(
+    const subtle::SubtleUtilBoringSSL::EcKey& ec_key,
+    subtle::EcdsaSignatureEncoding encoding,
+    std::shared_ptr<EcdsaPresignaturePool> presignatures) {
+  if (!internal::IsBoringSsl()) {
+    return util::Status(absl::StatusCode::kUnimplemented,
+                        "Signing with presignatures requires BoringSSL");
+  }
+  if (presignatures == nullptr || presignatures->curve() != ec_key.curve) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "Presignatures are not for the curve of the key");
+  }
+  util::StatusOr<std::unique_ptr<EcdsaRawSignBoringSsl>> signer =
+      New(ec_key, encoding);
+  if (!signer.ok()) return signer.status();
+
+  // Online signing computes s = k^-1 * (e + r * d) mod n with Montgomery
+  // multiplications, so the private key is kept as d * R^2 mod n: one
+  // multiplication by r then yields r * d * R.
+  const EC_GROUP* group = EC_KEY_get0_group((*signer)->key_.get());
+  const BIGNUM* order = EC_GROUP_get0_order(group);
+  internal::SslUniquePtr<BN_CTX> ctx(BN_CTX_new());
+  internal::SslUniquePtr<BN_MONT_CTX> order_mont(BN_MONT_CTX_new());
+  internal::SslUniquePtr<BIGNUM> private_key_rr(BN_new());
+  if (ctx == nullptr || order_mont == nullptr || private_key_rr == nullptr) {
+    return util::Status(absl::StatusCode::kInternal, "Allocation failed");
+  }
+  BN_set_flags(private_key_rr.get(), BN_FLG_CONSTTIME);
+  if (BN_MONT_CTX_set(order_mont.get(), order, ctx.get()) != 1 ||
+      !PadToWidthOf(private_key_rr.get(),
+                    EC_KEY_get0_private_key((*signer)->key_.get()), order) ||
+      BN_to_montgomery(private_key_rr.get(), private_key_rr.get(),
+                       order_mont.get(), ctx.get()) != 1 ||
+      BN_to_montgomery(private_key_rr.get(), private_key_rr.get(),
+                       order_mont.get(), ctx.get()) != 1) {
+    return util::Status(absl::StatusCode::kInternal,
+                        "Could not prepare the private key");
+  }
+  (*signer)->presignatures_ = std::move(presignatures);
+  (*signer)->order_mont_ = std::move(order_mont);
+  (*signer)->private_key_rr_ = std::move(private_key_rr);
+  return signer;
 }
 
 util::StatusOr<std::string> EcdsaRawSignBoringSsl::Sign(
@@ -132,6 +194,16 @@ util::StatusOr<std::string> EcdsaRawSignBoringSsl::Sign(
   // regardless of whether the size is 0.
   data = internal::EnsureStringNonNull(data);
 
+  if (presignatures_ != nullptr) {
+    util::StatusOr<std::string> signature = SignWithPresignature(data);
+    if (!signature.ok()) return signature.status();
+    if (encoding_ == subtle::EcdsaSignatureEncoding::DER) {
+      return internal::EcSignatureIeeeToDer(EC_KEY_get0_group(key_.get()),
+                                            *signature);
+    }
+    return signature;
+  }
+
   // Compute the raw signature.
   std::vector<uint8_t> buffer(ECDSA_size(key_.get()));
   unsigned int sig_length;
@@ -154,6 +226,86 @@ util::StatusOr<std::string> EcdsaRawSignBoringSsl::Sign(
   return std::string(reinterpret_cast<char*>(buffer.data()), sig_length);
 }
 
+util::StatusOr<std::string> EcdsaRawSignBoringSsl::SignWithPresignature(
+    absl::string_view digest) const {
+  const EC_GROUP* group = EC_KEY_get0_group(key_.get());
+  const BIGNUM* order = EC_GROUP_get0_order(group);
+  const size_t field_size = (EC_GROUP_get_degree(group) + 7) / 8;
+
+  // As in ECDSA_sign(), e consists of the leftmost bits of the digest, up to
+  // the bit length of the order n.
+  const size_t order_bits = BN_num_bits(order);
+  size_t e_size = digest.size();
+  if (8 * e_size > order_bits) e_size = (order_bits + 7) / 8;
+  internal::SslUniquePtr<BIGNUM> e(BN_bin2bn(
+      reinterpret_cast<const uint8_t*>(digest.data()), e_size, nullptr));
+  if (e == nullptr ||
+      (8 * e_size > order_bits &&
+       BN_rshift(e.get(), e.get(), 8 * e_size - order_bits) != 1)) {
+    return util::Status(absl::StatusCode::kInternal,
+                        "Could not convert the digest");
+  }
+
+  internal::SslUniquePtr<BN_CTX> ctx(BN_CTX_new());
+  internal::SslUniquePtr<BIGNUM> e_mont(BN_new());
+  internal::SslUniquePtr<BIGNUM> k_inv(BN_new());
+  internal::SslUniquePtr<BIGNUM> u(BN_new());
+  internal::SslUniquePtr<BIGNUM> s(BN_new());
+  if (ctx == nullptr || e_mont == nullptr || k_inv == nullptr ||
+      u == nullptr || s == nullptr) {
+    return util::Status(absl::StatusCode::kInternal, "Allocation failed");
+  }
+  // e is public, so it is reduced and brought into the Montgomery domain with
+  // variable-time operations.
+  if (BN_nnmod(e.get(), e.get(), order, ctx.get()) != 1 ||
+      BN_to_montgomery(e_mont.get(), e.get(), order_mont_.get(), ctx.get()) !=
+          1) {
+    return util::Status(absl::StatusCode::kInternal,
+                        "Could not convert the digest");
+  }
+  BN_set_flags(k_inv.get(), BN_FLG_CONSTTIME);
+  BN_set_flags(u.get(), BN_FLG_CONSTTIME);
+  BN_set_flags(s.get(), BN_FLG_CONSTTIME);
+  while (true) {
+    util::StatusOr<EcdsaPresignature> presignature = presignatures_->Take();
+    if (!presignature.ok()) return presignature.status();
+    util::StatusOr<internal::SslUniquePtr<BIGNUM>> r =
+        internal::StringToBignum(presignature->r);
+    if (!r.ok()) return r.status();
+    const absl::string_view k_inv_bytes =
+        util::SecretDataAsStringView(presignature->k_inv);
+
+    // All operands of the Montgomery multiplications and of the addition are
+    // reduced and at the full width of n:
+    //   u = r * (d * R^2) * R^-1      = r * d * R
+    //   u = u + e * R                 = (e + r * d) * R
+    //   s = u * k^-1 * R^-1           = k^-1 * (e + r * d)
+    const bool ok =
+        BN_bin2bn(reinterpret_cast<const uint8_t*>(k_inv_bytes.data()),
+                  k_inv_bytes.size(), k_inv.get()) != nullptr &&
+        PadToWidthOf(k_inv.get(), k_inv.get(), order) &&
+        BN_mod_mul_montgomery(u.get(), r->get(), private_key_rr_.get(),
+                              order_mont_.get(), ctx.get()) == 1 &&
+        BN_mod_add_quick(u.get(), u.get(), e_mont.get(), order) == 1 &&
+        BN_mod_mul_montgomery(s.get(), u.get(), k_inv.get(),
+                              order_mont_.get(), ctx.get()) == 1;
+    BN_clear(k_inv.get());
+    BN_clear(u.get());
+    if (!ok) {
+      BN_clear(s.get());
+      return util::Status(absl::StatusCode::kInternal, "Signing failed.");
+    }
+    // s = 0 happens with negligible probability; such a signature would be
+    // invalid, so the next presignature is used instead.
+    if (BN_is_zero(s.get())) continue;
+
+    util::StatusOr<std::string> s_bytes =
+        internal::BignumToString(s.get(), field_size);
+    if (!s_bytes.ok()) return s_bytes.status();
+    return absl::StrCat(presignature->r, *s_bytes);
+  }
+}
+
 }  // namespace internal
 }  // namespace tink
 }  // namespace crypto
@@ -22,11 +22,13 @@
 #include <utility>
 
 #include "absl/strings/string_view.h"
+#include "openssl/bn.h"
 #include "openssl/ec.h"
 #include "openssl/evp.h"
 #include "tink/internal/fips_utils.h"
 #include "tink/internal/ssl_unique_ptr.h"
 #include "tink/public_key_sign.h"
+#include "tink/signature/internal/ecdsa_presignature_pool.h"
 #include "tink/subtle/common_enums.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 #include "tink/util/statusor.h"
@@ -42,6 +44,15 @@ class EcdsaRawSignBoringSsl : public PublicKeySign {
   New(const crypto::tink::internal::EcKey& ec_key,
       subtle::EcdsaSignatureEncoding encoding);
 
+  // As above, but signs with presignatures from `presignatures`, which must
+  // be for the curve of `ec_key`. Signing then costs a few modular
+  // multiplications instead of a scalar multiplication. Requires BoringSSL,
+  // whose BIGNUM arithmetic keeps secret scalars at a fixed width.
+  static crypto::tink::util::StatusOr<std::unique_ptr<EcdsaRawSignBoringSsl>>
+  New(const crypto::tink::internal::EcKey& ec_key,
+      subtle::EcdsaSignatureEncoding encoding,
+      std::shared_ptr<EcdsaPresignaturePool> presignatures);
+
   // Computes the signature for 'data'.
   crypto::tink::util::StatusOr<std::string> Sign(
       absl::string_view data) const override;
@@ -51,11 +62,25 @@ class EcdsaRawSignBoringSsl : public PublicKeySign {
 
  private:
   EcdsaRawSignBoringSsl(internal::SslUniquePtr<EC_KEY> key,
-                        subtle::EcdsaSignatureEncoding encoding)
-      : key_(std::move(key)), encoding_(encoding) {}
+                        subtle::EcdsaSignatureEncoding encoding,
+                        std::shared_ptr<EcdsaPresignaturePool> presignatures)
+      : key_(std::move(key)),
+        encoding_(encoding),
+        presignatures_(std::move(presignatures)) {}
+
+  // Returns the IEEE_P1363 signature of the message with digest `digest`,
+  // using a presignature.
+  crypto::tink::util::StatusOr<std::string> SignWithPresignature(
+      absl::string_view digest) const;
 
   internal::SslUniquePtr<EC_KEY> key_;
   subtle::EcdsaSignatureEncoding encoding_;
+  // Null unless signing with presignatures.
+  std::shared_ptr<EcdsaPresignaturePool> presignatures_;
+  // For signing with presignatures: Montgomery context for the group order n,
+  // and the private key d as d * R^2 mod n at the full width of n.
+  internal::SslUniquePtr<BN_MONT_CTX> order_mont_;
+  internal::SslUniquePtr<BIGNUM> private_key_rr_;
 };
 
 }  // namespace internal
@@ -22,10 +22,13 @@
 
 #include "gtest/gtest.h"
 #include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
 #include "tink/internal/ec_util.h"
 #include "tink/internal/fips_utils.h"
+#include "tink/internal/ssl_util.h"
 #include "tink/public_key_sign.h"
 #include "tink/public_key_verify.h"
+#include "tink/signature/internal/ecdsa_presignature_pool.h"
 #include "tink/subtle/common_enums.h"
 #include "tink/subtle/ecdsa_verify_boringssl.h"
 #include "tink/subtle/subtle_util_boringssl.h"
@@ -290,6 +293,100 @@ TEST(EcdsaRawSignBoringSslTest, FipsFailWithoutBoringCrypto) {
       StatusIs(absl::StatusCode::kInternal));
 }
 
+TEST(EcdsaRawSignBoringSslTest, VerifySignatureWithPresignatures) {
+  if (internal::IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  if (!internal::IsBoringSsl()) {
+    GTEST_SKIP() << "Presignatures are not supported when OpenSSL is used";
+  }
+  struct {
+    subtle::EllipticCurveType curve;
+    subtle::HashType hash;
+  } test_cases[] = {
+      {subtle::EllipticCurveType::NIST_P256, subtle::HashType::SHA256},
+      {subtle::EllipticCurveType::NIST_P384, subtle::HashType::SHA384},
+      // The digest is longer than the order and is truncated.
+      {subtle::EllipticCurveType::NIST_P384, subtle::HashType::SHA512},
+      {subtle::EllipticCurveType::NIST_P521, subtle::HashType::SHA512},
+  };
+  for (const auto& test_case : test_cases) {
+    util::StatusOr<std::unique_ptr<EcdsaPresignaturePool>> pool =
+        EcdsaPresignaturePool::New(test_case.curve,
+                                   {/*capacity=*/4, /*refill_threshold=*/1});
+    ASSERT_THAT(pool, IsOk());
+    std::shared_ptr<EcdsaPresignaturePool> presignatures = *std::move(pool);
+    for (subtle::EcdsaSignatureEncoding encoding :
+         {subtle::EcdsaSignatureEncoding::DER,
+          subtle::EcdsaSignatureEncoding::IEEE_P1363}) {
+      util::StatusOr<EcKey> ec_key =
+          subtle::SubtleUtilBoringSSL::GetNewEcKey(test_case.curve);
+      ASSERT_THAT(ec_key, IsOk());
+      util::StatusOr<std::unique_ptr<EcdsaRawSignBoringSsl>> signer =
+          EcdsaRawSignBoringSsl::New(*ec_key, encoding, presignatures);
+      ASSERT_THAT(signer, IsOk());
+      util::StatusOr<std::unique_ptr<subtle::EcdsaVerifyBoringSsl>> verifier =
+          subtle::EcdsaVerifyBoringSsl::New(*ec_key, test_case.hash, encoding);
+      ASSERT_THAT(verifier, IsOk());
+
+      // More signatures than the pool holds.
+      for (int i = 0; i < 10; ++i) {
+        std::string message = absl::StrCat("message ", i);
+        util::StatusOr<std::string> digest =
+            ComputeDigest(test_case.hash, message);
+        ASSERT_THAT(digest, IsOk());
+        util::StatusOr<std::string> signature = (*signer)->Sign(*digest);
+        ASSERT_THAT(signature, IsOk());
+        EXPECT_THAT((*verifier)->Verify(*signature, message), IsOk());
+        EXPECT_THAT((*verifier)->Verify(*signature, "other message"),
+                    Not(IsOk()));
+      }
+    }
+  }
+}
+
+TEST(EcdsaRawSignBoringSslTest, PresignaturesForOtherCurveFail) {
+  if (internal::IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  if (!internal::IsBoringSsl()) {
+    GTEST_SKIP() << "Presignatures are not supported when OpenSSL is used";
+  }
+  util::StatusOr<std::unique_ptr<EcdsaPresignaturePool>> pool =
+      EcdsaPresignaturePool::New(subtle::EllipticCurveType::NIST_P384,
+                                 {/*capacity=*/4, /*refill_threshold=*/1});
+  ASSERT_THAT(pool, IsOk());
+  util::StatusOr<EcKey> ec_key = subtle::SubtleUtilBoringSSL::GetNewEcKey(
+      subtle::EllipticCurveType::NIST_P256);
+  ASSERT_THAT(ec_key, IsOk());
+  EXPECT_THAT(EcdsaRawSignBoringSsl::New(
+                  *ec_key, subtle::EcdsaSignatureEncoding::DER,
+                  std::shared_ptr<EcdsaPresignaturePool>(*std::move(pool)))
+                  .status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(EcdsaRawSignBoringSslTest, PresignaturesWithOpenSslFail) {
+  if (internal::IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  if (internal::IsBoringSsl()) {
+    GTEST_SKIP() << "Presignatures are supported when BoringSSL is used";
+  }
+  util::StatusOr<std::unique_ptr<EcdsaPresignaturePool>> pool =
+      EcdsaPresignaturePool::New(subtle::EllipticCurveType::NIST_P256,
+                                 {/*capacity=*/4, /*refill_threshold=*/1});
+  ASSERT_THAT(pool, IsOk());
+  util::StatusOr<EcKey> ec_key = subtle::SubtleUtilBoringSSL::GetNewEcKey(
+      subtle::EllipticCurveType::NIST_P256);
+  ASSERT_THAT(ec_key, IsOk());
+  EXPECT_THAT(EcdsaRawSignBoringSsl::New(
+                  *ec_key, subtle::EcdsaSignatureEncoding::DER,
+                  std::shared_ptr<EcdsaPresignaturePool>(*std::move(pool)))
+                  .status(),
+              StatusIs(absl::StatusCode::kUnimplemented));
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace tink
@@ -0,0 +1,59 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SIGNATURE_MULTI_PUBLIC_KEY_SIGN_H_
+#define TINK_SIGNATURE_MULTI_PUBLIC_KEY_SIGN_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+// A signature produced by one key of a keyset.
+struct KeysetSignature {
+  // ID of the key that produced `signature`.
+  uint32_t key_id;
+  // The signature, including the output prefix of the key, i.e., exactly what
+  // a PublicKeySign primitive for that key alone would produce.
+  std::string signature;
+};
+
+// Signs a message with every enabled key of a signature keyset at once, e.g.,
+// for manifests that must stay verifiable by consumers that only know the old
+// or only the new key during a key rotation.
+//
+// Obtained from a private keyset handle with
+// GetPrimitive<MultiPublicKeySign>(); signatures are checked with
+// MultiPublicKeyVerify.
+class MultiPublicKeySign {
+ public:
+  // Computes one signature for 'data' per key of the keyset, in keyset order.
+  // Fails if any single key fails to sign.
+  virtual crypto::tink::util::StatusOr<std::vector<KeysetSignature>>
+  SignWithAllKeys(absl::string_view data) const = 0;
+
+  virtual ~MultiPublicKeySign() = default;
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SIGNATURE_MULTI_PUBLIC_KEY_SIGN_H_
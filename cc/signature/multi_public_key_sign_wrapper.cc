@@ -0,0 +1,213 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/signature/multi_public_key_sign_wrapper.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "openssl/evp.h"
+#include "tink/crypto_format.h"
+#include "tink/internal/monitoring_util.h"
+#include "tink/internal/registry_impl.h"
+#include "tink/internal/run_in_parallel.h"
+#include "tink/internal/util.h"
+#include "tink/monitoring/monitoring.h"
+#include "tink/primitive_set.h"
+#include "tink/public_key_sign.h"
+#include "tink/signature/internal/digest_sign.h"
+#include "tink/signature/multi_public_key_sign.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+using ::google::crypto::tink::OutputPrefixType;
+
+namespace {
+
+constexpr absl::string_view kPrimitive = "public_key_sign";
+constexpr absl::string_view kSignApi = "sign_with_all_keys";
+
+util::Status Validate(PrimitiveSet<PublicKeySign>* public_key_sign_set) {
+  if (public_key_sign_set == nullptr) {
+    return util::Status(absl::StatusCode::kInternal,
+                        "public_key_sign_set must be non-NULL");
+  }
+  if (public_key_sign_set->get_primary() == nullptr) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "public_key_sign_set has no primary");
+  }
+  return util::OkStatus();
+}
+
+// A digest of the message, or of the message followed by the LEGACY start
+// byte, shared by all keys that use the same hash function.
+struct SharedDigest {
+  const EVP_MD* md;
+  bool legacy;
+  std::string value;
+};
+
+class MultiPublicKeySignSetWrapper : public MultiPublicKeySign {
+ public:
+  explicit MultiPublicKeySignSetWrapper(
+      std::unique_ptr<PrimitiveSet<PublicKeySign>> public_key_sign_set,
+      std::unique_ptr<MonitoringClient> monitoring_sign_client = nullptr)
+      : public_key_sign_set_(std::move(public_key_sign_set)),
+        entries_(public_key_sign_set_->get_all_in_keyset_order()),
+        monitoring_sign_client_(std::move(monitoring_sign_client)) {}
+
+  crypto::tink::util::StatusOr<std::vector<KeysetSignature>> SignWithAllKeys(
+      absl::string_view data) const override;
+
+  ~MultiPublicKeySignSetWrapper() override = default;
+
+ private:
+  std::unique_ptr<PrimitiveSet<PublicKeySign>> public_key_sign_set_;
+  std::vector<PrimitiveSet<PublicKeySign>::Entry<PublicKeySign>*> entries_;
+  std::unique_ptr<MonitoringClient> monitoring_sign_client_;
+};
+
+util::StatusOr<std::vector<KeysetSignature>>
+MultiPublicKeySignSetWrapper::SignWithAllKeys(absl::string_view data) const {
+  // BoringSSL expects a non-null pointer for data,
+  // regardless of whether the size is 0.
+  data = internal::EnsureStringNonNull(data);
+
+  std::string legacy_data;
+  std::vector<SharedDigest> digests;
+  // For every entry, the index of its digest in `digests`, or -1 if the
+  // primitive hashes the message itself.
+  std::vector<int> digest_index(entries_.size(), -1);
+  for (size_t i = 0; i < entries_.size(); ++i) {
+    const bool legacy =
+        entries_[i]->get_output_prefix_type() == OutputPrefixType::LEGACY;
+    if (legacy && legacy_data.empty()) {
+      legacy_data = absl::StrCat(data, std::string("\x00", 1));
+    }
+    const auto* digest_sign = dynamic_cast<const internal::DigestSign*>(
+        &entries_[i]->get_primitive());
+    if (digest_sign == nullptr) continue;
+    const EVP_MD* md = digest_sign->GetDigestMd();
+    auto it = std::find_if(digests.begin(), digests.end(),
+                           [&](const SharedDigest& digest) {
+                             return digest.md == md && digest.legacy == legacy;
+                           });
+    if (it == digests.end()) {
+      absl::string_view message = legacy ? legacy_data : data;
+      uint8_t value[EVP_MAX_MD_SIZE];
+      unsigned int value_size = 0;
+      if (EVP_Digest(message.data(), message.size(), value, &value_size, md,
+                     /*impl=*/nullptr) != 1) {
+        if (monitoring_sign_client_ != nullptr) {
+          monitoring_sign_client_->LogFailure();
+        }
+        return util::Status(absl::StatusCode::kInternal,
+                            "Could not compute digest.");
+      }
+      digests.push_back(
+          {md, legacy,
+           std::string(reinterpret_cast<const char*>(value), value_size)});
+      it = digests.end() - 1;
+    }
+    digest_index[i] = it - digests.begin();
+  }
+
+  std::vector<util::StatusOr<std::string>> results(
+      entries_.size(),
+      util::Status(absl::StatusCode::kInternal, "Signing did not run."));
+  internal::RunInParallel(entries_.size(), [&](size_t i) {
+    const PublicKeySign& primitive = entries_[i]->get_primitive();
+    if (digest_index[i] >= 0) {
+      results[i] = dynamic_cast<const internal::DigestSign&>(primitive)
+                       .SignDigest(digests[digest_index[i]].value);
+    } else if (entries_[i]->get_output_prefix_type() ==
+               OutputPrefixType::LEGACY) {
+      results[i] = primitive.Sign(legacy_data);
+    } else {
+      results[i] = primitive.Sign(data);
+    }
+  });
+
+  std::vector<KeysetSignature> signatures;
+  signatures.reserve(entries_.size());
+  for (size_t i = 0; i < entries_.size(); ++i) {
+    if (!results[i].ok()) {
+      if (monitoring_sign_client_ != nullptr) {
+        monitoring_sign_client_->LogFailure();
+      }
+      return results[i].status();
+    }
+    signatures.push_back(
+        {entries_[i]->get_key_id(),
+         absl::StrCat(entries_[i]->get_identifier(), *results[i])});
+  }
+  if (monitoring_sign_client_ != nullptr) {
+    for (const auto* entry : entries_) {
+      monitoring_sign_client_->Log(entry->get_key_id(), data.size());
+    }
+  }
+  return signatures;
+}
+
+}  // namespace
+
+util::StatusOr<std::unique_ptr<MultiPublicKeySign>>
+MultiPublicKeySignWrapper::Wrap(
+    std::unique_ptr<PrimitiveSet<PublicKeySign>> primitive_set) const {
+  util::Status status = Validate(primitive_set.get());
+  if (!status.ok()) return status;
+
+  MonitoringClientFactory* const monitoring_factory =
+      internal::RegistryImpl::GlobalInstance().GetMonitoringClientFactory();
+
+  // Monitoring is not enabled. Create a wrapper without monitoring clients.
+  if (monitoring_factory == nullptr) {
+    return {absl::make_unique<MultiPublicKeySignSetWrapper>(
+        std::move(primitive_set))};
+  }
+
+  util::StatusOr<MonitoringKeySetInfo> keyset_info =
+      internal::MonitoringKeySetInfoFromPrimitiveSet(*primitive_set);
+  if (!keyset_info.ok()) {
+    return keyset_info.status();
+  }
+
+  util::StatusOr<std::unique_ptr<MonitoringClient>> monitoring_sign_client =
+      monitoring_factory->New(
+          MonitoringContext(kPrimitive, kSignApi, *keyset_info));
+  if (!monitoring_sign_client.ok()) {
+    return monitoring_sign_client.status();
+  }
+
+  return {absl::make_unique<MultiPublicKeySignSetWrapper>(
+      std::move(primitive_set), *std::move(monitoring_sign_client))};
+}
+
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,193 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/signature/multi_public_key_sign_wrapper.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "tink/internal/fips_utils.h"
+#include "tink/keyset_handle.h"
+#include "tink/keyset_manager.h"
+#include "tink/primitive_set.h"
+#include "tink/public_key_sign.h"
+#include "tink/public_key_verify.h"
+#include "tink/signature/multi_public_key_sign.h"
+#include "tink/signature/multi_public_key_verify.h"
+#include "tink/signature/signature_config.h"
+#include "tink/signature/signature_key_templates.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "tink/util/test_util.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::test::DummyPublicKeySign;
+using ::crypto::tink::test::DummyPublicKeyVerify;
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::google::crypto::tink::KeysetInfo;
+using ::google::crypto::tink::KeyStatusType;
+using ::google::crypto::tink::KeyTemplate;
+using ::google::crypto::tink::OutputPrefixType;
+using ::testing::HasSubstr;
+using ::testing::SizeIs;
+
+KeysetInfo::KeyInfo MakeKeyInfo(uint32_t key_id,
+                                OutputPrefixType output_prefix_type) {
+  KeysetInfo::KeyInfo key_info;
+  key_info.set_output_prefix_type(output_prefix_type);
+  key_info.set_key_id(key_id);
+  key_info.set_status(KeyStatusType::ENABLED);
+  return key_info;
+}
+
+TEST(MultiPublicKeySignWrapperTest, WrapNullptr) {
+  EXPECT_THAT(MultiPublicKeySignWrapper().Wrap(nullptr).status(),
+              StatusIs(absl::StatusCode::kInternal, HasSubstr("non-NULL")));
+}
+
+TEST(MultiPublicKeySignWrapperTest, WrapEmpty) {
+  EXPECT_THAT(MultiPublicKeySignWrapper()
+                  .Wrap(std::make_unique<PrimitiveSet<PublicKeySign>>())
+                  .status(),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       HasSubstr("no primary")));
+}
+
+TEST(MultiPublicKeySignWrapperTest, SignsWithAllKeysInKeysetOrder) {
+  std::vector<KeysetInfo::KeyInfo> key_infos = {
+      MakeKeyInfo(1234543, OutputPrefixType::RAW),
+      MakeKeyInfo(726329, OutputPrefixType::LEGACY),
+      MakeKeyInfo(7213743, OutputPrefixType::TINK)};
+  auto pk_sign_set = std::make_unique<PrimitiveSet<PublicKeySign>>();
+  for (int i = 0; i < key_infos.size(); ++i) {
+    auto entry = pk_sign_set->AddPrimitive(
+        std::make_unique<DummyPublicKeySign>(absl::StrCat("signature_", i)),
+        key_infos[i]);
+    ASSERT_THAT(entry, IsOk());
+    if (i == 1) {
+      ASSERT_THAT(pk_sign_set->set_primary(*entry), IsOk());
+    }
+  }
+  util::StatusOr<std::unique_ptr<MultiPublicKeySign>> pk_sign =
+      MultiPublicKeySignWrapper().Wrap(std::move(pk_sign_set));
+  ASSERT_THAT(pk_sign, IsOk());
+
+  std::string data = "some data to sign";
+  util::StatusOr<std::vector<KeysetSignature>> signatures =
+      (*pk_sign)->SignWithAllKeys(data);
+  ASSERT_THAT(signatures, IsOk());
+  ASSERT_THAT(*signatures, SizeIs(3));
+
+  // RAW: no prefix.
+  EXPECT_EQ((*signatures)[0].key_id, 1234543);
+  EXPECT_THAT(DummyPublicKeyVerify("signature_0")
+                  .Verify((*signatures)[0].signature, data),
+              IsOk());
+  // LEGACY: 5 byte prefix, signs data || 0x00.
+  EXPECT_EQ((*signatures)[1].key_id, 726329);
+  EXPECT_THAT(DummyPublicKeyVerify("signature_1")
+                  .Verify((*signatures)[1].signature.substr(5),
+                          absl::StrCat(data, std::string("\x00", 1))),
+              IsOk());
+  // TINK: 5 byte prefix.
+  EXPECT_EQ((*signatures)[2].key_id, 7213743);
+  EXPECT_THAT(DummyPublicKeyVerify("signature_2")
+                  .Verify((*signatures)[2].signature.substr(5), data),
+              IsOk());
+}
+
+class MultiPublicKeySignWrapperKeysetTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    if (internal::IsFipsModeEnabled()) {
+      GTEST_SKIP() << "Not supported in FIPS-only mode";
+    }
+    ASSERT_THAT(SignatureConfig::Register(), IsOk());
+  }
+};
+
+TEST_F(MultiPublicKeySignWrapperKeysetTest, SignaturesVerifyWithPublicKeyset) {
+  KeyTemplate legacy_ecdsa = SignatureKeyTemplates::EcdsaP256();
+  legacy_ecdsa.set_output_prefix_type(OutputPrefixType::LEGACY);
+
+  util::StatusOr<std::unique_ptr<KeysetManager>> manager =
+      KeysetManager::New(SignatureKeyTemplates::EcdsaP256());
+  ASSERT_THAT(manager, IsOk());
+  // Keys sharing SHA256 with different prefixes and encodings, a key with
+  // another hash function, and a key that signs the message directly.
+  for (const KeyTemplate& key_template :
+       {legacy_ecdsa, SignatureKeyTemplates::EcdsaP256Ieee(),
+        SignatureKeyTemplates::EcdsaP256Raw(),
+        SignatureKeyTemplates::EcdsaP384Sha384(),
+        SignatureKeyTemplates::RsaSsaPkcs13072Sha256F4(),
+        SignatureKeyTemplates::RsaSsaPss3072Sha256Sha256F4(),
+        SignatureKeyTemplates::Ed25519()}) {
+    ASSERT_THAT((*manager)->Add(key_template), IsOk());
+  }
+  util::StatusOr<uint32_t> disabled_key_id =
+      (*manager)->Add(SignatureKeyTemplates::EcdsaP256());
+  ASSERT_THAT(disabled_key_id, IsOk());
+  ASSERT_THAT((*manager)->Disable(*disabled_key_id), IsOk());
+
+  std::unique_ptr<KeysetHandle> private_handle = (*manager)->GetKeysetHandle();
+  util::StatusOr<std::unique_ptr<KeysetHandle>> public_handle =
+      private_handle->GetPublicKeysetHandle();
+  ASSERT_THAT(public_handle, IsOk());
+
+  util::StatusOr<std::unique_ptr<MultiPublicKeySign>> signer =
+      private_handle->GetPrimitive<MultiPublicKeySign>();
+  ASSERT_THAT(signer, IsOk());
+  util::StatusOr<std::unique_ptr<PublicKeyVerify>> verifier =
+      (*public_handle)->GetPrimitive<PublicKeyVerify>();
+  ASSERT_THAT(verifier, IsOk());
+
+  std::string data = "manifest";
+  util::StatusOr<std::vector<KeysetSignature>> signatures =
+      (*signer)->SignWithAllKeys(data);
+  ASSERT_THAT(signatures, IsOk());
+  ASSERT_THAT(*signatures, SizeIs(8));
+  const KeysetInfo keyset_info = private_handle->GetKeysetInfo();
+  for (int i = 0; i < signatures->size(); ++i) {
+    EXPECT_EQ((*signatures)[i].key_id, keyset_info.key_info(i).key_id());
+    EXPECT_THAT((*verifier)->Verify((*signatures)[i].signature, data), IsOk())
+        << "key " << (*signatures)[i].key_id;
+    EXPECT_THAT((*verifier)->Verify((*signatures)[i].signature, "other data"),
+                StatusIs(absl::StatusCode::kInvalidArgument));
+  }
+
+  util::StatusOr<std::unique_ptr<MultiPublicKeyVerify>> multi_verifier =
+      (*public_handle)->GetPrimitive<MultiPublicKeyVerify>();
+  ASSERT_THAT(multi_verifier, IsOk());
+  EXPECT_THAT((*multi_verifier)->VerifyAll(*signatures, data), IsOk());
+  EXPECT_THAT((*multi_verifier)->VerifyAny(*signatures, data), IsOk());
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
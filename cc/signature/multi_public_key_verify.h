@@ -0,0 +1,52 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SIGNATURE_MULTI_PUBLIC_KEY_VERIFY_H_
+#define TINK_SIGNATURE_MULTI_PUBLIC_KEY_VERIFY_H_
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/signature/multi_public_key_sign.h"
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+
+// Verifies the signatures produced by MultiPublicKeySign against the keys of
+// a public keyset. Each signature is only checked with the keys whose ID
+// matches its `key_id`.
+class MultiPublicKeyVerify {
+ public:
+  // Succeeds if every key of the keyset has a valid signature for 'data' in
+  // 'signatures'. Signatures by keys that are not in the keyset are ignored,
+  // but an invalid signature by a key in the keyset is an error.
+  virtual crypto::tink::util::Status VerifyAll(
+      absl::Span<const KeysetSignature> signatures,
+      absl::string_view data) const = 0;
+
+  // Succeeds if at least one element of 'signatures' is a valid signature for
+  // 'data' by a key of the keyset.
+  virtual crypto::tink::util::Status VerifyAny(
+      absl::Span<const KeysetSignature> signatures,
+      absl::string_view data) const = 0;
+
+  virtual ~MultiPublicKeyVerify() = default;
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SIGNATURE_MULTI_PUBLIC_KEY_VERIFY_H_
@@ -0,0 +1,220 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/signature/multi_public_key_verify_wrapper.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/crypto_format.h"
+#include "tink/internal/monitoring_util.h"
+#include "tink/internal/registry_impl.h"
+#include "tink/internal/util.h"
+#include "tink/monitoring/monitoring.h"
+#include "tink/primitive_set.h"
+#include "tink/public_key_verify.h"
+#include "tink/signature/multi_public_key_sign.h"
+#include "tink/signature/multi_public_key_verify.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+using ::google::crypto::tink::OutputPrefixType;
+
+namespace {
+
+constexpr absl::string_view kPrimitive = "public_key_verify";
+constexpr absl::string_view kVerifyApi = "verify_keyset_signatures";
+
+util::Status Validate(PrimitiveSet<PublicKeyVerify>* public_key_verify_set) {
+  if (public_key_verify_set == nullptr) {
+    return util::Status(absl::StatusCode::kInternal,
+                        "public_key_verify_set must be non-NULL");
+  }
+  if (public_key_verify_set->get_primary() == nullptr) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "public_key_verify_set has no primary");
+  }
+  return util::OkStatus();
+}
+
+class MultiPublicKeyVerifySetWrapper : public MultiPublicKeyVerify {
+ public:
+  explicit MultiPublicKeyVerifySetWrapper(
+      std::unique_ptr<PrimitiveSet<PublicKeyVerify>> public_key_verify_set,
+      std::unique_ptr<MonitoringClient> monitoring_verify_client = nullptr)
+      : public_key_verify_set_(std::move(public_key_verify_set)),
+        monitoring_verify_client_(std::move(monitoring_verify_client)) {
+    for (auto* entry : public_key_verify_set_->get_all_in_keyset_order()) {
+      entries_by_key_id_[entry->get_key_id()].push_back(entry);
+    }
+  }
+
+  crypto::tink::util::Status VerifyAll(
+      absl::Span<const KeysetSignature> signatures,
+      absl::string_view data) const override;
+
+  crypto::tink::util::Status VerifyAny(
+      absl::Span<const KeysetSignature> signatures,
+      absl::string_view data) const override;
+
+  ~MultiPublicKeyVerifySetWrapper() override = default;
+
+ private:
+  using Entry = PrimitiveSet<PublicKeyVerify>::Entry<PublicKeyVerify>;
+
+  // Returns true if `signature` is valid for `data` under one of the keys
+  // with ID `signature.key_id`. Sets `known_key` if there is such a key.
+  bool VerifyOne(const KeysetSignature& signature, absl::string_view data,
+                 bool* known_key) const;
+
+  std::unique_ptr<PrimitiveSet<PublicKeyVerify>> public_key_verify_set_;
+  absl::flat_hash_map<uint32_t, std::vector<Entry*>> entries_by_key_id_;
+  std::unique_ptr<MonitoringClient> monitoring_verify_client_;
+};
+
+bool MultiPublicKeyVerifySetWrapper::VerifyOne(
+    const KeysetSignature& signature, absl::string_view data,
+    bool* known_key) const {
+  auto it = entries_by_key_id_.find(signature.key_id);
+  *known_key = it != entries_by_key_id_.end();
+  if (!*known_key) {
+    return false;
+  }
+  for (const Entry* entry : it->second) {
+    if (!absl::StartsWith(signature.signature, entry->get_identifier())) {
+      continue;
+    }
+    absl::string_view raw_signature = internal::EnsureStringNonNull(
+        absl::string_view(signature.signature)
+            .substr(entry->get_identifier().size()));
+    util::Status status;
+    if (entry->get_output_prefix_type() == OutputPrefixType::LEGACY) {
+      status = entry->get_primitive().Verify(
+          raw_signature, absl::StrCat(data, std::string("\x00", 1)));
+    } else {
+      status = entry->get_primitive().Verify(raw_signature, data);
+    }
+    if (status.ok()) {
+      if (monitoring_verify_client_ != nullptr) {
+        monitoring_verify_client_->Log(entry->get_key_id(), data.size());
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+util::Status MultiPublicKeyVerifySetWrapper::VerifyAll(
+    absl::Span<const KeysetSignature> signatures,
+    absl::string_view data) const {
+  data = internal::EnsureStringNonNull(data);
+
+  absl::flat_hash_set<uint32_t> verified_key_ids;
+  for (const KeysetSignature& signature : signatures) {
+    bool known_key;
+    if (VerifyOne(signature, data, &known_key)) {
+      verified_key_ids.insert(signature.key_id);
+    } else if (known_key) {
+      if (monitoring_verify_client_ != nullptr) {
+        monitoring_verify_client_->LogFailure();
+      }
+      return util::Status(
+          absl::StatusCode::kInvalidArgument,
+          absl::StrCat("Invalid signature by key ", signature.key_id));
+    }
+  }
+  for (const auto& key_id_and_entries : entries_by_key_id_) {
+    if (!verified_key_ids.contains(key_id_and_entries.first)) {
+      if (monitoring_verify_client_ != nullptr) {
+        monitoring_verify_client_->LogFailure();
+      }
+      return util::Status(
+          absl::StatusCode::kInvalidArgument,
+          absl::StrCat("Missing signature by key ", key_id_and_entries.first));
+    }
+  }
+  return util::OkStatus();
+}
+
+util::Status MultiPublicKeyVerifySetWrapper::VerifyAny(
+    absl::Span<const KeysetSignature> signatures,
+    absl::string_view data) const {
+  data = internal::EnsureStringNonNull(data);
+
+  for (const KeysetSignature& signature : signatures) {
+    bool known_key;
+    if (VerifyOne(signature, data, &known_key)) {
+      return util::OkStatus();
+    }
+  }
+  if (monitoring_verify_client_ != nullptr) {
+    monitoring_verify_client_->LogFailure();
+  }
+  return util::Status(absl::StatusCode::kInvalidArgument,
+                      "No valid signature.");
+}
+
+}  // namespace
+
+util::StatusOr<std::unique_ptr<MultiPublicKeyVerify>>
+MultiPublicKeyVerifyWrapper::Wrap(
+    std::unique_ptr<PrimitiveSet<PublicKeyVerify>> primitive_set) const {
+  util::Status status = Validate(primitive_set.get());
+  if (!status.ok()) return status;
+
+  MonitoringClientFactory* const monitoring_factory =
+      internal::RegistryImpl::GlobalInstance().GetMonitoringClientFactory();
+
+  // Monitoring is not enabled. Create a wrapper without monitoring clients.
+  if (monitoring_factory == nullptr) {
+    return {absl::make_unique<MultiPublicKeyVerifySetWrapper>(
+        std::move(primitive_set))};
+  }
+
+  util::StatusOr<MonitoringKeySetInfo> keyset_info =
+      internal::MonitoringKeySetInfoFromPrimitiveSet(*primitive_set);
+  if (!keyset_info.ok()) {
+    return keyset_info.status();
+  }
+
+  util::StatusOr<std::unique_ptr<MonitoringClient>> monitoring_verify_client =
+      monitoring_factory->New(
+          MonitoringContext(kPrimitive, kVerifyApi, *keyset_info));
+  if (!monitoring_verify_client.ok()) {
+    return monitoring_verify_client.status();
+  }
+
+  return {absl::make_unique<MultiPublicKeyVerifySetWrapper>(
+      std::move(primitive_set), *std::move(monitoring_verify_client))};
+}
+
+}  // namespace tink
+}  // namespace crypto
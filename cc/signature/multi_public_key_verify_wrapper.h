@@ -0,0 +1,47 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SIGNATURE_MULTI_PUBLIC_KEY_VERIFY_WRAPPER_H_
+#define TINK_SIGNATURE_MULTI_PUBLIC_KEY_VERIFY_WRAPPER_H_
+
+#include <memory>
+
+#include "tink/primitive_set.h"
+#include "tink/primitive_wrapper.h"
+#include "tink/public_key_verify.h"
+#include "tink/signature/multi_public_key_verify.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+// Wraps a set of PublicKeyVerify-instances that correspond to a keyset into a
+// MultiPublicKeyVerify-primitive.
+class MultiPublicKeyVerifyWrapper
+    : public PrimitiveWrapper<PublicKeyVerify, MultiPublicKeyVerify> {
+ public:
+  // Returns a MultiPublicKeyVerify-primitive that uses the PublicKeyVerify
+  // instances of 'primitive_set', which must be non-NULL and must contain a
+  // primary instance.
+  crypto::tink::util::StatusOr<std::unique_ptr<MultiPublicKeyVerify>> Wrap(
+      std::unique_ptr<PrimitiveSet<PublicKeyVerify>> primitive_set)
+      const override;
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SIGNATURE_MULTI_PUBLIC_KEY_VERIFY_WRAPPER_H_
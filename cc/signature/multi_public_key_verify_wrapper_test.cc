@@ -0,0 +1,190 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/signature/multi_public_key_verify_wrapper.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "tink/crypto_format.h"
+#include "tink/primitive_set.h"
+#include "tink/public_key_verify.h"
+#include "tink/signature/multi_public_key_sign.h"
+#include "tink/signature/multi_public_key_verify.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "tink/util/test_util.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::test::DummyPublicKeySign;
+using ::crypto::tink::test::DummyPublicKeyVerify;
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::google::crypto::tink::KeysetInfo;
+using ::google::crypto::tink::KeyStatusType;
+using ::google::crypto::tink::OutputPrefixType;
+using ::testing::HasSubstr;
+
+constexpr uint32_t kRawKeyId = 1234543;
+constexpr uint32_t kLegacyKeyId = 726329;
+constexpr uint32_t kTinkKeyId = 7213743;
+constexpr uint32_t kUnknownKeyId = 42;
+
+KeysetInfo::KeyInfo MakeKeyInfo(uint32_t key_id,
+                                OutputPrefixType output_prefix_type) {
+  KeysetInfo::KeyInfo key_info;
+  key_info.set_output_prefix_type(output_prefix_type);
+  key_info.set_key_id(key_id);
+  key_info.set_status(KeyStatusType::ENABLED);
+  return key_info;
+}
+
+KeysetSignature Sign(uint32_t key_id, OutputPrefixType output_prefix_type,
+                     absl::string_view signature_name,
+                     absl::string_view data) {
+  KeysetInfo::KeyInfo key_info = MakeKeyInfo(key_id, output_prefix_type);
+  std::string prefix = CryptoFormat::GetOutputPrefix(key_info).value();
+  std::string message(data);
+  if (output_prefix_type == OutputPrefixType::LEGACY) {
+    message.push_back('\x00');
+  }
+  return {key_id,
+          absl::StrCat(prefix,
+                       DummyPublicKeySign(signature_name).Sign(message).value())};
+}
+
+class MultiPublicKeyVerifyWrapperTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    auto pk_verify_set = std::make_unique<PrimitiveSet<PublicKeyVerify>>();
+    ASSERT_THAT(pk_verify_set->AddPrimitive(
+                    std::make_unique<DummyPublicKeyVerify>("raw"),
+                    MakeKeyInfo(kRawKeyId, OutputPrefixType::RAW)),
+                IsOk());
+    ASSERT_THAT(pk_verify_set->AddPrimitive(
+                    std::make_unique<DummyPublicKeyVerify>("legacy"),
+                    MakeKeyInfo(kLegacyKeyId, OutputPrefixType::LEGACY)),
+                IsOk());
+    auto primary = pk_verify_set->AddPrimitive(
+        std::make_unique<DummyPublicKeyVerify>("tink"),
+        MakeKeyInfo(kTinkKeyId, OutputPrefixType::TINK));
+    ASSERT_THAT(primary, IsOk());
+    ASSERT_THAT(pk_verify_set->set_primary(*primary), IsOk());
+
+    util::StatusOr<std::unique_ptr<MultiPublicKeyVerify>> verify =
+        MultiPublicKeyVerifyWrapper().Wrap(std::move(pk_verify_set));
+    ASSERT_THAT(verify, IsOk());
+    verify_ = *std::move(verify);
+  }
+
+  std::vector<KeysetSignature> SignWithAllKeys(absl::string_view data) {
+    return {Sign(kRawKeyId, OutputPrefixType::RAW, "raw", data),
+            Sign(kLegacyKeyId, OutputPrefixType::LEGACY, "legacy", data),
+            Sign(kTinkKeyId, OutputPrefixType::TINK, "tink", data)};
+  }
+
+  std::unique_ptr<MultiPublicKeyVerify> verify_;
+};
+
+TEST(MultiPublicKeyVerifyWrapperWrapTest, WrapNullptr) {
+  EXPECT_THAT(MultiPublicKeyVerifyWrapper().Wrap(nullptr).status(),
+              StatusIs(absl::StatusCode::kInternal, HasSubstr("non-NULL")));
+}
+
+TEST(MultiPublicKeyVerifyWrapperWrapTest, WrapEmpty) {
+  EXPECT_THAT(MultiPublicKeyVerifyWrapper()
+                  .Wrap(std::make_unique<PrimitiveSet<PublicKeyVerify>>())
+                  .status(),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       HasSubstr("no primary")));
+}
+
+TEST_F(MultiPublicKeyVerifyWrapperTest, VerifyAllAndAny) {
+  std::string data = "some data";
+  std::vector<KeysetSignature> signatures = SignWithAllKeys(data);
+  EXPECT_THAT(verify_->VerifyAll(signatures, data), IsOk());
+  EXPECT_THAT(verify_->VerifyAny(signatures, data), IsOk());
+  for (const KeysetSignature& signature : signatures) {
+    EXPECT_THAT(verify_->VerifyAny({signature}, data), IsOk());
+  }
+}
+
+TEST_F(MultiPublicKeyVerifyWrapperTest, WrongData) {
+  std::vector<KeysetSignature> signatures = SignWithAllKeys("some data");
+  EXPECT_THAT(verify_->VerifyAll(signatures, "other data"),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       HasSubstr("Invalid signature")));
+  EXPECT_THAT(verify_->VerifyAny(signatures, "other data"),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST_F(MultiPublicKeyVerifyWrapperTest, MissingSignature) {
+  std::string data = "some data";
+  std::vector<KeysetSignature> signatures = SignWithAllKeys(data);
+  signatures.erase(signatures.begin() + 1);
+  EXPECT_THAT(verify_->VerifyAll(signatures, data),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       HasSubstr(absl::StrCat("Missing signature by key ",
+                                              kLegacyKeyId))));
+  EXPECT_THAT(verify_->VerifyAny(signatures, data), IsOk());
+}
+
+TEST_F(MultiPublicKeyVerifyWrapperTest, InvalidSignatureByKnownKey) {
+  std::string data = "some data";
+  std::vector<KeysetSignature> signatures = SignWithAllKeys(data);
+  // A valid signature by another key does not count for this key.
+  signatures[2].key_id = kLegacyKeyId;
+  EXPECT_THAT(verify_->VerifyAll(signatures, data),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       HasSubstr(absl::StrCat("Invalid signature by key ",
+                                              kLegacyKeyId))));
+  EXPECT_THAT(verify_->VerifyAny({signatures[2]}, data),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST_F(MultiPublicKeyVerifyWrapperTest, SignaturesByUnknownKeysAreIgnored) {
+  std::string data = "some data";
+  std::vector<KeysetSignature> signatures = SignWithAllKeys(data);
+  KeysetSignature unknown =
+      Sign(kUnknownKeyId, OutputPrefixType::TINK, "unknown", data);
+  signatures.push_back(unknown);
+  EXPECT_THAT(verify_->VerifyAll(signatures, data), IsOk());
+  EXPECT_THAT(verify_->VerifyAny({unknown}, data),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       HasSubstr("No valid signature")));
+}
+
+TEST_F(MultiPublicKeyVerifyWrapperTest, EmptySignatures) {
+  EXPECT_THAT(verify_->VerifyAll({}, "some data"),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(verify_->VerifyAny({}, "some data"),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
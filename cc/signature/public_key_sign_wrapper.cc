@@ -19,8 +19,11 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "tink/crypto_format.h"
 #include "tink/internal/monitoring_util.h"
 #include "tink/internal/registry_impl.h"
@@ -64,6 +67,9 @@ class PublicKeySignSetWrapper : public PublicKeySign {
   crypto::tink::util::StatusOr<std::string> Sign(
       absl::string_view data) const override;
 
+  crypto::tink::util::StatusOr<std::vector<std::string>> SignBatch(
+      absl::Span<const absl::string_view> data) const override;
+
   ~PublicKeySignSetWrapper() override = default;
 
  private:
@@ -99,6 +105,41 @@ util::StatusOr<std::string> PublicKeySignSetWrapper::Sign(
   return key_id + sign_result.value();
 }
 
+util::StatusOr<std::vector<std::string>> PublicKeySignSetWrapper::SignBatch(
+    absl::Span<const absl::string_view> data) const {
+  auto primary = public_key_sign_set_->get_primary();
+  // LEGACY keys sign a modified copy of every message; batching brings no
+  // benefit there.
+  if (primary->get_output_prefix_type() == OutputPrefixType::LEGACY) {
+    return PublicKeySign::SignBatch(data);
+  }
+
+  std::vector<absl::string_view> non_null_data(data.begin(), data.end());
+  for (absl::string_view& d : non_null_data) {
+    d = internal::EnsureStringNonNull(d);
+  }
+  util::StatusOr<std::vector<std::string>> sign_result =
+      primary->get_primitive().SignBatch(non_null_data);
+  if (!sign_result.ok()) {
+    if (monitoring_sign_client_ != nullptr) {
+      monitoring_sign_client_->LogFailure();
+    }
+    return sign_result.status();
+  }
+  if (monitoring_sign_client_ != nullptr) {
+    for (absl::string_view d : non_null_data) {
+      monitoring_sign_client_->Log(primary->get_key_id(), d.size());
+    }
+  }
+  const std::string& key_id = primary->get_identifier();
+  if (!key_id.empty()) {
+    for (std::string& signature : *sign_result) {
+      signature.insert(0, key_id);
+    }
+  }
+  return sign_result;
+}
+
 }  // anonymous namespace
 
 util::StatusOr<std::unique_ptr<PublicKeySign>> PublicKeySignWrapper::Wrap(
@@ -19,11 +19,13 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
+#include "absl/strings/string_view.h"
 #include "tink/crypto_format.h"
 #include "tink/internal/registry_impl.h"
 #include "tink/monitoring/monitoring.h"
@@ -182,6 +184,35 @@ TEST(PublicKeySignSetWrapperTest, TestLegacySignatures) {
   EXPECT_TRUE(status.ok()) << status;
 }
 
+TEST(PublicKeySignSetWrapperTest, SignBatchMatchesSign) {
+  for (OutputPrefixType prefix_type :
+       {OutputPrefixType::TINK, OutputPrefixType::LEGACY,
+        OutputPrefixType::RAW}) {
+    KeysetInfo::KeyInfo key;
+    key.set_output_prefix_type(prefix_type);
+    key.set_key_id(1234543);
+    key.set_status(KeyStatusType::ENABLED);
+    auto pk_sign_set = absl::make_unique<PrimitiveSet<PublicKeySign>>();
+    auto entry = pk_sign_set->AddPrimitive(
+        absl::make_unique<DummyPublicKeySign>("SomeSignatures"), key);
+    ASSERT_THAT(entry, IsOk());
+    ASSERT_THAT(pk_sign_set->set_primary(*entry), IsOk());
+    util::StatusOr<std::unique_ptr<PublicKeySign>> pk_sign =
+        PublicKeySignWrapper().Wrap(std::move(pk_sign_set));
+    ASSERT_THAT(pk_sign, IsOk());
+
+    std::vector<absl::string_view> data = {"", "first message",
+                                           "second message"};
+    util::StatusOr<std::vector<std::string>> signatures =
+        (*pk_sign)->SignBatch(data);
+    ASSERT_THAT(signatures, IsOk());
+    ASSERT_EQ(signatures->size(), data.size());
+    for (int i = 0; i < data.size(); ++i) {
+      EXPECT_THAT((*pk_sign)->Sign(data[i]), IsOkAndHolds((*signatures)[i]));
+    }
+  }
+}
+
 KeysetInfo::KeyInfo PopulateKeyInfo(uint32_t key_id,
                                     OutputPrefixType out_prefix_type,
                                     KeyStatusType status) {
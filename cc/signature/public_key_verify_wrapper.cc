@@ -16,6 +16,7 @@
 
 #include "tink/signature/public_key_verify_wrapper.h"
 
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <utility>
@@ -23,6 +24,7 @@
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
 #include "tink/crypto_format.h"
+#include "tink/internal/adaptive_key_order.h"
 #include "tink/internal/monitoring_util.h"
 #include "tink/internal/registry_impl.h"
 #include "tink/internal/util.h"
@@ -61,6 +63,7 @@ class PublicKeyVerifySetWrapper : public PublicKeyVerify {
       std::unique_ptr<PrimitiveSet<PublicKeyVerify>> public_key_verify_set,
       std::unique_ptr<MonitoringClient> monitoring_verify_client = nullptr)
       : public_key_verify_set_(std::move(public_key_verify_set)),
+      key_order_(*public_key_verify_set_),
       monitoring_verify_client_(std::move(monitoring_verify_client)) {}
 
   crypto::tink::util::Status Verify(absl::string_view signature,
@@ -70,6 +73,7 @@ class PublicKeyVerifySetWrapper : public PublicKeyVerify {
 
  private:
   std::unique_ptr<PrimitiveSet<PublicKeyVerify>> public_key_verify_set_;
+  internal::PrimitiveSetKeyOrder<PublicKeyVerify> key_order_;
   std::unique_ptr<MonitoringClient> monitoring_verify_client_;
 };
 
@@ -92,40 +96,51 @@ util::Status PublicKeyVerifySetWrapper::Verify(absl::string_view signature,
   if (primitives_result.ok()) {
     absl::string_view raw_signature =
         signature.substr(CryptoFormat::kNonRawPrefixSize);
-    for (auto& entry : *(primitives_result.value())) {
-      std::string legacy_data;
-      absl::string_view view_on_data_or_legacy_data = data;
-      if (entry->get_output_prefix_type() == OutputPrefixType::LEGACY) {
-        legacy_data = absl::StrCat(data, std::string("\x00", 1));
-        view_on_data_or_legacy_data = legacy_data;
-      }
-      auto& public_key_verify = entry->get_primitive();
-      auto verify_result =
-          public_key_verify.Verify(raw_signature, view_on_data_or_legacy_data);
-      if (verify_result.ok()) {
-        if (monitoring_verify_client_ != nullptr) {
-          monitoring_verify_client_->Log(entry->get_key_id(), data.size());
-        }
-        return util::OkStatus();
-      } else {
-        // LOG that a matching key didn't verify the signature.
+    const PrimitiveSet<PublicKeyVerify>::Primitives& candidates =
+        *(primitives_result.value());
+    size_t match = 0;
+    if (internal::TryCandidates(
+            key_order_.Get(key_id), candidates.size(), [&](size_t i) {
+              const auto& entry = candidates[i];
+              std::string legacy_data;
+              absl::string_view view_on_data_or_legacy_data = data;
+              if (entry->get_output_prefix_type() == OutputPrefixType::LEGACY) {
+                legacy_data = absl::StrCat(data, std::string("\x00", 1));
+                view_on_data_or_legacy_data = legacy_data;
+              }
+              match = i;
+              return entry->get_primitive()
+                  .Verify(raw_signature, view_on_data_or_legacy_data)
+                  .ok();
+            })) {
+      if (monitoring_verify_client_ != nullptr) {
+        monitoring_verify_client_->Log(candidates[match]->get_key_id(),
+                                       data.size());
       }
+      return util::OkStatus();
     }
   }
 
   // No matching key succeeded with verification, try all RAW keys.
   auto raw_primitives_result = public_key_verify_set_->get_raw_primitives();
   if (raw_primitives_result.ok()) {
-    for (auto& public_key_verify_entry : *(raw_primitives_result.value())) {
-      auto& public_key_verify = public_key_verify_entry->get_primitive();
-      auto verify_result = public_key_verify.Verify(signature, data);
-      if (verify_result.ok()) {
-        if (monitoring_verify_client_ != nullptr) {
-          monitoring_verify_client_->Log(public_key_verify_entry->get_key_id(),
-                                         data.size());
-        }
-        return util::OkStatus();
+    const PrimitiveSet<PublicKeyVerify>::Primitives& candidates =
+        *(raw_primitives_result.value());
+    size_t match = 0;
+    if (internal::TryCandidates(
+            key_order_.Get(CryptoFormat::kRawPrefix), candidates.size(),
+            [&](size_t i) {
+              match = i;
+              return candidates[i]
+                  ->get_primitive()
+                  .Verify(signature, data)
+                  .ok();
+            })) {
+      if (monitoring_verify_client_ != nullptr) {
+        monitoring_verify_client_->Log(candidates[match]->get_key_id(),
+                                       data.size());
       }
+      return util::OkStatus();
     }
   }
   if (monitoring_verify_client_ != nullptr) {
@@ -23,6 +23,8 @@
 #include "tink/signature/ecdsa_verify_key_manager.h"
 #include "tink/signature/ed25519_sign_key_manager.h"
 #include "tink/signature/ed25519_verify_key_manager.h"
+#include "tink/signature/multi_public_key_sign_wrapper.h"
+#include "tink/signature/multi_public_key_verify_wrapper.h"
 #include "tink/signature/public_key_sign_wrapper.h"
 #include "tink/signature/public_key_verify_wrapper.h"
 #include "tink/signature/rsa_ssa_pkcs1_proto_serialization.h"
@@ -47,6 +49,12 @@ util::Status SignatureConfig::Register() {
   status = Registry::RegisterPrimitiveWrapper(
       absl::make_unique<PublicKeyVerifyWrapper>());
   if (!status.ok()) return status;
+  status = Registry::RegisterPrimitiveWrapper(
+      absl::make_unique<MultiPublicKeySignWrapper>());
+  if (!status.ok()) return status;
+  status = Registry::RegisterPrimitiveWrapper(
+      absl::make_unique<MultiPublicKeyVerifyWrapper>());
+  if (!status.ok()) return status;
 
   // Register key managers which utilize FIPS validated BoringCrypto
   // implementations.
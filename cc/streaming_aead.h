@@ -17,12 +17,18 @@
 #ifndef TINK_STREAMING_AEAD_H_
 #define TINK_STREAMING_AEAD_H_
 
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <utility>
 
+#include "absl/status/status.h"
 #include "absl/strings/string_view.h"
 #include "tink/input_stream.h"
 #include "tink/output_stream.h"
 #include "tink/random_access_stream.h"
+#include "tink/util/buffer.h"
+#include "tink/util/status.h"
 #include "tink/util/statusor.h"
 
 namespace crypto {
@@ -39,6 +45,102 @@ namespace tink {
 // of the ciphertext.
 class StreamingAead {
  public:
+  // Push-style encryption of a single ciphertext stream, for callers that
+  // cannot block on an OutputStream (e.g., event loops writing to
+  // non-blocking sockets). The produced ciphertext is identical to the one
+  // written by NewEncryptingStream().
+  class PushEncrypter {
+   public:
+    // Encrypts the next 'plaintext' bytes of the stream, and appends all
+    // ciphertext bytes that became available to '*ciphertext'. Since only the
+    // last segment is encrypted differently, up to one segment of plaintext
+    // is held back until more plaintext arrives or Finalize() is called.
+    virtual crypto::tink::util::Status Update(absl::string_view plaintext,
+                                              std::string* ciphertext) = 0;
+
+    // Encrypts the remaining plaintext as the last segment and appends the
+    // rest of the ciphertext to '*ciphertext'. No other method may be called
+    // afterwards.
+    virtual crypto::tink::util::Status Finalize(std::string* ciphertext) = 0;
+
+    virtual ~PushEncrypter() = default;
+  };
+
+  // Push-style decryption of a single ciphertext stream. Ciphertext bytes can
+  // be fed in chunks of arbitrary size as they arrive; plaintext is released
+  // one segment at a time, as soon as the segment authenticates. The
+  // plaintext is complete and authentic only once Finalize() returns OK.
+  class PushDecrypter {
+   public:
+    // Appends 'ciphertext' to the stream, and appends the plaintext of all
+    // segments that authenticated to '*plaintext'. Returns an error as soon
+    // as the ciphertext is known to be invalid; the decrypter is then unusable.
+    virtual crypto::tink::util::Status Update(absl::string_view ciphertext,
+                                              std::string* plaintext) = 0;
+
+    // Signals the end of the ciphertext stream, checks that it is not
+    // truncated and appends the plaintext of the last segment to
+    // '*plaintext'. No other method may be called afterwards.
+    virtual crypto::tink::util::Status Finalize(std::string* plaintext) = 0;
+
+    virtual ~PushDecrypter() = default;
+  };
+
+  // Continues an existing ciphertext stream, e.g., an encrypted log file that
+  // is reopened to append more records. Only the last segment of the existing
+  // ciphertext is decrypted and rewritten; everything before it is kept as is.
+  //
+  // Appending has two limitations that follow from the ciphertext format, in
+  // which the nonce of a segment depends on whether it is the last one:
+  //  - Small appends are not supported. Every append must fill the rest of
+  //    the current last segment and start a new one (see min_append_size()),
+  //    which can be up to a full ciphertext segment of plaintext. Callers
+  //    that append small records must buffer them until enough plaintext is
+  //    available, or start a new stream.
+  //  - Appends are not crash-safe. The last segment is overwritten in place,
+  //    so a crash during an append can leave a stream that no longer
+  //    decrypts, and it cannot be safely rolled back (see
+  //    ciphertext_rewrite_offset()). Callers that need crash safety must
+  //    write the appended stream to a copy and atomically replace the
+  //    original, e.g., with rename().
+  class Appender {
+   public:
+    // Returns the offset in the existing ciphertext from which on it is
+    // replaced by the ciphertext written by the stream that
+    // NewAppendingStream() returns. The bytes before this offset are never
+    // modified. The replaced part is at most one ciphertext segment.
+    //
+    // Do not restore the replaced bytes after an interrupted append and then
+    // append other data: the next append would encrypt the replaced segment
+    // again under the same nonce with a different plaintext, which breaks the
+    // confidentiality and authenticity of the stream if the interrupted write
+    // was ever persisted. To recover from an interrupted append, either
+    // finish it by appending byte-identical plaintext, or decrypt the stream
+    // and encrypt it into a new one.
+    virtual int64_t ciphertext_rewrite_offset() const = 0;
+
+    // Returns the minimal number of plaintext bytes that a non-empty append
+    // must add. Encrypting the last segment again as the last segment would
+    // reuse its nonce, so every append must extend the stream to a new
+    // segment.
+    virtual int64_t min_append_size() const = 0;
+
+    // Returns a wrapper around 'ciphertext_destination' such that any bytes
+    // written via the wrapper are appended to the plaintext of the existing
+    // ciphertext. 'ciphertext_destination' must write the ciphertext starting
+    // at ciphertext_rewrite_offset(). Nothing is written to it before the
+    // rewritten segment is final, and Close() fails without writing anything
+    // if fewer than min_append_size() bytes were appended, unless nothing was
+    // appended at all. ByteCount() of the wrapper returns the number of
+    // appended plaintext bytes. May only be called once.
+    virtual crypto::tink::util::StatusOr<
+        std::unique_ptr<crypto::tink::OutputStream>>
+    NewAppendingStream(
+        std::unique_ptr<crypto::tink::OutputStream> ciphertext_destination) = 0;
+
+    virtual ~Appender() = default;
+  };
+
   // Returns a wrapper around 'ciphertext_destination', such that any bytes
   // written via the wrapper are AEAD-encrypted using 'associated_data' as
   // associated authenticated data. The associated data is not included in the
@@ -77,6 +179,76 @@ class StreamingAead {
       std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source,
       absl::string_view associated_data) const = 0;
 
+  // Authenticates the whole ciphertext in 'ciphertext_source' using
+  // 'associated_data' as associated authenticated data, without producing any
+  // plaintext. Returns OK if and only if decrypting the whole ciphertext would
+  // succeed. This is meant for integrity scrubbing of stored ciphertexts.
+  // On failure, if 'first_invalid_segment' is non-null, it is set to the
+  // number of the first ciphertext segment that failed to authenticate, or
+  // to -1 if the failure cannot be attributed to a segment (e.g., a corrupted
+  // header, or an implementation that does not track segments).
+  // The default implementation reads the whole plaintext through
+  // NewDecryptingRandomAccessStream() and discards it; segment-based
+  // implementations override it to check only the tags, in parallel if
+  // enabled with EnableParallelism() (see config/parallelism.h).
+  virtual crypto::tink::util::Status VerifyCiphertext(
+      std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source,
+      absl::string_view associated_data, int64_t* first_invalid_segment) const {
+    if (first_invalid_segment != nullptr) *first_invalid_segment = -1;
+    crypto::tink::util::StatusOr<
+        std::unique_ptr<crypto::tink::RandomAccessStream>>
+        plaintext = NewDecryptingRandomAccessStream(
+            std::move(ciphertext_source), associated_data);
+    if (!plaintext.ok()) return plaintext.status();
+    constexpr int kChunkSize = 1 << 16;
+    crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::util::Buffer>>
+        buffer = crypto::tink::util::Buffer::New(kChunkSize);
+    if (!buffer.ok()) return buffer.status();
+    int64_t position = 0;
+    while (true) {
+      crypto::tink::util::Status status =
+          (*plaintext)->PRead(position, kChunkSize, buffer->get());
+      if (absl::IsOutOfRange(status)) return crypto::tink::util::OkStatus();
+      if (!status.ok()) return status;
+      position += (*buffer)->size();
+    }
+  }
+
+  // Returns a PushEncrypter that encrypts a new ciphertext stream using
+  // 'associated_data' as associated authenticated data.
+  // Implementations that do not support push-style encryption return an
+  // UNIMPLEMENTED error.
+  virtual crypto::tink::util::StatusOr<std::unique_ptr<PushEncrypter>>
+  NewPushEncrypter(absl::string_view associated_data) const {
+    return crypto::tink::util::Status(
+        absl::StatusCode::kUnimplemented,
+        "Push-style encryption is not supported");
+  }
+
+  // Returns a PushDecrypter that decrypts a ciphertext stream using
+  // 'associated_data' as associated authenticated data.
+  // Implementations that do not support push-style decryption return an
+  // UNIMPLEMENTED error.
+  virtual crypto::tink::util::StatusOr<std::unique_ptr<PushDecrypter>>
+  NewPushDecrypter(absl::string_view associated_data) const {
+    return crypto::tink::util::Status(
+        absl::StatusCode::kUnimplemented,
+        "Push-style decryption is not supported");
+  }
+
+  // Returns an Appender that continues the ciphertext stream in
+  // 'ciphertext_source', which must have been encrypted using
+  // 'associated_data' as associated authenticated data. The last segment of
+  // the stream is authenticated before the Appender is returned.
+  // Implementations that do not support appending return an UNIMPLEMENTED
+  // error.
+  virtual crypto::tink::util::StatusOr<std::unique_ptr<Appender>> NewAppender(
+      std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source,
+      absl::string_view associated_data) const {
+    return crypto::tink::util::Status(absl::StatusCode::kUnimplemented,
+                                      "Appending is not supported");
+  }
+
   virtual ~StreamingAead() = default;
 };
 
@@ -16,11 +16,15 @@
 
 #include "tink/streamingaead/streaming_aead_wrapper.h"
 
+#include <cstdint>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
+#include "absl/memory/memory.h"
 #include "absl/status/status.h"
+#include "absl/strings/string_view.h"
 #include "tink/crypto_format.h"
 #include "tink/input_stream.h"
 #include "tink/output_stream.h"
@@ -29,6 +33,7 @@
 #include "tink/streaming_aead.h"
 #include "tink/streamingaead/decrypting_input_stream.h"
 #include "tink/streamingaead/decrypting_random_access_stream.h"
+#include "tink/streamingaead/shared_random_access_stream.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
 
@@ -52,6 +57,71 @@ Status Validate(PrimitiveSet<StreamingAead>* primitives) {
   return util::OkStatus();
 }
 
+// Decrypts with the first key whose PushDecrypter authenticates the
+// ciphertext. Until then, the ciphertext is fed to the PushDecrypters of all
+// keys that did not fail yet; as a wrong key fails on the first segment, this
+// buffers at most one segment per key.
+class PushDecrypterSet : public StreamingAead::PushDecrypter {
+ public:
+  explicit PushDecrypterSet(
+      std::vector<std::unique_ptr<StreamingAead::PushDecrypter>> candidates)
+      : candidates_(std::move(candidates)) {}
+
+  Status Update(absl::string_view ciphertext, std::string* plaintext) override {
+    if (selected_ != nullptr) return selected_->Update(ciphertext, plaintext);
+    if (plaintext == nullptr) {
+      return Status(absl::StatusCode::kInvalidArgument,
+                    "plaintext must be non-null");
+    }
+    auto it = candidates_.begin();
+    while (it != candidates_.end()) {
+      std::string candidate_plaintext;
+      if (!(*it)->Update(ciphertext, &candidate_plaintext).ok()) {
+        it = candidates_.erase(it);
+        continue;
+      }
+      if (!candidate_plaintext.empty()) {
+        // A segment authenticated under this key.
+        selected_ = std::move(*it);
+        candidates_.clear();
+        plaintext->append(candidate_plaintext);
+        return util::OkStatus();
+      }
+      ++it;
+    }
+    if (candidates_.empty()) return NoMatchingKeyError();
+    return util::OkStatus();
+  }
+
+  Status Finalize(std::string* plaintext) override {
+    if (selected_ != nullptr) return selected_->Finalize(plaintext);
+    if (plaintext == nullptr) {
+      return Status(absl::StatusCode::kInvalidArgument,
+                    "plaintext must be non-null");
+    }
+    for (std::unique_ptr<StreamingAead::PushDecrypter>& candidate :
+         candidates_) {
+      std::string candidate_plaintext;
+      if (candidate->Finalize(&candidate_plaintext).ok()) {
+        candidates_.clear();
+        plaintext->append(candidate_plaintext);
+        return util::OkStatus();
+      }
+    }
+    candidates_.clear();
+    return NoMatchingKeyError();
+  }
+
+ private:
+  static Status NoMatchingKeyError() {
+    return Status(absl::StatusCode::kInvalidArgument,
+                  "Could not find a decrypter matching the ciphertext stream.");
+  }
+
+  std::vector<std::unique_ptr<StreamingAead::PushDecrypter>> candidates_;
+  std::unique_ptr<StreamingAead::PushDecrypter> selected_;
+};
+
 class StreamingAeadSetWrapper: public StreamingAead {
  public:
   explicit StreamingAeadSetWrapper(
@@ -74,6 +144,21 @@ class StreamingAeadSetWrapper: public StreamingAead {
       std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source,
       absl::string_view associated_data) const override;
 
+  crypto::tink::util::Status VerifyCiphertext(
+      std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source,
+      absl::string_view associated_data,
+      int64_t* first_invalid_segment) const override;
+
+  crypto::tink::util::StatusOr<std::unique_ptr<PushEncrypter>>
+  NewPushEncrypter(absl::string_view associated_data) const override;
+
+  crypto::tink::util::StatusOr<std::unique_ptr<PushDecrypter>>
+  NewPushDecrypter(absl::string_view associated_data) const override;
+
+  crypto::tink::util::StatusOr<std::unique_ptr<Appender>> NewAppender(
+      std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source,
+      absl::string_view associated_data) const override;
+
   ~StreamingAeadSetWrapper() override = default;
 
  private:
@@ -109,6 +194,94 @@ StreamingAeadSetWrapper::NewDecryptingRandomAccessStream(
       primitives_, std::move(ciphertext_source), associated_data)};
 }
 
+// Streaming ciphertexts carry no key ID, so every key is tried. A wrong key
+// already fails on the first segment, so the key that got furthest is the one
+// that produced the ciphertext, and its failure is reported. If no key gets
+// past the first segment, or no key can even read the header, the first
+// failure in keyset order is reported.
+Status StreamingAeadSetWrapper::VerifyCiphertext(
+    std::unique_ptr<RandomAccessStream> ciphertext_source,
+    absl::string_view associated_data, int64_t* first_invalid_segment) const {
+  if (first_invalid_segment != nullptr) *first_invalid_segment = -1;
+  if (ciphertext_source == nullptr) {
+    return Status(absl::StatusCode::kInvalidArgument,
+                  "ciphertext_source must be non-null.");
+  }
+  int64_t furthest_segment = -1;
+  Status furthest_status;
+  Status first_status;
+  for (const PrimitiveSet<StreamingAead>::Entry<StreamingAead>* entry :
+       primitives_->get_all()) {
+    int64_t failed_segment = -1;
+    Status status = entry->get_primitive().VerifyCiphertext(
+        absl::make_unique<streamingaead::SharedRandomAccessStream>(
+            ciphertext_source.get()),
+        associated_data, &failed_segment);
+    if (status.ok()) return util::OkStatus();
+    if (first_status.ok()) first_status = status;
+    if (failed_segment > furthest_segment) {
+      furthest_segment = failed_segment;
+      furthest_status = status;
+    }
+  }
+  if (first_invalid_segment != nullptr) {
+    *first_invalid_segment = furthest_segment;
+  }
+  if (furthest_segment >= 0) return furthest_status;
+  if (!first_status.ok()) return first_status;
+  return Status(absl::StatusCode::kInvalidArgument,
+                "Could not find a decrypter matching the ciphertext stream.");
+}
+
+StatusOr<std::unique_ptr<StreamingAead::PushEncrypter>>
+StreamingAeadSetWrapper::NewPushEncrypter(
+    absl::string_view associated_data) const {
+  return primitives_->get_primary()->get_primitive().NewPushEncrypter(
+      associated_data);
+}
+
+StatusOr<std::unique_ptr<StreamingAead::PushDecrypter>>
+StreamingAeadSetWrapper::NewPushDecrypter(
+    absl::string_view associated_data) const {
+  std::vector<std::unique_ptr<PushDecrypter>> candidates;
+  Status status;
+  for (const PrimitiveSet<StreamingAead>::Entry<StreamingAead>* entry :
+       primitives_->get_all()) {
+    StatusOr<std::unique_ptr<PushDecrypter>> decrypter =
+        entry->get_primitive().NewPushDecrypter(associated_data);
+    if (!decrypter.ok()) {
+      status = decrypter.status();
+      continue;
+    }
+    candidates.push_back(*std::move(decrypter));
+  }
+  if (candidates.empty()) return status;
+  return {absl::make_unique<PushDecrypterSet>(std::move(candidates))};
+}
+
+// Appending continues with the key that produced the ciphertext, which need
+// not be the primary key; it is the key that authenticates the last segment.
+StatusOr<std::unique_ptr<StreamingAead::Appender>>
+StreamingAeadSetWrapper::NewAppender(
+    std::unique_ptr<RandomAccessStream> ciphertext_source,
+    absl::string_view associated_data) const {
+  if (ciphertext_source == nullptr) {
+    return Status(absl::StatusCode::kInvalidArgument,
+                  "ciphertext_source must be non-null.");
+  }
+  for (const PrimitiveSet<StreamingAead>::Entry<StreamingAead>* entry :
+       primitives_->get_all()) {
+    StatusOr<std::unique_ptr<Appender>> appender =
+        entry->get_primitive().NewAppender(
+            absl::make_unique<streamingaead::SharedRandomAccessStream>(
+                ciphertext_source.get()),
+            associated_data);
+    if (appender.ok()) return appender;
+  }
+  return Status(absl::StatusCode::kInvalidArgument,
+                "Could not find an appender matching the ciphertext stream.");
+}
+
 }  // anonymous namespace
 
 StatusOr<std::unique_ptr<StreamingAead>> StreamingAeadWrapper::Wrap(
@@ -16,6 +16,7 @@
 
 #include "tink/streamingaead/streaming_aead_wrapper.h"
 
+#include <cstdint>
 #include <memory>
 #include <sstream>
 #include <string>
@@ -29,6 +30,7 @@
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "tink/config/global_registry.h"
+#include "tink/config/tink_fips.h"
 #include "tink/input_stream.h"
 #include "tink/insecure_secret_key_access.h"
 #include "tink/internal/test_random_access_stream.h"
@@ -39,13 +41,17 @@
 #include "tink/streaming_aead.h"
 #include "tink/streamingaead/aes_gcm_hkdf_streaming_key_manager.h"
 #include "tink/streamingaead/streaming_aead_config.h"
+#include "tink/subtle/aes_gcm_hkdf_streaming.h"
+#include "tink/subtle/common_enums.h"
 #include "tink/subtle/random.h"
 #include "tink/subtle/streaming_aead_test_util.h"
 #include "tink/subtle/test_util.h"
 #include "tink/util/buffer.h"
 #include "tink/util/istream_input_stream.h"
 #include "tink/util/ostream_output_stream.h"
+#include "tink/util/secret_data.h"
 #include "tink/util/status.h"
+#include "tink/util/statusor.h"
 #include "tink/util/test_matchers.h"
 #include "tink/util/test_util.h"
 #include "proto/aes_gcm_hkdf_streaming.pb.h"
@@ -67,6 +73,7 @@ using ::google::crypto::tink::KeysetInfo;
 using ::google::crypto::tink::KeyStatusType;
 using ::google::crypto::tink::OutputPrefixType;
 using ::testing::HasSubstr;
+using ::testing::Not;
 
 // A container for specification of instances of DummyStreamingAead
 // to be created for testing.
@@ -537,6 +544,200 @@ TEST(StreamingAeadSetWrapperTest, DecryptOldKeyWorksWithRandomAccess) {
             "create three output blocks. ");
 }
 
+// Returns an AES-GCM-HKDF streaming AEAD for 'ikm' with 64 byte segments.
+std::unique_ptr<StreamingAead> NewAesGcmHkdfStreaming(
+    const util::SecretData& ikm) {
+  subtle::AesGcmHkdfStreaming::Params params;
+  params.ikm = ikm;
+  params.hkdf_hash = subtle::SHA256;
+  params.derived_key_size = 16;
+  params.ciphertext_segment_size = 64;
+  params.ciphertext_offset = 0;
+  util::StatusOr<std::unique_ptr<subtle::AesGcmHkdfStreaming>> result =
+      subtle::AesGcmHkdfStreaming::New(std::move(params));
+  EXPECT_THAT(result, IsOk());
+  return *std::move(result);
+}
+
+TEST(StreamingAeadSetWrapperTest, VerifyCiphertextWithOldKey) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  util::SecretData old_ikm = subtle::Random::GetRandomKeyBytes(16);
+  util::SecretData new_ikm = subtle::Random::GetRandomKeyBytes(16);
+  auto saead_set = absl::make_unique<PrimitiveSet<StreamingAead>>();
+  uint32_t key_id = 1;
+  for (const util::SecretData& ikm : {old_ikm, new_ikm}) {
+    KeysetInfo::KeyInfo key_info;
+    key_info.set_output_prefix_type(OutputPrefixType::RAW);
+    key_info.set_key_id(key_id++);
+    key_info.set_status(KeyStatusType::ENABLED);
+    auto entry = saead_set->AddPrimitive(NewAesGcmHkdfStreaming(ikm), key_info);
+    ASSERT_THAT(entry, IsOk());
+    ASSERT_THAT(saead_set->set_primary(*entry), IsOk());
+  }
+  util::StatusOr<std::unique_ptr<StreamingAead>> saead =
+      StreamingAeadWrapper().Wrap(std::move(saead_set));
+  ASSERT_THAT(saead, IsOk());
+
+  std::string aad = "some aad";
+  util::StatusOr<std::string> ciphertext =
+      EncryptToString(NewAesGcmHkdfStreaming(old_ikm).get(),
+                      subtle::Random::GetRandomBytes(300), aad,
+                      /*ciphertext_offset=*/0);
+  ASSERT_THAT(ciphertext, IsOk());
+  auto verify = [&](const std::string& ct, int64_t* first_invalid_segment) {
+    return (*saead)->VerifyCiphertext(
+        absl::make_unique<internal::TestRandomAccessStream>(ct), aad,
+        first_invalid_segment);
+  };
+
+  int64_t first_invalid_segment = 0;
+  EXPECT_THAT(verify(*ciphertext, &first_invalid_segment), IsOk());
+
+  // The old key gets past the first segment, so its failure is reported.
+  std::string modified = *ciphertext;
+  modified[3 * 64 + 1] ^= 1;
+  EXPECT_THAT(verify(modified, &first_invalid_segment), Not(IsOk()));
+  EXPECT_EQ(first_invalid_segment, 3);
+
+  // If the first segment is invalid, no key gets past it, and the failure of
+  // the first key is reported.
+  modified = *ciphertext;
+  modified[50] ^= 1;
+  EXPECT_THAT(verify(modified, &first_invalid_segment),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       HasSubstr("segment 0 failed verification")));
+  EXPECT_EQ(first_invalid_segment, 0);
+
+  // A truncated header is reported as such, not as a missing key.
+  util::Status status =
+      verify(ciphertext->substr(0, 5), &first_invalid_segment);
+  EXPECT_THAT(status, Not(IsOk()));
+  EXPECT_THAT(status.message(), Not(HasSubstr("Could not find a decrypter")));
+  EXPECT_EQ(first_invalid_segment, -1);
+}
+
+TEST(StreamingAeadSetWrapperTest, PushDecryptionWithOldKey) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  util::SecretData old_ikm = subtle::Random::GetRandomKeyBytes(16);
+  util::SecretData new_ikm = subtle::Random::GetRandomKeyBytes(16);
+  auto saead_set = absl::make_unique<PrimitiveSet<StreamingAead>>();
+  uint32_t key_id = 1;
+  for (const util::SecretData& ikm : {old_ikm, new_ikm}) {
+    KeysetInfo::KeyInfo key_info;
+    key_info.set_output_prefix_type(OutputPrefixType::RAW);
+    key_info.set_key_id(key_id++);
+    key_info.set_status(KeyStatusType::ENABLED);
+    auto entry = saead_set->AddPrimitive(NewAesGcmHkdfStreaming(ikm), key_info);
+    ASSERT_THAT(entry, IsOk());
+    ASSERT_THAT(saead_set->set_primary(*entry), IsOk());
+  }
+  util::StatusOr<std::unique_ptr<StreamingAead>> saead =
+      StreamingAeadWrapper().Wrap(std::move(saead_set));
+  ASSERT_THAT(saead, IsOk());
+
+  std::string aad = "some aad";
+  std::string plaintext = subtle::Random::GetRandomBytes(300);
+  util::StatusOr<std::string> ciphertext =
+      EncryptToString(NewAesGcmHkdfStreaming(old_ikm).get(), plaintext, aad,
+                      /*ciphertext_offset=*/0);
+  ASSERT_THAT(ciphertext, IsOk());
+
+  util::StatusOr<std::unique_ptr<StreamingAead::PushDecrypter>> decrypter =
+      (*saead)->NewPushDecrypter(aad);
+  ASSERT_THAT(decrypter, IsOk());
+  std::string decrypted;
+  for (int pos = 0; pos < ciphertext->size(); pos += 10) {
+    ASSERT_THAT((*decrypter)->Update(ciphertext->substr(pos, 10), &decrypted),
+                IsOk());
+  }
+  ASSERT_THAT((*decrypter)->Finalize(&decrypted), IsOk());
+  EXPECT_EQ(decrypted, plaintext);
+
+  // If the first segment is invalid, no key matches.
+  std::string modified = *ciphertext;
+  modified[50] ^= 1;
+  decrypter = (*saead)->NewPushDecrypter(aad);
+  ASSERT_THAT(decrypter, IsOk());
+  decrypted.clear();
+  EXPECT_THAT((*decrypter)->Update(modified, &decrypted),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       HasSubstr("Could not find a decrypter")));
+  EXPECT_EQ(decrypted, "");
+}
+
+TEST(StreamingAeadSetWrapperTest, AppendWithOldKey) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  util::SecretData old_ikm = subtle::Random::GetRandomKeyBytes(16);
+  util::SecretData new_ikm = subtle::Random::GetRandomKeyBytes(16);
+  auto saead_set = absl::make_unique<PrimitiveSet<StreamingAead>>();
+  uint32_t key_id = 1;
+  for (const util::SecretData& ikm : {old_ikm, new_ikm}) {
+    KeysetInfo::KeyInfo key_info;
+    key_info.set_output_prefix_type(OutputPrefixType::RAW);
+    key_info.set_key_id(key_id++);
+    key_info.set_status(KeyStatusType::ENABLED);
+    auto entry = saead_set->AddPrimitive(NewAesGcmHkdfStreaming(ikm), key_info);
+    ASSERT_THAT(entry, IsOk());
+    ASSERT_THAT(saead_set->set_primary(*entry), IsOk());
+  }
+  util::StatusOr<std::unique_ptr<StreamingAead>> saead =
+      StreamingAeadWrapper().Wrap(std::move(saead_set));
+  ASSERT_THAT(saead, IsOk());
+
+  std::string aad = "some aad";
+  std::string plaintext = subtle::Random::GetRandomBytes(300);
+  util::StatusOr<std::string> ciphertext =
+      EncryptToString(NewAesGcmHkdfStreaming(old_ikm).get(), plaintext, aad,
+                      /*ciphertext_offset=*/0);
+  ASSERT_THAT(ciphertext, IsOk());
+
+  util::StatusOr<std::unique_ptr<StreamingAead::Appender>> appender =
+      (*saead)->NewAppender(
+          absl::make_unique<internal::TestRandomAccessStream>(*ciphertext),
+          aad);
+  ASSERT_THAT(appender, IsOk());
+  std::string appended =
+      subtle::Random::GetRandomBytes((*appender)->min_append_size() + 100);
+  std::stringbuf tail;
+  util::StatusOr<std::unique_ptr<OutputStream>> stream =
+      (*appender)->NewAppendingStream(
+          absl::make_unique<util::OstreamOutputStream>(
+              absl::make_unique<std::ostream>(&tail)));
+  ASSERT_THAT(stream, IsOk());
+  ASSERT_THAT(WriteToStream(stream->get(), appended), IsOk());
+  std::string result = absl::StrCat(
+      ciphertext->substr(0, (*appender)->ciphertext_rewrite_offset()),
+      tail.str());
+
+  util::StatusOr<std::unique_ptr<RandomAccessStream>> decrypting_stream =
+      NewAesGcmHkdfStreaming(old_ikm)->NewDecryptingRandomAccessStream(
+          absl::make_unique<internal::TestRandomAccessStream>(result), aad);
+  ASSERT_THAT(decrypting_stream, IsOk());
+  std::string decrypted;
+  EXPECT_THAT(
+      ReadAllFromRandomAccessStream(decrypting_stream->get(), decrypted),
+      StatusIs(absl::StatusCode::kOutOfRange));
+  EXPECT_EQ(decrypted, plaintext + appended);
+
+  // No key authenticates a modified last segment.
+  std::string modified = *ciphertext;
+  modified.back() ^= 1;
+  EXPECT_THAT(
+      (*saead)
+          ->NewAppender(
+              absl::make_unique<internal::TestRandomAccessStream>(modified),
+              aad)
+          .status(),
+      StatusIs(absl::StatusCode::kInvalidArgument,
+               HasSubstr("Could not find an appender")));
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
@@ -16,20 +16,26 @@
 
 #include "tink/subtle/aes_cmac_boringssl.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "openssl/cmac.h"
+#include "openssl/crypto.h"
 #include "openssl/evp.h"
+#include "tink/internal/aes_cmac_batch.h"
 #include "tink/internal/aes_util.h"
 #include "tink/internal/ssl_unique_ptr.h"
 #include "tink/internal/util.h"
-#include "tink/subtle/subtle_util.h"
 #include "tink/util/errors.h"
+#include "tink/util/request_arena.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
 
@@ -61,17 +67,19 @@ util::StatusOr<std::unique_ptr<Mac>> AesCmacBoringSsl::New(util::SecretData key,
                      "Invalid tag size: expected lower than %d, found %d",
                      kMaxTagSize, tag_size);
   }
-  return {absl::WrapUnique(new AesCmacBoringSsl(std::move(key), tag_size))};
+  util::StatusOr<std::unique_ptr<internal::AesCmacBatch>> batch =
+      internal::AesCmacBatch::New(key);
+  if (!batch.ok()) return batch.status();
+  return {absl::WrapUnique(
+      new AesCmacBoringSsl(std::move(key), tag_size, *std::move(batch)))};
 }
 
-util::StatusOr<std::string> AesCmacBoringSsl::ComputeMac(
-    absl::string_view data) const {
+util::Status AesCmacBoringSsl::ComputeTag(absl::string_view data,
+                                          uint8_t* tag) const {
   // BoringSSL expects a non-null pointer for data,
   // regardless of whether the size is 0.
   data = internal::EnsureStringNonNull(data);
 
-  std::string result;
-  ResizeStringUninitialized(&result, kMaxTagSize);
   internal::SslUniquePtr<CMAC_CTX> context(CMAC_CTX_new());
   util::StatusOr<const EVP_CIPHER*> cipher =
       internal::GetAesCbcCipherForKeySize(key_.size());
@@ -81,14 +89,43 @@ util::StatusOr<std::string> AesCmacBoringSsl::ComputeMac(
   size_t len = 0;
   const uint8_t* key_ptr = reinterpret_cast<const uint8_t*>(&key_[0]);
   const uint8_t* data_ptr = reinterpret_cast<const uint8_t*>(data.data());
-  uint8_t* result_ptr = reinterpret_cast<uint8_t*>(&result[0]);
   if (CMAC_Init(context.get(), key_ptr, key_.size(), *cipher, nullptr) <= 0 ||
       CMAC_Update(context.get(), data_ptr, data.size()) <= 0 ||
-      CMAC_Final(context.get(), result_ptr, &len) == 0) {
+      CMAC_Final(context.get(), tag, &len) == 0) {
     return util::Status(absl::StatusCode::kInternal, "Failed to compute CMAC");
   }
+  return util::OkStatus();
+}
 
-  result.resize(tag_size_);
+util::StatusOr<std::string> AesCmacBoringSsl::ComputeMac(
+    absl::string_view data) const {
+  uint8_t tag[kMaxTagSize];
+  util::Status status = ComputeTag(data, tag);
+  if (!status.ok()) return status;
+  return std::string(reinterpret_cast<const char*>(tag), tag_size_);
+}
+
+util::StatusOr<absl::string_view> AesCmacBoringSsl::ComputeMacWithArena(
+    absl::string_view data, util::RequestArena* arena) const {
+  uint8_t tag[kMaxTagSize];
+  util::Status status = ComputeTag(data, tag);
+  if (!status.ok()) return status;
+  return arena->Copy(
+      absl::string_view(reinterpret_cast<const char*>(tag), tag_size_));
+}
+
+util::StatusOr<std::vector<std::string>> AesCmacBoringSsl::ComputeMacBatch(
+    absl::Span<const absl::string_view> data) const {
+  std::vector<uint8_t> tags(internal::AesCmacBatch::kTagSize * data.size());
+  util::Status status = batch_->Compute(data, absl::MakeSpan(tags));
+  if (!status.ok()) return status;
+  std::vector<std::string> result;
+  result.reserve(data.size());
+  for (size_t i = 0; i < data.size(); ++i) {
+    result.emplace_back(reinterpret_cast<const char*>(
+                            &tags[i * internal::AesCmacBatch::kTagSize]),
+                        tag_size_);
+  }
   return result;
 }
 
@@ -99,15 +136,35 @@ util::Status AesCmacBoringSsl::VerifyMac(absl::string_view mac,
                      "Incorrect tag size: expected %d, found %d", tag_size_,
                      mac.size());
   }
-  util::StatusOr<std::string> computed_mac = ComputeMac(data);
-  if (!computed_mac.ok()) return computed_mac.status();
-  if (CRYPTO_memcmp(computed_mac->data(), mac.data(), tag_size_) != 0) {
+  uint8_t tag[kMaxTagSize];
+  util::Status status = ComputeTag(data, tag);
+  if (!status.ok()) return status;
+  if (CRYPTO_memcmp(tag, mac.data(), tag_size_) != 0) {
     return util::Status(absl::StatusCode::kInvalidArgument,
                         "CMAC verification failed");
   }
   return util::OkStatus();
 }
 
+util::StatusOr<std::vector<bool>> AesCmacBoringSsl::VerifyMacBatch(
+    absl::Span<const absl::string_view> macs,
+    absl::Span<const absl::string_view> data) const {
+  if (macs.size() != data.size()) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "Number of MACs and number of messages differ");
+  }
+  std::vector<uint8_t> tags(internal::AesCmacBatch::kTagSize * data.size());
+  util::Status status = batch_->Compute(data, absl::MakeSpan(tags));
+  if (!status.ok()) return status;
+  std::vector<bool> valid(data.size());
+  for (size_t i = 0; i < data.size(); ++i) {
+    valid[i] = macs[i].size() == tag_size_ &&
+               CRYPTO_memcmp(&tags[i * internal::AesCmacBatch::kTagSize],
+                             macs[i].data(), tag_size_) == 0;
+  }
+  return valid;
+}
+
 }  // namespace subtle
 }  // namespace tink
 }  // namespace crypto
@@ -17,13 +17,20 @@
 #ifndef TINK_SUBTLE_AES_CMAC_BORINGSSL_H_
 #define TINK_SUBTLE_AES_CMAC_BORINGSSL_H_
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/internal/aes_cmac_batch.h"
 #include "tink/internal/fips_utils.h"
 #include "tink/mac.h"
+#include "tink/util/request_arena.h"
 #include "tink/util/secret_data.h"
+#include "tink/util/status.h"
 #include "tink/util/statusor.h"
 
 namespace crypto {
@@ -39,20 +46,40 @@ class AesCmacBoringSsl : public Mac {
   crypto::tink::util::StatusOr<std::string> ComputeMac(
       absl::string_view data) const override;
 
+  // Computes the CMAC for 'data' and places it in 'arena'.
+  crypto::tink::util::StatusOr<absl::string_view> ComputeMacWithArena(
+      absl::string_view data, util::RequestArena* arena) const override;
+
+  // Computes the CMACs for all elements of 'data', interleaving up to
+  // internal::AesCmacBatch::kNumLanes messages at a time.
+  crypto::tink::util::StatusOr<std::vector<std::string>> ComputeMacBatch(
+      absl::Span<const absl::string_view> data) const override;
+
   // Verifies if 'mac' is a correct CMAC for 'data'.
   // Returns Status::OK if 'mac' is correct, and a non-OK-Status otherwise.
   crypto::tink::util::Status VerifyMac(absl::string_view mac,
                                        absl::string_view data) const override;
 
+  // Verifies a batch of (tag, data) pairs, computing the CMACs of up to
+  // internal::AesCmacBatch::kNumLanes messages at a time.
+  crypto::tink::util::StatusOr<std::vector<bool>> VerifyMacBatch(
+      absl::Span<const absl::string_view> macs,
+      absl::Span<const absl::string_view> data) const override;
+
   static constexpr crypto::tink::internal::FipsCompatibility kFipsStatus =
       crypto::tink::internal::FipsCompatibility::kNotFips;
 
  private:
-  AesCmacBoringSsl(util::SecretData key, uint32_t tag_size)
-      : key_(std::move(key)), tag_size_(tag_size) {}
+  // Writes the full 16-byte CMAC of `data` to `tag`.
+  util::Status ComputeTag(absl::string_view data, uint8_t* tag) const;
+
+  AesCmacBoringSsl(util::SecretData key, uint32_t tag_size,
+                   std::unique_ptr<internal::AesCmacBatch> batch)
+      : key_(std::move(key)), tag_size_(tag_size), batch_(std::move(batch)) {}
 
   const util::SecretData key_;
   const uint32_t tag_size_;
+  const std::unique_ptr<internal::AesCmacBatch> batch_;
 };
 
 }  // namespace subtle
@@ -19,15 +19,19 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "absl/status/status.h"
 #include "absl/strings/escaping.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "tink/config/tink_fips.h"
 #include "tink/mac.h"
 #include "tink/subtle/common_enums.h"
+#include "tink/subtle/random.h"
+#include "tink/util/request_arena.h"
 #include "tink/util/secret_data.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
@@ -39,6 +43,7 @@ namespace subtle {
 namespace {
 
 using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::IsOkAndHolds;
 using ::crypto::tink::test::StatusIs;
 using ::testing::Not;
 using ::testing::SizeIs;
@@ -273,6 +278,94 @@ INSTANTIATE_TEST_SUITE_P(
                     std::make_pair(40, "dfa66747de9ae63030ca32611497c827"),
                     std::make_pair(64, "51f0bebf7e3b9d92fc49741779363cfe")));
 
+TEST(AesCmacBoringSslTest, ComputeMacBatchMatchesComputeMac) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+
+  util::SecretData key =
+      util::SecretDataFromStringView(absl::HexStringToBytes(kKey256Hex));
+  for (uint32_t tag_size : {kTagSize, kSmallTagSize}) {
+    util::StatusOr<std::unique_ptr<Mac>> cmac =
+        AesCmacBoringSsl::New(key, tag_size);
+    ASSERT_THAT(cmac, IsOk());
+    std::vector<std::string> messages;
+    for (int size = 0; size <= 128; ++size) {
+      messages.push_back(Random::GetRandomBytes(size));
+    }
+    std::vector<absl::string_view> data(messages.begin(), messages.end());
+    util::StatusOr<std::vector<std::string>> tags =
+        (*cmac)->ComputeMacBatch(data);
+    ASSERT_THAT(tags, IsOk());
+    ASSERT_THAT(*tags, SizeIs(messages.size()));
+    for (int i = 0; i < messages.size(); ++i) {
+      util::StatusOr<std::string> tag = (*cmac)->ComputeMac(messages[i]);
+      ASSERT_THAT(tag, IsOk());
+      EXPECT_EQ((*tags)[i], *tag);
+      EXPECT_THAT((*cmac)->VerifyMac((*tags)[i], messages[i]), IsOk());
+    }
+  }
+}
+
+TEST(AesCmacBoringSslTest, ComputeMacWithArenaMatchesComputeMac) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+
+  util::SecretData key =
+      util::SecretDataFromStringView(absl::HexStringToBytes(kKey256Hex));
+  util::RequestArena arena;
+  for (uint32_t tag_size : {kTagSize, kSmallTagSize}) {
+    util::StatusOr<std::unique_ptr<Mac>> cmac =
+        AesCmacBoringSsl::New(key, tag_size);
+    ASSERT_THAT(cmac, IsOk());
+    std::string data = Random::GetRandomBytes(40);
+    util::StatusOr<absl::string_view> tag =
+        (*cmac)->ComputeMacWithArena(data, &arena);
+    ASSERT_THAT(tag, IsOk());
+    EXPECT_THAT((*cmac)->ComputeMac(data), IsOkAndHolds(std::string(*tag)));
+  }
+}
+
+TEST(AesCmacBoringSslTest, VerifyMacBatch) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+
+  util::SecretData key =
+      util::SecretDataFromStringView(absl::HexStringToBytes(kKey256Hex));
+  for (uint32_t tag_size : {kTagSize, kSmallTagSize}) {
+    util::StatusOr<std::unique_ptr<Mac>> cmac =
+        AesCmacBoringSsl::New(key, tag_size);
+    ASSERT_THAT(cmac, IsOk());
+    std::vector<std::string> messages;
+    std::vector<std::string> tags;
+    std::vector<bool> expected;
+    for (int size = 0; size <= 64; ++size) {
+      messages.push_back(Random::GetRandomBytes(size));
+      util::StatusOr<std::string> tag = (*cmac)->ComputeMac(messages.back());
+      ASSERT_THAT(tag, IsOk());
+      // Corrupt every third tag and truncate every fifth one.
+      if (size % 3 == 0) {
+        (*tag)[size % tag_size] ^= 0x01;
+      } else if (size % 5 == 0) {
+        tag->pop_back();
+      }
+      tags.push_back(*tag);
+      expected.push_back(size % 3 != 0 && size % 5 != 0);
+    }
+    std::vector<absl::string_view> tag_views(tags.begin(), tags.end());
+    std::vector<absl::string_view> data(messages.begin(), messages.end());
+    EXPECT_THAT((*cmac)->VerifyMacBatch(tag_views, data),
+                IsOkAndHolds(expected));
+    EXPECT_THAT(
+        (*cmac)
+            ->VerifyMacBatch(tag_views, absl::MakeConstSpan(data).subspan(1))
+            .status(),
+        StatusIs(absl::StatusCode::kInvalidArgument));
+  }
+}
+
 TEST(AesCmacBoringSslTest, TestFipsOnly) {
   if (!IsFipsModeEnabled()) {
     GTEST_SKIP() << "Only supported in FIPS-only mode";
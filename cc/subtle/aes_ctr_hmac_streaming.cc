@@ -27,6 +27,7 @@
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "openssl/err.h"
 #include "openssl/evp.h"
 #include "tink/internal/aes_util.h"
@@ -304,9 +305,9 @@ util::Status AesCtrHmacStreamSegmentDecrypter::Init(
   return util::OkStatus();
 }
 
-util::Status AesCtrHmacStreamSegmentDecrypter::DecryptSegment(
-    const std::vector<uint8_t>& ciphertext, int64_t segment_number,
-    bool is_last_segment, std::vector<uint8_t>* plaintext_buffer) {
+util::Status AesCtrHmacStreamSegmentDecrypter::VerifyTag(
+    absl::Span<const uint8_t> ciphertext, int64_t segment_number,
+    bool is_last_segment, std::string* nonce) const {
   if (!is_initialized_) {
     return util::Status(absl::StatusCode::kFailedPrecondition,
                         "decrypter not initialized");
@@ -319,10 +320,6 @@ util::Status AesCtrHmacStreamSegmentDecrypter::DecryptSegment(
     return util::Status(absl::StatusCode::kInvalidArgument,
                         "ciphertext too short");
   }
-  if (plaintext_buffer == nullptr) {
-    return util::Status(absl::StatusCode::kInvalidArgument,
-                        "plaintext_buffer must be non-null");
-  }
   if (segment_number > std::numeric_limits<uint32_t>::max() ||
       (segment_number == std::numeric_limits<uint32_t>::max() &&
        !is_last_segment)) {
@@ -331,19 +328,39 @@ util::Status AesCtrHmacStreamSegmentDecrypter::DecryptSegment(
   }
 
   int pt_size = ciphertext.size() - tag_size_;
-  plaintext_buffer->resize(pt_size);
-
-  std::string nonce =
-      NonceForSegment(nonce_prefix_, segment_number, is_last_segment);
+  *nonce = NonceForSegment(nonce_prefix_, segment_number, is_last_segment);
 
-  // Verify MAC tag.
   absl::string_view tag(
       reinterpret_cast<const char*>(ciphertext.data() + pt_size), tag_size_);
   absl::string_view ciphertext_string(
       reinterpret_cast<const char*>(ciphertext.data()), pt_size);
-  auto status = mac_->VerifyMac(tag, absl::StrCat(nonce, ciphertext_string));
+  return mac_->VerifyMac(tag, absl::StrCat(*nonce, ciphertext_string));
+}
+
+util::Status AesCtrHmacStreamSegmentDecrypter::VerifySegment(
+    absl::Span<const uint8_t> ciphertext, int64_t segment_number,
+    bool is_last_segment) {
+  std::string nonce;
+  return VerifyTag(ciphertext, segment_number, is_last_segment, &nonce);
+}
+
+util::Status AesCtrHmacStreamSegmentDecrypter::DecryptSegment(
+    const std::vector<uint8_t>& ciphertext, int64_t segment_number,
+    bool is_last_segment, std::vector<uint8_t>* plaintext_buffer) {
+  if (plaintext_buffer == nullptr) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "plaintext_buffer must be non-null");
+  }
+
+  // Verify MAC tag.
+  std::string nonce;
+  auto status =
+      VerifyTag(ciphertext, segment_number, is_last_segment, &nonce);
   if (!status.ok()) return status;
 
+  int pt_size = ciphertext.size() - tag_size_;
+  plaintext_buffer->resize(pt_size);
+
   // Decrypt.
   internal::SslUniquePtr<EVP_CIPHER_CTX> ctx(EVP_CIPHER_CTX_new());
   if (ctx.get() == nullptr) {
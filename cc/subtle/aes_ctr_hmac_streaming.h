@@ -23,6 +23,7 @@
 #include <vector>
 
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "openssl/evp.h"
 #include "tink/internal/fips_utils.h"
 #include "tink/mac.h"
@@ -173,6 +174,11 @@ class AesCtrHmacStreamSegmentDecrypter : public StreamSegmentDecrypter {
                               int64_t segment_number, bool is_last_segment,
                               std::vector<uint8_t>* plaintext_buffer) override;
 
+  // Only checks the HMAC tag, without running AES-CTR.
+  util::Status VerifySegment(absl::Span<const uint8_t> ciphertext,
+                             int64_t segment_number,
+                             bool is_last_segment) override;
+
   int get_header_size() const override {
     return 1 + key_size_ + AesCtrHmacStreaming::kNoncePrefixSizeInBytes;
   }
@@ -201,6 +207,12 @@ class AesCtrHmacStreamSegmentDecrypter : public StreamSegmentDecrypter {
         tag_algo_(tag_algo),
         tag_size_(tag_size) {}
 
+  // Checks the arguments of a segment operation and verifies the tag of
+  // 'ciphertext'. On success, sets 'nonce' to the nonce of the segment.
+  util::Status VerifyTag(absl::Span<const uint8_t> ciphertext,
+                         int64_t segment_number, bool is_last_segment,
+                         std::string* nonce) const;
+
   // Parameters set upon decrypter creation.
   const util::SecretData ikm_;
   const HashType hkdf_algo_;
@@ -16,6 +16,7 @@
 
 #include "tink/subtle/aes_ctr_hmac_streaming.h"
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <utility>
@@ -28,6 +29,7 @@
 #include "absl/status/statusor.h"
 #include "absl/strings/escaping.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
 #include "tink/config/tink_fips.h"
 #include "tink/internal/test_random_access_stream.h"
 #include "tink/random_access_stream.h"
@@ -46,6 +48,7 @@ using ::crypto::tink::test::IsOkAndHolds;
 using ::crypto::tink::test::StatusIs;
 using ::testing::Eq;
 using ::testing::HasSubstr;
+using ::testing::Not;
 
 namespace crypto {
 namespace tink {
@@ -577,6 +580,62 @@ TEST(ValidateTest, WrongTagAlgo) {
                        HasSubstr("unsupported tag_algo")));
 }
 
+TEST(AesCtrHmacStreamingTest, VerifyCiphertextReportsFirstInvalidSegment) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  constexpr int kSegmentSize = 128;
+  constexpr int kCiphertextOffset = 8;
+  AesCtrHmacStreaming::Params params = ValidParams();
+  params.ciphertext_segment_size = kSegmentSize;
+  params.ciphertext_offset = kCiphertextOffset;
+  util::StatusOr<std::unique_ptr<AesCtrHmacStreaming>> streaming_aead =
+      AesCtrHmacStreaming::New(std::move(params));
+  ASSERT_THAT(streaming_aead, IsOk());
+
+  std::string associated_data = "some associated data";
+  util::StatusOr<std::string> ciphertext =
+      EncryptToString(streaming_aead->get(), Random::GetRandomBytes(1000),
+                      associated_data, kCiphertextOffset);
+  ASSERT_THAT(ciphertext, IsOk());
+  auto verify = [&](const std::string& ct, absl::string_view ad,
+                    int64_t* first_invalid_segment) {
+    return (*streaming_aead)
+        ->VerifyCiphertext(
+            absl::make_unique<internal::TestRandomAccessStream>(ct), ad,
+            first_invalid_segment);
+  };
+
+  int64_t first_invalid_segment = 0;
+  EXPECT_THAT(verify(*ciphertext, associated_data, &first_invalid_segment),
+              IsOk());
+
+  // Segments after the first one start at multiples of the segment size.
+  std::string modified = *ciphertext;
+  modified[5 * kSegmentSize + 3] ^= 1;
+  modified[2 * kSegmentSize + 3] ^= 1;
+  EXPECT_THAT(verify(modified, associated_data, &first_invalid_segment),
+              Not(IsOk()));
+  EXPECT_THAT(first_invalid_segment, Eq(2));
+
+  std::string truncated = ciphertext->substr(0, ciphertext->size() - 1);
+  EXPECT_THAT(verify(truncated, associated_data, &first_invalid_segment),
+              Not(IsOk()));
+  EXPECT_THAT(first_invalid_segment, Eq((truncated.size() - 1) / kSegmentSize));
+
+  EXPECT_THAT(verify(*ciphertext, "wrong associated data",
+                     &first_invalid_segment),
+              Not(IsOk()));
+  EXPECT_THAT(first_invalid_segment, Eq(0));
+
+  // A corrupted header cannot be attributed to a segment.
+  std::string bad_header = *ciphertext;
+  bad_header[kCiphertextOffset] ^= 1;
+  EXPECT_THAT(verify(bad_header, associated_data, &first_invalid_segment),
+              Not(IsOk()));
+  EXPECT_THAT(first_invalid_segment, Eq(-1));
+}
+
 // FIPS only mode tests
 TEST(AesCtrHmacStreamingTest, TestFipsOnly) {
   if (!IsFipsModeEnabled()) {
@@ -26,8 +26,11 @@
 #include "absl/status/status.h"
 #include "absl/strings/escaping.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "tink/aead/internal/wycheproof_aead.h"
 #include "tink/internal/fips_utils.h"
+#include "tink/util/request_arena.h"
 #include "tink/util/secret_data.h"
 #include "tink/util/statusor.h"
 #include "tink/util/test_matchers.h"
@@ -44,6 +47,7 @@ constexpr absl::string_view kKey256 =
     "000102030405060708090a0b0c0d0e0f000102030405060708090a0b0c0d0e0f";
 
 using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::IsOkAndHolds;
 using ::crypto::tink::test::StatusIs;
 using ::testing::AllOf;
 using ::testing::Eq;
@@ -80,6 +84,68 @@ TEST_F(AesGcmBoringSslTest, BasicEncryptDecrypt) {
   EXPECT_EQ(*plaintext, kMessage);
 }
 
+TEST_F(AesGcmBoringSslTest, EncryptDecryptWithArena) {
+  util::RequestArena arena;
+  util::StatusOr<absl::string_view> ciphertext =
+      cipher_->EncryptWithArena(kMessage, kAssociatedData, &arena);
+  ASSERT_THAT(ciphertext, IsOk());
+  EXPECT_EQ(ciphertext->size(), kMessage.size() + 12 + 16);
+  EXPECT_THAT(cipher_->Decrypt(*ciphertext, kAssociatedData),
+              IsOkAndHolds(std::string(kMessage)));
+  util::StatusOr<absl::string_view> plaintext =
+      cipher_->DecryptWithArena(*ciphertext, kAssociatedData, &arena);
+  ASSERT_THAT(plaintext, IsOk());
+  EXPECT_EQ(*plaintext, kMessage);
+
+  std::string modified_ct(*ciphertext);
+  modified_ct.back() ^= 1;
+  EXPECT_THAT(
+      cipher_->DecryptWithArena(modified_ct, kAssociatedData, &arena).status(),
+      Not(IsOk()));
+}
+
+TEST_F(AesGcmBoringSslTest, EncryptDecryptFragments) {
+  // "Some data to encrypt." in three fragments; the output is split so that
+  // neither the IV nor the tag lie in a single fragment.
+  std::vector<absl::string_view> plaintext = {
+      kMessage.substr(0, 5), kMessage.substr(5, 10), kMessage.substr(15)};
+  std::string ciphertext(kMessage.size() + 12 + 16, '\0');
+  absl::Span<char> buffer = absl::MakeSpan(ciphertext);
+  std::vector<absl::Span<char>> ciphertext_fragments = {
+      buffer.subspan(0, 7), buffer.subspan(7, 20), buffer.subspan(27, 14),
+      buffer.subspan(41)};
+  EXPECT_THAT(cipher_->EncryptFragments(plaintext, kAssociatedData,
+                                        ciphertext_fragments),
+              IsOkAndHolds(ciphertext.size()));
+  EXPECT_THAT(cipher_->Decrypt(ciphertext, kAssociatedData),
+              IsOkAndHolds(std::string(kMessage)));
+
+  util::StatusOr<std::string> contiguous_ciphertext =
+      cipher_->Encrypt(kMessage, kAssociatedData);
+  ASSERT_THAT(contiguous_ciphertext, IsOk());
+  absl::string_view ct = *contiguous_ciphertext;
+  std::string decrypted(kMessage.size(), '\0');
+  absl::Span<char> out = absl::MakeSpan(decrypted);
+  EXPECT_THAT(cipher_->DecryptFragments(
+                  {ct.substr(0, 3), ct.substr(3, 30), ct.substr(33)},
+                  kAssociatedData, {out.subspan(0, 1), out.subspan(1)}),
+              IsOkAndHolds(kMessage.size()));
+  EXPECT_EQ(decrypted, kMessage);
+
+  std::string modified_ct(ct);
+  modified_ct.back() ^= 1;
+  EXPECT_THAT(cipher_
+                  ->DecryptFragments({modified_ct}, kAssociatedData,
+                                     {absl::MakeSpan(decrypted)})
+                  .status(),
+              Not(IsOk()));
+  EXPECT_THAT(cipher_
+                  ->EncryptFragments(plaintext, kAssociatedData,
+                                     {buffer.subspan(1)})
+                  .status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
 TEST_F(AesGcmBoringSslTest, ModifyMessageAndAssociatedData) {
   util::StatusOr<std::string> ciphertext =
       cipher_->Encrypt(kMessage, kAssociatedData);
@@ -0,0 +1,309 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/subtle/aes_gcm_hkdf_segmented_aead.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/aead/internal/ssl_aead.h"
+#include "tink/internal/fips_utils.h"
+#include "tink/internal/fragments.h"
+#include "tink/internal/run_in_parallel.h"
+#include "tink/internal/util.h"
+#include "tink/subtle/aes_gcm_hkdf_stream_segment_encrypter.h"
+#include "tink/subtle/hkdf.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/subtle_util.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+namespace {
+
+constexpr int kTagSize = AesGcmHkdfStreamSegmentEncrypter::kTagSizeInBytes;
+constexpr int kNoncePrefixSize =
+    AesGcmHkdfStreamSegmentEncrypter::kNoncePrefixSizeInBytes;
+// Segment numbers are 32-bit.
+constexpr int64_t kMaxSegments =
+    static_cast<int64_t>(std::numeric_limits<uint32_t>::max()) + 1;
+
+util::Status Validate(const AesGcmHkdfSegmentedAead::Params& params) {
+  if (!(params.hkdf_hash == SHA1 || params.hkdf_hash == SHA256 ||
+        params.hkdf_hash == SHA512)) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "unsupported hkdf_hash");
+  }
+  if (params.ikm.size() < 16 || params.ikm.size() < params.derived_key_size) {
+    return util::Status(absl::StatusCode::kInvalidArgument, "ikm too small");
+  }
+  if (params.derived_key_size != 16 && params.derived_key_size != 32) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "derived_key_size must be 16 or 32");
+  }
+  if (params.ciphertext_segment_size <=
+      1 + params.derived_key_size + kNoncePrefixSize + kTagSize) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "ciphertext_segment_size too small");
+  }
+  return util::OkStatus();
+}
+
+// Constructs the nonce nonce_prefix || segment_number || last_segment, with
+// the segment number in big-endian order.
+std::string SegmentNonce(absl::string_view nonce_prefix,
+                         int64_t segment_number, bool is_last_segment) {
+  std::string nonce(nonce_prefix);
+  for (int shift = 24; shift >= 0; shift -= 8) {
+    nonce.push_back(static_cast<char>((segment_number >> shift) & 0xff));
+  }
+  nonce.push_back(is_last_segment ? 1 : 0);
+  return nonce;
+}
+
+// Sizes of the plaintext segments of a message. The first segment is shorter
+// by the size of the header.
+struct SegmentLayout {
+  int64_t first_segment_size;
+  int64_t segment_size;
+
+  // Offset of segment `i` in the plaintext.
+  int64_t PlaintextStart(int64_t i) const {
+    return i == 0 ? 0 : first_segment_size + (i - 1) * segment_size;
+  }
+};
+
+util::Status FirstError(const std::vector<util::Status>& statuses) {
+  for (const util::Status& status : statuses) {
+    if (!status.ok()) return status;
+  }
+  return util::OkStatus();
+}
+
+}  // namespace
+
+util::StatusOr<std::unique_ptr<Aead>> AesGcmHkdfSegmentedAead::New(
+    Params params) {
+  util::Status status =
+      internal::CheckFipsCompatibility<AesGcmHkdfSegmentedAead>();
+  if (!status.ok()) return status;
+
+  status = Validate(params);
+  if (!status.ok()) return status;
+  return {absl::WrapUnique(new AesGcmHkdfSegmentedAead(std::move(params)))};
+}
+
+int AesGcmHkdfSegmentedAead::header_size() const {
+  return 1 + derived_key_size_ + kNoncePrefixSize;
+}
+
+void AesGcmHkdfSegmentedAead::RunSegments(
+    int64_t num_segments, const std::function<void(int64_t)>& task) const {
+  if (num_segments == 1) {
+    task(0);
+  } else if (executor_) {
+    executor_(num_segments, task);
+  } else {
+    internal::RunInParallel(num_segments, [&task](size_t i) { task(i); });
+  }
+}
+
+int64_t AesGcmHkdfSegmentedAead::NumSegments(int64_t plaintext_size) const {
+  const int64_t first_segment_size =
+      ciphertext_segment_size_ - header_size() - kTagSize;
+  const int64_t segment_size = ciphertext_segment_size_ - kTagSize;
+  if (plaintext_size <= first_segment_size) return 1;
+  return 1 + (plaintext_size - first_segment_size + segment_size - 1) /
+                 segment_size;
+}
+
+util::StatusOr<int64_t> AesGcmHkdfSegmentedAead::MaxEncryptionSize(
+    int64_t plaintext_size) const {
+  const int64_t num_segments = NumSegments(plaintext_size);
+  if (num_segments > kMaxSegments) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "plaintext too long");
+  }
+  return header_size() + plaintext_size + num_segments * kTagSize;
+}
+
+util::StatusOr<std::string> AesGcmHkdfSegmentedAead::Encrypt(
+    absl::string_view plaintext, absl::string_view associated_data) const {
+  util::StatusOr<int64_t> ciphertext_size =
+      MaxEncryptionSize(plaintext.size());
+  if (!ciphertext_size.ok()) return ciphertext_size.status();
+  std::string ciphertext;
+  ResizeStringUninitialized(&ciphertext, *ciphertext_size);
+  util::Status status = EncryptInto(plaintext, associated_data,
+                                    absl::MakeSpan(ciphertext));
+  if (!status.ok()) return status;
+  return ciphertext;
+}
+
+util::StatusOr<int64_t> AesGcmHkdfSegmentedAead::EncryptFragments(
+    absl::Span<const absl::string_view> plaintext,
+    absl::string_view associated_data,
+    absl::Span<const absl::Span<char>> ciphertext) const {
+  // Only a single plaintext and a single ciphertext fragment can be encrypted
+  // in place.
+  if (plaintext.size() != 1 || ciphertext.size() != 1) {
+    return Aead::EncryptFragments(plaintext, associated_data, ciphertext);
+  }
+  if (internal::FragmentsOverlap(plaintext, ciphertext)) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "Plaintext and ciphertext fragments must not overlap");
+  }
+  util::StatusOr<int64_t> ciphertext_size =
+      MaxEncryptionSize(plaintext[0].size());
+  if (!ciphertext_size.ok()) return ciphertext_size.status();
+  if (ciphertext[0].size() < *ciphertext_size) {
+    return util::Status(
+        absl::StatusCode::kInvalidArgument,
+        absl::StrCat("Ciphertext fragments too small; expected at least ",
+                     *ciphertext_size, " bytes"));
+  }
+  util::Status status =
+      EncryptInto(plaintext[0], associated_data,
+                  ciphertext[0].subspan(0, *ciphertext_size));
+  if (!status.ok()) return status;
+  return *ciphertext_size;
+}
+
+util::Status AesGcmHkdfSegmentedAead::EncryptInto(
+    absl::string_view plaintext, absl::string_view associated_data,
+    absl::Span<char> ciphertext) const {
+  const SegmentLayout layout = {
+      ciphertext_segment_size_ - header_size() - kTagSize,
+      ciphertext_segment_size_ - kTagSize};
+  const int64_t plaintext_size = plaintext.size();
+  const int64_t num_segments = NumSegments(plaintext_size);
+
+  const std::string salt = Random::GetRandomBytes(derived_key_size_);
+  const std::string nonce_prefix = Random::GetRandomBytes(kNoncePrefixSize);
+  util::StatusOr<util::SecretData> key = Hkdf::ComputeHkdf(
+      hkdf_hash_, ikm_, salt, associated_data, derived_key_size_);
+  if (!key.ok()) return key.status();
+  util::StatusOr<std::unique_ptr<internal::SslOneShotAead>> aead =
+      internal::CreateAesGcmOneShotCrypter(*key);
+  if (!aead.ok()) return aead.status();
+
+  char* const out = ciphertext.data();
+  out[0] = static_cast<char>(header_size());
+  std::memcpy(out + 1, salt.data(), salt.size());
+  std::memcpy(out + 1 + salt.size(), nonce_prefix.data(), nonce_prefix.size());
+  char* const segments = out + header_size();
+
+  std::vector<util::Status> statuses(num_segments);
+  RunSegments(num_segments, [&](int64_t i) {
+    const int64_t start = layout.PlaintextStart(i);
+    const int64_t size =
+        std::min(layout.PlaintextStart(i + 1), plaintext_size) - start;
+    const std::string nonce =
+        SegmentNonce(nonce_prefix, i, i == num_segments - 1);
+    util::StatusOr<int64_t> written = (*aead)->Encrypt(
+        internal::EnsureStringNonNull(plaintext.substr(start, size)),
+        /*associated_data=*/"", nonce,
+        absl::MakeSpan(segments + start + i * kTagSize, size + kTagSize));
+    if (!written.ok()) statuses[i] = written.status();
+  });
+  return FirstError(statuses);
+}
+
+util::StatusOr<std::string> AesGcmHkdfSegmentedAead::Decrypt(
+    absl::string_view ciphertext, absl::string_view associated_data) const {
+  const int64_t ciphertext_size = ciphertext.size();
+  if (ciphertext_size < header_size() + kTagSize) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "ciphertext too short");
+  }
+  if (ciphertext[0] != header_size()) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "corrupted header");
+  }
+  // The header and the first segment together take one ciphertext segment.
+  int64_t num_segments =
+      (ciphertext_size + ciphertext_segment_size_ - 1) /
+      ciphertext_segment_size_;
+  const int64_t last_segment_size =
+      ciphertext_size - (num_segments - 1) * ciphertext_segment_size_ -
+      (num_segments == 1 ? header_size() : 0);
+  if (last_segment_size < kTagSize) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "ciphertext has an invalid size");
+  }
+  if (num_segments > kMaxSegments) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "ciphertext too long");
+  }
+
+  const absl::string_view salt = ciphertext.substr(1, derived_key_size_);
+  const absl::string_view nonce_prefix =
+      ciphertext.substr(1 + derived_key_size_, kNoncePrefixSize);
+  util::StatusOr<util::SecretData> key = Hkdf::ComputeHkdf(
+      hkdf_hash_, ikm_, salt, associated_data, derived_key_size_);
+  if (!key.ok()) return key.status();
+  util::StatusOr<std::unique_ptr<internal::SslOneShotAead>> aead =
+      internal::CreateAesGcmOneShotCrypter(*key);
+  if (!aead.ok()) return aead.status();
+
+  const SegmentLayout layout = {
+      ciphertext_segment_size_ - header_size() - kTagSize,
+      ciphertext_segment_size_ - kTagSize};
+  const int64_t plaintext_size =
+      ciphertext_size - header_size() - num_segments * kTagSize;
+  std::string plaintext;
+  ResizeStringUninitialized(&plaintext, plaintext_size);
+  const absl::string_view segments = ciphertext.substr(header_size());
+
+  std::vector<util::Status> statuses(num_segments);
+  RunSegments(num_segments, [&](int64_t i) {
+    const int64_t start = layout.PlaintextStart(i);
+    const int64_t size =
+        std::min(layout.PlaintextStart(i + 1), plaintext_size) - start;
+    const std::string nonce =
+        SegmentNonce(nonce_prefix, i, i == num_segments - 1);
+    util::StatusOr<int64_t> written = (*aead)->Decrypt(
+        segments.substr(start + i * kTagSize, size + kTagSize),
+        /*associated_data=*/"", nonce,
+        absl::MakeSpan(&plaintext[0] + start, size));
+    if (!written.ok()) statuses[i] = written.status();
+  });
+  util::Status status = FirstError(statuses);
+  if (!status.ok()) return status;
+  return plaintext;
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
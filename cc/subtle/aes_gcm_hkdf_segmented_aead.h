@@ -0,0 +1,128 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef TINK_SUBTLE_AES_GCM_HKDF_SEGMENTED_AEAD_H_
+#define TINK_SUBTLE_AES_GCM_HKDF_SEGMENTED_AEAD_H_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/aead.h"
+#include "tink/internal/fips_utils.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// One-shot AEAD for very large in-memory payloads, which can encrypt and
+// decrypt the segments of a message in parallel.
+//
+// The ciphertext is exactly the ciphertext that AesGcmHkdfStreaming with the
+// same parameters and a ciphertext offset of 0 produces for the same
+// plaintext:
+//   header || segment_0 || segment_1 || ... || segment_k
+// where the header is header_size || salt || nonce_prefix, and each segment
+// is encrypted with AES-GCM under a key derived with HKDF from the salt and
+// the associated data, using nonce_prefix || segment number || last segment
+// flag as nonce. See AesGcmHkdfStreamSegmentEncrypter for details. Hence
+// ciphertexts of this primitive can also be decrypted as a stream.
+class AesGcmHkdfSegmentedAead : public Aead {
+ public:
+  // Runs `task(i)` for every i in [0, num_tasks), possibly concurrently, and
+  // returns once all calls have returned.
+  using Executor = std::function<void(
+      int64_t num_tasks, const std::function<void(int64_t)>& task)>;
+
+  struct Params {
+    util::SecretData ikm;
+    HashType hkdf_hash;
+    int derived_key_size;
+    int ciphertext_segment_size;
+    // Runs the segments of a message. If empty, segments run on the calling
+    // thread, helped by the shared thread pool if enabled with
+    // EnableParallelism() (see config/parallelism.h).
+    Executor executor;
+  };
+
+  static util::StatusOr<std::unique_ptr<Aead>> New(Params params);
+
+  util::StatusOr<std::string> Encrypt(
+      absl::string_view plaintext,
+      absl::string_view associated_data) const override;
+
+  util::StatusOr<std::string> Decrypt(
+      absl::string_view ciphertext,
+      absl::string_view associated_data) const override;
+
+  // Returns the exact ciphertext size.
+  util::StatusOr<int64_t> MaxEncryptionSize(
+      int64_t plaintext_size) const override;
+
+  // Encrypts a single plaintext fragment directly into a single ciphertext
+  // fragment. Other fragmentations fall back to Aead::EncryptFragments().
+  util::StatusOr<int64_t> EncryptFragments(
+      absl::Span<const absl::string_view> plaintext,
+      absl::string_view associated_data,
+      absl::Span<const absl::Span<char>> ciphertext) const override;
+
+  static constexpr crypto::tink::internal::FipsCompatibility kFipsStatus =
+      crypto::tink::internal::FipsCompatibility::kNotFips;
+
+ private:
+  explicit AesGcmHkdfSegmentedAead(Params params)
+      : ikm_(std::move(params.ikm)),
+        hkdf_hash_(params.hkdf_hash),
+        derived_key_size_(params.derived_key_size),
+        ciphertext_segment_size_(params.ciphertext_segment_size),
+        executor_(std::move(params.executor)) {}
+
+  int header_size() const;
+
+  // Returns the number of segments of a plaintext of `plaintext_size` bytes.
+  int64_t NumSegments(int64_t plaintext_size) const;
+
+  // Encrypts `plaintext` into `ciphertext`, which must have exactly
+  // MaxEncryptionSize(plaintext.size()) bytes.
+  util::Status EncryptInto(absl::string_view plaintext,
+                           absl::string_view associated_data,
+                           absl::Span<char> ciphertext) const;
+
+  // Runs `task(i)` for all segments i in [0, num_segments).
+  void RunSegments(int64_t num_segments,
+                   const std::function<void(int64_t)>& task) const;
+
+  const util::SecretData ikm_;
+  const HashType hkdf_hash_;
+  const int derived_key_size_;
+  const int ciphertext_segment_size_;
+  const Executor executor_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_AES_GCM_HKDF_SEGMENTED_AEAD_H_
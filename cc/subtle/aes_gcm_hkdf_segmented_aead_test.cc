@@ -0,0 +1,338 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/subtle/aes_gcm_hkdf_segmented_aead.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/aead.h"
+#include "tink/config/tink_fips.h"
+#include "tink/input_stream.h"
+#include "tink/subtle/aes_gcm_hkdf_streaming.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/streaming_aead_test_util.h"
+#include "tink/subtle/test_util.h"
+#include "tink/util/istream_input_stream.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::IsOkAndHolds;
+using ::crypto::tink::test::StatusIs;
+using ::testing::Eq;
+using ::testing::Gt;
+using ::testing::Not;
+
+constexpr int kSegmentSize = 128;
+
+AesGcmHkdfSegmentedAead::Params TestParams(const util::SecretData& ikm) {
+  AesGcmHkdfSegmentedAead::Params params;
+  params.ikm = ikm;
+  params.hkdf_hash = SHA256;
+  params.derived_key_size = 16;
+  params.ciphertext_segment_size = kSegmentSize;
+  return params;
+}
+
+// Decrypts `ciphertext` with AesGcmHkdfStreaming.
+util::StatusOr<std::string> DecryptAsStream(const util::SecretData& ikm,
+                                            absl::string_view ciphertext,
+                                            absl::string_view associated_data) {
+  AesGcmHkdfStreaming::Params params;
+  params.ikm = ikm;
+  params.hkdf_hash = SHA256;
+  params.derived_key_size = 16;
+  params.ciphertext_segment_size = kSegmentSize;
+  params.ciphertext_offset = 0;
+  util::StatusOr<std::unique_ptr<AesGcmHkdfStreaming>> streaming_aead =
+      AesGcmHkdfStreaming::New(std::move(params));
+  if (!streaming_aead.ok()) return streaming_aead.status();
+  util::StatusOr<std::unique_ptr<InputStream>> stream =
+      (*streaming_aead)
+          ->NewDecryptingStream(
+              absl::make_unique<util::IstreamInputStream>(
+                  absl::make_unique<std::stringstream>(std::string(ciphertext))),
+              associated_data);
+  if (!stream.ok()) return stream.status();
+  std::string plaintext;
+  util::Status status = test::ReadFromStream(stream->get(), &plaintext);
+  if (!status.ok()) return status;
+  return plaintext;
+}
+
+TEST(AesGcmHkdfSegmentedAeadTest, EncryptDecrypt) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  for (HashType hkdf_hash : {SHA1, SHA256, SHA512}) {
+    for (int derived_key_size : {16, 32}) {
+      AesGcmHkdfSegmentedAead::Params params;
+      params.ikm = Random::GetRandomKeyBytes(32);
+      params.hkdf_hash = hkdf_hash;
+      params.derived_key_size = derived_key_size;
+      params.ciphertext_segment_size = kSegmentSize;
+      util::StatusOr<std::unique_ptr<Aead>> aead =
+          AesGcmHkdfSegmentedAead::New(std::move(params));
+      ASSERT_THAT(aead, IsOk());
+      // Sizes around the boundaries of the first and of later segments.
+      const int header_size = 1 + derived_key_size + 7;
+      const int first_segment_size = kSegmentSize - header_size - 16;
+      for (int size : {0, 1, first_segment_size - 1, first_segment_size,
+                       first_segment_size + 1, first_segment_size + 112,
+                       first_segment_size + 113, 5000}) {
+        SCOPED_TRACE(absl::StrCat("hkdf_hash = ", EnumToString(hkdf_hash),
+                                  ", derived_key_size = ", derived_key_size,
+                                  ", plaintext size = ", size));
+        std::string plaintext = Random::GetRandomBytes(size);
+        util::StatusOr<std::string> ciphertext =
+            (*aead)->Encrypt(plaintext, "associated data");
+        ASSERT_THAT(ciphertext, IsOk());
+        EXPECT_THAT((*aead)->Decrypt(*ciphertext, "associated data"),
+                    IsOkAndHolds(Eq(plaintext)));
+        EXPECT_THAT((*aead)->Decrypt(*ciphertext, "other data").status(),
+                    Not(IsOk()));
+      }
+    }
+  }
+}
+
+TEST(AesGcmHkdfSegmentedAeadTest, CiphertextIsStreamingCiphertext) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  util::SecretData ikm = Random::GetRandomKeyBytes(16);
+  util::StatusOr<std::unique_ptr<Aead>> aead =
+      AesGcmHkdfSegmentedAead::New(TestParams(ikm));
+  ASSERT_THAT(aead, IsOk());
+  for (int size : {0, 10, 100, 1000}) {
+    SCOPED_TRACE(absl::StrCat("plaintext size = ", size));
+    std::string plaintext = Random::GetRandomBytes(size);
+    util::StatusOr<std::string> ciphertext =
+        (*aead)->Encrypt(plaintext, "associated data");
+    ASSERT_THAT(ciphertext, IsOk());
+    EXPECT_THAT(DecryptAsStream(ikm, *ciphertext, "associated data"),
+                IsOkAndHolds(Eq(plaintext)));
+
+    // And the other way around.
+    AesGcmHkdfStreaming::Params params;
+    params.ikm = ikm;
+    params.hkdf_hash = SHA256;
+    params.derived_key_size = 16;
+    params.ciphertext_segment_size = kSegmentSize;
+    params.ciphertext_offset = 0;
+    util::StatusOr<std::unique_ptr<AesGcmHkdfStreaming>> streaming_aead =
+        AesGcmHkdfStreaming::New(std::move(params));
+    ASSERT_THAT(streaming_aead, IsOk());
+    util::StatusOr<std::string> stream_ciphertext = EncryptToString(
+        streaming_aead->get(), plaintext, "associated data",
+        /*ciphertext_offset=*/0);
+    ASSERT_THAT(stream_ciphertext, IsOk());
+    EXPECT_THAT((*aead)->Decrypt(*stream_ciphertext, "associated data"),
+                IsOkAndHolds(Eq(plaintext)));
+  }
+}
+
+TEST(AesGcmHkdfSegmentedAeadTest, EncryptWithPrefix) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  util::StatusOr<std::unique_ptr<Aead>> aead =
+      AesGcmHkdfSegmentedAead::New(TestParams(Random::GetRandomKeyBytes(16)));
+  ASSERT_THAT(aead, IsOk());
+  std::string plaintext = Random::GetRandomBytes(1000);
+  util::StatusOr<std::string> ciphertext =
+      (*aead)->EncryptWithPrefix("prefix", plaintext, "associated data");
+  ASSERT_THAT(ciphertext, IsOk());
+  ASSERT_EQ(ciphertext->substr(0, 6), "prefix");
+  EXPECT_THAT((*aead)->Decrypt(ciphertext->substr(6), "associated data"),
+              IsOkAndHolds(Eq(plaintext)));
+}
+
+TEST(AesGcmHkdfSegmentedAeadTest, MaxEncryptionSizeIsCiphertextSize) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  util::StatusOr<std::unique_ptr<Aead>> aead =
+      AesGcmHkdfSegmentedAead::New(TestParams(Random::GetRandomKeyBytes(16)));
+  ASSERT_THAT(aead, IsOk());
+  for (int size : {0, 1, 50, 127, 128, 1000}) {
+    std::string plaintext = Random::GetRandomBytes(size);
+    util::StatusOr<std::string> ciphertext =
+        (*aead)->Encrypt(plaintext, "associated data");
+    ASSERT_THAT(ciphertext, IsOk());
+    EXPECT_THAT((*aead)->MaxEncryptionSize(size),
+                IsOkAndHolds(Eq(ciphertext->size())))
+        << "size " << size;
+  }
+}
+
+TEST(AesGcmHkdfSegmentedAeadTest, EncryptFragments) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  util::StatusOr<std::unique_ptr<Aead>> aead =
+      AesGcmHkdfSegmentedAead::New(TestParams(Random::GetRandomKeyBytes(16)));
+  ASSERT_THAT(aead, IsOk());
+  std::string plaintext = Random::GetRandomBytes(1000);
+  util::StatusOr<int64_t> size = (*aead)->MaxEncryptionSize(plaintext.size());
+  ASSERT_THAT(size, IsOk());
+
+  // A single fragment is encrypted in place.
+  std::string ciphertext(*size + 10, 'x');
+  EXPECT_THAT((*aead)->EncryptFragments({plaintext}, "associated data",
+                                        {absl::MakeSpan(ciphertext)}),
+              IsOkAndHolds(Eq(*size)));
+  EXPECT_THAT(
+      (*aead)->Decrypt(ciphertext.substr(0, *size), "associated data"),
+      IsOkAndHolds(Eq(plaintext)));
+  EXPECT_THAT((*aead)->EncryptFragments(
+                  {plaintext}, "associated data",
+                  {absl::MakeSpan(ciphertext).subspan(0, *size - 1)})
+                  .status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+
+  // Other fragmentations are supported as well.
+  std::string first(100, 'x');
+  std::string second(*size - 100, 'x');
+  EXPECT_THAT(
+      (*aead)->EncryptFragments(
+          {absl::string_view(plaintext).substr(0, 300),
+           absl::string_view(plaintext).substr(300)},
+          "associated data",
+          {absl::MakeSpan(first), absl::MakeSpan(second)}),
+      IsOkAndHolds(Eq(*size)));
+  EXPECT_THAT((*aead)->Decrypt(absl::StrCat(first, second), "associated data"),
+              IsOkAndHolds(Eq(plaintext)));
+}
+
+TEST(AesGcmHkdfSegmentedAeadTest, UsesExecutor) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  std::atomic<int64_t> num_tasks(0);
+  AesGcmHkdfSegmentedAead::Params params =
+      TestParams(Random::GetRandomKeyBytes(16));
+  params.executor = [&num_tasks](int64_t n,
+                                 const std::function<void(int64_t)>& task) {
+    // Run the segments in reverse order, to check that they are independent.
+    for (int64_t i = n - 1; i >= 0; --i) {
+      task(i);
+      ++num_tasks;
+    }
+  };
+  util::StatusOr<std::unique_ptr<Aead>> aead =
+      AesGcmHkdfSegmentedAead::New(std::move(params));
+  ASSERT_THAT(aead, IsOk());
+
+  std::string plaintext = Random::GetRandomBytes(1000);
+  util::StatusOr<std::string> ciphertext =
+      (*aead)->Encrypt(plaintext, "associated data");
+  ASSERT_THAT(ciphertext, IsOk());
+  EXPECT_THAT(num_tasks.load(), Gt(1));
+  EXPECT_THAT((*aead)->Decrypt(*ciphertext, "associated data"),
+              IsOkAndHolds(Eq(plaintext)));
+}
+
+TEST(AesGcmHkdfSegmentedAeadTest, ModifiedCiphertextFails) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  util::StatusOr<std::unique_ptr<Aead>> aead =
+      AesGcmHkdfSegmentedAead::New(TestParams(Random::GetRandomKeyBytes(16)));
+  ASSERT_THAT(aead, IsOk());
+  std::string plaintext = Random::GetRandomBytes(500);
+  util::StatusOr<std::string> ciphertext =
+      (*aead)->Encrypt(plaintext, "associated data");
+  ASSERT_THAT(ciphertext, IsOk());
+
+  for (size_t i = 0; i < ciphertext->size(); i += 7) {
+    std::string modified = *ciphertext;
+    modified[i] ^= 1;
+    EXPECT_THAT((*aead)->Decrypt(modified, "associated data").status(),
+                Not(IsOk()))
+        << "byte " << i;
+  }
+  // Truncation, also at segment boundaries.
+  for (size_t size : {0, 10, 100, 128, 256, 384}) {
+    EXPECT_THAT(
+        (*aead)->Decrypt(ciphertext->substr(0, size), "associated data")
+            .status(),
+        Not(IsOk()))
+        << "size " << size;
+  }
+  EXPECT_THAT(
+      (*aead)->Decrypt(absl::StrCat(*ciphertext, "x"), "associated data")
+          .status(),
+      Not(IsOk()));
+}
+
+TEST(AesGcmHkdfSegmentedAeadTest, InvalidParams) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  AesGcmHkdfSegmentedAead::Params params =
+      TestParams(Random::GetRandomKeyBytes(16));
+  params.derived_key_size = 32;
+  EXPECT_THAT(AesGcmHkdfSegmentedAead::New(params).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+
+  params = TestParams(Random::GetRandomKeyBytes(16));
+  params.hkdf_hash = SHA384;
+  EXPECT_THAT(AesGcmHkdfSegmentedAead::New(params).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+
+  params = TestParams(Random::GetRandomKeyBytes(16));
+  params.ciphertext_segment_size = 1 + 16 + 7 + 16;
+  EXPECT_THAT(AesGcmHkdfSegmentedAead::New(params).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(AesGcmHkdfSegmentedAeadTest, FipsMode) {
+  if (!IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Only supported in FIPS-only mode";
+  }
+  EXPECT_THAT(
+      AesGcmHkdfSegmentedAead::New(TestParams(Random::GetRandomKeyBytes(16)))
+          .status(),
+      StatusIs(absl::StatusCode::kInternal));
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
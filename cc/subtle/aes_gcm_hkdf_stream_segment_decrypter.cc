@@ -30,8 +30,13 @@
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/span.h"
+#include "openssl/crypto.h"
+#include "openssl/evp.h"
+#include "tink/aead/internal/aead_util.h"
 #include "tink/aead/internal/ssl_aead.h"
+#include "tink/internal/aes_util.h"
 #include "tink/internal/err_util.h"
+#include "tink/internal/ssl_unique_ptr.h"
 #include "tink/subtle/aes_gcm_hkdf_stream_segment_encrypter.h"
 #include "tink/subtle/common_enums.h"
 #include "tink/subtle/hkdf.h"
@@ -60,6 +65,69 @@ void BigEndianStore32(uint8_t dst[4], uint32_t val) {
   std::memcpy(dst, &val, sizeof(val));
 }
 
+void BigEndianStore64(uint8_t dst[8], uint64_t val) {
+  for (int i = 7; i >= 0; --i) {
+    dst[i] = val & 0xff;
+    val >>= 8;
+  }
+}
+
+uint64_t BigEndianLoad64(const uint8_t src[8]) {
+  uint64_t val = 0;
+  for (int i = 0; i < 8; ++i) {
+    val = (val << 8) | src[i];
+  }
+  return val;
+}
+
+// Sets 'out' to the product of 'x' and 'y' in GF(2^128), using the bit order
+// and reduction polynomial of GCM (NIST SP 800-38D, Algorithm 1). Runs in
+// constant time.
+void GcmMultiply(const uint8_t x[16], const uint8_t y[16], uint8_t out[16]) {
+  uint64_t z_hi = 0;
+  uint64_t z_lo = 0;
+  uint64_t v_hi = BigEndianLoad64(y);
+  uint64_t v_lo = BigEndianLoad64(y + 8);
+  for (int i = 0; i < 128; ++i) {
+    const uint64_t bit = (x[i / 8] >> (7 - i % 8)) & 1;
+    const uint64_t mask = 0 - bit;
+    z_hi ^= v_hi & mask;
+    z_lo ^= v_lo & mask;
+    const uint64_t reduce = 0 - (v_lo & 1);
+    v_lo = (v_lo >> 1) | (v_hi << 63);
+    v_hi = (v_hi >> 1) ^ (0xe100000000000000ULL & reduce);
+  }
+  BigEndianStore64(out, z_hi);
+  BigEndianStore64(out + 8, z_lo);
+}
+
+util::StatusOr<util::SecretData> ComputeHashSubkey(
+    const util::SecretData& key) {
+  util::StatusOr<const EVP_CIPHER*> cipher =
+      internal::GetAesEcbCipherForKeySize(key.size());
+  if (!cipher.ok()) {
+    return cipher.status();
+  }
+  internal::SslUniquePtr<EVP_CIPHER_CTX> ctx(EVP_CIPHER_CTX_new());
+  if (ctx == nullptr) {
+    return util::Status(absl::StatusCode::kInternal,
+                        "could not initialize EVP_CIPHER_CTX");
+  }
+  const uint8_t zeros[AesGcmHkdfStreamSegmentEncrypter::kTagSizeInBytes] = {};
+  util::SecretData hash_subkey(sizeof(zeros));
+  int len = 0;
+  if (EVP_EncryptInit_ex(ctx.get(), *cipher, /*impl=*/nullptr, key.data(),
+                         /*iv=*/nullptr) != 1 ||
+      EVP_CIPHER_CTX_set_padding(ctx.get(), /*pad=*/0) != 1 ||
+      EVP_EncryptUpdate(ctx.get(), hash_subkey.data(), &len, zeros,
+                        sizeof(zeros)) != 1 ||
+      len != sizeof(zeros)) {
+    return util::Status(absl::StatusCode::kInternal,
+                        "could not compute hash subkey");
+  }
+  return hash_subkey;
+}
+
 util::Status Validate(const AesGcmHkdfStreamSegmentDecrypter::Params& params) {
   if (!(params.hkdf_hash == SHA1 || params.hkdf_hash == SHA256 ||
         params.hkdf_hash == SHA512)) {
@@ -153,7 +221,19 @@ util::Status AesGcmHkdfStreamSegmentDecrypter::Init(
   if (!aead_ptr.ok()) {
     return aead_ptr.status();
   }
+  util::StatusOr<const EVP_CIPHER*> gcm_cipher =
+      internal::GetAesGcmCipherForKeySize(key->size());
+  if (!gcm_cipher.ok()) {
+    return gcm_cipher.status();
+  }
+  util::StatusOr<util::SecretData> hash_subkey = ComputeHashSubkey(*key);
+  if (!hash_subkey.ok()) {
+    return hash_subkey.status();
+  }
   aead_ = *std::move(aead_ptr);
+  gcm_cipher_ = *gcm_cipher;
+  key_ = *std::move(key);
+  hash_subkey_ = *std::move(hash_subkey);
   is_initialized_ = true;
   return util::OkStatus();
 }
@@ -163,44 +243,59 @@ int AesGcmHkdfStreamSegmentDecrypter::get_plaintext_segment_size() const {
          AesGcmHkdfStreamSegmentEncrypter::kTagSizeInBytes;
 }
 
-util::Status AesGcmHkdfStreamSegmentDecrypter::DecryptSegment(
-    const std::vector<uint8_t>& ciphertext, int64_t segment_number,
-    bool is_last_segment, std::vector<uint8_t>* plaintext_buffer) {
+util::Status AesGcmHkdfStreamSegmentDecrypter::ValidateSegment(
+    size_t ciphertext_size, int64_t segment_number,
+    bool is_last_segment) const {
   if (!is_initialized_) {
     return util::Status(absl::StatusCode::kFailedPrecondition,
                         "decrypter not initialized");
   }
-  if (ciphertext.size() > get_ciphertext_segment_size()) {
+  if (ciphertext_size > get_ciphertext_segment_size()) {
     return util::Status(absl::StatusCode::kInvalidArgument,
                         "ciphertext too long");
   }
-  if (ciphertext.size() < AesGcmHkdfStreamSegmentEncrypter::kTagSizeInBytes) {
+  if (ciphertext_size < AesGcmHkdfStreamSegmentEncrypter::kTagSizeInBytes) {
     return util::Status(absl::StatusCode::kInvalidArgument,
                         "ciphertext too short");
   }
-  if (plaintext_buffer == nullptr) {
-    return util::Status(absl::StatusCode::kInvalidArgument,
-                        "plaintext_buffer must be non-null");
-  }
   if (segment_number > std::numeric_limits<uint32_t>::max() ||
       (segment_number == std::numeric_limits<uint32_t>::max() &&
        !is_last_segment)) {
     return util::Status(absl::StatusCode::kInvalidArgument,
                         "too many segments");
   }
+  return util::OkStatus();
+}
 
-  const int64_t kPlaintextSize =
-      ciphertext.size() - AesGcmHkdfStreamSegmentEncrypter::kTagSizeInBytes;
-  plaintext_buffer->resize(kPlaintextSize);
-
-  // Construct IV.
+std::vector<uint8_t> AesGcmHkdfStreamSegmentDecrypter::SegmentIv(
+    int64_t segment_number, bool is_last_segment) const {
   std::vector<uint8_t> iv(AesGcmHkdfStreamSegmentEncrypter::kNonceSizeInBytes);
   absl::c_copy(nonce_prefix_, iv.begin());
   BigEndianStore32(
       iv.data() + AesGcmHkdfStreamSegmentEncrypter::kNoncePrefixSizeInBytes,
       static_cast<uint32_t>(segment_number));
   iv.back() = is_last_segment ? 1 : 0;
+  return iv;
+}
 
+util::Status AesGcmHkdfStreamSegmentDecrypter::DecryptSegment(
+    const std::vector<uint8_t>& ciphertext, int64_t segment_number,
+    bool is_last_segment, std::vector<uint8_t>* plaintext_buffer) {
+  util::Status status =
+      ValidateSegment(ciphertext.size(), segment_number, is_last_segment);
+  if (!status.ok()) {
+    return status;
+  }
+  if (plaintext_buffer == nullptr) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "plaintext_buffer must be non-null");
+  }
+
+  const int64_t kPlaintextSize =
+      ciphertext.size() - AesGcmHkdfStreamSegmentEncrypter::kTagSizeInBytes;
+  plaintext_buffer->resize(kPlaintextSize);
+
+  std::vector<uint8_t> iv = SegmentIv(segment_number, is_last_segment);
   util::StatusOr<uint64_t> written_bytes = aead_->Decrypt(
       absl::string_view(reinterpret_cast<const char*>(ciphertext.data()),
                         ciphertext.size()),
@@ -214,6 +309,70 @@ util::Status AesGcmHkdfStreamSegmentDecrypter::DecryptSegment(
   return util::OkStatus();
 }
 
+// A segment is encrypted with an empty associated data A, so its tag is
+//   T = AES_K(J0) xor GHASH_H(C || [len(A)]_64 || [len(C)]_64)
+// with len(A) = 0. GCM with C as associated data and an empty message (i.e.,
+// GMAC over C) under the same IV returns
+//   T' = AES_K(J0) xor GHASH_H(C || [len(C)]_64 || [0]_64).
+// Both hash the same number of blocks and differ only in the last one, and
+// GHASH is linear, so T = T' xor (([len(C)]_64 || [len(C)]_64) * H).
+// This authenticates the segment with the GHASH kernel of the backend alone,
+// without running AES-CTR over the ciphertext.
+util::Status AesGcmHkdfStreamSegmentDecrypter::VerifySegment(
+    absl::Span<const uint8_t> ciphertext, int64_t segment_number,
+    bool is_last_segment) {
+  util::Status status =
+      ValidateSegment(ciphertext.size(), segment_number, is_last_segment);
+  if (!status.ok()) {
+    return status;
+  }
+  constexpr int kTagSize = AesGcmHkdfStreamSegmentEncrypter::kTagSizeInBytes;
+  const size_t ct_size = ciphertext.size() - kTagSize;
+  std::vector<uint8_t> iv = SegmentIv(segment_number, is_last_segment);
+
+  internal::SslUniquePtr<EVP_CIPHER_CTX> ctx(EVP_CIPHER_CTX_new());
+  if (ctx == nullptr) {
+    return util::Status(absl::StatusCode::kInternal,
+                        "could not initialize EVP_CIPHER_CTX");
+  }
+  if (EVP_EncryptInit_ex(ctx.get(), gcm_cipher_, /*impl=*/nullptr,
+                         /*key=*/nullptr, /*iv=*/nullptr) != 1 ||
+      EVP_CIPHER_CTX_ctrl(ctx.get(), EVP_CTRL_AEAD_SET_IVLEN, iv.size(),
+                          /*ptr=*/nullptr) != 1 ||
+      EVP_EncryptInit_ex(ctx.get(), /*cipher=*/nullptr, /*impl=*/nullptr,
+                         key_.data(), iv.data()) != 1) {
+    return util::Status(absl::StatusCode::kInternal,
+                        "could not initialize ctx");
+  }
+  int len = 0;
+  if (ct_size > 0 &&
+      EVP_EncryptUpdate(ctx.get(), /*out=*/nullptr, &len, ciphertext.data(),
+                        ct_size) != 1) {
+    return util::Status(absl::StatusCode::kInternal,
+                        "could not authenticate ciphertext");
+  }
+  uint8_t tag[kTagSize];
+  if (EVP_EncryptFinal_ex(ctx.get(), /*out=*/nullptr, &len) != 1 ||
+      EVP_CIPHER_CTX_ctrl(ctx.get(), EVP_CTRL_AEAD_GET_TAG, kTagSize, tag) !=
+          1) {
+    return util::Status(absl::StatusCode::kInternal, "could not compute tag");
+  }
+
+  uint8_t lengths[kTagSize];
+  BigEndianStore64(lengths, 8 * static_cast<uint64_t>(ct_size));
+  BigEndianStore64(lengths + 8, 8 * static_cast<uint64_t>(ct_size));
+  uint8_t correction[kTagSize];
+  GcmMultiply(lengths, hash_subkey_.data(), correction);
+  for (int i = 0; i < kTagSize; ++i) {
+    tag[i] ^= correction[i];
+  }
+  if (CRYPTO_memcmp(tag, ciphertext.data() + ct_size, kTagSize) != 0) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "Authentication failed");
+  }
+  return util::OkStatus();
+}
+
 }  // namespace subtle
 }  // namespace tink
 }  // namespace crypto
@@ -17,11 +17,14 @@
 #ifndef TINK_SUBTLE_AES_GCM_HKDF_STREAM_SEGMENT_DECRYPTER_H_
 #define TINK_SUBTLE_AES_GCM_HKDF_STREAM_SEGMENT_DECRYPTER_H_
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "absl/types/span.h"
+#include "openssl/evp.h"
 #include "tink/aead/internal/ssl_aead.h"
 #include "tink/subtle/common_enums.h"
 #include "tink/subtle/stream_segment_decrypter.h"
@@ -80,6 +83,11 @@ class AesGcmHkdfStreamSegmentDecrypter : public StreamSegmentDecrypter {
       bool is_last_segment,
       std::vector<uint8_t>* plaintext_buffer) override;
 
+  // Checks the tag with GHASH only, without running AES-CTR.
+  util::Status VerifySegment(absl::Span<const uint8_t> ciphertext,
+                             int64_t segment_number,
+                             bool is_last_segment) override;
+
   int get_header_size() const override {
     return header_size_;
   }
@@ -96,6 +104,14 @@ class AesGcmHkdfStreamSegmentDecrypter : public StreamSegmentDecrypter {
  private:
   explicit AesGcmHkdfStreamSegmentDecrypter(Params params);
 
+  // Checks the arguments shared by DecryptSegment() and VerifySegment().
+  util::Status ValidateSegment(size_t ciphertext_size, int64_t segment_number,
+                               bool is_last_segment) const;
+
+  // Returns the IV of the specified segment.
+  std::vector<uint8_t> SegmentIv(int64_t segment_number,
+                                 bool is_last_segment) const;
+
   // Parameters set upon decrypter creation.
   // All sizes are in bytes.
   const util::SecretData ikm_;
@@ -112,6 +128,10 @@ class AesGcmHkdfStreamSegmentDecrypter : public StreamSegmentDecrypter {
   std::vector<uint8_t> nonce_prefix_;
 
   std::unique_ptr<internal::SslOneShotAead> aead_;
+  // Used by VerifySegment().
+  const EVP_CIPHER* gcm_cipher_ = nullptr;
+  util::SecretData key_;
+  util::SecretData hash_subkey_;
 };
 
 }  // namespace subtle
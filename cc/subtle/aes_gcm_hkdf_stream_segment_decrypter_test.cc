@@ -149,6 +149,71 @@ TEST(AesGcmHkdfStreamSegmentDecrypterTest, testBasic) {
 }
 
 
+TEST(AesGcmHkdfStreamSegmentDecrypterTest, testVerifySegment) {
+  for (int derived_key_size : {16, 32}) {
+    SCOPED_TRACE(absl::StrCat("derived_key_size = ", derived_key_size));
+    AesGcmHkdfStreamSegmentDecrypter::Params params;
+    params.ikm = Random::GetRandomKeyBytes(32);
+    params.hkdf_hash = SHA256;
+    params.derived_key_size = derived_key_size;
+    params.ciphertext_offset = 0;
+    params.ciphertext_segment_size = 256;
+    params.associated_data = "associated data";
+    auto result = AesGcmHkdfStreamSegmentDecrypter::New(params);
+    ASSERT_TRUE(result.ok()) << result.status();
+    auto dec = std::move(result.value());
+    std::vector<uint8_t> ct(32, 'c');
+    EXPECT_EQ(absl::StatusCode::kFailedPrecondition,
+              dec->VerifySegment(ct, 0, false).code());
+
+    auto enc = std::move(GetEncrypter(params.ikm, SHA256, derived_key_size,
+                                      /*ciphertext_offset=*/0, 256,
+                                      params.associated_data)
+                             .value());
+    ASSERT_TRUE(dec->Init(enc->get_header()).ok());
+
+    int segment_number = 0;
+    for (int pt_size :
+         {0, 1, 15, 16, 17, 100, dec->get_plaintext_segment_size()}) {
+      for (bool is_last_segment : {false, true}) {
+        SCOPED_TRACE(absl::StrCat("plaintext_size = ", pt_size,
+                                  ", is_last_segment = ", is_last_segment));
+        std::vector<uint8_t> pt(pt_size, 'p');
+        std::vector<uint8_t> ct;
+        ASSERT_TRUE(enc->EncryptSegment(pt, is_last_segment, &ct).ok());
+        EXPECT_TRUE(
+            dec->VerifySegment(ct, segment_number, is_last_segment).ok());
+
+        // Wrong segment number or last-segment flag.
+        EXPECT_FALSE(
+            dec->VerifySegment(ct, segment_number + 1, is_last_segment).ok());
+        EXPECT_FALSE(
+            dec->VerifySegment(ct, segment_number, !is_last_segment).ok());
+
+        // Modified ciphertext or tag.
+        for (int i = 0; i < ct.size(); ++i) {
+          std::vector<uint8_t> modified_ct = ct;
+          modified_ct[i] ^= 1;
+          std::vector<uint8_t> decrypted;
+          EXPECT_FALSE(dec->DecryptSegment(modified_ct, segment_number,
+                                           is_last_segment, &decrypted)
+                           .ok());
+          EXPECT_FALSE(
+              dec->VerifySegment(modified_ct, segment_number, is_last_segment)
+                  .ok());
+        }
+        // Truncated ciphertext.
+        std::vector<uint8_t> truncated_ct(ct.begin(), ct.end() - 1);
+        EXPECT_FALSE(
+            dec->VerifySegment(truncated_ct, segment_number, is_last_segment)
+                .ok());
+        segment_number++;
+      }
+    }
+  }
+}
+
+
 TEST(AesGcmHkdfStreamSegmentDecrypterTest, testWrongDerivedKeySize) {
   for (int derived_key_size : {12, 24, 64}) {
     for (HashType hkdf_hash : {SHA1, SHA256, SHA512}) {
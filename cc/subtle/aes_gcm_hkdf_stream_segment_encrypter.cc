@@ -31,6 +31,7 @@
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/span.h"
+#include "tink/aead/internal/af_alg_aes_gcm.h"
 #include "tink/aead/internal/ssl_aead.h"
 #include "tink/internal/err_util.h"
 #include "tink/subtle/random.h"
@@ -71,6 +72,17 @@ util::Status Validate(const AesGcmHkdfStreamSegmentEncrypter::Params& params) {
     return util::Status(absl::StatusCode::kInvalidArgument,
                         "ciphertext_offset must be non-negative");
   }
+  if (!params.nonce_prefix.empty() &&
+      params.nonce_prefix.size() !=
+          AesGcmHkdfStreamSegmentEncrypter::kNoncePrefixSizeInBytes) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "nonce_prefix has wrong size");
+  }
+  if (params.first_segment_number < 0 ||
+      params.first_segment_number > std::numeric_limits<uint32_t>::max()) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "first_segment_number out of range");
+  }
   int header_size = 1 + params.salt.size() +
                     AesGcmHkdfStreamSegmentEncrypter::kNoncePrefixSizeInBytes;
   if (params.ciphertext_segment_size <=
@@ -117,12 +129,17 @@ int AesGcmHkdfStreamSegmentEncrypter::get_plaintext_segment_size() const {
 }
 
 AesGcmHkdfStreamSegmentEncrypter::AesGcmHkdfStreamSegmentEncrypter(
-    std::unique_ptr<internal::SslOneShotAead> aead, const Params& params)
+    std::unique_ptr<internal::SslOneShotAead> aead,
+    std::unique_ptr<internal::AfAlgAesGcm> kernel_aead, const Params& params)
     : aead_(std::move(aead)),
-      nonce_prefix_(Random::GetRandomBytes(kNoncePrefixSizeInBytes)),
+      kernel_aead_(std::move(kernel_aead)),
+      nonce_prefix_(params.nonce_prefix.empty()
+                        ? Random::GetRandomBytes(kNoncePrefixSizeInBytes)
+                        : params.nonce_prefix),
       header_(CreateHeader(params.salt, nonce_prefix_)),
       ciphertext_segment_size_(params.ciphertext_segment_size),
-      ciphertext_offset_(params.ciphertext_offset) {}
+      ciphertext_offset_(params.ciphertext_offset),
+      segment_number_(params.first_segment_number) {}
 
 util::StatusOr<std::unique_ptr<StreamSegmentEncrypter>>
 AesGcmHkdfStreamSegmentEncrypter::New(Params params) {
@@ -135,14 +152,22 @@ AesGcmHkdfStreamSegmentEncrypter::New(Params params) {
   if (!aead.ok()) {
     return aead.status();
   }
-  return {absl::WrapUnique(
-      new AesGcmHkdfStreamSegmentEncrypter(*std::move(aead), params))};
+  std::unique_ptr<internal::AfAlgAesGcm> kernel_aead;
+  if (params.use_kernel_crypto) {
+    // Failures only mean that the kernel cannot be used.
+    util::StatusOr<std::unique_ptr<internal::AfAlgAesGcm>> kernel =
+        internal::AfAlgAesGcm::New(
+            params.key, params.ciphertext_segment_size - kTagSizeInBytes);
+    if (kernel.ok()) kernel_aead = *std::move(kernel);
+  }
+  return {absl::WrapUnique(new AesGcmHkdfStreamSegmentEncrypter(
+      *std::move(aead), std::move(kernel_aead), params))};
 }
 
-util::Status AesGcmHkdfStreamSegmentEncrypter::EncryptSegment(
-    const std::vector<uint8_t>& plaintext, bool is_last_segment,
-    std::vector<uint8_t>* ciphertext_buffer) {
-  if (plaintext.size() > get_plaintext_segment_size()) {
+util::Status AesGcmHkdfStreamSegmentEncrypter::CheckSegment(
+    int64_t plaintext_size, bool is_last_segment,
+    std::vector<uint8_t>* ciphertext_buffer) const {
+  if (plaintext_size > get_plaintext_segment_size()) {
     return util::Status(absl::StatusCode::kInvalidArgument,
                         "plaintext too long");
   }
@@ -156,6 +181,17 @@ util::Status AesGcmHkdfStreamSegmentEncrypter::EncryptSegment(
     return util::Status(absl::StatusCode::kInvalidArgument,
                         "too many segments");
   }
+  return util::OkStatus();
+}
+
+util::Status AesGcmHkdfStreamSegmentEncrypter::EncryptSegment(
+    const std::vector<uint8_t>& plaintext, bool is_last_segment,
+    std::vector<uint8_t>* ciphertext_buffer) {
+  util::Status status =
+      CheckSegment(plaintext.size(), is_last_segment, ciphertext_buffer);
+  if (!status.ok()) {
+    return status;
+  }
 
   const int64_t kCiphertextSize = plaintext.size() + kTagSizeInBytes;
   ciphertext_buffer->resize(kCiphertextSize);
@@ -180,6 +216,34 @@ util::Status AesGcmHkdfStreamSegmentEncrypter::EncryptSegment(
   return util::OkStatus();
 }
 
+util::Status AesGcmHkdfStreamSegmentEncrypter::EncryptSegmentFromFile(
+    int plaintext_fd, int plaintext_size, bool is_last_segment,
+    std::vector<uint8_t>* ciphertext_buffer) {
+  if (kernel_aead_ == nullptr) {
+    return util::Status(absl::StatusCode::kUnimplemented,
+                        "Kernel encryption is not available");
+  }
+  if (plaintext_size < 0) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "plaintext_size must be non-negative");
+  }
+  util::Status status =
+      CheckSegment(plaintext_size, is_last_segment, ciphertext_buffer);
+  if (!status.ok()) {
+    return status;
+  }
+  std::string iv =
+      ConstructNonce(nonce_prefix_, static_cast<uint32_t>(get_segment_number()),
+                     is_last_segment);
+  status = kernel_aead_->EncryptFromFd(plaintext_fd, plaintext_size, iv,
+                                       ciphertext_buffer);
+  if (!status.ok()) {
+    return status;
+  }
+  IncSegmentNumber();
+  return util::OkStatus();
+}
+
 }  // namespace subtle
 }  // namespace tink
 }  // namespace crypto
@@ -17,10 +17,12 @@
 #ifndef TINK_SUBTLE_AES_GCM_HKDF_STREAM_SEGMENT_ENCRYPTER_H_
 #define TINK_SUBTLE_AES_GCM_HKDF_STREAM_SEGMENT_ENCRYPTER_H_
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "tink/aead/internal/af_alg_aes_gcm.h"
 #include "tink/aead/internal/ssl_aead.h"
 #include "tink/subtle/stream_segment_encrypter.h"
 #include "tink/util/secret_data.h"
@@ -76,6 +78,16 @@ class AesGcmHkdfStreamSegmentEncrypter : public StreamSegmentEncrypter {
     std::string salt;
     int ciphertext_offset;
     int ciphertext_segment_size;
+    // To continue an existing ciphertext, the nonce prefix from its header
+    // and the number of the first segment to encrypt. If 'nonce_prefix' is
+    // empty, a random one is chosen.
+    std::string nonce_prefix;
+    int64_t first_segment_number = 0;
+    // If true, EncryptSegmentFromFile() encrypts in the kernel via AF_ALG
+    // where available, so that plaintext read from files is spliced into the
+    // kernel instead of being copied through user space. If the kernel does
+    // not support this, the encrypter silently uses user-space encryption.
+    bool use_kernel_crypto = false;
   };
 
   static util::StatusOr<std::unique_ptr<StreamSegmentEncrypter>> New(
@@ -85,6 +97,12 @@ class AesGcmHkdfStreamSegmentEncrypter : public StreamSegmentEncrypter {
                               bool is_last_segment,
                               std::vector<uint8_t>* ciphertext_buffer) override;
 
+  // Returns an UNIMPLEMENTED error unless `use_kernel_crypto` was set and
+  // the kernel supports AF_ALG encryption.
+  util::Status EncryptSegmentFromFile(
+      int plaintext_fd, int plaintext_size, bool is_last_segment,
+      std::vector<uint8_t>* ciphertext_buffer) override;
+
   const std::vector<uint8_t>& get_header() const override { return header_; }
   int64_t get_segment_number() const override { return segment_number_; }
   int get_plaintext_segment_size() const override;
@@ -98,19 +116,26 @@ class AesGcmHkdfStreamSegmentEncrypter : public StreamSegmentEncrypter {
 
  private:
   AesGcmHkdfStreamSegmentEncrypter(
-      std::unique_ptr<internal::SslOneShotAead> aead, const Params& params);
+      std::unique_ptr<internal::SslOneShotAead> aead,
+      std::unique_ptr<internal::AfAlgAesGcm> kernel_aead, const Params& params);
+
+  // Checks that a segment of `plaintext_size` bytes can be encrypted next.
+  util::Status CheckSegment(int64_t plaintext_size, bool is_last_segment,
+                            std::vector<uint8_t>* ciphertext_buffer) const;
 
   // When OpenSSL is used, this uses a thread-safe implementation that makes a
   // copy of the context for each EncryptSegment call, which may result in some
   // extra latency compared to BoringSSL.
   const std::unique_ptr<internal::SslOneShotAead> aead_;
+  // Null unless `use_kernel_crypto` was set and AF_ALG is available.
+  const std::unique_ptr<internal::AfAlgAesGcm> kernel_aead_;
 
   const std::string nonce_prefix_;
   const std::vector<uint8_t> header_;
   const int ciphertext_segment_size_;
   const int ciphertext_offset_;
 
-  int64_t segment_number_ = 0;
+  int64_t segment_number_;
 };
 
 }  // namespace subtle
@@ -16,6 +16,7 @@
 
 #include "tink/subtle/aes_gcm_hkdf_stream_segment_encrypter.h"
 
+#include <cstdint>
 #include <string>
 #include <utility>
 #include <vector>
@@ -196,6 +197,58 @@ TEST(AesGcmHkdfStreamSegmentEncrypterTest, testWrongCiphertextSegmentSize) {
   }
 }
 
+TEST(AesGcmHkdfStreamSegmentEncrypterTest, testContinueExistingStream) {
+  AesGcmHkdfStreamSegmentEncrypter::Params params;
+  params.key = Random::GetRandomKeyBytes(16);
+  params.salt = Random::GetRandomBytes(16);
+  params.ciphertext_offset = 0;
+  params.ciphertext_segment_size = 128;
+  auto original = AesGcmHkdfStreamSegmentEncrypter::New(params);
+  ASSERT_TRUE(original.ok()) << original.status();
+  std::vector<uint8_t> plaintext(50, 'a');
+  std::vector<uint8_t> original_ciphertext;
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_TRUE((*original)
+                    ->EncryptSegment(plaintext, /*is_last_segment=*/false,
+                                     &original_ciphertext)
+                    .ok());
+  }
+
+  // An encrypter with the same nonce prefix starting at segment 2 produces
+  // the same ciphertext for that segment.
+  const std::vector<uint8_t>& header = (*original)->get_header();
+  params.nonce_prefix = std::string(header.begin() + 1 + 16, header.end());
+  params.first_segment_number = 2;
+  auto continued = AesGcmHkdfStreamSegmentEncrypter::New(params);
+  ASSERT_TRUE(continued.ok()) << continued.status();
+  EXPECT_EQ((*continued)->get_header(), header);
+  EXPECT_EQ((*continued)->get_segment_number(), 2);
+  std::vector<uint8_t> continued_ciphertext;
+  ASSERT_TRUE((*continued)
+                  ->EncryptSegment(plaintext, /*is_last_segment=*/false,
+                                   &continued_ciphertext)
+                  .ok());
+  EXPECT_EQ(continued_ciphertext, original_ciphertext);
+}
+
+TEST(AesGcmHkdfStreamSegmentEncrypterTest, testWrongContinuationParams) {
+  AesGcmHkdfStreamSegmentEncrypter::Params params;
+  params.key = Random::GetRandomKeyBytes(16);
+  params.salt = Random::GetRandomBytes(16);
+  params.ciphertext_offset = 0;
+  params.ciphertext_segment_size = 128;
+  params.nonce_prefix = Random::GetRandomBytes(6);
+  auto result = AesGcmHkdfStreamSegmentEncrypter::New(params);
+  EXPECT_EQ(absl::StatusCode::kInvalidArgument, result.status().code());
+
+  params.nonce_prefix = Random::GetRandomBytes(7);
+  for (int64_t first_segment_number : {-1LL, 1LL << 32}) {
+    params.first_segment_number = first_segment_number;
+    result = AesGcmHkdfStreamSegmentEncrypter::New(params);
+    EXPECT_EQ(absl::StatusCode::kInvalidArgument, result.status().code());
+  }
+}
+
 }  // namespace
 }  // namespace subtle
 }  // namespace tink
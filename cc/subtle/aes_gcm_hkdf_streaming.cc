@@ -16,9 +16,11 @@
 
 #include "tink/subtle/aes_gcm_hkdf_streaming.h"
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
@@ -74,6 +76,18 @@ util::StatusOr<std::unique_ptr<AesGcmHkdfStreaming>> AesGcmHkdfStreaming::New(
 util::StatusOr<std::unique_ptr<StreamSegmentEncrypter>>
 AesGcmHkdfStreaming::NewSegmentEncrypter(
     absl::string_view associated_data) const {
+  return CreateSegmentEncrypter(associated_data, /*use_kernel_crypto=*/false);
+}
+
+util::StatusOr<std::unique_ptr<StreamSegmentEncrypter>>
+AesGcmHkdfStreaming::NewSegmentEncrypterForFile(
+    absl::string_view associated_data) const {
+  return CreateSegmentEncrypter(associated_data, use_kernel_crypto_);
+}
+
+util::StatusOr<std::unique_ptr<StreamSegmentEncrypter>>
+AesGcmHkdfStreaming::CreateSegmentEncrypter(absl::string_view associated_data,
+                                            bool use_kernel_crypto) const {
   AesGcmHkdfStreamSegmentEncrypter::Params params;
   params.salt = Random::GetRandomBytes(derived_key_size_);
   auto hkdf_result = Hkdf::ComputeHkdf(hkdf_hash_, ikm_, params.salt,
@@ -82,6 +96,34 @@ AesGcmHkdfStreaming::NewSegmentEncrypter(
   params.key = std::move(hkdf_result).value();
   params.ciphertext_offset = ciphertext_offset_;
   params.ciphertext_segment_size = ciphertext_segment_size_;
+  params.use_kernel_crypto = use_kernel_crypto;
+  return AesGcmHkdfStreamSegmentEncrypter::New(std::move(params));
+}
+
+util::StatusOr<std::unique_ptr<StreamSegmentEncrypter>>
+AesGcmHkdfStreaming::NewSegmentEncrypterForAppend(
+    absl::string_view associated_data, const std::vector<uint8_t>& header,
+    int64_t first_segment_number) const {
+  // The header is header_size || salt || nonce_prefix.
+  const int header_size =
+      1 + derived_key_size_ +
+      AesGcmHkdfStreamSegmentEncrypter::kNoncePrefixSizeInBytes;
+  if (header.size() != header_size || header[0] != header_size) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "corrupted header");
+  }
+  AesGcmHkdfStreamSegmentEncrypter::Params params;
+  params.salt = std::string(header.begin() + 1,
+                            header.begin() + 1 + derived_key_size_);
+  auto hkdf_result = Hkdf::ComputeHkdf(hkdf_hash_, ikm_, params.salt,
+                                       associated_data, derived_key_size_);
+  if (!hkdf_result.ok()) return hkdf_result.status();
+  params.key = std::move(hkdf_result).value();
+  params.ciphertext_offset = ciphertext_offset_;
+  params.ciphertext_segment_size = ciphertext_segment_size_;
+  params.nonce_prefix =
+      std::string(header.begin() + 1 + derived_key_size_, header.end());
+  params.first_segment_number = first_segment_number;
   return AesGcmHkdfStreamSegmentEncrypter::New(std::move(params));
 }
 
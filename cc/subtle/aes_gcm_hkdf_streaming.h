@@ -17,8 +17,10 @@
 #ifndef TINK_SUBTLE_AES_GCM_HKDF_STREAMING_H_
 #define TINK_SUBTLE_AES_GCM_HKDF_STREAMING_H_
 
+#include <cstdint>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "tink/internal/fips_utils.h"
 #include "tink/subtle/common_enums.h"
@@ -38,6 +40,11 @@ class AesGcmHkdfStreaming : public NonceBasedStreamingAead {
     int derived_key_size;
     int ciphertext_segment_size;
     int ciphertext_offset;
+    // If true, EncryptFile() (see streaming_aead_file_encryption.h) encrypts
+    // in the kernel via AF_ALG where available, splicing the plaintext from
+    // the file into the kernel. It falls back to user-space encryption if the
+    // kernel does not support this. The ciphertext is the same either way.
+    bool use_kernel_crypto = false;
   };
 
   static util::StatusOr<std::unique_ptr<AesGcmHkdfStreaming>> New(
@@ -50,22 +57,36 @@ class AesGcmHkdfStreaming : public NonceBasedStreamingAead {
   util::StatusOr<std::unique_ptr<StreamSegmentEncrypter>> NewSegmentEncrypter(
       absl::string_view associated_data) const override;
 
+  util::StatusOr<std::unique_ptr<StreamSegmentEncrypter>>
+  NewSegmentEncrypterForFile(absl::string_view associated_data) const override;
+
   util::StatusOr<std::unique_ptr<StreamSegmentDecrypter>> NewSegmentDecrypter(
       absl::string_view associated_data) const override;
 
+  util::StatusOr<std::unique_ptr<StreamSegmentEncrypter>>
+  NewSegmentEncrypterForAppend(absl::string_view associated_data,
+                               const std::vector<uint8_t>& header,
+                               int64_t first_segment_number) const override;
+
  private:
   explicit AesGcmHkdfStreaming(Params params)
       : ikm_(std::move(params.ikm)),
         hkdf_hash_(params.hkdf_hash),
         derived_key_size_(params.derived_key_size),
         ciphertext_segment_size_(params.ciphertext_segment_size),
-        ciphertext_offset_(params.ciphertext_offset) {}
+        ciphertext_offset_(params.ciphertext_offset),
+        use_kernel_crypto_(params.use_kernel_crypto) {}
+
+  util::StatusOr<std::unique_ptr<StreamSegmentEncrypter>>
+  CreateSegmentEncrypter(absl::string_view associated_data,
+                         bool use_kernel_crypto) const;
 
   const util::SecretData ikm_;
   const HashType hkdf_hash_;
   const int derived_key_size_;
   const int ciphertext_segment_size_;
   const int ciphertext_offset_;
+  const bool use_kernel_crypto_;
 };
 
 }  // namespace subtle
@@ -28,6 +28,7 @@
 #include "absl/strings/string_view.h"
 #include "absl/types/span.h"
 #include "tink/aead/internal/ssl_aead.h"
+#include "tink/internal/fragments.h"
 #include "tink/subtle/random.h"
 #include "tink/subtle/subtle_util.h"
 #include "tink/util/status.h"
@@ -98,6 +99,61 @@ util::StatusOr<std::string> AesGcmSivBoringSsl::Decrypt(
   return plaintext;
 }
 
+util::StatusOr<int64_t> AesGcmSivBoringSsl::MaxEncryptionSize(
+    int64_t plaintext_size) const {
+  return kIvSizeInBytes + aead_->CiphertextSize(plaintext_size);
+}
+
+util::StatusOr<int64_t> AesGcmSivBoringSsl::EncryptFragments(
+    absl::Span<const absl::string_view> plaintext,
+    absl::string_view associated_data,
+    absl::Span<const absl::Span<char>> ciphertext) const {
+  const int64_t ciphertext_size =
+      kIvSizeInBytes +
+      aead_->CiphertextSize(internal::FragmentsSize(plaintext));
+  const int64_t buffer_size = internal::FragmentsSize(ciphertext);
+  if (buffer_size < ciphertext_size) {
+    return util::Status(
+        absl::StatusCode::kInvalidArgument,
+        absl::StrCat("Ciphertext fragments too small; expected at least ",
+                     ciphertext_size, " bytes, got ", buffer_size));
+  }
+  std::string nonce;
+  ResizeStringUninitialized(&nonce, kIvSizeInBytes);
+  util::Status res = Random::GetRandomBytes(absl::MakeSpan(nonce));
+  if (!res.ok()) {
+    return res;
+  }
+  internal::CopyToFragments(nonce, ciphertext);
+  util::StatusOr<int64_t> written_bytes = aead_->EncryptFragments(
+      plaintext, associated_data, nonce,
+      internal::SubFragments(ciphertext, kIvSizeInBytes,
+                             buffer_size - kIvSizeInBytes));
+  if (!written_bytes.ok()) {
+    return written_bytes.status();
+  }
+  return kIvSizeInBytes + *written_bytes;
+}
+
+util::StatusOr<int64_t> AesGcmSivBoringSsl::DecryptFragments(
+    absl::Span<const absl::string_view> ciphertext,
+    absl::string_view associated_data,
+    absl::Span<const absl::Span<char>> plaintext) const {
+  const int64_t ciphertext_size = internal::FragmentsSize(ciphertext);
+  if (ciphertext_size < kIvSizeInBytes + kTagSizeInBytes) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        absl::StrCat("Ciphertext too short; expected at least ",
+                                     kIvSizeInBytes + kTagSizeInBytes,
+                                     " got ", ciphertext_size));
+  }
+  std::string nonce(kIvSizeInBytes, '\0');
+  internal::CopyFromFragments(ciphertext, absl::MakeSpan(nonce));
+  return aead_->DecryptFragments(
+      internal::SubFragments(ciphertext, kIvSizeInBytes,
+                             ciphertext_size - kIvSizeInBytes),
+      associated_data, nonce, plaintext);
+}
+
 }  // namespace subtle
 }  // namespace tink
 }  // namespace crypto
@@ -25,6 +25,7 @@
 #include "absl/status/status.h"
 #include "absl/strings/escaping.h"
 #include "absl/strings/str_cat.h"
+#include "absl/types/span.h"
 #include "tink/aead/internal/wycheproof_aead.h"
 #include "tink/config/tink_fips.h"
 #include "tink/internal/ssl_util.h"
@@ -47,6 +48,7 @@ constexpr int kIvSizeInBytes = 12;
 constexpr int kTagSizeInBytes = 16;
 
 using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::IsOkAndHolds;
 using ::crypto::tink::test::StatusIs;
 using ::testing::AllOf;
 using ::testing::Eq;
@@ -102,6 +104,38 @@ TEST(AesGcmSivBoringSslTest, DecryptFailsIfCiphertextTooSmall) {
   }
 }
 
+TEST(AesGcmSivBoringSslTest, EncryptDecryptFragments) {
+  if (!internal::IsBoringSsl()) {
+    GTEST_SKIP() << "Unimplemented with OpenSSL";
+  }
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+
+  util::StatusOr<std::unique_ptr<Aead>> aead = AesGcmSivBoringSsl::New(
+      util::SecretDataFromStringView(absl::HexStringToBytes(kKey256Hex)));
+  ASSERT_THAT(aead, IsOk());
+
+  std::string ciphertext(kMessage.size() + kIvSizeInBytes + kTagSizeInBytes, '\0');
+  absl::Span<char> buffer = absl::MakeSpan(ciphertext);
+  EXPECT_THAT(
+      (*aead)->EncryptFragments({kMessage.substr(0, 4), kMessage.substr(4)},
+                                kAssociatedData,
+                                {buffer.subspan(0, 5), buffer.subspan(5)}),
+      IsOkAndHolds(ciphertext.size()));
+  EXPECT_THAT((*aead)->Decrypt(ciphertext, kAssociatedData),
+              IsOkAndHolds(std::string(kMessage)));
+
+  absl::string_view ct = ciphertext;
+  std::string plaintext(kMessage.size(), '\0');
+  absl::Span<char> out = absl::MakeSpan(plaintext);
+  EXPECT_THAT((*aead)->DecryptFragments({ct.substr(0, 9), ct.substr(9)},
+                                        kAssociatedData,
+                                        {out.subspan(0, 2), out.subspan(2)}),
+              IsOkAndHolds(kMessage.size()));
+  EXPECT_EQ(plaintext, kMessage);
+}
+
 TEST(AesGcmSivBoringSslTest, TestFipsOnly) {
   if (!internal::IsBoringSsl()) {
     GTEST_SKIP() << "Unimplemented with OpenSSL";
@@ -34,6 +34,7 @@
 #include "tink/internal/aes_util.h"
 #include "tink/subtle/subtle_util.h"
 #include "tink/util/errors.h"
+#include "tink/util/request_arena.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
 
@@ -206,22 +207,47 @@ util::Status AesSivBoringSsl::AesCtrCrypt(absl::string_view in,
   return internal::AesCtr128Crypt(in, iv, key, out);
 }
 
-util::StatusOr<std::string> AesSivBoringSsl::EncryptDeterministically(
-    absl::string_view plaintext, absl::string_view associated_data) const {
+util::Status AesSivBoringSsl::EncryptInto(absl::string_view plaintext,
+                                          absl::string_view associated_data,
+                                          absl::Span<char> out) const {
   uint8_t siv[kBlockSize];
   S2v(absl::MakeSpan(reinterpret_cast<const uint8_t*>(associated_data.data()),
                      associated_data.size()),
       absl::MakeSpan(reinterpret_cast<const uint8_t*>(plaintext.data()),
                      plaintext.size()),
       siv);
-  size_t ciphertext_size = plaintext.size() + kBlockSize;
+  std::copy(std::begin(siv), std::end(siv), out.begin());
+  return AesCtrCrypt(plaintext, siv, k2_.get(), out.subspan(kBlockSize));
+}
+
+util::Status AesSivBoringSsl::DecryptInto(absl::string_view ciphertext,
+                                          absl::string_view associated_data,
+                                          absl::Span<char> out) const {
+  const uint8_t* siv = reinterpret_cast<const uint8_t*>(&ciphertext[0]);
+  util::Status res =
+      AesCtrCrypt(ciphertext.substr(kBlockSize), siv, k2_.get(), out);
+  if (!res.ok()) {
+    return res;
+  }
 
+  uint8_t s2v[kBlockSize];
+  S2v(absl::MakeSpan(reinterpret_cast<const uint8_t*>(associated_data.data()),
+                     associated_data.size()),
+      absl::MakeSpan(reinterpret_cast<const uint8_t*>(out.data()), out.size()),
+      s2v);
+  if (CRYPTO_memcmp(siv, s2v, kBlockSize) != 0) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "invalid ciphertext");
+  }
+  return util::OkStatus();
+}
+
+util::StatusOr<std::string> AesSivBoringSsl::EncryptDeterministically(
+    absl::string_view plaintext, absl::string_view associated_data) const {
   std::string ciphertext;
-  ResizeStringUninitialized(&ciphertext, ciphertext_size);
-  std::copy(std::begin(siv), std::end(siv), ciphertext.begin());
+  ResizeStringUninitialized(&ciphertext, plaintext.size() + kBlockSize);
   util::Status res =
-      AesCtrCrypt(plaintext, siv, k2_.get(),
-                  absl::MakeSpan(ciphertext).subspan(kBlockSize));
+      EncryptInto(plaintext, associated_data, absl::MakeSpan(ciphertext));
   if (!res.ok()) {
     return res;
   }
@@ -234,27 +260,45 @@ util::StatusOr<std::string> AesSivBoringSsl::DecryptDeterministically(
     return util::Status(absl::StatusCode::kInvalidArgument,
                         "ciphertext too short");
   }
-  size_t plaintext_size = ciphertext.size() - kBlockSize;
   std::string plaintext;
-  ResizeStringUninitialized(&plaintext, plaintext_size);
-  const uint8_t* siv = reinterpret_cast<const uint8_t*>(&ciphertext[0]);
-  util::Status res = AesCtrCrypt(ciphertext.substr(kBlockSize), siv, k2_.get(),
-                                 absl::MakeSpan(plaintext));
+  ResizeStringUninitialized(&plaintext, ciphertext.size() - kBlockSize);
+  util::Status res =
+      DecryptInto(ciphertext, associated_data, absl::MakeSpan(plaintext));
   if (!res.ok()) {
     return res;
   }
+  return plaintext;
+}
 
-  uint8_t s2v[kBlockSize];
-  S2v(absl::MakeSpan(reinterpret_cast<const uint8_t*>(associated_data.data()),
-                     associated_data.size()),
-      absl::MakeSpan(reinterpret_cast<const uint8_t*>(plaintext.data()),
-                     plaintext_size),
-      s2v);
-  if (CRYPTO_memcmp(siv, s2v, kBlockSize) != 0) {
+util::StatusOr<absl::string_view>
+AesSivBoringSsl::EncryptDeterministicallyWithArena(
+    absl::string_view plaintext, absl::string_view associated_data,
+    util::RequestArena* arena) const {
+  absl::Span<char> ciphertext = arena->Allocate(plaintext.size() + kBlockSize);
+  util::Status res = EncryptInto(plaintext, associated_data, ciphertext);
+  if (!res.ok()) {
+    return res;
+  }
+  return absl::string_view(ciphertext.data(), ciphertext.size());
+}
+
+util::StatusOr<absl::string_view>
+AesSivBoringSsl::DecryptDeterministicallyWithArena(
+    absl::string_view ciphertext, absl::string_view associated_data,
+    util::RequestArena* arena) const {
+  if (ciphertext.size() < kBlockSize) {
     return util::Status(absl::StatusCode::kInvalidArgument,
-                        "invalid ciphertext");
+                        "ciphertext too short");
   }
-  return plaintext;
+  absl::Span<char> plaintext =
+      arena->Allocate(ciphertext.size() - kBlockSize);
+  util::Status res = DecryptInto(ciphertext, associated_data, plaintext);
+  if (!res.ok()) {
+    // Do not leave unauthenticated plaintext in the arena.
+    OPENSSL_cleanse(plaintext.data(), plaintext.size());
+    return res;
+  }
+  return absl::string_view(plaintext.data(), plaintext.size());
 }
 
 }  // namespace subtle
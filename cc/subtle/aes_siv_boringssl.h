@@ -27,6 +27,7 @@
 #include "tink/deterministic_aead.h"
 #include "tink/internal/aes_util.h"
 #include "tink/internal/fips_utils.h"
+#include "tink/util/request_arena.h"
 #include "tink/util/secret_data.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
@@ -70,6 +71,16 @@ class AesSivBoringSsl : public DeterministicAead {
       absl::string_view ciphertext,
       absl::string_view associated_data) const override;
 
+  crypto::tink::util::StatusOr<absl::string_view>
+  EncryptDeterministicallyWithArena(
+      absl::string_view plaintext, absl::string_view associated_data,
+      util::RequestArena* arena) const override;
+
+  crypto::tink::util::StatusOr<absl::string_view>
+  DecryptDeterministicallyWithArena(
+      absl::string_view ciphertext, absl::string_view associated_data,
+      util::RequestArena* arena) const override;
+
   static bool IsValidKeySizeInBytes(size_t size) { return size == 64; }
 
   static constexpr crypto::tink::internal::FipsCompatibility kFipsStatus =
@@ -116,6 +127,18 @@ class AesSivBoringSsl : public DeterministicAead {
   void S2v(absl::Span<const uint8_t> aad, absl::Span<const uint8_t> msg,
            uint8_t siv[kBlockSize]) const;
 
+  // Writes the SIV followed by the encryption of `plaintext` to `out`, which
+  // must have size plaintext.size() + kBlockSize.
+  util::Status EncryptInto(absl::string_view plaintext,
+                           absl::string_view associated_data,
+                           absl::Span<char> out) const;
+
+  // Decrypts `ciphertext`, which must be at least kBlockSize bytes long, to
+  // `out` of size ciphertext.size() - kBlockSize, and verifies the SIV.
+  util::Status DecryptInto(absl::string_view ciphertext,
+                           absl::string_view associated_data,
+                           absl::Span<char> out) const;
+
   // Encrypts (or decrypts) `in` using an SIV `siv` and key `key`, and writes
   // the result to `out`.
   util::Status AesCtrCrypt(absl::string_view in, const uint8_t siv[kBlockSize],
@@ -26,6 +26,7 @@
 #include "absl/status/status.h"
 #include "tink/config/tink_fips.h"
 #include "tink/subtle/wycheproof_util.h"
+#include "tink/util/request_arena.h"
 #include "tink/util/secret_data.h"
 #include "tink/util/statusor.h"
 #include "tink/util/test_matchers.h"
@@ -73,6 +74,39 @@ TEST(AesSivBoringSslTest, testEncryptDecrypt) {
   EXPECT_EQ(pt.value(), message);
 }
 
+TEST(AesSivBoringSslTest, EncryptDecryptWithArena) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  util::SecretData key = util::SecretDataFromStringView(test::HexDecodeOrDie(
+      "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"
+      "00112233445566778899aabbccddeefff0f1f2f3f4f5f6f7f8f9fafbfcfdfeff"));
+  auto res = AesSivBoringSsl::New(key);
+  ASSERT_TRUE(res.ok()) << res.status();
+  auto cipher = std::move(res.value());
+  std::string associated_data = "Associated data";
+  std::string message = "Some data to encrypt.";
+  util::RequestArena arena;
+  util::StatusOr<absl::string_view> ct =
+      cipher->EncryptDeterministicallyWithArena(message, associated_data,
+                                                &arena);
+  ASSERT_TRUE(ct.ok()) << ct.status();
+  auto expected_ct = cipher->EncryptDeterministically(message, associated_data);
+  ASSERT_TRUE(expected_ct.ok()) << expected_ct.status();
+  EXPECT_EQ(*ct, *expected_ct);
+  util::StatusOr<absl::string_view> pt =
+      cipher->DecryptDeterministicallyWithArena(*ct, associated_data, &arena);
+  ASSERT_TRUE(pt.ok()) << pt.status();
+  EXPECT_EQ(*pt, message);
+
+  std::string modified_ct(*ct);
+  modified_ct[0] ^= 1;
+  EXPECT_FALSE(cipher
+                   ->DecryptDeterministicallyWithArena(modified_ct,
+                                                       associated_data, &arena)
+                   .ok());
+}
+
 TEST(AesSivBoringSslTest, testNullPtrStringView) {
   if (IsFipsModeEnabled()) {
     GTEST_SKIP() << "Not supported in FIPS-only mode";
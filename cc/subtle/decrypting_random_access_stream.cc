@@ -17,6 +17,9 @@
 #include "tink/subtle/decrypting_random_access_stream.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <cstring>
 #include <limits>
 #include <memory>
@@ -28,6 +31,8 @@
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
+#include "tink/internal/run_in_parallel.h"
 #include "tink/random_access_stream.h"
 #include "tink/subtle/stream_segment_decrypter.h"
 #include "tink/util/buffer.h"
@@ -205,8 +210,8 @@ int64_t DecryptingRandomAccessStream::GetSegmentNr(int64_t pt_position) {
   return (pt_position + ct_offset_ + header_size_) / pt_segment_size_;
 }
 
-util::Status DecryptingRandomAccessStream::ReadAndDecryptSegment(
-    int64_t segment_nr, Buffer* ct_buffer, std::vector<uint8_t>* pt_segment) {
+util::Status DecryptingRandomAccessStream::ReadSegment(int64_t segment_nr,
+                                                      Buffer* ct_buffer) {
   int64_t ct_position = segment_nr * ct_segment_size_;
   if (ct_position / ct_segment_size_ != segment_nr /* overflow occured! */) {
     return Status(absl::StatusCode::kOutOfRange,
@@ -227,19 +232,27 @@ util::Status DecryptingRandomAccessStream::ReadAndDecryptSegment(
       (is_last_segment && ct_buffer->size() > 0 &&
        pread_status.code() == absl::StatusCode::kOutOfRange)) {
     // some bytes were read
-    auto dec_status = segment_decrypter_->DecryptSegment(
-        std::vector<uint8_t>(ct_buffer->get_mem_block(),
-                             ct_buffer->get_mem_block() + ct_buffer->size()),
-        segment_nr, is_last_segment, pt_segment);
-    if (dec_status.ok()) {
-      return is_last_segment ?
-          Status(absl::StatusCode::kOutOfRange, "EOF") : util::OkStatus();
-    }
-    return dec_status;
+    return util::OkStatus();
   }
   return pread_status;
 }
 
+util::Status DecryptingRandomAccessStream::ReadAndDecryptSegment(
+    int64_t segment_nr, Buffer* ct_buffer, std::vector<uint8_t>* pt_segment) {
+  auto read_status = ReadSegment(segment_nr, ct_buffer);
+  if (!read_status.ok()) return read_status;
+  bool is_last_segment = (segment_nr == segment_count_ - 1);
+  auto dec_status = segment_decrypter_->DecryptSegment(
+      std::vector<uint8_t>(ct_buffer->get_mem_block(),
+                           ct_buffer->get_mem_block() + ct_buffer->size()),
+      segment_nr, is_last_segment, pt_segment);
+  if (dec_status.ok()) {
+    return is_last_segment ?
+        Status(absl::StatusCode::kOutOfRange, "EOF") : util::OkStatus();
+  }
+  return dec_status;
+}
+
 util::Status DecryptingRandomAccessStream::PReadAndDecrypt(
     int64_t position, int count, Buffer* dest_buffer) {
   if (position < 0 || count < 0 || dest_buffer == nullptr
@@ -307,6 +320,67 @@ StatusOr<int64_t> DecryptingRandomAccessStream::size() {
   return pt_size_;
 }
 
+
+// static
+util::Status DecryptingRandomAccessStream::VerifyAllSegments(
+    std::unique_ptr<StreamSegmentDecrypter> segment_decrypter,
+    std::unique_ptr<RandomAccessStream> ciphertext_source,
+    int64_t* first_invalid_segment) {
+  if (first_invalid_segment != nullptr) *first_invalid_segment = -1;
+  StatusOr<std::unique_ptr<RandomAccessStream>> stream =
+      New(std::move(segment_decrypter), std::move(ciphertext_source));
+  if (!stream.ok()) return stream.status();
+  // New() only returns instances of this class.
+  auto* dec_stream = static_cast<DecryptingRandomAccessStream*>(stream->get());
+  {
+    absl::MutexLock lock(&dec_stream->status_mutex_);
+    dec_stream->InitializeIfNeeded();
+    if (!dec_stream->status_.ok()) return dec_stream->status_;
+  }
+  return dec_stream->VerifySegments(first_invalid_segment);
+}
+
+util::Status DecryptingRandomAccessStream::VerifySegments(
+    int64_t* first_invalid_segment) {
+  // Segments are verified in parallel. Once a segment fails, segments after it
+  // are skipped, but earlier ones are still verified so that the reported
+  // failure is the first one in the stream.
+  absl::Mutex failure_mutex;
+  int64_t failed_segment = segment_count_;
+  Status failure;
+  std::atomic<int64_t> failed_segment_hint(segment_count_);
+  internal::RunInParallel(segment_count_, [&](size_t i) {
+    const int64_t segment_nr = i;
+    if (segment_nr > failed_segment_hint.load()) return;
+    Status status;
+    StatusOr<std::unique_ptr<Buffer>> ct_buffer = Buffer::New(ct_segment_size_);
+    if (!ct_buffer.ok()) {
+      status = ct_buffer.status();
+    } else {
+      status = ReadSegment(segment_nr, ct_buffer->get());
+      if (status.ok()) {
+        status = segment_decrypter_->VerifySegment(
+            absl::MakeConstSpan(
+                reinterpret_cast<const uint8_t*>((*ct_buffer)->get_mem_block()),
+                (*ct_buffer)->size()),
+            segment_nr, segment_nr == segment_count_ - 1);
+      }
+    }
+    if (status.ok()) return;
+    absl::MutexLock lock(&failure_mutex);
+    if (segment_nr < failed_segment) {
+      failed_segment = segment_nr;
+      failure = status;
+      failed_segment_hint.store(segment_nr);
+    }
+  });
+  if (failed_segment == segment_count_) return util::OkStatus();
+  if (first_invalid_segment != nullptr) *first_invalid_segment = failed_segment;
+  return Status(failure.code(),
+                absl::StrCat("segment ", failed_segment,
+                             " failed verification: ", failure.message()));
+}
+
 }  // namespace subtle
 }  // namespace tink
 }  // namespace crypto
@@ -17,6 +17,7 @@
 #ifndef TINK_SUBTLE_DECRYPTING_RANDOM_ACCESS_STREAM_H_
 #define TINK_SUBTLE_DECRYPTING_RANDOM_ACCESS_STREAM_H_
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -51,6 +52,19 @@ class DecryptingRandomAccessStream : public crypto::tink::RandomAccessStream {
   New(std::unique_ptr<StreamSegmentDecrypter> segment_decrypter,
       std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source);
 
+  // Authenticates every segment of 'ciphertext_source' with
+  // 'segment_decrypter', without producing any plaintext. Segments are
+  // verified in parallel if enabled with EnableParallelism() (see
+  // config/parallelism.h). Returns OK if decrypting the whole stream would
+  // succeed. Otherwise, if the header and the stream size are valid, the
+  // error names the first segment that failed and, if 'first_invalid_segment'
+  // is non-null, sets it to that segment's number; in all other cases
+  // '*first_invalid_segment' is set to -1.
+  static crypto::tink::util::Status VerifyAllSegments(
+      std::unique_ptr<StreamSegmentDecrypter> segment_decrypter,
+      std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source,
+      int64_t* first_invalid_segment);
+
   // -----------------------
   // Methods of RandomAccessStream-interface implemented by this class.
   crypto::tink::util::Status PRead(
@@ -62,6 +76,11 @@ class DecryptingRandomAccessStream : public crypto::tink::RandomAccessStream {
   DecryptingRandomAccessStream() {}
   crypto::tink::util::Status PReadAndDecrypt(
       int64_t position, int count, crypto::tink::util::Buffer* dest_buffer);
+  // Reads the specified ciphertext segment from ct_source_ into ct_buffer.
+  crypto::tink::util::Status ReadSegment(int64_t segment_nr,
+                                         crypto::tink::util::Buffer* ct_buffer);
+  // Verifies all segments of an initialized stream.
+  crypto::tink::util::Status VerifySegments(int64_t* first_invalid_segment);
   // Reads the specified ciphertext segment from ct_source_, decrypts it,
   // and writes the resulting plaintext bytes to pt_segment.
   // Uses the provided ct_buffer as a buffer for the ciphertext segment.
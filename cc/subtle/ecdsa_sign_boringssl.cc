@@ -25,6 +25,7 @@
 #include "openssl/evp.h"
 #include "tink/internal/md_util.h"
 #include "tink/internal/util.h"
+#include "tink/signature/internal/ecdsa_presignature_pool.h"
 #include "tink/signature/internal/ecdsa_raw_sign_boringssl.h"
 #include "tink/subtle/common_enums.h"
 #include "tink/subtle/subtle_util_boringssl.h"
@@ -37,6 +38,13 @@ namespace subtle {
 util::StatusOr<std::unique_ptr<EcdsaSignBoringSsl>> EcdsaSignBoringSsl::New(
     const SubtleUtilBoringSSL::EcKey& ec_key, HashType hash_type,
     EcdsaSignatureEncoding encoding) {
+  return New(ec_key, hash_type, encoding, nullptr);
+}
+
+util::StatusOr<std::unique_ptr<EcdsaSignBoringSsl>> EcdsaSignBoringSsl::New(
+    const SubtleUtilBoringSSL::EcKey& ec_key, HashType hash_type,
+    EcdsaSignatureEncoding encoding,
+    std::shared_ptr<internal::EcdsaPresignaturePool> presignatures) {
   auto status = internal::CheckFipsCompatibility<EcdsaSignBoringSsl>();
   if (!status.ok()) return status;
 
@@ -51,7 +59,10 @@ util::StatusOr<std::unique_ptr<EcdsaSignBoringSsl>> EcdsaSignBoringSsl::New(
   }
 
   util::StatusOr<std::unique_ptr<internal::EcdsaRawSignBoringSsl>> raw_sign =
-      internal::EcdsaRawSignBoringSsl::New(ec_key, encoding);
+      presignatures == nullptr
+          ? internal::EcdsaRawSignBoringSsl::New(ec_key, encoding)
+          : internal::EcdsaRawSignBoringSsl::New(ec_key, encoding,
+                                                 std::move(presignatures));
   if (!raw_sign.ok()) return raw_sign.status();
 
   return {
@@ -78,6 +89,15 @@ util::StatusOr<std::string> EcdsaSignBoringSsl::Sign(
       absl::string_view(reinterpret_cast<char*>(digest), digest_size));
 }
 
+util::StatusOr<std::string> EcdsaSignBoringSsl::SignDigest(
+    absl::string_view digest) const {
+  if (digest.size() != EVP_MD_size(hash_)) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "Invalid digest size.");
+  }
+  return raw_signer_->Sign(digest);
+}
+
 }  // namespace subtle
 }  // namespace tink
 }  // namespace crypto
@@ -25,6 +25,8 @@
 #include "openssl/evp.h"
 #include "tink/internal/fips_utils.h"
 #include "tink/public_key_sign.h"
+#include "tink/signature/internal/digest_sign.h"
+#include "tink/signature/internal/ecdsa_presignature_pool.h"
 #include "tink/signature/internal/ecdsa_raw_sign_boringssl.h"
 #include "tink/subtle/common_enums.h"
 #include "tink/subtle/subtle_util_boringssl.h"
@@ -35,16 +37,31 @@ namespace tink {
 namespace subtle {
 
 // ECDSA signing using Boring SSL, generating signatures in DER-encoding.
-class EcdsaSignBoringSsl : public PublicKeySign {
+class EcdsaSignBoringSsl : public PublicKeySign, public internal::DigestSign {
  public:
   static crypto::tink::util::StatusOr<std::unique_ptr<EcdsaSignBoringSsl>> New(
       const SubtleUtilBoringSSL::EcKey& ec_key, HashType hash_type,
       EcdsaSignatureEncoding encoding);
 
+  // As above, but signs with presignatures from `presignatures`, which must
+  // be for the curve of `ec_key` and can be shared with other signers. This
+  // moves most of the signing cost to the refill thread of the pool. Not
+  // available in FIPS-only mode or when Tink is built with OpenSSL.
+  static crypto::tink::util::StatusOr<std::unique_ptr<EcdsaSignBoringSsl>> New(
+      const SubtleUtilBoringSSL::EcKey& ec_key, HashType hash_type,
+      EcdsaSignatureEncoding encoding,
+      std::shared_ptr<internal::EcdsaPresignaturePool> presignatures);
+
   // Computes the signature for 'data'.
   crypto::tink::util::StatusOr<std::string> Sign(
       absl::string_view data) const override;
 
+  const EVP_MD* GetDigestMd() const override { return hash_; }
+
+  // Computes the signature for a message with digest 'digest'.
+  crypto::tink::util::StatusOr<std::string> SignDigest(
+      absl::string_view digest) const override;
+
   static constexpr crypto::tink::internal::FipsCompatibility kFipsStatus =
       crypto::tink::internal::FipsCompatibility::kRequiresBoringCrypto;
 
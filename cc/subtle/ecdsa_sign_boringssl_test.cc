@@ -16,15 +16,20 @@
 
 #include "tink/subtle/ecdsa_sign_boringssl.h"
 
+#include <memory>
 #include <string>
 #include <utility>
 
 #include "gtest/gtest.h"
 #include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "openssl/evp.h"
 #include "tink/internal/ec_util.h"
 #include "tink/internal/fips_utils.h"
+#include "tink/internal/ssl_util.h"
 #include "tink/public_key_sign.h"
 #include "tink/public_key_verify.h"
+#include "tink/signature/internal/ecdsa_presignature_pool.h"
 #include "tink/subtle/common_enums.h"
 #include "tink/subtle/ecdsa_verify_boringssl.h"
 #include "tink/subtle/subtle_util_boringssl.h"
@@ -83,6 +88,75 @@ TEST_F(EcdsaSignBoringSslTest, testBasicSigning) {
   }
 }
 
+TEST_F(EcdsaSignBoringSslTest, SigningWithPresignatures) {
+  if (internal::IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  if (!internal::IsBoringSsl()) {
+    GTEST_SKIP() << "Presignatures are not supported when OpenSSL is used";
+  }
+  util::StatusOr<std::unique_ptr<internal::EcdsaPresignaturePool>> pool =
+      internal::EcdsaPresignaturePool::New(
+          EllipticCurveType::NIST_P256,
+          {/*capacity=*/8, /*refill_threshold=*/2});
+  ASSERT_THAT(pool, IsOk());
+  std::shared_ptr<internal::EcdsaPresignaturePool> presignatures =
+      *std::move(pool);
+  for (EcdsaSignatureEncoding encoding :
+       {EcdsaSignatureEncoding::DER, EcdsaSignatureEncoding::IEEE_P1363}) {
+    util::StatusOr<SubtleUtilBoringSSL::EcKey> ec_key =
+        SubtleUtilBoringSSL::GetNewEcKey(EllipticCurveType::NIST_P256);
+    ASSERT_THAT(ec_key, IsOk());
+    util::StatusOr<std::unique_ptr<EcdsaSignBoringSsl>> signer =
+        EcdsaSignBoringSsl::New(*ec_key, HashType::SHA256, encoding,
+                                presignatures);
+    ASSERT_THAT(signer, IsOk());
+    util::StatusOr<std::unique_ptr<EcdsaVerifyBoringSsl>> verifier =
+        EcdsaVerifyBoringSsl::New(*ec_key, HashType::SHA256, encoding);
+    ASSERT_THAT(verifier, IsOk());
+
+    std::string message = "some data to be signed";
+    util::StatusOr<std::string> signature = (*signer)->Sign(message);
+    ASSERT_THAT(signature, IsOk());
+    EXPECT_THAT((*verifier)->Verify(*signature, message), IsOk());
+    // Each signature uses a fresh nonce.
+    util::StatusOr<std::string> signature2 = (*signer)->Sign(message);
+    ASSERT_THAT(signature2, IsOk());
+    EXPECT_NE(*signature, *signature2);
+    EXPECT_THAT((*verifier)->Verify(*signature2, message), IsOk());
+  }
+}
+
+TEST_F(EcdsaSignBoringSslTest, SignDigest) {
+  if (internal::IsFipsModeEnabled() && !internal::IsFipsEnabledInSsl()) {
+    GTEST_SKIP()
+        << "Test is skipped if kOnlyUseFips but BoringCrypto is unavailable.";
+  }
+  auto ec_key =
+      SubtleUtilBoringSSL::GetNewEcKey(EllipticCurveType::NIST_P256).value();
+  auto signer = EcdsaSignBoringSsl::New(ec_key, HashType::SHA256,
+                                        EcdsaSignatureEncoding::DER);
+  ASSERT_THAT(signer, IsOk());
+  auto verifier = EcdsaVerifyBoringSsl::New(ec_key, HashType::SHA256,
+                                            EcdsaSignatureEncoding::DER);
+  ASSERT_THAT(verifier, IsOk());
+  ASSERT_EQ(EVP_MD_type((*signer)->GetDigestMd()), NID_sha256);
+
+  std::string message = "some data to be signed";
+  uint8_t digest[EVP_MAX_MD_SIZE];
+  unsigned int digest_size = 0;
+  ASSERT_EQ(EVP_Digest(message.data(), message.size(), digest, &digest_size,
+                       EVP_sha256(), /*impl=*/nullptr),
+            1);
+  util::StatusOr<std::string> signature = (*signer)->SignDigest(
+      absl::string_view(reinterpret_cast<const char*>(digest), digest_size));
+  ASSERT_THAT(signature, IsOk());
+  EXPECT_THAT((*verifier)->Verify(*signature, message), IsOk());
+
+  EXPECT_THAT((*signer)->SignDigest("too short").status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
 TEST_F(EcdsaSignBoringSslTest, testEncodingsMismatch) {
   if (internal::IsFipsModeEnabled() && !internal::IsFipsEnabledInSsl()) {
     GTEST_SKIP()
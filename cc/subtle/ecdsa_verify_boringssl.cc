@@ -43,11 +43,11 @@ util::StatusOr<std::unique_ptr<EcdsaVerifyBoringSsl>> EcdsaVerifyBoringSsl::New(
     const SubtleUtilBoringSSL::EcKey& ec_key, HashType hash_type,
     EcdsaSignatureEncoding encoding) {
   // Check curve.
-  auto group_result = internal::EcGroupFromCurveType(ec_key.curve);
-  if (!group_result.ok()) return group_result.status();
-  internal::SslUniquePtr<EC_GROUP> group = std::move(group_result.value());
+  util::StatusOr<const EC_GROUP*> group =
+      internal::CachedEcGroupFromCurveType(ec_key.curve);
+  if (!group.ok()) return group.status();
   internal::SslUniquePtr<EC_KEY> key(EC_KEY_new());
-  EC_KEY_set_group(key.get(), group.get());
+  EC_KEY_set_group(key.get(), *group);
 
   // Check key.
   auto ec_point_result =
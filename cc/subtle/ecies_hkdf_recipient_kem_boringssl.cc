@@ -65,21 +65,19 @@ EciesHkdfNistPCurveRecipientKemBoringSsl::New(EllipticCurveType curve,
   if (priv_key.empty()) {
     return util::Status(absl::StatusCode::kInvalidArgument, "empty priv_key");
   }
-  auto status_or_ec_group = internal::EcGroupFromCurveType(curve);
-  if (!status_or_ec_group.ok()) return status_or_ec_group.status();
-  // TODO(przydatek): consider refactoring internal/ec_util,
-  //     so that the saved group can be used for KEM operations.
+  // Check curve. GenerateKey uses the process-wide group of `curve`, so there
+  // is no need to keep a copy here.
+  util::StatusOr<const EC_GROUP*> ec_group =
+      internal::CachedEcGroupFromCurveType(curve);
+  if (!ec_group.ok()) return ec_group.status();
   return {absl::WrapUnique(new EciesHkdfNistPCurveRecipientKemBoringSsl(
-      curve, std::move(priv_key), std::move(status_or_ec_group.value())))};
+      curve, std::move(priv_key)))};
 }
 
 EciesHkdfNistPCurveRecipientKemBoringSsl::
     EciesHkdfNistPCurveRecipientKemBoringSsl(
-        EllipticCurveType curve, util::SecretData priv_key_value,
-        internal::SslUniquePtr<EC_GROUP> ec_group)
-    : curve_(curve),
-      priv_key_value_(std::move(priv_key_value)),
-      ec_group_(std::move(ec_group)) {}
+        EllipticCurveType curve, util::SecretData priv_key_value)
+    : curve_(curve), priv_key_value_(std::move(priv_key_value)) {}
 
 util::StatusOr<util::SecretData>
 EciesHkdfNistPCurveRecipientKemBoringSsl::GenerateKey(
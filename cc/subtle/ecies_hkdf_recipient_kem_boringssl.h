@@ -76,12 +76,10 @@ class EciesHkdfNistPCurveRecipientKemBoringSsl
 
  private:
   EciesHkdfNistPCurveRecipientKemBoringSsl(
-      EllipticCurveType curve, util::SecretData priv_key_value,
-      internal::SslUniquePtr<EC_GROUP> ec_group);
+      EllipticCurveType curve, util::SecretData priv_key_value);
 
   EllipticCurveType curve_;
   util::SecretData priv_key_value_;
-  internal::SslUniquePtr<EC_GROUP> ec_group_;
 };
 
 // Implementation of EciesHkdfRecipientKemBoringSsl for curve25519.
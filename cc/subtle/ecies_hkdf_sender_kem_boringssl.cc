@@ -86,14 +86,13 @@ EciesHkdfNistPCurveSendKemBoringSsl::GenerateKey(
                         "peer_pub_key_ wasn't initialized");
   }
 
-  auto status_or_ec_group = internal::EcGroupFromCurveType(curve_);
-  if (!status_or_ec_group.ok()) {
-    return status_or_ec_group.status();
+  util::StatusOr<const EC_GROUP*> group =
+      internal::CachedEcGroupFromCurveType(curve_);
+  if (!group.ok()) {
+    return group.status();
   }
-  internal::SslUniquePtr<EC_GROUP> group =
-      std::move(status_or_ec_group.value());
   internal::SslUniquePtr<EC_KEY> ephemeral_key(EC_KEY_new());
-  if (1 != EC_KEY_set_group(ephemeral_key.get(), group.get())) {
+  if (1 != EC_KEY_set_group(ephemeral_key.get(), *group)) {
     return util::Status(absl::StatusCode::kInternal, "EC_KEY_set_group failed");
   }
   if (1 != EC_KEY_generate_key(ephemeral_key.get())) {
@@ -107,21 +106,20 @@ EciesHkdfNistPCurveSendKemBoringSsl::GenerateKey(
   if (!status_or_string_kem.ok()) {
     return status_or_string_kem.status();
   }
-  std::string kem_bytes = status_or_string_kem.value();
+  std::string kem_bytes = *std::move(status_or_string_kem);
   auto status_or_string_shared_secret = internal::ComputeEcdhSharedSecret(
       curve_, ephemeral_priv, peer_pub_key_.get());
   if (!status_or_string_shared_secret.ok()) {
     return status_or_string_shared_secret.status();
   }
-  util::SecretData shared_secret = status_or_string_shared_secret.value();
   auto symmetric_key_or = Hkdf::ComputeEciesHkdfSymmetricKey(
-      hash, kem_bytes, shared_secret, hkdf_salt, hkdf_info, key_size_in_bytes);
+      hash, kem_bytes, *status_or_string_shared_secret, hkdf_salt, hkdf_info,
+      key_size_in_bytes);
   if (!symmetric_key_or.ok()) {
     return symmetric_key_or.status();
   }
-  util::SecretData symmetric_key = symmetric_key_or.value();
   return absl::make_unique<const KemKey>(std::move(kem_bytes),
-                                         std::move(symmetric_key));
+                                         *std::move(symmetric_key_or));
 }
 
 EciesHkdfX25519SendKemBoringSsl::EciesHkdfX25519SendKemBoringSsl(
@@ -202,7 +200,7 @@ EciesHkdfX25519SendKemBoringSsl::GenerateKey(
     return symmetric_key.status();
   }
   return std::make_unique<const KemKey>(std::string(public_key),
-                                        *symmetric_key);
+                                        *std::move(symmetric_key));
 }
 
 }  // namespace subtle
@@ -16,21 +16,27 @@
 
 #include "tink/subtle/hmac_boringssl.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "openssl/crypto.h"
 #include "openssl/evp.h"
 #include "openssl/hmac.h"
 #include "tink/internal/md_util.h"
+#include "tink/internal/ssl_unique_ptr.h"
 #include "tink/internal/util.h"
 #include "tink/mac.h"
 #include "tink/subtle/common_enums.h"
 #include "tink/util/errors.h"
+#include "tink/util/request_arena.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
 
@@ -60,17 +66,16 @@ util::StatusOr<std::unique_ptr<Mac>> HmacBoringSsl::New(HashType hash_type,
   return {absl::WrapUnique(new HmacBoringSsl(*md, tag_size, std::move(key)))};
 }
 
-util::StatusOr<std::string> HmacBoringSsl::ComputeMac(
-    absl::string_view data) const {
+util::Status HmacBoringSsl::ComputeTag(absl::string_view data,
+                                       uint8_t* tag) const {
   // BoringSSL expects a non-null pointer for data,
   // regardless of whether the size is 0.
   data = internal::EnsureStringNonNull(data);
 
-  uint8_t buf[EVP_MAX_MD_SIZE];
   unsigned int out_len;
   const uint8_t* res = HMAC(md_, key_.data(), key_.size(),
                             reinterpret_cast<const uint8_t*>(data.data()),
-                            data.size(), buf, &out_len);
+                            data.size(), tag, &out_len);
   if (res == nullptr) {
     // TODO(bleichen): We expect that BoringSSL supports the
     //   hashes that we use. Maybe we should have a status that indicates
@@ -78,28 +83,35 @@ util::StatusOr<std::string> HmacBoringSsl::ComputeMac(
     return util::Status(absl::StatusCode::kInternal,
                         "BoringSSL failed to compute HMAC");
   }
+  return util::OkStatus();
+}
+
+util::StatusOr<std::string> HmacBoringSsl::ComputeMac(
+    absl::string_view data) const {
+  uint8_t buf[EVP_MAX_MD_SIZE];
+  util::Status status = ComputeTag(data, buf);
+  if (!status.ok()) return status;
   return std::string(reinterpret_cast<char*>(buf), tag_size_);
 }
 
+util::StatusOr<absl::string_view> HmacBoringSsl::ComputeMacWithArena(
+    absl::string_view data, util::RequestArena* arena) const {
+  uint8_t buf[EVP_MAX_MD_SIZE];
+  util::Status status = ComputeTag(data, buf);
+  if (!status.ok()) return status;
+  return arena->Copy(
+      absl::string_view(reinterpret_cast<const char*>(buf), tag_size_));
+}
+
 util::Status HmacBoringSsl::VerifyMac(absl::string_view mac,
                                       absl::string_view data) const {
-  // BoringSSL expects a non-null pointer for data,
-  // regardless of whether the size is 0.
-  data = internal::EnsureStringNonNull(data);
-
   if (mac.size() != tag_size_) {
     return util::Status(absl::StatusCode::kInvalidArgument,
                         "incorrect tag size");
   }
   uint8_t buf[EVP_MAX_MD_SIZE];
-  unsigned int out_len;
-  const uint8_t* res = HMAC(md_, key_.data(), key_.size(),
-                            reinterpret_cast<const uint8_t*>(data.data()),
-                            data.size(), buf, &out_len);
-  if (res == nullptr) {
-    return util::Status(absl::StatusCode::kInternal,
-                        "BoringSSL failed to compute HMAC");
-  }
+  util::Status status = ComputeTag(data, buf);
+  if (!status.ok()) return status;
   if (CRYPTO_memcmp(buf, mac.data(), tag_size_) != 0) {
     return util::Status(absl::StatusCode::kInvalidArgument,
                         "verification failed");
@@ -107,6 +119,45 @@ util::Status HmacBoringSsl::VerifyMac(absl::string_view mac,
   return util::OkStatus();
 }
 
+util::StatusOr<std::vector<bool>> HmacBoringSsl::VerifyMacBatch(
+    absl::Span<const absl::string_view> macs,
+    absl::Span<const absl::string_view> data) const {
+  if (macs.size() != data.size()) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "Number of MACs and number of messages differ");
+  }
+  std::vector<bool> valid(data.size());
+  if (data.empty()) return valid;
+
+  // The inner and outer key pads are hashed once for the whole batch;
+  // re-initializing the context with a null key reuses them.
+  internal::SslUniquePtr<HMAC_CTX> context(HMAC_CTX_new());
+  if (context == nullptr ||
+      !HMAC_Init_ex(context.get(), key_.data(), key_.size(), md_,
+                    /*impl=*/nullptr)) {
+    return util::Status(absl::StatusCode::kInternal,
+                        "HMAC initialization failed");
+  }
+  uint8_t buf[EVP_MAX_MD_SIZE];
+  for (size_t i = 0; i < data.size(); ++i) {
+    if (macs[i].size() != tag_size_) continue;
+    absl::string_view message = internal::EnsureStringNonNull(data[i]);
+    unsigned int out_len;
+    if (!HMAC_Init_ex(context.get(), /*key=*/nullptr, /*key_len=*/0,
+                      /*md=*/nullptr, /*impl=*/nullptr) ||
+        !HMAC_Update(context.get(),
+                     reinterpret_cast<const uint8_t*>(message.data()),
+                     message.size()) ||
+        !HMAC_Final(context.get(), buf, &out_len)) {
+      return util::Status(absl::StatusCode::kInternal,
+                          "BoringSSL failed to compute HMAC");
+    }
+    valid[i] = CRYPTO_memcmp(buf, macs[i].data(), tag_size_) == 0;
+  }
+  OPENSSL_cleanse(buf, sizeof(buf));
+  return valid;
+}
+
 }  // namespace subtle
 }  // namespace tink
 }  // namespace crypto
@@ -17,15 +17,19 @@
 #ifndef TINK_SUBTLE_HMAC_BORINGSSL_H_
 #define TINK_SUBTLE_HMAC_BORINGSSL_H_
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "openssl/evp.h"
 #include "tink/internal/fips_utils.h"
 #include "tink/mac.h"
 #include "tink/subtle/common_enums.h"
+#include "tink/util/request_arena.h"
 #include "tink/util/secret_data.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
@@ -43,12 +47,22 @@ class HmacBoringSsl : public Mac {
   crypto::tink::util::StatusOr<std::string> ComputeMac(
       absl::string_view data) const override;
 
+  // Computes the HMAC for 'data' and places it in 'arena'.
+  crypto::tink::util::StatusOr<absl::string_view> ComputeMacWithArena(
+      absl::string_view data, util::RequestArena* arena) const override;
+
   // Verifies if 'mac' is a correct HMAC for 'data'.
   // Returns Status::OK if 'mac' is correct, and a non-OK-Status otherwise.
   crypto::tink::util::Status VerifyMac(
       absl::string_view mac,
       absl::string_view data) const override;
 
+  // Verifies a batch of (tag, data) pairs. The keyed HMAC state is set up once
+  // and reused for every message.
+  crypto::tink::util::StatusOr<std::vector<bool>> VerifyMacBatch(
+      absl::Span<const absl::string_view> macs,
+      absl::Span<const absl::string_view> data) const override;
+
   static constexpr crypto::tink::internal::FipsCompatibility kFipsStatus =
       crypto::tink::internal::FipsCompatibility::kRequiresBoringCrypto;
 
@@ -56,6 +70,10 @@ class HmacBoringSsl : public Mac {
   // Minimum HMAC key size in bytes.
   static constexpr size_t kMinKeySize = 16;
 
+  // Writes the full, untruncated HMAC of `data` to `tag`, which must have room
+  // for EVP_MAX_MD_SIZE bytes.
+  util::Status ComputeTag(absl::string_view data, uint8_t* tag) const;
+
   HmacBoringSsl(const EVP_MD* md, uint32_t tag_size, util::SecretData key)
       : md_(md), tag_size_(tag_size), key_(std::move(key)) {}
 
@@ -16,15 +16,19 @@
 
 #include "tink/subtle/hmac_boringssl.h"
 
+#include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "absl/status/status.h"
 #include "absl/strings/escaping.h"
+#include "absl/strings/string_view.h"
 #include "tink/internal/fips_utils.h"
 #include "tink/mac.h"
 #include "tink/subtle/common_enums.h"
+#include "tink/util/request_arena.h"
 #include "tink/util/secret_data.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
@@ -92,6 +96,24 @@ TEST_F(HmacBoringSslTest, testBasic) {
   }
 }
 
+TEST_F(HmacBoringSslTest, ComputeMacWithArena) {
+  if (internal::IsFipsModeEnabled() && !internal::IsFipsEnabledInSsl()) {
+    GTEST_SKIP()
+        << "Test should not run in FIPS mode when BoringCrypto is unavailable.";
+  }
+
+  util::SecretData key = util::SecretDataFromStringView(
+      absl::HexStringToBytes("000102030405060708090a0b0c0d0e0f"));
+  auto hmac_result = HmacBoringSsl::New(HashType::SHA1, 16, key);
+  ASSERT_TRUE(hmac_result.ok()) << hmac_result.status();
+  auto hmac = std::move(hmac_result.value());
+  util::RequestArena arena;
+  util::StatusOr<absl::string_view> tag =
+      hmac->ComputeMacWithArena("Some data to test.", &arena);
+  ASSERT_TRUE(tag.ok()) << tag.status();
+  EXPECT_EQ(*tag, absl::HexStringToBytes("9ccdca5b7fffb690df396e4ac49b9cd4"));
+}
+
 TEST_F(HmacBoringSslTest, testModification) {
   if (internal::IsFipsModeEnabled() && !internal::IsFipsEnabledInSsl()) {
     GTEST_SKIP()
@@ -140,6 +162,59 @@ TEST_F(HmacBoringSslTest, testTruncation) {
   }
 }
 
+TEST_F(HmacBoringSslTest, VerifyMacBatch) {
+  if (internal::IsFipsModeEnabled() && !internal::IsFipsEnabledInSsl()) {
+    GTEST_SKIP()
+        << "Test should not run in FIPS mode when BoringCrypto is unavailable.";
+  }
+
+  util::SecretData key = util::SecretDataFromStringView(
+      absl::HexStringToBytes("000102030405060708090a0b0c0d0e0f"));
+  for (HashType hash : {HashType::SHA1, HashType::SHA256, HashType::SHA512}) {
+    util::StatusOr<std::unique_ptr<Mac>> hmac =
+        HmacBoringSsl::New(hash, /*tag_size=*/16, key);
+    ASSERT_TRUE(hmac.ok()) << hmac.status();
+    std::vector<std::string> messages = {"", "a", std::string(200, 'x'),
+                                         "Some data to test."};
+    std::vector<std::string> tags;
+    for (const std::string& message : messages) {
+      util::StatusOr<std::string> tag = (*hmac)->ComputeMac(message);
+      ASSERT_TRUE(tag.ok()) << tag.status();
+      tags.push_back(*tag);
+    }
+    // Swap two tags, corrupt one and truncate another.
+    std::swap(tags[0], tags[1]);
+    tags[2][5] ^= 1;
+    tags.push_back(tags[3].substr(0, 15));
+    messages.push_back(messages[3]);
+
+    std::vector<absl::string_view> tag_views(tags.begin(), tags.end());
+    std::vector<absl::string_view> message_views(messages.begin(),
+                                                 messages.end());
+    util::StatusOr<std::vector<bool>> valid =
+        (*hmac)->VerifyMacBatch(tag_views, message_views);
+    ASSERT_TRUE(valid.ok()) << valid.status();
+    EXPECT_EQ(*valid, std::vector<bool>({false, false, false, true, false}));
+  }
+}
+
+TEST_F(HmacBoringSslTest, VerifyMacBatchSizeMismatch) {
+  if (internal::IsFipsModeEnabled() && !internal::IsFipsEnabledInSsl()) {
+    GTEST_SKIP()
+        << "Test should not run in FIPS mode when BoringCrypto is unavailable.";
+  }
+
+  util::SecretData key = util::SecretDataFromStringView(
+      absl::HexStringToBytes("000102030405060708090a0b0c0d0e0f"));
+  util::StatusOr<std::unique_ptr<Mac>> hmac =
+      HmacBoringSsl::New(HashType::SHA256, /*tag_size=*/16, key);
+  ASSERT_TRUE(hmac.ok()) << hmac.status();
+  std::vector<absl::string_view> tags = {"a", "b"};
+  std::vector<absl::string_view> messages = {"a"};
+  EXPECT_THAT((*hmac)->VerifyMacBatch(tags, messages).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
 TEST_F(HmacBoringSslTest, testInvalidKeySizes) {
   if (internal::IsFipsModeEnabled() && !internal::IsFipsEnabledInSsl()) {
     GTEST_SKIP()
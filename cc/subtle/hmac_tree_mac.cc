@@ -0,0 +1,462 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/subtle/hmac_tree_mac.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "openssl/crypto.h"
+#include "openssl/evp.h"
+#include "tink/chunked_mac.h"
+#include "tink/internal/fips_utils.h"
+#include "tink/internal/keyed_hmac.h"
+#include "tink/internal/md_util.h"
+#include "tink/internal/run_in_parallel.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+namespace {
+
+// Domain separation of leaves, inner nodes and the final tag.
+constexpr uint8_t kLeafPrefix = 0x00;
+constexpr uint8_t kNodePrefix = 0x01;
+constexpr uint8_t kTagPrefix = 0x02;
+
+// Lower bounds on the work of a parallel task, so that small inputs are not
+// spread over threads.
+constexpr size_t kMinBytesPerTask = 1 << 18;
+constexpr size_t kMinNodesPerTask = 1 << 10;
+
+void StoreBigEndian64(uint64_t value, uint8_t* out) {
+  for (int i = 7; i >= 0; --i) {
+    out[i] = static_cast<uint8_t>(value);
+    value >>= 8;
+  }
+}
+
+// Calls `task(begin, end)` for consecutive ranges covering [0, n), each with
+// at least `min_per_task` elements except for the last one, in parallel.
+// Returns the first error in the order of the ranges.
+template <typename Task>
+util::Status ParallelFor(size_t n, size_t min_per_task, const Task& task) {
+  const size_t num_threads =
+      std::max(1u, std::thread::hardware_concurrency());
+  // A few ranges per thread balance threads that progress unevenly.
+  const size_t per_task =
+      std::max(min_per_task, (n + 4 * num_threads - 1) / (4 * num_threads));
+  const size_t num_tasks = (n + per_task - 1) / per_task;
+  std::vector<util::Status> statuses(num_tasks);
+  internal::RunInParallel(num_tasks, [&](size_t i) {
+    statuses[i] = task(i * per_task, std::min(n, (i + 1) * per_task));
+  });
+  for (const util::Status& status : statuses) {
+    if (!status.ok()) return status;
+  }
+  return util::OkStatus();
+}
+
+// Returns the number of chunks of a message of `data_size` bytes.
+uint64_t NumChunks(uint64_t data_size, uint32_t chunk_size) {
+  return data_size == 0 ? 1 : (data_size - 1) / chunk_size + 1;
+}
+
+// Writes the leaves of `chunks` to `out`. `chunks` are consecutive chunks of
+// the message, starting at chunk `first_chunk`; only the last one may be
+// shorter than `chunk_size`. Empty `chunks` stand for one empty chunk.
+util::Status ComputeLeaves(const internal::KeyedHmac& hmac,
+                           absl::string_view chunks, uint64_t first_chunk,
+                           uint32_t chunk_size, uint8_t* out) {
+  const size_t node_size = hmac.tag_size();
+  return ParallelFor(
+      NumChunks(chunks.size(), chunk_size),
+      std::max<size_t>(1, kMinBytesPerTask / chunk_size),
+      [&](size_t begin, size_t end) {
+        uint8_t prefix[9];
+        prefix[0] = kLeafPrefix;
+        for (size_t i = begin; i < end; ++i) {
+          StoreBigEndian64(first_chunk + i, &prefix[1]);
+          const absl::string_view inputs[] = {
+              absl::string_view(reinterpret_cast<const char*>(prefix),
+                                sizeof(prefix)),
+              chunks.substr(std::min(chunks.size(), i * chunk_size),
+                            chunk_size)};
+          util::Status status = hmac.Compute(
+              inputs, absl::MakeSpan(out + i * node_size, node_size));
+          if (!status.ok()) return status;
+        }
+        return util::OkStatus();
+      });
+}
+
+// Computes the (n + 1) / 2 parents of the `n` nodes in `level`: parent j
+// combines nodes 2j and 2j + 1, and if n is odd, the last node is moved up
+// unchanged.
+util::StatusOr<std::vector<uint8_t>> ComputeParents(
+    const internal::KeyedHmac& hmac, absl::Span<const uint8_t> level) {
+  const size_t node_size = hmac.tag_size();
+  const size_t n = level.size() / node_size;
+  std::vector<uint8_t> parents((n + 1) / 2 * node_size);
+  util::Status status = ParallelFor(
+      n / 2, kMinNodesPerTask, [&](size_t begin, size_t end) {
+        const uint8_t prefix = kNodePrefix;
+        for (size_t j = begin; j < end; ++j) {
+          const absl::string_view inputs[] = {
+              absl::string_view(reinterpret_cast<const char*>(&prefix), 1),
+              absl::string_view(
+                  reinterpret_cast<const char*>(&level[2 * j * node_size]),
+                  2 * node_size)};
+          util::Status status = hmac.Compute(
+              inputs, absl::MakeSpan(&parents[j * node_size], node_size));
+          if (!status.ok()) return status;
+        }
+        return util::OkStatus();
+      });
+  if (!status.ok()) return status;
+  if (n % 2 == 1) {
+    std::copy(level.end() - node_size, level.end(),
+              parents.end() - node_size);
+  }
+  return parents;
+}
+
+util::StatusOr<std::vector<uint8_t>> ComputeRoot(
+    const internal::KeyedHmac& hmac, std::vector<uint8_t> level) {
+  while (level.size() > hmac.tag_size()) {
+    util::StatusOr<std::vector<uint8_t>> parents = ComputeParents(hmac, level);
+    if (!parents.ok()) return parents.status();
+    level = *std::move(parents);
+  }
+  return level;
+}
+
+util::StatusOr<std::string> ComputeTag(const internal::KeyedHmac& hmac,
+                                       uint64_t data_size,
+                                       absl::Span<const uint8_t> root,
+                                       uint32_t tag_size) {
+  uint8_t prefix[9];
+  prefix[0] = kTagPrefix;
+  StoreBigEndian64(data_size, &prefix[1]);
+  const absl::string_view inputs[] = {
+      absl::string_view(reinterpret_cast<const char*>(prefix), sizeof(prefix)),
+      absl::string_view(reinterpret_cast<const char*>(root.data()),
+                        root.size())};
+  std::vector<uint8_t> tag(hmac.tag_size());
+  util::Status status = hmac.Compute(inputs, absl::MakeSpan(tag));
+  if (!status.ok()) return status;
+  return std::string(tag.begin(), tag.begin() + tag_size);
+}
+
+util::Status CompareTags(absl::string_view expected, absl::string_view tag) {
+  if (expected.size() != tag.size() ||
+      CRYPTO_memcmp(expected.data(), tag.data(), tag.size()) != 0) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "verification failed");
+  }
+  return util::OkStatus();
+}
+
+class HmacTreeMacComputation : public ChunkedMacComputation {
+ public:
+  HmacTreeMacComputation(std::shared_ptr<const internal::KeyedHmac> hmac,
+                         uint32_t tag_size, uint32_t chunk_size)
+      : hmac_(std::move(hmac)), tag_size_(tag_size), chunk_size_(chunk_size) {}
+
+  util::Status Update(absl::string_view data) override {
+    if (finalized_) {
+      return util::Status(absl::StatusCode::kFailedPrecondition,
+                          "MAC computation already finalized");
+    }
+    data_size_ += data.size();
+    if (!pending_.empty()) {
+      const size_t size =
+          std::min<size_t>(chunk_size_ - pending_.size(), data.size());
+      pending_.append(data.data(), size);
+      data.remove_prefix(size);
+      if (pending_.size() < chunk_size_) return util::OkStatus();
+      util::Status status = AddChunks(pending_);
+      if (!status.ok()) return status;
+      pending_.clear();
+    }
+    // Whole chunks are hashed directly from `data`, in parallel.
+    const size_t size = data.size() - data.size() % chunk_size_;
+    if (size > 0) {
+      util::Status status = AddChunks(data.substr(0, size));
+      if (!status.ok()) return status;
+    }
+    pending_ = std::string(data.substr(size));
+    return util::OkStatus();
+  }
+
+  util::StatusOr<std::string> ComputeMac() override {
+    if (finalized_) {
+      return util::Status(absl::StatusCode::kFailedPrecondition,
+                          "MAC computation already finalized");
+    }
+    finalized_ = true;
+    if (!pending_.empty() || num_chunks_ == 0) {
+      util::Status status = AddChunks(pending_);
+      if (!status.ok()) return status;
+    }
+    util::StatusOr<std::vector<uint8_t>> root =
+        ComputeRoot(*hmac_, std::move(leaves_));
+    if (!root.ok()) return root.status();
+    return ComputeTag(*hmac_, data_size_, *root, tag_size_);
+  }
+
+ private:
+  util::Status AddChunks(absl::string_view chunks) {
+    const uint64_t num_chunks = NumChunks(chunks.size(), chunk_size_);
+    const size_t offset = leaves_.size();
+    leaves_.resize(offset + num_chunks * hmac_->tag_size());
+    util::Status status = ComputeLeaves(*hmac_, chunks, num_chunks_,
+                                        chunk_size_, &leaves_[offset]);
+    num_chunks_ += num_chunks;
+    return status;
+  }
+
+  const std::shared_ptr<const internal::KeyedHmac> hmac_;
+  const uint32_t tag_size_;
+  const uint32_t chunk_size_;
+  // Bytes of the current chunk that is not complete yet.
+  std::string pending_;
+  std::vector<uint8_t> leaves_;
+  uint64_t num_chunks_ = 0;
+  uint64_t data_size_ = 0;
+  bool finalized_ = false;
+};
+
+class HmacTreeMacVerification : public ChunkedMacVerification {
+ public:
+  HmacTreeMacVerification(std::unique_ptr<ChunkedMacComputation> computation,
+                          absl::string_view tag)
+      : computation_(std::move(computation)), tag_(tag) {}
+
+  util::Status Update(absl::string_view data) override {
+    return computation_->Update(data);
+  }
+
+  util::Status VerifyMac() override {
+    util::StatusOr<std::string> tag = computation_->ComputeMac();
+    if (!tag.ok()) return tag.status();
+    return CompareTags(*tag, tag_);
+  }
+
+ private:
+  const std::unique_ptr<ChunkedMacComputation> computation_;
+  const std::string tag_;
+};
+
+}  // namespace
+
+util::StatusOr<std::unique_ptr<HmacTreeMac>> HmacTreeMac::New(
+    HashType hash, uint32_t tag_size, uint32_t chunk_size,
+    const util::SecretData& key) {
+  util::Status status = internal::CheckFipsCompatibility<HmacTreeMac>();
+  if (!status.ok()) return status;
+
+  if (key.size() < kMinKeySize) {
+    return util::Status(absl::StatusCode::kInvalidArgument, "invalid key size");
+  }
+  if (hash != SHA256 && hash != SHA384 && hash != SHA512) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "unsupported hash function");
+  }
+  util::StatusOr<const EVP_MD*> md = internal::EvpHashFromHashType(hash);
+  if (!md.ok()) return md.status();
+  if (tag_size < kMinTagSize || tag_size > EVP_MD_size(*md)) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "invalid tag size");
+  }
+  if (chunk_size < kMinChunkSize) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "invalid chunk size");
+  }
+  util::StatusOr<std::unique_ptr<internal::KeyedHmac>> hmac =
+      internal::KeyedHmac::New(*md, util::SecretDataAsStringView(key));
+  if (!hmac.ok()) return hmac.status();
+  return absl::WrapUnique(
+      new HmacTreeMac(*std::move(hmac), tag_size, chunk_size));
+}
+
+util::StatusOr<std::string> HmacTreeMac::ComputeMac(
+    absl::string_view data) const {
+  std::vector<uint8_t> leaves(NumChunks(data.size(), chunk_size_) *
+                              hmac_->tag_size());
+  util::Status status = ComputeLeaves(*hmac_, data, /*first_chunk=*/0,
+                                      chunk_size_, leaves.data());
+  if (!status.ok()) return status;
+  util::StatusOr<std::vector<uint8_t>> root =
+      ComputeRoot(*hmac_, std::move(leaves));
+  if (!root.ok()) return root.status();
+  return ComputeTag(*hmac_, data.size(), *root, tag_size_);
+}
+
+util::Status HmacTreeMac::VerifyMac(absl::string_view mac,
+                                    absl::string_view data) const {
+  util::StatusOr<std::string> tag = ComputeMac(data);
+  if (!tag.ok()) return tag.status();
+  return CompareTags(*tag, mac);
+}
+
+util::StatusOr<std::unique_ptr<ChunkedMacComputation>>
+HmacTreeMac::CreateComputation() const {
+  return {absl::make_unique<HmacTreeMacComputation>(hmac_, tag_size_,
+                                                    chunk_size_)};
+}
+
+util::StatusOr<std::unique_ptr<ChunkedMacVerification>>
+HmacTreeMac::CreateVerification(absl::string_view tag) const {
+  return {absl::make_unique<HmacTreeMacVerification>(
+      absl::make_unique<HmacTreeMacComputation>(hmac_, tag_size_, chunk_size_),
+      tag)};
+}
+
+// The inclusion proof lists, from the leaves up, the nodes next to the range
+// of nodes that the chunks determine on every level: the left neighbor if the
+// range starts with a right child, then the right neighbor if the range ends
+// with a left child that has a sibling.
+util::StatusOr<std::string> HmacTreeMac::ComputeInclusionProof(
+    absl::string_view data, uint64_t first_chunk, uint64_t num_chunks) const {
+  uint64_t count = NumChunks(data.size(), chunk_size_);
+  if (num_chunks == 0 || first_chunk >= count ||
+      num_chunks > count - first_chunk) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "invalid chunk range");
+  }
+  const size_t node_size = hmac_->tag_size();
+  std::vector<uint8_t> level(count * node_size);
+  util::Status status = ComputeLeaves(*hmac_, data, /*first_chunk=*/0,
+                                      chunk_size_, level.data());
+  if (!status.ok()) return status;
+
+  std::string proof;
+  uint64_t begin = first_chunk;
+  uint64_t end = first_chunk + num_chunks;
+  while (count > 1) {
+    if (begin % 2 == 1) {
+      proof.append(
+          reinterpret_cast<const char*>(&level[(begin - 1) * node_size]),
+          node_size);
+    }
+    if (end % 2 == 1 && end < count) {
+      proof.append(reinterpret_cast<const char*>(&level[end * node_size]),
+                   node_size);
+    }
+    util::StatusOr<std::vector<uint8_t>> parents =
+        ComputeParents(*hmac_, level);
+    if (!parents.ok()) return parents.status();
+    level = *std::move(parents);
+    begin /= 2;
+    end = (end + 1) / 2;
+    count = (count + 1) / 2;
+  }
+  return proof;
+}
+
+util::Status HmacTreeMac::VerifyRange(absl::string_view mac,
+                                      uint64_t data_size, uint64_t first_chunk,
+                                      absl::string_view chunks,
+                                      absl::string_view proof) const {
+  uint64_t count = NumChunks(data_size, chunk_size_);
+  if (first_chunk >= count || (chunks.empty() && data_size > 0)) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "invalid chunk range");
+  }
+  const uint64_t num_chunks = NumChunks(chunks.size(), chunk_size_);
+  if (num_chunks > count - first_chunk) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "invalid chunk range");
+  }
+  // All chunks but the last one of the message are whole.
+  const uint64_t range_end = first_chunk + num_chunks == count
+                                 ? data_size
+                                 : (first_chunk + num_chunks) * chunk_size_;
+  if (chunks.size() != range_end - first_chunk * chunk_size_) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "chunks do not match the chunk range");
+  }
+
+  const size_t node_size = hmac_->tag_size();
+  std::vector<uint8_t> level(num_chunks * node_size);
+  util::Status status = ComputeLeaves(*hmac_, chunks, first_chunk, chunk_size_,
+                                      level.data());
+  if (!status.ok()) return status;
+
+  auto next_proof_node = [&]() -> util::StatusOr<absl::string_view> {
+    if (proof.size() < node_size) {
+      return util::Status(absl::StatusCode::kInvalidArgument,
+                          "inclusion proof too short");
+    }
+    absl::string_view node = proof.substr(0, node_size);
+    proof.remove_prefix(node_size);
+    return node;
+  };
+  uint64_t begin = first_chunk;
+  uint64_t end = first_chunk + num_chunks;
+  while (count > 1) {
+    if (begin % 2 == 1) {
+      util::StatusOr<absl::string_view> node = next_proof_node();
+      if (!node.ok()) return node.status();
+      level.insert(level.begin(), node->begin(), node->end());
+      --begin;
+    }
+    if (end % 2 == 1 && end < count) {
+      util::StatusOr<absl::string_view> node = next_proof_node();
+      if (!node.ok()) return node.status();
+      level.insert(level.end(), node->begin(), node->end());
+      ++end;
+    }
+    // The range now starts with a left child, and ends with a right child or
+    // with the last node of the level.
+    util::StatusOr<std::vector<uint8_t>> parents =
+        ComputeParents(*hmac_, level);
+    if (!parents.ok()) return parents.status();
+    level = *std::move(parents);
+    begin /= 2;
+    end = (end + 1) / 2;
+    count = (count + 1) / 2;
+  }
+  if (!proof.empty()) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "inclusion proof too long");
+  }
+  util::StatusOr<std::string> tag =
+      ComputeTag(*hmac_, data_size, level, tag_size_);
+  if (!tag.ok()) return tag.status();
+  return CompareTags(*tag, mac);
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,108 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef TINK_SUBTLE_HMAC_TREE_MAC_H_
+#define TINK_SUBTLE_HMAC_TREE_MAC_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+#include "tink/chunked_mac.h"
+#include "tink/internal/fips_utils.h"
+#include "tink/internal/keyed_hmac.h"
+#include "tink/mac.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// MAC over a Merkle tree of HMAC values; proto/hmac_tree.proto describes the
+// construction. The data is split into chunks of chunk_size bytes whose leaf
+// HMACs are independent, so they are computed in parallel if enabled with
+// EnableParallelism() (see config/parallelism.h). A
+// range of chunks can be verified against the tag with an inclusion proof of
+// O(log(number of chunks)) tree nodes, without the rest of the data.
+//
+// Implements Mac for data in memory and ChunkedMac for data that arrives in
+// pieces; both compute the same tags. This class is thread-safe.
+class HmacTreeMac : public Mac, public ChunkedMac {
+ public:
+  static crypto::tink::util::StatusOr<std::unique_ptr<HmacTreeMac>> New(
+      HashType hash, uint32_t tag_size, uint32_t chunk_size,
+      const util::SecretData& key);
+
+  crypto::tink::util::StatusOr<std::string> ComputeMac(
+      absl::string_view data) const override;
+
+  crypto::tink::util::Status VerifyMac(absl::string_view mac,
+                                       absl::string_view data) const override;
+
+  crypto::tink::util::StatusOr<std::unique_ptr<ChunkedMacComputation>>
+  CreateComputation() const override;
+
+  crypto::tink::util::StatusOr<std::unique_ptr<ChunkedMacVerification>>
+  CreateVerification(absl::string_view tag) const override;
+
+  // Returns the inclusion proof for the `num_chunks` chunks of `data`
+  // starting at chunk `first_chunk`, i.e., the tree nodes that together with
+  // these chunks determine the root of the tree.
+  crypto::tink::util::StatusOr<std::string> ComputeInclusionProof(
+      absl::string_view data, uint64_t first_chunk, uint64_t num_chunks) const;
+
+  // Verifies that `mac` is the tag of a message of `data_size` bytes whose
+  // chunks starting at chunk `first_chunk` are `chunks`, using `proof` from
+  // ComputeInclusionProof(). `chunks` must consist of whole chunks, except
+  // for the last chunk of the message.
+  crypto::tink::util::Status VerifyRange(absl::string_view mac,
+                                         uint64_t data_size,
+                                         uint64_t first_chunk,
+                                         absl::string_view chunks,
+                                         absl::string_view proof) const;
+
+  uint32_t chunk_size() const { return chunk_size_; }
+
+  static constexpr crypto::tink::internal::FipsCompatibility kFipsStatus =
+      crypto::tink::internal::FipsCompatibility::kNotFips;
+
+  static constexpr size_t kMinKeySize = 16;
+  static constexpr uint32_t kMinTagSize = 16;
+  static constexpr uint32_t kMinChunkSize = 1024;
+
+ private:
+  HmacTreeMac(std::shared_ptr<const internal::KeyedHmac> hmac,
+              uint32_t tag_size, uint32_t chunk_size)
+      : hmac_(std::move(hmac)), tag_size_(tag_size), chunk_size_(chunk_size) {}
+
+  // Shared with the ChunkedMac computations, which may outlive this object.
+  const std::shared_ptr<const internal::KeyedHmac> hmac_;
+  const uint32_t tag_size_;
+  const uint32_t chunk_size_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_HMAC_TREE_MAC_H_
@@ -0,0 +1,335 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/subtle/hmac_tree_mac.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "tink/chunked_mac.h"
+#include "tink/internal/fips_utils.h"
+#include "tink/internal/run_in_parallel.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/random.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::IsOkAndHolds;
+using ::crypto::tink::test::StatusIs;
+using ::testing::Not;
+using ::testing::SizeIs;
+
+constexpr uint32_t kChunkSize = HmacTreeMac::kMinChunkSize;
+
+util::StatusOr<std::unique_ptr<HmacTreeMac>> NewMac(HashType hash,
+                                                    uint32_t tag_size) {
+  return HmacTreeMac::New(hash, tag_size, kChunkSize,
+                          util::SecretDataFromStringView(
+                              Random::GetRandomBytes(32)));
+}
+
+util::StatusOr<std::string> ComputeChunkedMac(const ChunkedMac& mac,
+                                              absl::string_view data,
+                                              size_t piece_size) {
+  util::StatusOr<std::unique_ptr<ChunkedMacComputation>> computation =
+      mac.CreateComputation();
+  if (!computation.ok()) return computation.status();
+  for (size_t i = 0; i < data.size(); i += piece_size) {
+    util::Status status = (*computation)->Update(data.substr(i, piece_size));
+    if (!status.ok()) return status;
+  }
+  return (*computation)->ComputeMac();
+}
+
+TEST(HmacTreeMacTest, ComputeAndVerify) {
+  if (internal::IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  for (HashType hash : {SHA256, SHA384, SHA512}) {
+    util::StatusOr<std::unique_ptr<HmacTreeMac>> mac = NewMac(hash, 32);
+    ASSERT_THAT(mac, IsOk());
+    for (size_t size : {0, 1, 1023, 1024, 1025, 3 * 1024, 5 * 1024 + 7}) {
+      SCOPED_TRACE(size);
+      std::string data = Random::GetRandomBytes(size);
+      util::StatusOr<std::string> tag = (*mac)->ComputeMac(data);
+      ASSERT_THAT(tag, IsOkAndHolds(SizeIs(32)));
+      EXPECT_THAT((*mac)->VerifyMac(*tag, data), IsOk());
+      EXPECT_THAT((*mac)->VerifyMac(*tag, data + "x"), Not(IsOk()));
+      if (size > 0) {
+        EXPECT_THAT((*mac)->VerifyMac(*tag, data.substr(0, size - 1)),
+                    Not(IsOk()));
+        data[size / 2] ^= 1;
+        EXPECT_THAT((*mac)->VerifyMac(*tag, data), Not(IsOk()));
+      }
+    }
+  }
+}
+
+TEST(HmacTreeMacTest, TagsDependOnTheKey) {
+  if (internal::IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  util::StatusOr<std::unique_ptr<HmacTreeMac>> mac1 = NewMac(SHA256, 32);
+  ASSERT_THAT(mac1, IsOk());
+  util::StatusOr<std::unique_ptr<HmacTreeMac>> mac2 = NewMac(SHA256, 32);
+  ASSERT_THAT(mac2, IsOk());
+  std::string data = Random::GetRandomBytes(4 * kChunkSize);
+  util::StatusOr<std::string> tag = (*mac1)->ComputeMac(data);
+  ASSERT_THAT(tag, IsOk());
+  EXPECT_THAT((*mac2)->VerifyMac(*tag, data),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(HmacTreeMacTest, TagsDoNotDependOnParallelism) {
+  if (internal::IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  util::StatusOr<std::unique_ptr<HmacTreeMac>> mac = NewMac(SHA256, 32);
+  ASSERT_THAT(mac, IsOk());
+  std::string data = Random::GetRandomBytes(100 * kChunkSize + 7);
+  util::StatusOr<std::string> tag = (*mac)->ComputeMac(data);
+  ASSERT_THAT(tag, IsOk());
+  ASSERT_THAT(internal::StartSharedThreadPool(4), IsOk());
+  EXPECT_THAT((*mac)->ComputeMac(data), IsOkAndHolds(*tag));
+  EXPECT_THAT((*mac)->VerifyMac(*tag, data), IsOk());
+}
+
+TEST(HmacTreeMacTest, ChunkedMacMatchesMac) {
+  if (internal::IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  util::StatusOr<std::unique_ptr<HmacTreeMac>> mac = NewMac(SHA256, 16);
+  ASSERT_THAT(mac, IsOk());
+  for (size_t size : {0, 100, 1024, 2048, 10 * 1024 + 3}) {
+    std::string data = Random::GetRandomBytes(size);
+    util::StatusOr<std::string> tag = (*mac)->ComputeMac(data);
+    ASSERT_THAT(tag, IsOk());
+    for (size_t piece_size : {1, 7, 1000, 1024, 3000, 1 << 20}) {
+      SCOPED_TRACE(absl::StrCat(size, " ", piece_size));
+      EXPECT_THAT(ComputeChunkedMac(**mac, data, piece_size),
+                  IsOkAndHolds(*tag));
+    }
+
+    util::StatusOr<std::unique_ptr<ChunkedMacVerification>> verification =
+        (*mac)->CreateVerification(*tag);
+    ASSERT_THAT(verification, IsOk());
+    ASSERT_THAT((*verification)->Update(data), IsOk());
+    EXPECT_THAT((*verification)->VerifyMac(), IsOk());
+
+    verification = (*mac)->CreateVerification(*tag);
+    ASSERT_THAT(verification, IsOk());
+    ASSERT_THAT((*verification)->Update(data + "x"), IsOk());
+    EXPECT_THAT((*verification)->VerifyMac(),
+                StatusIs(absl::StatusCode::kInvalidArgument));
+  }
+}
+
+TEST(HmacTreeMacTest, ComputationCannotBeReused) {
+  if (internal::IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  util::StatusOr<std::unique_ptr<HmacTreeMac>> mac = NewMac(SHA256, 32);
+  ASSERT_THAT(mac, IsOk());
+  util::StatusOr<std::unique_ptr<ChunkedMacComputation>> computation =
+      (*mac)->CreateComputation();
+  ASSERT_THAT(computation, IsOk());
+  ASSERT_THAT((*computation)->Update("data"), IsOk());
+  ASSERT_THAT((*computation)->ComputeMac(), IsOk());
+  EXPECT_THAT((*computation)->Update("data"),
+              StatusIs(absl::StatusCode::kFailedPrecondition));
+  EXPECT_THAT((*computation)->ComputeMac().status(),
+              StatusIs(absl::StatusCode::kFailedPrecondition));
+}
+
+TEST(HmacTreeMacTest, ComputationOutlivesMac) {
+  if (internal::IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  util::StatusOr<std::unique_ptr<HmacTreeMac>> mac = NewMac(SHA256, 32);
+  ASSERT_THAT(mac, IsOk());
+  std::string data = Random::GetRandomBytes(3 * kChunkSize);
+  util::StatusOr<std::string> tag = (*mac)->ComputeMac(data);
+  ASSERT_THAT(tag, IsOk());
+  util::StatusOr<std::unique_ptr<ChunkedMacComputation>> computation =
+      (*mac)->CreateComputation();
+  ASSERT_THAT(computation, IsOk());
+  mac->reset();
+  ASSERT_THAT((*computation)->Update(data), IsOk());
+  EXPECT_THAT((*computation)->ComputeMac(), IsOkAndHolds(*tag));
+}
+
+TEST(HmacTreeMacTest, VerifyAllRanges) {
+  if (internal::IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  util::StatusOr<std::unique_ptr<HmacTreeMac>> mac = NewMac(SHA256, 32);
+  ASSERT_THAT(mac, IsOk());
+  for (uint64_t num_chunks = 1; num_chunks <= 9; ++num_chunks) {
+    // The last chunk is partial.
+    std::string data = Random::GetRandomBytes(num_chunks * kChunkSize - 10);
+    util::StatusOr<std::string> tag = (*mac)->ComputeMac(data);
+    ASSERT_THAT(tag, IsOk());
+    for (uint64_t first = 0; first < num_chunks; ++first) {
+      for (uint64_t count = 1; first + count <= num_chunks; ++count) {
+        SCOPED_TRACE(absl::StrCat(num_chunks, " ", first, " ", count));
+        util::StatusOr<std::string> proof =
+            (*mac)->ComputeInclusionProof(data, first, count);
+        ASSERT_THAT(proof, IsOk());
+        absl::string_view chunks = absl::string_view(data).substr(
+            first * kChunkSize, count * kChunkSize);
+        EXPECT_THAT(
+            (*mac)->VerifyRange(*tag, data.size(), first, chunks, *proof),
+            IsOk());
+      }
+    }
+  }
+}
+
+TEST(HmacTreeMacTest, VerifyRangeOfEmptyData) {
+  if (internal::IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  util::StatusOr<std::unique_ptr<HmacTreeMac>> mac = NewMac(SHA256, 32);
+  ASSERT_THAT(mac, IsOk());
+  util::StatusOr<std::string> tag = (*mac)->ComputeMac("");
+  ASSERT_THAT(tag, IsOk());
+  util::StatusOr<std::string> proof = (*mac)->ComputeInclusionProof("", 0, 1);
+  ASSERT_THAT(proof, IsOkAndHolds(""));
+  EXPECT_THAT((*mac)->VerifyRange(*tag, 0, 0, "", *proof), IsOk());
+  EXPECT_THAT((*mac)->VerifyRange(*tag, 1, 0, "", *proof), Not(IsOk()));
+}
+
+TEST(HmacTreeMacTest, VerifyRangeRejectsModifications) {
+  if (internal::IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  util::StatusOr<std::unique_ptr<HmacTreeMac>> mac = NewMac(SHA256, 32);
+  ASSERT_THAT(mac, IsOk());
+  std::string data = Random::GetRandomBytes(7 * kChunkSize + 5);
+  util::StatusOr<std::string> tag = (*mac)->ComputeMac(data);
+  ASSERT_THAT(tag, IsOk());
+  util::StatusOr<std::string> proof = (*mac)->ComputeInclusionProof(data, 3, 2);
+  ASSERT_THAT(proof, IsOk());
+  std::string chunks = data.substr(3 * kChunkSize, 2 * kChunkSize);
+  ASSERT_THAT((*mac)->VerifyRange(*tag, data.size(), 3, chunks, *proof),
+              IsOk());
+
+  std::string modified_chunks = chunks;
+  modified_chunks[kChunkSize + 1] ^= 1;
+  EXPECT_THAT(
+      (*mac)->VerifyRange(*tag, data.size(), 3, modified_chunks, *proof),
+      StatusIs(absl::StatusCode::kInvalidArgument));
+
+  std::string modified_proof = *proof;
+  modified_proof[0] ^= 1;
+  EXPECT_THAT(
+      (*mac)->VerifyRange(*tag, data.size(), 3, chunks, modified_proof),
+      StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT((*mac)->VerifyRange(*tag, data.size(), 3, chunks,
+                                  proof->substr(0, proof->size() - 1)),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT((*mac)->VerifyRange(*tag, data.size(), 3, chunks, *proof + "x"),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+
+  std::string modified_tag = *tag;
+  modified_tag[0] ^= 1;
+  EXPECT_THAT(
+      (*mac)->VerifyRange(modified_tag, data.size(), 3, chunks, *proof),
+      StatusIs(absl::StatusCode::kInvalidArgument));
+
+  // The chunks at another position, or a message of another size, do not
+  // verify with the same proof.
+  EXPECT_THAT((*mac)->VerifyRange(*tag, data.size(), 2, chunks, *proof),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT((*mac)->VerifyRange(*tag, data.size() + 1, 3, chunks, *proof),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  // Partial chunks only exist at the end of the message.
+  EXPECT_THAT((*mac)->VerifyRange(*tag, data.size(), 3,
+                                  chunks.substr(0, chunks.size() - 1), *proof),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT((*mac)->VerifyRange(*tag, data.size(), 8, chunks, *proof),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(HmacTreeMacTest, InvalidRange) {
+  if (internal::IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  util::StatusOr<std::unique_ptr<HmacTreeMac>> mac = NewMac(SHA256, 32);
+  ASSERT_THAT(mac, IsOk());
+  std::string data = Random::GetRandomBytes(4 * kChunkSize);
+  EXPECT_THAT((*mac)->ComputeInclusionProof(data, 0, 0).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT((*mac)->ComputeInclusionProof(data, 4, 1).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT((*mac)->ComputeInclusionProof(data, 2, 3).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(HmacTreeMacTest, InvalidParameters) {
+  if (internal::IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  util::SecretData key =
+      util::SecretDataFromStringView(Random::GetRandomBytes(32));
+  EXPECT_THAT(HmacTreeMac::New(SHA256, 32, kChunkSize, key), IsOk());
+  EXPECT_THAT(HmacTreeMac::New(SHA1, 16, kChunkSize, key).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(HmacTreeMac::New(SHA256, 15, kChunkSize, key).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(HmacTreeMac::New(SHA256, 33, kChunkSize, key).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(HmacTreeMac::New(SHA512, 64, kChunkSize, key), IsOk());
+  EXPECT_THAT(HmacTreeMac::New(SHA256, 32, kChunkSize - 1, key).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(
+      HmacTreeMac::New(SHA256, 32, kChunkSize,
+                       util::SecretDataFromStringView(
+                           Random::GetRandomBytes(15)))
+          .status(),
+      StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(HmacTreeMacTest, FipsMode) {
+  if (!internal::IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Only supported in FIPS-only mode";
+  }
+  util::SecretData key =
+      util::SecretDataFromStringView(Random::GetRandomBytes(32));
+  EXPECT_THAT(HmacTreeMac::New(SHA256, 32, kChunkSize, key).status(),
+              StatusIs(absl::StatusCode::kInternal));
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
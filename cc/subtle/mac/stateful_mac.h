@@ -30,7 +30,9 @@
 #include <memory>
 #include <string>
 
+#include "absl/status/status.h"
 #include "absl/strings/string_view.h"
+#include "openssl/crypto.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
 
@@ -45,6 +47,21 @@ class StatefulMac {
 
   virtual util::Status Update(absl::string_view data) = 0;
   virtual util::StatusOr<std::string> Finalize() = 0;
+
+  // Finalizes the computation and compares the result with `tag` in constant
+  // time. Returns kInvalidArgument if they differ. Implementations override
+  // this to compare against a tag computed into a stack buffer instead of a
+  // newly allocated string.
+  virtual util::Status FinalizeAndVerify(absl::string_view tag) {
+    util::StatusOr<std::string> computed_tag = Finalize();
+    if (!computed_tag.ok()) return computed_tag.status();
+    if (computed_tag->size() != tag.size() ||
+        CRYPTO_memcmp(computed_tag->data(), tag.data(), tag.size()) != 0) {
+      return util::Status(absl::StatusCode::kInvalidArgument,
+                          "Verification failed.");
+    }
+    return util::OkStatus();
+  }
 };
 
 class StatefulMacFactory {
@@ -16,9 +16,12 @@
 
 #include "tink/subtle/nonce_based_streaming_aead.h"
 
+#include <cstdint>
 #include <memory>
 #include <utility>
+#include <vector>
 
+#include "absl/status/status.h"
 #include "absl/strings/string_view.h"
 #include "tink/input_stream.h"
 #include "tink/output_stream.h"
@@ -27,8 +30,12 @@
 #include "tink/subtle/decrypting_random_access_stream.h"
 #include "tink/subtle/stream_segment_decrypter.h"
 #include "tink/subtle/stream_segment_encrypter.h"
+#include "tink/subtle/streaming_aead_appender.h"
 #include "tink/subtle/streaming_aead_decrypting_stream.h"
 #include "tink/subtle/streaming_aead_encrypting_stream.h"
+#include "tink/subtle/streaming_aead_push_decrypter.h"
+#include "tink/subtle/streaming_aead_push_encrypter.h"
+#include "tink/util/status.h"
 #include "tink/util/statusor.h"
 
 namespace crypto {
@@ -68,6 +75,63 @@ crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::RandomAccessStream>>
       std::move(ciphertext_source));
 }
 
+crypto::tink::util::Status NonceBasedStreamingAead::VerifyCiphertext(
+    std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source,
+    absl::string_view associated_data, int64_t* first_invalid_segment) const {
+  if (first_invalid_segment != nullptr) *first_invalid_segment = -1;
+  auto segment_decrypter_result = NewSegmentDecrypter(associated_data);
+  if (!segment_decrypter_result.ok()) return segment_decrypter_result.status();
+  return DecryptingRandomAccessStream::VerifyAllSegments(
+      std::move(segment_decrypter_result.value()),
+      std::move(ciphertext_source), first_invalid_segment);
+}
+
+crypto::tink::util::StatusOr<std::unique_ptr<StreamingAead::PushEncrypter>>
+NonceBasedStreamingAead::NewPushEncrypter(
+    absl::string_view associated_data) const {
+  auto segment_encrypter_result = NewSegmentEncrypter(associated_data);
+  if (!segment_encrypter_result.ok()) return segment_encrypter_result.status();
+  return StreamingAeadPushEncrypter::New(
+      std::move(segment_encrypter_result.value()));
+}
+
+crypto::tink::util::StatusOr<std::unique_ptr<StreamingAead::PushDecrypter>>
+NonceBasedStreamingAead::NewPushDecrypter(
+    absl::string_view associated_data) const {
+  auto segment_decrypter_result = NewSegmentDecrypter(associated_data);
+  if (!segment_decrypter_result.ok()) return segment_decrypter_result.status();
+  return StreamingAeadPushDecrypter::New(
+      std::move(segment_decrypter_result.value()));
+}
+
+crypto::tink::util::StatusOr<std::unique_ptr<StreamingAead::Appender>>
+NonceBasedStreamingAead::NewAppender(
+    std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source,
+    absl::string_view associated_data) const {
+  auto segment_decrypter_result = NewSegmentDecrypter(associated_data);
+  if (!segment_decrypter_result.ok()) return segment_decrypter_result.status();
+  return StreamingAeadAppender::New(
+      std::move(segment_decrypter_result.value()), std::move(ciphertext_source),
+      [&](const std::vector<uint8_t>& header, int64_t first_segment_number) {
+        return NewSegmentEncrypterForAppend(associated_data, header,
+                                            first_segment_number);
+      });
+}
+
+crypto::tink::util::StatusOr<std::unique_ptr<StreamSegmentEncrypter>>
+NonceBasedStreamingAead::NewSegmentEncrypterForFile(
+    absl::string_view associated_data) const {
+  return NewSegmentEncrypter(associated_data);
+}
+
+crypto::tink::util::StatusOr<std::unique_ptr<StreamSegmentEncrypter>>
+NonceBasedStreamingAead::NewSegmentEncrypterForAppend(
+    absl::string_view associated_data, const std::vector<uint8_t>& header,
+    int64_t first_segment_number) const {
+  return crypto::tink::util::Status(absl::StatusCode::kUnimplemented,
+                                    "Appending is not supported");
+}
+
 }  // namespace subtle
 }  // namespace tink
 }  // namespace crypto
@@ -17,7 +17,9 @@
 #ifndef TINK_SUBTLE_NONCE_BASED_STREAMING_AEAD_H_
 #define TINK_SUBTLE_NONCE_BASED_STREAMING_AEAD_H_
 
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "absl/strings/string_view.h"
 #include "tink/input_stream.h"
@@ -26,6 +28,7 @@
 #include "tink/streaming_aead.h"
 #include "tink/subtle/stream_segment_decrypter.h"
 #include "tink/subtle/stream_segment_encrypter.h"
+#include "tink/util/status.h"
 #include "tink/util/statusor.h"
 
 namespace crypto {
@@ -55,6 +58,23 @@ class NonceBasedStreamingAead : public StreamingAead {
       std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source,
       absl::string_view associated_data) const override;
 
+  // Verifies the tags of all segments without decrypting them, in parallel
+  // if enabled with EnableParallelism().
+  crypto::tink::util::Status VerifyCiphertext(
+      std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source,
+      absl::string_view associated_data,
+      int64_t* first_invalid_segment) const override;
+
+  crypto::tink::util::StatusOr<std::unique_ptr<PushEncrypter>>
+  NewPushEncrypter(absl::string_view associated_data) const override;
+
+  crypto::tink::util::StatusOr<std::unique_ptr<PushDecrypter>>
+  NewPushDecrypter(absl::string_view associated_data) const override;
+
+  crypto::tink::util::StatusOr<std::unique_ptr<Appender>> NewAppender(
+      std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source,
+      absl::string_view associated_data) const override;
+
  protected:
   // Methods to be implemented by a subclass of this class.
 
@@ -62,9 +82,30 @@ class NonceBasedStreamingAead : public StreamingAead {
   virtual crypto::tink::util::StatusOr<std::unique_ptr<StreamSegmentEncrypter>>
   NewSegmentEncrypter(absl::string_view associated_data) const = 0;
 
+  // Returns a new StreamSegmentEncrypter for EncryptFile() (see
+  // streaming_aead_file_encryption.h). Subclasses can override this to return
+  // an encrypter that supports EncryptSegmentFromFile(); the default calls
+  // NewSegmentEncrypter().
+  virtual crypto::tink::util::StatusOr<std::unique_ptr<StreamSegmentEncrypter>>
+  NewSegmentEncrypterForFile(absl::string_view associated_data) const;
+
   // Returns a new StreamSegmentDecrypter that uses `associated_data` for AEAD.
   virtual crypto::tink::util::StatusOr<std::unique_ptr<StreamSegmentDecrypter>>
   NewSegmentDecrypter(absl::string_view associated_data) const = 0;
+
+  // Returns a new StreamSegmentEncrypter that uses `associated_data` for AEAD
+  // and continues the ciphertext stream with header `header`, starting at
+  // segment `first_segment_number`. Subclasses that support appending
+  // override this; the default returns an UNIMPLEMENTED error.
+  virtual crypto::tink::util::StatusOr<std::unique_ptr<StreamSegmentEncrypter>>
+  NewSegmentEncrypterForAppend(absl::string_view associated_data,
+                               const std::vector<uint8_t>& header,
+                               int64_t first_segment_number) const;
+
+ private:
+  friend crypto::tink::util::Status EncryptFile(
+      const NonceBasedStreamingAead& streaming_aead, int plaintext_fd,
+      int ciphertext_fd, absl::string_view associated_data);
 };
 
 }  // namespace subtle
@@ -84,8 +84,8 @@ util::Status EcKeyToSslEcPublicKey(
                         "`openssl_ec_key` arg cannot be NULL");
   }
 
-  util::StatusOr<internal::SslUniquePtr<EC_GROUP>> group =
-      internal::EcGroupFromCurveType(subtle_ec_key.curve);
+  util::StatusOr<const EC_GROUP*> group =
+      internal::CachedEcGroupFromCurveType(subtle_ec_key.curve);
   if (!group.ok()) {
     return group.status();
   }
@@ -98,7 +98,7 @@ util::Status EcKeyToSslEcPublicKey(
   }
 
   // Set key's group and EC point.
-  if (!EC_KEY_set_group(openssl_ec_key, group->get())) {
+  if (!EC_KEY_set_group(openssl_ec_key, *group)) {
     return util::Status(
         absl::StatusCode::kInternal,
         absl::StrCat("Failed to set key group from EC group for curve ",
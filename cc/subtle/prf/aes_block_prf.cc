@@ -0,0 +1,228 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/subtle/prf/aes_block_prf.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "openssl/aes.h"
+#include "openssl/crypto.h"
+#include "openssl/evp.h"
+#include "tink/internal/aes_util.h"
+#include "tink/internal/fips_utils.h"
+#include "tink/internal/ssl_unique_ptr.h"
+#include "tink/util/request_arena.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+constexpr size_t kBlockSize = AesBlockPrf::kBlockSize;
+
+// Below this many inputs, ComputeBatch() does not amortize the setup of an
+// EVP context and uses the precomputed key schedule instead.
+constexpr size_t kMinEvpBatchSize = 8;
+
+// Number of blocks encrypted per EVP call in ComputeBatch().
+constexpr size_t kChunkBlocks = 64;
+
+// Copies `input[offset, offset + kBlockSize)` to `block`, zero-padded.
+void LoadBlock(absl::string_view input, size_t offset, uint8_t* block) {
+  const size_t size = input.size() - offset < kBlockSize
+                          ? input.size() - offset
+                          : kBlockSize;
+  std::memcpy(block, input.data() + offset, size);
+  std::memset(block + size, 0, kBlockSize - size);
+}
+
+// XORs `input[offset, offset + kBlockSize)`, zero-padded, into `block`.
+void XorBlock(absl::string_view input, size_t offset, uint8_t* block) {
+  for (size_t i = 0; offset + i < input.size() && i < kBlockSize; ++i) {
+    block[i] ^= static_cast<uint8_t>(input[offset + i]);
+  }
+}
+
+util::Status EncryptBlocks(EVP_CIPHER_CTX* context, uint8_t* blocks,
+                           size_t num_blocks) {
+  int len = 0;
+  if (EVP_EncryptUpdate(context, blocks, &len, blocks,
+                        num_blocks * kBlockSize) != 1 ||
+      len != static_cast<int>(num_blocks * kBlockSize)) {
+    return util::Status(absl::StatusCode::kInternal, "AES encryption failed");
+  }
+  return util::OkStatus();
+}
+
+}  // namespace
+
+util::StatusOr<std::unique_ptr<Prf>> AesBlockPrf::New(
+    const util::SecretData& key, size_t input_size) {
+  util::Status status = internal::CheckFipsCompatibility<AesBlockPrf>();
+  if (!status.ok()) return status;
+
+  if (key.size() != 16 && key.size() != 32) {
+    return util::Status(
+        absl::StatusCode::kInvalidArgument,
+        absl::StrCat("Invalid key size; valid values are {16, 32} bytes, got ",
+                     key.size()));
+  }
+  if (input_size == 0 || input_size > kMaxInputSize) {
+    return util::Status(
+        absl::StatusCode::kInvalidArgument,
+        absl::StrCat("Invalid input size; must be between 1 and ",
+                     kMaxInputSize, " bytes, got ", input_size));
+  }
+  util::SecretUniquePtr<AES_KEY> aes_key = util::MakeSecretUniquePtr<AES_KEY>();
+  if (AES_set_encrypt_key(key.data(), 8 * key.size(), aes_key.get()) != 0) {
+    return util::Status(absl::StatusCode::kInternal,
+                        "could not initialize aes key");
+  }
+  return {absl::WrapUnique(
+      new AesBlockPrf(key, std::move(aes_key), input_size))};
+}
+
+util::Status AesBlockPrf::Validate(absl::string_view input,
+                                   size_t output_length) const {
+  if (input.size() != input_size_) {
+    return util::Status(
+        absl::StatusCode::kInvalidArgument,
+        absl::StrCat("Invalid input size; this PRF only accepts inputs of ",
+                     input_size_, " bytes, got ", input.size()));
+  }
+  if (output_length > kBlockSize) {
+    return util::Status(
+        absl::StatusCode::kInvalidArgument,
+        absl::StrCat("PRF only supports outputs up to ", kBlockSize,
+                     " bytes, but ", output_length, " bytes were requested"));
+  }
+  return util::OkStatus();
+}
+
+void AesBlockPrf::ComputeBlock(absl::string_view input,
+                               uint8_t out[kBlockSize]) const {
+  LoadBlock(input, 0, out);
+  AES_encrypt(out, out, aes_key_.get());
+  if (input_size_ > kBlockSize) {
+    XorBlock(input, kBlockSize, out);
+    AES_encrypt(out, out, aes_key_.get());
+  }
+}
+
+util::StatusOr<std::string> AesBlockPrf::Compute(absl::string_view input,
+                                                 size_t output_length) const {
+  util::Status status = Validate(input, output_length);
+  if (!status.ok()) return status;
+
+  uint8_t block[kBlockSize];
+  ComputeBlock(input, block);
+  std::string output(reinterpret_cast<const char*>(block), output_length);
+  OPENSSL_cleanse(block, sizeof(block));
+  return output;
+}
+
+util::StatusOr<absl::string_view> AesBlockPrf::ComputeWithArena(
+    absl::string_view input, size_t output_length,
+    util::RequestArena* arena) const {
+  util::Status status = Validate(input, output_length);
+  if (!status.ok()) return status;
+
+  uint8_t block[kBlockSize];
+  ComputeBlock(input, block);
+  absl::string_view output = arena->Copy(
+      absl::string_view(reinterpret_cast<const char*>(block), output_length));
+  OPENSSL_cleanse(block, sizeof(block));
+  return output;
+}
+
+util::StatusOr<std::vector<std::string>> AesBlockPrf::ComputeBatch(
+    absl::Span<const absl::string_view> inputs, size_t output_length) const {
+  for (absl::string_view input : inputs) {
+    util::Status status = Validate(input, output_length);
+    if (!status.ok()) return status;
+  }
+  std::vector<std::string> outputs;
+  outputs.reserve(inputs.size());
+  if (inputs.size() < kMinEvpBatchSize) {
+    uint8_t block[kBlockSize];
+    for (absl::string_view input : inputs) {
+      ComputeBlock(input, block);
+      outputs.emplace_back(reinterpret_cast<const char*>(block),
+                           output_length);
+    }
+    OPENSSL_cleanse(block, sizeof(block));
+    return outputs;
+  }
+
+  util::StatusOr<const EVP_CIPHER*> cipher =
+      internal::GetAesEcbCipherForKeySize(key_.size());
+  if (!cipher.ok()) return cipher.status();
+  internal::SslUniquePtr<EVP_CIPHER_CTX> context(EVP_CIPHER_CTX_new());
+  if (context == nullptr ||
+      EVP_EncryptInit_ex(context.get(), *cipher, /*impl=*/nullptr, key_.data(),
+                         /*iv=*/nullptr) != 1 ||
+      EVP_CIPHER_CTX_set_padding(context.get(), /*pad=*/0) != 1) {
+    return util::Status(absl::StatusCode::kInternal,
+                        "Context initialization failed");
+  }
+
+  std::array<uint8_t, kChunkBlocks * kBlockSize> blocks;
+  util::Status status;
+  for (size_t start = 0; start < inputs.size(); start += kChunkBlocks) {
+    const size_t num_blocks = inputs.size() - start < kChunkBlocks
+                                  ? inputs.size() - start
+                                  : kChunkBlocks;
+    for (size_t i = 0; i < num_blocks; ++i) {
+      LoadBlock(inputs[start + i], 0, &blocks[i * kBlockSize]);
+    }
+    status = EncryptBlocks(context.get(), blocks.data(), num_blocks);
+    if (status.ok() && input_size_ > kBlockSize) {
+      for (size_t i = 0; i < num_blocks; ++i) {
+        XorBlock(inputs[start + i], kBlockSize, &blocks[i * kBlockSize]);
+      }
+      status = EncryptBlocks(context.get(), blocks.data(), num_blocks);
+    }
+    if (!status.ok()) break;
+    for (size_t i = 0; i < num_blocks; ++i) {
+      outputs.emplace_back(
+          reinterpret_cast<const char*>(&blocks[i * kBlockSize]),
+          output_length);
+    }
+  }
+  OPENSSL_cleanse(blocks.data(), blocks.size());
+  if (!status.ok()) return status;
+  return outputs;
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,103 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef TINK_SUBTLE_PRF_AES_BLOCK_PRF_H_
+#define TINK_SUBTLE_PRF_AES_BLOCK_PRF_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "openssl/aes.h"
+#include "tink/internal/fips_utils.h"
+#include "tink/prf/prf_set.h"
+#include "tink/util/request_arena.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// A Prf for short inputs of a fixed size, such as user IDs or shard keys,
+// that costs one or two AES block encryptions per input:
+//   * inputs of at most 16 bytes are zero-padded to one block and encrypted,
+//   * inputs of 17 to 32 bytes are zero-padded to two blocks and
+//     authenticated with CBC-MAC.
+// Zero padding and CBC-MAC are only secure because all inputs have the same
+// size; Compute() rejects inputs of any other size. Outputs have at most 16
+// bytes.
+//
+// AES is a permutation, so it is indistinguishable from a random function
+// only up to the birthday bound; do not evaluate more than 2^48 inputs per
+// key.
+//
+// Compute() uses a precomputed key schedule and no heap memory besides the
+// output. ComputeBatch() encrypts many blocks per EVP call, which lets
+// pipelined AES implementations (e.g., AES-NI) process several blocks at once.
+class AesBlockPrf : public Prf {
+ public:
+  static constexpr size_t kBlockSize = 16;
+  static constexpr size_t kMaxInputSize = 2 * kBlockSize;
+
+  // Key must be 16 or 32 bytes, and `input_size` between 1 and kMaxInputSize.
+  static util::StatusOr<std::unique_ptr<Prf>> New(const util::SecretData& key,
+                                                  size_t input_size);
+
+  util::StatusOr<std::string> Compute(absl::string_view input,
+                                      size_t output_length) const override;
+
+  util::StatusOr<std::vector<std::string>> ComputeBatch(
+      absl::Span<const absl::string_view> inputs,
+      size_t output_length) const override;
+
+  util::StatusOr<absl::string_view> ComputeWithArena(
+      absl::string_view input, size_t output_length,
+      util::RequestArena* arena) const override;
+
+  static constexpr crypto::tink::internal::FipsCompatibility kFipsStatus =
+      crypto::tink::internal::FipsCompatibility::kNotFips;
+
+ private:
+  AesBlockPrf(util::SecretData key, util::SecretUniquePtr<AES_KEY> aes_key,
+              size_t input_size)
+      : key_(std::move(key)),
+        aes_key_(std::move(aes_key)),
+        input_size_(input_size) {}
+
+  util::Status Validate(absl::string_view input, size_t output_length) const;
+
+  // Computes the full 16-byte PRF output of a validated `input`.
+  void ComputeBlock(absl::string_view input, uint8_t out[kBlockSize]) const;
+
+  // Kept to set up the EVP context of ComputeBatch().
+  const util::SecretData key_;
+  const util::SecretUniquePtr<AES_KEY> aes_key_;
+  const size_t input_size_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_PRF_AES_BLOCK_PRF_H_
@@ -0,0 +1,232 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/subtle/prf/aes_block_prf.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/status/status.h"
+#include "absl/strings/escaping.h"
+#include "absl/strings/string_view.h"
+#include "openssl/evp.h"
+#include "tink/config/tink_fips.h"
+#include "tink/internal/ssl_unique_ptr.h"
+#include "tink/prf/prf_set.h"
+#include "tink/subtle/random.h"
+#include "tink/util/request_arena.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::IsOkAndHolds;
+using ::crypto::tink::test::StatusIs;
+using ::testing::SizeIs;
+
+// Computes the expected output with AES-CBC and a zero IV: the last
+// ciphertext block is the CBC-MAC of the zero-padded input.
+std::string ReferencePrf(const util::SecretData& key, absl::string_view input) {
+  std::string padded(input);
+  padded.resize(input.size() <= 16 ? 16 : 32, '\0');
+  const EVP_CIPHER* cipher =
+      key.size() == 16 ? EVP_aes_128_cbc() : EVP_aes_256_cbc();
+  internal::SslUniquePtr<EVP_CIPHER_CTX> context(EVP_CIPHER_CTX_new());
+  const uint8_t iv[16] = {};
+  EXPECT_EQ(EVP_EncryptInit_ex(context.get(), cipher, nullptr, key.data(), iv),
+            1);
+  EXPECT_EQ(EVP_CIPHER_CTX_set_padding(context.get(), 0), 1);
+  std::vector<uint8_t> out(padded.size());
+  int len = 0;
+  EXPECT_EQ(EVP_EncryptUpdate(context.get(), out.data(), &len,
+                              reinterpret_cast<const uint8_t*>(padded.data()),
+                              padded.size()),
+            1);
+  return std::string(out.end() - 16, out.end());
+}
+
+// Test vectors from FIPS 197, Appendix C.
+TEST(AesBlockPrfTest, Fips197TestVectors) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+
+  std::string input = absl::HexStringToBytes("00112233445566778899aabbccddeeff");
+  util::StatusOr<std::unique_ptr<Prf>> prf128 =
+      AesBlockPrf::New(util::SecretDataFromStringView(absl::HexStringToBytes(
+                           "000102030405060708090a0b0c0d0e0f")),
+                       16);
+  ASSERT_THAT(prf128, IsOk());
+  EXPECT_THAT((*prf128)->Compute(input, 16),
+              IsOkAndHolds(absl::HexStringToBytes(
+                  "69c4e0d86a7b0430d8cdb78070b4c55a")));
+
+  util::StatusOr<std::unique_ptr<Prf>> prf256 = AesBlockPrf::New(
+      util::SecretDataFromStringView(absl::HexStringToBytes(
+          "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f")),
+      16);
+  ASSERT_THAT(prf256, IsOk());
+  EXPECT_THAT((*prf256)->Compute(input, 8),
+              IsOkAndHolds(absl::HexStringToBytes("8ea2b7ca516745bf")));
+}
+
+TEST(AesBlockPrfTest, MatchesCbcMac) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+
+  for (size_t key_size : {16, 32}) {
+    for (size_t input_size : {1, 8, 15, 16, 17, 31, 32}) {
+      util::SecretData key =
+          util::SecretDataFromStringView(Random::GetRandomBytes(key_size));
+      util::StatusOr<std::unique_ptr<Prf>> prf =
+          AesBlockPrf::New(key, input_size);
+      ASSERT_THAT(prf, IsOk());
+      std::string input = Random::GetRandomBytes(input_size);
+      EXPECT_THAT((*prf)->Compute(input, 16),
+                  IsOkAndHolds(ReferencePrf(key, input)))
+          << "key size " << key_size << ", input size " << input_size;
+    }
+  }
+}
+
+TEST(AesBlockPrfTest, ComputeBatch) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+
+  for (size_t input_size : {12, 16, 24}) {
+    util::StatusOr<std::unique_ptr<Prf>> prf = AesBlockPrf::New(
+        util::SecretDataFromStringView(Random::GetRandomBytes(32)),
+        input_size);
+    ASSERT_THAT(prf, IsOk());
+    // Covers both the small-batch path and several EVP chunks.
+    for (size_t batch_size : {0, 1, 7, 8, 64, 65, 200}) {
+      std::vector<std::string> messages;
+      for (size_t i = 0; i < batch_size; ++i) {
+        messages.push_back(Random::GetRandomBytes(input_size));
+      }
+      std::vector<absl::string_view> inputs(messages.begin(), messages.end());
+      util::StatusOr<std::vector<std::string>> outputs =
+          (*prf)->ComputeBatch(inputs, 10);
+      ASSERT_THAT(outputs, IsOk());
+      ASSERT_THAT(*outputs, SizeIs(batch_size));
+      for (size_t i = 0; i < batch_size; ++i) {
+        EXPECT_THAT((*prf)->Compute(messages[i], 10),
+                    IsOkAndHolds((*outputs)[i]));
+      }
+    }
+  }
+}
+
+TEST(AesBlockPrfTest, ComputeWithArena) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+
+  util::StatusOr<std::unique_ptr<Prf>> prf = AesBlockPrf::New(
+      util::SecretDataFromStringView(Random::GetRandomBytes(32)), 5);
+  ASSERT_THAT(prf, IsOk());
+  util::RequestArena arena;
+  for (size_t output_length : {1, 10, 16}) {
+    util::StatusOr<absl::string_view> output =
+        (*prf)->ComputeWithArena("input", output_length, &arena);
+    ASSERT_THAT(output, IsOk());
+    EXPECT_THAT((*prf)->Compute("input", output_length),
+                IsOkAndHolds(std::string(*output)));
+  }
+  EXPECT_THAT((*prf)->ComputeWithArena("input", 17, &arena).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(AesBlockPrfTest, RejectsInputsOfOtherSizes) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+
+  util::StatusOr<std::unique_ptr<Prf>> prf = AesBlockPrf::New(
+      util::SecretDataFromStringView(Random::GetRandomBytes(32)), 8);
+  ASSERT_THAT(prf, IsOk());
+  EXPECT_THAT((*prf)->Compute("", 16).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT((*prf)->Compute("1234567", 16).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT((*prf)->Compute("123456789", 16).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  std::vector<absl::string_view> inputs(10, "12345678");
+  inputs.push_back("1234");
+  EXPECT_THAT((*prf)->ComputeBatch(inputs, 16).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(AesBlockPrfTest, OutputTooLong) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+
+  util::StatusOr<std::unique_ptr<Prf>> prf = AesBlockPrf::New(
+      util::SecretDataFromStringView(Random::GetRandomBytes(32)), 8);
+  ASSERT_THAT(prf, IsOk());
+  EXPECT_THAT((*prf)->Compute("12345678", 17).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(AesBlockPrfTest, InvalidParameters) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+
+  EXPECT_THAT(AesBlockPrf::New(util::SecretDataFromStringView(
+                                   Random::GetRandomBytes(24)),
+                               16)
+                  .status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  for (size_t input_size : {0, 33}) {
+    EXPECT_THAT(AesBlockPrf::New(util::SecretDataFromStringView(
+                                     Random::GetRandomBytes(32)),
+                                 input_size)
+                    .status(),
+                StatusIs(absl::StatusCode::kInvalidArgument));
+  }
+}
+
+TEST(AesBlockPrfTest, FipsOnly) {
+  if (!IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Only supported in FIPS-only mode";
+  }
+
+  EXPECT_THAT(AesBlockPrf::New(util::SecretDataFromStringView(
+                                   Random::GetRandomBytes(32)),
+                               16)
+                  .status(),
+              StatusIs(absl::StatusCode::kInternal));
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
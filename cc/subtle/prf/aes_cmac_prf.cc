@@ -0,0 +1,109 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////////
+#include "tink/subtle/prf/aes_cmac_prf.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/internal/aes_cmac_batch.h"
+#include "tink/internal/fips_utils.h"
+#include "tink/util/request_arena.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+util::Status ValidateOutputLength(size_t output_length) {
+  if (output_length > internal::AesCmacBatch::kTagSize) {
+    return util::Status(
+        absl::StatusCode::kInvalidArgument,
+        absl::StrCat("PRF only supports outputs up to ",
+                     internal::AesCmacBatch::kTagSize, " bytes, but ",
+                     output_length, " bytes were requested"));
+  }
+  return util::OkStatus();
+}
+
+}  // namespace
+
+util::StatusOr<std::unique_ptr<Prf>> AesCmacPrf::New(
+    const util::SecretData& key_value) {
+  util::Status status = internal::CheckFipsCompatibility<AesCmacPrf>();
+  if (!status.ok()) return status;
+
+  util::StatusOr<std::unique_ptr<internal::AesCmacBatch>> cmac =
+      internal::AesCmacBatch::New(key_value);
+  if (!cmac.ok()) return cmac.status();
+  return {absl::WrapUnique(new AesCmacPrf(*std::move(cmac)))};
+}
+
+util::StatusOr<std::string> AesCmacPrf::Compute(absl::string_view input,
+                                                size_t output_length) const {
+  util::Status status = ValidateOutputLength(output_length);
+  if (!status.ok()) return status;
+
+  uint8_t tag[internal::AesCmacBatch::kTagSize];
+  status = cmac_->Compute(absl::MakeConstSpan(&input, 1), absl::MakeSpan(tag));
+  if (!status.ok()) return status;
+  return std::string(reinterpret_cast<const char*>(tag), output_length);
+}
+
+util::StatusOr<absl::string_view> AesCmacPrf::ComputeWithArena(
+    absl::string_view input, size_t output_length,
+    util::RequestArena* arena) const {
+  util::Status status = ValidateOutputLength(output_length);
+  if (!status.ok()) return status;
+
+  uint8_t tag[internal::AesCmacBatch::kTagSize];
+  status = cmac_->Compute(absl::MakeConstSpan(&input, 1), absl::MakeSpan(tag));
+  if (!status.ok()) return status;
+  return arena->Copy(
+      absl::string_view(reinterpret_cast<const char*>(tag), output_length));
+}
+
+util::StatusOr<std::vector<std::string>> AesCmacPrf::ComputeBatch(
+    absl::Span<const absl::string_view> inputs, size_t output_length) const {
+  util::Status status = ValidateOutputLength(output_length);
+  if (!status.ok()) return status;
+
+  std::vector<uint8_t> tags(internal::AesCmacBatch::kTagSize * inputs.size());
+  status = cmac_->Compute(inputs, absl::MakeSpan(tags));
+  if (!status.ok()) return status;
+  std::vector<std::string> outputs;
+  outputs.reserve(inputs.size());
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    outputs.emplace_back(reinterpret_cast<const char*>(
+                             &tags[i * internal::AesCmacBatch::kTagSize]),
+                         output_length);
+  }
+  return outputs;
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,71 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////////
+#ifndef TINK_SUBTLE_PRF_AES_CMAC_PRF_H_
+#define TINK_SUBTLE_PRF_AES_CMAC_PRF_H_
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/internal/aes_cmac_batch.h"
+#include "tink/internal/fips_utils.h"
+#include "tink/prf/prf_set.h"
+#include "tink/util/request_arena.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// AES-CMAC (RFC 4493) as a Prf, with output of at most 16 bytes.
+// ComputeBatch() interleaves the CMAC computations of several inputs, see
+// internal::AesCmacBatch.
+class AesCmacPrf : public Prf {
+ public:
+  // Key must be 16 or 32 bytes, all other sizes will be rejected.
+  static util::StatusOr<std::unique_ptr<Prf>> New(
+      const util::SecretData& key_value);
+
+  util::StatusOr<std::string> Compute(absl::string_view input,
+                                      size_t output_length) const override;
+
+  util::StatusOr<std::vector<std::string>> ComputeBatch(
+      absl::Span<const absl::string_view> inputs,
+      size_t output_length) const override;
+
+  util::StatusOr<absl::string_view> ComputeWithArena(
+      absl::string_view input, size_t output_length,
+      util::RequestArena* arena) const override;
+
+  static constexpr crypto::tink::internal::FipsCompatibility kFipsStatus =
+      crypto::tink::internal::FipsCompatibility::kNotFips;
+
+ private:
+  explicit AesCmacPrf(std::unique_ptr<internal::AesCmacBatch> cmac)
+      : cmac_(std::move(cmac)) {}
+
+  const std::unique_ptr<internal::AesCmacBatch> cmac_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_PRF_AES_CMAC_PRF_H_
@@ -0,0 +1,162 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////////
+#include "tink/subtle/prf/aes_cmac_prf.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/strings/escaping.h"
+#include "absl/strings/string_view.h"
+#include "tink/config/tink_fips.h"
+#include "tink/prf/prf_set.h"
+#include "tink/subtle/prf/prf_set_util.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/stateful_cmac_boringssl.h"
+#include "tink/util/request_arena.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::IsOkAndHolds;
+using ::crypto::tink::test::StatusIs;
+using ::testing::ElementsAre;
+using ::testing::SizeIs;
+
+TEST(AesCmacPrfTest, Rfc4493TestVectors) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+
+  util::StatusOr<std::unique_ptr<Prf>> prf =
+      AesCmacPrf::New(util::SecretDataFromStringView(
+          absl::HexStringToBytes("2b7e151628aed2a6abf7158809cf4f3c")));
+  ASSERT_THAT(prf, IsOk());
+  std::string message = absl::HexStringToBytes(
+      "6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51"
+      "30c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710");
+
+  EXPECT_THAT((*prf)->Compute("", 16),
+              IsOkAndHolds(absl::HexStringToBytes(
+                  "bb1d6929e95937287fa37d129b756746")));
+  std::vector<absl::string_view> inputs = {
+      absl::string_view(message).substr(0, 16), message};
+  EXPECT_THAT(
+      (*prf)->ComputeBatch(inputs, 8),
+      IsOkAndHolds(ElementsAre(absl::HexStringToBytes("070a16b46b4d4144"),
+                               absl::HexStringToBytes("51f0bebf7e3b9d92"))));
+}
+
+TEST(AesCmacPrfTest, MatchesStatefulCmacPrf) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+
+  util::SecretData key =
+      util::SecretDataFromStringView(Random::GetRandomBytes(32));
+  util::StatusOr<std::unique_ptr<Prf>> prf = AesCmacPrf::New(key);
+  ASSERT_THAT(prf, IsOk());
+  std::unique_ptr<Prf> reference = CreatePrfFromStatefulMacFactory(
+      absl::make_unique<StatefulCmacBoringSslFactory>(16, key));
+
+  std::vector<std::string> messages;
+  for (int size = 0; size <= 128; ++size) {
+    messages.push_back(Random::GetRandomBytes(size));
+  }
+  std::vector<absl::string_view> inputs(messages.begin(), messages.end());
+  util::StatusOr<std::vector<std::string>> outputs =
+      (*prf)->ComputeBatch(inputs, 16);
+  ASSERT_THAT(outputs, IsOk());
+  ASSERT_THAT(*outputs, SizeIs(messages.size()));
+  for (int i = 0; i < messages.size(); ++i) {
+    util::StatusOr<std::string> expected = reference->Compute(messages[i], 16);
+    ASSERT_THAT(expected, IsOk());
+    EXPECT_EQ((*outputs)[i], *expected);
+    EXPECT_THAT((*prf)->Compute(messages[i], 16), IsOkAndHolds(*expected));
+  }
+}
+
+TEST(AesCmacPrfTest, ComputeWithArena) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+
+  util::StatusOr<std::unique_ptr<Prf>> prf = AesCmacPrf::New(
+      util::SecretDataFromStringView(Random::GetRandomBytes(32)));
+  ASSERT_THAT(prf, IsOk());
+  util::RequestArena arena;
+  for (size_t output_length : {1, 10, 16}) {
+    util::StatusOr<absl::string_view> output =
+        (*prf)->ComputeWithArena("input", output_length, &arena);
+    ASSERT_THAT(output, IsOk());
+    EXPECT_THAT((*prf)->Compute("input", output_length),
+                IsOkAndHolds(std::string(*output)));
+  }
+  EXPECT_THAT((*prf)->ComputeWithArena("input", 17, &arena).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(AesCmacPrfTest, OutputTooLong) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+
+  util::StatusOr<std::unique_ptr<Prf>> prf = AesCmacPrf::New(
+      util::SecretDataFromStringView(Random::GetRandomBytes(32)));
+  ASSERT_THAT(prf, IsOk());
+  EXPECT_THAT((*prf)->Compute("input", 17).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  std::vector<absl::string_view> inputs = {"input"};
+  EXPECT_THAT((*prf)->ComputeBatch(inputs, 17).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(AesCmacPrfTest, InvalidKeySize) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+
+  EXPECT_THAT(AesCmacPrf::New(util::SecretDataFromStringView(
+                                  Random::GetRandomBytes(24)))
+                  .status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(AesCmacPrfTest, FipsOnly) {
+  if (!IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Only supported in FIPS-only mode";
+  }
+
+  EXPECT_THAT(AesCmacPrf::New(util::SecretDataFromStringView(
+                                  Random::GetRandomBytes(32)))
+                  .status(),
+              StatusIs(absl::StatusCode::kInternal));
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,160 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/subtle/prf/hkdf_prf.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "openssl/crypto.h"
+#include "openssl/evp.h"
+#include "tink/internal/fips_utils.h"
+#include "tink/internal/keyed_hmac.h"
+#include "tink/internal/md_util.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/subtle_util.h"
+#include "tink/util/request_arena.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+// HKDF-Expand can produce at most 255 blocks of output.
+constexpr size_t kMaxBlocks = 255;
+
+}  // namespace
+
+util::StatusOr<std::unique_ptr<Prf>> HkdfPrf::New(
+    HashType hash, const util::SecretData& secret, absl::string_view salt) {
+  util::Status status = internal::CheckFipsCompatibility<HkdfPrf>();
+  if (!status.ok()) return status;
+
+  if (hash != SHA256 && hash != SHA512 && hash != SHA1) {
+    return util::Status(
+        absl::StatusCode::kInvalidArgument,
+        absl::StrCat("Hash ", hash, " not acceptable for HkdfPrf"));
+  }
+  if (secret.size() < 10) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "Too short secret for HkdfPrf");
+  }
+  util::StatusOr<const EVP_MD*> md = internal::EvpHashFromHashType(hash);
+  if (!md.ok()) {
+    return util::Status(absl::StatusCode::kUnimplemented, "Unsupported hash");
+  }
+
+  // HKDF-Extract. An empty salt is equivalent to the all-zero salt of
+  // RFC 5869, since HMAC pads keys with zeros.
+  util::StatusOr<std::unique_ptr<internal::KeyedHmac>> extract =
+      internal::KeyedHmac::New(*md, salt);
+  if (!extract.ok()) return extract.status();
+  util::SecretData prk((*extract)->tag_size());
+  absl::string_view ikm = util::SecretDataAsStringView(secret);
+  status = (*extract)->Compute(absl::MakeConstSpan(&ikm, 1),
+                               absl::MakeSpan(prk.data(), prk.size()));
+  if (!status.ok()) return status;
+
+  util::StatusOr<std::unique_ptr<internal::KeyedHmac>> expand =
+      internal::KeyedHmac::New(*md, util::SecretDataAsStringView(prk));
+  if (!expand.ok()) return expand.status();
+  return {absl::WrapUnique(new HkdfPrf(*std::move(expand)))};
+}
+
+util::Status HkdfPrf::ValidateOutputLength(size_t output_length) const {
+  if (output_length > kMaxBlocks * prk_->tag_size()) {
+    return util::Status(
+        absl::StatusCode::kInvalidArgument,
+        absl::StrCat("PRF only supports outputs up to ",
+                     kMaxBlocks * prk_->tag_size(), " bytes, but ",
+                     output_length, " bytes were requested"));
+  }
+  return util::OkStatus();
+}
+
+util::Status HkdfPrf::ComputeInto(absl::string_view input,
+                                  absl::Span<uint8_t> out) const {
+  const size_t block_size = prk_->tag_size();
+  // T(i) = HMAC(PRK, T(i - 1) | info | i), with T(0) empty. Full blocks are
+  // written to `out` directly; only a trailing partial block needs `last`.
+  uint8_t last[EVP_MAX_MD_SIZE];
+  absl::string_view previous;
+  uint8_t counter = 1;
+  util::Status status;
+  for (size_t offset = 0; offset < out.size(); offset += block_size) {
+    const char counter_byte = static_cast<char>(counter++);
+    const absl::string_view inputs[] = {previous, input,
+                                        absl::string_view(&counter_byte, 1)};
+    const size_t remaining = out.size() - offset;
+    if (remaining >= block_size) {
+      status = prk_->Compute(inputs, out.subspan(offset, block_size));
+      if (!status.ok()) break;
+      previous = absl::string_view(
+          reinterpret_cast<const char*>(&out[offset]), block_size);
+    } else {
+      status = prk_->Compute(inputs, absl::MakeSpan(last, block_size));
+      if (!status.ok()) break;
+      std::memcpy(&out[offset], last, remaining);
+    }
+  }
+  OPENSSL_cleanse(last, sizeof(last));
+  return status;
+}
+
+util::StatusOr<std::string> HkdfPrf::Compute(absl::string_view input,
+                                             size_t output_length) const {
+  util::Status status = ValidateOutputLength(output_length);
+  if (!status.ok()) return status;
+
+  std::string output;
+  ResizeStringUninitialized(&output, output_length);
+  status = ComputeInto(
+      input, absl::MakeSpan(reinterpret_cast<uint8_t*>(&output[0]),
+                            output.size()));
+  if (!status.ok()) return status;
+  return output;
+}
+
+util::StatusOr<absl::string_view> HkdfPrf::ComputeWithArena(
+    absl::string_view input, size_t output_length,
+    util::RequestArena* arena) const {
+  util::Status status = ValidateOutputLength(output_length);
+  if (!status.ok()) return status;
+
+  absl::Span<char> output = arena->Allocate(output_length);
+  status = ComputeInto(
+      input, absl::MakeSpan(reinterpret_cast<uint8_t*>(output.data()),
+                            output.size()));
+  if (!status.ok()) return status;
+  return absl::string_view(output.data(), output.size());
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
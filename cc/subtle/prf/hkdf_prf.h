@@ -0,0 +1,80 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef TINK_SUBTLE_PRF_HKDF_PRF_H_
+#define TINK_SUBTLE_PRF_HKDF_PRF_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/internal/fips_utils.h"
+#include "tink/internal/keyed_hmac.h"
+#include "tink/prf/prf_set.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/util/request_arena.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// HKDF (RFC 5869) as a Prf: Compute(input, n) returns the first n bytes of
+// HKDF(secret, salt, info = input). Produces the same output as
+// HkdfStreamingPrf, but runs HKDF-Extract once, at construction, and
+// HKDF-Expand directly into the output buffer.
+class HkdfPrf : public Prf {
+ public:
+  static util::StatusOr<std::unique_ptr<Prf>> New(
+      HashType hash, const util::SecretData& secret, absl::string_view salt);
+
+  util::StatusOr<std::string> Compute(absl::string_view input,
+                                      size_t output_length) const override;
+
+  util::StatusOr<absl::string_view> ComputeWithArena(
+      absl::string_view input, size_t output_length,
+      util::RequestArena* arena) const override;
+
+  static constexpr crypto::tink::internal::FipsCompatibility kFipsStatus =
+      crypto::tink::internal::FipsCompatibility::kNotFips;
+
+ private:
+  // `prk` is the pseudorandom key output by HKDF-Extract.
+  explicit HkdfPrf(std::unique_ptr<internal::KeyedHmac> prk)
+      : prk_(std::move(prk)) {}
+
+  util::Status ValidateOutputLength(size_t output_length) const;
+
+  // Runs HKDF-Expand with info `input` into `out`, where out.size() has been
+  // validated by ValidateOutputLength().
+  util::Status ComputeInto(absl::string_view input,
+                           absl::Span<uint8_t> out) const;
+
+  const std::unique_ptr<internal::KeyedHmac> prk_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_PRF_HKDF_PRF_H_
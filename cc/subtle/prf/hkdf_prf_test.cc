@@ -0,0 +1,183 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/subtle/prf/hkdf_prf.h"
+
+#include <memory>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/status/status.h"
+#include "absl/strings/escaping.h"
+#include "absl/strings/string_view.h"
+#include "tink/config/tink_fips.h"
+#include "tink/prf/prf_set.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/prf/hkdf_streaming_prf.h"
+#include "tink/subtle/prf/prf_set_util.h"
+#include "tink/subtle/random.h"
+#include "tink/util/request_arena.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::IsOkAndHolds;
+using ::crypto::tink::test::StatusIs;
+
+// Test cases 1, 3 and 4 from RFC 5869.
+TEST(HkdfPrfTest, Rfc5869TestVectors) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+
+  struct {
+    HashType hash;
+    std::string ikm;
+    std::string salt;
+    std::string info;
+    std::string okm;
+  } test_vectors[] = {
+      {SHA256, "0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b",
+       "000102030405060708090a0b0c", "f0f1f2f3f4f5f6f7f8f9",
+       "3cb25f25faacd57a90434f64d0362f2a2d2d0a90cf1a5a4c5db02d56ecc4c5bf"
+       "34007208d5b887185865"},
+      {SHA256, "0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b", "", "",
+       "8da4e775a563c18f715f802a063c5a31b8a11f5c5ee1879ec3454e5f3c738d2d"
+       "9d201395faa4b61a96c8"},
+      {SHA1, "0b0b0b0b0b0b0b0b0b0b0b", "000102030405060708090a0b0c",
+       "f0f1f2f3f4f5f6f7f8f9",
+       "085a01ea1b10f36933068b56efa5ad81a4f14b822f5b091568a9cdd4f155fda2"
+       "c22e422478d305f3f896"},
+  };
+  for (const auto& test_vector : test_vectors) {
+    util::StatusOr<std::unique_ptr<Prf>> prf = HkdfPrf::New(
+        test_vector.hash,
+        util::SecretDataFromStringView(absl::HexStringToBytes(test_vector.ikm)),
+        absl::HexStringToBytes(test_vector.salt));
+    ASSERT_THAT(prf, IsOk());
+    std::string okm = absl::HexStringToBytes(test_vector.okm);
+    EXPECT_THAT((*prf)->Compute(absl::HexStringToBytes(test_vector.info),
+                                okm.size()),
+                IsOkAndHolds(okm));
+  }
+}
+
+TEST(HkdfPrfTest, MatchesHkdfStreamingPrf) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+
+  for (HashType hash : {SHA1, SHA256, SHA512}) {
+    util::SecretData secret =
+        util::SecretDataFromStringView(Random::GetRandomBytes(32));
+    std::string salt = Random::GetRandomBytes(16);
+    util::StatusOr<std::unique_ptr<Prf>> prf = HkdfPrf::New(hash, secret, salt);
+    ASSERT_THAT(prf, IsOk());
+    util::StatusOr<std::unique_ptr<StreamingPrf>> streaming_prf =
+        HkdfStreamingPrf::New(hash, secret, salt);
+    ASSERT_THAT(streaming_prf, IsOk());
+    std::unique_ptr<Prf> reference =
+        CreatePrfFromStreamingPrf(*std::move(streaming_prf));
+    // Lengths around block boundaries, up to the maximum for SHA1.
+    for (size_t output_length : {0, 1, 19, 20, 21, 32, 63, 64, 65, 5100}) {
+      std::string input = Random::GetRandomBytes(output_length % 50);
+      util::StatusOr<std::string> expected =
+          reference->Compute(input, output_length);
+      ASSERT_THAT(expected, IsOk());
+      EXPECT_THAT((*prf)->Compute(input, output_length),
+                  IsOkAndHolds(*expected));
+    }
+  }
+}
+
+TEST(HkdfPrfTest, ComputeWithArena) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+
+  util::StatusOr<std::unique_ptr<Prf>> prf = HkdfPrf::New(
+      SHA256, util::SecretDataFromStringView(Random::GetRandomBytes(32)), "");
+  ASSERT_THAT(prf, IsOk());
+  util::RequestArena arena;
+  for (size_t output_length : {1, 32, 100}) {
+    util::StatusOr<absl::string_view> output =
+        (*prf)->ComputeWithArena("input", output_length, &arena);
+    ASSERT_THAT(output, IsOk());
+    EXPECT_THAT((*prf)->Compute("input", output_length),
+                IsOkAndHolds(std::string(*output)));
+  }
+  EXPECT_THAT(
+      (*prf)->ComputeWithArena("input", 255 * 32 + 1, &arena).status(),
+      StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(HkdfPrfTest, OutputTooLong) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+
+  util::StatusOr<std::unique_ptr<Prf>> prf = HkdfPrf::New(
+      SHA256, util::SecretDataFromStringView(Random::GetRandomBytes(32)), "");
+  ASSERT_THAT(prf, IsOk());
+  EXPECT_THAT((*prf)->Compute("input", 255 * 32), IsOk());
+  EXPECT_THAT((*prf)->Compute("input", 255 * 32 + 1).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(HkdfPrfTest, InvalidParameters) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+
+  EXPECT_THAT(
+      HkdfPrf::New(SHA256,
+                   util::SecretDataFromStringView(Random::GetRandomBytes(9)),
+                   "")
+          .status(),
+      StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(
+      HkdfPrf::New(SHA384,
+                   util::SecretDataFromStringView(Random::GetRandomBytes(32)),
+                   "")
+          .status(),
+      StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(HkdfPrfTest, FipsOnly) {
+  if (!IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Only supported in FIPS-only mode";
+  }
+
+  EXPECT_THAT(
+      HkdfPrf::New(SHA256,
+                   util::SecretDataFromStringView(Random::GetRandomBytes(32)),
+                   "")
+          .status(),
+      StatusIs(absl::StatusCode::kInternal));
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
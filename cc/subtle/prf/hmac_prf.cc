@@ -0,0 +1,119 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/subtle/prf/hmac_prf.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "openssl/crypto.h"
+#include "openssl/evp.h"
+#include "tink/internal/fips_utils.h"
+#include "tink/internal/keyed_hmac.h"
+#include "tink/internal/md_util.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/subtle_util.h"
+#include "tink/util/request_arena.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+util::StatusOr<std::unique_ptr<Prf>> HmacPrf::New(
+    HashType hash, const util::SecretData& key_value) {
+  util::Status status = internal::CheckFipsCompatibility<HmacPrf>();
+  if (!status.ok()) return status;
+
+  if (key_value.size() < kMinKeySize) {
+    return util::Status(absl::StatusCode::kInvalidArgument, "invalid key size");
+  }
+  util::StatusOr<const EVP_MD*> md = internal::EvpHashFromHashType(hash);
+  if (!md.ok()) return md.status();
+  util::StatusOr<std::unique_ptr<internal::KeyedHmac>> hmac =
+      internal::KeyedHmac::New(*md, util::SecretDataAsStringView(key_value));
+  if (!hmac.ok()) return hmac.status();
+  return {absl::WrapUnique(new HmacPrf(*std::move(hmac)))};
+}
+
+util::Status HmacPrf::ValidateOutputLength(size_t output_length) const {
+  if (output_length > hmac_->tag_size()) {
+    return util::Status(
+        absl::StatusCode::kInvalidArgument,
+        absl::StrCat("PRF only supports outputs up to ", hmac_->tag_size(),
+                     " bytes, but ", output_length, " bytes were requested"));
+  }
+  return util::OkStatus();
+}
+
+util::Status HmacPrf::ComputeInto(absl::string_view input,
+                                  absl::Span<uint8_t> out) const {
+  if (out.size() == hmac_->tag_size()) {
+    return hmac_->Compute(absl::MakeConstSpan(&input, 1), out);
+  }
+  uint8_t tag[EVP_MAX_MD_SIZE];
+  util::Status status = hmac_->Compute(absl::MakeConstSpan(&input, 1),
+                                       absl::MakeSpan(tag, hmac_->tag_size()));
+  if (status.ok() && !out.empty()) {
+    std::memcpy(out.data(), tag, out.size());
+  }
+  OPENSSL_cleanse(tag, sizeof(tag));
+  return status;
+}
+
+util::StatusOr<std::string> HmacPrf::Compute(absl::string_view input,
+                                             size_t output_length) const {
+  util::Status status = ValidateOutputLength(output_length);
+  if (!status.ok()) return status;
+
+  std::string output;
+  ResizeStringUninitialized(&output, output_length);
+  status = ComputeInto(
+      input, absl::MakeSpan(reinterpret_cast<uint8_t*>(&output[0]),
+                            output.size()));
+  if (!status.ok()) return status;
+  return output;
+}
+
+util::StatusOr<absl::string_view> HmacPrf::ComputeWithArena(
+    absl::string_view input, size_t output_length,
+    util::RequestArena* arena) const {
+  util::Status status = ValidateOutputLength(output_length);
+  if (!status.ok()) return status;
+
+  absl::Span<char> output = arena->Allocate(output_length);
+  status = ComputeInto(
+      input, absl::MakeSpan(reinterpret_cast<uint8_t*>(output.data()),
+                            output.size()));
+  if (!status.ok()) return status;
+  return absl::string_view(output.data(), output.size());
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
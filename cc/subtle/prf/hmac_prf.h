@@ -0,0 +1,82 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef TINK_SUBTLE_PRF_HMAC_PRF_H_
+#define TINK_SUBTLE_PRF_HMAC_PRF_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/internal/fips_utils.h"
+#include "tink/internal/keyed_hmac.h"
+#include "tink/prf/prf_set.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/util/request_arena.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// HMAC (RFC 2104) as a Prf, with output of at most the digest size of the
+// hash function. The key is processed once, at construction; see
+// internal::KeyedHmac.
+class HmacPrf : public Prf {
+ public:
+  // Key must be at least 16 bytes long.
+  static util::StatusOr<std::unique_ptr<Prf>> New(
+      HashType hash, const util::SecretData& key_value);
+
+  util::StatusOr<std::string> Compute(absl::string_view input,
+                                      size_t output_length) const override;
+
+  util::StatusOr<absl::string_view> ComputeWithArena(
+      absl::string_view input, size_t output_length,
+      util::RequestArena* arena) const override;
+
+  static constexpr crypto::tink::internal::FipsCompatibility kFipsStatus =
+      crypto::tink::internal::FipsCompatibility::kRequiresBoringCrypto;
+
+  // Minimum HMAC key size in bytes.
+  static constexpr size_t kMinKeySize = 16;
+
+ private:
+  explicit HmacPrf(std::unique_ptr<internal::KeyedHmac> hmac)
+      : hmac_(std::move(hmac)) {}
+
+  util::Status ValidateOutputLength(size_t output_length) const;
+
+  // Writes the first out.size() bytes of the tag of `input` to `out`, where
+  // out.size() has been validated by ValidateOutputLength().
+  util::Status ComputeInto(absl::string_view input,
+                           absl::Span<uint8_t> out) const;
+
+  const std::unique_ptr<internal::KeyedHmac> hmac_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_PRF_HMAC_PRF_H_
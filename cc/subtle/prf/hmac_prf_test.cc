@@ -0,0 +1,164 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/subtle/prf/hmac_prf.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/strings/escaping.h"
+#include "absl/strings/string_view.h"
+#include "tink/internal/fips_utils.h"
+#include "tink/prf/prf_set.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/prf/prf_set_util.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/stateful_hmac_boringssl.h"
+#include "tink/util/request_arena.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::IsOkAndHolds;
+using ::crypto::tink::test::StatusIs;
+
+// Test case 1 from RFC 4231 and RFC 2202.
+TEST(HmacPrfTest, TestVectors) {
+  if (internal::IsFipsModeEnabled() && !internal::IsFipsEnabledInSsl()) {
+    GTEST_SKIP()
+        << "Test should not run in FIPS mode when BoringCrypto is unavailable.";
+  }
+
+  util::SecretData key = util::SecretDataFromStringView(
+      absl::HexStringToBytes("0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b"));
+  struct {
+    HashType hash;
+    std::string tag;
+  } test_vectors[] = {
+      {SHA1, "b617318655057264e28bc0b6fb378c8ef146be00"},
+      {SHA256,
+       "b0344c61d8db38535ca8afceaf0bf12b881dc200c9833da726e9376c2e32cff7"},
+      {SHA512,
+       "87aa7cdea5ef619d4ff0b4241a1d6cb02379f4e2ce4ec2787ad0b30545e17cde"
+       "daa833b7d6b8a702038b274eaea3f4e4be9d914eeb61f1702e696c203a126854"},
+  };
+  for (const auto& test_vector : test_vectors) {
+    util::StatusOr<std::unique_ptr<Prf>> prf =
+        HmacPrf::New(test_vector.hash, key);
+    ASSERT_THAT(prf, IsOk());
+    std::string tag = absl::HexStringToBytes(test_vector.tag);
+    EXPECT_THAT((*prf)->Compute("Hi There", tag.size()), IsOkAndHolds(tag));
+    EXPECT_THAT((*prf)->Compute("Hi There", 16),
+                IsOkAndHolds(tag.substr(0, 16)));
+  }
+}
+
+TEST(HmacPrfTest, MatchesStatefulHmacPrf) {
+  if (internal::IsFipsModeEnabled() && !internal::IsFipsEnabledInSsl()) {
+    GTEST_SKIP()
+        << "Test should not run in FIPS mode when BoringCrypto is unavailable.";
+  }
+
+  util::SecretData key =
+      util::SecretDataFromStringView(Random::GetRandomBytes(32));
+  util::StatusOr<std::unique_ptr<Prf>> prf = HmacPrf::New(SHA512, key);
+  ASSERT_THAT(prf, IsOk());
+  std::unique_ptr<Prf> reference = CreatePrfFromStatefulMacFactory(
+      absl::make_unique<StatefulHmacBoringSslFactory>(SHA512, 64, key));
+  for (int size = 0; size <= 200; size += 25) {
+    std::string message = Random::GetRandomBytes(size);
+    util::StatusOr<std::string> expected = reference->Compute(message, 64);
+    ASSERT_THAT(expected, IsOk());
+    EXPECT_THAT((*prf)->Compute(message, 64), IsOkAndHolds(*expected));
+  }
+}
+
+TEST(HmacPrfTest, ComputeWithArena) {
+  if (internal::IsFipsModeEnabled() && !internal::IsFipsEnabledInSsl()) {
+    GTEST_SKIP()
+        << "Test should not run in FIPS mode when BoringCrypto is unavailable.";
+  }
+
+  util::StatusOr<std::unique_ptr<Prf>> prf = HmacPrf::New(
+      SHA256, util::SecretDataFromStringView(Random::GetRandomBytes(32)));
+  ASSERT_THAT(prf, IsOk());
+  util::RequestArena arena;
+  for (size_t output_length : {0, 1, 16, 32}) {
+    util::StatusOr<absl::string_view> output =
+        (*prf)->ComputeWithArena("input", output_length, &arena);
+    ASSERT_THAT(output, IsOk());
+    EXPECT_THAT((*prf)->Compute("input", output_length),
+                IsOkAndHolds(std::string(*output)));
+  }
+  EXPECT_THAT((*prf)->ComputeWithArena("input", 33, &arena).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(HmacPrfTest, OutputTooLong) {
+  if (internal::IsFipsModeEnabled() && !internal::IsFipsEnabledInSsl()) {
+    GTEST_SKIP()
+        << "Test should not run in FIPS mode when BoringCrypto is unavailable.";
+  }
+
+  util::StatusOr<std::unique_ptr<Prf>> prf = HmacPrf::New(
+      SHA256, util::SecretDataFromStringView(Random::GetRandomBytes(32)));
+  ASSERT_THAT(prf, IsOk());
+  EXPECT_THAT((*prf)->Compute("input", 33).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(HmacPrfTest, InvalidKeySize) {
+  if (internal::IsFipsModeEnabled() && !internal::IsFipsEnabledInSsl()) {
+    GTEST_SKIP()
+        << "Test should not run in FIPS mode when BoringCrypto is unavailable.";
+  }
+
+  EXPECT_THAT(
+      HmacPrf::New(SHA256,
+                   util::SecretDataFromStringView(Random::GetRandomBytes(15)))
+          .status(),
+      StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(HmacPrfTest, FailsInFipsModeWithoutBoringCrypto) {
+  if (!internal::IsFipsModeEnabled() || internal::IsFipsEnabledInSsl()) {
+    GTEST_SKIP()
+        << "Test assumes kOnlyUseFips but BoringCrypto is unavailable.";
+  }
+
+  EXPECT_THAT(
+      HmacPrf::New(SHA256,
+                   util::SecretDataFromStringView(Random::GetRandomBytes(32)))
+          .status(),
+      StatusIs(absl::StatusCode::kInternal));
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
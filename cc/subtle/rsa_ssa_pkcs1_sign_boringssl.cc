@@ -24,12 +24,14 @@
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
+#include "absl/types/span.h"
 #include "openssl/evp.h"
 #include "openssl/rsa.h"
 #include "tink/internal/bn_util.h"
 #include "tink/internal/err_util.h"
 #include "tink/internal/md_util.h"
 #include "tink/internal/rsa_util.h"
+#include "tink/internal/run_in_parallel.h"
 #include "tink/internal/ssl_unique_ptr.h"
 #include "tink/internal/util.h"
 #include "tink/subtle/subtle_util.h"
@@ -90,14 +92,22 @@ util::StatusOr<std::string> RsaSsaPkcs1SignBoringSsl::Sign(
   if (!digest.ok()) {
     return digest.status();
   }
+  return SignDigest(*digest);
+}
 
+util::StatusOr<std::string> RsaSsaPkcs1SignBoringSsl::SignDigest(
+    absl::string_view digest) const {
+  if (digest.size() != EVP_MD_size(sig_hash_)) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "Invalid digest size.");
+  }
   std::string signature;
   ResizeStringUninitialized(&signature, RSA_size(private_key_.get()));
   unsigned int signature_length = 0;
 
   if (RSA_sign(/*hash_nid=*/EVP_MD_type(sig_hash_),
-               /*digest=*/reinterpret_cast<const uint8_t*>(digest->data()),
-               /*digest_len=*/digest->size(),
+               /*digest=*/reinterpret_cast<const uint8_t*>(digest.data()),
+               /*digest_len=*/digest.size(),
                /*out=*/reinterpret_cast<uint8_t*>(&signature[0]),
                /*out_len=*/&signature_length,
                /*rsa=*/private_key_.get()) != 1) {
@@ -110,6 +120,26 @@ util::StatusOr<std::string> RsaSsaPkcs1SignBoringSsl::Sign(
   return signature;
 }
 
+util::StatusOr<std::vector<std::string>> RsaSsaPkcs1SignBoringSsl::SignBatch(
+    absl::Span<const absl::string_view> data) const {
+  // The private key operation dominates the cost of a signature, and
+  // private_key_ may be used from several threads at once.
+  std::vector<util::StatusOr<std::string>> results(
+      data.size(),
+      util::Status(absl::StatusCode::kInternal, "Signing did not run."));
+  internal::RunInParallel(data.size(),
+                          [&](size_t i) { results[i] = Sign(data[i]); });
+  std::vector<std::string> signatures;
+  signatures.reserve(data.size());
+  for (util::StatusOr<std::string>& result : results) {
+    if (!result.ok()) {
+      return result.status();
+    }
+    signatures.push_back(*std::move(result));
+  }
+  return signatures;
+}
+
 }  // namespace subtle
 }  // namespace tink
 }  // namespace crypto
@@ -17,18 +17,28 @@
 #include "tink/subtle/rsa_ssa_pkcs1_sign_boringssl.h"
 
 #include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "absl/status/status.h"
 #include "absl/strings/escaping.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
 #include "openssl/bn.h"
 #include "openssl/crypto.h"
 #include "openssl/rsa.h"
+#include "include/rapidjson/document.h"
 #include "tink/internal/fips_utils.h"
 #include "tink/internal/rsa_util.h"
 #include "tink/internal/ssl_unique_ptr.h"
+#include "tink/public_key_sign.h"
+#include "tink/public_key_verify.h"
 #include "tink/subtle/rsa_ssa_pkcs1_verify_boringssl.h"
+#include "tink/subtle/wycheproof_util.h"
+#include "tink/util/statusor.h"
 #include "tink/util/test_matchers.h"
 
 namespace crypto {
@@ -37,6 +47,7 @@ namespace subtle {
 namespace {
 
 using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::IsOkAndHolds;
 using ::crypto::tink::test::StatusIs;
 using ::testing::IsEmpty;
 using ::testing::Not;
@@ -97,6 +108,111 @@ TEST_F(RsaPkcs1SignBoringsslTest, EncodesPkcs1WithSeparateHashes) {
               IsOk());
 }
 
+TEST_F(RsaPkcs1SignBoringsslTest, SignBatch) {
+  if (internal::IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Test not run in FIPS-only mode";
+  }
+
+  internal::RsaSsaPkcs1Params params{/*sig_hash=*/HashType::SHA256};
+
+  util::StatusOr<std::unique_ptr<PublicKeySign>> signer =
+      RsaSsaPkcs1SignBoringSsl::New(private_key_, params);
+  ASSERT_THAT(signer, IsOk());
+  util::StatusOr<std::unique_ptr<PublicKeyVerify>> verifier =
+      RsaSsaPkcs1VerifyBoringSsl::New(public_key_, params);
+  ASSERT_THAT(verifier, IsOk());
+
+  std::vector<std::string> messages;
+  for (int i = 0; i < 17; ++i) {
+    messages.push_back(absl::StrCat("message ", i));
+  }
+  messages.push_back("");
+  std::vector<absl::string_view> data(messages.begin(), messages.end());
+  util::StatusOr<std::vector<std::string>> signatures =
+      (*signer)->SignBatch(data);
+  ASSERT_THAT(signatures, IsOk());
+  ASSERT_EQ(signatures->size(), data.size());
+  // PKCS#1 v1.5 signatures are deterministic, so the batch must produce
+  // exactly what Sign() produces.
+  for (int i = 0; i < data.size(); ++i) {
+    EXPECT_THAT((*signer)->Sign(data[i]), IsOkAndHolds((*signatures)[i]));
+    EXPECT_THAT((*verifier)->Verify((*signatures)[i], data[i]), IsOk());
+  }
+}
+
+TEST_F(RsaPkcs1SignBoringsslTest, SignBatchEmpty) {
+  if (internal::IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Test not run in FIPS-only mode";
+  }
+
+  internal::RsaSsaPkcs1Params params{/*sig_hash=*/HashType::SHA256};
+
+  util::StatusOr<std::unique_ptr<PublicKeySign>> signer =
+      RsaSsaPkcs1SignBoringSsl::New(private_key_, params);
+  ASSERT_THAT(signer, IsOk());
+  util::StatusOr<std::vector<std::string>> signatures =
+      (*signer)->SignBatch({});
+  ASSERT_THAT(signatures, IsOk());
+  EXPECT_THAT(*signatures, IsEmpty());
+}
+
+// Signs the messages of each test group in the Wycheproof file `file_name`
+// with one SignBatch() call, using a new key of the group's modulus size and
+// the group's hash function. PKCS #1 v1.5 signatures are deterministic, so
+// each signature must equal the one Sign() computes, and must verify.
+void SignWycheproofMessagesInBatches(absl::string_view file_name) {
+  internal::SslUniquePtr<BIGNUM> rsa_f4(BN_new());
+  ASSERT_TRUE(BN_set_word(rsa_f4.get(), RSA_F4));
+  std::unique_ptr<rapidjson::Document> root =
+      WycheproofUtil::ReadTestVectors(std::string(file_name));
+  for (const rapidjson::Value& test_group : (*root)["testGroups"].GetArray()) {
+    internal::RsaSsaPkcs1Params params{
+        /*hash_type=*/WycheproofUtil::GetHashType(test_group["sha"])};
+    const int modulus_size_in_bits =
+        8 * WycheproofUtil::GetInteger(test_group["n"]).size();
+    internal::RsaPrivateKey private_key;
+    internal::RsaPublicKey public_key;
+    ASSERT_THAT(internal::NewRsaKeyPair(modulus_size_in_bits, rsa_f4.get(),
+                                        &private_key, &public_key),
+                IsOk());
+    util::StatusOr<std::unique_ptr<PublicKeySign>> signer =
+        RsaSsaPkcs1SignBoringSsl::New(private_key, params);
+    ASSERT_THAT(signer, IsOk());
+    util::StatusOr<std::unique_ptr<PublicKeyVerify>> verifier =
+        RsaSsaPkcs1VerifyBoringSsl::New(public_key, params);
+    ASSERT_THAT(verifier, IsOk());
+
+    std::vector<std::string> messages;
+    std::vector<std::string> ids;
+    for (const rapidjson::Value& test : test_group["tests"].GetArray()) {
+      messages.push_back(WycheproofUtil::GetBytes(test["msg"]));
+      ids.push_back(absl::StrCat(test["tcId"].GetInt()));
+    }
+    std::vector<absl::string_view> data(messages.begin(), messages.end());
+    util::StatusOr<std::vector<std::string>> signatures =
+        (*signer)->SignBatch(data);
+    ASSERT_THAT(signatures, IsOk());
+    ASSERT_EQ(signatures->size(), data.size());
+    for (int i = 0; i < data.size(); ++i) {
+      EXPECT_THAT((*signer)->Sign(data[i]), IsOkAndHolds((*signatures)[i]))
+          << file_name << " tcId " << ids[i];
+      EXPECT_THAT((*verifier)->Verify((*signatures)[i], data[i]), IsOk())
+          << file_name << " tcId " << ids[i];
+    }
+  }
+}
+
+TEST_F(RsaPkcs1SignBoringsslTest, SignBatchWycheproofMessages) {
+  if (internal::IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Test not run in FIPS-only mode";
+  }
+  for (absl::string_view file_name : {"rsa_signature_2048_sha256_test.json",
+                                      "rsa_signature_3072_sha512_test.json"}) {
+    SCOPED_TRACE(file_name);
+    SignWycheproofMessagesInBatches(file_name);
+  }
+}
+
 TEST_F(RsaPkcs1SignBoringsslTest, RejectsUnsafeHash) {
   if (internal::IsFipsModeEnabled()) {
     GTEST_SKIP() << "Test not run in FIPS-only mode";
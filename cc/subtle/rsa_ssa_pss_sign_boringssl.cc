@@ -30,6 +30,7 @@
 #include "tink/internal/err_util.h"
 #include "tink/internal/md_util.h"
 #include "tink/internal/rsa_util.h"
+#include "tink/internal/run_in_parallel.h"
 #include "tink/internal/ssl_unique_ptr.h"
 #include "tink/internal/util.h"
 #include "tink/subtle/subtle_util.h"
@@ -146,15 +147,39 @@ util::StatusOr<std::string> RsaSsaPssSignBoringSsl::Sign(
   if (!digest.ok()) {
     return digest.status();
   }
+  return SignDigest(*digest);
+}
 
+util::StatusOr<std::string> RsaSsaPssSignBoringSsl::SignDigest(
+    absl::string_view digest) const {
   util::StatusOr<std::string> signature = SslRsaSsaPssSign(
-      private_key_.get(), *digest, sig_hash_, mgf1_hash_, salt_length_);
+      private_key_.get(), digest, sig_hash_, mgf1_hash_, salt_length_);
   if (!signature.ok()) {
     return util::Status(absl::StatusCode::kInternal, "Signing failed.");
   }
   return signature;
 }
 
+util::StatusOr<std::vector<std::string>> RsaSsaPssSignBoringSsl::SignBatch(
+    absl::Span<const absl::string_view> data) const {
+  // The private key operation dominates the cost of a signature, and
+  // private_key_ may be used from several threads at once.
+  std::vector<util::StatusOr<std::string>> results(
+      data.size(),
+      util::Status(absl::StatusCode::kInternal, "Signing did not run."));
+  internal::RunInParallel(data.size(),
+                          [&](size_t i) { results[i] = Sign(data[i]); });
+  std::vector<std::string> signatures;
+  signatures.reserve(data.size());
+  for (util::StatusOr<std::string>& result : results) {
+    if (!result.ok()) {
+      return result.status();
+    }
+    signatures.push_back(*std::move(result));
+  }
+  return signatures;
+}
+
 }  // namespace subtle
 }  // namespace tink
 }  // namespace crypto
@@ -20,14 +20,17 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "openssl/ec.h"
 #include "openssl/rsa.h"
 #include "tink/internal/fips_utils.h"
 #include "tink/internal/rsa_util.h"
 #include "tink/internal/ssl_unique_ptr.h"
 #include "tink/public_key_sign.h"
+#include "tink/signature/internal/digest_sign.h"
 #include "tink/subtle/common_enums.h"
 #include "tink/util/statusor.h"
 
@@ -38,7 +41,8 @@ namespace subtle {
 // The RSA SSA (Signature Schemes with Appendix) using PSS (Probabilistic
 // Signature Scheme) encoding is defined at
 // https://tools.ietf.org/html/rfc8017#section-8.1).
-class RsaSsaPssSignBoringSsl : public PublicKeySign {
+class RsaSsaPssSignBoringSsl : public PublicKeySign,
+                               public internal::DigestSign {
  public:
   static crypto::tink::util::StatusOr<std::unique_ptr<PublicKeySign>> New(
       const crypto::tink::internal::RsaPrivateKey& private_key,
@@ -49,6 +53,18 @@ class RsaSsaPssSignBoringSsl : public PublicKeySign {
   crypto::tink::util::StatusOr<std::string> Sign(
       absl::string_view data) const override;
 
+  // Signs the elements of 'data', concurrently if enabled with
+  // EnableParallelism() (see config/parallelism.h). Each signature is
+  // computed exactly as by Sign(), including RSA blinding.
+  crypto::tink::util::StatusOr<std::vector<std::string>> SignBatch(
+      absl::Span<const absl::string_view> data) const override;
+
+  const EVP_MD* GetDigestMd() const override { return sig_hash_; }
+
+  // Computes the signature for a message with digest 'digest'.
+  crypto::tink::util::StatusOr<std::string> SignDigest(
+      absl::string_view digest) const override;
+
   static constexpr crypto::tink::internal::FipsCompatibility kFipsStatus =
       crypto::tink::internal::FipsCompatibility::kRequiresBoringCrypto;
 
@@ -22,6 +22,7 @@
 
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
+#include "openssl/crypto.h"
 #include "openssl/evp.h"
 #include "tink/internal/aes_util.h"
 #include "tink/internal/ssl_unique_ptr.h"
@@ -83,6 +84,25 @@ util::StatusOr<std::string> StatefulCmacBoringSsl::Finalize() {
   return std::string(reinterpret_cast<char*>(buf), tag_size_);
 }
 
+util::Status StatefulCmacBoringSsl::FinalizeAndVerify(absl::string_view tag) {
+  if (tag.size() != tag_size_) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "Verification failed.");
+  }
+  uint8_t buf[EVP_MAX_MD_SIZE];
+  size_t out_len;
+
+  if (!CMAC_Final(cmac_context_.get(), buf, &out_len)) {
+    return util::Status(absl::StatusCode::kInternal,
+                        "CMAC finalization failed");
+  }
+  if (CRYPTO_memcmp(buf, tag.data(), tag_size_) != 0) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "Verification failed.");
+  }
+  return util::OkStatus();
+}
+
 StatefulCmacBoringSslFactory::StatefulCmacBoringSslFactory(
     uint32_t tag_size, const util::SecretData& key_value)
     : tag_size_(tag_size), key_value_(key_value) {}
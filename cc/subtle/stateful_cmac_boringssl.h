@@ -42,6 +42,7 @@ class StatefulCmacBoringSsl : public subtle::StatefulMac {
       uint32_t tag_size, const util::SecretData& key_value);
   util::Status Update(absl::string_view data) override;
   util::StatusOr<std::string> Finalize() override;
+  util::Status FinalizeAndVerify(absl::string_view tag) override;
 
  private:
   static constexpr size_t kSmallKeySize = 16;
@@ -55,6 +55,7 @@ constexpr absl::string_view kCmacOnDataSmallTagSizeHex = "c856e183e8dee9bb9940";
 
 using ::crypto::tink::test::IsOk;
 using ::crypto::tink::test::IsOkAndHolds;
+using ::crypto::tink::test::StatusIs;
 using ::testing::Not;
 using ::testing::TestWithParam;
 using ::testing::ValuesIn;
@@ -133,6 +134,29 @@ TEST(StatefulCmacBoringSslTest,
               IsOkAndHolds(absl::HexStringToBytes(kCmacOnDataSmallTagSizeHex)));
 }
 
+TEST(StatefulCmacBoringSslTest, FinalizeAndVerify) {
+  util::SecretData key =
+      util::SecretDataFromStringView(absl::HexStringToBytes(kKeyHex));
+  std::string tag = absl::HexStringToBytes(kCmacOnDataRegularTagSizeHex);
+  std::string modified_tag = tag;
+  modified_tag[3] ^= 0x10;
+  for (absl::string_view wrong_tag :
+       {absl::string_view(modified_tag), absl::string_view(tag).substr(1),
+        absl::string_view()}) {
+    util::StatusOr<std::unique_ptr<StatefulMac>> cmac =
+        StatefulCmacBoringSsl::New(kTagSize, key);
+    ASSERT_THAT(cmac, IsOk());
+    EXPECT_THAT((*cmac)->Update(kData), IsOk());
+    EXPECT_THAT((*cmac)->FinalizeAndVerify(wrong_tag),
+                StatusIs(absl::StatusCode::kInvalidArgument));
+  }
+  util::StatusOr<std::unique_ptr<StatefulMac>> cmac =
+      StatefulCmacBoringSsl::New(kTagSize, key);
+  ASSERT_THAT(cmac, IsOk());
+  EXPECT_THAT((*cmac)->Update(kData), IsOk());
+  EXPECT_THAT((*cmac)->FinalizeAndVerify(tag), IsOk());
+}
+
 TEST(StatefulCmacFactoryTest, FactoryGeneratesValidInstances) {
   auto factory = absl::make_unique<StatefulCmacBoringSslFactory>(
       kTagSize,
@@ -22,6 +22,7 @@
 
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
+#include "openssl/crypto.h"
 #include "openssl/evp.h"
 #include "tink/internal/md_util.h"
 #include "tink/internal/ssl_unique_ptr.h"
@@ -85,6 +86,25 @@ util::StatusOr<std::string> StatefulHmacBoringSsl::Finalize() {
   return std::string(reinterpret_cast<char*>(buf), tag_size_);
 }
 
+util::Status StatefulHmacBoringSsl::FinalizeAndVerify(absl::string_view tag) {
+  if (tag.size() != tag_size_) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "Verification failed.");
+  }
+  uint8_t buf[EVP_MAX_MD_SIZE];
+  unsigned int out_len;
+
+  if (!HMAC_Final(hmac_context_.get(), buf, &out_len)) {
+    return util::Status(absl::StatusCode::kInternal,
+                        "HMAC finalization failed");
+  }
+  if (CRYPTO_memcmp(buf, tag.data(), tag_size_) != 0) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "Verification failed.");
+  }
+  return util::OkStatus();
+}
+
 StatefulHmacBoringSslFactory::StatefulHmacBoringSslFactory(
     HashType hash_type, uint32_t tag_size, const util::SecretData& key_value)
     : hash_type_(hash_type), tag_size_(tag_size), key_value_(key_value) {}
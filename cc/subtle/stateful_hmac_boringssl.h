@@ -41,6 +41,7 @@ class StatefulHmacBoringSsl : public subtle::StatefulMac {
       HashType hash_type, uint32_t tag_size, const util::SecretData& key_value);
   util::Status Update(absl::string_view data) override;
   util::StatusOr<std::string> Finalize() override;
+  util::Status FinalizeAndVerify(absl::string_view tag) override;
 
  private:
   // Minimum HMAC key size in bytes.
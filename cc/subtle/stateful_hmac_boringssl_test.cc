@@ -164,6 +164,32 @@ TEST(StatefulHmacBoringSslTest, testMultipleUpdates) {
                      data4, expected_512_small);
 }
 
+TEST(StatefulHmacBoringSslTest, FinalizeAndVerify) {
+  util::SecretData key = util::SecretDataFromStringView(
+      test::HexDecodeOrDie("000102030405060708090a0b0c0d0e0f"));
+  std::string data = "Some data to test.";
+  std::string tag(test::HexDecodeOrDie("1d6eb74bc283f7947e92c72bd985ce6e"));
+
+  auto hmac_result = StatefulHmacBoringSsl::New(HashType::SHA256, kTagSize, key);
+  ASSERT_THAT(hmac_result, IsOk());
+  EXPECT_THAT((*hmac_result)->Update(data), IsOk());
+  EXPECT_THAT((*hmac_result)->FinalizeAndVerify(tag), IsOk());
+
+  std::string modified_tag = tag;
+  modified_tag[0] ^= 0x01;
+  hmac_result = StatefulHmacBoringSsl::New(HashType::SHA256, kTagSize, key);
+  ASSERT_THAT(hmac_result, IsOk());
+  EXPECT_THAT((*hmac_result)->Update(data), IsOk());
+  EXPECT_THAT((*hmac_result)->FinalizeAndVerify(modified_tag),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+
+  hmac_result = StatefulHmacBoringSsl::New(HashType::SHA256, kTagSize, key);
+  ASSERT_THAT(hmac_result, IsOk());
+  EXPECT_THAT((*hmac_result)->Update(data), IsOk());
+  EXPECT_THAT((*hmac_result)->FinalizeAndVerify(tag.substr(0, kSmallTagSize)),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
 TEST(StatefulHmacBoringSslTest, testInvalidKeySizes) {
   size_t tag_size = 16;
 
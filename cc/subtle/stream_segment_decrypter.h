@@ -20,6 +20,7 @@
 #include <cstdint>
 #include <vector>
 
+#include "absl/types/span.h"
 #include "tink/util/status.h"
 
 namespace crypto {
@@ -50,6 +51,21 @@ class StreamSegmentDecrypter {
       bool is_last_segment,
       std::vector<uint8_t>* plaintext_buffer) = 0;
 
+  // Authenticates 'ciphertext' as the segment with number 'segment_number'
+  // without producing the plaintext. Returns OK if and only if DecryptSegment()
+  // would succeed on the same arguments. Like DecryptSegment(), this may be
+  // called concurrently once Init() succeeded.
+  // The default implementation decrypts into a scratch buffer; decrypters whose
+  // tag can be checked without running the cipher override it.
+  virtual util::Status VerifySegment(absl::Span<const uint8_t> ciphertext,
+                                     int64_t segment_number,
+                                     bool is_last_segment) {
+    std::vector<uint8_t> plaintext;
+    return DecryptSegment(
+        std::vector<uint8_t>(ciphertext.begin(), ciphertext.end()),
+        segment_number, is_last_segment, &plaintext);
+  }
+
   // Initializes this decrypter, using the information from 'header',
   // which must be of size exactly get_header_size().
   virtual util::Status Init(const std::vector<uint8_t>& header) = 0;
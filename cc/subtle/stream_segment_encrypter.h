@@ -20,6 +20,7 @@
 #include <cstdint>
 #include <vector>
 
+#include "absl/status/status.h"
 #include "tink/util/status.h"
 
 namespace crypto {
@@ -76,6 +77,18 @@ class StreamSegmentEncrypter {
       bool is_last_segment,
       std::vector<uint8_t>* ciphertext_buffer) = 0;
 
+  // Like EncryptSegment(), but reads the 'plaintext_size' bytes of plaintext
+  // from the file descriptor 'plaintext_fd', starting at its current offset.
+  // This lets implementations backed by the kernel move the plaintext without
+  // copying it through user space. Implementations that do not support this
+  // return an UNIMPLEMENTED error without reading from 'plaintext_fd'.
+  virtual util::Status EncryptSegmentFromFile(
+      int plaintext_fd, int plaintext_size, bool is_last_segment,
+      std::vector<uint8_t>* ciphertext_buffer) {
+    return util::Status(absl::StatusCode::kUnimplemented,
+                        "Encrypting from a file is not supported");
+  }
+
   // Returns the header of the ciphertext stream.
   virtual const std::vector<uint8_t>& get_header() const = 0;
 
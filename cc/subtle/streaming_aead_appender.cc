@@ -0,0 +1,154 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/subtle/streaming_aead_appender.h"
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "tink/output_stream.h"
+#include "tink/random_access_stream.h"
+#include "tink/streaming_aead.h"
+#include "tink/subtle/stream_segment_decrypter.h"
+#include "tink/subtle/stream_segment_encrypter.h"
+#include "tink/subtle/streaming_aead_encrypting_stream.h"
+#include "tink/util/buffer.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+namespace {
+
+// Reads exactly 'count' bytes at 'position' of 'source' into 'buffer'.
+util::Status ReadExactly(RandomAccessStream* source, int64_t position,
+                         int count, util::Buffer* buffer) {
+  util::Status status = source->PRead(position, count, buffer);
+  // Reading up to the end of the stream may report OUT_OF_RANGE.
+  if (status.code() == absl::StatusCode::kOutOfRange &&
+      buffer->size() == count) {
+    return util::OkStatus();
+  }
+  if (status.code() == absl::StatusCode::kOutOfRange) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "ciphertext stream is too short");
+  }
+  return status;
+}
+
+std::vector<uint8_t> ToVector(const util::Buffer& buffer) {
+  return std::vector<uint8_t>(buffer.get_mem_block(),
+                              buffer.get_mem_block() + buffer.size());
+}
+
+}  // namespace
+
+// static
+util::StatusOr<std::unique_ptr<StreamingAead::Appender>>
+StreamingAeadAppender::New(
+    std::unique_ptr<StreamSegmentDecrypter> segment_decrypter,
+    std::unique_ptr<RandomAccessStream> ciphertext_source,
+    SegmentEncrypterFactory new_segment_encrypter) {
+  if (segment_decrypter == nullptr) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "segment_decrypter must be non-null");
+  }
+  if (ciphertext_source == nullptr) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "ciphertext_source must be non-null");
+  }
+  const int header_size = segment_decrypter->get_header_size();
+  const int ct_offset = segment_decrypter->get_ciphertext_offset();
+  const int ct_segment_size = segment_decrypter->get_ciphertext_segment_size();
+  const int pt_segment_size = segment_decrypter->get_plaintext_segment_size();
+  const int first_segment_start = ct_offset + header_size;
+  if (ct_offset < 0 || first_segment_start >= pt_segment_size) {
+    return util::Status(absl::StatusCode::kInternal,
+                        "Size of the first segment must be greater than 0.");
+  }
+
+  util::StatusOr<std::unique_ptr<util::Buffer>> buffer =
+      util::Buffer::New(ct_segment_size);
+  if (!buffer.ok()) return buffer.status();
+  util::Status status = ReadExactly(ciphertext_source.get(), ct_offset,
+                                    header_size, buffer->get());
+  if (!status.ok()) return status;
+  std::vector<uint8_t> header = ToVector(**buffer);
+  status = segment_decrypter->Init(header);
+  if (!status.ok()) return status;
+
+  // Segment 0 starts after the header, segment i > 0 at i * ct_segment_size.
+  // Only the last segment may be shorter than a full segment.
+  util::StatusOr<int64_t> ct_size = ciphertext_source->size();
+  if (!ct_size.ok()) return ct_size.status();
+  const int64_t last_segment_number =
+      *ct_size <= ct_segment_size ? 0 : (*ct_size - 1) / ct_segment_size;
+  if (last_segment_number > std::numeric_limits<uint32_t>::max()) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "too many segments");
+  }
+  const int64_t last_segment_start =
+      last_segment_number == 0 ? first_segment_start
+                               : last_segment_number * ct_segment_size;
+  if (*ct_size - last_segment_start < ct_segment_size - pt_segment_size) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "ciphertext stream is too short");
+  }
+  status = ReadExactly(ciphertext_source.get(), last_segment_start,
+                       *ct_size - last_segment_start, buffer->get());
+  if (!status.ok()) return status;
+  std::vector<uint8_t> last_segment_plaintext;
+  status = segment_decrypter->DecryptSegment(
+      ToVector(**buffer), last_segment_number, /*is_last_segment=*/true,
+      &last_segment_plaintext);
+  if (!status.ok()) return status;
+
+  util::StatusOr<std::unique_ptr<StreamSegmentEncrypter>> segment_encrypter =
+      new_segment_encrypter(header, last_segment_number);
+  if (!segment_encrypter.ok()) return segment_encrypter.status();
+  const int last_segment_capacity =
+      last_segment_number == 0 ? pt_segment_size - first_segment_start
+                               : pt_segment_size;
+  const int64_t min_append_size =
+      last_segment_capacity - last_segment_plaintext.size() + 1;
+  return {absl::WrapUnique(new StreamingAeadAppender(
+      *std::move(segment_encrypter), std::move(last_segment_plaintext),
+      last_segment_start, min_append_size))};
+}
+
+util::StatusOr<std::unique_ptr<OutputStream>>
+StreamingAeadAppender::NewAppendingStream(
+    std::unique_ptr<OutputStream> ciphertext_destination) {
+  if (segment_encrypter_ == nullptr) {
+    return util::Status(absl::StatusCode::kFailedPrecondition,
+                        "NewAppendingStream() was already called");
+  }
+  return StreamingAeadEncryptingStream::NewForAppend(
+      std::move(segment_encrypter_), std::move(last_segment_plaintext_),
+      std::move(ciphertext_destination));
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,88 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef TINK_SUBTLE_STREAMING_AEAD_APPENDER_H_
+#define TINK_SUBTLE_STREAMING_AEAD_APPENDER_H_
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/functional/function_ref.h"
+#include "tink/output_stream.h"
+#include "tink/random_access_stream.h"
+#include "tink/streaming_aead.h"
+#include "tink/subtle/stream_segment_decrypter.h"
+#include "tink/subtle/stream_segment_encrypter.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// Appender for segment-based ciphertext streams: reads and authenticates the
+// last segment of the existing stream, and continues the stream with a
+// StreamingAeadEncryptingStream that re-encrypts that segment.
+class StreamingAeadAppender : public StreamingAead::Appender {
+ public:
+  // Returns a segment encrypter that continues a ciphertext stream with
+  // header 'header', starting at segment 'first_segment_number'.
+  using SegmentEncrypterFactory =
+      absl::FunctionRef<util::StatusOr<std::unique_ptr<StreamSegmentEncrypter>>(
+          const std::vector<uint8_t>& header, int64_t first_segment_number)>;
+
+  // Reads the header and the last segment of 'ciphertext_source', decrypts
+  // the last segment with 'segment_decrypter', and gets the segment encrypter
+  // for the appended segments from 'new_segment_encrypter'.
+  // 'ciphertext_source' is not used after this returns.
+  static crypto::tink::util::StatusOr<std::unique_ptr<StreamingAead::Appender>>
+  New(std::unique_ptr<StreamSegmentDecrypter> segment_decrypter,
+      std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source,
+      SegmentEncrypterFactory new_segment_encrypter);
+
+  int64_t ciphertext_rewrite_offset() const override {
+    return rewrite_offset_;
+  }
+  int64_t min_append_size() const override { return min_append_size_; }
+
+  crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::OutputStream>>
+  NewAppendingStream(std::unique_ptr<crypto::tink::OutputStream>
+                         ciphertext_destination) override;
+
+ private:
+  StreamingAeadAppender(
+      std::unique_ptr<StreamSegmentEncrypter> segment_encrypter,
+      std::vector<uint8_t> last_segment_plaintext, int64_t rewrite_offset,
+      int64_t min_append_size)
+      : segment_encrypter_(std::move(segment_encrypter)),
+        last_segment_plaintext_(std::move(last_segment_plaintext)),
+        rewrite_offset_(rewrite_offset),
+        min_append_size_(min_append_size) {}
+
+  // Reset once NewAppendingStream() was called.
+  std::unique_ptr<StreamSegmentEncrypter> segment_encrypter_;
+  std::vector<uint8_t> last_segment_plaintext_;
+  const int64_t rewrite_offset_;
+  const int64_t min_append_size_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_STREAMING_AEAD_APPENDER_H_
@@ -0,0 +1,321 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/subtle/streaming_aead_appender.h"
+
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "tink/config/tink_fips.h"
+#include "tink/internal/test_random_access_stream.h"
+#include "tink/output_stream.h"
+#include "tink/random_access_stream.h"
+#include "tink/streaming_aead.h"
+#include "tink/subtle/aes_gcm_hkdf_streaming.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/streaming_aead_test_util.h"
+#include "tink/subtle/test_util.h"
+#include "tink/util/ostream_output_stream.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+using ::crypto::tink::internal::ReadAllFromRandomAccessStream;
+using ::crypto::tink::internal::TestRandomAccessStream;
+using ::crypto::tink::subtle::test::WriteToStream;
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::IsOkAndHolds;
+using ::crypto::tink::test::StatusIs;
+using ::testing::Eq;
+using ::testing::IsEmpty;
+using ::testing::Not;
+
+constexpr int kCiphertextSegmentSize = 128;
+constexpr int kCiphertextOffset = 8;
+// With a 16-byte derived key, the header has 24 bytes and every segment a
+// 16-byte tag.
+constexpr int kFirstSegmentSize = 128 - 16 - kCiphertextOffset - 24;
+constexpr int kSegmentSize = 128 - 16;
+constexpr absl::string_view kAssociatedData = "associated data";
+
+std::unique_ptr<AesGcmHkdfStreaming> NewStreamingAead() {
+  AesGcmHkdfStreaming::Params params;
+  params.ikm = Random::GetRandomKeyBytes(16);
+  params.hkdf_hash = SHA256;
+  params.derived_key_size = 16;
+  params.ciphertext_segment_size = kCiphertextSegmentSize;
+  params.ciphertext_offset = kCiphertextOffset;
+  util::StatusOr<std::unique_ptr<AesGcmHkdfStreaming>> streaming_aead =
+      AesGcmHkdfStreaming::New(std::move(params));
+  EXPECT_THAT(streaming_aead, IsOk());
+  return *std::move(streaming_aead);
+}
+
+util::StatusOr<std::unique_ptr<StreamingAead::Appender>> NewAppender(
+    const StreamingAead& streaming_aead, const std::string& ciphertext) {
+  return streaming_aead.NewAppender(
+      absl::make_unique<TestRandomAccessStream>(ciphertext), kAssociatedData);
+}
+
+std::unique_ptr<OutputStream> NewStringStream(std::stringbuf* buffer) {
+  return absl::make_unique<util::OstreamOutputStream>(
+      absl::make_unique<std::ostream>(buffer));
+}
+
+// Appends 'plaintext' to 'ciphertext' and returns the resulting ciphertext.
+util::StatusOr<std::string> Append(const StreamingAead& streaming_aead,
+                                   const std::string& ciphertext,
+                                   absl::string_view plaintext) {
+  util::StatusOr<std::unique_ptr<StreamingAead::Appender>> appender =
+      NewAppender(streaming_aead, ciphertext);
+  if (!appender.ok()) return appender.status();
+  std::stringbuf tail;
+  util::StatusOr<std::unique_ptr<OutputStream>> stream =
+      (*appender)->NewAppendingStream(NewStringStream(&tail));
+  if (!stream.ok()) return stream.status();
+  util::Status status = WriteToStream(stream->get(), plaintext);
+  if (!status.ok()) return status;
+  return absl::StrCat(
+      ciphertext.substr(0, (*appender)->ciphertext_rewrite_offset()),
+      tail.str());
+}
+
+util::StatusOr<std::string> Decrypt(const StreamingAead& streaming_aead,
+                                    const std::string& ciphertext) {
+  util::StatusOr<std::unique_ptr<RandomAccessStream>> stream =
+      streaming_aead.NewDecryptingRandomAccessStream(
+          absl::make_unique<TestRandomAccessStream>(ciphertext),
+          kAssociatedData);
+  if (!stream.ok()) return stream.status();
+  std::string plaintext;
+  util::Status status = ReadAllFromRandomAccessStream(stream->get(), plaintext);
+  if (status.code() != absl::StatusCode::kOutOfRange) return status;
+  return plaintext;
+}
+
+TEST(StreamingAeadAppenderTest, AppendsToExistingCiphertext) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  std::unique_ptr<AesGcmHkdfStreaming> streaming_aead = NewStreamingAead();
+  for (int initial_size :
+       {0, 1, kFirstSegmentSize - 1, kFirstSegmentSize, kFirstSegmentSize + 1,
+        kFirstSegmentSize + 2 * kSegmentSize,
+        kFirstSegmentSize + 2 * kSegmentSize + 50}) {
+    for (int extra_size : {0, 1, 200}) {
+      SCOPED_TRACE(absl::StrCat("initial_size = ", initial_size,
+                                ", extra_size = ", extra_size));
+      std::string initial = Random::GetRandomBytes(initial_size);
+      util::StatusOr<std::string> ciphertext = EncryptToString(
+          streaming_aead.get(), initial, kAssociatedData, kCiphertextOffset);
+      ASSERT_THAT(ciphertext, IsOk());
+      util::StatusOr<std::unique_ptr<StreamingAead::Appender>> appender =
+          NewAppender(*streaming_aead, *ciphertext);
+      ASSERT_THAT(appender, IsOk());
+
+      std::string appended = Random::GetRandomBytes(
+          (*appender)->min_append_size() + extra_size);
+      util::StatusOr<std::string> result =
+          Append(*streaming_aead, *ciphertext, appended);
+      ASSERT_THAT(result, IsOk());
+      EXPECT_THAT(Decrypt(*streaming_aead, *result),
+                  IsOkAndHolds(initial + appended));
+      EXPECT_THAT(streaming_aead->VerifyCiphertext(
+                      absl::make_unique<TestRandomAccessStream>(*result),
+                      kAssociatedData, /*first_invalid_segment=*/nullptr),
+                  IsOk());
+      // The ciphertext before the last segment is kept.
+      int64_t offset = (*appender)->ciphertext_rewrite_offset();
+      EXPECT_EQ(result->substr(0, offset), ciphertext->substr(0, offset));
+    }
+  }
+}
+
+TEST(StreamingAeadAppenderTest, RewriteOffsetAndMinAppendSize) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  std::unique_ptr<AesGcmHkdfStreaming> streaming_aead = NewStreamingAead();
+  util::StatusOr<std::string> ciphertext = EncryptToString(
+      streaming_aead.get(), Random::GetRandomBytes(10), kAssociatedData,
+      kCiphertextOffset);
+  ASSERT_THAT(ciphertext, IsOk());
+  util::StatusOr<std::unique_ptr<StreamingAead::Appender>> appender =
+      NewAppender(*streaming_aead, *ciphertext);
+  ASSERT_THAT(appender, IsOk());
+  EXPECT_EQ((*appender)->ciphertext_rewrite_offset(), kCiphertextOffset + 24);
+  EXPECT_EQ((*appender)->min_append_size(), kFirstSegmentSize - 10 + 1);
+
+  ciphertext = EncryptToString(
+      streaming_aead.get(),
+      Random::GetRandomBytes(kFirstSegmentSize + kSegmentSize + 10),
+      kAssociatedData, kCiphertextOffset);
+  ASSERT_THAT(ciphertext, IsOk());
+  appender = NewAppender(*streaming_aead, *ciphertext);
+  ASSERT_THAT(appender, IsOk());
+  EXPECT_EQ((*appender)->ciphertext_rewrite_offset(),
+            2 * kCiphertextSegmentSize);
+  EXPECT_EQ((*appender)->min_append_size(), kSegmentSize - 10 + 1);
+}
+
+TEST(StreamingAeadAppenderTest, RepeatedAppends) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  std::unique_ptr<AesGcmHkdfStreaming> streaming_aead = NewStreamingAead();
+  std::string plaintext = Random::GetRandomBytes(30);
+  util::StatusOr<std::string> ciphertext = EncryptToString(
+      streaming_aead.get(), plaintext, kAssociatedData, kCiphertextOffset);
+  ASSERT_THAT(ciphertext, IsOk());
+  for (int i = 0; i < 10; ++i) {
+    util::StatusOr<std::unique_ptr<StreamingAead::Appender>> appender =
+        NewAppender(*streaming_aead, *ciphertext);
+    ASSERT_THAT(appender, IsOk());
+    std::string appended =
+        Random::GetRandomBytes((*appender)->min_append_size() + 17 * i);
+    ciphertext = Append(*streaming_aead, *ciphertext, appended);
+    ASSERT_THAT(ciphertext, IsOk());
+    plaintext += appended;
+  }
+  EXPECT_THAT(Decrypt(*streaming_aead, *ciphertext), IsOkAndHolds(plaintext));
+}
+
+TEST(StreamingAeadAppenderTest, ShortAppendFailsWithoutWriting) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  std::unique_ptr<AesGcmHkdfStreaming> streaming_aead = NewStreamingAead();
+  util::StatusOr<std::string> ciphertext = EncryptToString(
+      streaming_aead.get(), Random::GetRandomBytes(kFirstSegmentSize + 5),
+      kAssociatedData, kCiphertextOffset);
+  ASSERT_THAT(ciphertext, IsOk());
+  util::StatusOr<std::unique_ptr<StreamingAead::Appender>> appender =
+      NewAppender(*streaming_aead, *ciphertext);
+  ASSERT_THAT(appender, IsOk());
+
+  std::stringbuf tail;
+  util::StatusOr<std::unique_ptr<OutputStream>> stream =
+      (*appender)->NewAppendingStream(NewStringStream(&tail));
+  ASSERT_THAT(stream, IsOk());
+  EXPECT_THAT(
+      WriteToStream(stream->get(), Random::GetRandomBytes(
+                                       (*appender)->min_append_size() - 1)),
+      StatusIs(absl::StatusCode::kFailedPrecondition));
+  EXPECT_THAT(tail.str(), IsEmpty());
+}
+
+TEST(StreamingAeadAppenderTest, EmptyAppendWritesNothing) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  std::unique_ptr<AesGcmHkdfStreaming> streaming_aead = NewStreamingAead();
+  util::StatusOr<std::string> ciphertext = EncryptToString(
+      streaming_aead.get(), Random::GetRandomBytes(300), kAssociatedData,
+      kCiphertextOffset);
+  ASSERT_THAT(ciphertext, IsOk());
+  util::StatusOr<std::unique_ptr<StreamingAead::Appender>> appender =
+      NewAppender(*streaming_aead, *ciphertext);
+  ASSERT_THAT(appender, IsOk());
+
+  std::stringbuf tail;
+  util::StatusOr<std::unique_ptr<OutputStream>> stream =
+      (*appender)->NewAppendingStream(NewStringStream(&tail));
+  ASSERT_THAT(stream, IsOk());
+  EXPECT_THAT(WriteToStream(stream->get(), ""), IsOk());
+  EXPECT_THAT(tail.str(), IsEmpty());
+}
+
+TEST(StreamingAeadAppenderTest, NewAppendingStreamCanOnlyBeCalledOnce) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  std::unique_ptr<AesGcmHkdfStreaming> streaming_aead = NewStreamingAead();
+  util::StatusOr<std::string> ciphertext = EncryptToString(
+      streaming_aead.get(), "plaintext", kAssociatedData, kCiphertextOffset);
+  ASSERT_THAT(ciphertext, IsOk());
+  util::StatusOr<std::unique_ptr<StreamingAead::Appender>> appender =
+      NewAppender(*streaming_aead, *ciphertext);
+  ASSERT_THAT(appender, IsOk());
+
+  std::stringbuf tail;
+  EXPECT_THAT(
+      (*appender)->NewAppendingStream(NewStringStream(&tail)).status(),
+      IsOk());
+  EXPECT_THAT(
+      (*appender)->NewAppendingStream(NewStringStream(&tail)).status(),
+      StatusIs(absl::StatusCode::kFailedPrecondition));
+}
+
+TEST(StreamingAeadAppenderTest, RejectsInvalidCiphertext) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  std::unique_ptr<AesGcmHkdfStreaming> streaming_aead = NewStreamingAead();
+  util::StatusOr<std::string> ciphertext = EncryptToString(
+      streaming_aead.get(), Random::GetRandomBytes(300), kAssociatedData,
+      kCiphertextOffset);
+  ASSERT_THAT(ciphertext, IsOk());
+
+  // Modified last segment.
+  std::string modified = *ciphertext;
+  modified.back() ^= 1;
+  EXPECT_THAT(NewAppender(*streaming_aead, modified).status(), Not(IsOk()));
+
+  // Truncated ciphertext: the remaining last segment is not marked as last.
+  EXPECT_THAT(NewAppender(*streaming_aead,
+                          ciphertext->substr(0, kCiphertextSegmentSize))
+                  .status(),
+              Not(IsOk()));
+  EXPECT_THAT(NewAppender(*streaming_aead,
+                          ciphertext->substr(0, kCiphertextOffset + 24 + 15))
+                  .status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(NewAppender(*streaming_aead, ciphertext->substr(0, 10)).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+
+  // Wrong associated data.
+  EXPECT_THAT(streaming_aead
+                  ->NewAppender(
+                      absl::make_unique<TestRandomAccessStream>(*ciphertext),
+                      "wrong associated data")
+                  .status(),
+              Not(IsOk()));
+
+  // Wrong key.
+  EXPECT_THAT(NewAppender(*NewStreamingAead(), *ciphertext).status(),
+              Not(IsOk()));
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -17,6 +17,7 @@
 #include "tink/subtle/streaming_aead_encrypting_stream.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <cstring>
 #include <memory>
 #include <utility>
@@ -97,6 +98,56 @@ StatusOr<std::unique_ptr<OutputStream>> StreamingAeadEncryptingStream::New(
   enc_stream->is_first_segment_ = true;
   enc_stream->count_backedup_ = first_segment_size;
   enc_stream->pt_buffer_offset_ = 0;
+  enc_stream->is_append_ = false;
+  enc_stream->min_last_segment_number_ = 0;
+  enc_stream->status_ = util::OkStatus();
+  return {std::move(enc_stream)};
+}
+
+// static
+StatusOr<std::unique_ptr<OutputStream>>
+StreamingAeadEncryptingStream::NewForAppend(
+    std::unique_ptr<StreamSegmentEncrypter> segment_encrypter,
+    std::vector<uint8_t> last_segment_plaintext,
+    std::unique_ptr<OutputStream> ciphertext_destination) {
+  if (segment_encrypter == nullptr) {
+    return Status(absl::StatusCode::kInvalidArgument,
+                  "segment_encrypter must be non-null");
+  }
+  if (ciphertext_destination == nullptr) {
+    return Status(absl::StatusCode::kInvalidArgument,
+                  "cipertext_destination must be non-null");
+  }
+  const int64_t last_segment_number = segment_encrypter->get_segment_number();
+  int segment_size = segment_encrypter->get_plaintext_segment_size();
+  if (last_segment_number == 0) {
+    segment_size -= segment_encrypter->get_ciphertext_offset() +
+                    segment_encrypter->get_header().size();
+  }
+  if (segment_size <= 0) {
+    return Status(absl::StatusCode::kInternal,
+                  "Size of the first segment must be greater than 0.");
+  }
+  if (last_segment_plaintext.size() > segment_size) {
+    return Status(absl::StatusCode::kInvalidArgument,
+                  "last_segment_plaintext is longer than a segment");
+  }
+  std::unique_ptr<StreamingAeadEncryptingStream> enc_stream(
+      new StreamingAeadEncryptingStream());
+  enc_stream->segment_encrypter_ = std::move(segment_encrypter);
+  enc_stream->ct_destination_ = std::move(ciphertext_destination);
+  // The existing plaintext of the last segment is kept at the start of
+  // pt_buffer_, and the rest of pt_buffer_ is handed out as backed-up space.
+  const int last_segment_size = last_segment_plaintext.size();
+  enc_stream->pt_buffer_ = std::move(last_segment_plaintext);
+  enc_stream->pt_buffer_.resize(segment_size);
+  enc_stream->pt_to_encrypt_.resize(0);
+  enc_stream->position_ = 0;
+  enc_stream->is_first_segment_ = false;
+  enc_stream->count_backedup_ = segment_size - last_segment_size;
+  enc_stream->pt_buffer_offset_ = last_segment_size;
+  enc_stream->is_append_ = true;
+  enc_stream->min_last_segment_number_ = last_segment_number + 1;
   enc_stream->status_ = util::OkStatus();
   return {std::move(enc_stream)};
 }
@@ -161,6 +212,11 @@ void StreamingAeadEncryptingStream::BackUp(int count) {
 
 Status StreamingAeadEncryptingStream::Close() {
   if (!status_.ok()) return status_;
+  if (is_append_ && position_ == 0) {
+    // Nothing was appended, so the existing ciphertext is left unchanged.
+    status_ = Status(absl::StatusCode::kFailedPrecondition, "Stream closed");
+    return ct_destination_->Close();
+  }
   if (is_first_segment_) {  // Next() was never called.
     status_ =
         WriteToStream(segment_encrypter_->get_header(), ct_destination_.get());
@@ -175,7 +231,19 @@ Status StreamingAeadEncryptingStream::Close() {
     pt_buffer_.resize(pt_buffer_.size() - count_backedup_);
     pt_last_segment = &pt_buffer_;
   }
-  if (pt_last_segment != &pt_to_encrypt_ && (!pt_to_encrypt_.empty())) {
+  bool encrypt_pt_to_encrypt =
+      pt_last_segment != &pt_to_encrypt_ && (!pt_to_encrypt_.empty());
+  int64_t last_segment_number = segment_encrypter_->get_segment_number();
+  if (encrypt_pt_to_encrypt) ++last_segment_number;
+  if (last_segment_number < min_last_segment_number_) {
+    // Only possible when appending: nothing has been written yet.
+    status_ = Status(absl::StatusCode::kFailedPrecondition,
+                     "Appended plaintext must extend the stream to a new "
+                     "segment");
+    ct_destination_->Close().IgnoreError();
+    return status_;
+  }
+  if (encrypt_pt_to_encrypt) {
     // Before writing the last segment we must encrypt pt_to_encrypt_.
     status_ = segment_encrypter_->EncryptSegment(
         pt_to_encrypt_, /* is_last_segment = */ false, &ct_buffer_);
@@ -17,6 +17,7 @@
 #ifndef TINK_SUBTLE_STREAMING_AEAD_ENCRYPTING_STREAM_H_
 #define TINK_SUBTLE_STREAMING_AEAD_ENCRYPTING_STREAM_H_
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -40,6 +41,22 @@ class StreamingAeadEncryptingStream : public OutputStream {
       New(std::unique_ptr<StreamSegmentEncrypter> segment_encrypter,
           std::unique_ptr<crypto::tink::OutputStream> ciphertext_destination);
 
+  // Like New(), but continues an existing ciphertext stream whose last
+  // segment has plaintext 'last_segment_plaintext'. 'segment_encrypter' must
+  // use the header of the existing stream and start at the number of its last
+  // segment. The returned stream does not write a header: it writes the
+  // re-encrypted last segment followed by the new segments, so
+  // 'ciphertext_destination' must start where the last segment starts.
+  // Close() fails if the appended plaintext does not reach a new segment, as
+  // the last segment would then be encrypted again with the same nonce, and
+  // writes nothing if no plaintext was appended.
+  static
+  crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::OutputStream>>
+      NewForAppend(
+          std::unique_ptr<StreamSegmentEncrypter> segment_encrypter,
+          std::vector<uint8_t> last_segment_plaintext,
+          std::unique_ptr<crypto::tink::OutputStream> ciphertext_destination);
+
   // -----------------------
   // Methods of OutputStream-interface implemented by this class.
   crypto::tink::util::StatusOr<int> Next(void** data) override;
@@ -67,6 +84,11 @@ class StreamingAeadEncryptingStream : public OutputStream {
   // header has been written to ct_destination_, nor the user had
   // a chance to write any data to this stream.
   bool is_first_segment_;
+
+  // Set for streams created by NewForAppend(); the last segment must then
+  // have a number of at least min_last_segment_number_.
+  bool is_append_;
+  int64_t min_last_segment_number_;
 };
 
 }  // namespace subtle
@@ -0,0 +1,174 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/subtle/streaming_aead_file_encryption.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "tink/subtle/nonce_based_streaming_aead.h"
+#include "tink/subtle/stream_segment_encrypter.h"
+#include "tink/util/errors.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+namespace {
+
+// Writes all 'size' bytes at 'data' to 'fd', retrying on EINTR.
+util::Status WriteAll(int fd, const uint8_t* data, size_t size) {
+  while (size > 0) {
+    ssize_t written = write(fd, data, size);
+    if (written < 0 && errno == EINTR) continue;
+    if (written <= 0) {
+      return ToStatusF(absl::StatusCode::kInternal,
+                       "I/O error upon write: %d", errno);
+    }
+    data += written;
+    size -= written;
+  }
+  return util::OkStatus();
+}
+
+// Reads 'size' bytes from 'fd' into '*buffer', or fewer only if the end of
+// the file is reached first.
+util::Status ReadFully(int fd, int size, std::vector<uint8_t>* buffer) {
+  buffer->resize(size);
+  int total_read = 0;
+  while (total_read < size) {
+    ssize_t read_size =
+        read(fd, buffer->data() + total_read, size - total_read);
+    if (read_size < 0 && errno == EINTR) continue;
+    if (read_size < 0) {
+      return ToStatusF(absl::StatusCode::kInternal,
+                       "I/O error upon read: %d", errno);
+    }
+    if (read_size == 0) break;
+    total_read += read_size;
+  }
+  buffer->resize(total_read);
+  return util::OkStatus();
+}
+
+// Returns the number of bytes from the current offset of 'fd' to its end if
+// 'fd' is a regular file, and -1 otherwise.
+int64_t RemainingFileSize(int fd) {
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || !S_ISREG(file_stat.st_mode)) return -1;
+  off_t offset = lseek(fd, 0, SEEK_CUR);
+  if (offset < 0 || offset > file_stat.st_size) return -1;
+  return file_stat.st_size - offset;
+}
+
+// Encrypts the remaining 'plaintext_size' bytes of the regular file
+// 'plaintext_fd' with EncryptSegmentFromFile(), where the first segment
+// holds 'first_segment_size' bytes. Returns UNIMPLEMENTED without reading
+// anything if the encrypter does not support this.
+util::Status EncryptSegmentsFromFile(StreamSegmentEncrypter& encrypter,
+                                     int plaintext_fd, int64_t plaintext_size,
+                                     int first_segment_size,
+                                     int ciphertext_fd) {
+  std::vector<uint8_t> ciphertext;
+  int segment_size = first_segment_size;
+  while (true) {
+    bool is_last_segment = plaintext_size <= segment_size;
+    int size = is_last_segment ? plaintext_size : segment_size;
+    util::Status status = encrypter.EncryptSegmentFromFile(
+        plaintext_fd, size, is_last_segment, &ciphertext);
+    if (!status.ok()) return status;
+    status = WriteAll(ciphertext_fd, ciphertext.data(), ciphertext.size());
+    if (!status.ok()) return status;
+    if (is_last_segment) return util::OkStatus();
+    plaintext_size -= size;
+    segment_size = encrypter.get_plaintext_segment_size();
+  }
+}
+
+// Encrypts everything that can be read from 'plaintext_fd' with
+// EncryptSegment(), reading one segment ahead to find the last one.
+util::Status EncryptSegmentsFromReads(StreamSegmentEncrypter& encrypter,
+                                      int plaintext_fd, int first_segment_size,
+                                      int ciphertext_fd) {
+  std::vector<uint8_t> segment;
+  std::vector<uint8_t> next_segment;
+  std::vector<uint8_t> ciphertext;
+  util::Status status = ReadFully(plaintext_fd, first_segment_size, &segment);
+  if (!status.ok()) return status;
+  while (true) {
+    // A short read means the end of the file, so no need to read further.
+    if (segment.size() < first_segment_size) {
+      next_segment.clear();
+    } else {
+      status = ReadFully(plaintext_fd, encrypter.get_plaintext_segment_size(),
+                         &next_segment);
+      if (!status.ok()) return status;
+    }
+    bool is_last_segment = next_segment.empty();
+    status = encrypter.EncryptSegment(segment, is_last_segment, &ciphertext);
+    if (!status.ok()) return status;
+    status = WriteAll(ciphertext_fd, ciphertext.data(), ciphertext.size());
+    if (!status.ok()) return status;
+    if (is_last_segment) return util::OkStatus();
+    std::swap(segment, next_segment);
+    first_segment_size = encrypter.get_plaintext_segment_size();
+  }
+}
+
+}  // namespace
+
+util::Status EncryptFile(const NonceBasedStreamingAead& streaming_aead,
+                         int plaintext_fd, int ciphertext_fd,
+                         absl::string_view associated_data) {
+  util::StatusOr<std::unique_ptr<StreamSegmentEncrypter>> encrypter =
+      streaming_aead.NewSegmentEncrypterForFile(associated_data);
+  if (!encrypter.ok()) return encrypter.status();
+  // As in StreamingAeadEncryptingStream, the ciphertext offset is left to
+  // the caller and only the header is written.
+  const std::vector<uint8_t>& header = (*encrypter)->get_header();
+  util::Status status = WriteAll(ciphertext_fd, header.data(), header.size());
+  if (!status.ok()) return status;
+  const int first_segment_size = (*encrypter)->get_plaintext_segment_size() -
+                                 (*encrypter)->get_ciphertext_offset() -
+                                 header.size();
+
+  int64_t plaintext_size = RemainingFileSize(plaintext_fd);
+  if (plaintext_size >= 0) {
+    status = EncryptSegmentsFromFile(**encrypter, plaintext_fd, plaintext_size,
+                                     first_segment_size, ciphertext_fd);
+    // Falls back to reading the plaintext if the encrypter does not support
+    // files, which it reports before consuming any input.
+    if (!absl::IsUnimplemented(status)) return status;
+  }
+  return EncryptSegmentsFromReads(**encrypter, plaintext_fd,
+                                  first_segment_size, ciphertext_fd);
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
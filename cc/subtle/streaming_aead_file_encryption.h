@@ -0,0 +1,50 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef TINK_SUBTLE_STREAMING_AEAD_FILE_ENCRYPTION_H_
+#define TINK_SUBTLE_STREAMING_AEAD_FILE_ENCRYPTION_H_
+
+#include "absl/strings/string_view.h"
+#include "tink/subtle/nonce_based_streaming_aead.h"
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// Encrypts the contents of the POSIX file descriptor 'plaintext_fd', from its
+// current offset to the end, with 'streaming_aead', using 'associated_data'
+// as associated authenticated data, and writes the ciphertext to
+// 'ciphertext_fd' at its current offset. The ciphertext is the same as the
+// one written by streaming_aead.NewEncryptingStream(). Neither descriptor is
+// closed.
+//
+// If 'plaintext_fd' is a regular file and the segment encrypter supports
+// EncryptSegmentFromFile() (e.g. AesGcmHkdfStreaming with use_kernel_crypto
+// on Linux), the plaintext is not copied through user space; otherwise it is
+// read segment by segment.
+//
+// Not available on Windows.
+crypto::tink::util::Status EncryptFile(
+    const NonceBasedStreamingAead& streaming_aead, int plaintext_fd,
+    int ciphertext_fd, absl::string_view associated_data);
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_STREAMING_AEAD_FILE_ENCRYPTION_H_
@@ -0,0 +1,335 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/streaming_aead_file_encryption.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "tink/config/tink_fips.h"
+#include "tink/input_stream.h"
+#include "tink/internal/test_file_util.h"
+#include "tink/streaming_aead.h"
+#include "tink/subtle/aes_gcm_hkdf_streaming.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/stream_segment_encrypter.h"
+#include "tink/subtle/streaming_aead_test_util.h"
+#include "tink/subtle/test_util.h"
+#include "tink/util/istream_input_stream.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "tink/util/test_util.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+using ::crypto::tink::subtle::test::DummyStreamingAead;
+using ::crypto::tink::subtle::test::DummyStreamSegmentEncrypter;
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::IsOkAndHolds;
+using ::testing::Eq;
+
+constexpr int kPlaintextSegmentSize = 100;
+constexpr int kHeaderSize = 10;
+constexpr int kCiphertextOffset = 5;
+
+// A DummyStreamSegmentEncrypter that also encrypts segments from files.
+class FileSegmentEncrypter : public DummyStreamSegmentEncrypter {
+ public:
+  explicit FileSegmentEncrypter(int* segments_from_file)
+      : DummyStreamSegmentEncrypter(kPlaintextSegmentSize, kHeaderSize,
+                                    kCiphertextOffset),
+        segments_from_file_(segments_from_file) {}
+
+  util::Status EncryptSegmentFromFile(
+      int plaintext_fd, int plaintext_size, bool is_last_segment,
+      std::vector<uint8_t>* ciphertext_buffer) override {
+    std::vector<uint8_t> plaintext(plaintext_size);
+    if (read(plaintext_fd, plaintext.data(), plaintext_size) !=
+        plaintext_size) {
+      return util::Status(absl::StatusCode::kOutOfRange, "short read");
+    }
+    (*segments_from_file_)++;
+    return EncryptSegment(plaintext, is_last_segment, ciphertext_buffer);
+  }
+
+ private:
+  int* segments_from_file_;
+};
+
+// A DummyStreamingAead whose EncryptFile() uses FileSegmentEncrypter.
+class FileStreamingAead : public DummyStreamingAead {
+ public:
+  FileStreamingAead()
+      : DummyStreamingAead(kPlaintextSegmentSize, kHeaderSize,
+                           kCiphertextOffset) {}
+
+  int segments_from_file() const { return segments_from_file_; }
+
+ protected:
+  util::StatusOr<std::unique_ptr<StreamSegmentEncrypter>>
+  NewSegmentEncrypterForFile(
+      absl::string_view associated_data) const override {
+    return {absl::make_unique<FileSegmentEncrypter>(&segments_from_file_)};
+  }
+
+ private:
+  mutable int segments_from_file_ = 0;
+};
+
+// Returns a descriptor of a new test file with `contents`, at offset 0.
+int OpenTestFile(absl::string_view suffix, absl::string_view contents) {
+  std::string filename =
+      absl::StrCat(internal::GetTestFileNamePrefix(), "_", suffix);
+  EXPECT_THAT(internal::CreateTestFile(filename, contents), IsOk());
+  std::string path =
+      absl::StrCat(crypto::tink::test::TmpDir(), "/", filename);
+  int fd = open(path.c_str(), O_RDWR);
+  EXPECT_GE(fd, 0);
+  return fd;
+}
+
+std::string ReadAll(int fd) {
+  std::string contents;
+  char buffer[1024];
+  lseek(fd, 0, SEEK_SET);
+  ssize_t read_size;
+  while ((read_size = read(fd, buffer, sizeof(buffer))) > 0) {
+    contents.append(buffer, read_size);
+  }
+  return contents;
+}
+
+std::string ExpectedCiphertext(absl::string_view plaintext) {
+  return DummyStreamSegmentEncrypter(kPlaintextSegmentSize, kHeaderSize,
+                                     kCiphertextOffset)
+      .GenerateCiphertext(plaintext);
+}
+
+util::StatusOr<std::string> DecryptString(const StreamingAead& streaming_aead,
+                                          const std::string& ciphertext,
+                                          absl::string_view associated_data) {
+  util::StatusOr<std::unique_ptr<InputStream>> decrypting_stream =
+      streaming_aead.NewDecryptingStream(
+          absl::make_unique<util::IstreamInputStream>(
+              absl::make_unique<std::stringstream>(ciphertext)),
+          associated_data);
+  if (!decrypting_stream.ok()) return decrypting_stream.status();
+  std::string plaintext;
+  util::Status status =
+      test::ReadFromStream(decrypting_stream->get(), &plaintext);
+  if (!status.ok()) return status;
+  return plaintext;
+}
+
+std::vector<int> PlaintextSizes() {
+  const int first_segment_size =
+      kPlaintextSegmentSize - kCiphertextOffset - kHeaderSize;
+  return {0,
+          1,
+          first_segment_size - 1,
+          first_segment_size,
+          first_segment_size + 1,
+          first_segment_size + 2 * kPlaintextSegmentSize,
+          first_segment_size + 2 * kPlaintextSegmentSize + 1,
+          10000};
+}
+
+TEST(StreamingAeadFileEncryptionTest, EncryptFileBySegments) {
+  DummyStreamingAead streaming_aead(kPlaintextSegmentSize, kHeaderSize,
+                                    kCiphertextOffset);
+  for (int pt_size : PlaintextSizes()) {
+    SCOPED_TRACE(absl::StrCat("pt_size = ", pt_size));
+    std::string plaintext = Random::GetRandomBytes(pt_size);
+    int plaintext_fd = OpenTestFile("plaintext", plaintext);
+    int ciphertext_fd = OpenTestFile("ciphertext", "");
+    ASSERT_THAT(EncryptFile(streaming_aead, plaintext_fd, ciphertext_fd, "ad"),
+                IsOk());
+    EXPECT_THAT(ReadAll(ciphertext_fd), Eq(ExpectedCiphertext(plaintext)));
+    close(plaintext_fd);
+    close(ciphertext_fd);
+  }
+}
+
+TEST(StreamingAeadFileEncryptionTest, EncryptFileFromFile) {
+  for (int pt_size : PlaintextSizes()) {
+    SCOPED_TRACE(absl::StrCat("pt_size = ", pt_size));
+    FileStreamingAead streaming_aead;
+    std::string plaintext = Random::GetRandomBytes(pt_size);
+    int plaintext_fd = OpenTestFile("plaintext", plaintext);
+    int ciphertext_fd = OpenTestFile("ciphertext", "");
+    ASSERT_THAT(EncryptFile(streaming_aead, plaintext_fd, ciphertext_fd, "ad"),
+                IsOk());
+    EXPECT_THAT(ReadAll(ciphertext_fd), Eq(ExpectedCiphertext(plaintext)));
+    const int first_segment_size =
+        kPlaintextSegmentSize - kCiphertextOffset - kHeaderSize;
+    int segments = 1;
+    if (pt_size > first_segment_size) {
+      segments += (pt_size - first_segment_size + kPlaintextSegmentSize - 1) /
+                  kPlaintextSegmentSize;
+    }
+    EXPECT_THAT(streaming_aead.segments_from_file(), Eq(segments));
+    close(plaintext_fd);
+    close(ciphertext_fd);
+  }
+}
+
+TEST(StreamingAeadFileEncryptionTest, EncryptFileStartsAtCurrentOffset) {
+  FileStreamingAead streaming_aead;
+  std::string plaintext = Random::GetRandomBytes(500);
+  int plaintext_fd = OpenTestFile("plaintext", plaintext);
+  int ciphertext_fd = OpenTestFile("ciphertext", "");
+  lseek(plaintext_fd, 200, SEEK_SET);
+  ASSERT_EQ(write(ciphertext_fd, "other", 5), 5);
+  ASSERT_THAT(EncryptFile(streaming_aead, plaintext_fd, ciphertext_fd, "ad"),
+              IsOk());
+  EXPECT_THAT(ReadAll(ciphertext_fd),
+              Eq(absl::StrCat("other", ExpectedCiphertext(
+                                           plaintext.substr(200)))));
+  close(plaintext_fd);
+  close(ciphertext_fd);
+}
+
+TEST(StreamingAeadFileEncryptionTest, EncryptFileFromPipe) {
+  FileStreamingAead streaming_aead;
+  // Small enough to fit into the pipe buffer.
+  std::string plaintext = Random::GetRandomBytes(1000);
+  int pipe_fds[2];
+  ASSERT_EQ(pipe(pipe_fds), 0);
+  ASSERT_EQ(write(pipe_fds[1], plaintext.data(), plaintext.size()),
+            plaintext.size());
+  close(pipe_fds[1]);
+  int ciphertext_fd = OpenTestFile("ciphertext", "");
+  ASSERT_THAT(EncryptFile(streaming_aead, pipe_fds[0], ciphertext_fd, "ad"),
+              IsOk());
+  EXPECT_THAT(ReadAll(ciphertext_fd), Eq(ExpectedCiphertext(plaintext)));
+  // Pipes have no known size, so they are read segment by segment.
+  EXPECT_THAT(streaming_aead.segments_from_file(), Eq(0));
+  close(pipe_fds[0]);
+  close(ciphertext_fd);
+}
+
+TEST(StreamingAeadFileEncryptionTest, AesGcmHkdfStreaming) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  constexpr int kSegmentSize = 128;
+  constexpr int kHeaderSize = 1 + 32 + 7;
+  constexpr int kPlaintextSegmentSize = kSegmentSize - 16;
+  // If the kernel cannot encrypt, use_kernel_crypto falls back to user space.
+  for (bool use_kernel_crypto : {false, true}) {
+    for (int ciphertext_offset : {0, 8}) {
+      AesGcmHkdfStreaming::Params params;
+      params.ikm = Random::GetRandomKeyBytes(32);
+      params.hkdf_hash = SHA256;
+      params.derived_key_size = 32;
+      params.ciphertext_segment_size = kSegmentSize;
+      params.ciphertext_offset = ciphertext_offset;
+      params.use_kernel_crypto = use_kernel_crypto;
+      util::StatusOr<std::unique_ptr<AesGcmHkdfStreaming>> streaming_aead =
+          AesGcmHkdfStreaming::New(std::move(params));
+      ASSERT_THAT(streaming_aead, IsOk());
+
+      const int first_segment_size =
+          kPlaintextSegmentSize - ciphertext_offset - kHeaderSize;
+      for (int pt_size : {0, 1, first_segment_size, first_segment_size + 1,
+                          first_segment_size + kPlaintextSegmentSize,
+                          first_segment_size + 3 * kPlaintextSegmentSize - 1,
+                          10000}) {
+        SCOPED_TRACE(absl::StrCat("use_kernel_crypto = ", use_kernel_crypto,
+                                  ", ciphertext_offset = ", ciphertext_offset,
+                                  ", pt_size = ", pt_size));
+        std::string plaintext = Random::GetRandomBytes(pt_size);
+        std::string associated_data = "some associated data";
+        int plaintext_fd = OpenTestFile("plaintext", plaintext);
+        int ciphertext_fd = OpenTestFile("ciphertext", "");
+        lseek(ciphertext_fd, ciphertext_offset, SEEK_SET);
+
+        ASSERT_THAT(EncryptFile(**streaming_aead, plaintext_fd, ciphertext_fd,
+                                associated_data),
+                    IsOk());
+        std::string ciphertext =
+            ReadAll(ciphertext_fd).substr(ciphertext_offset);
+        close(plaintext_fd);
+        close(ciphertext_fd);
+
+        util::StatusOr<std::string> expected = EncryptToString(
+            streaming_aead->get(), plaintext, associated_data,
+            ciphertext_offset);
+        ASSERT_THAT(expected, IsOk());
+        EXPECT_THAT(ciphertext.size(),
+                    Eq(expected->size() - ciphertext_offset));
+        EXPECT_THAT(
+            DecryptString(**streaming_aead, ciphertext, associated_data),
+            IsOkAndHolds(plaintext));
+      }
+    }
+  }
+}
+
+TEST(StreamingAeadFileEncryptionTest, AesGcmHkdfStreamingFromPipe) {
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  AesGcmHkdfStreaming::Params params;
+  params.ikm = Random::GetRandomKeyBytes(32);
+  params.hkdf_hash = SHA256;
+  params.derived_key_size = 32;
+  params.ciphertext_segment_size = 128;
+  params.ciphertext_offset = 0;
+  params.use_kernel_crypto = true;
+  util::StatusOr<std::unique_ptr<AesGcmHkdfStreaming>> streaming_aead =
+      AesGcmHkdfStreaming::New(std::move(params));
+  ASSERT_THAT(streaming_aead, IsOk());
+
+  // Small enough to fit into the pipe buffer.
+  std::string plaintext = Random::GetRandomBytes(1000);
+  int pipe_fds[2];
+  ASSERT_EQ(pipe(pipe_fds), 0);
+  ASSERT_EQ(write(pipe_fds[1], plaintext.data(), plaintext.size()),
+            plaintext.size());
+  close(pipe_fds[1]);
+  int ciphertext_fd = OpenTestFile("ciphertext", "");
+
+  ASSERT_THAT(EncryptFile(**streaming_aead, pipe_fds[0], ciphertext_fd, "ad"),
+              IsOk());
+  std::string ciphertext = ReadAll(ciphertext_fd);
+  close(pipe_fds[0]);
+  close(ciphertext_fd);
+  EXPECT_THAT(DecryptString(**streaming_aead, ciphertext, "ad"),
+              IsOkAndHolds(plaintext));
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,152 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/streaming_aead_push_decrypter.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "tink/streaming_aead.h"
+#include "tink/subtle/stream_segment_decrypter.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// static
+util::StatusOr<std::unique_ptr<StreamingAead::PushDecrypter>>
+StreamingAeadPushDecrypter::New(
+    std::unique_ptr<StreamSegmentDecrypter> segment_decrypter) {
+  if (segment_decrypter == nullptr) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "segment_decrypter must be non-null");
+  }
+  int first_segment_size = segment_decrypter->get_ciphertext_segment_size() -
+                           segment_decrypter->get_ciphertext_offset() -
+                           segment_decrypter->get_header_size();
+  if (first_segment_size <= 0) {
+    return util::Status(absl::StatusCode::kInternal,
+                        "Size of the first segment must be greater than 0.");
+  }
+  return {absl::WrapUnique(
+      new StreamingAeadPushDecrypter(std::move(segment_decrypter)))};
+}
+
+int StreamingAeadPushDecrypter::CurrentSegmentSize() const {
+  if (segment_number_ == 0) {
+    return segment_decrypter_->get_ciphertext_segment_size() -
+           segment_decrypter_->get_ciphertext_offset() -
+           segment_decrypter_->get_header_size();
+  }
+  return segment_decrypter_->get_ciphertext_segment_size();
+}
+
+util::Status StreamingAeadPushDecrypter::DecryptSegment(int size,
+                                                        bool is_last_segment) {
+  segment_.assign(ct_buffer_.begin() + ct_buffer_offset_,
+                  ct_buffer_.begin() + ct_buffer_offset_ + size);
+  return segment_decrypter_->DecryptSegment(segment_, segment_number_,
+                                            is_last_segment, &pt_buffer_);
+}
+
+void StreamingAeadPushDecrypter::ReleaseSegment(int size,
+                                                std::string* plaintext) {
+  ct_buffer_offset_ += size;
+  segment_number_++;
+  failed_as_intermediate_segment_ = false;
+  plaintext->append(reinterpret_cast<const char*>(pt_buffer_.data()),
+                    pt_buffer_.size());
+}
+
+util::Status StreamingAeadPushDecrypter::Update(absl::string_view ciphertext,
+                                                std::string* plaintext) {
+  if (!status_.ok()) return status_;
+  if (plaintext == nullptr) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "plaintext must be non-null");
+  }
+  ct_buffer_.insert(ct_buffer_.end(), ciphertext.begin(), ciphertext.end());
+
+  if (!is_initialized_) {
+    const size_t header_size = segment_decrypter_->get_header_size();
+    if (ct_buffer_.size() < header_size) return util::OkStatus();
+    status_ = segment_decrypter_->Init(std::vector<uint8_t>(
+        ct_buffer_.begin(), ct_buffer_.begin() + header_size));
+    if (!status_.ok()) return status_;
+    ct_buffer_offset_ = header_size;
+    is_initialized_ = true;
+  }
+
+  while (true) {
+    const int segment_size = CurrentSegmentSize();
+    const size_t available = ct_buffer_.size() - ct_buffer_offset_;
+    if (available > static_cast<size_t>(segment_size)) {
+      // More ciphertext follows, so this is an intermediate segment.
+      status_ = DecryptSegment(segment_size, /*is_last_segment=*/false);
+      if (!status_.ok()) return status_;
+      ReleaseSegment(segment_size, plaintext);
+    } else if (available == static_cast<size_t>(segment_size) &&
+               !failed_as_intermediate_segment_) {
+      // Release the segment without waiting for more ciphertext if it
+      // authenticates as an intermediate segment. Otherwise, it can only be
+      // the last segment, which Finalize() decrypts.
+      if (DecryptSegment(segment_size, /*is_last_segment=*/false).ok()) {
+        ReleaseSegment(segment_size, plaintext);
+      } else {
+        failed_as_intermediate_segment_ = true;
+      }
+    } else {
+      break;
+    }
+  }
+  ct_buffer_.erase(ct_buffer_.begin(), ct_buffer_.begin() + ct_buffer_offset_);
+  ct_buffer_offset_ = 0;
+  return util::OkStatus();
+}
+
+util::Status StreamingAeadPushDecrypter::Finalize(std::string* plaintext) {
+  if (!status_.ok()) return status_;
+  if (plaintext == nullptr) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "plaintext must be non-null");
+  }
+  if (!is_initialized_) {
+    status_ = util::Status(absl::StatusCode::kInvalidArgument,
+                           "Could not read stream header.");
+    return status_;
+  }
+  const int size = ct_buffer_.size() - ct_buffer_offset_;
+  status_ = DecryptSegment(size, /*is_last_segment=*/true);
+  if (!status_.ok()) return status_;
+  ReleaseSegment(size, plaintext);
+  ct_buffer_.clear();
+  ct_buffer_offset_ = 0;
+  status_ =
+      util::Status(absl::StatusCode::kFailedPrecondition, "Stream finalized");
+  return util::OkStatus();
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,87 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_STREAMING_AEAD_PUSH_DECRYPTER_H_
+#define TINK_SUBTLE_STREAMING_AEAD_PUSH_DECRYPTER_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "tink/streaming_aead.h"
+#include "tink/subtle/stream_segment_decrypter.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// Push-style counterpart of StreamingAeadDecryptingStream: decrypts the same
+// ciphertext stream, but takes ciphertext through Update() calls instead of
+// reading it from an InputStream.
+//
+// A complete ciphertext segment is decrypted as soon as it is available. If
+// it does not authenticate as an intermediate segment it may still be the
+// last one, so it is kept until more ciphertext or Finalize() decides.
+class StreamingAeadPushDecrypter : public StreamingAead::PushDecrypter {
+ public:
+  static crypto::tink::util::StatusOr<
+      std::unique_ptr<StreamingAead::PushDecrypter>>
+  New(std::unique_ptr<StreamSegmentDecrypter> segment_decrypter);
+
+  crypto::tink::util::Status Update(absl::string_view ciphertext,
+                                    std::string* plaintext) override;
+  crypto::tink::util::Status Finalize(std::string* plaintext) override;
+
+ private:
+  explicit StreamingAeadPushDecrypter(
+      std::unique_ptr<StreamSegmentDecrypter> segment_decrypter)
+      : segment_decrypter_(std::move(segment_decrypter)) {}
+
+  // Returns the ciphertext size of the segment decrypted next.
+  int CurrentSegmentSize() const;
+
+  // Decrypts 'size' bytes of ct_buffer_ starting at ct_buffer_offset_ as
+  // segment segment_number_ into pt_buffer_.
+  crypto::tink::util::Status DecryptSegment(int size, bool is_last_segment);
+
+  // Consumes the segment that was just decrypted and appends its plaintext to
+  // '*plaintext'.
+  void ReleaseSegment(int size, std::string* plaintext);
+
+  std::unique_ptr<StreamSegmentDecrypter> segment_decrypter_;
+  // Ciphertext that has not been decrypted yet, starting at ct_buffer_offset_.
+  std::vector<uint8_t> ct_buffer_;
+  size_t ct_buffer_offset_ = 0;
+  std::vector<uint8_t> segment_;     // ciphertext of the current segment
+  std::vector<uint8_t> pt_buffer_;   // plaintext of the current segment
+  int64_t segment_number_ = 0;
+  bool is_initialized_ = false;
+  // Whether the complete segment at ct_buffer_offset_ already failed to
+  // authenticate as an intermediate segment.
+  bool failed_as_intermediate_segment_ = false;
+  crypto::tink::util::Status status_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_STREAMING_AEAD_PUSH_DECRYPTER_H_
@@ -0,0 +1,231 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/streaming_aead_push_decrypter.h"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "tink/streaming_aead.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/test_util.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+using ::crypto::tink::subtle::test::DummyStreamSegmentDecrypter;
+using ::crypto::tink::subtle::test::DummyStreamSegmentEncrypter;
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::testing::Eq;
+using ::testing::IsEmpty;
+
+constexpr int kPlaintextSegmentSize = 100;
+constexpr int kHeaderSize = 10;
+constexpr int kCiphertextOffset = 5;
+constexpr int kFirstSegmentSize =
+    kPlaintextSegmentSize - kHeaderSize - kCiphertextOffset;
+
+std::unique_ptr<StreamingAead::PushDecrypter> NewPushDecrypter() {
+  util::StatusOr<std::unique_ptr<StreamingAead::PushDecrypter>> decrypter =
+      StreamingAeadPushDecrypter::New(
+          absl::make_unique<DummyStreamSegmentDecrypter>(
+              kPlaintextSegmentSize, kHeaderSize, kCiphertextOffset));
+  EXPECT_THAT(decrypter, IsOk());
+  return *std::move(decrypter);
+}
+
+std::string GenerateCiphertext(absl::string_view plaintext) {
+  return DummyStreamSegmentEncrypter(kPlaintextSegmentSize, kHeaderSize,
+                                     kCiphertextOffset)
+      .GenerateCiphertext(plaintext);
+}
+
+TEST(StreamingAeadPushDecrypterTest, DecryptInChunks) {
+  for (int pt_size : {0, 1, 84, 85, 86, 185, 1000, 10000}) {
+    for (int chunk_size : {1, 7, 109, 100000}) {
+      SCOPED_TRACE(
+          absl::StrCat("pt_size = ", pt_size, ", chunk_size = ", chunk_size));
+      std::string plaintext = Random::GetRandomBytes(pt_size);
+      std::string ciphertext = GenerateCiphertext(plaintext);
+      std::unique_ptr<StreamingAead::PushDecrypter> decrypter =
+          NewPushDecrypter();
+      std::string decrypted;
+      for (int pos = 0; pos < ciphertext.size(); pos += chunk_size) {
+        ASSERT_THAT(decrypter->Update(ciphertext.substr(pos, chunk_size),
+                                      &decrypted),
+                    IsOk());
+      }
+      ASSERT_THAT(decrypter->Finalize(&decrypted), IsOk());
+      EXPECT_THAT(decrypted, Eq(plaintext));
+    }
+  }
+}
+
+TEST(StreamingAeadPushDecrypterTest, ReleasesSegmentAsSoonAsComplete) {
+  std::string plaintext = Random::GetRandomBytes(1000);
+  std::string ciphertext = GenerateCiphertext(plaintext);
+  std::unique_ptr<StreamingAead::PushDecrypter> decrypter = NewPushDecrypter();
+  std::string decrypted;
+  const int first_segment_end =
+      kHeaderSize + kFirstSegmentSize +
+      DummyStreamSegmentEncrypter::kSegmentTagSize;
+  ASSERT_THAT(
+      decrypter->Update(ciphertext.substr(0, first_segment_end - 1),
+                        &decrypted),
+      IsOk());
+  EXPECT_THAT(decrypted, IsEmpty());
+  ASSERT_THAT(decrypter->Update(ciphertext.substr(first_segment_end - 1, 1),
+                                &decrypted),
+              IsOk());
+  EXPECT_THAT(decrypted, Eq(plaintext.substr(0, kFirstSegmentSize)));
+}
+
+TEST(StreamingAeadPushDecrypterTest, LastSegmentOfFullSize) {
+  std::string plaintext = Random::GetRandomBytes(kFirstSegmentSize);
+  std::string ciphertext = GenerateCiphertext(plaintext);
+  std::unique_ptr<StreamingAead::PushDecrypter> decrypter = NewPushDecrypter();
+  std::string decrypted;
+  ASSERT_THAT(decrypter->Update(ciphertext, &decrypted), IsOk());
+  // The segment only authenticates as the last one.
+  EXPECT_THAT(decrypted, IsEmpty());
+  ASSERT_THAT(decrypter->Finalize(&decrypted), IsOk());
+  EXPECT_THAT(decrypted, Eq(plaintext));
+}
+
+TEST(StreamingAeadPushDecrypterTest, TruncatedCiphertextFails) {
+  std::string plaintext = Random::GetRandomBytes(1000);
+  std::string ciphertext = GenerateCiphertext(plaintext);
+  for (int size : {0, kHeaderSize - 1, kHeaderSize,
+                   kHeaderSize + kFirstSegmentSize +
+                       DummyStreamSegmentEncrypter::kSegmentTagSize,
+                   static_cast<int>(ciphertext.size()) - 1}) {
+    SCOPED_TRACE(absl::StrCat("size = ", size));
+    std::unique_ptr<StreamingAead::PushDecrypter> decrypter =
+        NewPushDecrypter();
+    std::string decrypted;
+    ASSERT_THAT(decrypter->Update(ciphertext.substr(0, size), &decrypted),
+                IsOk());
+    EXPECT_THAT(decrypter->Finalize(&decrypted),
+                StatusIs(absl::StatusCode::kInvalidArgument));
+  }
+}
+
+TEST(StreamingAeadPushDecrypterTest, ModifiedCiphertextFails) {
+  std::string plaintext = Random::GetRandomBytes(1000);
+  std::string ciphertext = GenerateCiphertext(plaintext);
+  // Corrupt the segment number of the second segment.
+  const int second_segment_end =
+      kHeaderSize + kFirstSegmentSize + kPlaintextSegmentSize +
+      2 * DummyStreamSegmentEncrypter::kSegmentTagSize;
+  ciphertext[second_segment_end - 2] ^= 1;
+  std::unique_ptr<StreamingAead::PushDecrypter> decrypter = NewPushDecrypter();
+  std::string decrypted;
+  EXPECT_THAT(decrypter->Update(ciphertext, &decrypted),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  // Only the first segment was released.
+  EXPECT_THAT(decrypted, Eq(plaintext.substr(0, kFirstSegmentSize)));
+  // The decrypter stays in the failed state.
+  EXPECT_THAT(decrypter->Finalize(&decrypted),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(StreamingAeadPushDecrypterTest, InvalidHeaderFails) {
+  std::string ciphertext = GenerateCiphertext("plaintext");
+  ciphertext[0] ^= 1;
+  std::unique_ptr<StreamingAead::PushDecrypter> decrypter = NewPushDecrypter();
+  std::string decrypted;
+  EXPECT_THAT(decrypter->Update(ciphertext, &decrypted),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(StreamingAeadPushDecrypterTest, InvalidArguments) {
+  EXPECT_THAT(StreamingAeadPushDecrypter::New(nullptr).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(NewPushDecrypter()->Update("a", nullptr),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+// Decrypts a ciphertext received over a non-blocking socket. Writing to and
+// reading from the socket are multiplexed with poll() on a single thread, as
+// an event loop serving many connections would do.
+TEST(StreamingAeadPushDecrypterTest, NonBlockingSocket) {
+  std::string plaintext = Random::GetRandomBytes(1 << 20);
+  std::string ciphertext = GenerateCiphertext(plaintext);
+  int fds[2];
+  ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+  for (int fd : fds) {
+    ASSERT_EQ(fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK), 0);
+  }
+  int writer = fds[0];
+  int reader = fds[1];
+
+  std::unique_ptr<StreamingAead::PushDecrypter> decrypter = NewPushDecrypter();
+  std::string decrypted;
+  size_t written = 0;
+  bool end_of_stream = false;
+  while (!end_of_stream) {
+    pollfd poll_fds[2] = {{writer, POLLOUT, 0}, {reader, POLLIN, 0}};
+    ASSERT_GT(poll(poll_fds, 2, /*timeout=*/10000), 0);
+    if (poll_fds[0].revents & POLLOUT) {
+      ssize_t n = write(writer, ciphertext.data() + written,
+                        std::min<size_t>(4096, ciphertext.size() - written));
+      ASSERT_TRUE(n > 0 || errno == EAGAIN);
+      if (n > 0) written += n;
+      if (written == ciphertext.size()) {
+        close(writer);
+        writer = -1;  // poll() ignores negative descriptors.
+      }
+    }
+    if (poll_fds[1].revents & (POLLIN | POLLHUP)) {
+      char buffer[1000];
+      ssize_t n = read(reader, buffer, sizeof(buffer));
+      ASSERT_TRUE(n >= 0 || errno == EAGAIN);
+      if (n > 0) {
+        ASSERT_THAT(decrypter->Update(absl::string_view(buffer, n),
+                                      &decrypted),
+                    IsOk());
+      } else if (n == 0) {
+        end_of_stream = true;
+      }
+    }
+  }
+  close(reader);
+  ASSERT_THAT(decrypter->Finalize(&decrypted), IsOk());
+  EXPECT_THAT(decrypted, Eq(plaintext));
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,132 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/streaming_aead_push_encrypter.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "tink/streaming_aead.h"
+#include "tink/subtle/stream_segment_encrypter.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+namespace {
+
+void Append(const std::vector<uint8_t>& bytes, std::string* out) {
+  out->append(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+}
+
+}  // namespace
+
+// static
+util::StatusOr<std::unique_ptr<StreamingAead::PushEncrypter>>
+StreamingAeadPushEncrypter::New(
+    std::unique_ptr<StreamSegmentEncrypter> segment_encrypter) {
+  if (segment_encrypter == nullptr) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "segment_encrypter must be non-null");
+  }
+  int first_segment_size = segment_encrypter->get_plaintext_segment_size() -
+                           segment_encrypter->get_ciphertext_offset() -
+                           segment_encrypter->get_header().size();
+  if (first_segment_size <= 0) {
+    return util::Status(absl::StatusCode::kInternal,
+                        "Size of the first segment must be greater than 0.");
+  }
+  return {absl::WrapUnique(
+      new StreamingAeadPushEncrypter(std::move(segment_encrypter)))};
+}
+
+int StreamingAeadPushEncrypter::CurrentSegmentSize() const {
+  if (segment_encrypter_->get_segment_number() == 0) {
+    return segment_encrypter_->get_plaintext_segment_size() -
+           segment_encrypter_->get_ciphertext_offset() -
+           segment_encrypter_->get_header().size();
+  }
+  return segment_encrypter_->get_plaintext_segment_size();
+}
+
+void StreamingAeadPushEncrypter::MaybeWriteHeader(std::string* ciphertext) {
+  if (header_written_) return;
+  Append(segment_encrypter_->get_header(), ciphertext);
+  header_written_ = true;
+}
+
+util::Status StreamingAeadPushEncrypter::EncryptSegment(
+    int size, bool is_last_segment, std::string* ciphertext) {
+  segment_.assign(pt_buffer_.begin() + pt_buffer_offset_,
+                  pt_buffer_.begin() + pt_buffer_offset_ + size);
+  pt_buffer_offset_ += size;
+  util::Status status = segment_encrypter_->EncryptSegment(
+      segment_, is_last_segment, &ct_buffer_);
+  if (!status.ok()) return status;
+  Append(ct_buffer_, ciphertext);
+  return util::OkStatus();
+}
+
+util::Status StreamingAeadPushEncrypter::Update(absl::string_view plaintext,
+                                                std::string* ciphertext) {
+  if (!status_.ok()) return status_;
+  if (ciphertext == nullptr) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "ciphertext must be non-null");
+  }
+  MaybeWriteHeader(ciphertext);
+  pt_buffer_.insert(pt_buffer_.end(), plaintext.begin(), plaintext.end());
+  // A segment can be encrypted once it is known not to be the last one, i.e.,
+  // once at least one more plaintext byte follows it.
+  while (pt_buffer_.size() - pt_buffer_offset_ >
+         static_cast<size_t>(CurrentSegmentSize())) {
+    status_ = EncryptSegment(CurrentSegmentSize(), /*is_last_segment=*/false,
+                             ciphertext);
+    if (!status_.ok()) return status_;
+  }
+  pt_buffer_.erase(pt_buffer_.begin(), pt_buffer_.begin() + pt_buffer_offset_);
+  pt_buffer_offset_ = 0;
+  return util::OkStatus();
+}
+
+util::Status StreamingAeadPushEncrypter::Finalize(std::string* ciphertext) {
+  if (!status_.ok()) return status_;
+  if (ciphertext == nullptr) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "ciphertext must be non-null");
+  }
+  MaybeWriteHeader(ciphertext);
+  status_ = EncryptSegment(pt_buffer_.size() - pt_buffer_offset_,
+                           /*is_last_segment=*/true, ciphertext);
+  if (!status_.ok()) return status_;
+  pt_buffer_.clear();
+  pt_buffer_offset_ = 0;
+  status_ =
+      util::Status(absl::StatusCode::kFailedPrecondition, "Stream finalized");
+  return util::OkStatus();
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,79 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_STREAMING_AEAD_PUSH_ENCRYPTER_H_
+#define TINK_SUBTLE_STREAMING_AEAD_PUSH_ENCRYPTER_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "tink/streaming_aead.h"
+#include "tink/subtle/stream_segment_encrypter.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// Push-style counterpart of StreamingAeadEncryptingStream: produces the same
+// ciphertext stream, but takes plaintext through Update() calls and hands out
+// ciphertext instead of writing it to an OutputStream.
+class StreamingAeadPushEncrypter : public StreamingAead::PushEncrypter {
+ public:
+  static crypto::tink::util::StatusOr<
+      std::unique_ptr<StreamingAead::PushEncrypter>>
+  New(std::unique_ptr<StreamSegmentEncrypter> segment_encrypter);
+
+  crypto::tink::util::Status Update(absl::string_view plaintext,
+                                    std::string* ciphertext) override;
+  crypto::tink::util::Status Finalize(std::string* ciphertext) override;
+
+ private:
+  explicit StreamingAeadPushEncrypter(
+      std::unique_ptr<StreamSegmentEncrypter> segment_encrypter)
+      : segment_encrypter_(std::move(segment_encrypter)) {}
+
+  // Returns the plaintext size of the segment encrypted next.
+  int CurrentSegmentSize() const;
+
+  // Writes the header to '*ciphertext' if this has not been done yet.
+  void MaybeWriteHeader(std::string* ciphertext);
+
+  // Encrypts 'size' bytes of pt_buffer_ starting at pt_buffer_offset_ as the
+  // next segment and appends the result to '*ciphertext'.
+  crypto::tink::util::Status EncryptSegment(int size, bool is_last_segment,
+                                            std::string* ciphertext);
+
+  std::unique_ptr<StreamSegmentEncrypter> segment_encrypter_;
+  // Plaintext that has not been encrypted yet, starting at pt_buffer_offset_.
+  std::vector<uint8_t> pt_buffer_;
+  size_t pt_buffer_offset_ = 0;
+  std::vector<uint8_t> segment_;     // plaintext of the current segment
+  std::vector<uint8_t> ct_buffer_;   // ciphertext of the current segment
+  bool header_written_ = false;
+  crypto::tink::util::Status status_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_STREAMING_AEAD_PUSH_ENCRYPTER_H_
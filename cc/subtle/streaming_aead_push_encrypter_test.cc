@@ -0,0 +1,121 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/streaming_aead_push_encrypter.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "tink/streaming_aead.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/test_util.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+using ::crypto::tink::subtle::test::DummyStreamSegmentEncrypter;
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::testing::Eq;
+using ::testing::IsEmpty;
+using ::testing::Not;
+
+constexpr int kPlaintextSegmentSize = 100;
+constexpr int kHeaderSize = 10;
+constexpr int kCiphertextOffset = 5;
+
+std::unique_ptr<StreamingAead::PushEncrypter> NewPushEncrypter() {
+  util::StatusOr<std::unique_ptr<StreamingAead::PushEncrypter>> encrypter =
+      StreamingAeadPushEncrypter::New(
+          absl::make_unique<DummyStreamSegmentEncrypter>(
+              kPlaintextSegmentSize, kHeaderSize, kCiphertextOffset));
+  EXPECT_THAT(encrypter, IsOk());
+  return *std::move(encrypter);
+}
+
+TEST(StreamingAeadPushEncrypterTest, MatchesEncryptingStream) {
+  DummyStreamSegmentEncrypter reference(kPlaintextSegmentSize, kHeaderSize,
+                                        kCiphertextOffset);
+  for (int pt_size : {0, 1, 84, 85, 86, 185, 1000, 10000}) {
+    for (int chunk_size : {1, 7, 100, 10000}) {
+      SCOPED_TRACE(
+          absl::StrCat("pt_size = ", pt_size, ", chunk_size = ", chunk_size));
+      std::string plaintext = Random::GetRandomBytes(pt_size);
+      std::unique_ptr<StreamingAead::PushEncrypter> encrypter =
+          NewPushEncrypter();
+      std::string ciphertext;
+      for (int pos = 0; pos < pt_size; pos += chunk_size) {
+        ASSERT_THAT(encrypter->Update(plaintext.substr(pos, chunk_size),
+                                      &ciphertext),
+                    IsOk());
+      }
+      ASSERT_THAT(encrypter->Finalize(&ciphertext), IsOk());
+      EXPECT_THAT(ciphertext, Eq(reference.GenerateCiphertext(plaintext)));
+    }
+  }
+}
+
+TEST(StreamingAeadPushEncrypterTest, ReleasesSegmentsOnceNotLast) {
+  std::unique_ptr<StreamingAead::PushEncrypter> encrypter = NewPushEncrypter();
+  const int first_segment_size =
+      kPlaintextSegmentSize - kHeaderSize - kCiphertextOffset;
+  std::string ciphertext;
+  ASSERT_THAT(encrypter->Update(std::string(first_segment_size, 'a'),
+                                &ciphertext),
+              IsOk());
+  // The first segment might still be the last one.
+  EXPECT_THAT(ciphertext.size(), Eq(kHeaderSize));
+  ASSERT_THAT(encrypter->Update("b", &ciphertext), IsOk());
+  EXPECT_THAT(ciphertext.size(),
+              Eq(kHeaderSize + first_segment_size +
+                 DummyStreamSegmentEncrypter::kSegmentTagSize));
+}
+
+TEST(StreamingAeadPushEncrypterTest, FailsAfterFinalize) {
+  std::unique_ptr<StreamingAead::PushEncrypter> encrypter = NewPushEncrypter();
+  std::string ciphertext;
+  ASSERT_THAT(encrypter->Finalize(&ciphertext), IsOk());
+  EXPECT_THAT(encrypter->Update("a", &ciphertext),
+              StatusIs(absl::StatusCode::kFailedPrecondition));
+  EXPECT_THAT(encrypter->Finalize(&ciphertext),
+              StatusIs(absl::StatusCode::kFailedPrecondition));
+}
+
+TEST(StreamingAeadPushEncrypterTest, InvalidArguments) {
+  EXPECT_THAT(StreamingAeadPushEncrypter::New(nullptr).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  std::unique_ptr<StreamingAead::PushEncrypter> encrypter = NewPushEncrypter();
+  EXPECT_THAT(encrypter->Update("a", nullptr),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  std::string ciphertext;
+  EXPECT_THAT(encrypter->Update("a", &ciphertext), IsOk());
+  EXPECT_THAT(ciphertext, Not(IsEmpty()));
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -16,12 +16,17 @@
 #include "tink/subtle/streaming_aead_test_util.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <cstring>
 #include <memory>
 #include <sstream>
 #include <string>
 #include <utility>
 
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
 #include "tink/internal/test_random_access_stream.h"
 #include "tink/random_access_stream.h"
 #include "tink/subtle/test_util.h"
@@ -29,6 +34,7 @@
 #include "tink/util/istream_input_stream.h"
 #include "tink/util/ostream_output_stream.h"
 #include "tink/util/status.h"
+#include "tink/util/statusor.h"
 
 namespace crypto {
 namespace tink {
@@ -74,6 +80,69 @@ Status ReadAndVerifyFragment(RandomAccessStream* ras, int pos, int count,
   return util::OkStatus();
 }
 
+// Feeds 'input' in chunks of 'chunk_size' bytes to 'update', then calls
+// 'finalize', and returns the concatenated output.
+template <typename PushCipher>
+util::StatusOr<std::string> PushInChunks(PushCipher* cipher,
+                                         absl::string_view input,
+                                         int chunk_size) {
+  std::string output;
+  for (size_t pos = 0; pos < input.size(); pos += chunk_size) {
+    Status status = cipher->Update(input.substr(pos, chunk_size), &output);
+    if (!status.ok()) return status;
+  }
+  Status status = cipher->Finalize(&output);
+  if (!status.ok()) return status;
+  return output;
+}
+
+// Checks that the push-style API interoperates with the streams: decrypts
+// 'ciphertext' (without offset) with a PushDecrypter, and decrypts the
+// output of a PushEncrypter with a decrypting stream.
+Status CheckPushEncryptionAndDecryption(StreamingAead* encrypter,
+                                        StreamingAead* decrypter,
+                                        absl::string_view plaintext,
+                                        absl::string_view associated_data,
+                                        absl::string_view ciphertext) {
+  // Odd chunk sizes make segment boundaries fall inside chunks.
+  constexpr int kChunkSize = 7;
+  util::StatusOr<std::unique_ptr<StreamingAead::PushDecrypter>>
+      push_decrypter = decrypter->NewPushDecrypter(associated_data);
+  if (absl::IsUnimplemented(push_decrypter.status())) {
+    return util::OkStatus();
+  }
+  if (!push_decrypter.ok()) return push_decrypter.status();
+  util::StatusOr<std::string> decrypted =
+      PushInChunks(push_decrypter->get(), ciphertext, kChunkSize);
+  if (!decrypted.ok()) return decrypted.status();
+  if (*decrypted != plaintext) {
+    return Status(absl::StatusCode::kInternal,
+                  "Push-style decryption differs from plaintext.");
+  }
+
+  util::StatusOr<std::unique_ptr<StreamingAead::PushEncrypter>>
+      push_encrypter = encrypter->NewPushEncrypter(associated_data);
+  if (!push_encrypter.ok()) return push_encrypter.status();
+  util::StatusOr<std::string> push_ciphertext =
+      PushInChunks(push_encrypter->get(), plaintext, kChunkSize);
+  if (!push_ciphertext.ok()) return push_ciphertext.status();
+  auto dec_stream_result = decrypter->NewDecryptingStream(
+      absl::make_unique<IstreamInputStream>(
+          absl::make_unique<std::stringstream>(*push_ciphertext)),
+      associated_data);
+  if (!dec_stream_result.ok()) return dec_stream_result.status();
+  std::string stream_decrypted;
+  Status status = subtle::test::ReadFromStream(dec_stream_result->get(),
+                                               &stream_decrypted);
+  if (!status.ok()) return status;
+  if (stream_decrypted != plaintext) {
+    return Status(absl::StatusCode::kInternal,
+                  "Decryption of push-style encryption differs from "
+                  "plaintext.");
+  }
+  return util::OkStatus();
+}
+
 }  // namespace
 
 crypto::tink::util::Status EncryptThenDecrypt(StreamingAead* encrypter,
@@ -148,7 +217,42 @@ crypto::tink::util::Status EncryptThenDecrypt(StreamingAead* encrypter,
       }
     }
   }
-  return crypto::tink::util::OkStatus();
+
+  // Authenticate the ciphertext without decrypting it.
+  int64_t first_invalid_segment = 0;
+  status = decrypter->VerifyCiphertext(
+      std::make_unique<TestRandomAccessStream>(std::string(ct_buf->str())),
+      associated_data, &first_invalid_segment);
+  if (!status.ok()) {
+    return Status(absl::StatusCode::kInternal,
+                  absl::StrCat("Verification failed at segment ",
+                               first_invalid_segment,
+                               " with status: ", status.ToString()));
+  }
+
+  std::string ciphertext = ct_buf->str();
+  return CheckPushEncryptionAndDecryption(
+      encrypter, decrypter, plaintext, associated_data,
+      absl::string_view(ciphertext).substr(ciphertext_offset));
+}
+
+crypto::tink::util::StatusOr<std::string> EncryptToString(
+    StreamingAead* encrypter, absl::string_view plaintext,
+    absl::string_view associated_data, int ciphertext_offset) {
+  auto ct_stream = absl::make_unique<std::stringstream>();
+  auto ct_buf = ct_stream->rdbuf();
+  auto ct_destination =
+      absl::make_unique<OstreamOutputStream>(std::move(ct_stream));
+  auto status = subtle::test::WriteToStream(
+      ct_destination.get(), std::string(ciphertext_offset, 'o'), false);
+  if (!status.ok()) return status;
+  auto enc_stream_result = encrypter->NewEncryptingStream(
+      std::move(ct_destination), associated_data);
+  if (!enc_stream_result.ok()) return enc_stream_result.status();
+  status = subtle::test::WriteToStream(enc_stream_result.value().get(),
+                                       plaintext);
+  if (!status.ok()) return status;
+  return ct_buf->str();
 }
 
 }  // namespace tink
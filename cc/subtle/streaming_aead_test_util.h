@@ -17,15 +17,21 @@
 #ifndef TINK_SUBTLE_STREAMING_AEAD_TEST_UTIL_H_
 #define TINK_SUBTLE_STREAMING_AEAD_TEST_UTIL_H_
 
+#include <string>
+
 #include "absl/strings/string_view.h"
 #include "tink/streaming_aead.h"
 #include "tink/util/status.h"
+#include "tink/util/statusor.h"
 
 namespace crypto {
 namespace tink {
 
 // Encrypt with NewEncryptingStream, then decrypt using NewDecryptingStream,
-// and NewDecryptingRandomAccessStream (for a few fragments).
+// and NewDecryptingRandomAccessStream (for a few fragments), and check that
+// VerifyCiphertext accepts the ciphertext. If the primitives support it, also
+// checks that push-style encryption and decryption interoperate with the
+// streams.
 // 'ciphertext_offset' is the offset of the actual ciphertext in the
 // computed ciphertext stream (cf. description of StreamSegmentEncrypter
 // in stream_segment_encrypter.h).
@@ -37,6 +43,13 @@ crypto::tink::util::Status EncryptThenDecrypt(StreamingAead* encrypter,
                                               absl::string_view associated_data,
                                               int ciphertext_offset);
 
+// Encrypts 'plaintext' with NewEncryptingStream and returns the resulting
+// ciphertext stream, preceded by 'ciphertext_offset' bytes, i.e., in the form
+// expected by NewDecryptingRandomAccessStream and VerifyCiphertext.
+crypto::tink::util::StatusOr<std::string> EncryptToString(
+    StreamingAead* encrypter, absl::string_view plaintext,
+    absl::string_view associated_data, int ciphertext_offset);
+
 }  // namespace tink
 }  // namespace crypto
 
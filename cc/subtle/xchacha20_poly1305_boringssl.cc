@@ -17,7 +17,9 @@
 #include "tink/subtle/xchacha20_poly1305_boringssl.h"
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <utility>
@@ -30,6 +32,7 @@
 #include "absl/types/span.h"
 #include "tink/aead.h"
 #include "tink/aead/internal/ssl_aead.h"
+#include "tink/internal/fragments.h"
 #include "tink/internal/util.h"
 #include "tink/subtle/random.h"
 #include "tink/subtle/subtle_util.h"
@@ -104,6 +107,146 @@ util::StatusOr<std::string> XChacha20Poly1305BoringSsl::Decrypt(
   return plaintext;
 }
 
+util::StatusOr<std::vector<std::string>>
+XChacha20Poly1305BoringSsl::EncryptBatch(
+    absl::Span<const absl::string_view> plaintexts,
+    absl::Span<const absl::string_view> associated_data) const {
+  if (plaintexts.size() != associated_data.size()) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "Number of plaintexts and associated data differ");
+  }
+  std::string nonces;
+  ResizeStringUninitialized(&nonces, kNonceSizeInBytes * plaintexts.size());
+  util::Status res = Random::GetRandomBytes(absl::MakeSpan(nonces));
+  if (!res.ok()) {
+    return res;
+  }
+  std::vector<std::string> ciphertexts(plaintexts.size());
+  std::vector<absl::string_view> nonce_views(plaintexts.size());
+  std::vector<absl::Span<char>> buffers(plaintexts.size());
+  for (size_t i = 0; i < plaintexts.size(); ++i) {
+    std::string& ct = ciphertexts[i];
+    ResizeStringUninitialized(
+        &ct, kNonceSizeInBytes + aead_->CiphertextSize(plaintexts[i].size()));
+    std::memcpy(&ct[0], &nonces[i * kNonceSizeInBytes], kNonceSizeInBytes);
+    nonce_views[i] = absl::string_view(ct).substr(0, kNonceSizeInBytes);
+    buffers[i] = absl::MakeSpan(ct).subspan(kNonceSizeInBytes);
+  }
+  util::StatusOr<std::vector<int64_t>> written_bytes =
+      aead_->EncryptBatch(plaintexts, associated_data, nonce_views, buffers);
+  if (!written_bytes.ok()) {
+    return written_bytes.status();
+  }
+  return ciphertexts;
+}
+
+util::StatusOr<std::vector<util::StatusOr<std::string>>>
+XChacha20Poly1305BoringSsl::DecryptBatch(
+    absl::Span<const absl::string_view> ciphertexts,
+    absl::Span<const absl::string_view> associated_data) const {
+  if (ciphertexts.size() != associated_data.size()) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        "Number of ciphertexts and associated data differ");
+  }
+  std::vector<util::StatusOr<std::string>> results(ciphertexts.size());
+  std::vector<std::string> plaintexts(ciphertexts.size());
+
+  // Ciphertexts that are long enough are decrypted in one batch.
+  std::vector<size_t> indices;
+  std::vector<absl::string_view> encrypted;
+  std::vector<absl::string_view> batch_associated_data;
+  std::vector<absl::string_view> nonces;
+  std::vector<absl::Span<char>> buffers;
+  for (size_t i = 0; i < ciphertexts.size(); ++i) {
+    absl::string_view ciphertext = ciphertexts[i];
+    if (ciphertext.size() < kNonceSizeInBytes + kTagSizeInBytes) {
+      results[i] = util::Status(
+          absl::StatusCode::kInvalidArgument,
+          absl::StrCat("Ciphertext too short; expected at least ",
+                       kNonceSizeInBytes + kTagSizeInBytes, " got ",
+                       ciphertext.size()));
+      continue;
+    }
+    ResizeStringUninitialized(
+        &plaintexts[i],
+        aead_->PlaintextSize(ciphertext.size() - kNonceSizeInBytes));
+    indices.push_back(i);
+    nonces.push_back(ciphertext.substr(0, kNonceSizeInBytes));
+    encrypted.push_back(ciphertext.substr(kNonceSizeInBytes));
+    batch_associated_data.push_back(associated_data[i]);
+    buffers.push_back(absl::MakeSpan(plaintexts[i]));
+  }
+  util::StatusOr<std::vector<util::StatusOr<int64_t>>> written_bytes =
+      aead_->DecryptBatch(encrypted, batch_associated_data, nonces, buffers);
+  if (!written_bytes.ok()) {
+    return written_bytes.status();
+  }
+  for (size_t j = 0; j < indices.size(); ++j) {
+    const size_t i = indices[j];
+    if ((*written_bytes)[j].ok()) {
+      results[i] = std::move(plaintexts[i]);
+    } else {
+      results[i] = (*written_bytes)[j].status();
+    }
+  }
+  return results;
+}
+
+util::StatusOr<int64_t> XChacha20Poly1305BoringSsl::MaxEncryptionSize(
+    int64_t plaintext_size) const {
+  return kNonceSizeInBytes + aead_->CiphertextSize(plaintext_size);
+}
+
+util::StatusOr<int64_t> XChacha20Poly1305BoringSsl::EncryptFragments(
+    absl::Span<const absl::string_view> plaintext,
+    absl::string_view associated_data,
+    absl::Span<const absl::Span<char>> ciphertext) const {
+  const int64_t ciphertext_size =
+      kNonceSizeInBytes +
+      aead_->CiphertextSize(internal::FragmentsSize(plaintext));
+  const int64_t buffer_size = internal::FragmentsSize(ciphertext);
+  if (buffer_size < ciphertext_size) {
+    return util::Status(
+        absl::StatusCode::kInvalidArgument,
+        absl::StrCat("Ciphertext fragments too small; expected at least ",
+                     ciphertext_size, " bytes, got ", buffer_size));
+  }
+  std::string nonce;
+  ResizeStringUninitialized(&nonce, kNonceSizeInBytes);
+  util::Status res = Random::GetRandomBytes(absl::MakeSpan(nonce));
+  if (!res.ok()) {
+    return res;
+  }
+  internal::CopyToFragments(nonce, ciphertext);
+  util::StatusOr<int64_t> written_bytes = aead_->EncryptFragments(
+      plaintext, associated_data, nonce,
+      internal::SubFragments(ciphertext, kNonceSizeInBytes,
+                             buffer_size - kNonceSizeInBytes));
+  if (!written_bytes.ok()) {
+    return written_bytes.status();
+  }
+  return kNonceSizeInBytes + *written_bytes;
+}
+
+util::StatusOr<int64_t> XChacha20Poly1305BoringSsl::DecryptFragments(
+    absl::Span<const absl::string_view> ciphertext,
+    absl::string_view associated_data,
+    absl::Span<const absl::Span<char>> plaintext) const {
+  const int64_t ciphertext_size = internal::FragmentsSize(ciphertext);
+  if (ciphertext_size < kNonceSizeInBytes + kTagSizeInBytes) {
+    return util::Status(absl::StatusCode::kInvalidArgument,
+                        absl::StrCat("Ciphertext too short; expected at least ",
+                                     kNonceSizeInBytes + kTagSizeInBytes,
+                                     " got ", ciphertext_size));
+  }
+  std::string nonce(kNonceSizeInBytes, '\0');
+  internal::CopyFromFragments(ciphertext, absl::MakeSpan(nonce));
+  return aead_->DecryptFragments(
+      internal::SubFragments(ciphertext, kNonceSizeInBytes,
+                             ciphertext_size - kNonceSizeInBytes),
+      associated_data, nonce, plaintext);
+}
+
 }  // namespace subtle
 }  // namespace tink
 }  // namespace crypto
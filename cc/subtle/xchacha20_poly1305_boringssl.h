@@ -17,11 +17,14 @@
 #ifndef TINK_SUBTLE_XCHACHA20_POLY1305_BORINGSSL_H_
 #define TINK_SUBTLE_XCHACHA20_POLY1305_BORINGSSL_H_
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "tink/aead.h"
 #include "tink/aead/internal/ssl_aead.h"
 #include "tink/internal/fips_utils.h"
@@ -50,6 +53,33 @@ class XChacha20Poly1305BoringSsl : public Aead {
       absl::string_view ciphertext,
       absl::string_view associated_data) const override;
 
+  // Draws the nonces of the whole batch with a single call to the RNG and
+  // seals all messages with one SslOneShotAead::EncryptBatch() call.
+  crypto::tink::util::StatusOr<std::vector<std::string>> EncryptBatch(
+      absl::Span<const absl::string_view> plaintexts,
+      absl::Span<const absl::string_view> associated_data) const override;
+
+  crypto::tink::util::StatusOr<
+      std::vector<crypto::tink::util::StatusOr<std::string>>>
+  DecryptBatch(absl::Span<const absl::string_view> ciphertexts,
+               absl::Span<const absl::string_view> associated_data)
+      const override;
+
+  crypto::tink::util::StatusOr<int64_t> MaxEncryptionSize(
+      int64_t plaintext_size) const override;
+
+  // Writes the nonce to the first fragments and encrypts the rest with
+  // SslOneShotAead::EncryptFragments().
+  crypto::tink::util::StatusOr<int64_t> EncryptFragments(
+      absl::Span<const absl::string_view> plaintext,
+      absl::string_view associated_data,
+      absl::Span<const absl::Span<char>> ciphertext) const override;
+
+  crypto::tink::util::StatusOr<int64_t> DecryptFragments(
+      absl::Span<const absl::string_view> ciphertext,
+      absl::string_view associated_data,
+      absl::Span<const absl::Span<char>> plaintext) const override;
+
   static constexpr crypto::tink::internal::FipsCompatibility kFipsStatus =
       crypto::tink::internal::FipsCompatibility::kNotFips;
 
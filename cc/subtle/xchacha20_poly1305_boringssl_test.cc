@@ -16,6 +16,7 @@
 
 #include "tink/subtle/xchacha20_poly1305_boringssl.h"
 
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <vector>
@@ -25,6 +26,8 @@
 #include "absl/status/status.h"
 #include "absl/strings/escaping.h"
 #include "absl/strings/str_cat.h"
+#include "absl/types/span.h"
+#include "absl/strings/string_view.h"
 #include "tink/aead/internal/wycheproof_aead.h"
 #include "tink/config/tink_fips.h"
 #include "tink/internal/ssl_util.h"
@@ -48,6 +51,7 @@ constexpr absl::string_view kMessage = "Some data to encrypt.";
 constexpr absl::string_view kAssociatedData = "Some data to authenticate.";
 
 using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::IsOkAndHolds;
 using ::crypto::tink::test::StatusIs;
 using ::testing::AllOf;
 using ::testing::Eq;
@@ -83,6 +87,30 @@ TEST(XChacha20Poly1305BoringSslTest, EncryptDecrypt) {
   }
 }
 
+TEST(XChacha20Poly1305BoringSslTest, EncryptWithPrefix) {
+  if (!internal::IsBoringSsl()) {
+    GTEST_SKIP() << "Unimplemented with OpenSSL";
+  }
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+
+  util::StatusOr<std::unique_ptr<Aead>> aead = XChacha20Poly1305BoringSsl::New(
+      util::SecretDataFromStringView(absl::HexStringToBytes(kKey256Hex)));
+  ASSERT_THAT(aead, IsOk());
+
+  util::StatusOr<std::string> ciphertext =
+      (*aead)->EncryptWithPrefix("prefix", kMessage, kAssociatedData);
+  ASSERT_THAT(ciphertext, IsOk());
+  ASSERT_THAT(*ciphertext, SizeIs(6 + kMessage.size() + kNonceSizeInBytes +
+                                  kTagSizeInBytes));
+  EXPECT_EQ(ciphertext->substr(0, 6), "prefix");
+  util::StatusOr<std::string> plaintext =
+      (*aead)->Decrypt(ciphertext->substr(6), kAssociatedData);
+  ASSERT_THAT(plaintext, IsOk());
+  EXPECT_EQ(*plaintext, kMessage);
+}
+
 // Test decryption with a known ciphertext, message, associated_data and key
 // tuple to make sure this is using the correct algorithm. The values are taken
 // from the test vector tcId 1 of the Wycheproof tests:
@@ -145,6 +173,97 @@ TEST(XChacha20Poly1305BoringSslTest, DecryptFailsIfCiphertextTooSmall) {
   }
 }
 
+TEST(XChacha20Poly1305BoringSslTest, EncryptBatchDecryptBatch) {
+  if (!internal::IsBoringSsl()) {
+    GTEST_SKIP() << "Unimplemented with OpenSSL";
+  }
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+
+  util::SecretData key =
+      util::SecretDataFromStringView(absl::HexStringToBytes(kKey256Hex));
+  util::StatusOr<std::unique_ptr<Aead>> aead =
+      XChacha20Poly1305BoringSsl::New(key);
+  ASSERT_THAT(aead, IsOk());
+
+  std::vector<std::string> messages;
+  std::vector<std::string> associated_data;
+  for (int i = 0; i < 20; ++i) {
+    messages.push_back(std::string(i * 7, 'a' + i));
+    associated_data.push_back(absl::StrCat(kAssociatedData, i));
+  }
+  std::vector<absl::string_view> message_views(messages.begin(),
+                                               messages.end());
+  std::vector<absl::string_view> associated_data_views(associated_data.begin(),
+                                                       associated_data.end());
+  util::StatusOr<std::vector<std::string>> ciphertexts =
+      (*aead)->EncryptBatch(message_views, associated_data_views);
+  ASSERT_THAT(ciphertexts, IsOk());
+  ASSERT_THAT(*ciphertexts, SizeIs(messages.size()));
+  for (size_t i = 0; i < messages.size(); ++i) {
+    EXPECT_THAT((*aead)->Decrypt((*ciphertexts)[i], associated_data[i]),
+                IsOkAndHolds(messages[i]));
+  }
+
+  // Corrupt one ciphertext and truncate another.
+  (*ciphertexts)[3].back() ^= 1;
+  (*ciphertexts)[5].resize(kNonceSizeInBytes + kTagSizeInBytes - 1);
+  std::vector<absl::string_view> ciphertext_views(ciphertexts->begin(),
+                                                  ciphertexts->end());
+  util::StatusOr<std::vector<util::StatusOr<std::string>>> plaintexts =
+      (*aead)->DecryptBatch(ciphertext_views, associated_data_views);
+  ASSERT_THAT(plaintexts, IsOk());
+  ASSERT_THAT(*plaintexts, SizeIs(messages.size()));
+  for (size_t i = 0; i < messages.size(); ++i) {
+    if (i == 3) {
+      EXPECT_THAT((*plaintexts)[i], Not(IsOk()));
+    } else if (i == 5) {
+      EXPECT_THAT((*plaintexts)[i].status(),
+                  StatusIs(absl::StatusCode::kInvalidArgument));
+    } else {
+      EXPECT_THAT((*plaintexts)[i], IsOkAndHolds(messages[i]));
+    }
+  }
+
+  EXPECT_THAT((*aead)->EncryptBatch(message_views, {}).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT((*aead)->DecryptBatch(ciphertext_views, {}).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(XChacha20Poly1305BoringSslTest, EncryptDecryptFragments) {
+  if (!internal::IsBoringSsl()) {
+    GTEST_SKIP() << "Unimplemented with OpenSSL";
+  }
+  if (IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+
+  util::StatusOr<std::unique_ptr<Aead>> aead = XChacha20Poly1305BoringSsl::New(
+      util::SecretDataFromStringView(absl::HexStringToBytes(kKey256Hex)));
+  ASSERT_THAT(aead, IsOk());
+
+  std::string ciphertext(kMessage.size() + kNonceSizeInBytes + kTagSizeInBytes, '\0');
+  absl::Span<char> buffer = absl::MakeSpan(ciphertext);
+  EXPECT_THAT(
+      (*aead)->EncryptFragments({kMessage.substr(0, 4), kMessage.substr(4)},
+                                kAssociatedData,
+                                {buffer.subspan(0, 5), buffer.subspan(5)}),
+      IsOkAndHolds(ciphertext.size()));
+  EXPECT_THAT((*aead)->Decrypt(ciphertext, kAssociatedData),
+              IsOkAndHolds(std::string(kMessage)));
+
+  absl::string_view ct = ciphertext;
+  std::string plaintext(kMessage.size(), '\0');
+  absl::Span<char> out = absl::MakeSpan(plaintext);
+  EXPECT_THAT((*aead)->DecryptFragments({ct.substr(0, 9), ct.substr(9)},
+                                        kAssociatedData,
+                                        {out.subspan(0, 2), out.subspan(2)}),
+              IsOkAndHolds(kMessage.size()));
+  EXPECT_EQ(plaintext, kMessage);
+}
+
 TEST(XChacha20Poly1305BoringSslTest, FailisOnFipsOnlyMode) {
   if (!internal::IsBoringSsl()) {
     GTEST_SKIP() << "Unimplemented with OpenSSL";
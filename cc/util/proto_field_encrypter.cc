@@ -0,0 +1,345 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/util/proto_field_encrypter.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/cleanup/cleanup.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "google/protobuf/arena.h"
+#include "google/protobuf/descriptor.h"
+#include "google/protobuf/field_mask.pb.h"
+#include "google/protobuf/message.h"
+#include "tink/aead.h"
+#include "tink/deterministic_aead.h"
+#include "tink/subtle/subtle_util.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+
+namespace {
+
+using ::google::protobuf::Descriptor;
+using ::google::protobuf::FieldDescriptor;
+using ::google::protobuf::FieldMask;
+using ::google::protobuf::Message;
+using ::google::protobuf::Reflection;
+
+void SelectFieldsRecursive(
+    const Descriptor* descriptor, const std::string& prefix,
+    const std::function<bool(const FieldDescriptor&)>& is_selected,
+    std::vector<const Descriptor*>* enclosing, FieldMask* mask) {
+  enclosing->push_back(descriptor);
+  for (int i = 0; i < descriptor->field_count(); ++i) {
+    const FieldDescriptor* field = descriptor->field(i);
+    if (field->is_map()) continue;
+    std::string path = prefix.empty()
+                           ? field->name()
+                           : absl::StrCat(prefix, ".", field->name());
+    if (field->type() == FieldDescriptor::TYPE_BYTES) {
+      if (is_selected(*field)) mask->add_paths(path);
+    } else if (field->type() == FieldDescriptor::TYPE_MESSAGE &&
+               std::find(enclosing->begin(), enclosing->end(),
+                         field->message_type()) == enclosing->end()) {
+      SelectFieldsRecursive(field->message_type(), path, is_selected,
+                            enclosing, mask);
+    }
+  }
+  enclosing->pop_back();
+}
+
+// Associated data of a value in field path `path`: the length of the path as
+// a 4-byte big-endian integer, the path, and the caller's associated data.
+std::string FieldAssociatedData(absl::string_view path,
+                                absl::string_view associated_data) {
+  return absl::StrCat(subtle::BigEndian32(path.size()), path,
+                      associated_data);
+}
+
+// Appends a slot for every present value of `fields.back()` in `message`,
+// descending through `fields[depth]`.
+template <typename Slot>
+void CollectSlots(Message* message,
+                  const std::vector<const FieldDescriptor*>& fields,
+                  size_t depth, size_t associated_data_index,
+                  std::vector<Slot>* slots) {
+  const FieldDescriptor* field = fields[depth];
+  const Reflection* reflection = message->GetReflection();
+  bool last = depth + 1 == fields.size();
+  if (field->is_repeated()) {
+    int size = reflection->FieldSize(*message, field);
+    for (int i = 0; i < size; ++i) {
+      if (last) {
+        slots->push_back({message, field, i, associated_data_index});
+      } else {
+        CollectSlots(reflection->MutableRepeatedMessage(message, field, i),
+                     fields, depth + 1, associated_data_index, slots);
+      }
+    }
+  } else if (reflection->HasField(*message, field)) {
+    if (last) {
+      slots->push_back({message, field, -1, associated_data_index});
+    } else {
+      CollectSlots(reflection->MutableMessage(message, field), fields,
+                   depth + 1, associated_data_index, slots);
+    }
+  }
+}
+
+}  // namespace
+
+FieldMask ProtoFieldEncrypter::SelectFields(
+    const Descriptor* descriptor,
+    const std::function<bool(const FieldDescriptor&)>& is_selected) {
+  FieldMask mask;
+  std::vector<const Descriptor*> enclosing;
+  SelectFieldsRecursive(descriptor, "", is_selected, &enclosing, &mask);
+  return mask;
+}
+
+StatusOr<std::vector<ProtoFieldEncrypter::FieldPath>>
+ProtoFieldEncrypter::ResolvePaths(const Descriptor* descriptor,
+                                  const FieldMask& fields) {
+  if (descriptor == nullptr) {
+    return Status(absl::StatusCode::kInvalidArgument,
+                  "descriptor must be non-null");
+  }
+  if (fields.paths_size() == 0) {
+    return Status(absl::StatusCode::kInvalidArgument, "No fields selected");
+  }
+  absl::flat_hash_set<std::string> seen;
+  std::vector<FieldPath> paths;
+  paths.reserve(fields.paths_size());
+  for (const std::string& name : fields.paths()) {
+    if (!seen.insert(name).second) {
+      return Status(absl::StatusCode::kInvalidArgument,
+                    absl::StrCat("Duplicate field path '", name, "'"));
+    }
+    FieldPath path;
+    path.name = name;
+    const Descriptor* current = descriptor;
+    std::vector<absl::string_view> parts = absl::StrSplit(name, '.');
+    for (size_t i = 0; i < parts.size(); ++i) {
+      const FieldDescriptor* field =
+          current->FindFieldByName(std::string(parts[i]));
+      if (field == nullptr) {
+        return Status(absl::StatusCode::kInvalidArgument,
+                      absl::StrCat("Unknown field '", parts[i], "' in path '",
+                                   name, "'"));
+      }
+      if (field->is_map()) {
+        return Status(absl::StatusCode::kInvalidArgument,
+                      absl::StrCat("Map field '", parts[i], "' in path '",
+                                   name, "' is not supported"));
+      }
+      bool last = i + 1 == parts.size();
+      if (last && field->type() != FieldDescriptor::TYPE_BYTES) {
+        return Status(absl::StatusCode::kInvalidArgument,
+                      absl::StrCat("Field path '", name,
+                                   "' does not end in a bytes field"));
+      }
+      if (!last && field->type() != FieldDescriptor::TYPE_MESSAGE) {
+        return Status(absl::StatusCode::kInvalidArgument,
+                      absl::StrCat("Field '", parts[i], "' in path '", name,
+                                   "' is not a message field"));
+      }
+      path.fields.push_back(field);
+      current = field->message_type();
+    }
+    paths.push_back(std::move(path));
+  }
+  return paths;
+}
+
+StatusOr<std::unique_ptr<ProtoFieldEncrypter>> ProtoFieldEncrypter::New(
+    const Descriptor* descriptor, const FieldMask& fields,
+    std::unique_ptr<Aead> aead) {
+  if (aead == nullptr) {
+    return Status(absl::StatusCode::kInvalidArgument,
+                  "aead must be non-null");
+  }
+  StatusOr<std::vector<FieldPath>> paths = ResolvePaths(descriptor, fields);
+  if (!paths.ok()) return paths.status();
+  return absl::WrapUnique(new ProtoFieldEncrypter(
+      descriptor, *std::move(paths), std::move(aead), nullptr));
+}
+
+StatusOr<std::unique_ptr<ProtoFieldEncrypter>> ProtoFieldEncrypter::New(
+    const Descriptor* descriptor, const FieldMask& fields,
+    std::unique_ptr<DeterministicAead> daead) {
+  if (daead == nullptr) {
+    return Status(absl::StatusCode::kInvalidArgument,
+                  "daead must be non-null");
+  }
+  StatusOr<std::vector<FieldPath>> paths = ResolvePaths(descriptor, fields);
+  if (!paths.ok()) return paths.status();
+  return absl::WrapUnique(new ProtoFieldEncrypter(
+      descriptor, *std::move(paths), nullptr, std::move(daead)));
+}
+
+StatusOr<Message*> ProtoFieldEncrypter::Encrypt(
+    const Message& message, absl::string_view associated_data,
+    google::protobuf::Arena* arena) const {
+  const Message* messages[] = {&message};
+  StatusOr<std::vector<Message*>> result =
+      Process(messages, {associated_data}, arena, /*encrypt=*/true);
+  if (!result.ok()) return result.status();
+  return result->front();
+}
+
+StatusOr<Message*> ProtoFieldEncrypter::Decrypt(
+    const Message& message, absl::string_view associated_data,
+    google::protobuf::Arena* arena) const {
+  const Message* messages[] = {&message};
+  StatusOr<std::vector<Message*>> result =
+      Process(messages, {associated_data}, arena, /*encrypt=*/false);
+  if (!result.ok()) return result.status();
+  return result->front();
+}
+
+StatusOr<std::vector<Message*>> ProtoFieldEncrypter::EncryptBatch(
+    absl::Span<const Message* const> messages,
+    absl::Span<const absl::string_view> associated_data,
+    google::protobuf::Arena* arena) const {
+  return Process(messages, associated_data, arena, /*encrypt=*/true);
+}
+
+StatusOr<std::vector<Message*>> ProtoFieldEncrypter::DecryptBatch(
+    absl::Span<const Message* const> messages,
+    absl::Span<const absl::string_view> associated_data,
+    google::protobuf::Arena* arena) const {
+  return Process(messages, associated_data, arena, /*encrypt=*/false);
+}
+
+StatusOr<std::vector<Message*>> ProtoFieldEncrypter::Process(
+    absl::Span<const Message* const> messages,
+    absl::Span<const absl::string_view> associated_data,
+    google::protobuf::Arena* arena, bool encrypt) const {
+  if (messages.size() != associated_data.size()) {
+    return Status(absl::StatusCode::kInvalidArgument,
+                  "Number of messages and associated data differ");
+  }
+  for (const Message* message : messages) {
+    if (message == nullptr || message->GetDescriptor() != descriptor_) {
+      return Status(absl::StatusCode::kInvalidArgument,
+                    absl::StrCat("Expected a message of type ",
+                                 descriptor_->full_name()));
+    }
+  }
+
+  std::vector<Message*> outputs;
+  outputs.reserve(messages.size());
+  auto delete_outputs = absl::MakeCleanup([&outputs, arena] {
+    if (arena == nullptr) {
+      for (Message* output : outputs) delete output;
+    }
+  });
+  std::vector<std::string> field_associated_data;
+  field_associated_data.reserve(messages.size() * paths_.size());
+  std::vector<Slot> slots;
+  for (size_t i = 0; i < messages.size(); ++i) {
+    Message* output = messages[i]->New(arena);
+    outputs.push_back(output);
+    output->CopyFrom(*messages[i]);
+    for (const FieldPath& path : paths_) {
+      CollectSlots(output, path.fields, 0, field_associated_data.size(),
+                   &slots);
+      field_associated_data.push_back(
+          FieldAssociatedData(path.name, associated_data[i]));
+    }
+  }
+
+  // Views of the current values. Cord fields are copied into `scratch`.
+  std::vector<std::string> scratch(slots.size());
+  std::vector<absl::string_view> inputs;
+  std::vector<absl::string_view> inputs_associated_data;
+  inputs.reserve(slots.size());
+  inputs_associated_data.reserve(slots.size());
+  for (size_t i = 0; i < slots.size(); ++i) {
+    const Slot& slot = slots[i];
+    const Reflection* reflection = slot.message->GetReflection();
+    inputs.push_back(
+        slot.index < 0
+            ? reflection->GetStringReference(*slot.message, slot.field,
+                                             &scratch[i])
+            : reflection->GetRepeatedStringReference(
+                  *slot.message, slot.field, slot.index, &scratch[i]));
+    inputs_associated_data.push_back(
+        field_associated_data[slot.associated_data_index]);
+  }
+
+  std::vector<std::string> results;
+  if (aead_ != nullptr && encrypt) {
+    StatusOr<std::vector<std::string>> ciphertexts =
+        aead_->EncryptBatch(inputs, inputs_associated_data);
+    if (!ciphertexts.ok()) return ciphertexts.status();
+    results = *std::move(ciphertexts);
+  } else if (aead_ != nullptr) {
+    StatusOr<std::vector<StatusOr<std::string>>> plaintexts =
+        aead_->DecryptBatch(inputs, inputs_associated_data);
+    if (!plaintexts.ok()) return plaintexts.status();
+    results.reserve(plaintexts->size());
+    for (StatusOr<std::string>& plaintext : *plaintexts) {
+      if (!plaintext.ok()) return plaintext.status();
+      results.push_back(*std::move(plaintext));
+    }
+  } else {
+    results.reserve(inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      StatusOr<std::string> result =
+          encrypt ? daead_->EncryptDeterministically(inputs[i],
+                                                     inputs_associated_data[i])
+                  : daead_->DecryptDeterministically(
+                        inputs[i], inputs_associated_data[i]);
+      if (!result.ok()) return result.status();
+      results.push_back(*std::move(result));
+    }
+  }
+
+  for (size_t i = 0; i < slots.size(); ++i) {
+    const Slot& slot = slots[i];
+    const Reflection* reflection = slot.message->GetReflection();
+    if (slot.index < 0) {
+      reflection->SetString(slot.message, slot.field, std::move(results[i]));
+    } else {
+      reflection->SetRepeatedString(slot.message, slot.field, slot.index,
+                                    std::move(results[i]));
+    }
+  }
+  std::move(delete_outputs).Cancel();
+  return outputs;
+}
+
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
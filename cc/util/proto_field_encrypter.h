@@ -0,0 +1,176 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef TINK_UTIL_PROTO_FIELD_ENCRYPTER_H_
+#define TINK_UTIL_PROTO_FIELD_ENCRYPTER_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "google/protobuf/arena.h"
+#include "google/protobuf/descriptor.h"
+#include "google/protobuf/field_mask.pb.h"
+#include "google/protobuf/message.h"
+#include "tink/aead.h"
+#include "tink/deterministic_aead.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+
+// Encrypts and decrypts selected fields of protobuf messages, leaving all
+// other fields in the clear.
+//
+// The encrypted fields are named by a FieldMask over the message type. Each
+// path must end in a field of type `bytes`, which holds the ciphertext after
+// encryption; all other fields on the path must be message fields, which may
+// be repeated (e.g. "records.payload" selects the payload of every element of
+// `records`). Map fields are not supported. Only present values are
+// encrypted: unset fields, and fields with implicit presence that hold the
+// empty string, are left as they are.
+//
+// Every value is encrypted with its field path as part of the associated
+// data, so a ciphertext does not decrypt if it is moved to another field. It
+// may still be moved between elements of the same repeated field, or between
+// messages; callers that need to prevent that pass per-message associated
+// data, such as a record ID.
+//
+// All values of a call, including all messages of a batch, are encrypted with
+// one Aead::EncryptBatch() call. Results are written to new messages that are
+// allocated on the given protobuf arena.
+//
+//   util::StatusOr<std::unique_ptr<ProtoFieldEncrypter>> encrypter =
+//       ProtoFieldEncrypter::New(Record::descriptor(), mask, std::move(aead));
+//   google::protobuf::Arena arena;
+//   util::StatusOr<google::protobuf::Message*> encrypted =
+//       (*encrypter)->Encrypt(record, record_id, &arena);
+//
+// This class is thread-safe.
+class ProtoFieldEncrypter {
+ public:
+  // Returns a FieldMask with the paths of all `bytes` fields reachable from
+  // `descriptor` through singular or repeated message fields, for which
+  // `is_selected` returns true. This selects fields by descriptor options,
+  // e.g. a custom field option that marks sensitive fields:
+  //
+  //   ProtoFieldEncrypter::SelectFields(
+  //       Record::descriptor(),
+  //       [](const google::protobuf::FieldDescriptor& field) {
+  //         return field.options().GetExtension(sensitive);
+  //       });
+  //
+  // Message types that contain themselves are not expanded recursively.
+  static google::protobuf::FieldMask SelectFields(
+      const google::protobuf::Descriptor* descriptor,
+      const std::function<bool(const google::protobuf::FieldDescriptor&)>&
+          is_selected);
+
+  // Returns an encrypter for the fields in `fields` of messages of type
+  // `descriptor`, which uses randomized encryption with `aead`.
+  static crypto::tink::util::StatusOr<std::unique_ptr<ProtoFieldEncrypter>>
+  New(const google::protobuf::Descriptor* descriptor,
+      const google::protobuf::FieldMask& fields, std::unique_ptr<Aead> aead);
+
+  // Returns an encrypter for the fields in `fields` of messages of type
+  // `descriptor`, which uses deterministic encryption with `daead`. Equal
+  // values in the same field path and with the same associated data have
+  // equal ciphertexts, so they can be compared and looked up while encrypted.
+  static crypto::tink::util::StatusOr<std::unique_ptr<ProtoFieldEncrypter>>
+  New(const google::protobuf::Descriptor* descriptor,
+      const google::protobuf::FieldMask& fields,
+      std::unique_ptr<DeterministicAead> daead);
+
+  // Returns a copy of `message`, allocated on `arena`, in which the selected
+  // fields are encrypted with `associated_data`. If `arena` is null, the
+  // caller owns the returned message.
+  crypto::tink::util::StatusOr<google::protobuf::Message*> Encrypt(
+      const google::protobuf::Message& message,
+      absl::string_view associated_data, google::protobuf::Arena* arena) const;
+
+  // Returns a copy of `message`, allocated on `arena`, in which the selected
+  // fields are decrypted with `associated_data`. Fails if any of them does not
+  // decrypt. If `arena` is null, the caller owns the returned message.
+  crypto::tink::util::StatusOr<google::protobuf::Message*> Decrypt(
+      const google::protobuf::Message& message,
+      absl::string_view associated_data, google::protobuf::Arena* arena) const;
+
+  // Like Encrypt(), for `messages[i]` with `associated_data[i]` for every i.
+  // The selected fields of all messages are encrypted in a single batch.
+  crypto::tink::util::StatusOr<std::vector<google::protobuf::Message*>>
+  EncryptBatch(absl::Span<const google::protobuf::Message* const> messages,
+               absl::Span<const absl::string_view> associated_data,
+               google::protobuf::Arena* arena) const;
+
+  // Like Decrypt(), for `messages[i]` with `associated_data[i]` for every i.
+  // Fails if any selected field of any message does not decrypt.
+  crypto::tink::util::StatusOr<std::vector<google::protobuf::Message*>>
+  DecryptBatch(absl::Span<const google::protobuf::Message* const> messages,
+               absl::Span<const absl::string_view> associated_data,
+               google::protobuf::Arena* arena) const;
+
+ private:
+  // A selected field path, resolved against the message type.
+  struct FieldPath {
+    std::vector<const google::protobuf::FieldDescriptor*> fields;
+    std::string name;
+  };
+
+  // A present value of a selected field in an output message.
+  struct Slot {
+    google::protobuf::Message* message;
+    const google::protobuf::FieldDescriptor* field;
+    int index;  // -1 for singular fields.
+    size_t associated_data_index;
+  };
+
+  ProtoFieldEncrypter(const google::protobuf::Descriptor* descriptor,
+                      std::vector<FieldPath> paths,
+                      std::unique_ptr<Aead> aead,
+                      std::unique_ptr<DeterministicAead> daead)
+      : descriptor_(descriptor),
+        paths_(std::move(paths)),
+        aead_(std::move(aead)),
+        daead_(std::move(daead)) {}
+
+  static crypto::tink::util::StatusOr<std::vector<FieldPath>> ResolvePaths(
+      const google::protobuf::Descriptor* descriptor,
+      const google::protobuf::FieldMask& fields);
+
+  crypto::tink::util::StatusOr<std::vector<google::protobuf::Message*>>
+  Process(absl::Span<const google::protobuf::Message* const> messages,
+          absl::Span<const absl::string_view> associated_data,
+          google::protobuf::Arena* arena, bool encrypt) const;
+
+  const google::protobuf::Descriptor* const descriptor_;
+  const std::vector<FieldPath> paths_;
+  // Exactly one of aead_ and daead_ is set.
+  const std::unique_ptr<Aead> aead_;
+  const std::unique_ptr<DeterministicAead> daead_;
+};
+
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_UTIL_PROTO_FIELD_ENCRYPTER_H_
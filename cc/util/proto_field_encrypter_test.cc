@@ -0,0 +1,324 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/util/proto_field_encrypter.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "google/protobuf/arena.h"
+#include "google/protobuf/descriptor.h"
+#include "google/protobuf/field_mask.pb.h"
+#include "google/protobuf/message.h"
+#include "google/protobuf/util/message_differencer.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "tink/aead.h"
+#include "tink/deterministic_aead.h"
+#include "tink/internal/fips_utils.h"
+#include "tink/subtle/aes_gcm_boringssl.h"
+#include "tink/subtle/aes_siv_boringssl.h"
+#include "tink/subtle/random.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "proto/test_proto.pb.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::google::crypto::tink::Keyset;
+using ::google::crypto::tink::NestedTestProto;
+using ::google::protobuf::Arena;
+using ::google::protobuf::FieldDescriptor;
+using ::google::protobuf::FieldMask;
+using ::google::protobuf::Message;
+using ::google::protobuf::util::MessageDifferencer;
+using ::testing::ElementsAre;
+using ::testing::Eq;
+using ::testing::Ne;
+using ::testing::Not;
+
+FieldMask Mask(std::vector<std::string> paths) {
+  FieldMask mask;
+  for (std::string& path : paths) mask.add_paths(std::move(path));
+  return mask;
+}
+
+std::unique_ptr<Aead> NewAead() {
+  StatusOr<std::unique_ptr<Aead>> aead = subtle::AesGcmBoringSsl::New(
+      SecretDataFromStringView(subtle::Random::GetRandomBytes(32)));
+  EXPECT_THAT(aead, IsOk());
+  return *std::move(aead);
+}
+
+std::unique_ptr<DeterministicAead> NewDeterministicAead() {
+  StatusOr<std::unique_ptr<DeterministicAead>> daead =
+      subtle::AesSivBoringSsl::New(
+          SecretDataFromStringView(subtle::Random::GetRandomBytes(64)));
+  EXPECT_THAT(daead, IsOk());
+  return *std::move(daead);
+}
+
+Keyset TestKeyset(int num_keys) {
+  Keyset keyset;
+  keyset.set_primary_key_id(1);
+  for (int i = 0; i < num_keys; ++i) {
+    Keyset::Key* key = keyset.add_key();
+    key->set_key_id(i + 1);
+    key->mutable_key_data()->set_type_url(absl::StrCat("type", i));
+    key->mutable_key_data()->set_value(absl::StrCat("secret key value ", i));
+  }
+  return keyset;
+}
+
+TEST(ProtoFieldEncrypterTest, EncryptDecryptRepeated) {
+  StatusOr<std::unique_ptr<ProtoFieldEncrypter>> encrypter =
+      ProtoFieldEncrypter::New(Keyset::descriptor(),
+                               Mask({"key.key_data.value"}), NewAead());
+  ASSERT_THAT(encrypter, IsOk());
+  Keyset keyset = TestKeyset(3);
+
+  Arena arena;
+  StatusOr<Message*> encrypted = (*encrypter)->Encrypt(keyset, "ad", &arena);
+  ASSERT_THAT(encrypted, IsOk());
+  EXPECT_THAT((*encrypted)->GetArena(), Eq(&arena));
+  const Keyset& encrypted_keyset = static_cast<const Keyset&>(**encrypted);
+  ASSERT_EQ(encrypted_keyset.key_size(), 3);
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_THAT(encrypted_keyset.key(i).key_data().value(),
+                Ne(keyset.key(i).key_data().value()));
+    EXPECT_THAT(encrypted_keyset.key(i).key_data().type_url(),
+                Eq(keyset.key(i).key_data().type_url()));
+    EXPECT_THAT(encrypted_keyset.key(i).key_id(), Eq(keyset.key(i).key_id()));
+  }
+
+  StatusOr<Message*> decrypted =
+      (*encrypter)->Decrypt(**encrypted, "ad", &arena);
+  ASSERT_THAT(decrypted, IsOk());
+  EXPECT_TRUE(MessageDifferencer::Equals(**decrypted, keyset));
+}
+
+TEST(ProtoFieldEncrypterTest, EncryptDecryptSingular) {
+  StatusOr<std::unique_ptr<ProtoFieldEncrypter>> encrypter =
+      ProtoFieldEncrypter::New(NestedTestProto::descriptor(),
+                               Mask({"a.str", "b.str", "str"}), NewAead());
+  ASSERT_THAT(encrypter, IsOk());
+  NestedTestProto message;
+  message.mutable_a()->set_str("a");
+  message.mutable_a()->set_num(1);
+  message.set_str("top");
+
+  StatusOr<Message*> encrypted =
+      (*encrypter)->Encrypt(message, "", /*arena=*/nullptr);
+  ASSERT_THAT(encrypted, IsOk());
+  std::unique_ptr<Message> owned_encrypted(*encrypted);
+  const NestedTestProto& encrypted_message =
+      static_cast<const NestedTestProto&>(**encrypted);
+  EXPECT_THAT(encrypted_message.a().str(), Ne("a"));
+  EXPECT_THAT(encrypted_message.a().num(), Eq(1));
+  EXPECT_THAT(encrypted_message.str(), Ne("top"));
+  // Absent fields stay absent.
+  EXPECT_FALSE(encrypted_message.has_b());
+
+  StatusOr<Message*> decrypted =
+      (*encrypter)->Decrypt(**encrypted, "", /*arena=*/nullptr);
+  ASSERT_THAT(decrypted, IsOk());
+  std::unique_ptr<Message> owned_decrypted(*decrypted);
+  EXPECT_TRUE(MessageDifferencer::Equals(**decrypted, message));
+}
+
+TEST(ProtoFieldEncrypterTest, EmptyValuesAreNotEncrypted) {
+  StatusOr<std::unique_ptr<ProtoFieldEncrypter>> encrypter =
+      ProtoFieldEncrypter::New(NestedTestProto::descriptor(),
+                               Mask({"a.str", "str"}), NewAead());
+  ASSERT_THAT(encrypter, IsOk());
+  NestedTestProto message;
+  message.mutable_a()->set_num(1);
+
+  Arena arena;
+  StatusOr<Message*> encrypted = (*encrypter)->Encrypt(message, "", &arena);
+  ASSERT_THAT(encrypted, IsOk());
+  EXPECT_TRUE(MessageDifferencer::Equals(**encrypted, message));
+}
+
+TEST(ProtoFieldEncrypterTest, CiphertextIsBoundToFieldPath) {
+  StatusOr<std::unique_ptr<ProtoFieldEncrypter>> encrypter =
+      ProtoFieldEncrypter::New(NestedTestProto::descriptor(),
+                               Mask({"a.str", "str"}), NewAead());
+  ASSERT_THAT(encrypter, IsOk());
+  NestedTestProto message;
+  message.mutable_a()->set_str("a");
+  message.set_str("top");
+
+  Arena arena;
+  StatusOr<Message*> encrypted = (*encrypter)->Encrypt(message, "", &arena);
+  ASSERT_THAT(encrypted, IsOk());
+  NestedTestProto swapped = static_cast<const NestedTestProto&>(**encrypted);
+  swapped.mutable_a()->mutable_str()->swap(*swapped.mutable_str());
+  EXPECT_THAT((*encrypter)->Decrypt(swapped, "", &arena), Not(IsOk()));
+}
+
+TEST(ProtoFieldEncrypterTest, CiphertextIsBoundToAssociatedData) {
+  StatusOr<std::unique_ptr<ProtoFieldEncrypter>> encrypter =
+      ProtoFieldEncrypter::New(Keyset::descriptor(),
+                               Mask({"key.key_data.value"}), NewAead());
+  ASSERT_THAT(encrypter, IsOk());
+
+  Arena arena;
+  StatusOr<Message*> encrypted =
+      (*encrypter)->Encrypt(TestKeyset(1), "record 1", &arena);
+  ASSERT_THAT(encrypted, IsOk());
+  EXPECT_THAT((*encrypter)->Decrypt(**encrypted, "record 1", &arena), IsOk());
+  EXPECT_THAT((*encrypter)->Decrypt(**encrypted, "record 2", &arena),
+              Not(IsOk()));
+}
+
+TEST(ProtoFieldEncrypterTest, Deterministic) {
+  if (::crypto::tink::internal::IsFipsModeEnabled()) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  StatusOr<std::unique_ptr<ProtoFieldEncrypter>> encrypter =
+      ProtoFieldEncrypter::New(Keyset::descriptor(),
+                               Mask({"key.key_data.value"}),
+                               NewDeterministicAead());
+  ASSERT_THAT(encrypter, IsOk());
+  Keyset keyset = TestKeyset(2);
+  keyset.mutable_key(1)->mutable_key_data()->set_value(
+      keyset.key(0).key_data().value());
+
+  Arena arena;
+  StatusOr<Message*> encrypted = (*encrypter)->Encrypt(keyset, "ad", &arena);
+  ASSERT_THAT(encrypted, IsOk());
+  const Keyset& encrypted_keyset = static_cast<const Keyset&>(**encrypted);
+  EXPECT_THAT(encrypted_keyset.key(0).key_data().value(),
+              Ne(keyset.key(0).key_data().value()));
+  EXPECT_THAT(encrypted_keyset.key(0).key_data().value(),
+              Eq(encrypted_keyset.key(1).key_data().value()));
+
+  StatusOr<Message*> encrypted_again =
+      (*encrypter)->Encrypt(keyset, "ad", &arena);
+  ASSERT_THAT(encrypted_again, IsOk());
+  EXPECT_TRUE(MessageDifferencer::Equals(**encrypted_again, **encrypted));
+
+  StatusOr<Message*> decrypted =
+      (*encrypter)->Decrypt(**encrypted, "ad", &arena);
+  ASSERT_THAT(decrypted, IsOk());
+  EXPECT_TRUE(MessageDifferencer::Equals(**decrypted, keyset));
+}
+
+TEST(ProtoFieldEncrypterTest, Batch) {
+  StatusOr<std::unique_ptr<ProtoFieldEncrypter>> encrypter =
+      ProtoFieldEncrypter::New(Keyset::descriptor(),
+                               Mask({"key.key_data.value"}), NewAead());
+  ASSERT_THAT(encrypter, IsOk());
+  std::vector<Keyset> keysets;
+  std::vector<std::string> record_ids;
+  for (int i = 0; i < 20; ++i) {
+    keysets.push_back(TestKeyset(i % 4));
+    record_ids.push_back(absl::StrCat("record ", i));
+  }
+  std::vector<const Message*> messages;
+  for (const Keyset& keyset : keysets) messages.push_back(&keyset);
+  std::vector<absl::string_view> associated_data(record_ids.begin(),
+                                                 record_ids.end());
+
+  Arena arena;
+  StatusOr<std::vector<Message*>> encrypted =
+      (*encrypter)->EncryptBatch(messages, associated_data, &arena);
+  ASSERT_THAT(encrypted, IsOk());
+  ASSERT_EQ(encrypted->size(), keysets.size());
+  StatusOr<std::vector<Message*>> decrypted =
+      (*encrypter)->DecryptBatch(*encrypted, associated_data, &arena);
+  ASSERT_THAT(decrypted, IsOk());
+  ASSERT_EQ(decrypted->size(), keysets.size());
+  for (int i = 0; i < keysets.size(); ++i) {
+    EXPECT_TRUE(MessageDifferencer::Equals(*(*decrypted)[i], keysets[i]));
+    // Each message decrypts on its own with its own associated data.
+    EXPECT_THAT(
+        (*encrypter)->Decrypt(*(*encrypted)[i], associated_data[i], &arena),
+        IsOk());
+  }
+
+  EXPECT_THAT(
+      (*encrypter)->EncryptBatch(messages, {"too few"}, &arena).status(),
+      StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT((*encrypter)->EncryptBatch({}, {}, &arena), IsOk());
+}
+
+TEST(ProtoFieldEncrypterTest, RejectsOtherMessageType) {
+  StatusOr<std::unique_ptr<ProtoFieldEncrypter>> encrypter =
+      ProtoFieldEncrypter::New(Keyset::descriptor(),
+                               Mask({"key.key_data.value"}), NewAead());
+  ASSERT_THAT(encrypter, IsOk());
+  Arena arena;
+  EXPECT_THAT((*encrypter)->Encrypt(NestedTestProto(), "", &arena).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(ProtoFieldEncrypterTest, RejectsInvalidFieldMasks) {
+  for (const FieldMask& mask :
+       {Mask({}), Mask({"key.key_data.unknown"}), Mask({"key.key_data"}),
+        Mask({"key.key_data.type_url"}), Mask({"primary_key_id.value"}),
+        Mask({"key.key_data.value", "key.key_data.value"})}) {
+    SCOPED_TRACE(mask.DebugString());
+    EXPECT_THAT(
+        ProtoFieldEncrypter::New(Keyset::descriptor(), mask, NewAead())
+            .status(),
+        StatusIs(absl::StatusCode::kInvalidArgument));
+  }
+  EXPECT_THAT(ProtoFieldEncrypter::New(Keyset::descriptor(),
+                                       Mask({"key.key_data.value"}),
+                                       std::unique_ptr<Aead>())
+                  .status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(ProtoFieldEncrypterTest, SelectFields) {
+  EXPECT_THAT(ProtoFieldEncrypter::SelectFields(
+                  NestedTestProto::descriptor(),
+                  [](const FieldDescriptor&) { return true; })
+                  .paths(),
+              ElementsAre("a.str", "b.str", "str"));
+  EXPECT_THAT(ProtoFieldEncrypter::SelectFields(
+                  Keyset::descriptor(),
+                  [](const FieldDescriptor& field) {
+                    return field.name() == "value";
+                  })
+                  .paths(),
+              ElementsAre("key.key_data.value"));
+  EXPECT_THAT(ProtoFieldEncrypter::SelectFields(
+                  Keyset::descriptor(),
+                  [](const FieldDescriptor&) { return false; })
+                  .paths(),
+              ElementsAre());
+}
+
+}  // namespace
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,101 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/util/request_arena.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "openssl/crypto.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+
+namespace {
+
+constexpr size_t kAlignment = alignof(std::max_align_t);
+
+size_t AlignUp(size_t size) {
+  return (size + kAlignment - 1) & ~(kAlignment - 1);
+}
+
+}  // namespace
+
+RequestArena::RequestArena(size_t initial_size)
+    : next_block_size_(std::max(AlignUp(initial_size), kAlignment)) {}
+
+RequestArena::~RequestArena() { Reset(); }
+
+absl::Span<char> RequestArena::Allocate(size_t size) {
+  const size_t aligned_size = AlignUp(size);
+  if (blocks_.empty() || blocks_.back().size - offset_ < aligned_size) {
+    const size_t block_size = std::max(next_block_size_, aligned_size);
+    blocks_.push_back({std::unique_ptr<char[]>(new char[block_size]),
+                       block_size});
+    next_block_size_ = 2 * block_size;
+    offset_ = 0;
+  }
+  char* result = blocks_.back().data.get() + offset_;
+  offset_ += aligned_size;
+  return absl::MakeSpan(result, size);
+}
+
+absl::string_view RequestArena::Copy(absl::string_view data) {
+  absl::Span<char> copy = Allocate(data.size());
+  if (!data.empty()) {
+    std::memcpy(copy.data(), data.data(), data.size());
+  }
+  return absl::string_view(copy.data(), copy.size());
+}
+
+void RequestArena::Reset() {
+  if (blocks_.empty()) return;
+  for (size_t i = 0; i + 1 < blocks_.size(); ++i) {
+    OPENSSL_cleanse(blocks_[i].data.get(), blocks_[i].size);
+  }
+  OPENSSL_cleanse(blocks_.back().data.get(), offset_);
+  offset_ = 0;
+  if (blocks_.size() == 1) return;
+
+  const size_t total_size = capacity();
+  blocks_.clear();
+  blocks_.push_back(
+      {std::unique_ptr<char[]>(new char[total_size]), total_size});
+  next_block_size_ = 2 * total_size;
+}
+
+size_t RequestArena::bytes_used() const {
+  if (blocks_.empty()) return 0;
+  return capacity() - blocks_.back().size + offset_;
+}
+
+size_t RequestArena::capacity() const {
+  size_t result = 0;
+  for (const Block& block : blocks_) {
+    result += block.size;
+  }
+  return result;
+}
+
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
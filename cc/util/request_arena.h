@@ -0,0 +1,104 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_UTIL_REQUEST_ARENA_H_
+#define TINK_UTIL_REQUEST_ARENA_H_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+
+// A bump allocator for the output and scratch buffers of a sequence of
+// primitive calls that belong to the same request.
+//
+// The *WithArena() methods of Aead, DeterministicAead, Mac and Prf place
+// their results in a RequestArena instead of returning a std::string. The
+// returned views stay valid until the next call to Reset(), which makes the
+// memory available to the next request. Reset() retains the capacity used so
+// far in a single block, so once a serving loop has seen its largest request
+// it performs no further heap allocation:
+//
+//   util::RequestArena arena;
+//   while (...) {
+//     util::StatusOr<absl::string_view> plaintext =
+//         aead->DecryptWithArena(ciphertext, associated_data, &arena);
+//     ...
+//     arena.Reset();
+//   }
+//
+// Since outputs may include plaintexts, Reset() and the destructor zero all
+// memory handed out since the previous reset.
+//
+// This class is not thread-safe; each thread should use its own arena.
+class RequestArena {
+ public:
+  static constexpr size_t kDefaultBlockSize = 4096;
+
+  // Creates an arena whose first block holds `initial_size` bytes. The block
+  // is allocated on first use.
+  explicit RequestArena(size_t initial_size = kDefaultBlockSize);
+
+  // Not copyable or movable.
+  RequestArena(const RequestArena&) = delete;
+  RequestArena& operator=(const RequestArena&) = delete;
+
+  ~RequestArena();
+
+  // Returns `size` bytes of uninitialized memory, aligned to
+  // alignof(std::max_align_t), that stay valid until Reset().
+  absl::Span<char> Allocate(size_t size);
+
+  // Copies `data` into the arena and returns a view of the copy.
+  absl::string_view Copy(absl::string_view data);
+
+  // Zeroes and releases everything allocated since the last reset. If more
+  // than one block was in use, they are replaced by a single block of their
+  // combined size.
+  void Reset();
+
+  // Number of bytes consumed since the last reset, including alignment padding
+  // and the unused tails of full blocks.
+  size_t bytes_used() const;
+
+  // Total size of the blocks the arena holds, including the bytes already
+  // handed out since the last reset. Up to capacity() - bytes_used() more
+  // bytes can be allocated before the arena allocates a new block.
+  size_t capacity() const;
+
+ private:
+  struct Block {
+    std::unique_ptr<char[]> data;
+    size_t size;
+  };
+
+  std::vector<Block> blocks_;
+  // Offset of the first free byte in blocks_.back().
+  size_t offset_ = 0;
+  size_t next_block_size_;
+};
+
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_UTIL_REQUEST_ARENA_H_
@@ -0,0 +1,112 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/util/request_arena.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+namespace {
+
+using ::testing::Eq;
+using ::testing::Ge;
+
+TEST(RequestArenaTest, AllocateIsAlignedAndDisjoint) {
+  RequestArena arena(/*initial_size=*/64);
+  std::vector<absl::Span<char>> allocations;
+  for (size_t size : {0, 1, 7, 16, 33, 100, 1000}) {
+    absl::Span<char> allocation = arena.Allocate(size);
+    EXPECT_THAT(allocation.size(), Eq(size));
+    EXPECT_THAT(reinterpret_cast<uintptr_t>(allocation.data()) %
+                    alignof(std::max_align_t),
+                Eq(0));
+    std::fill(allocation.begin(), allocation.end(),
+              static_cast<char>(allocations.size()));
+    allocations.push_back(allocation);
+  }
+  // Later allocations did not overwrite earlier ones.
+  for (size_t i = 0; i < allocations.size(); ++i) {
+    for (char c : allocations[i]) {
+      EXPECT_THAT(c, Eq(static_cast<char>(i)));
+    }
+  }
+}
+
+TEST(RequestArenaTest, Copy) {
+  RequestArena arena;
+  std::string data = "some data";
+  absl::string_view copy = arena.Copy(data);
+  EXPECT_THAT(copy, Eq(data));
+  EXPECT_NE(copy.data(), data.data());
+  EXPECT_THAT(arena.Copy(""), Eq(""));
+}
+
+TEST(RequestArenaTest, ResetKeepsCapacityInOneBlock) {
+  RequestArena arena(/*initial_size=*/64);
+  for (int i = 0; i < 10; ++i) {
+    arena.Allocate(100);
+  }
+  const size_t capacity = arena.capacity();
+  EXPECT_THAT(capacity, Ge(1000));
+  EXPECT_THAT(arena.bytes_used(), Ge(1000));
+
+  arena.Reset();
+  EXPECT_THAT(arena.bytes_used(), Eq(0));
+  EXPECT_THAT(arena.capacity(), Eq(capacity));
+
+  // The same workload now fits into the retained block.
+  char* first = arena.Allocate(100).data();
+  for (int i = 1; i < 10; ++i) {
+    arena.Allocate(100);
+  }
+  EXPECT_THAT(arena.capacity(), Eq(capacity));
+  arena.Reset();
+  EXPECT_THAT(arena.Allocate(100).data(), Eq(first));
+}
+
+TEST(RequestArenaTest, ResetZeroesMemory) {
+  RequestArena arena;
+  absl::Span<char> allocation = arena.Allocate(32);
+  std::fill(allocation.begin(), allocation.end(), 'x');
+  arena.Reset();
+  for (char c : allocation) {
+    EXPECT_THAT(c, Eq(0));
+  }
+}
+
+TEST(RequestArenaTest, LargeAllocation) {
+  RequestArena arena(/*initial_size=*/16);
+  absl::Span<char> allocation = arena.Allocate(1 << 20);
+  EXPECT_THAT(allocation.size(), Eq(1 << 20));
+  EXPECT_THAT(arena.capacity(), Ge(1 << 20));
+}
+
+}  // namespace
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto